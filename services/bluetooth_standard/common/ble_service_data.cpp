@@ -477,7 +477,7 @@ void BleAdvertiserDataImpl::SetPayload(const std::string &payload)
  * @return Returns advertiser data packet.
  * @since 6
  */
-std::string BleAdvertiserDataImpl::GetPayload() const
+const std::string &BleAdvertiserDataImpl::GetPayload() const
 {
     return payload_;
 }
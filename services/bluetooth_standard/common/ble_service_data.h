@@ -403,7 +403,7 @@ public:
      * @return Returns advertiser data packet.
      * @since 6
      */
-    std::string GetPayload() const;
+    const std::string &GetPayload() const;
 
 private:
     /// Advertiser data packet
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VIRTUAL_CONTROLLER_H
+#define VIRTUAL_CONTROLLER_H
+
+#include "bluetooth_hal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// In-process software controller behind the HAL interface of bluetooth_hal.h.
+// The host under test talks to it through HalInit/HalSendHciPacket/HalClose, and a virtual peer host sits on the
+// far end of every link it creates. ACL data between the two hosts is paced by controller credits and a one-way
+// latency, so the stack can be exercised and measured without real hardware.
+
+#define VIRTUAL_CONTROLLER_TRANSPORT_BREDR 0x01
+#define VIRTUAL_CONTROLLER_TRANSPORT_LE 0x02
+
+typedef struct {
+    // Local public address reported by Read BD_ADDR, in HCI byte order.
+    uint8_t localAddr[6];
+    // Address of the virtual peer for LE connections initiated through the white list, in HCI byte order.
+    uint8_t peerAddr[6];
+    // BR/EDR ACL payload size and number of controller buffers reported by Read Buffer Size.
+    uint16_t aclDataLength;
+    uint16_t aclCredits;
+    // LE ACL payload size and number of controller buffers reported by LE Read Buffer Size.
+    uint16_t leAclDataLength;
+    uint8_t leAclCredits;
+    // One-way latency of an ACL packet across a virtual link, in microseconds.
+    uint32_t linkLatencyUs;
+} VirtualControllerConfig;
+
+typedef struct {
+    // Link established to the virtual peer.
+    void (*onConnected)(uint16_t handle, uint8_t transport, void *context);
+    // Link to the virtual peer closed.
+    void (*onDisconnected)(uint16_t handle, void *context);
+    // One ACL fragment sent by the host under test, delivered once the link latency elapsed.
+    // packetBoundary holds the PB flag of the fragment (0x00/0x02 first, 0x01 continuing).
+    void (*onAclData)(uint16_t handle, uint8_t packetBoundary, const uint8_t *data, uint16_t length, void *context);
+} VirtualPeerCallbacks;
+
+typedef struct {
+    // Advertising reports per LE Advertising Report event (1 to 25, lowered to what fits in one event).
+    uint8_t reportsPerEvent;
+    // Advertising data length of every report (0 to 31).
+    uint8_t dataLength;
+    // Number of distinct advertiser addresses the reports rotate through.
+    uint16_t numAdvertisers;
+    // Gap between two report events, 0 to send as fast as the host accepts them.
+    uint32_t intervalUs;
+} VirtualAdvertisingFlood;
+
+typedef struct {
+    uint64_t commands;
+    uint64_t events;
+    uint64_t aclToController;
+    uint64_t aclToHost;
+    uint64_t aclBytesToController;
+    uint64_t aclBytesToHost;
+    uint64_t advertisingReports;
+    // Host sent ACL data with no controller buffer left.
+    uint64_t creditOverruns;
+} VirtualControllerStatistics;
+
+void VirtualControllerGetDefaultConfig(VirtualControllerConfig *config);
+
+// Takes effect at the next HalInit.
+void VirtualControllerSetConfig(const VirtualControllerConfig *config);
+
+void VirtualPeerRegisterCallbacks(const VirtualPeerCallbacks *callbacks, void *context);
+
+// Sends one L2CAP PDU from the virtual peer, fragmented to the host ACL data length.
+int VirtualPeerSendAcl(uint16_t handle, const uint8_t *data, uint16_t length);
+
+// Connects the virtual peer from the given address (HCI byte order) as if the host were advertising; the host takes
+// the slave role. Any number of such links can be up at once. Returns the connection handle, 0 when not running.
+uint16_t VirtualPeerConnectLe(uint8_t addrType, const uint8_t addr[6]);
+
+// Closes a link from the peer side, the host sees Disconnection Complete with Remote User Terminated Connection.
+int VirtualPeerDisconnect(uint16_t handle);
+
+// Generates LE advertising reports while the host has LE scanning enabled.
+void VirtualControllerStartAdvertisingFlood(const VirtualAdvertisingFlood *flood);
+void VirtualControllerStopAdvertisingFlood(void);
+
+void VirtualControllerGetStatistics(VirtualControllerStatistics *statistics);
+void VirtualControllerResetStatistics(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // VIRTUAL_CONTROLLER_H
@@ -0,0 +1,1075 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "virtual_controller.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace bluetooth {
+namespace {
+using Clock = std::chrono::steady_clock;
+
+// Events
+constexpr uint8_t EVT_CONNECTION_COMPLETE = 0x03;
+constexpr uint8_t EVT_DISCONNECTION_COMPLETE = 0x05;
+constexpr uint8_t EVT_REMOTE_NAME_REQUEST_COMPLETE = 0x07;
+constexpr uint8_t EVT_READ_REMOTE_SUPPORTED_FEATURES_COMPLETE = 0x0B;
+constexpr uint8_t EVT_READ_REMOTE_VERSION_INFORMATION_COMPLETE = 0x0C;
+constexpr uint8_t EVT_COMMAND_COMPLETE = 0x0E;
+constexpr uint8_t EVT_COMMAND_STATUS = 0x0F;
+constexpr uint8_t EVT_NUMBER_OF_COMPLETED_PACKETS = 0x13;
+constexpr uint8_t EVT_READ_REMOTE_EXTENDED_FEATURES_COMPLETE = 0x23;
+constexpr uint8_t EVT_LE_META = 0x3E;
+
+constexpr uint8_t LE_EVT_CONNECTION_COMPLETE = 0x01;
+constexpr uint8_t LE_EVT_ADVERTISING_REPORT = 0x02;
+constexpr uint8_t LE_EVT_CONNECTION_UPDATE_COMPLETE = 0x03;
+constexpr uint8_t LE_EVT_READ_REMOTE_FEATURES_COMPLETE = 0x04;
+
+// Commands
+constexpr uint16_t CMD_CREATE_CONNECTION = 0x0405;
+constexpr uint16_t CMD_DISCONNECT = 0x0406;
+constexpr uint16_t CMD_CHANGE_CONNECTION_PACKET_TYPE = 0x040F;
+constexpr uint16_t CMD_AUTHENTICATION_REQUESTED = 0x0411;
+constexpr uint16_t CMD_SET_CONNECTION_ENCRYPTION = 0x0413;
+constexpr uint16_t CMD_REMOTE_NAME_REQUEST = 0x0419;
+constexpr uint16_t CMD_READ_REMOTE_SUPPORTED_FEATURES = 0x041B;
+constexpr uint16_t CMD_READ_REMOTE_EXTENDED_FEATURES = 0x041C;
+constexpr uint16_t CMD_READ_REMOTE_VERSION_INFORMATION = 0x041D;
+constexpr uint16_t CMD_SNIFF_MODE = 0x0803;
+constexpr uint16_t CMD_EXIT_SNIFF_MODE = 0x0804;
+constexpr uint16_t CMD_SWITCH_ROLE = 0x080B;
+constexpr uint16_t CMD_RESET = 0x0C03;
+constexpr uint16_t CMD_READ_LOCAL_NAME = 0x0C14;
+constexpr uint16_t CMD_READ_LOCAL_VERSION_INFORMATION = 0x1001;
+constexpr uint16_t CMD_READ_LOCAL_SUPPORTED_COMMANDS = 0x1002;
+constexpr uint16_t CMD_READ_LOCAL_SUPPORTED_FEATURES = 0x1003;
+constexpr uint16_t CMD_READ_LOCAL_EXTENDED_FEATURES = 0x1004;
+constexpr uint16_t CMD_READ_BUFFER_SIZE = 0x1005;
+constexpr uint16_t CMD_READ_BD_ADDR = 0x1009;
+constexpr uint16_t CMD_READ_RSSI = 0x1405;
+constexpr uint16_t CMD_LE_READ_BUFFER_SIZE = 0x2002;
+constexpr uint16_t CMD_LE_READ_LOCAL_SUPPORTED_FEATURES = 0x2003;
+constexpr uint16_t CMD_LE_SET_SCAN_ENABLE = 0x200C;
+constexpr uint16_t CMD_LE_CREATE_CONNECTION = 0x200D;
+constexpr uint16_t CMD_LE_READ_WHITE_LIST_SIZE = 0x200F;
+constexpr uint16_t CMD_LE_ADD_DEVICE_TO_WHITE_LIST = 0x2011;
+constexpr uint16_t CMD_LE_CONNECTION_UPDATE = 0x2013;
+constexpr uint16_t CMD_LE_READ_REMOTE_FEATURES = 0x2016;
+constexpr uint16_t CMD_LE_ENCRYPT = 0x2017;
+constexpr uint16_t CMD_LE_RAND = 0x2018;
+constexpr uint16_t CMD_LE_START_ENCRYPTION = 0x2019;
+constexpr uint16_t CMD_LE_READ_SUPPORTED_STATES = 0x201C;
+constexpr uint16_t CMD_LE_SET_DATA_LENGTH = 0x2022;
+constexpr uint16_t CMD_LE_READ_LOCAL_P256_PUBLIC_KEY = 0x2025;
+constexpr uint16_t CMD_LE_GENERATE_DHKEY = 0x2026;
+constexpr uint16_t CMD_LE_READ_RESOLVING_LIST_SIZE = 0x202A;
+constexpr uint16_t CMD_LE_READ_MAXIMUM_DATA_LENGTH = 0x202F;
+constexpr uint16_t CMD_LE_SET_PHY = 0x2032;
+constexpr uint16_t CMD_LE_SET_EXTENDED_SCAN_ENABLE = 0x2042;
+
+constexpr uint8_t STATUS_SUCCESS = 0x00;
+constexpr uint8_t STATUS_UNKNOWN_CONNECTION_IDENTIFIER = 0x02;
+constexpr uint8_t STATUS_UNSUPPORTED_FEATURE = 0x11;
+constexpr uint8_t REASON_REMOTE_USER_TERMINATED_CONNECTION = 0x13;
+constexpr uint8_t REASON_CONNECTION_TERMINATED_BY_LOCAL_HOST = 0x16;
+
+constexpr uint8_t PB_FIRST_NON_FLUSHABLE = 0x00;
+constexpr uint8_t PB_CONTINUING = 0x01;
+constexpr uint8_t PB_FIRST_FLUSHABLE = 0x02;
+
+constexpr size_t ADDRESS_SIZE = 6;
+constexpr size_t FEATURES_SIZE = 8;
+constexpr size_t SUPPORTED_COMMANDS_SIZE = 64;
+constexpr size_t LOCAL_NAME_SIZE = 248;
+constexpr size_t CMD_HEADER_SIZE = 3;
+constexpr size_t ACL_HEADER_SIZE = 4;
+constexpr uint8_t HCI_VERSION_5_0 = 0x09;
+constexpr uint16_t MANUFACTURER_NAME = 0xFFFF;
+constexpr uint8_t SCO_DATA_LENGTH = 64;
+constexpr uint16_t SCO_CREDITS = 8;
+constexpr uint8_t WHITE_LIST_SIZE = 8;
+constexpr uint8_t RESOLVING_LIST_SIZE = 8;
+constexpr uint16_t LE_MAX_OCTETS = 251;
+constexpr uint16_t LE_MAX_TIME = 2120;
+constexpr uint8_t MAX_REPORTS_PER_EVENT = 25;
+constexpr size_t MAX_EVENT_PARAMS_SIZE = 255;
+constexpr uint8_t MAX_ADVERTISING_DATA_LENGTH = 31;
+constexpr size_t MAX_DELIVERIES_PER_ROUND = 64;
+constexpr uint8_t ADV_IND = 0x00;
+constexpr uint8_t ADDRESS_TYPE_RANDOM = 0x01;
+constexpr uint8_t AD_TYPE_MANUFACTURER_SPECIFIC_DATA = 0xFF;
+constexpr uint8_t LE_ROLE_SLAVE = 0x01;
+// 30 ms connection interval, no latency, 5 s supervision timeout.
+constexpr uint16_t PEER_CONN_INTERVAL = 0x0018;
+constexpr uint16_t PEER_CONN_LATENCY = 0x0000;
+constexpr uint16_t PEER_SUPERVISION_TIMEOUT = 0x01F4;
+constexpr int8_t PEER_RSSI = -42;
+
+// BR/EDR controller with SSP, EDR and LE.
+constexpr uint8_t LMP_FEATURES[FEATURES_SIZE] = {0xBF, 0xFE, 0xCF, 0xFE, 0xDB, 0xFF, 0x7B, 0x87};
+// Secure Simple Pairing (Host Support) and LE Supported (Host).
+constexpr uint8_t LMP_HOST_FEATURES[FEATURES_SIZE] = {0x03, 0, 0, 0, 0, 0, 0, 0};
+// LE Encryption and LE Data Packet Length Extension.
+constexpr uint8_t LE_FEATURES[FEATURES_SIZE] = {0x21, 0, 0, 0, 0, 0, 0, 0};
+
+constexpr char PEER_NAME[] = "VirtualPeer";
+
+void PutUint16(std::vector<uint8_t> &buffer, uint16_t value)
+{
+    buffer.push_back(static_cast<uint8_t>(value & 0xFF));
+    buffer.push_back(static_cast<uint8_t>(value >> 8));
+}
+
+uint16_t GetUint16(const uint8_t *data)
+{
+    return static_cast<uint16_t>(data[0] | (data[1] << 8));
+}
+}  // namespace
+
+class VirtualController {
+public:
+    static VirtualController &GetInstance()
+    {
+        static VirtualController instance;
+        return instance;
+    }
+
+    int Init(BtHciCallbacks *callbacks);
+    int SendHciPacket(BtPacketType type, const BtPacket *packet);
+    void Close();
+
+    void SetConfig(const VirtualControllerConfig &config);
+    void RegisterPeer(const VirtualPeerCallbacks *callbacks, void *context);
+    int PeerSendAcl(uint16_t handle, const uint8_t *data, uint16_t length);
+    uint16_t PeerConnectLe(uint8_t addrType, const uint8_t *addr);
+    int PeerDisconnect(uint16_t handle);
+    void StartAdvertisingFlood(const VirtualAdvertisingFlood &flood);
+    void StopAdvertisingFlood();
+    void GetStatistics(VirtualControllerStatistics &statistics) const;
+    void ResetStatistics();
+
+private:
+    VirtualController();
+    ~VirtualController() = default;
+
+    enum DeliveryType {
+        HOST_EVENT,
+        HOST_ACL,
+        PEER_ACL,
+        PEER_CONNECTED,
+        PEER_DISCONNECTED,
+    };
+
+    struct Delivery {
+        DeliveryType type_ = HOST_EVENT;
+        uint16_t handle_ = 0;
+        uint8_t packetBoundary_ = 0;
+        std::vector<uint8_t> data_ {};
+    };
+
+    struct Link {
+        uint8_t transport_ = VIRTUAL_CONTROLLER_TRANSPORT_BREDR;
+        uint16_t inFlight_ = 0;
+    };
+
+    void Run();
+    void Deliver(Delivery &delivery, std::map<uint16_t, uint16_t> &completed);
+    void SendNumberOfCompletedPackets(const std::map<uint16_t, uint16_t> &completed);
+    void SendAdvertisingReports();
+    void ToHost(BtPacketType type, std::vector<uint8_t> &data);
+
+    // The following run with mutex_ held.
+    void Schedule(Clock::time_point due, Delivery delivery);
+    void QueueEvent(uint8_t code, const std::vector<uint8_t> &params);
+    void QueueLeEvent(uint8_t subCode, const std::vector<uint8_t> &params);
+    void CommandComplete(uint16_t opcode, const std::vector<uint8_t> &returnParams);
+    void CommandStatus(uint16_t opcode, uint8_t status);
+    void OnCommand(uint16_t opcode, const uint8_t *params, size_t length);
+    bool OnInformationalCommand(uint16_t opcode, const uint8_t *params, size_t length);
+    bool OnLeCommand(uint16_t opcode, const uint8_t *params, size_t length);
+    bool OnLinkCommand(uint16_t opcode, const uint8_t *params, size_t length);
+    void OnAclFromHost(const uint8_t *data, size_t length);
+    uint16_t CreateLink(uint8_t transport);
+    void RemoveLink(uint16_t handle);
+
+    VirtualControllerConfig config_ {};
+    BtHciCallbacks *callbacks_ = nullptr;
+    VirtualPeerCallbacks peer_ {};
+    void *peerContext_ = nullptr;
+
+    mutable std::mutex mutex_ {};
+    std::condition_variable cv_ {};
+    std::thread worker_ {};
+    bool running_ = false;
+    // Ordered by due time; equal keys keep their insertion order.
+    std::multimap<Clock::time_point, Delivery> deliveries_ {};
+    std::map<uint16_t, Link> links_ {};
+    uint16_t nextHandle_ = 1;
+    uint8_t whiteListAddrType_ = 0;
+    uint8_t whiteListAddr_[ADDRESS_SIZE] = {0};
+    bool scanning_ = false;
+    bool flooding_ = false;
+    VirtualAdvertisingFlood flood_ {};
+    uint32_t nextAdvertiser_ = 0;
+    Clock::time_point nextFlood_ {};
+    std::mt19937 random_ {};
+
+    std::atomic<uint64_t> commands_ {0};
+    std::atomic<uint64_t> events_ {0};
+    std::atomic<uint64_t> aclToController_ {0};
+    std::atomic<uint64_t> aclToHost_ {0};
+    std::atomic<uint64_t> aclBytesToController_ {0};
+    std::atomic<uint64_t> aclBytesToHost_ {0};
+    std::atomic<uint64_t> advertisingReports_ {0};
+    std::atomic<uint64_t> creditOverruns_ {0};
+};
+
+VirtualController::VirtualController()
+{
+    VirtualControllerGetDefaultConfig(&config_);
+}
+
+int VirtualController::Init(BtHciCallbacks *callbacks)
+{
+    if (callbacks == nullptr) {
+        return INITIALIZATION_ERROR;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_) {
+        return INITIALIZATION_ERROR;
+    }
+    callbacks_ = callbacks;
+    deliveries_.clear();
+    links_.clear();
+    nextHandle_ = 1;
+    whiteListAddrType_ = 0;
+    std::copy(config_.peerAddr, config_.peerAddr + ADDRESS_SIZE, whiteListAddr_);
+    scanning_ = false;
+    running_ = true;
+    worker_ = std::thread(&VirtualController::Run, this);
+    return SUCCESS;
+}
+
+void VirtualController::Close()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+    }
+    cv_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    deliveries_.clear();
+    links_.clear();
+    callbacks_ = nullptr;
+}
+
+void VirtualController::SetConfig(const VirtualControllerConfig &config)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_ = config;
+}
+
+void VirtualController::RegisterPeer(const VirtualPeerCallbacks *callbacks, void *context)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (callbacks != nullptr) {
+        peer_ = *callbacks;
+    } else {
+        peer_ = {};
+    }
+    peerContext_ = context;
+}
+
+int VirtualController::SendHciPacket(BtPacketType type, const BtPacket *packet)
+{
+    if ((packet == nullptr) || (packet->data == nullptr)) {
+        return TRANSPORT_ERROR;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) {
+        return TRANSPORT_ERROR;
+    }
+    switch (type) {
+        case PACKET_TYPE_CMD:
+            if (packet->size < CMD_HEADER_SIZE) {
+                return TRANSPORT_ERROR;
+            }
+            commands_++;
+            OnCommand(GetUint16(packet->data), packet->data + CMD_HEADER_SIZE, packet->size - CMD_HEADER_SIZE);
+            break;
+        case PACKET_TYPE_ACL:
+            if (packet->size < ACL_HEADER_SIZE) {
+                return TRANSPORT_ERROR;
+            }
+            OnAclFromHost(packet->data, packet->size);
+            break;
+        default:
+            // SCO is accepted and dropped.
+            break;
+    }
+    cv_.notify_all();
+    return SUCCESS;
+}
+
+int VirtualController::PeerSendAcl(uint16_t handle, const uint8_t *data, uint16_t length)
+{
+    if ((data == nullptr) && (length != 0)) {
+        return TRANSPORT_ERROR;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = links_.find(handle);
+    if ((!running_) || (it == links_.end())) {
+        return TRANSPORT_ERROR;
+    }
+
+    uint16_t fragmentSize = (it->second.transport_ == VIRTUAL_CONTROLLER_TRANSPORT_LE) ? config_.leAclDataLength
+                                                                                        : config_.aclDataLength;
+    Clock::time_point due = Clock::now() + std::chrono::microseconds(config_.linkLatencyUs);
+    uint16_t offset = 0;
+    do {
+        uint16_t size = std::min<uint16_t>(fragmentSize, length - offset);
+        Delivery delivery;
+        delivery.type_ = HOST_ACL;
+        delivery.handle_ = handle;
+        delivery.packetBoundary_ = (offset == 0) ? PB_FIRST_FLUSHABLE : PB_CONTINUING;
+        delivery.data_.assign(data + offset, data + offset + size);
+        Schedule(due, std::move(delivery));
+        offset += size;
+    } while (offset < length);
+    cv_.notify_all();
+    return SUCCESS;
+}
+
+uint16_t VirtualController::PeerConnectLe(uint8_t addrType, const uint8_t *addr)
+{
+    if (addr == nullptr) {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) {
+        return 0;
+    }
+
+    // The peer connects to the host as if the host were advertising, so the host takes the slave role.
+    uint16_t handle = CreateLink(VIRTUAL_CONTROLLER_TRANSPORT_LE);
+    std::vector<uint8_t> evt = {STATUS_SUCCESS};
+    PutUint16(evt, handle);
+    evt.push_back(LE_ROLE_SLAVE);
+    evt.push_back(addrType);
+    evt.insert(evt.end(), addr, addr + ADDRESS_SIZE);
+    PutUint16(evt, PEER_CONN_INTERVAL);
+    PutUint16(evt, PEER_CONN_LATENCY);
+    PutUint16(evt, PEER_SUPERVISION_TIMEOUT);
+    evt.push_back(0x00);  // Master clock accuracy
+    QueueLeEvent(LE_EVT_CONNECTION_COMPLETE, evt);
+    cv_.notify_all();
+    return handle;
+}
+
+int VirtualController::PeerDisconnect(uint16_t handle)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if ((!running_) || (links_.find(handle) == links_.end())) {
+        return TRANSPORT_ERROR;
+    }
+
+    RemoveLink(handle);
+    std::vector<uint8_t> evt = {STATUS_SUCCESS};
+    PutUint16(evt, handle);
+    evt.push_back(REASON_REMOTE_USER_TERMINATED_CONNECTION);
+    QueueEvent(EVT_DISCONNECTION_COMPLETE, evt);
+    cv_.notify_all();
+    return SUCCESS;
+}
+
+void VirtualController::StartAdvertisingFlood(const VirtualAdvertisingFlood &flood)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        flood_ = flood;
+        flood_.dataLength = std::min(flood.dataLength, MAX_ADVERTISING_DATA_LENGTH);
+        // Subevent code and report count, then per report: event type, address type, address, length, data, rssi.
+        uint8_t fitting = static_cast<uint8_t>((MAX_EVENT_PARAMS_SIZE - 2) / (ADDRESS_SIZE + 4 + flood_.dataLength));
+        flood_.reportsPerEvent =
+            std::max<uint8_t>(1, std::min({flood.reportsPerEvent, MAX_REPORTS_PER_EVENT, fitting}));
+        flood_.numAdvertisers = std::max<uint16_t>(1, flood.numAdvertisers);
+        flooding_ = true;
+        nextFlood_ = Clock::now();
+    }
+    cv_.notify_all();
+}
+
+void VirtualController::StopAdvertisingFlood()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    flooding_ = false;
+}
+
+void VirtualController::GetStatistics(VirtualControllerStatistics &statistics) const
+{
+    statistics.commands = commands_;
+    statistics.events = events_;
+    statistics.aclToController = aclToController_;
+    statistics.aclToHost = aclToHost_;
+    statistics.aclBytesToController = aclBytesToController_;
+    statistics.aclBytesToHost = aclBytesToHost_;
+    statistics.advertisingReports = advertisingReports_;
+    statistics.creditOverruns = creditOverruns_;
+}
+
+void VirtualController::ResetStatistics()
+{
+    commands_ = 0;
+    events_ = 0;
+    aclToController_ = 0;
+    aclToHost_ = 0;
+    aclBytesToController_ = 0;
+    aclBytesToHost_ = 0;
+    advertisingReports_ = 0;
+    creditOverruns_ = 0;
+}
+
+void VirtualController::Run()
+{
+    if (callbacks_->OnInited != nullptr) {
+        callbacks_->OnInited(SUCCESS);
+    }
+
+    std::vector<Delivery> batch;
+    std::map<uint16_t, uint16_t> completed;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_) {
+        Clock::time_point now = Clock::now();
+        bool floodDue = flooding_ && scanning_ && (nextFlood_ <= now);
+        bool deliveryDue = (!deliveries_.empty()) && (deliveries_.begin()->first <= now);
+        if ((!floodDue) && (!deliveryDue)) {
+            Clock::time_point wakeUp = now + std::chrono::seconds(1);
+            if (!deliveries_.empty()) {
+                wakeUp = std::min(wakeUp, deliveries_.begin()->first);
+            }
+            if (flooding_ && scanning_) {
+                wakeUp = std::min(wakeUp, nextFlood_);
+            }
+            cv_.wait_until(lock, wakeUp);
+            continue;
+        }
+
+        while ((!deliveries_.empty()) && (deliveries_.begin()->first <= now) &&
+               (batch.size() < MAX_DELIVERIES_PER_ROUND)) {
+            batch.push_back(std::move(deliveries_.begin()->second));
+            deliveries_.erase(deliveries_.begin());
+        }
+        if (floodDue) {
+            nextFlood_ = now + std::chrono::microseconds(flood_.intervalUs);
+        }
+
+        // Callbacks into the host and the peer may call back into the controller.
+        lock.unlock();
+        for (auto &delivery : batch) {
+            Deliver(delivery, completed);
+        }
+        batch.clear();
+        if (!completed.empty()) {
+            SendNumberOfCompletedPackets(completed);
+            completed.clear();
+        }
+        if (floodDue) {
+            SendAdvertisingReports();
+        }
+        lock.lock();
+    }
+}
+
+void VirtualController::Deliver(Delivery &delivery, std::map<uint16_t, uint16_t> &completed)
+{
+    switch (delivery.type_) {
+        case HOST_EVENT:
+            events_++;
+            ToHost(PACKET_TYPE_EVENT, delivery.data_);
+            break;
+        case HOST_ACL: {
+            aclToHost_++;
+            aclBytesToHost_ += delivery.data_.size();
+            std::vector<uint8_t> packet;
+            packet.reserve(ACL_HEADER_SIZE + delivery.data_.size());
+            PutUint16(packet, static_cast<uint16_t>(delivery.handle_ | (delivery.packetBoundary_ << 12)));
+            PutUint16(packet, static_cast<uint16_t>(delivery.data_.size()));
+            packet.insert(packet.end(), delivery.data_.begin(), delivery.data_.end());
+            ToHost(PACKET_TYPE_ACL, packet);
+            break;
+        }
+        case PEER_ACL:
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                auto it = links_.find(delivery.handle_);
+                if ((it != links_.end()) && (it->second.inFlight_ > 0)) {
+                    it->second.inFlight_--;
+                }
+            }
+            completed[delivery.handle_]++;
+            if (peer_.onAclData != nullptr) {
+                peer_.onAclData(delivery.handle_,
+                    delivery.packetBoundary_,
+                    delivery.data_.data(),
+                    static_cast<uint16_t>(delivery.data_.size()),
+                    peerContext_);
+            }
+            break;
+        case PEER_CONNECTED:
+            if (peer_.onConnected != nullptr) {
+                peer_.onConnected(delivery.handle_, delivery.packetBoundary_, peerContext_);
+            }
+            break;
+        case PEER_DISCONNECTED:
+            if (peer_.onDisconnected != nullptr) {
+                peer_.onDisconnected(delivery.handle_, peerContext_);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void VirtualController::SendNumberOfCompletedPackets(const std::map<uint16_t, uint16_t> &completed)
+{
+    std::vector<uint8_t> packet;
+    packet.push_back(EVT_NUMBER_OF_COMPLETED_PACKETS);
+    packet.push_back(0);
+    packet.push_back(static_cast<uint8_t>(completed.size()));
+    for (auto &entry : completed) {
+        PutUint16(packet, entry.first);
+        PutUint16(packet, entry.second);
+    }
+    packet[1] = static_cast<uint8_t>(packet.size() - 2);
+    events_++;
+    ToHost(PACKET_TYPE_EVENT, packet);
+}
+
+void VirtualController::SendAdvertisingReports()
+{
+    VirtualAdvertisingFlood flood;
+    uint32_t firstAdvertiser;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        flood = flood_;
+        firstAdvertiser = nextAdvertiser_;
+        nextAdvertiser_ += flood.reportsPerEvent;
+    }
+
+    std::vector<uint8_t> packet;
+    packet.push_back(EVT_LE_META);
+    packet.push_back(0);
+    packet.push_back(LE_EVT_ADVERTISING_REPORT);
+    packet.push_back(flood.reportsPerEvent);
+    for (uint8_t i = 0; i < flood.reportsPerEvent; i++) {
+        uint16_t advertiser = static_cast<uint16_t>((firstAdvertiser + i) % flood.numAdvertisers);
+        packet.push_back(ADV_IND);
+        packet.push_back(ADDRESS_TYPE_RANDOM);
+        // Random static address: two most significant bits set.
+        uint8_t addr[ADDRESS_SIZE] = {
+            static_cast<uint8_t>(advertiser & 0xFF), static_cast<uint8_t>(advertiser >> 8), 0x00, 0x00, 0x00, 0xC0};
+        packet.insert(packet.end(), addr, addr + ADDRESS_SIZE);
+        packet.push_back(flood.dataLength);
+        if (flood.dataLength > 0) {
+            // One manufacturer specific AD structure filling the data.
+            packet.push_back(static_cast<uint8_t>(flood.dataLength - 1));
+            if (flood.dataLength > 1) {
+                packet.push_back(AD_TYPE_MANUFACTURER_SPECIFIC_DATA);
+                packet.insert(packet.end(), flood.dataLength - 2, static_cast<uint8_t>(advertiser));
+            }
+        }
+        packet.push_back(static_cast<uint8_t>(-60));
+    }
+    packet[1] = static_cast<uint8_t>(packet.size() - 2);
+    advertisingReports_ += flood.reportsPerEvent;
+    events_++;
+    ToHost(PACKET_TYPE_EVENT, packet);
+}
+
+void VirtualController::ToHost(BtPacketType type, std::vector<uint8_t> &data)
+{
+    BtPacket packet = {data.data(), static_cast<uint32_t>(data.size())};
+    callbacks_->OnReceivedHciPacket(type, &packet);
+}
+
+void VirtualController::Schedule(Clock::time_point due, Delivery delivery)
+{
+    deliveries_.emplace(due, std::move(delivery));
+}
+
+void VirtualController::QueueEvent(uint8_t code, const std::vector<uint8_t> &params)
+{
+    Delivery delivery;
+    delivery.type_ = HOST_EVENT;
+    delivery.data_.reserve(params.size() + 2);
+    delivery.data_.push_back(code);
+    delivery.data_.push_back(static_cast<uint8_t>(params.size()));
+    delivery.data_.insert(delivery.data_.end(), params.begin(), params.end());
+    Schedule(Clock::now(), std::move(delivery));
+}
+
+void VirtualController::QueueLeEvent(uint8_t subCode, const std::vector<uint8_t> &params)
+{
+    std::vector<uint8_t> metaParams;
+    metaParams.reserve(params.size() + 1);
+    metaParams.push_back(subCode);
+    metaParams.insert(metaParams.end(), params.begin(), params.end());
+    QueueEvent(EVT_LE_META, metaParams);
+}
+
+void VirtualController::CommandComplete(uint16_t opcode, const std::vector<uint8_t> &returnParams)
+{
+    std::vector<uint8_t> params;
+    params.push_back(1);
+    PutUint16(params, opcode);
+    params.insert(params.end(), returnParams.begin(), returnParams.end());
+    QueueEvent(EVT_COMMAND_COMPLETE, params);
+}
+
+void VirtualController::CommandStatus(uint16_t opcode, uint8_t status)
+{
+    std::vector<uint8_t> params;
+    params.push_back(status);
+    params.push_back(1);
+    PutUint16(params, opcode);
+    QueueEvent(EVT_COMMAND_STATUS, params);
+}
+
+void VirtualController::OnCommand(uint16_t opcode, const uint8_t *params, size_t length)
+{
+    if (OnInformationalCommand(opcode, params, length) || OnLeCommand(opcode, params, length) ||
+        OnLinkCommand(opcode, params, length)) {
+        return;
+    }
+    // Anything else is accepted with an empty return parameter list.
+    CommandComplete(opcode, {STATUS_SUCCESS});
+}
+
+bool VirtualController::OnInformationalCommand(uint16_t opcode, const uint8_t *params, size_t length)
+{
+    std::vector<uint8_t> ret = {STATUS_SUCCESS};
+    switch (opcode) {
+        case CMD_RESET:
+            scanning_ = false;
+            break;
+        case CMD_READ_LOCAL_NAME:
+            ret.insert(ret.end(), LOCAL_NAME_SIZE, 0);
+            break;
+        case CMD_READ_LOCAL_VERSION_INFORMATION:
+            ret.push_back(HCI_VERSION_5_0);
+            PutUint16(ret, 0);
+            ret.push_back(HCI_VERSION_5_0);
+            PutUint16(ret, MANUFACTURER_NAME);
+            PutUint16(ret, 0);
+            break;
+        case CMD_READ_LOCAL_SUPPORTED_COMMANDS:
+            ret.insert(ret.end(), SUPPORTED_COMMANDS_SIZE, 0xFF);
+            break;
+        case CMD_READ_LOCAL_SUPPORTED_FEATURES:
+            ret.insert(ret.end(), LMP_FEATURES, LMP_FEATURES + FEATURES_SIZE);
+            break;
+        case CMD_READ_LOCAL_EXTENDED_FEATURES: {
+            uint8_t page = (length > 0) ? params[0] : 0;
+            ret.push_back(page);
+            ret.push_back(1);
+            const uint8_t *features = (page == 0) ? LMP_FEATURES : LMP_HOST_FEATURES;
+            ret.insert(ret.end(), features, features + FEATURES_SIZE);
+            break;
+        }
+        case CMD_READ_BUFFER_SIZE:
+            PutUint16(ret, config_.aclDataLength);
+            ret.push_back(SCO_DATA_LENGTH);
+            PutUint16(ret, config_.aclCredits);
+            PutUint16(ret, SCO_CREDITS);
+            break;
+        case CMD_READ_BD_ADDR:
+            ret.insert(ret.end(), config_.localAddr, config_.localAddr + ADDRESS_SIZE);
+            break;
+        default:
+            return false;
+    }
+    CommandComplete(opcode, ret);
+    return true;
+}
+
+bool VirtualController::OnLeCommand(uint16_t opcode, const uint8_t *params, size_t length)
+{
+    std::vector<uint8_t> ret = {STATUS_SUCCESS};
+    switch (opcode) {
+        case CMD_LE_READ_BUFFER_SIZE:
+            PutUint16(ret, config_.leAclDataLength);
+            ret.push_back(config_.leAclCredits);
+            break;
+        case CMD_LE_READ_LOCAL_SUPPORTED_FEATURES:
+            ret.insert(ret.end(), LE_FEATURES, LE_FEATURES + FEATURES_SIZE);
+            break;
+        case CMD_LE_SET_SCAN_ENABLE:
+        case CMD_LE_SET_EXTENDED_SCAN_ENABLE:
+            scanning_ = (length > 0) && (params[0] != 0);
+            break;
+        case CMD_LE_READ_WHITE_LIST_SIZE:
+            ret.push_back(WHITE_LIST_SIZE);
+            break;
+        case CMD_LE_READ_RESOLVING_LIST_SIZE:
+            ret.push_back(RESOLVING_LIST_SIZE);
+            break;
+        case CMD_LE_ADD_DEVICE_TO_WHITE_LIST:
+            if (length >= 1 + ADDRESS_SIZE) {
+                whiteListAddrType_ = params[0];
+                std::copy(params + 1, params + 1 + ADDRESS_SIZE, whiteListAddr_);
+            }
+            break;
+        case CMD_LE_ENCRYPT:
+            ret.insert(ret.end(), 16, 0);
+            break;
+        case CMD_LE_RAND:
+            for (int i = 0; i < 8; i++) {
+                ret.push_back(static_cast<uint8_t>(random_()));
+            }
+            break;
+        case CMD_LE_READ_SUPPORTED_STATES:
+            ret.insert(ret.end(), FEATURES_SIZE, 0xFF);
+            break;
+        case CMD_LE_SET_DATA_LENGTH:
+            PutUint16(ret, (length >= 2) ? GetUint16(params) : 0);
+            break;
+        case CMD_LE_READ_MAXIMUM_DATA_LENGTH:
+            PutUint16(ret, LE_MAX_OCTETS);
+            PutUint16(ret, LE_MAX_TIME);
+            PutUint16(ret, LE_MAX_OCTETS);
+            PutUint16(ret, LE_MAX_TIME);
+            break;
+        default:
+            return false;
+    }
+    CommandComplete(opcode, ret);
+    return true;
+}
+
+bool VirtualController::OnLinkCommand(uint16_t opcode, const uint8_t *params, size_t length)
+{
+    switch (opcode) {
+        case CMD_CREATE_CONNECTION: {
+            if (length < ADDRESS_SIZE) {
+                CommandStatus(opcode, STATUS_UNSUPPORTED_FEATURE);
+                break;
+            }
+            CommandStatus(opcode, STATUS_SUCCESS);
+            uint16_t handle = CreateLink(VIRTUAL_CONTROLLER_TRANSPORT_BREDR);
+            std::vector<uint8_t> evt = {STATUS_SUCCESS};
+            PutUint16(evt, handle);
+            evt.insert(evt.end(), params, params + ADDRESS_SIZE);
+            evt.push_back(0x01);  // ACL link
+            evt.push_back(0x00);  // Encryption disabled
+            QueueEvent(EVT_CONNECTION_COMPLETE, evt);
+            break;
+        }
+        case CMD_LE_CREATE_CONNECTION: {
+            // scan interval, scan window, initiator filter policy, peer address type, peer address, own address
+            // type, interval min, interval max, latency, supervision timeout, CE length min, CE length max
+            const size_t filterPolicyOffset = 4;
+            const size_t peerAddrTypeOffset = 5;
+            const size_t peerAddrOffset = 6;
+            const size_t intervalMaxOffset = 15;
+            const size_t latencyOffset = 17;
+            const size_t timeoutOffset = 19;
+            if (length < timeoutOffset + 2) {
+                CommandStatus(opcode, STATUS_UNSUPPORTED_FEATURE);
+                break;
+            }
+            CommandStatus(opcode, STATUS_SUCCESS);
+            bool useWhiteList = params[filterPolicyOffset] != 0;
+            uint16_t handle = CreateLink(VIRTUAL_CONTROLLER_TRANSPORT_LE);
+            std::vector<uint8_t> evt = {STATUS_SUCCESS};
+            PutUint16(evt, handle);
+            evt.push_back(0x00);  // Master
+            if (useWhiteList) {
+                evt.push_back(whiteListAddrType_);
+                evt.insert(evt.end(), whiteListAddr_, whiteListAddr_ + ADDRESS_SIZE);
+            } else {
+                evt.push_back(params[peerAddrTypeOffset]);
+                evt.insert(evt.end(), params + peerAddrOffset, params + peerAddrOffset + ADDRESS_SIZE);
+            }
+            evt.insert(evt.end(), params + intervalMaxOffset, params + intervalMaxOffset + 2);
+            evt.insert(evt.end(), params + latencyOffset, params + latencyOffset + 2);
+            evt.insert(evt.end(), params + timeoutOffset, params + timeoutOffset + 2);
+            evt.push_back(0x00);  // Master clock accuracy
+            QueueLeEvent(LE_EVT_CONNECTION_COMPLETE, evt);
+            break;
+        }
+        case CMD_DISCONNECT: {
+            uint16_t handle = (length >= 2) ? GetUint16(params) : 0;
+            if (links_.find(handle) == links_.end()) {
+                CommandStatus(opcode, STATUS_UNKNOWN_CONNECTION_IDENTIFIER);
+                break;
+            }
+            CommandStatus(opcode, STATUS_SUCCESS);
+            RemoveLink(handle);
+            std::vector<uint8_t> evt = {STATUS_SUCCESS};
+            PutUint16(evt, handle);
+            evt.push_back(REASON_CONNECTION_TERMINATED_BY_LOCAL_HOST);
+            QueueEvent(EVT_DISCONNECTION_COMPLETE, evt);
+            break;
+        }
+        case CMD_REMOTE_NAME_REQUEST: {
+            if (length < ADDRESS_SIZE) {
+                CommandStatus(opcode, STATUS_UNSUPPORTED_FEATURE);
+                break;
+            }
+            CommandStatus(opcode, STATUS_SUCCESS);
+            std::vector<uint8_t> evt = {STATUS_SUCCESS};
+            evt.insert(evt.end(), params, params + ADDRESS_SIZE);
+            evt.insert(evt.end(), PEER_NAME, PEER_NAME + sizeof(PEER_NAME));
+            evt.resize(1 + ADDRESS_SIZE + LOCAL_NAME_SIZE, 0);
+            QueueEvent(EVT_REMOTE_NAME_REQUEST_COMPLETE, evt);
+            break;
+        }
+        case CMD_READ_REMOTE_SUPPORTED_FEATURES:
+        case CMD_READ_REMOTE_EXTENDED_FEATURES:
+        case CMD_READ_REMOTE_VERSION_INFORMATION:
+        case CMD_LE_READ_REMOTE_FEATURES: {
+            uint16_t handle = (length >= 2) ? GetUint16(params) : 0;
+            if (links_.find(handle) == links_.end()) {
+                CommandStatus(opcode, STATUS_UNKNOWN_CONNECTION_IDENTIFIER);
+                break;
+            }
+            CommandStatus(opcode, STATUS_SUCCESS);
+            std::vector<uint8_t> evt = {STATUS_SUCCESS};
+            PutUint16(evt, handle);
+            if (opcode == CMD_READ_REMOTE_VERSION_INFORMATION) {
+                evt.push_back(HCI_VERSION_5_0);
+                PutUint16(evt, MANUFACTURER_NAME);
+                PutUint16(evt, 0);
+                QueueEvent(EVT_READ_REMOTE_VERSION_INFORMATION_COMPLETE, evt);
+            } else if (opcode == CMD_READ_REMOTE_EXTENDED_FEATURES) {
+                uint8_t page = (length >= 3) ? params[2] : 0;
+                const uint8_t *features = (page == 0) ? LMP_FEATURES : LMP_HOST_FEATURES;
+                evt.push_back(page);
+                evt.push_back(1);
+                evt.insert(evt.end(), features, features + FEATURES_SIZE);
+                QueueEvent(EVT_READ_REMOTE_EXTENDED_FEATURES_COMPLETE, evt);
+            } else if (opcode == CMD_LE_READ_REMOTE_FEATURES) {
+                evt.insert(evt.end(), LE_FEATURES, LE_FEATURES + FEATURES_SIZE);
+                QueueLeEvent(LE_EVT_READ_REMOTE_FEATURES_COMPLETE, evt);
+            } else {
+                evt.insert(evt.end(), LMP_FEATURES, LMP_FEATURES + FEATURES_SIZE);
+                QueueEvent(EVT_READ_REMOTE_SUPPORTED_FEATURES_COMPLETE, evt);
+            }
+            break;
+        }
+        case CMD_LE_CONNECTION_UPDATE: {
+            // handle, interval min, interval max, latency, supervision timeout, CE length min, CE length max
+            const size_t intervalMaxOffset = 4;
+            if (length < intervalMaxOffset + 6) {
+                CommandStatus(opcode, STATUS_UNSUPPORTED_FEATURE);
+                break;
+            }
+            CommandStatus(opcode, STATUS_SUCCESS);
+            std::vector<uint8_t> evt = {STATUS_SUCCESS};
+            evt.insert(evt.end(), params, params + 2);
+            evt.insert(evt.end(), params + intervalMaxOffset, params + intervalMaxOffset + 6);
+            QueueLeEvent(LE_EVT_CONNECTION_UPDATE_COMPLETE, evt);
+            break;
+        }
+        case CMD_READ_RSSI: {
+            uint16_t handle = (length >= 2) ? GetUint16(params) : 0;
+            std::vector<uint8_t> ret = {
+                (links_.find(handle) != links_.end()) ? STATUS_SUCCESS : STATUS_UNKNOWN_CONNECTION_IDENTIFIER};
+            PutUint16(ret, handle);
+            ret.push_back(static_cast<uint8_t>(PEER_RSSI));
+            CommandComplete(opcode, ret);
+            break;
+        }
+        case CMD_CHANGE_CONNECTION_PACKET_TYPE:
+        case CMD_AUTHENTICATION_REQUESTED:
+        case CMD_SET_CONNECTION_ENCRYPTION:
+        case CMD_SNIFF_MODE:
+        case CMD_EXIT_SNIFF_MODE:
+        case CMD_SWITCH_ROLE:
+        case CMD_LE_START_ENCRYPTION:
+        case CMD_LE_READ_LOCAL_P256_PUBLIC_KEY:
+        case CMD_LE_GENERATE_DHKEY:
+        case CMD_LE_SET_PHY:
+            // Security, power, packet type and PHY procedures are not emulated.
+            CommandStatus(opcode, STATUS_UNSUPPORTED_FEATURE);
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+void VirtualController::OnAclFromHost(const uint8_t *data, size_t length)
+{
+    uint16_t handleAndFlags = GetUint16(data);
+    uint16_t handle = handleAndFlags & 0x0FFF;
+    uint16_t dataLength = GetUint16(data + 2);
+    if (ACL_HEADER_SIZE + dataLength > length) {
+        return;
+    }
+
+    auto it = links_.find(handle);
+    if (it == links_.end()) {
+        return;
+    }
+    uint16_t credits = (it->second.transport_ == VIRTUAL_CONTROLLER_TRANSPORT_LE) ? config_.leAclCredits
+                                                                                   : config_.aclCredits;
+    if (it->second.inFlight_ >= credits) {
+        creditOverruns_++;
+    }
+    it->second.inFlight_++;
+    aclToController_++;
+    aclBytesToController_ += dataLength;
+
+    Delivery delivery;
+    delivery.type_ = PEER_ACL;
+    delivery.handle_ = handle;
+    delivery.packetBoundary_ = static_cast<uint8_t>((handleAndFlags >> 12) & 0x03);
+    delivery.data_.assign(data + ACL_HEADER_SIZE, data + ACL_HEADER_SIZE + dataLength);
+    Schedule(Clock::now() + std::chrono::microseconds(config_.linkLatencyUs), std::move(delivery));
+}
+
+uint16_t VirtualController::CreateLink(uint8_t transport)
+{
+    uint16_t handle = nextHandle_++;
+    if (nextHandle_ > 0x0EFF) {
+        nextHandle_ = 1;
+    }
+    Link link;
+    link.transport_ = transport;
+    links_[handle] = link;
+
+    Delivery delivery;
+    delivery.type_ = PEER_CONNECTED;
+    delivery.handle_ = handle;
+    delivery.packetBoundary_ = transport;
+    Schedule(Clock::now(), std::move(delivery));
+    return handle;
+}
+
+void VirtualController::RemoveLink(uint16_t handle)
+{
+    links_.erase(handle);
+
+    Delivery delivery;
+    delivery.type_ = PEER_DISCONNECTED;
+    delivery.handle_ = handle;
+    Schedule(Clock::now(), std::move(delivery));
+}
+}  // namespace bluetooth
+
+using bluetooth::VirtualController;
+
+int HalInit(BtHciCallbacks *callbacks)
+{
+    return VirtualController::GetInstance().Init(callbacks);
+}
+
+int HalSendHciPacket(BtPacketType type, const BtPacket *packet)
+{
+    return VirtualController::GetInstance().SendHciPacket(type, packet);
+}
+
+void HalClose(void)
+{
+    VirtualController::GetInstance().Close();
+}
+
+void VirtualControllerGetDefaultConfig(VirtualControllerConfig *config)
+{
+    if (config == nullptr) {
+        return;
+    }
+    const uint8_t localAddr[] = {0x01, 0x00, 0x00, 0xDA, 0x1A, 0x00};
+    const uint8_t peerAddr[] = {0x02, 0x00, 0x00, 0xDA, 0x1A, 0x00};
+    std::copy(localAddr, localAddr + sizeof(localAddr), config->localAddr);
+    std::copy(peerAddr, peerAddr + sizeof(peerAddr), config->peerAddr);
+    config->aclDataLength = 1021;
+    config->aclCredits = 8;
+    config->leAclDataLength = 251;
+    config->leAclCredits = 8;
+    config->linkLatencyUs = 0;
+}
+
+void VirtualControllerSetConfig(const VirtualControllerConfig *config)
+{
+    if (config != nullptr) {
+        VirtualController::GetInstance().SetConfig(*config);
+    }
+}
+
+void VirtualPeerRegisterCallbacks(const VirtualPeerCallbacks *callbacks, void *context)
+{
+    VirtualController::GetInstance().RegisterPeer(callbacks, context);
+}
+
+int VirtualPeerSendAcl(uint16_t handle, const uint8_t *data, uint16_t length)
+{
+    return VirtualController::GetInstance().PeerSendAcl(handle, data, length);
+}
+
+uint16_t VirtualPeerConnectLe(uint8_t addrType, const uint8_t addr[6])
+{
+    return VirtualController::GetInstance().PeerConnectLe(addrType, addr);
+}
+
+int VirtualPeerDisconnect(uint16_t handle)
+{
+    return VirtualController::GetInstance().PeerDisconnect(handle);
+}
+
+void VirtualControllerStartAdvertisingFlood(const VirtualAdvertisingFlood *flood)
+{
+    if (flood != nullptr) {
+        VirtualController::GetInstance().StartAdvertisingFlood(*flood);
+    }
+}
+
+void VirtualControllerStopAdvertisingFlood(void)
+{
+    VirtualController::GetInstance().StopAdvertisingFlood();
+}
+
+void VirtualControllerGetStatistics(VirtualControllerStatistics *statistics)
+{
+    if (statistics != nullptr) {
+        VirtualController::GetInstance().GetStatistics(*statistics);
+    }
+}
+
+void VirtualControllerResetStatistics(void)
+{
+    VirtualController::GetInstance().ResetStatistics();
+}
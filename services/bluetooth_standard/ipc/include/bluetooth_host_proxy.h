@@ -91,6 +91,7 @@ public:
     void DeregisterBleAdapterObserver(const sptr<IBluetoothHostObserver> &observer) override;
     void RegisterBlePeripheralCallback(const sptr<IBluetoothBlePeripheralObserver> &observer) override;
     void DeregisterBlePeripheralCallback(const sptr<IBluetoothBlePeripheralObserver> &observer) override;
+    std::string GetPerformanceCounters() override;
 
 private:
     ErrCode InnerTransact(uint32_t code, MessageOption &flags, MessageParcel &data, MessageParcel &reply);
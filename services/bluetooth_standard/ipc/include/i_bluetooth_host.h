@@ -113,6 +113,7 @@ public:
         BT_DEREGISTER_BLE_ADAPTER_OBSERVER,
         BT_REGISTER_BLE_PERIPHERAL_OBSERVER,
         BT_DEREGISTER_BLE_PERIPHERAL_OBSERVER,
+        GET_PERFORMANCE_COUNTERS,
     };
 
     virtual void RegisterObserver(const sptr<IBluetoothHostObserver> &observer) = 0;
@@ -177,6 +178,7 @@ public:
     virtual void DeregisterBleAdapterObserver(const sptr<IBluetoothHostObserver> &observer) = 0;
     virtual void RegisterBlePeripheralCallback(const sptr<IBluetoothBlePeripheralObserver> &observer) = 0;
     virtual void DeregisterBlePeripheralCallback(const sptr<IBluetoothBlePeripheralObserver> &observer) = 0;
+    virtual std::string GetPerformanceCounters() = 0;
 };
 }  // namespace Bluetooth
 }  // namespace OHOS
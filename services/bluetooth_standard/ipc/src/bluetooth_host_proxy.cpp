@@ -1407,6 +1407,28 @@ void BluetoothHostProxy::DeregisterBlePeripheralCallback(const sptr<IBluetoothBl
     return;
 }
 
+std::string BluetoothHostProxy::GetPerformanceCounters()
+{
+    std::string counters;
+    MessageParcel data;
+    if (!data.WriteInterfaceToken(BluetoothHostProxy::GetDescriptor())) {
+        HILOGE("BluetoothHostProxy::GetPerformanceCounters WriteInterfaceToken error");
+        return "";
+    }
+    MessageParcel reply;
+    MessageOption option{MessageOption::TF_SYNC};
+    int32_t error = InnerTransact(IBluetoothHost::Code::GET_PERFORMANCE_COUNTERS, option, data, reply);
+    if (error != NO_ERROR) {
+        HILOGE("BluetoothHostProxy::GetPerformanceCounters done fail, error: %{public}d", error);
+        return "";
+    }
+    if (!reply.ReadString(counters)) {
+        HILOGE("BluetoothHostProxy::GetPerformanceCounters Read reply fail");
+        return "";
+    }
+    return counters;
+}
+
 ErrCode BluetoothHostProxy::InnerTransact(
     uint32_t code, MessageOption &flags, MessageParcel &data, MessageParcel &reply)
 {
@@ -206,6 +206,9 @@ const std::map<uint32_t, std::function<ErrCode(BluetoothHostStub *, MessageParce
         {BluetoothHostStub::BT_DEREGISTER_BLE_PERIPHERAL_OBSERVER,
             std::bind(&BluetoothHostStub::DeregisterBlePeripheralCallbackInner, std::placeholders::_1,
                 std::placeholders::_2, std::placeholders::_3)},
+        {BluetoothHostStub::GET_PERFORMANCE_COUNTERS,
+            std::bind(&BluetoothHostStub::GetPerformanceCountersInner, std::placeholders::_1,
+                std::placeholders::_2, std::placeholders::_3)},
 
 };
 
@@ -1170,5 +1173,16 @@ ErrCode BluetoothHostStub::DeregisterBlePeripheralCallbackInner(MessageParcel &d
     return NO_ERROR;
 }
 
+ErrCode BluetoothHostStub::GetPerformanceCountersInner(MessageParcel &data, MessageParcel &reply)
+{
+    std::string result = GetPerformanceCounters();
+    bool ret = reply.WriteString(result);
+    if (!ret) {
+        HILOGE("BluetoothHostStub: reply writing failed in: %{public}s.", __func__);
+        return TRANSACTION_ERR;
+    }
+    return NO_ERROR;
+}
+
 }  // namespace Bluetooth
 }  // namespace OHOS
@@ -40,6 +40,7 @@ public:
 
     void OnStart() override;
     void OnStop() override;
+    int32_t Dump(int32_t fd, const std::vector<std::u16string> &args) override;
 
     void RegisterObserver(const sptr<IBluetoothHostObserver> &observer) override;
     void DeregisterObserver(const sptr<IBluetoothHostObserver> &observer) override;
@@ -112,6 +113,7 @@ public:
     void DeregisterBlePeripheralCallback(const sptr<IBluetoothBlePeripheralObserver> &observer) override;
     void GetLocalSupportedUuids(std::vector<std::string> &uuids) override;
     std::vector<bluetooth::Uuid> GetDeviceUuids(int32_t transport, const std::string &address) override;
+    std::string GetPerformanceCounters() override;
 
 private:
     static sptr<BluetoothHostServer> instance;
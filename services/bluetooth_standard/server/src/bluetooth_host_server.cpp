@@ -16,6 +16,7 @@
 #include "bluetooth_host_server.h"
 
 #include <thread>
+#include <unistd.h>
 
 #include "bluetooth_a2dp_source_server.h"
 #include "bluetooth_ble_advertiser_server.h"
@@ -1243,5 +1244,23 @@ void BluetoothHostServer::DeregisterBlePeripheralCallback(const sptr<IBluetoothB
     pimpl->bleRemoteObservers_.Deregister(observer);
 }
 
+std::string BluetoothHostServer::GetPerformanceCounters()
+{
+    HILOGD("[%{public}s]: %{public}s(): Enter!", __FILE__, __FUNCTION__);
+    return IAdapterManager::GetInstance()->GetPerformanceCounters();
+}
+
+int32_t BluetoothHostServer::Dump(int32_t fd, const std::vector<std::u16string> &args)
+{
+    HILOGI("BluetoothHostServer::Dump start.");
+
+    std::string counters = IAdapterManager::GetInstance()->GetPerformanceCounters();
+    if (write(fd, counters.c_str(), counters.size()) < 0) {
+        HILOGE("[%{public}s]: %{public}s() write failed!", __FILE__, __FUNCTION__);
+        return ERR_INVALID_VALUE;
+    }
+    return ERR_OK;
+}
+
 }  // namespace Bluetooth
 }  // namespace OHOS
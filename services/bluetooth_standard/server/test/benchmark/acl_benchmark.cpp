@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "benchmark_environment.h"
+#include "btm.h"
+
+namespace bluetooth {
+namespace {
+constexpr uint8_t PEER_ADDRESS_TYPE_PUBLIC = 0x00;
+
+BenchmarkCounter g_leConnected;
+BenchmarkCounter g_leDisconnected;
+BenchmarkCounter g_rssiRead;
+// Static, an event handler may still be dispatching through it when the links are gone.
+BtmAclCallbacks g_aclCallbacks {};
+
+void OnLeConnectionComplete(uint8_t status, uint16_t connectionHandle, const BtAddr *addr, uint8_t role, void *context)
+{
+    if ((status == 0) && (role == LE_CONNECTION_ROLE_SLAVE)) {
+        g_leConnected.Add();
+    }
+}
+
+void OnLeDisconnectionComplete(uint8_t status, uint16_t connectionHandle, uint8_t reason, void *context)
+{
+    if (status == 0) {
+        g_leDisconnected.Add();
+    }
+}
+
+void OnReadRssiComplete(uint8_t status, const BtAddr *addr, int8_t rssi, void *context)
+{
+    if (status == 0) {
+        g_rssiRead.Add();
+    }
+}
+
+/**
+ * @brief LE links the virtual peer opens to the host under test, each from its own address.
+ */
+class LeLinks {
+public:
+    LeLinks()
+    {
+        g_aclCallbacks.leConnectionComplete = OnLeConnectionComplete;
+        g_aclCallbacks.leDisconnectionComplete = OnLeDisconnectionComplete;
+        g_aclCallbacks.readRssiComplete = OnReadRssiComplete;
+        BTM_RegisterAclCallbacks(&g_aclCallbacks, nullptr);
+    }
+
+    ~LeLinks()
+    {
+        Disconnect();
+        BTM_DeregisterAclCallbacks(&g_aclCallbacks);
+    }
+
+    bool Connect(int count)
+    {
+        uint64_t expected = g_leConnected.Get();
+        for (int i = 0; i < count; i++) {
+            Link link;
+            link.addr_.type = BT_PUBLIC_DEVICE_ADDRESS;
+            link.addr_.addr[0] = static_cast<uint8_t>(i);
+            link.addr_.addr[1] = static_cast<uint8_t>(i >> 8);
+            link.addr_.addr[2] = 0xBE;  // Unlike the default peer address.
+            link.addr_.addr[3] = 0xDA;
+            link.addr_.addr[4] = 0x1A;
+            link.addr_.addr[5] = 0x00;
+            link.handle_ = VirtualPeerConnectLe(PEER_ADDRESS_TYPE_PUBLIC, link.addr_.addr);
+            if (link.handle_ == 0) {
+                return false;
+            }
+            links_.push_back(link);
+        }
+        return g_leConnected.WaitFor(expected + count);
+    }
+
+    void Disconnect()
+    {
+        uint64_t expected = g_leDisconnected.Get() + links_.size();
+        for (auto &link : links_) {
+            VirtualPeerDisconnect(link.handle_);
+        }
+        links_.clear();
+        g_leDisconnected.WaitFor(expected);
+    }
+
+    struct Link {
+        uint16_t handle_ = 0;
+        BtAddr addr_ {};
+    };
+
+    const std::vector<Link> &Get() const
+    {
+        return links_;
+    }
+
+private:
+    std::vector<Link> links_ {};
+};
+}  // namespace
+
+// Connection lookups by handle, as every ACL event handler of BTM does, with the given number of LE links up.
+static void BM_BtmAclLookupByHandle(benchmark::State &state)
+{
+    LeLinks links;
+    if (!links.Connect(state.range(0))) {
+        state.SkipWithError("LE links not connected");
+        return;
+    }
+
+    BtAddr localAddr = {};
+    BtAddr peerAddr = {};
+    for (auto _ : state) {
+        for (auto &link : links.Get()) {
+            benchmark::DoNotOptimize(BTM_GetAclTranspot(link.handle_));
+            benchmark::DoNotOptimize(BTM_GetLeConnectionAddress(link.handle_, &localAddr, &peerAddr));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_BtmAclLookupByHandle)->Arg(1)->Arg(8)->Arg(32)->Arg(48);
+
+// Read RSSI round trips on every LE link: an address lookup for the command, then a handle lookup and a callback
+// dispatch for the event, as the connection, encryption and role change events go through.
+static void BM_BtmAclLeEventRoundTrip(benchmark::State &state)
+{
+    LeLinks links;
+    if (!links.Connect(state.range(0))) {
+        state.SkipWithError("LE links not connected");
+        return;
+    }
+
+    uint64_t expected = g_rssiRead.Get();
+    for (auto _ : state) {
+        for (auto &link : links.Get()) {
+            BTM_ReadRssi(&link.addr_);
+        }
+        expected += links.Get().size();
+        if (!g_rssiRead.WaitFor(expected)) {
+            state.SkipWithError("Read RSSI not completed");
+            break;
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_BtmAclLeEventRoundTrip)->Arg(1)->Arg(8)->Arg(32)->Arg(48)->UseRealTime()->Unit(benchmark::kMicrosecond);
+}  // namespace bluetooth
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark_environment.h"
+
+#include <algorithm>
+
+#include "btm.h"
+#include "log.h"
+#include "virtual_peer.h"
+
+namespace bluetooth {
+namespace {
+VirtualControllerConfig g_config {};
+bool g_started = false;
+}  // namespace
+
+bool BenchmarkEnvironment::Start(const VirtualControllerConfig &config)
+{
+    g_config = config;
+    VirtualControllerSetConfig(&g_config);
+    VirtualPeer::GetInstance().Attach();
+
+    if (BTM_Initialize() != BT_NO_ERROR) {
+        LOG_ERROR("%{public}s: BTM_Initialize failed", __func__);
+        return false;
+    }
+    if (BTM_Enable(BREDR_CONTROLLER) != BT_NO_ERROR) {
+        LOG_ERROR("%{public}s: BTM_Enable(BREDR_CONTROLLER) failed", __func__);
+        BTM_Close();
+        return false;
+    }
+    if (BTM_Enable(LE_CONTROLLER) != BT_NO_ERROR) {
+        LOG_ERROR("%{public}s: BTM_Enable(LE_CONTROLLER) failed", __func__);
+        BTM_Disable(BREDR_CONTROLLER);
+        BTM_Close();
+        return false;
+    }
+    g_started = true;
+    return true;
+}
+
+void BenchmarkEnvironment::Stop()
+{
+    if (!g_started) {
+        return;
+    }
+    BTM_Disable(LE_CONTROLLER);
+    BTM_Disable(BREDR_CONTROLLER);
+    BTM_Close();
+    g_started = false;
+}
+
+const VirtualControllerConfig &BenchmarkEnvironment::GetConfig()
+{
+    return g_config;
+}
+
+BtAddr BenchmarkEnvironment::GetPeerAddress()
+{
+    BtAddr addr = {};
+    std::copy(g_config.peerAddr, g_config.peerAddr + BT_ADDRESS_SIZE, addr.addr);
+    addr.type = BT_PUBLIC_DEVICE_ADDRESS;
+    return addr;
+}
+}  // namespace bluetooth
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BENCHMARK_ENVIRONMENT_H
+#define BENCHMARK_ENVIRONMENT_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+#include "btstack.h"
+#include "virtual_controller.h"
+
+namespace bluetooth {
+constexpr std::chrono::milliseconds BENCHMARK_TIMEOUT {10000};
+
+/**
+ * @brief Host stack running on top of the virtual controller, shared by all benchmarks of the process.
+ */
+class BenchmarkEnvironment {
+public:
+    // Brings up btstack on BR/EDR and LE with the given controller configuration.
+    static bool Start(const VirtualControllerConfig &config);
+    static void Stop();
+
+    static const VirtualControllerConfig &GetConfig();
+
+    // Address of the virtual peer as the host addresses it.
+    static BtAddr GetPeerAddress();
+};
+
+/**
+ * @brief Counter a benchmark waits on while stack callbacks advance it.
+ */
+class BenchmarkCounter {
+public:
+    void Add(uint64_t value = 1)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            value_ += value;
+        }
+        cv_.notify_all();
+    }
+
+    uint64_t Get()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return value_;
+    }
+
+    void Reset()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        value_ = 0;
+    }
+
+    bool WaitFor(uint64_t value, std::chrono::milliseconds timeout = BENCHMARK_TIMEOUT)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cv_.wait_for(lock, timeout, [this, value]() { return value_ >= value; });
+    }
+
+private:
+    std::mutex mutex_ {};
+    std::condition_variable cv_ {};
+    uint64_t value_ = 0;
+};
+}  // namespace bluetooth
+
+#endif  // BENCHMARK_ENVIRONMENT_H
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <benchmark/benchmark.h>
+
+#include "benchmark_environment.h"
+
+namespace {
+/**
+ * Virtual controller options, removed from argv before Google Benchmark parses the rest:
+ *   --vc_acl_length=N      BR/EDR ACL data length
+ *   --vc_acl_credits=N     BR/EDR ACL buffers
+ *   --vc_le_length=N       LE ACL data length
+ *   --vc_le_credits=N      LE ACL buffers
+ *   --vc_latency_us=N      one-way link latency
+ */
+bool ParseControllerOption(const char *arg, VirtualControllerConfig &config)
+{
+    struct Option {
+        const char *prefix;
+        unsigned long max;
+        void (*apply)(VirtualControllerConfig &config, unsigned long value);
+    };
+    static const Option options[] = {
+        {"--vc_acl_length=", 0xFFFF, [](VirtualControllerConfig &c, unsigned long v) { c.aclDataLength = v; }},
+        {"--vc_acl_credits=", 0xFFFF, [](VirtualControllerConfig &c, unsigned long v) { c.aclCredits = v; }},
+        {"--vc_le_length=", 0xFFFF, [](VirtualControllerConfig &c, unsigned long v) { c.leAclDataLength = v; }},
+        {"--vc_le_credits=", 0xFF, [](VirtualControllerConfig &c, unsigned long v) { c.leAclCredits = v; }},
+        {"--vc_latency_us=", 0xFFFFFFFF, [](VirtualControllerConfig &c, unsigned long v) { c.linkLatencyUs = v; }},
+    };
+
+    for (auto &option : options) {
+        size_t prefixLength = strlen(option.prefix);
+        if (strncmp(arg, option.prefix, prefixLength) != 0) {
+            continue;
+        }
+        char *end = nullptr;
+        unsigned long value = strtoul(arg + prefixLength, &end, 10);
+        if ((end == arg + prefixLength) || (*end != '\0') || (value > option.max)) {
+            fprintf(stderr, "Invalid value: %s\n", arg);
+            exit(EXIT_FAILURE);
+        }
+        option.apply(config, value);
+        return true;
+    }
+    return false;
+}
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    VirtualControllerConfig config = {};
+    VirtualControllerGetDefaultConfig(&config);
+    int remaining = 1;
+    for (int i = 1; i < argc; i++) {
+        if (!ParseControllerOption(argv[i], config)) {
+            argv[remaining++] = argv[i];
+        }
+    }
+    argc = remaining;
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return EXIT_FAILURE;
+    }
+    if (!bluetooth::BenchmarkEnvironment::Start(config)) {
+        fprintf(stderr, "Failed to start the host stack on the virtual controller\n");
+        return EXIT_FAILURE;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    bluetooth::BenchmarkEnvironment::Stop();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "att.h"
+#include "benchmark_environment.h"
+#include "virtual_peer.h"
+
+namespace bluetooth {
+namespace {
+constexpr uint16_t NOTIFIED_ATT_HANDLE = 0x002A;
+constexpr uint32_t NOTIFICATIONS_PER_ITERATION = 256;
+constexpr uint16_t CLIENT_RX_MTU = 247;
+// 7.5 ms connection interval, no latency, 2 s supervision timeout.
+constexpr AttLeConnect LE_CONNECTION_PARAMETERS = {0x0006, 0x0006, 0x0000, 0x00C8};
+
+BenchmarkCounter g_connected;
+BenchmarkCounter g_mtuExchanged;
+BenchmarkCounter g_notifications;
+uint16_t g_attConnectHandle = 0;
+
+void OnLeConnectCompleted(uint16_t connectHandle, AttLeConnectCallback *data, void *context)
+{
+    if ((data != nullptr) && (data->status == 0)) {
+        g_attConnectHandle = connectHandle;
+        g_connected.Add();
+    }
+}
+
+void OnLeDisconnectCompleted(uint16_t connectHandle, AttLeDisconnectCallback *data, void *context)
+{}
+
+void OnBredrConnectCompleted(uint16_t connectHandle, AttBredrConnectCallback *data, void *context)
+{}
+
+void OnBredrDisconnectCompleted(uint16_t connectHandle, AttBredrDisconnectCallback *data, void *context)
+{}
+
+void OnBredrConnectInd(uint16_t connectHandle, void *context)
+{}
+
+void OnClientData(uint16_t connectHandle, uint16_t event, void *eventData, Buffer *buffer, void *context)
+{
+    if (event == ATT_HANDLE_VALUE_NOTIFICATION_ID) {
+        g_notifications.Add();
+    } else if (event == ATT_EXCHANGE_MTU_RESPONSE_ID) {
+        g_mtuExchanged.Add();
+    }
+}
+
+uint16_t ConnectLe()
+{
+    static uint16_t handle = 0;
+    if (handle != 0) {
+        return handle;
+    }
+
+    AttConnectCallback callback = {OnLeConnectCompleted,
+        OnLeDisconnectCompleted,
+        OnBredrConnectCompleted,
+        OnBredrDisconnectCompleted,
+        OnBredrConnectInd};
+    ATT_ConnectRegister(callback, nullptr);
+    ATT_ClientDataRegister(OnClientData, nullptr);
+
+    AttConnect cfg = {};
+    cfg.leConnParaVar = LE_CONNECTION_PARAMETERS;
+    BtAddr addr = BenchmarkEnvironment::GetPeerAddress();
+    uint16_t unused = 0;
+    ATT_ConnectReq(BT_TRANSPORT_LE, &cfg, &addr, &unused);
+    if (!g_connected.WaitFor(1)) {
+        return 0;
+    }
+    // Large values need a larger ATT_MTU than the default 23.
+    ATT_ExchangeMTURequest(g_attConnectHandle, CLIENT_RX_MTU);
+    if (!g_mtuExchanged.WaitFor(1)) {
+        return 0;
+    }
+    handle = VirtualPeer::GetInstance().WaitForLink(VIRTUAL_CONTROLLER_TRANSPORT_LE, BENCHMARK_TIMEOUT);
+    return handle;
+}
+}  // namespace
+
+// Rate at which the ATT client delivers Handle Value Notifications pushed by the peer.
+static void BM_GattNotificationRate(benchmark::State &state)
+{
+    uint16_t handle = ConnectLe();
+    if (handle == 0) {
+        state.SkipWithError("LE link not connected");
+        return;
+    }
+
+    uint16_t valueLength = static_cast<uint16_t>(state.range(0));
+    uint64_t expected = g_notifications.Get();
+    for (auto _ : state) {
+        VirtualPeer::GetInstance().SendNotifications(
+            handle, NOTIFIED_ATT_HANDLE, valueLength, NOTIFICATIONS_PER_ITERATION);
+        expected += NOTIFICATIONS_PER_ITERATION;
+        if (!g_notifications.WaitFor(expected)) {
+            state.SkipWithError("Notifications lost");
+            break;
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * NOTIFICATIONS_PER_ITERATION);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * NOTIFICATIONS_PER_ITERATION * valueLength);
+}
+BENCHMARK(BM_GattNotificationRate)->Arg(20)->Arg(244)->UseRealTime()->Unit(benchmark::kMillisecond);
+}  // namespace bluetooth
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+
+#include <benchmark/benchmark.h>
+
+#include "at_command_tokenizer.h"
+#include "hfp_ag/hfp_ag_command_parser.h"
+#include "hfp_ag/hfp_ag_command_processor.h"
+
+namespace bluetooth {
+namespace {
+// Commands a car kit sends to the AG from the RFCOMM connection to the end of the service level connection setup,
+// followed by the volume and vendor commands it sends right after.
+constexpr std::string_view CAR_KIT_SLC_BURST =
+    "AT+BRSF=1015\r"
+    "AT+BAC=1,2\r"
+    "AT+CIND=?\r"
+    "AT+CIND?\r"
+    "AT+CMER=3,0,0,1\r"
+    "AT+CHLD=?\r"
+    "AT+BIND=1,2\r"
+    "AT+BIND=?\r"
+    "AT+BIND?\r"
+    "AT+CLIP=1\r"
+    "AT+CCWA=1\r"
+    "AT+CMEE=1\r"
+    "AT+NREC=0\r"
+    "AT+COPS=3,0\r"
+    "AT+COPS?\r"
+    "AT+BIA=0,0,0,1,1,1,0\r"
+    "AT+VGS=15\r"
+    "AT+VGM=15\r"
+    "AT+XAPL=ABCD-1234-0100,10\r"
+    "AT+IPHONEACCEV=2,1,5,2,0\r";
+}  // namespace
+
+// SLC bursts per second split into RFCOMM packets, tokenized and extracted by the AG command parser.
+// Arguments: RFCOMM packet size, commands straddle packets unless the burst fits in one.
+static void BM_HfpAgParseSlcBurst(benchmark::State &state)
+{
+    const uint8_t *burst = reinterpret_cast<const uint8_t *>(CAR_KIT_SLC_BURST.data());
+    size_t packetSize = state.range(0);
+    int64_t commands = 0;
+    utility::AtCommandTokenizer tokenizer;
+    for (auto _ : state) {
+        for (size_t offset = 0; offset < CAR_KIT_SLC_BURST.size(); offset += packetSize) {
+            size_t len = std::min(packetSize, CAR_KIT_SLC_BURST.size() - offset);
+            tokenizer.Feed(burst + offset, len, [&commands](std::string_view line) {
+                std::string_view cmd;
+                std::string arg;
+                HfpAgCommandParser::Extract(line, cmd, arg);
+                benchmark::DoNotOptimize(HfpAgCommandProcessor::IsSupported(cmd));
+                commands++;
+            });
+        }
+    }
+    state.SetItemsProcessed(commands);
+    state.SetBytesProcessed(state.iterations() * CAR_KIT_SLC_BURST.size());
+}
+BENCHMARK(BM_HfpAgParseSlcBurst)->Arg(7)->Arg(32)->Arg(127)->Arg(1024);
+}  // namespace bluetooth
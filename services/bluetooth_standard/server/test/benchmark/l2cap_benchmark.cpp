@@ -0,0 +1,247 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "benchmark_environment.h"
+#include "l2cap_if.h"
+#include "packet.h"
+#include "virtual_peer.h"
+
+namespace bluetooth {
+namespace {
+constexpr uint16_t PSM_BASIC = 0x1001;
+constexpr uint16_t PSM_ERTM = 0x1003;
+constexpr uint16_t PSM_MEDIA = 0x1005;
+constexpr uint16_t CHANNEL_MTU = 1691;
+constexpr uint16_t FLUSH_TIMEOUT_INFINITE = 0xFFFF;
+constexpr int SDUS_PER_ITERATION = 64;
+
+// SBC at 44.1 kHz, joint stereo, 16 blocks, 8 subbands, bitpool 53: 119 byte frames of 128 samples each.
+// A media packet carries an RTP header, the SBC payload header and 7 frames.
+constexpr uint16_t SBC_FRAME_LENGTH = 119;
+constexpr uint16_t SBC_FRAMES_PER_PACKET = 7;
+constexpr uint16_t MEDIA_HEADER_LENGTH = 13;
+constexpr uint16_t MEDIA_PACKET_LENGTH = MEDIA_HEADER_LENGTH + SBC_FRAME_LENGTH * SBC_FRAMES_PER_PACKET;
+constexpr std::chrono::microseconds MEDIA_PACKET_PERIOD {SBC_FRAMES_PER_PACKET * 128 * 1000000 / 44100};
+constexpr int MEDIA_PACKETS = 250;
+
+/**
+ * @brief Outgoing L2CAP channel from the host under test to the virtual peer.
+ */
+class BenchmarkChannel {
+public:
+    BenchmarkChannel(uint16_t psm, uint8_t mode) : psm_(psm)
+    {
+        cfg_.mtu = CHANNEL_MTU;
+        cfg_.flushTimeout = FLUSH_TIMEOUT_INFINITE;
+        cfg_.rfc.mode = mode;
+        // ERTM runs without FCS: both ends share the process and nothing corrupts frames in between.
+        cfg_.fcs = (mode == L2CAP_BASIC_MODE) ? 0x01 : 0x00;
+    }
+
+    ~BenchmarkChannel()
+    {
+        Close();
+    }
+
+    bool Open()
+    {
+        L2capService service = {};
+        service.recvConnectionRsp = OnConnectionRsp;
+        service.recvConfigReq = OnConfigReq;
+        service.recvConfigRsp = OnConfigRsp;
+        service.recvDisconnectionReq = OnDisconnectionReq;
+        service.recvDisconnectionRsp = OnDisconnectionRsp;
+        service.disconnectAbnormal = OnDisconnectAbnormal;
+        service.recvData = OnData;
+        service.remoteBusy = OnRemoteBusy;
+        L2CIF_RegisterService(psm_, &service, this, nullptr);
+
+        BtAddr addr = BenchmarkEnvironment::GetPeerAddress();
+        if (L2CIF_ConnectReq(&addr, psm_, psm_, this, OnConnectReq) != BT_NO_ERROR) {
+            return false;
+        }
+        // Local configuration accepted and remote configuration answered.
+        return connected_.WaitFor(2);
+    }
+
+    void Close()
+    {
+        if (lcid_ != 0) {
+            L2CIF_DisconnectionReq(lcid_, nullptr);
+            lcid_ = 0;
+        }
+        L2CIF_DeregisterService(psm_, nullptr);
+    }
+
+    uint16_t GetLcid() const
+    {
+        return lcid_;
+    }
+
+    int Send(const uint8_t *data, uint16_t length)
+    {
+        Packet *pkt = PacketMalloc(0, 0, length);
+        PacketPayloadWrite(pkt, data, 0, length);
+        int ret = L2CIF_SendData(lcid_, pkt, nullptr);
+        PacketFree(pkt);
+        return ret;
+    }
+
+private:
+    static void OnConnectReq(const BtAddr *addr, uint16_t lcid, int result, void *context)
+    {
+        if (result == BT_NO_ERROR) {
+            static_cast<BenchmarkChannel *>(context)->lcid_ = lcid;
+        }
+    }
+
+    static void OnConnectionRsp(
+        uint16_t lcid, const L2capConnectionInfo *info, uint16_t result, uint16_t status, void *context)
+    {
+        auto channel = static_cast<BenchmarkChannel *>(context);
+        if (result == L2CAP_CONNECTION_SUCCESSFUL) {
+            L2CIF_ConfigReq(lcid, &channel->cfg_, nullptr);
+        }
+    }
+
+    static void OnConfigReq(uint16_t lcid, uint8_t id, const L2capConfigInfo *cfg, void *context)
+    {
+        auto channel = static_cast<BenchmarkChannel *>(context);
+        L2capConfigInfo rsp = *cfg;
+        L2CIF_ConfigRsp(lcid, id, &rsp, L2CAP_SUCCESS, nullptr);
+        channel->connected_.Add();
+    }
+
+    static void OnConfigRsp(uint16_t lcid, const L2capConfigInfo *cfg, uint16_t result, void *context)
+    {
+        if (result == L2CAP_SUCCESS) {
+            static_cast<BenchmarkChannel *>(context)->connected_.Add();
+        }
+    }
+
+    static void OnDisconnectionReq(uint16_t lcid, uint8_t id, void *context)
+    {
+        L2CIF_DisconnectionRsp(lcid, id, nullptr);
+    }
+
+    static void OnDisconnectionRsp(uint16_t lcid, void *context)
+    {}
+
+    static void OnDisconnectAbnormal(uint16_t lcid, uint8_t reason, void *context)
+    {}
+
+    static void OnData(uint16_t lcid, Packet *pkt, void *context)
+    {}
+
+    static void OnRemoteBusy(uint16_t lcid, uint8_t isBusy, void *context)
+    {}
+
+    uint16_t psm_ = 0;
+    uint16_t lcid_ = 0;
+    L2capConfigInfo cfg_ {};
+    BenchmarkCounter connected_ {};
+};
+
+void RunThroughput(benchmark::State &state, uint16_t psm, uint8_t mode)
+{
+    BenchmarkChannel channel(psm, mode);
+    if (!channel.Open()) {
+        state.SkipWithError("L2CAP channel not connected");
+        return;
+    }
+
+    uint16_t sduLength = static_cast<uint16_t>(state.range(0));
+    std::vector<uint8_t> sdu(sduLength, 0xA5);
+    VirtualPeer &peer = VirtualPeer::GetInstance();
+    uint64_t expected = peer.GetReceivedBytes(channel.GetLcid());
+    for (auto _ : state) {
+        for (int i = 0; i < SDUS_PER_ITERATION; i++) {
+            channel.Send(sdu.data(), sduLength);
+        }
+        expected += static_cast<uint64_t>(sduLength) * SDUS_PER_ITERATION;
+        if (!peer.WaitForReceivedBytes(channel.GetLcid(), expected, BENCHMARK_TIMEOUT)) {
+            state.SkipWithError("Peer did not receive all data");
+            break;
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * sduLength * SDUS_PER_ITERATION);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * SDUS_PER_ITERATION);
+}
+}  // namespace
+
+// Host to peer ACL throughput through an L2CAP basic mode channel.
+static void BM_AclThroughput(benchmark::State &state)
+{
+    RunThroughput(state, PSM_BASIC, L2CAP_BASIC_MODE);
+}
+BENCHMARK(BM_AclThroughput)->Arg(64)->Arg(672)->Arg(CHANNEL_MTU)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Host to peer throughput through an L2CAP enhanced retransmission mode channel, including I-frame acknowledgement.
+static void BM_L2capErtmThroughput(benchmark::State &state)
+{
+    RunThroughput(state, PSM_ERTM, L2CAP_ENHANCED_RETRANSMISSION_MODE);
+}
+BENCHMARK(BM_L2capErtmThroughput)->Arg(64)->Arg(672)->Arg(CHANNEL_MTU)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Media packets sized and timed like an SBC A2DP stream; reports how evenly they reach the peer.
+static void BM_A2dpPacketCadence(benchmark::State &state)
+{
+    BenchmarkChannel channel(PSM_MEDIA, L2CAP_BASIC_MODE);
+    if (!channel.Open()) {
+        state.SkipWithError("L2CAP channel not connected");
+        return;
+    }
+
+    std::vector<uint8_t> packet(MEDIA_PACKET_LENGTH, 0x9C);
+    VirtualPeer &peer = VirtualPeer::GetInstance();
+    double sumJitterUs = 0;
+    double maxJitterUs = 0;
+    uint64_t intervals = 0;
+    for (auto _ : state) {
+        peer.TakeArrivalTimes(channel.GetLcid());
+        uint64_t expected = peer.GetReceivedBytes(channel.GetLcid()) + MEDIA_PACKET_LENGTH * MEDIA_PACKETS;
+        auto due = std::chrono::steady_clock::now();
+        for (int i = 0; i < MEDIA_PACKETS; i++) {
+            std::this_thread::sleep_until(due);
+            channel.Send(packet.data(), MEDIA_PACKET_LENGTH);
+            due += MEDIA_PACKET_PERIOD;
+        }
+        if (!peer.WaitForReceivedBytes(channel.GetLcid(), expected, BENCHMARK_TIMEOUT)) {
+            state.SkipWithError("Peer did not receive all media packets");
+            break;
+        }
+
+        auto arrivals = peer.TakeArrivalTimes(channel.GetLcid());
+        for (size_t i = 1; i < arrivals.size(); i++) {
+            auto interval = std::chrono::duration_cast<std::chrono::microseconds>(arrivals[i] - arrivals[i - 1]);
+            double jitterUs = std::fabs(static_cast<double>((interval - MEDIA_PACKET_PERIOD).count()));
+            sumJitterUs += jitterUs;
+            maxJitterUs = std::max(maxJitterUs, jitterUs);
+            intervals++;
+        }
+    }
+    state.counters["jitter_avg_us"] = (intervals > 0) ? (sumJitterUs / intervals) : 0;
+    state.counters["jitter_max_us"] = maxJitterUs;
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * MEDIA_PACKETS);
+}
+BENCHMARK(BM_A2dpPacketCadence)->Iterations(1)->UseRealTime()->Unit(benchmark::kMillisecond);
+}  // namespace bluetooth
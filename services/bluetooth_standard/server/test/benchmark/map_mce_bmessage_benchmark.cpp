@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "map_mce_data_analyse.h"
+
+namespace bluetooth {
+namespace {
+constexpr size_t BODY_LINE_LENGTH = 76;
+constexpr size_t KILOBYTE = 1024;
+
+IProfileMapVcard MakeVcard(size_t index)
+{
+    IProfileMapVcard vcard;
+    std::string id = std::to_string(index);
+    vcard.VERSION = "3.0";
+    vcard.N = "Recipient;" + id;
+    vcard.FN = "Recipient " + id;
+    vcard.TEL.push_back("+8613800" + id);
+    vcard.EMAIL.push_back("recipient" + id + "@example.com");
+    return vcard;
+}
+
+// Body of about bodySize bytes in 76 character lines, as a base64 MMS part or a mail body would be.
+std::string MakeBody(size_t bodySize)
+{
+    std::string line(BODY_LINE_LENGTH, 'A');
+    std::string body;
+    body.reserve(bodySize + BODY_LINE_LENGTH);
+    while (body.size() < bodySize) {
+        body += line;
+        body += "\r\n";
+    }
+    return body;
+}
+
+std::string MakeBMessage(MapMessageType type, size_t recipients, size_t bodySize)
+{
+    IProfileBMessageStruct msg;
+    msg.version_property = "1.0";
+    msg.readstatus_property = MapMessageStatus::UNREAD;
+    msg.type_property = type;
+    msg.folder_property = u"telecom/msg/inbox";
+    msg.originator_.push_back(MakeVcard(0));
+    msg.envelope_.maxLevelOfEnvelope_ = MCE_RECIPIENT_LEVEL1;
+    for (size_t i = 1; i <= recipients; i++) {
+        msg.envelope_.recipientLevel1_.push_back(MakeVcard(i));
+    }
+    msg.envelope_.msgBody_.body_charset = "UTF-8";
+    msg.envelope_.msgBody_.body_encoding = (type == MapMessageType::MMS) ? "BASE64" : "8BIT";
+    msg.envelope_.msgBody_.body_content = MakeBody(bodySize);
+    msg.envelope_.msgBody_.body_content_length = msg.envelope_.msgBody_.body_content.size();
+    return MceBmessageParamMakeStringObject(msg).GetStringObject();
+}
+
+void RunBMessageParse(benchmark::State &state, MapMessageType type)
+{
+    std::string object = MakeBMessage(type, state.range(0), state.range(1) * KILOBYTE);
+    for (auto _ : state) {
+        MceTypesBMessage bMessage;
+        bMessage.BuildObjectData(object);
+        benchmark::DoNotOptimize(bMessage.GetBMessageData());
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * object.size());
+}
+}  // namespace
+
+// bMessages per second parsed from a GetMessage response carrying an MMS.
+// Arguments: recipients, body size in KB.
+static void BM_MapMceParseMmsBMessage(benchmark::State &state)
+{
+    RunBMessageParse(state, MapMessageType::MMS);
+}
+BENCHMARK(BM_MapMceParseMmsBMessage)->Args({1, 1})->Args({10, 300})->Args({50, 1024});
+
+// bMessages per second parsed from a GetMessage response carrying an email.
+// Arguments: recipients, body size in KB.
+static void BM_MapMceParseEmailBMessage(benchmark::State &state)
+{
+    RunBMessageParse(state, MapMessageType::EMAIL);
+}
+BENCHMARK(BM_MapMceParseEmailBMessage)->Args({1, 4})->Args({20, 64})->Args({100, 512});
+}  // namespace bluetooth
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "benchmark_environment.h"
+#include "gap_le_if.h"
+
+namespace bluetooth {
+namespace {
+constexpr uint8_t SCAN_TYPE_PASSIVE = 0x00;
+constexpr uint16_t SCAN_INTERVAL = 0x0010;
+constexpr uint16_t SCAN_WINDOW = 0x0010;
+constexpr uint16_t ADVERTISERS = 1000;
+constexpr uint64_t REPORTS_PER_ITERATION = 2000;
+
+BenchmarkCounter g_reports;
+BenchmarkCounter g_scanParamSet;
+BenchmarkCounter g_scanEnableSet;
+
+void OnAdvertisingReport(
+    uint8_t advType, const BtAddr *addr, GapAdvReportParam reportParam, const BtAddr *currentAddr, void *context)
+{
+    g_reports.Add();
+}
+
+void OnScanSetParamResult(uint8_t status, void *context)
+{
+    g_scanParamSet.Add();
+}
+
+void OnScanSetEnableResult(uint8_t status, void *context)
+{
+    g_scanEnableSet.Add();
+}
+
+bool SetScan(uint8_t enable)
+{
+    uint64_t expected = g_scanEnableSet.Get() + 1;
+    GAPIF_LeScanSetEnable(enable, 0);
+    return g_scanEnableSet.WaitFor(expected);
+}
+}  // namespace
+
+// Advertising reports per second the host delivers to the scan callback under a synthetic flood.
+// Arguments: reports per LE Advertising Report event, advertising data length.
+static void BM_ScanReportRate(benchmark::State &state)
+{
+    static GapScanCallback callback = {OnAdvertisingReport, OnScanSetParamResult, OnScanSetEnableResult};
+    GAPIF_RegisterScanCallback(&callback, nullptr);
+    GapLeScanParam param = {SCAN_TYPE_PASSIVE, {SCAN_INTERVAL, SCAN_WINDOW}};
+    uint64_t expectedParam = g_scanParamSet.Get() + 1;
+    GAPIF_LeScanSetParam(param, GAP_SCAN_NOT_USE_WL);
+    if ((!g_scanParamSet.WaitFor(expectedParam)) || (!SetScan(1))) {
+        GAPIF_DeregisterScanCallback();
+        state.SkipWithError("LE scan not started");
+        return;
+    }
+
+    VirtualAdvertisingFlood flood = {};
+    flood.reportsPerEvent = static_cast<uint8_t>(state.range(0));
+    flood.dataLength = static_cast<uint8_t>(state.range(1));
+    flood.numAdvertisers = ADVERTISERS;
+    flood.intervalUs = 0;
+    VirtualControllerStatistics before = {};
+    VirtualControllerGetStatistics(&before);
+    uint64_t delivered = 0;
+    g_reports.Reset();
+    VirtualControllerStartAdvertisingFlood(&flood);
+    for (auto _ : state) {
+        delivered += REPORTS_PER_ITERATION;
+        if (!g_reports.WaitFor(delivered)) {
+            state.SkipWithError("Advertising reports stalled");
+            break;
+        }
+    }
+    VirtualControllerStopAdvertisingFlood();
+    SetScan(0);
+    GAPIF_DeregisterScanCallback();
+
+    VirtualControllerStatistics after = {};
+    VirtualControllerGetStatistics(&after);
+    uint64_t generated = after.advertisingReports - before.advertisingReports;
+    uint64_t received = g_reports.Get();
+    state.counters["generated"] = static_cast<double>(generated);
+    state.counters["not_delivered"] = static_cast<double>((generated > received) ? (generated - received) : 0);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * REPORTS_PER_ITERATION));
+}
+BENCHMARK(BM_ScanReportRate)->Args({1, 31})->Args({6, 31})->Args({20, 2})->UseRealTime()->Unit(benchmark::kMillisecond);
+}  // namespace bluetooth
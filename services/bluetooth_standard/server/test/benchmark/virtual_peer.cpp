@@ -0,0 +1,465 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "virtual_peer.h"
+
+#include "virtual_controller.h"
+
+namespace bluetooth {
+namespace {
+constexpr uint16_t L2CAP_HEADER_LENGTH = 4;
+constexpr uint16_t SIGNAL_HEADER_LENGTH = 4;
+constexpr uint16_t CID_SIGNALING = 0x0001;
+constexpr uint16_t CID_ATT = 0x0004;
+
+constexpr uint8_t SIGNAL_COMMAND_REJECT = 0x01;
+constexpr uint8_t SIGNAL_CONNECTION_REQUEST = 0x02;
+constexpr uint8_t SIGNAL_CONNECTION_RESPONSE = 0x03;
+constexpr uint8_t SIGNAL_CONFIGURATION_REQUEST = 0x04;
+constexpr uint8_t SIGNAL_CONFIGURATION_RESPONSE = 0x05;
+constexpr uint8_t SIGNAL_DISCONNECTION_REQUEST = 0x06;
+constexpr uint8_t SIGNAL_DISCONNECTION_RESPONSE = 0x07;
+constexpr uint8_t SIGNAL_ECHO_REQUEST = 0x08;
+constexpr uint8_t SIGNAL_ECHO_RESPONSE = 0x09;
+constexpr uint8_t SIGNAL_INFORMATION_REQUEST = 0x0A;
+constexpr uint8_t SIGNAL_INFORMATION_RESPONSE = 0x0B;
+
+constexpr uint16_t INFO_EXTENDED_FEATURES = 0x0002;
+constexpr uint16_t INFO_FIXED_CHANNELS = 0x0003;
+constexpr uint8_t FEATURE_ERTM = 0x08;
+constexpr uint8_t FEATURE_FCS_OPTION = 0x20;
+constexpr uint8_t FIXED_CHANNEL_SIGNALING = 0x02;
+constexpr uint16_t INFO_RESULT_SUCCESS = 0x0000;
+constexpr uint16_t INFO_RESULT_NOT_SUPPORTED = 0x0001;
+
+constexpr uint8_t OPTION_MTU = 0x01;
+constexpr uint8_t OPTION_RFC = 0x04;
+constexpr uint8_t OPTION_FCS = 0x05;
+constexpr uint8_t OPTION_TYPE_MASK = 0x7F;
+constexpr uint8_t OPTION_RFC_LENGTH = 9;
+constexpr uint8_t MODE_ERTM = 0x03;
+
+constexpr uint16_t PEER_MTU = 4096;
+constexpr uint8_t PEER_TX_WINDOW = 63;
+constexpr uint8_t PEER_MAX_TRANSMIT = 3;
+constexpr uint16_t PEER_MPS = 1010;
+constexpr uint16_t RETRANSMISSION_TIMEOUT = 2000;
+constexpr uint16_t MONITOR_TIMEOUT = 12000;
+
+constexpr uint8_t CONTROL_SFRAME = 0x01;
+constexpr uint8_t CONTROL_PBIT = 0x10;
+constexpr uint8_t CONTROL_FBIT = 0x80;
+constexpr uint8_t SEQ_MASK = 0x3F;
+constexpr uint8_t SAR_UNSEGMENTED = 0x00;
+constexpr uint8_t SAR_START = 0x01;
+constexpr uint8_t SAR_END = 0x02;
+
+constexpr uint8_t ATT_EXCHANGE_MTU_REQUEST = 0x02;
+constexpr uint8_t ATT_EXCHANGE_MTU_RESPONSE = 0x03;
+constexpr uint8_t ATT_HANDLE_VALUE_NOTIFICATION = 0x1B;
+constexpr uint16_t PEER_ATT_MTU = 247;
+
+constexpr uint8_t PB_CONTINUING = 0x01;
+
+void PutUint16(std::vector<uint8_t> &buffer, uint16_t value)
+{
+    buffer.push_back(static_cast<uint8_t>(value & 0xFF));
+    buffer.push_back(static_cast<uint8_t>(value >> 8));
+}
+
+uint16_t GetUint16(const uint8_t *data)
+{
+    return static_cast<uint16_t>(data[0] | (data[1] << 8));
+}
+}  // namespace
+
+VirtualPeer &VirtualPeer::GetInstance()
+{
+    static VirtualPeer instance;
+    return instance;
+}
+
+void VirtualPeer::Attach()
+{
+    VirtualPeerCallbacks callbacks = {OnConnected, OnDisconnected, OnAclData};
+    VirtualPeerRegisterCallbacks(&callbacks, this);
+}
+
+uint16_t VirtualPeer::WaitForLink(uint8_t transport, std::chrono::milliseconds timeout)
+{
+    uint16_t handle = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait_for(lock, timeout, [this, transport, &handle]() {
+        for (auto &link : links_) {
+            if (link.second.transport_ == transport) {
+                handle = link.first;
+                return true;
+            }
+        }
+        return false;
+    });
+    return handle;
+}
+
+uint64_t VirtualPeer::GetReceivedBytes(uint16_t hostCid)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Channel *channel = FindChannelByHostCid(hostCid);
+    return (channel != nullptr) ? channel->bytes_ : 0;
+}
+
+bool VirtualPeer::WaitForReceivedBytes(uint16_t hostCid, uint64_t bytes, std::chrono::milliseconds timeout)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return cv_.wait_for(lock, timeout, [this, hostCid, bytes]() {
+        Channel *channel = FindChannelByHostCid(hostCid);
+        return (channel != nullptr) && (channel->bytes_ >= bytes);
+    });
+}
+
+std::vector<VirtualPeer::Clock::time_point> VirtualPeer::TakeArrivalTimes(uint16_t hostCid)
+{
+    std::vector<Clock::time_point> arrivals;
+    std::lock_guard<std::mutex> lock(mutex_);
+    Channel *channel = FindChannelByHostCid(hostCid);
+    if (channel != nullptr) {
+        arrivals.swap(channel->arrivals_);
+    }
+    return arrivals;
+}
+
+int VirtualPeer::SendNotifications(uint16_t handle, uint16_t attHandle, uint16_t valueLength, uint32_t count)
+{
+    std::vector<uint8_t> payload;
+    payload.push_back(ATT_HANDLE_VALUE_NOTIFICATION);
+    PutUint16(payload, attHandle);
+    payload.resize(payload.size() + valueLength, static_cast<uint8_t>(attHandle));
+
+    for (uint32_t i = 0; i < count; i++) {
+        std::vector<uint8_t> pdu;
+        pdu.reserve(L2CAP_HEADER_LENGTH + payload.size());
+        PutUint16(pdu, static_cast<uint16_t>(payload.size()));
+        PutUint16(pdu, CID_ATT);
+        pdu.insert(pdu.end(), payload.begin(), payload.end());
+        int ret = VirtualPeerSendAcl(handle, pdu.data(), static_cast<uint16_t>(pdu.size()));
+        if (ret != 0) {
+            return ret;
+        }
+    }
+    return 0;
+}
+
+void VirtualPeer::OnConnected(uint16_t handle, uint8_t transport, void *context)
+{
+    auto peer = static_cast<VirtualPeer *>(context);
+    {
+        std::lock_guard<std::mutex> lock(peer->mutex_);
+        Link link;
+        link.transport_ = transport;
+        peer->links_[handle] = link;
+    }
+    peer->cv_.notify_all();
+}
+
+void VirtualPeer::OnDisconnected(uint16_t handle, void *context)
+{
+    auto peer = static_cast<VirtualPeer *>(context);
+    {
+        std::lock_guard<std::mutex> lock(peer->mutex_);
+        peer->links_.erase(handle);
+    }
+    peer->cv_.notify_all();
+}
+
+void VirtualPeer::OnAclData(
+    uint16_t handle, uint8_t packetBoundary, const uint8_t *data, uint16_t length, void *context)
+{
+    auto peer = static_cast<VirtualPeer *>(context);
+    {
+        std::lock_guard<std::mutex> lock(peer->mutex_);
+        auto it = peer->links_.find(handle);
+        if (it == peer->links_.end()) {
+            return;
+        }
+
+        Link &link = it->second;
+        if (packetBoundary != PB_CONTINUING) {
+            link.reassembly_.clear();
+        }
+        link.reassembly_.insert(link.reassembly_.end(), data, data + length);
+        if (link.reassembly_.size() < L2CAP_HEADER_LENGTH) {
+            return;
+        }
+        size_t pduLength = L2CAP_HEADER_LENGTH + GetUint16(link.reassembly_.data());
+        if (link.reassembly_.size() < pduLength) {
+            return;
+        }
+        link.reassembly_.resize(pduLength);
+        std::vector<uint8_t> pdu;
+        pdu.swap(link.reassembly_);
+        peer->OnPdu(handle, link, pdu);
+    }
+    peer->cv_.notify_all();
+}
+
+void VirtualPeer::OnPdu(uint16_t handle, Link &link, const std::vector<uint8_t> &pdu)
+{
+    uint16_t cid = GetUint16(pdu.data() + 2);
+    const uint8_t *payload = pdu.data() + L2CAP_HEADER_LENGTH;
+    uint16_t length = static_cast<uint16_t>(pdu.size() - L2CAP_HEADER_LENGTH);
+
+    if (link.transport_ == VIRTUAL_CONTROLLER_TRANSPORT_LE) {
+        // The ATT MTU exchange is the only LE request the benchmarks make.
+        if ((cid == CID_ATT) && (length > 0) && (payload[0] == ATT_EXCHANGE_MTU_REQUEST)) {
+            std::vector<uint8_t> rsp;
+            rsp.push_back(ATT_EXCHANGE_MTU_RESPONSE);
+            PutUint16(rsp, PEER_ATT_MTU);
+            SendPdu(handle, CID_ATT, rsp);
+        }
+        return;
+    }
+
+    if (cid == CID_SIGNALING) {
+        uint16_t offset = 0;
+        while (offset + SIGNAL_HEADER_LENGTH <= length) {
+            uint16_t signalLength = GetUint16(payload + offset + 2);
+            if (offset + SIGNAL_HEADER_LENGTH + signalLength > length) {
+                break;
+            }
+            OnSignal(handle,
+                link,
+                payload[offset],
+                payload[offset + 1],
+                payload + offset + SIGNAL_HEADER_LENGTH,
+                signalLength);
+            offset += SIGNAL_HEADER_LENGTH + signalLength;
+        }
+        return;
+    }
+
+    auto it = link.channels_.find(cid);
+    if (it != link.channels_.end()) {
+        OnChannelData(handle, it->second, payload, length);
+    }
+}
+
+void VirtualPeer::OnSignal(
+    uint16_t handle, Link &link, uint8_t code, uint8_t identifier, const uint8_t *data, uint16_t length)
+{
+    std::vector<uint8_t> rsp;
+    switch (code) {
+        case SIGNAL_INFORMATION_REQUEST: {
+            if (length < 2) {
+                break;
+            }
+            uint16_t infoType = GetUint16(data);
+            PutUint16(rsp, infoType);
+            if (infoType == INFO_EXTENDED_FEATURES) {
+                PutUint16(rsp, INFO_RESULT_SUCCESS);
+                rsp.push_back(FEATURE_ERTM | FEATURE_FCS_OPTION);
+                rsp.insert(rsp.end(), 3, 0);
+            } else if (infoType == INFO_FIXED_CHANNELS) {
+                PutUint16(rsp, INFO_RESULT_SUCCESS);
+                rsp.push_back(FIXED_CHANNEL_SIGNALING);
+                rsp.insert(rsp.end(), 7, 0);
+            } else {
+                PutUint16(rsp, INFO_RESULT_NOT_SUPPORTED);
+            }
+            SendSignal(handle, SIGNAL_INFORMATION_RESPONSE, identifier, rsp);
+            break;
+        }
+        case SIGNAL_CONNECTION_REQUEST: {
+            if (length < 4) {
+                break;
+            }
+            Channel channel;
+            channel.hostCid_ = GetUint16(data + 2);
+            channel.peerCid_ = link.nextCid_++;
+            link.channels_[channel.peerCid_] = channel;
+            PutUint16(rsp, channel.peerCid_);
+            PutUint16(rsp, channel.hostCid_);
+            PutUint16(rsp, 0);  // Connection successful
+            PutUint16(rsp, 0);  // No further information
+            SendSignal(handle, SIGNAL_CONNECTION_RESPONSE, identifier, rsp);
+            break;
+        }
+        case SIGNAL_CONFIGURATION_REQUEST:
+            OnConfigurationRequest(handle, link, identifier, data, length);
+            break;
+        case SIGNAL_DISCONNECTION_REQUEST:
+            if (length < 4) {
+                break;
+            }
+            link.channels_.erase(GetUint16(data));
+            rsp.assign(data, data + 4);
+            SendSignal(handle, SIGNAL_DISCONNECTION_RESPONSE, identifier, rsp);
+            break;
+        case SIGNAL_ECHO_REQUEST:
+            rsp.assign(data, data + length);
+            SendSignal(handle, SIGNAL_ECHO_RESPONSE, identifier, rsp);
+            break;
+        case SIGNAL_CONFIGURATION_RESPONSE:
+        case SIGNAL_DISCONNECTION_RESPONSE:
+        case SIGNAL_COMMAND_REJECT:
+            break;
+        default:
+            PutUint16(rsp, 0);  // Command not understood
+            SendSignal(handle, SIGNAL_COMMAND_REJECT, identifier, rsp);
+            break;
+    }
+}
+
+void VirtualPeer::OnConfigurationRequest(
+    uint16_t handle, Link &link, uint8_t identifier, const uint8_t *data, uint16_t length)
+{
+    if (length < 4) {
+        return;
+    }
+    auto it = link.channels_.find(GetUint16(data));
+    if (it == link.channels_.end()) {
+        return;
+    }
+    Channel &channel = it->second;
+
+    uint8_t txWindow = PEER_TX_WINDOW;
+    uint16_t mps = PEER_MPS;
+    uint16_t offset = 4;
+    while (offset + 2 <= length) {
+        uint8_t type = data[offset] & OPTION_TYPE_MASK;
+        uint8_t optionLength = data[offset + 1];
+        if (offset + 2 + optionLength > length) {
+            break;
+        }
+        const uint8_t *option = data + offset + 2;
+        if ((type == OPTION_RFC) && (optionLength == OPTION_RFC_LENGTH)) {
+            channel.ertm_ = (option[0] == MODE_ERTM);
+            txWindow = option[1];
+            mps = GetUint16(option + 7);
+        }
+        offset += 2 + optionLength;
+    }
+
+    // Accept the host configuration as is.
+    std::vector<uint8_t> rsp;
+    PutUint16(rsp, channel.hostCid_);
+    PutUint16(rsp, 0);  // Flags
+    PutUint16(rsp, 0);  // Success
+    if (channel.ertm_) {
+        rsp.push_back(OPTION_RFC);
+        rsp.push_back(OPTION_RFC_LENGTH);
+        rsp.push_back(MODE_ERTM);
+        rsp.push_back(txWindow);
+        rsp.push_back(0);
+        PutUint16(rsp, RETRANSMISSION_TIMEOUT);
+        PutUint16(rsp, MONITOR_TIMEOUT);
+        PutUint16(rsp, mps);
+    }
+    SendSignal(handle, SIGNAL_CONFIGURATION_RESPONSE, identifier, rsp);
+
+    // Then configure the other direction.
+    std::vector<uint8_t> req;
+    PutUint16(req, channel.hostCid_);
+    PutUint16(req, 0);  // Flags
+    req.push_back(OPTION_MTU);
+    req.push_back(2);
+    PutUint16(req, PEER_MTU);
+    if (channel.ertm_) {
+        req.push_back(OPTION_RFC);
+        req.push_back(OPTION_RFC_LENGTH);
+        req.push_back(MODE_ERTM);
+        req.push_back(PEER_TX_WINDOW);
+        req.push_back(PEER_MAX_TRANSMIT);
+        PutUint16(req, 0);
+        PutUint16(req, 0);
+        PutUint16(req, PEER_MPS);
+        req.push_back(OPTION_FCS);
+        req.push_back(1);
+        req.push_back(0);  // No FCS
+    }
+    uint8_t reqIdentifier = link.nextIdentifier_++;
+    if (link.nextIdentifier_ == 0) {
+        link.nextIdentifier_ = 1;
+    }
+    SendSignal(handle, SIGNAL_CONFIGURATION_REQUEST, reqIdentifier, req);
+}
+
+void VirtualPeer::OnChannelData(uint16_t handle, Channel &channel, const uint8_t *data, uint16_t length)
+{
+    if (!channel.ertm_) {
+        channel.bytes_ += length;
+        channel.arrivals_.push_back(Clock::now());
+        return;
+    }
+
+    if (length < 2) {
+        return;
+    }
+    uint16_t control = GetUint16(data);
+    std::vector<uint8_t> ack;
+    if ((control & CONTROL_SFRAME) == 0) {
+        uint8_t txSeq = (control >> 1) & SEQ_MASK;
+        uint8_t sar = static_cast<uint8_t>(control >> 14);
+        uint16_t headerLength = (sar == SAR_START) ? 4 : 2;
+        if ((txSeq == channel.expectedTxSeq_) && (length >= headerLength)) {
+            channel.expectedTxSeq_ = (channel.expectedTxSeq_ + 1) & SEQ_MASK;
+            channel.bytes_ += length - headerLength;
+            if ((sar == SAR_UNSEGMENTED) || (sar == SAR_END)) {
+                channel.arrivals_.push_back(Clock::now());
+            }
+        }
+        // RR acknowledging everything received in sequence.
+        ack.push_back(CONTROL_SFRAME);
+    } else if (control & CONTROL_PBIT) {
+        ack.push_back(CONTROL_SFRAME | CONTROL_FBIT);
+    } else {
+        return;
+    }
+    ack.push_back(channel.expectedTxSeq_);
+    SendPdu(handle, channel.hostCid_, ack);
+}
+
+void VirtualPeer::SendSignal(uint16_t handle, uint8_t code, uint8_t identifier, const std::vector<uint8_t> &data)
+{
+    std::vector<uint8_t> signal;
+    signal.reserve(SIGNAL_HEADER_LENGTH + data.size());
+    signal.push_back(code);
+    signal.push_back(identifier);
+    PutUint16(signal, static_cast<uint16_t>(data.size()));
+    signal.insert(signal.end(), data.begin(), data.end());
+    SendPdu(handle, CID_SIGNALING, signal);
+}
+
+void VirtualPeer::SendPdu(uint16_t handle, uint16_t cid, const std::vector<uint8_t> &payload)
+{
+    std::vector<uint8_t> pdu;
+    pdu.reserve(L2CAP_HEADER_LENGTH + payload.size());
+    PutUint16(pdu, static_cast<uint16_t>(payload.size()));
+    PutUint16(pdu, cid);
+    pdu.insert(pdu.end(), payload.begin(), payload.end());
+    VirtualPeerSendAcl(handle, pdu.data(), static_cast<uint16_t>(pdu.size()));
+}
+
+VirtualPeer::Channel *VirtualPeer::FindChannelByHostCid(uint16_t hostCid)
+{
+    for (auto &link : links_) {
+        for (auto &channel : link.second.channels_) {
+            if (channel.second.hostCid_ == hostCid) {
+                return &channel.second;
+            }
+        }
+    }
+    return nullptr;
+}
+}  // namespace bluetooth
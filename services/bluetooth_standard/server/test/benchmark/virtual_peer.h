@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VIRTUAL_PEER_H
+#define VIRTUAL_PEER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace bluetooth {
+/**
+ * @brief Remote host on the far side of the virtual controller.
+ *
+ * Answers just enough of the BR/EDR L2CAP signaling channel for the host under test to open basic mode and
+ * enhanced retransmission mode channels, acknowledges ERTM I-frames, and counts what arrives on every channel.
+ * On LE links it can push ATT notifications to the host.
+ */
+class VirtualPeer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static VirtualPeer &GetInstance();
+
+    // Hooks the peer to the virtual controller; must run before the stack is enabled.
+    void Attach();
+
+    /**
+     * @brief Waits for the first link of a transport.
+     *
+     * @param transport VIRTUAL_CONTROLLER_TRANSPORT_BREDR or VIRTUAL_CONTROLLER_TRANSPORT_LE.
+     * @return Connection handle, or 0 on timeout.
+     */
+    uint16_t WaitForLink(uint8_t transport, std::chrono::milliseconds timeout);
+
+    // Bytes of SDU payload received on the channel whose host side CID is hostCid.
+    uint64_t GetReceivedBytes(uint16_t hostCid);
+    bool WaitForReceivedBytes(uint16_t hostCid, uint64_t bytes, std::chrono::milliseconds timeout);
+
+    // Arrival time of every SDU received on the channel since the previous call.
+    std::vector<Clock::time_point> TakeArrivalTimes(uint16_t hostCid);
+
+    // Sends Handle Value Notifications on the ATT fixed channel of an LE link.
+    int SendNotifications(uint16_t handle, uint16_t attHandle, uint16_t valueLength, uint32_t count);
+
+private:
+    VirtualPeer() = default;
+    ~VirtualPeer() = default;
+
+    struct Channel {
+        uint16_t hostCid_ = 0;
+        uint16_t peerCid_ = 0;
+        bool ertm_ = false;
+        uint8_t expectedTxSeq_ = 0;
+        uint64_t bytes_ = 0;
+        std::vector<Clock::time_point> arrivals_ {};
+    };
+
+    struct Link {
+        uint8_t transport_ = 0;
+        std::vector<uint8_t> reassembly_ {};
+        std::map<uint16_t, Channel> channels_ {};  // keyed by peer CID
+        uint16_t nextCid_ = 0x0040;
+        uint8_t nextIdentifier_ = 1;
+    };
+
+    static void OnConnected(uint16_t handle, uint8_t transport, void *context);
+    static void OnDisconnected(uint16_t handle, void *context);
+    static void OnAclData(uint16_t handle, uint8_t packetBoundary, const uint8_t *data, uint16_t length, void *context);
+
+    // The following run with mutex_ held.
+    void OnPdu(uint16_t handle, Link &link, const std::vector<uint8_t> &pdu);
+    void OnSignal(uint16_t handle, Link &link, uint8_t code, uint8_t identifier, const uint8_t *data, uint16_t length);
+    void OnConfigurationRequest(uint16_t handle, Link &link, uint8_t identifier, const uint8_t *data, uint16_t length);
+    void OnChannelData(uint16_t handle, Channel &channel, const uint8_t *data, uint16_t length);
+    void SendSignal(uint16_t handle, uint8_t code, uint8_t identifier, const std::vector<uint8_t> &data);
+    void SendPdu(uint16_t handle, uint16_t cid, const std::vector<uint8_t> &payload);
+    Channel *FindChannelByHostCid(uint16_t hostCid);
+
+    std::mutex mutex_ {};
+    std::condition_variable cv_ {};
+    std::map<uint16_t, Link> links_ {};
+};
+}  // namespace bluetooth
+
+#endif  // VIRTUAL_PEER_H
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "at_command_tokenizer.h"
+#include "hfp_ag/hfp_ag_command_parser.h"
+#include "hfp_hf/hfp_hf_command_parser.h"
+
+using namespace bluetooth;
+
+namespace {
+void ExtractLine(std::string_view line)
+{
+    std::string_view cmd;
+    std::string arg;
+    int type = HfpAgCommandParser::Extract(line, cmd, arg);
+    if (type != HFP_AG_CMD_INVALID) {
+        (void)HfpAgCommandProcessor::IsSupported(cmd);
+    }
+
+    arg.clear();
+    HfpHfCommandParser::Extract(line, cmd, arg);
+    (void)HfpHfCommandProcessor::IsSupported(cmd);
+}
+}  // namespace
+
+/* The first byte selects where the input is split into two RFCOMM packets, so that commands crossing a packet
+ * boundary are exercised as well.
+ */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    if (size == 0) {
+        return 0;
+    }
+
+    size_t split = data[0] % size;
+    utility::AtCommandTokenizer tokenizer;
+    tokenizer.Feed(data + 1, split, ExtractLine);
+    tokenizer.Feed(data + 1 + split, size - 1 - split, ExtractLine);
+    return 0;
+}
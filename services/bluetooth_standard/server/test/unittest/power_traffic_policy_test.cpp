@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include "power_traffic_policy.h"
+
+using namespace testing::ext;
+using namespace bluetooth;
+
+namespace OHOS {
+namespace Bluetooth {
+namespace {
+// A burst moves enough data in one sample period for the link to be busy.
+constexpr uint64_t BURST_PACKETS = 10;
+constexpr uint64_t BURST_BYTES = 1000;
+// Light traffic stays below both busy thresholds.
+constexpr uint64_t LIGHT_PACKETS = 1;
+constexpr uint64_t LIGHT_BYTES = 20;
+// Bursts every 3 s leave an idle gap of 2.8 s, whose hold is within the max hold.
+constexpr uint32_t STEADY_GAP_MS = 2800;
+// Bursts every second leave an idle gap of 0.8 s, shorter than POWER_TRAFFIC_SHORT_GAP_MS.
+constexpr uint32_t SHORT_GAP_MS = 800;
+constexpr uint32_t LONG_PAUSE_MS = 30000;
+constexpr int STEADY_CYCLES = 5;
+}  // namespace
+
+class PowerTrafficPolicyTest : public testing::Test {
+public:
+    PowerTrafficPolicyTest()
+    {}
+    ~PowerTrafficPolicyTest()
+    {}
+
+    void SetUp();
+    void TearDown();
+
+    // Feed the policy one sample period that moved the given packets and bytes.
+    PowerTrafficDecision Sample(uint64_t packets, uint64_t bytes);
+    PowerTrafficDecision Burst();
+    // Stay idle for ms, returns the last decision other than NONE, NONE if there was none.
+    PowerTrafficDecision Idle(uint32_t ms);
+    // Stay idle until the policy lets the link sniff, returns the idle time it took or 0 if it never did.
+    uint32_t IdleUntilSniff(uint32_t maxMs);
+
+    PowerTrafficPolicy policy_ {};
+    uint64_t packets_ = 0;
+    uint64_t bytes_ = 0;
+    uint32_t idleMs_ = 0;
+};
+
+void PowerTrafficPolicyTest::SetUp()
+{
+    packets_ = 0;
+    bytes_ = 0;
+    idleMs_ = 0;
+    EXPECT_EQ(PowerTrafficDecision::NONE, policy_.Update(bytes_, packets_, idleMs_, 0));
+}
+
+void PowerTrafficPolicyTest::TearDown()
+{}
+
+PowerTrafficDecision PowerTrafficPolicyTest::Sample(uint64_t packets, uint64_t bytes)
+{
+    packets_ += packets;
+    bytes_ += bytes;
+    idleMs_ = (packets != 0) ? 0 : (idleMs_ + POWER_TRAFFIC_SAMPLE_PERIOD_MS);
+    return policy_.Update(bytes_, packets_, idleMs_, POWER_TRAFFIC_SAMPLE_PERIOD_MS);
+}
+
+PowerTrafficDecision PowerTrafficPolicyTest::Burst()
+{
+    return Sample(BURST_PACKETS, BURST_BYTES);
+}
+
+PowerTrafficDecision PowerTrafficPolicyTest::Idle(uint32_t ms)
+{
+    PowerTrafficDecision last = PowerTrafficDecision::NONE;
+    for (uint32_t time = 0; time < ms; time += POWER_TRAFFIC_SAMPLE_PERIOD_MS) {
+        PowerTrafficDecision decision = Sample(0, 0);
+        if (decision != PowerTrafficDecision::NONE) {
+            last = decision;
+        }
+    }
+    return last;
+}
+
+uint32_t PowerTrafficPolicyTest::IdleUntilSniff(uint32_t maxMs)
+{
+    for (uint32_t time = 0; time < maxMs; time += POWER_TRAFFIC_SAMPLE_PERIOD_MS) {
+        if (Sample(0, 0) == PowerTrafficDecision::SNIFF) {
+            return idleMs_;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @tc.number: PowerTrafficPolicy_UnitTest_0100
+ * @tc.name: Update
+ * @tc.desc: Test that a busy sample puts the link in active mode at once and light traffic decides nothing.
+ */
+HWTEST_F(PowerTrafficPolicyTest, PowerTrafficPolicy_UnitTest_BusySampleActivates, TestSize.Level1)
+{
+    EXPECT_EQ(PowerTrafficDecision::NONE, Sample(LIGHT_PACKETS, LIGHT_BYTES));
+    EXPECT_EQ(PowerModeLevel::NO_ACTION, policy_.GetPowerInfo().powerMode_);
+    EXPECT_EQ(PowerSsrLevel::NO_ACTION, policy_.GetSsrLevel());
+
+    EXPECT_EQ(PowerTrafficDecision::ACTIVE, Burst());
+    EXPECT_EQ(PowerModeLevel::LEVEL_ACTIVE, policy_.GetPowerInfo().powerMode_);
+    EXPECT_EQ(PowerTrafficDecision::NONE, Burst());
+}
+
+/**
+ * @tc.number: PowerTrafficPolicy_UnitTest_0200
+ * @tc.name: Update
+ * @tc.desc: Test that without a gap history the link is released after the min hold, and light traffic does not
+ *           wake it from sniff mode.
+ */
+HWTEST_F(PowerTrafficPolicyTest, PowerTrafficPolicy_UnitTest_ReleaseAfterMinHold, TestSize.Level1)
+{
+    EXPECT_EQ(PowerTrafficDecision::ACTIVE, Burst());
+    EXPECT_EQ(uint32_t(POWER_TRAFFIC_MIN_HOLD_MS), policy_.GetHoldMs());
+    EXPECT_EQ(uint32_t(POWER_TRAFFIC_MIN_HOLD_MS), IdleUntilSniff(LONG_PAUSE_MS));
+    EXPECT_EQ(PowerModeLevel::LEVEL_LOW, policy_.GetPowerInfo().powerMode_);
+    EXPECT_EQ(PowerSsrLevel::SSR2, policy_.GetSsrLevel());
+
+    EXPECT_EQ(PowerTrafficDecision::NONE, Sample(LIGHT_PACKETS, LIGHT_BYTES));
+    EXPECT_NE(PowerModeLevel::LEVEL_ACTIVE, policy_.GetPowerInfo().powerMode_);
+}
+
+/**
+ * @tc.number: PowerTrafficPolicy_UnitTest_0300
+ * @tc.name: Update
+ * @tc.desc: Test that steady bursts learn their gap and are bridged: the link is held active across every gap
+ *           instead of going through sniff mode.
+ */
+HWTEST_F(PowerTrafficPolicyTest, PowerTrafficPolicy_UnitTest_SteadyBurstsHeld, TestSize.Level1)
+{
+    EXPECT_EQ(PowerTrafficDecision::ACTIVE, Burst());
+    EXPECT_EQ(PowerTrafficDecision::SNIFF, Idle(STEADY_GAP_MS));
+    EXPECT_EQ(PowerTrafficDecision::ACTIVE, Burst());
+    EXPECT_EQ(STEADY_GAP_MS * 2, policy_.GetHoldMs());
+
+    for (int cycle = 0; cycle < STEADY_CYCLES; cycle++) {
+        EXPECT_EQ(PowerTrafficDecision::NONE, Idle(STEADY_GAP_MS));
+        EXPECT_EQ(PowerTrafficDecision::HELD, Burst());
+        EXPECT_EQ(PowerModeLevel::LEVEL_ACTIVE, policy_.GetPowerInfo().powerMode_);
+    }
+    EXPECT_EQ(STEADY_GAP_MS * 2, policy_.GetHoldMs());
+    EXPECT_EQ(STEADY_GAP_MS * 2, IdleUntilSniff(LONG_PAUSE_MS));
+}
+
+/**
+ * @tc.number: PowerTrafficPolicy_UnitTest_0400
+ * @tc.name: Update
+ * @tc.desc: Test that a pause longer than the max hold restarts the gap average instead of feeding it.
+ */
+HWTEST_F(PowerTrafficPolicyTest, PowerTrafficPolicy_UnitTest_LongPauseRestartsAverage, TestSize.Level1)
+{
+    EXPECT_EQ(PowerTrafficDecision::ACTIVE, Burst());
+    for (int cycle = 0; cycle < STEADY_CYCLES; cycle++) {
+        Idle(STEADY_GAP_MS);
+        Burst();
+    }
+    EXPECT_EQ(STEADY_GAP_MS * 2, policy_.GetHoldMs());
+
+    EXPECT_EQ(PowerTrafficDecision::SNIFF, Idle(LONG_PAUSE_MS));
+    EXPECT_EQ(PowerTrafficDecision::ACTIVE, Burst());
+    EXPECT_EQ(uint32_t(POWER_TRAFFIC_MIN_HOLD_MS), policy_.GetHoldMs());
+
+    EXPECT_EQ(PowerTrafficDecision::SNIFF, Idle(STEADY_GAP_MS));
+    EXPECT_EQ(PowerTrafficDecision::ACTIVE, Burst());
+    EXPECT_EQ(STEADY_GAP_MS * 2, policy_.GetHoldMs());
+}
+
+/**
+ * @tc.number: PowerTrafficPolicy_UnitTest_0500
+ * @tc.name: Update
+ * @tc.desc: Test that the idle time before the first burst is not taken for a gap between bursts.
+ */
+HWTEST_F(PowerTrafficPolicyTest, PowerTrafficPolicy_UnitTest_IdleBeforeFirstBurstIgnored, TestSize.Level1)
+{
+    EXPECT_EQ(PowerTrafficDecision::NONE, Idle(SHORT_GAP_MS));
+    EXPECT_EQ(PowerTrafficDecision::ACTIVE, Burst());
+    EXPECT_EQ(uint32_t(POWER_TRAFFIC_MIN_HOLD_MS), policy_.GetHoldMs());
+    EXPECT_EQ(uint32_t(POWER_TRAFFIC_MIN_HOLD_MS), IdleUntilSniff(LONG_PAUSE_MS));
+    EXPECT_EQ(PowerSsrLevel::SSR2, policy_.GetSsrLevel());
+}
+
+/**
+ * @tc.number: PowerTrafficPolicy_UnitTest_0600
+ * @tc.name: GetPowerInfo/GetSsrLevel
+ * @tc.desc: Test that bursts closer than the short gap pick the mid sniff level and the first subrating level.
+ */
+HWTEST_F(PowerTrafficPolicyTest, PowerTrafficPolicy_UnitTest_ShortGapsPickMidLevel, TestSize.Level1)
+{
+    EXPECT_EQ(PowerTrafficDecision::ACTIVE, Burst());
+    for (int cycle = 0; cycle < STEADY_CYCLES; cycle++) {
+        EXPECT_EQ(PowerTrafficDecision::NONE, Idle(SHORT_GAP_MS));
+        EXPECT_EQ(PowerTrafficDecision::NONE, Burst());
+    }
+    EXPECT_EQ(SHORT_GAP_MS * 2, policy_.GetHoldMs());
+    EXPECT_EQ(SHORT_GAP_MS * 2, IdleUntilSniff(LONG_PAUSE_MS));
+    EXPECT_EQ(PowerModeLevel::LEVEL_MID, policy_.GetPowerInfo().powerMode_);
+    EXPECT_EQ(PowerSsrLevel::SSR1, policy_.GetSsrLevel());
+}
+
+/**
+ * @tc.number: PowerTrafficPolicy_UnitTest_0700
+ * @tc.name: Wake
+ * @tc.desc: Test that data sent wakes a sniffing link at once, and the link is released again after the hold.
+ */
+HWTEST_F(PowerTrafficPolicyTest, PowerTrafficPolicy_UnitTest_WakeActivates, TestSize.Level1)
+{
+    EXPECT_EQ(PowerTrafficDecision::ACTIVE, Burst());
+    EXPECT_EQ(uint32_t(POWER_TRAFFIC_MIN_HOLD_MS), IdleUntilSniff(LONG_PAUSE_MS));
+
+    EXPECT_TRUE(policy_.Wake());
+    EXPECT_EQ(PowerModeLevel::LEVEL_ACTIVE, policy_.GetPowerInfo().powerMode_);
+    EXPECT_EQ(PowerSsrLevel::NO_ACTION, policy_.GetSsrLevel());
+    EXPECT_FALSE(policy_.Wake());
+
+    // The data sent ends the gap of the min hold, which is bridged from now on.
+    EXPECT_EQ(PowerTrafficDecision::NONE, Sample(LIGHT_PACKETS, LIGHT_BYTES));
+    EXPECT_EQ(uint32_t(POWER_TRAFFIC_MIN_HOLD_MS * 2), IdleUntilSniff(LONG_PAUSE_MS));
+}
+}  // namespace Bluetooth
+}  // namespace OHOS
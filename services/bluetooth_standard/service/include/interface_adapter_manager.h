@@ -296,6 +296,15 @@ public:
      * @since 6
      */
     virtual int GetPowerMode(const std::string &address) const = 0;
+
+    /**
+     * @brief Get a snapshot of the stack performance counters and histograms.
+     *
+     * @return Returns one "name value" line per counter and one line per histogram with
+     *         its sample count, mean and approximate percentiles.
+     * @since 6
+     */
+    virtual std::string GetPerformanceCounters() const = 0;
 };
 }  // namespace bluetooth
 
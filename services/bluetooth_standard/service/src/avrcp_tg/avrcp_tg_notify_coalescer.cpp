@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "avrcp_tg_notify_coalescer.h"
+
+namespace bluetooth {
+AvrcTgNotifyCoalescer::AvrcTgNotifyCoalescer(const std::function<void()> &timeout)
+    : timer_(std::make_unique<utility::Timer>(timeout))
+{
+    LOG_DEBUG("[AVRCP TG] AvrcTgNotifyCoalescer::%{public}s", __func__);
+
+    for (uint8_t eventId = AVRC_TG_EVENT_ID_PLAYBACK_STATUS_CHANGED; eventId < AVRC_TG_EVENT_ID_RESERVED; eventId++) {
+        if (IsSupportedEvent(eventId)) {
+            EncodeFrame(eventId, entries_[eventId]);
+        }
+    }
+    entries_[AVRC_TG_EVENT_ID_PLAYBACK_POS_CHANGED].interval_ = AVRC_PLAYBACK_INTERVAL_1_SEC * MS_PER_SECOND;
+    entries_[AVRC_TG_EVENT_ID_VOLUME_CHANGED].interval_ = AVRC_TG_NOTIFY_VOLUME_INTERVAL;
+}
+
+AvrcTgNotifyCoalescer::~AvrcTgNotifyCoalescer()
+{
+    LOG_DEBUG("[AVRCP TG] AvrcTgNotifyCoalescer::%{public}s", __func__);
+
+    timer_->Stop();
+}
+
+int AvrcTgNotifyCoalescer::GetValueSize(uint8_t eventId)
+{
+    int size = -1;
+
+    switch (eventId) {
+        case AVRC_TG_EVENT_ID_PLAYBACK_STATUS_CHANGED:
+            size = AVRC_TG_NOTIFY_EVENT_ID_PLAYBACK_STATUS_SIZE;
+            break;
+        case AVRC_TG_EVENT_ID_TRACK_CHANGED:
+            size = AVRC_TG_NOTIFY_EVENT_UID_SIZE;
+            break;
+        case AVRC_TG_EVENT_ID_PLAYBACK_POS_CHANGED:
+            size = AVRC_TG_NOTIFY_EVENT_PLAYBACK_POSITION_SIZE;
+            break;
+        case AVRC_TG_EVENT_ID_ADDRESSED_PLAYER_CHANGED:
+            size = AVRC_TG_NOTIFY_EVENT_PLAYER_ID_SIZE + AVRC_TG_NOTIFY_EVENT_UID_COUNTER_SIZE;
+            break;
+        case AVRC_TG_EVENT_ID_UIDS_CHANGED:
+            size = AVRC_TG_NOTIFY_EVENT_UID_COUNTER_SIZE;
+            break;
+        case AVRC_TG_EVENT_ID_VOLUME_CHANGED:
+            size = AVRC_TG_NOTIFY_EVENT_ID_VOLUME_SIZE;
+            break;
+        case AVRC_TG_EVENT_ID_TRACK_REACHED_END:
+        case AVRC_TG_EVENT_ID_TRACK_REACHED_START:
+        case AVRC_TG_EVENT_ID_NOW_PLAYING_CONTENT_CHANGED:
+        case AVRC_TG_EVENT_ID_AVAILABLE_PLAYERS_CHANGED:
+            size = 0;
+            break;
+        default:
+            /// The "PlayerApplicationSettingChanged" has a variable size, it is sent directly.
+            break;
+    }
+
+    return size;
+}
+
+bool AvrcTgNotifyCoalescer::IsSupportedEvent(uint8_t eventId)
+{
+    return GetValueSize(eventId) >= 0;
+}
+
+bool AvrcTgNotifyCoalescer::IsStateEvent(uint8_t eventId)
+{
+    return (eventId == AVRC_TG_EVENT_ID_PLAYBACK_STATUS_CHANGED) ||
+           (eventId == AVRC_TG_EVENT_ID_PLAYBACK_POS_CHANGED) || (eventId == AVRC_TG_EVENT_ID_VOLUME_CHANGED);
+}
+
+void AvrcTgNotifyCoalescer::EncodeFrame(uint8_t eventId, Entry &entry)
+{
+    entry.valueSize_ = static_cast<uint8_t>(GetValueSize(eventId));
+    uint16_t parameterLength = AVRC_TG_NOTIFY_EVENT_ID_SIZE + entry.valueSize_;
+
+    uint8_t *frame = entry.frame_;
+    uint8_t offset = 0x00;
+    frame[offset++] = AVRC_TG_RSP_CODE_CHANGED;
+    frame[offset++] = (AVRC_TG_VENDOR_SUBUNIT_TYPE << AVRC_TG_VENDOR_BIT3) | AVRC_TG_VENDOR_SUBUNIT_ID;
+    frame[offset++] = AVRC_TG_OP_CODE_VENDOR;
+    frame[offset++] = static_cast<uint8_t>(AVRC_TG_DEFAULT_BLUETOOTH_SIG_COMPANY_ID >> AVRC_TG_OFFSET_SIXTEEN_BITS);
+    frame[offset++] = static_cast<uint8_t>(AVRC_TG_DEFAULT_BLUETOOTH_SIG_COMPANY_ID >> AVRC_TG_OFFSET_EIGHT_BITS);
+    frame[offset++] = static_cast<uint8_t>(AVRC_TG_DEFAULT_BLUETOOTH_SIG_COMPANY_ID);
+    frame[offset++] = AVRC_TG_PDU_ID_REGISTER_NOTIFICATION;
+    frame[offset++] = AVRC_TG_VENDOR_PACKET_TYPE;
+    frame[offset++] = static_cast<uint8_t>(parameterLength >> AVRC_TG_OFFSET_EIGHT_BITS);
+    frame[offset++] = static_cast<uint8_t>(parameterLength);
+    frame[offset++] = eventId;
+    entry.frameSize_ = offset + entry.valueSize_;
+}
+
+void AvrcTgNotifyCoalescer::SetInterval(uint8_t eventId, uint32_t interval)
+{
+    LOG_DEBUG("[AVRCP TG] AvrcTgNotifyCoalescer::%{public}s", __func__);
+    LOG_DEBUG("[AVRCP TG] eventId[%{public}d] - interval[%{public}u]", eventId, interval);
+
+    if (IsSupportedEvent(eventId)) {
+        entries_[eventId].interval_ = interval;
+    }
+}
+
+void AvrcTgNotifyCoalescer::Record(uint8_t eventId, uint64_t value)
+{
+    if (!IsSupportedEvent(eventId)) {
+        return;
+    }
+
+    Entry &entry = entries_[eventId];
+    entry.isPending_ = false;
+    entry.hasValue_ = true;
+    entry.lastValue_ = value;
+}
+
+bool AvrcTgNotifyCoalescer::Update(uint8_t eventId, uint64_t value, uint8_t label)
+{
+    if (!IsSupportedEvent(eventId)) {
+        return false;
+    }
+
+    Entry &entry = entries_[eventId];
+    /// Only the events whose value is the whole state are suppressed. An equal UID or player ID may still be a new
+    /// track or player, e.g. a TG without browsing reports the UID 0x0 for every track.
+    if (IsStateEvent(eventId) && entry.hasValue_ && entry.lastValue_ == value) {
+        LOG_DEBUG("[AVRCP TG] The value of the event[%{public}d] is unchanged!", eventId);
+        entry.isPending_ = false;
+        return false;
+    }
+
+    entry.isPending_ = true;
+    entry.value_ = value;
+    entry.label_ = label;
+
+    if (isFlushScheduled_) {
+        return false;
+    }
+    isFlushScheduled_ = true;
+
+    return true;
+}
+
+std::vector<AvrcTgNotifyCoalescer::Frame> AvrcTgNotifyCoalescer::Collect(void)
+{
+    LOG_DEBUG("[AVRCP TG] AvrcTgNotifyCoalescer::%{public}s", __func__);
+
+    isFlushScheduled_ = false;
+    timer_->Stop();
+
+    Clock::time_point now = Clock::now();
+    bool isDue = false;
+    bool isPending = false;
+    Clock::time_point deadline = Clock::time_point::max();
+    for (auto &entry : entries_) {
+        if (!entry.isPending_) {
+            continue;
+        }
+        isPending = true;
+        Clock::time_point due = entry.lastSent_ + std::chrono::milliseconds(entry.interval_);
+        if (entry.lastSent_ == Clock::time_point() || due <= now) {
+            isDue = true;
+            break;
+        }
+        deadline = std::min(deadline, due);
+    }
+
+    std::vector<Frame> frames;
+    if (!isDue) {
+        if (isPending) {
+            auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count();
+            timer_->Start(static_cast<int>(ms) + 1);
+        }
+        return frames;
+    }
+
+    /// The link is woken up anyway, so the held events are sent in the same burst.
+    for (uint8_t eventId = 0; eventId < AVRC_TG_EVENT_ID_RESERVED; eventId++) {
+        Entry &entry = entries_[eventId];
+        if (!entry.isPending_) {
+            continue;
+        }
+        uint8_t *value = entry.frame_ + entry.frameSize_ - entry.valueSize_;
+        for (uint8_t i = 0; i < entry.valueSize_; i++) {
+            value[i] = static_cast<uint8_t>(entry.value_ >> (AVRC_TG_OFFSET_EIGHT_BITS * (entry.valueSize_ - i - 1)));
+        }
+        entry.isPending_ = false;
+        entry.hasValue_ = true;
+        entry.lastValue_ = entry.value_;
+        entry.lastSent_ = now;
+        frames.push_back({eventId, entry.label_, entry.frame_, entry.frameSize_});
+    }
+
+    return frames;
+}
+}  // namespace bluetooth
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AVRCP_TG_NOTIFY_COALESCER_H
+#define AVRCP_TG_NOTIFY_COALESCER_H
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "avrcp_tg_notification.h"
+#include "base_def.h"
+#include "timer.h"
+
+namespace bluetooth {
+/**
+ * @brief This enumeration declares the values of the notification coalescer.
+ */
+enum AvrcTgNotifyCoalescerConfig {
+    // The max size of the CHANGED frame: the fixed operands, the "EventID" and the largest value.
+    AVRC_TG_NOTIFY_FRAME_MAX_SIZE = 0x13,
+    // The min interval between two <b>EVENT_VOLUME_CHANGED</b>, in milliseconds.
+    AVRC_TG_NOTIFY_VOLUME_INTERVAL = 200,
+};
+
+/**
+ * @brief This class coalesces the CHANGED responses of the <b>NOTIFICATION</b> command of one connection.
+ *
+ * @details Each event keeps at most one pending CHANGED response, a later value replaces the pending one. A value
+ * of the playback status, the playback position or the volume equal to the last one reported to the CT is dropped.
+ * An event with a min interval is held until the interval has passed since its last CHANGED response, unless another
+ * event is sent, in which case it is sent with the others.
+ * Every supported event has a pre-encoded CHANGED frame, whose value is patched in place before being sent.
+ */
+class AvrcTgNotifyCoalescer {
+public:
+    /**
+     * @brief This struct provides the CHANGED frame to be sent.
+     */
+    struct Frame {
+        uint8_t eventId_;      // The value of the "EventID".
+        uint8_t label_;        // The label of the registration.
+        const uint8_t *data_;  // The pre-encoded frame, valid until the next call of the <b>Collect</b>.
+        size_t size_;          // The size of the frame.
+    };
+
+    /**
+     * @brief A constructor used to create an <b>AvrcTgNotifyCoalescer</b> instance.
+     *
+     * @param[in] timeout The callback function, which is called in the thread of the timer when the held events are
+     * due.
+     */
+    explicit AvrcTgNotifyCoalescer(const std::function<void()> &timeout);
+
+    /**
+     * @brief A destructor used to delete the <b>AvrcTgNotifyCoalescer</b> instance.
+     */
+    ~AvrcTgNotifyCoalescer();
+
+    /**
+     * @brief Checks the CHANGED response of the event is coalesced or not.
+     *
+     * @param[in] eventId The value of the "EventID".
+     * @return The result of the method execution.
+     * @retval true  The event is coalesced.
+     * @retval false The event is sent directly.
+     */
+    static bool IsSupportedEvent(uint8_t eventId);
+
+    /**
+     * @brief Sets the min interval between two CHANGED responses of the event.
+     *
+     * @param[in] eventId  The value of the "EventID".
+     * @param[in] interval The min interval in milliseconds.
+     */
+    void SetInterval(uint8_t eventId, uint32_t interval);
+
+    /**
+     * @brief Records the value reported by the INTERIM response, and drops the pending CHANGED response.
+     *
+     * @param[in] eventId The value of the "EventID".
+     * @param[in] value   The value of the event.
+     */
+    void Record(uint8_t eventId, uint64_t value);
+
+    /**
+     * @brief Updates the pending CHANGED response of the event.
+     *
+     * @param[in] eventId The value of the "EventID".
+     * @param[in] value   The value of the event.
+     * @param[in] label   The label of the registration.
+     * @return The result of the method execution.
+     * @retval true  A flush has to be scheduled.
+     * @retval false A flush has been scheduled, or there is nothing to send.
+     */
+    bool Update(uint8_t eventId, uint64_t value, uint8_t label);
+
+    /**
+     * @brief Collects the pending CHANGED responses to be sent in one burst.
+     *
+     * @details If no pending event is due, nothing is collected and the timer is started for the earliest one.
+     * @return The frames to be sent.
+     */
+    std::vector<Frame> Collect(void);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief This struct provides the state of one event.
+     */
+    struct Entry {
+        bool isPending_ {false};                             // The CHANGED response is pending or not.
+        bool hasValue_ {false};                              // The last value is known or not.
+        uint8_t label_ {0};                                  // The label of the pending CHANGED response.
+        uint64_t value_ {0};                                 // The value of the pending CHANGED response.
+        uint64_t lastValue_ {0};                             // The value last reported to the CT.
+        Clock::time_point lastSent_ {};                      // The time of the last CHANGED response.
+        uint32_t interval_ {0};                              // The min interval between two CHANGED responses.
+        uint8_t frame_[AVRC_TG_NOTIFY_FRAME_MAX_SIZE] {};    // The pre-encoded CHANGED frame.
+        uint8_t frameSize_ {0};                              // The size of the pre-encoded CHANGED frame.
+        uint8_t valueSize_ {0};                              // The size of the value in the frame.
+    };
+
+    /**
+     * @brief Checks the value of the event is the whole state or not, a CHANGED response equal to the last one
+     * reported is dropped only for these events.
+     *
+     * @param[in] eventId The value of the "EventID".
+     * @return The result of the method execution.
+     * @retval true  The event reports a state.
+     * @retval false The event reports an identifier, which may be equal for a new item.
+     */
+    static bool IsStateEvent(uint8_t eventId);
+
+    /**
+     * @brief Gets the size of the value of the event.
+     *
+     * @param[in] eventId The value of the "EventID".
+     * @return The size of the value, or -1 if the event is not coalesced.
+     */
+    static int GetValueSize(uint8_t eventId);
+
+    /**
+     * @brief Pre-encodes the CHANGED frame of the event.
+     *
+     * @param[in] eventId The value of the "EventID".
+     * @param[in] entry   The state of the event.
+     */
+    static void EncodeFrame(uint8_t eventId, Entry &entry);
+
+    // The state of the events, indexed by the "EventID".
+    Entry entries_[AVRC_TG_EVENT_ID_RESERVED] {};
+    // A flush has been scheduled or not.
+    bool isFlushScheduled_ {false};
+    // The timer of the held events.
+    std::unique_ptr<utility::Timer> timer_ {nullptr};
+
+    DISALLOW_COPY_AND_ASSIGN(AvrcTgNotifyCoalescer);
+};
+}  // namespace bluetooth
+
+#endif  // AVRCP_TG_NOTIFY_COALESCER_H
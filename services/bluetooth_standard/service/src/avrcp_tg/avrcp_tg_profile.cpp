@@ -24,6 +24,7 @@
 #include "avrcp_tg_vendor_continuation.h"
 #include "avrcp_tg_vendor_player_application_settings.h"
 #include "power_manager.h"
+#include "securec.h"
 
 namespace bluetooth {
 bool AvrcTgProfile::g_isEnabled = false;
@@ -99,6 +100,7 @@ int AvrcTgProfile::Disable(void)
     do {
         std::lock_guard<std::recursive_mutex> lock(mutex_);
         SetEnableFlag(false);
+        coalescers_.clear();
     } while (false);
 
     AvrcTgConnectManager *cnManager = AvrcTgConnectManager::GetInstance();
@@ -581,6 +583,93 @@ void AvrcTgProfile::SendVendorRsp(
     AvrcTgStateMachineManager::GetInstance()->SendMessageToControlStateMachine(rawAddr, msg);
 }
 
+AvrcTgNotifyCoalescer &AvrcTgProfile::GetNotifyCoalescer(const RawAddress &rawAddr)
+{
+    LOG_DEBUG("[AVRCP TG] AvrcTgProfile::%{public}s", __func__);
+
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+
+    auto iter = coalescers_.find(rawAddr.GetAddress());
+    if (iter == coalescers_.end()) {
+        auto func = std::bind(&AvrcTgProfile::NotifyTimeoutCallback, this, rawAddr);
+        iter = coalescers_.emplace(rawAddr.GetAddress(), std::make_unique<AvrcTgNotifyCoalescer>(func)).first;
+    }
+
+    return *iter->second;
+}
+
+void AvrcTgProfile::RecordNotifyValue(const RawAddress &rawAddr, uint8_t eventId, uint64_t value)
+{
+    LOG_DEBUG("[AVRCP TG] AvrcTgProfile::%{public}s", __func__);
+
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+
+    GetNotifyCoalescer(rawAddr).Record(eventId, value);
+}
+
+void AvrcTgProfile::SendChangedNotification(const RawAddress &rawAddr, uint8_t eventId, uint64_t value, uint8_t label)
+{
+    LOG_DEBUG("[AVRCP TG] AvrcTgProfile::%{public}s", __func__);
+    LOG_DEBUG("[AVRCP TG] eventId[%{public}d] - label[%{public}d]", eventId, label);
+
+    if (!AvrcTgConnectManager::GetInstance()->IsNotifyStateEnabled(rawAddr, eventId)) {
+        return;
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+
+    if (GetNotifyCoalescer(rawAddr).Update(eventId, value, label)) {
+        /// Flushes after the current task, so the notifications fired together are sent in one burst.
+        dispatcher_->PostTask(std::bind(&AvrcTgProfile::FlushNotifications, this, rawAddr));
+    }
+}
+
+void AvrcTgProfile::FlushNotifications(RawAddress rawAddr)
+{
+    LOG_DEBUG("[AVRCP TG] AvrcTgProfile::%{public}s", __func__);
+
+    if (!IsEnabled()) {
+        return;
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+
+    auto iter = coalescers_.find(rawAddr.GetAddress());
+    if (iter == coalescers_.end()) {
+        return;
+    }
+
+    std::vector<AvrcTgNotifyCoalescer::Frame> frames = iter->second->Collect();
+    if (frames.empty()) {
+        return;
+    }
+
+    AvrcTgConnectManager *cnManager = AvrcTgConnectManager::GetInstance();
+    IPowerManager::GetInstance().StatusUpdate(RequestStatus::BUSY, PROFILE_NAME_AVRCP_TG, rawAddr);
+    for (auto &frame : frames) {
+        if (!cnManager->IsNotifyStateEnabled(rawAddr, frame.eventId_)) {
+            continue;
+        }
+
+        Packet *pkt = PacketMalloc(0x00, 0x00, frame.size_);
+        (void)memcpy_s(BufferPtr(PacketContinuousPayload(pkt)), frame.size_, frame.data_, frame.size_);
+        AVCT_SendMsgReq(cnManager->GetConnectId(rawAddr), frame.label_, AVCT_RESPONSE, pkt);
+        PacketFree(pkt);
+
+        cnManager->DisableNotifyState(rawAddr, frame.eventId_);
+    }
+    IPowerManager::GetInstance().StatusUpdate(RequestStatus::IDLE, PROFILE_NAME_AVRCP_TG, rawAddr);
+}
+
+void AvrcTgProfile::NotifyTimeoutCallback(const RawAddress &rawAddr)
+{
+    LOG_DEBUG("[AVRCP TG] AvrcTgProfile::%{public}s", __func__);
+
+    if (IsEnabled()) {
+        dispatcher_->PostTask(std::bind(&AvrcTgProfile::FlushNotifications, this, rawAddr));
+    }
+}
+
 void AvrcTgProfile::SendGetCapabilitiesRsp(
     const RawAddress &rawAddr, const std::vector<uint32_t> &companies, uint8_t label, int result)
 {
@@ -1051,6 +1140,11 @@ void AvrcTgProfile::SendPlaybackStatusChangedRsp(bool isInterim, uint8_t playSta
     AvrcTgConnectManager *cnManager = AvrcTgConnectManager::GetInstance();
     RawAddress rawAddr(cnManager->GetActiveDevice());
 
+    if (!isInterim && result == RET_NO_ERROR) {
+        SendChangedNotification(rawAddr, AVRC_TG_EVENT_ID_PLAYBACK_STATUS_CHANGED, playStatus, label);
+        return;
+    }
+
     if (cnManager->IsNotifyStateEnabled(rawAddr, AVRC_TG_EVENT_ID_PLAYBACK_STATUS_CHANGED)) {
         uint8_t crCode = ExplainResultToControlCrCode(result);
         if (isInterim && crCode == AVRC_TG_RSP_CODE_ACCEPTED) {
@@ -1058,6 +1152,9 @@ void AvrcTgProfile::SendPlaybackStatusChangedRsp(bool isInterim, uint8_t playSta
         } else if (!isInterim && crCode == AVRC_TG_RSP_CODE_ACCEPTED) {
             crCode = AVRC_TG_RSP_CODE_CHANGED;
         }
+        if (crCode == AVRC_TG_RSP_CODE_INTERIM) {
+            RecordNotifyValue(rawAddr, AVRC_TG_EVENT_ID_PLAYBACK_STATUS_CHANGED, playStatus);
+        }
 
         std::shared_ptr<AvrcTgNotifyPacket> notifyPkt =
             std::make_shared<AvrcTgNotifyPacket>(AVRC_TG_EVENT_ID_PLAYBACK_STATUS_CHANGED, crCode, label);
@@ -1081,6 +1178,11 @@ void AvrcTgProfile::SendTrackChangedRsp(bool isInterim, uint64_t identifier, uin
     AvrcTgConnectManager *cnManager = AvrcTgConnectManager::GetInstance();
     RawAddress rawAddr(cnManager->GetActiveDevice());
 
+    if (!isInterim && result == RET_NO_ERROR) {
+        SendChangedNotification(rawAddr, AVRC_TG_EVENT_ID_TRACK_CHANGED, identifier, label);
+        return;
+    }
+
     if (cnManager->IsNotifyStateEnabled(rawAddr, AVRC_TG_EVENT_ID_TRACK_CHANGED)) {
         uint8_t crCode = ExplainResultToControlCrCode(result);
         if (isInterim && crCode == AVRC_TG_RSP_CODE_ACCEPTED) {
@@ -1088,6 +1190,9 @@ void AvrcTgProfile::SendTrackChangedRsp(bool isInterim, uint64_t identifier, uin
         } else if (!isInterim && crCode == AVRC_TG_RSP_CODE_ACCEPTED) {
             crCode = AVRC_TG_RSP_CODE_CHANGED;
         }
+        if (crCode == AVRC_TG_RSP_CODE_INTERIM) {
+            RecordNotifyValue(rawAddr, AVRC_TG_EVENT_ID_TRACK_CHANGED, identifier);
+        }
 
         std::shared_ptr<AvrcTgNotifyPacket> notifyPkt =
             std::make_shared<AvrcTgNotifyPacket>(AVRC_TG_EVENT_ID_TRACK_CHANGED, crCode, label);
@@ -1111,6 +1216,11 @@ void AvrcTgProfile::SendTrackReachedEndRsp(bool isInterim, uint8_t label, int re
     AvrcTgConnectManager *cnManager = AvrcTgConnectManager::GetInstance();
     RawAddress rawAddr(cnManager->GetActiveDevice());
 
+    if (!isInterim && result == RET_NO_ERROR) {
+        SendChangedNotification(rawAddr, AVRC_TG_EVENT_ID_TRACK_REACHED_END, 0, label);
+        return;
+    }
+
     if (cnManager->IsNotifyStateEnabled(rawAddr, AVRC_TG_EVENT_ID_TRACK_REACHED_END)) {
         uint8_t crCode = ExplainResultToControlCrCode(result);
         if (isInterim && crCode == AVRC_TG_RSP_CODE_ACCEPTED) {
@@ -1140,6 +1250,11 @@ void AvrcTgProfile::SendTrackReachedStartRsp(bool isInterim, uint8_t label, int
     AvrcTgConnectManager *cnManager = AvrcTgConnectManager::GetInstance();
     RawAddress rawAddr(cnManager->GetActiveDevice());
 
+    if (!isInterim && result == RET_NO_ERROR) {
+        SendChangedNotification(rawAddr, AVRC_TG_EVENT_ID_TRACK_REACHED_START, 0, label);
+        return;
+    }
+
     if (cnManager->IsNotifyStateEnabled(rawAddr, AVRC_TG_EVENT_ID_TRACK_REACHED_START)) {
         uint8_t crCode = ExplainResultToControlCrCode(result);
         if (isInterim && crCode == AVRC_TG_RSP_CODE_ACCEPTED) {
@@ -1169,6 +1284,11 @@ void AvrcTgProfile::SendPlaybackPosChangedRsp(bool isInterim, uint32_t playbackP
     AvrcTgConnectManager *cnManager = AvrcTgConnectManager::GetInstance();
     RawAddress rawAddr(cnManager->GetActiveDevice());
 
+    if (!isInterim && result == RET_NO_ERROR) {
+        SendChangedNotification(rawAddr, AVRC_TG_EVENT_ID_PLAYBACK_POS_CHANGED, playbackPos, label);
+        return;
+    }
+
     if (cnManager->IsNotifyStateEnabled(rawAddr, AVRC_TG_EVENT_ID_PLAYBACK_POS_CHANGED)) {
         uint8_t crCode = ExplainResultToControlCrCode(result);
         if (isInterim && crCode == AVRC_TG_RSP_CODE_ACCEPTED) {
@@ -1176,6 +1296,9 @@ void AvrcTgProfile::SendPlaybackPosChangedRsp(bool isInterim, uint32_t playbackP
         } else if (!isInterim && crCode == AVRC_TG_RSP_CODE_ACCEPTED) {
             crCode = AVRC_TG_RSP_CODE_CHANGED;
         }
+        if (crCode == AVRC_TG_RSP_CODE_INTERIM) {
+            RecordNotifyValue(rawAddr, AVRC_TG_EVENT_ID_PLAYBACK_POS_CHANGED, playbackPos);
+        }
 
         std::shared_ptr<AvrcTgNotifyPacket> notifyPkt =
             std::make_shared<AvrcTgNotifyPacket>(AVRC_TG_EVENT_ID_PLAYBACK_POS_CHANGED, crCode, label);
@@ -1230,6 +1353,11 @@ void AvrcTgProfile::SendNowPlayingContentChangedRsp(bool isInterim, uint8_t labe
     AvrcTgConnectManager *cnManager = AvrcTgConnectManager::GetInstance();
     RawAddress rawAddr(cnManager->GetActiveDevice());
 
+    if (!isInterim && result == RET_NO_ERROR) {
+        SendChangedNotification(rawAddr, AVRC_TG_EVENT_ID_NOW_PLAYING_CONTENT_CHANGED, 0, label);
+        return;
+    }
+
     if (cnManager->IsNotifyStateEnabled(rawAddr, AVRC_TG_EVENT_ID_NOW_PLAYING_CONTENT_CHANGED)) {
         uint8_t crCode = ExplainResultToControlCrCode(result);
         if (isInterim && crCode == AVRC_TG_RSP_CODE_ACCEPTED) {
@@ -1259,6 +1387,11 @@ void AvrcTgProfile::SendAvailablePlayersChangedRsp(bool isInterim, uint8_t label
     AvrcTgConnectManager *cnManager = AvrcTgConnectManager::GetInstance();
     RawAddress rawAddr(cnManager->GetActiveDevice());
 
+    if (!isInterim && result == RET_NO_ERROR) {
+        SendChangedNotification(rawAddr, AVRC_TG_EVENT_ID_AVAILABLE_PLAYERS_CHANGED, 0, label);
+        return;
+    }
+
     if (cnManager->IsNotifyStateEnabled(rawAddr, AVRC_TG_EVENT_ID_AVAILABLE_PLAYERS_CHANGED)) {
         uint8_t crCode = ExplainResultToControlCrCode(result);
         if (isInterim && crCode == AVRC_TG_RSP_CODE_ACCEPTED) {
@@ -1288,6 +1421,12 @@ void AvrcTgProfile::SendAddressedPlayerChangedRsp(
 
     AvrcTgConnectManager *cnManager = AvrcTgConnectManager::GetInstance();
     RawAddress rawAddr(cnManager->GetActiveDevice());
+    uint64_t value = (static_cast<uint32_t>(playerId) << AVRC_TG_OFFSET_SIXTEEN_BITS) | uidCounter;
+
+    if (!isInterim && result == RET_NO_ERROR) {
+        SendChangedNotification(rawAddr, AVRC_TG_EVENT_ID_ADDRESSED_PLAYER_CHANGED, value, label);
+        return;
+    }
 
     if (cnManager->IsNotifyStateEnabled(rawAddr, AVRC_TG_EVENT_ID_ADDRESSED_PLAYER_CHANGED)) {
         uint8_t crCode = ExplainResultToControlCrCode(result);
@@ -1296,6 +1435,9 @@ void AvrcTgProfile::SendAddressedPlayerChangedRsp(
         } else if (!isInterim && crCode == AVRC_TG_RSP_CODE_ACCEPTED) {
             crCode = AVRC_TG_RSP_CODE_CHANGED;
         }
+        if (crCode == AVRC_TG_RSP_CODE_INTERIM) {
+            RecordNotifyValue(rawAddr, AVRC_TG_EVENT_ID_ADDRESSED_PLAYER_CHANGED, value);
+        }
 
         std::shared_ptr<AvrcTgNotifyPacket> notifyPkt =
             std::make_shared<AvrcTgNotifyPacket>(AVRC_TG_EVENT_ID_ADDRESSED_PLAYER_CHANGED, crCode, label);
@@ -1319,6 +1461,11 @@ void AvrcTgProfile::SendUidsChangedRsp(bool isInterim, uint16_t uidCounter, uint
     AvrcTgConnectManager *cnManager = AvrcTgConnectManager::GetInstance();
     RawAddress rawAddr(cnManager->GetActiveDevice());
 
+    if (!isInterim && result == RET_NO_ERROR) {
+        SendChangedNotification(rawAddr, AVRC_TG_EVENT_ID_UIDS_CHANGED, uidCounter, label);
+        return;
+    }
+
     if (cnManager->IsNotifyStateEnabled(rawAddr, AVRC_TG_EVENT_ID_UIDS_CHANGED)) {
         uint8_t crCode = ExplainResultToControlCrCode(result);
         if (isInterim && crCode == AVRC_TG_RSP_CODE_ACCEPTED) {
@@ -1326,6 +1473,9 @@ void AvrcTgProfile::SendUidsChangedRsp(bool isInterim, uint16_t uidCounter, uint
         } else if (!isInterim && crCode == AVRC_TG_RSP_CODE_ACCEPTED) {
             crCode = AVRC_TG_RSP_CODE_CHANGED;
         }
+        if (crCode == AVRC_TG_RSP_CODE_INTERIM) {
+            RecordNotifyValue(rawAddr, AVRC_TG_EVENT_ID_UIDS_CHANGED, uidCounter);
+        }
 
         std::shared_ptr<AvrcTgNotifyPacket> notifyPkt =
             std::make_shared<AvrcTgNotifyPacket>(AVRC_TG_EVENT_ID_UIDS_CHANGED, crCode, label);
@@ -1349,6 +1499,11 @@ void AvrcTgProfile::SendVolumeChangedRsp(bool isInterim, uint8_t volume, uint8_t
     AvrcTgConnectManager *cnManager = AvrcTgConnectManager::GetInstance();
     RawAddress rawAddr(cnManager->GetActiveDevice());
 
+    if (!isInterim && result == RET_NO_ERROR) {
+        SendChangedNotification(rawAddr, AVRC_TG_EVENT_ID_VOLUME_CHANGED, volume, label);
+        return;
+    }
+
     if (cnManager->IsNotifyStateEnabled(rawAddr, AVRC_TG_EVENT_ID_VOLUME_CHANGED)) {
         uint8_t crCode = ExplainResultToControlCrCode(result);
         if (isInterim && crCode == AVRC_TG_RSP_CODE_ACCEPTED) {
@@ -1356,6 +1511,9 @@ void AvrcTgProfile::SendVolumeChangedRsp(bool isInterim, uint8_t volume, uint8_t
         } else if (!isInterim && crCode == AVRC_TG_RSP_CODE_ACCEPTED) {
             crCode = AVRC_TG_RSP_CODE_CHANGED;
         }
+        if (crCode == AVRC_TG_RSP_CODE_INTERIM) {
+            RecordNotifyValue(rawAddr, AVRC_TG_EVENT_ID_VOLUME_CHANGED, volume);
+        }
 
         std::shared_ptr<AvrcTgNotifyPacket> notifyPkt =
             std::make_shared<AvrcTgNotifyPacket>(AVRC_TG_EVENT_ID_VOLUME_CHANGED, crCode, label);
@@ -1403,6 +1561,8 @@ void AvrcTgProfile::ReceiveRegisterNotificationCmd(const RawAddress &rawAddr, ui
         case AVRC_TG_EVENT_ID_PLAYBACK_POS_CHANGED:
             if (notifyPkt->IsValid()) {
                 myObserver_->setPlaybackInterval(rawAddr, notifyPkt->GetPlaybackInterval());
+                GetNotifyCoalescer(rawAddr).SetInterval(
+                    AVRC_TG_EVENT_ID_PLAYBACK_POS_CHANGED, notifyPkt->GetPlaybackInterval() * MS_PER_SECOND);
                 myObserver_->getPlayStatus(rawAddr, label, AVRC_ACTION_TYPE_NOTIFY_PLAYBACK_POS_CHANGED);
             }
             break;
@@ -2010,6 +2170,9 @@ void AvrcTgProfile::DeleteResource(const RawAddress &rawAddr)
 
     AvrcTgConnectManager::GetInstance()->Delete(rawAddr);
     AvrcTgStateMachineManager::GetInstance()->DeletePairOfStateMachine(rawAddr);
+
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    coalescers_.erase(rawAddr.GetAddress());
 }
 
 void AvrcTgProfile::DeleteBrowseStateMachine(const RawAddress &rawAddr)
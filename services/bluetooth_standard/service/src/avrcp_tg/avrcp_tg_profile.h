@@ -17,8 +17,11 @@
 #define AVRCP_TG_PROFILE_H
 
 #include <deque>
+#include <map>
+#include <memory>
 #include "avrcp_media.h"
 #include "avrcp_tg_internal.h"
+#include "avrcp_tg_notify_coalescer.h"
 #include "avrcp_tg_state_machine.h"
 #include "base_def.h"
 #include "dispatcher.h"
@@ -1004,6 +1007,8 @@ private:
     AvctMsgCallback msgCallback_ {nullptr};
     // Locks the local variable in a multi-threaded environment.
     std::recursive_mutex mutex_ {};
+    /// The coalescers of the CHANGED responses, according to the address of the bluetooth device.
+    std::map<std::string, std::unique_ptr<AvrcTgNotifyCoalescer>> coalescers_ {};
     /**
      * @brief A deleted default constructor.
      */
@@ -1125,6 +1130,49 @@ private:
      */
     static void SendVendorRsp(const RawAddress &rawAddr, std::shared_ptr<AvrcTgVendorPacket> &pkt, AvrcTgSmEvent event);
 
+    /**
+     * @brief Gets the coalescer of the CHANGED responses of the specified device, which is created if it does not
+     * exist.
+     *
+     * @param[in] rawAddr The address of the bluetooth device.
+     * @return The reference of the coalescer.
+     */
+    AvrcTgNotifyCoalescer &GetNotifyCoalescer(const RawAddress &rawAddr);
+
+    /**
+     * @brief Records the value reported by the INTERIM response of the <b>NOTIFICATION</b>.
+     *
+     * @param[in] rawAddr The address of the bluetooth device.
+     * @param[in] eventId The value of the "EventID".
+     * @param[in] value   The value of the event.
+     */
+    void RecordNotifyValue(const RawAddress &rawAddr, uint8_t eventId, uint64_t value);
+
+    /**
+     * @brief Queues the CHANGED response of the <b>NOTIFICATION</b>, which is sent by the <b>FlushNotifications</b>.
+     *
+     * @param[in] rawAddr The address of the bluetooth device.
+     * @param[in] eventId The value of the "EventID".
+     * @param[in] value   The value of the event.
+     * @param[in] label   The label which is used to distinguish different call.
+     */
+    void SendChangedNotification(const RawAddress &rawAddr, uint8_t eventId, uint64_t value, uint8_t label);
+
+    /**
+     * @brief Sends the due CHANGED responses of the <b>NOTIFICATION</b> in one burst.
+     *
+     * @param[in] rawAddr The address of the bluetooth device.
+     */
+    void FlushNotifications(RawAddress rawAddr);
+
+    /**
+     * @brief The callback function, which registers into the <b>AvrcTgNotifyCoalescer</b>.
+     *
+     * @details This function switches to the thread of the AVRCP TG service firstly, then flushes the notifications.
+     * @param[in] rawAddr The address of the bluetooth device.
+     */
+    void NotifyTimeoutCallback(const RawAddress &rawAddr);
+
     /**
      * @brief Receives the command of the <b>GetCapabilities</b>.
      *
@@ -1349,7 +1397,7 @@ private:
      *
      * @param[in] rawAddr The address of the bluetooth device.
      */
-    static void DeleteResource(const RawAddress &rawAddr);
+    void DeleteResource(const RawAddress &rawAddr);
 
     /**
      * @brief Deletes the browse state machine.
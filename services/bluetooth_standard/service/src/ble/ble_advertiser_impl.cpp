@@ -16,6 +16,8 @@
 #include "ble_advertiser_impl.h"
 
 #include <algorithm>
+#include <deque>
+#include <set>
 
 #include "ble_adapter.h"
 #include "ble_defs.h"
@@ -26,6 +28,40 @@
 #include "securec.h"
 
 namespace bluetooth {
+/// Advertising or scan response payload with the local name and tx power appended, rebuilt only when an input changes.
+struct BleAdvertiserEncodedData {
+    bool IsValid(const std::string &source, const std::string &name, int8_t txPower, size_t maxLen, bool withName) const
+    {
+        return valid_ && (txPower_ == txPower) && (maxLen_ == maxLen) && (withName_ == withName) &&
+               (source_ == source) && (name_ == name);
+    }
+
+    bool valid_ = false;
+    std::string source_ {};
+    std::string name_ {};
+    int8_t txPower_ = 0;
+    size_t maxLen_ = 0;
+    bool withName_ = false;
+    int status_ = BT_NO_ERROR;
+    std::string payload_ {};
+    /// Bumped whenever payload_ changes, so a running set only rewrites what differs.
+    uint32_t generation_ = 0;
+};
+
+struct BleAdvertiserEncodedSet {
+    BleAdvertiserEncodedData adv_ {};
+    BleAdvertiserEncodedData rsp_ {};
+    /// Tx power the controller selected for the current parameters, advertised in place of the requested one.
+    bool hasSelectedTxPower_ = false;
+    int8_t selectedTxPower_ = 0;
+};
+
+struct BleAdvertiserUpdateData {
+    BleAdvertiserSettingsImpl settings_ {};
+    BleAdvertiserDataImpl advData_ {};
+    BleAdvertiserDataImpl rspData_ {};
+};
+
 struct BleAdvertiserImpl::impl {
     std::map<uint8_t, BleAdvertiserImplWrapData> advHandleSettingDatas_ {};
     std::recursive_mutex mutex_ {};
@@ -36,7 +72,29 @@ struct BleAdvertiserImpl::impl {
     uint8_t advStartHandle_ = BLE_INVALID_ADVERTISING_HANDLE;
     uint8_t advStopHandle_ = BLE_INVALID_ADVERTISING_HANDLE;
     bool isStopAdv_ = false;
-    bool operationLast_ = false;
+    /// Set while an extended advertising start sequence is in flight
+    bool isExAdvStarting_ = false;
+    /// Data set commands of the start sequence still waiting for completion
+    size_t pendingFragments_ = 0;
+    std::map<uint8_t, BleAdvertiserEncodedSet> encodedDatas_ {};
+    /// Restarts of extended sets collected until the next flush
+    std::map<uint8_t, BleAdvertiserUpdateData> pendingUpdates_ {};
+    bool isUpdateScheduled_ = false;
+    /// Advertising handle per outstanding update command, BLE_INVALID_ADVERTISING_HANDLE for batched enables
+    std::deque<uint8_t> updateEvents_ {};
+    std::map<uint8_t, int> updateResults_ {};
+    /// New settings and data of the sets being updated, committed once their update succeeded
+    std::map<uint8_t, BleAdvertiserUpdateData> updateDatas_ {};
+    /// Sets disabled by the running update, enabled again once all their commands completed
+    std::vector<uint8_t> updateRestartHandles_ {};
+    /// Stops and address rotations requested while another sequence was in flight
+    std::set<uint8_t> pendingStops_ {};
+    std::set<uint8_t> pendingRotations_ {};
+    /// Set while a single extended set is being stopped
+    bool isExAdvStopping_ = false;
+    /// Set whose resolvable private address is being rotated, and whether it has been disabled for that yet
+    uint8_t rotateHandle_ = BLE_INVALID_ADVERTISING_HANDLE;
+    bool isRotateDisabled_ = false;
     STOP_ALL_ADV_TYPE stopAllAdvType_ = STOP_ADV_TYPE_SINGLE;
     /// Gap callback pointer
     /// Advertising parameters
@@ -244,25 +302,17 @@ void BleAdvertiserImpl::StartAdvertising(const BleAdvertiserSettingsImpl &settin
     LOG_DEBUG("[BleAdvertiserImpl] %{public}s", __func__);
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->mutex_);
-    pimpl->advStartHandle_ = advHandle;
     int advStatus = ADVERTISE_NOT_STARTED;
     auto iter = pimpl->advHandleSettingDatas_.find(advHandle);
     if (iter != pimpl->advHandleSettingDatas_.end()) {
         advStatus = iter->second.advStatus_;
     }
 
-    if (BleFeature::GetInstance().IsLeExtendedAdvertisingSupported()) {
-        if ((advStatus == ADVERTISE_FAILED_ALREADY_STARTED) && (pimpl->advStartHandle_ == advHandle)) {
-            LOG_ERROR("[BleAdvertiserImpl] %{public}s:Extend Advertising has started already.", __func__);
-            callback_->OnStartResultEvent(ADVERTISE_FAILED_ALREADY_STARTED, advHandle);
-            return;
-        }
-    } else {
-        if (advStatus == ADVERTISE_FAILED_ALREADY_STARTED) {
-            LOG_ERROR("[BleAdvertiserImpl] %{public}s:Advertising has started already.", __func__);
-            callback_->OnStartResultEvent(ADVERTISE_FAILED_ALREADY_STARTED, advHandle);
-            return;
-        }
+    bool isExAdv = BleFeature::GetInstance().IsLeExtendedAdvertisingSupported();
+    if ((!isExAdv) && (advStatus == ADVERTISE_FAILED_ALREADY_STARTED)) {
+        LOG_ERROR("[BleAdvertiserImpl] %{public}s:Advertising has started already.", __func__);
+        callback_->OnStartResultEvent(ADVERTISE_FAILED_ALREADY_STARTED, advHandle);
+        return;
     }
 
     int ret = CheckAdvertiserPara(settings, advData, scanResponse);
@@ -272,6 +322,13 @@ void BleAdvertiserImpl::StartAdvertising(const BleAdvertiserSettingsImpl &settin
         return;
     }
 
+    /// Restarting a running extended set only rewrites what changed, batched with the other pending restarts.
+    if (isExAdv && ((advStatus == ADVERTISE_FAILED_ALREADY_STARTED) || IsExAdvBusy())) {
+        QueueAdvertisingUpdate(settings, advData, scanResponse, advHandle);
+        return;
+    }
+
+    pimpl->advStartHandle_ = advHandle;
     advStatus = ADVERTISE_FAILED_ALREADY_STARTED;
     if (iter != pimpl->advHandleSettingDatas_.end()) {
         if (iter->second.timer_ != nullptr) {
@@ -332,7 +389,8 @@ void BleAdvertiserImpl::ExtentAdvertising(uint8_t advHandle)
     }
 
     pimpl->isStopAdv_ = false;
-    ret = SetExAdvParamToGap(iter->second.settings_);
+    pimpl->isExAdvStarting_ = true;
+    ret = SetExAdvParamToGap(advHandle, iter->second.settings_);
     if (ret != BT_NO_ERROR) {
         iter->second.advStatus_ = ADVERTISE_FAILED_INTERNAL_ERROR;
         LOG_ERROR("Set adv parameter to gap failed!");
@@ -358,6 +416,16 @@ void BleAdvertiserImpl::StopAdvertising(uint8_t advHandle) const
         return;
     }
 
+    bool isExAdv = BleFeature::GetInstance().IsLeExtendedAdvertisingSupported();
+    if (isExAdv && IsExAdvBusy()) {
+        /// Sent once the running sequence completes, so the disable is not taken for one of its commands.
+        /// The stop supersedes a restart or an address rotation of the set still waiting.
+        pimpl->pendingStops_.insert(advHandle);
+        pimpl->pendingUpdates_.erase(advHandle);
+        pimpl->pendingRotations_.erase(advHandle);
+        return;
+    }
+
     int ret;
     pimpl->advStopHandle_ = advHandle;
     iter->second.stopAllAdvType_ = STOP_ADV_TYPE_SINGLE;
@@ -366,7 +434,7 @@ void BleAdvertiserImpl::StopAdvertising(uint8_t advHandle) const
         iter->second.timer_->Stop();
         iter->second.timer_ = nullptr;
     }
-    if (BleFeature::GetInstance().IsLeExtendedAdvertisingSupported()) {
+    if (isExAdv) {
         ret = SetExAdvEnableToGap(advHandle, false);
     } else {
         ret = SetAdvEnableToGap(false);
@@ -377,6 +445,7 @@ void BleAdvertiserImpl::StopAdvertising(uint8_t advHandle) const
         callback_->OnStartResultEvent(ret, advHandle);
     } else {
         pimpl->isStopAdv_ = true;
+        pimpl->isExAdvStopping_ = isExAdv;
         iter->second.advStatus_ = ADVERTISE_NOT_STARTED;
         LOG_DEBUG("[BleAdvertiserImpl] %{public}s:Stop advertising success!.", __func__);
     }
@@ -587,7 +656,16 @@ void BleAdvertiserImpl::ExAdvSetEnableResultTask(uint8_t status)
     LOG_DEBUG("[BleAdvertiserImpl] %{public}s", __func__);
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->mutex_);
+    if (pimpl->rotateHandle_ != BLE_INVALID_ADVERTISING_HANDLE) {
+        RotateAddressResult(status);
+        return;
+    }
+    if (!pimpl->updateEvents_.empty()) {
+        AdvertisingUpdateResult(status);
+        return;
+    }
     if (pimpl->isStopAdv_) {
+        pimpl->isExAdvStopping_ = false;
         switch (pimpl->stopAllAdvType_) {
             case STOP_ADV_TYPE_ALL:
                 HandleGapExAdvEvent(BLE_GAP_EX_ALL_ADV_STOP_COMPLETE_EVT, status);
@@ -734,7 +812,7 @@ int BleAdvertiserImpl::SetAdvParamToGap(const BleAdvertiserSettingsImpl &setting
     return GAPIF_LeAdvSetParam(advType, para);
 }
 
-int BleAdvertiserImpl::SetExAdvParamToGap(const BleAdvertiserSettingsImpl &settings) const
+int BleAdvertiserImpl::SetExAdvParamToGap(uint8_t advHandle, const BleAdvertiserSettingsImpl &settings) const
 {
     LOG_DEBUG("[BleAdvertiserImpl] %{public}s", __func__);
 
@@ -767,7 +845,7 @@ int BleAdvertiserImpl::SetExAdvParamToGap(const BleAdvertiserSettingsImpl &setti
             advType |= GAP_ADVERTISING_PROPERTY_SCANABLE | GAP_ADVERTISING_PROPERTY_INCLUDE_TXPOWER;
         }
     }
-    return GAPIF_LeExAdvSetParam(pimpl->advStartHandle_, advType, settings.GetTxPower(), para);
+    return GAPIF_LeExAdvSetParam(advHandle, advType, settings.GetTxPower(), para);
 }
 
 int BleAdvertiserImpl::CheckAdvertiserLen(uint8_t payload, uint8_t advType)
@@ -823,143 +901,125 @@ int BleAdvertiserImpl::CheckAdvertiserFlag(const std::string &payload) const
     return BT_NO_ERROR;
 }
 
-int BleAdvertiserImpl::SetAdvDataToGap(
-    const BleAdvertiserDataImpl &advData, const BleAdvertiserSettingsImpl &settings, int8_t txPowerLevel) const
+int BleAdvertiserImpl::EncodeAdvData(uint8_t advHandle, const BleAdvertiserDataImpl &data,
+    const BleAdvertiserSettingsImpl &settings, int8_t txPowerLevel, bool isScanRsp, const std::string *&payload) const
 {
     LOG_DEBUG("[BleAdvertiserImpl] %{public}s", __func__);
 
-    BleAdvertiserDataImpl data = static_cast<BleAdvertiserDataImpl>(advData);
-
-    int ret = CheckAdvertiserFlag(data.GetPayload());
-    if (ret != BT_NO_ERROR) {
-        return ret;
-    }
+    BleAdvertiserEncodedSet &encodedSet = pimpl->encodedDatas_[advHandle];
+    BleAdvertiserEncodedData &encoded = isScanRsp ? encodedSet.rsp_ : encodedSet.adv_;
+    payload = &encoded.payload_;
 
+    bool isExAdv = BleFeature::GetInstance().IsLeExtendedAdvertisingSupported();
+    const std::string &source = data.GetPayload();
     // bluetooth localname
     std::string name = BleProperties::GetInstance().GetLocalName();
     size_t maxDataLen = GetMaxAdvertisingDataLength(settings);
-    if ((!data.GetPayload().empty()) && (!name.empty()) &&
-        (data.GetPayload().size() + name.size() + BLE_ADV_DATA_FIELD_TYPE_AND_LEN <= maxDataLen)) {
-        data.SetDeviceName(name);
-    }
-    // adv txpower
-    if ((!data.GetPayload().empty()) && (data.GetPayload().size() + BLE_ADV_DATA_BYTE_FIELD_LEN <= maxDataLen)) {
-        data.SetTxPowerLevel(txPowerLevel);
+    /// Scan responses carry no tx power, and connectable extended sets put the name in the advertising data.
+    int8_t txPower = isScanRsp ? 0 : txPowerLevel;
+    bool withName = (!name.empty()) && ((!isScanRsp) || (!isExAdv) || (!settings.IsConnectable()));
+    if (encoded.IsValid(source, name, txPower, maxDataLen, withName)) {
+        return encoded.status_;
+    }
+
+    encoded.valid_ = true;
+    encoded.source_ = source;
+    encoded.name_ = name;
+    encoded.txPower_ = txPower;
+    encoded.maxLen_ = maxDataLen;
+    encoded.withName_ = withName;
+    encoded.status_ = BT_NO_ERROR;
+    if ((!isScanRsp) && (!isExAdv)) {
+        encoded.status_ = CheckAdvertiserFlag(source);
+        if (encoded.status_ != BT_NO_ERROR) {
+            return encoded.status_;
+        }
     }
 
-    if (!data.GetPayload().empty()) {
-        std::vector<uint8_t> legacyDatas;
-        for (size_t i = 0; i < data.GetPayload().size(); i++) {
-            legacyDatas.push_back(data.GetPayload()[i]);
+    BleAdvertiserDataImpl encodedData = data;
+    if (isScanRsp) {
+        if (withName && (source.size() + name.size() + BLE_ADV_DATA_FIELD_TYPE_AND_LEN <= maxDataLen)) {
+            encodedData.SetDeviceName(name);
+        }
+    } else {
+        if ((!source.empty()) && withName &&
+            (source.size() + name.size() + BLE_ADV_DATA_FIELD_TYPE_AND_LEN <= maxDataLen)) {
+            encodedData.SetDeviceName(name);
         }
-        LOG_INFO("[BleAdvertiserImpl] %{public}s: Advertising Data Data=%{public}s %{public}d",
+        // adv txpower
+        if ((!encodedData.GetPayload().empty()) &&
+            (encodedData.GetPayload().size() + BLE_ADV_DATA_BYTE_FIELD_LEN <= maxDataLen)) {
+            encodedData.SetTxPowerLevel(txPowerLevel);
+        }
+    }
+
+    if (encoded.payload_ != encodedData.GetPayload()) {
+        encoded.payload_ = encodedData.GetPayload();
+        encoded.generation_++;
+    }
+    if (!encoded.payload_.empty()) {
+        std::vector<uint8_t> datas(encoded.payload_.begin(), encoded.payload_.end());
+        LOG_INFO("[BleAdvertiserImpl] %{public}s: %{public}s Data=%{public}s %{public}zu",
             __func__,
-            BleUtils::ConvertIntToHexString(legacyDatas).c_str(),
-            data.GetPayload().size());
+            isScanRsp ? "Scan Response" : "Advertising",
+            BleUtils::ConvertIntToHexString(datas).c_str(),
+            encoded.payload_.size());
     }
-    return GAPIF_LeAdvSetData(data.GetPayload().size(), (uint8_t *)data.GetPayload().c_str());
+    return BT_NO_ERROR;
 }
 
-int BleAdvertiserImpl::ExAdvDataFragment(const BleAdvertiserDataImpl &data) const
+int BleAdvertiserImpl::SetAdvDataToGap(
+    const BleAdvertiserDataImpl &advData, const BleAdvertiserSettingsImpl &settings, int8_t txPowerLevel) const
 {
-    pimpl->operationLast_ = false;
-    uint8_t advStartHandle = pimpl->advStartHandle_;
-    size_t payloadLen = data.GetPayload().size();
-    std::string payload = data.GetPayload();
-    uint8_t maxlen = BLE_EX_ADV_PAYLOAD_DATA_LEN;
-    uint8_t fragment = GAP_CONTROLLER_SHOULD_NOT_FRAGMENT;
-    int ret = BT_NO_ERROR;
-    if ((payloadLen / maxlen == 0) || ((payloadLen / maxlen == 1) && (payloadLen % maxlen == 0))) {
-        uint8_t operation = GAP_ADVERTISING_DATA_OPERATION_COMPLETE;
-        pimpl->operationLast_ = true;
-        return GAPIF_LeExAdvSetData(advStartHandle, operation, fragment, payloadLen, (uint8_t *)payload.c_str());
-    } else if (((payloadLen / maxlen == 1) && (payloadLen % maxlen > 0)) ||
-               ((payloadLen / maxlen == BLE_DIV_RESULT_TWO) && (payloadLen % maxlen == 0))) {
-        std::string advData = payload.substr(0, maxlen);
-        uint8_t operation = GAP_ADVERTISING_DATA_OPERATION_FIRST;
-        ret = GAPIF_LeExAdvSetData(advStartHandle, operation, fragment, maxlen, (uint8_t *)advData.c_str());
-        pimpl->operationLast_ = true;
-        operation = GAP_ADVERTISING_DATA_OPERATION_LAST;
-        uint8_t length = payloadLen - maxlen;
-        advData = payload.substr(maxlen, payloadLen - maxlen);
-        ret &= GAPIF_LeExAdvSetData(advStartHandle, operation, fragment, length, (uint8_t *)advData.c_str());
-    } else if (((payloadLen / maxlen == BLE_DIV_RESULT_TWO) && (payloadLen % maxlen > 0)) ||
-               payloadLen / maxlen > BLE_DIV_RESULT_TWO) {
-        uint8_t operation = GAP_ADVERTISING_DATA_OPERATION_FIRST;
-        std::string advData = payload.substr(0, maxlen);
-        ret = GAPIF_LeExAdvSetData(advStartHandle, operation, fragment, maxlen, (uint8_t *)advData.c_str());
-        operation = GAP_ADVERTISING_DATA_OPERATION_INTERMEDIATE;
-        for (size_t i = 0; i < (payloadLen / maxlen - 1); i++) {
-            if ((i == (payloadLen / maxlen - 1) - 1) && (payloadLen - maxlen * (payloadLen / maxlen) == 0)) {
-                operation = GAP_ADVERTISING_DATA_OPERATION_LAST;
-            }
-            uint8_t length = maxlen * (i + 1);
-            advData = payload.substr(maxlen * (i + 1), maxlen);
-            ret &= GAPIF_LeExAdvSetData(advStartHandle, operation, fragment, length, (uint8_t *)advData.c_str());
-        }
-        pimpl->operationLast_ = true;
-        if (payloadLen - maxlen * (payloadLen / maxlen) > 0) {
-            ret &= GAPIF_LeExAdvSetData(advStartHandle,
-                GAP_ADVERTISING_DATA_OPERATION_LAST,
-                fragment,
-                payloadLen - maxlen * (payloadLen / maxlen),
-                (uint8_t *)payload.substr(maxlen * (payloadLen / maxlen), payloadLen - maxlen * (payloadLen / maxlen))
-                    .c_str());
-        }
+    LOG_DEBUG("[BleAdvertiserImpl] %{public}s", __func__);
+
+    const std::string *payload = nullptr;
+    int ret = EncodeAdvData(pimpl->advStartHandle_, advData, settings, txPowerLevel, false, payload);
+    if (ret != BT_NO_ERROR) {
+        return ret;
     }
-    return ret;
+    return GAPIF_LeAdvSetData(payload->size(), reinterpret_cast<const uint8_t *>(payload->data()));
 }
 
-int BleAdvertiserImpl::ExResDataFragment(const BleAdvertiserDataImpl &data) const
+int BleAdvertiserImpl::SetExAdvPayloadToGap(
+    uint8_t advHandle, const std::string &payload, bool isScanRsp, size_t &fragments) const
 {
-    pimpl->operationLast_ = false;
-    size_t payloadLen = data.GetPayload().size();
-    std::string payload = data.GetPayload();
-    uint8_t fragmentPreference = GAP_CONTROLLER_SHOULD_NOT_FRAGMENT;
-    int ret = BT_NO_ERROR;
-    int maxlen = BLE_EX_ADV_PAYLOAD_DATA_LEN;
-    if ((payloadLen / maxlen == 0) || ((payloadLen / maxlen == 1) && (payloadLen % maxlen == 0))) {
-        uint8_t operation = GAP_ADVERTISING_DATA_OPERATION_COMPLETE;
-        pimpl->operationLast_ = true;
-
-        return GAPIF_LeExAdvSetScanRspData(
-            pimpl->advStartHandle_, operation, fragmentPreference, payloadLen, (uint8_t *)payload.c_str());
-    } else if (((payloadLen / maxlen == 1) && (payloadLen % maxlen > 0)) ||
-               ((payloadLen / maxlen == BLE_DIV_RESULT_TWO) && (payloadLen % maxlen == 0))) {
-        uint8_t operation = GAP_ADVERTISING_DATA_OPERATION_FIRST;
-        ret = GAPIF_LeExAdvSetScanRspData(
-            pimpl->advStartHandle_, operation, fragmentPreference, maxlen, (uint8_t *)payload.substr(maxlen).c_str());
-
-        pimpl->operationLast_ = true;
-        operation = GAP_ADVERTISING_DATA_OPERATION_LAST;
-        ret &= GAPIF_LeExAdvSetScanRspData(pimpl->advStartHandle_,
-            operation,
-            fragmentPreference,
-            payloadLen - maxlen,
-            (uint8_t *)payload.substr(maxlen, payloadLen - maxlen).c_str());
-    } else if (payloadLen / maxlen > 1) {
-        uint8_t operation = GAP_ADVERTISING_DATA_OPERATION_FIRST;
-        ret = GAPIF_LeExAdvSetScanRspData(
-            pimpl->advStartHandle_, operation, fragmentPreference, maxlen, (uint8_t *)payload.substr(maxlen).c_str());
-
-        operation = GAP_ADVERTISING_DATA_OPERATION_INTERMEDIATE;
-        for (size_t i = 0; i < (payloadLen / maxlen - 1); i++) {
-            ret &= GAPIF_LeExAdvSetScanRspData(pimpl->advStartHandle_,
-                operation,
-                fragmentPreference,
-                maxlen * (i + 1),
-                (uint8_t *)payload.substr(maxlen * (i + 1), maxlen).c_str());
-        }
-        pimpl->operationLast_ = true;
-        operation = GAP_ADVERTISING_DATA_OPERATION_LAST;
-        ret &= GAPIF_LeExAdvSetScanRspData(pimpl->advStartHandle_,
-            operation,
-            fragmentPreference,
-            data.GetPayload().size() - maxlen * (payloadLen / maxlen),
-            (uint8_t *)payload.substr(maxlen * (payloadLen / maxlen), payloadLen - maxlen * (payloadLen / maxlen))
-                .c_str());
-    }
-    return ret;
+    LOG_DEBUG("[BleAdvertiserImpl] %{public}s", __func__);
+
+    fragments = 0;
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(payload.data());
+    size_t payloadLen = payload.size();
+    size_t offset = 0;
+    /// An empty payload is still written once to clear the previous one.
+    do {
+        size_t length = std::min(payloadLen - offset, static_cast<size_t>(BLE_EX_ADV_PAYLOAD_DATA_LEN));
+        bool isFirst = (offset == 0);
+        bool isLast = (offset + length == payloadLen);
+        uint8_t operation = GAP_ADVERTISING_DATA_OPERATION_INTERMEDIATE;
+        if (isFirst && isLast) {
+            operation = GAP_ADVERTISING_DATA_OPERATION_COMPLETE;
+        } else if (isFirst) {
+            operation = GAP_ADVERTISING_DATA_OPERATION_FIRST;
+        } else if (isLast) {
+            operation = GAP_ADVERTISING_DATA_OPERATION_LAST;
+        }
+
+        int ret;
+        if (isScanRsp) {
+            ret = GAPIF_LeExAdvSetScanRspData(
+                advHandle, operation, GAP_CONTROLLER_SHOULD_NOT_FRAGMENT, length, data + offset);
+        } else {
+            ret = GAPIF_LeExAdvSetData(advHandle, operation, GAP_CONTROLLER_SHOULD_NOT_FRAGMENT, length, data + offset);
+        }
+        if (ret != BT_NO_ERROR) {
+            LOG_ERROR("[BleAdvertiserImpl] %{public}s:Set fragment %{public}zu failed! %{public}d",
+                __func__, fragments, ret);
+            return ret;
+        }
+        fragments++;
+        offset += length;
+    } while (offset < payloadLen);
+    return BT_NO_ERROR;
 }
 
 int BleAdvertiserImpl::SetExAdvDataToGap(
@@ -967,30 +1027,13 @@ int BleAdvertiserImpl::SetExAdvDataToGap(
 {
     LOG_DEBUG("[BleAdvertiserImpl] %{public}s", __func__);
 
-    BleAdvertiserDataImpl data = static_cast<BleAdvertiserDataImpl>(advData);
-    // bluetooth localname
-    std::string name = BleProperties::GetInstance().GetLocalName();
-    size_t maxData = GetMaxAdvertisingDataLength(settings);
-    if ((!data.GetPayload().empty()) && (!name.empty()) && (data.GetPayload().size() + name.size() <= maxData)) {
-        data.SetDeviceName(name);
-    }
-    // adv txpower
-    if ((!data.GetPayload().empty()) && (data.GetPayload().size() + BLE_ADV_DATA_BYTE_FIELD_LEN <= maxData)) {
-        data.SetTxPowerLevel(txPowerLevel);
-    }
-
-    if (!data.GetPayload().empty()) {
-        std::vector<uint8_t> exAdvDatas;
-        for (size_t i = 0; i < data.GetPayload().size(); i++) {
-            exAdvDatas.push_back(data.GetPayload()[i]);
-        }
-        LOG_INFO("[BleAdvertiserImpl] %{public}s: Advertising Data Data=%{public}s %{public}d",
-            __func__,
-            BleUtils::ConvertIntToHexString(exAdvDatas).c_str(),
-            data.GetPayload().size());
+    const std::string *payload = nullptr;
+    int ret = EncodeAdvData(pimpl->advStartHandle_, advData, settings, txPowerLevel, false, payload);
+    if (ret != BT_NO_ERROR) {
+        return ret;
     }
     // fragment data
-    return ExAdvDataFragment(data);
+    return SetExAdvPayloadToGap(pimpl->advStartHandle_, *payload, false, pimpl->pendingFragments_);
 }
 
 int BleAdvertiserImpl::SetAdvScanRspDataToGap(
@@ -998,27 +1041,12 @@ int BleAdvertiserImpl::SetAdvScanRspDataToGap(
 {
     LOG_DEBUG("[BleAdvertiserImpl] %{public}s", __func__);
 
-    BleAdvertiserDataImpl legacyScandata = static_cast<BleAdvertiserDataImpl>(scanResponse);
-    // bluetooth localname
-    std::string name = BleProperties::GetInstance().GetLocalName();
-    size_t maxDataLen = GetMaxAdvertisingDataLength(settings);
-    if ((!name.empty()) &&
-        (legacyScandata.GetPayload().size() + name.size() + BLE_ADV_DATA_FIELD_TYPE_AND_LEN <= maxDataLen)) {
-        legacyScandata.SetDeviceName(name);
-    }
-
-    if (!legacyScandata.GetPayload().empty()) {
-        std::vector<uint8_t> legacyDatas;
-        for (size_t i = 0; i < legacyScandata.GetPayload().size(); i++) {
-            legacyDatas.push_back(legacyScandata.GetPayload()[i]);
-        }
-        LOG_INFO("[BleAdvertiserImpl] %{public}s: Advertising Data Data=%{public}s %{public}d",
-            __func__,
-            BleUtils::ConvertIntToHexString(legacyDatas).c_str(),
-            legacyScandata.GetPayload().size());
+    const std::string *payload = nullptr;
+    int ret = EncodeAdvData(pimpl->advStartHandle_, scanResponse, settings, txPowerLevel, true, payload);
+    if (ret != BT_NO_ERROR) {
+        return ret;
     }
-    return GAPIF_LeAdvSetScanRspData(
-        legacyScandata.GetPayload().size(), (uint8_t *)legacyScandata.GetPayload().c_str());
+    return GAPIF_LeAdvSetScanRspData(payload->size(), reinterpret_cast<const uint8_t *>(payload->data()));
 }
 
 int BleAdvertiserImpl::SetExAdvScanRspDataToGap(
@@ -1026,32 +1054,17 @@ int BleAdvertiserImpl::SetExAdvScanRspDataToGap(
 {
     LOG_DEBUG("[BleAdvertiserImpl] %{public}s", __func__);
 
-    BleAdvertiserDataImpl exAdvScandata = static_cast<BleAdvertiserDataImpl>(scanResponse);
-    auto iter = pimpl->advHandleSettingDatas_.find(pimpl->advStartHandle_);
-    if (iter == pimpl->advHandleSettingDatas_.end()) {
+    if (pimpl->advHandleSettingDatas_.find(pimpl->advStartHandle_) == pimpl->advHandleSettingDatas_.end()) {
         LOG_ERROR("[BleAdvertiserImpl] %{public}s:invalid handle! %u.", __func__, pimpl->advStartHandle_);
         return BT_BAD_PARAM;
     }
-    // bluetooth localname
-    std::string name = BleProperties::GetInstance().GetLocalName();
-    size_t maxData = GetMaxAdvertisingDataLength(settings);
-    if ((!iter->second.settings_.IsConnectable()) && (!name.empty()) &&
-        (exAdvScandata.GetPayload().size() + name.size() + BLE_ADV_DATA_FIELD_TYPE_AND_LEN <= maxData)) {
-        exAdvScandata.SetDeviceName(name);
-    }
-
-    if (!exAdvScandata.GetPayload().empty()) {
-        std::vector<uint8_t> exAdvDatas;
-        for (size_t i = 0; i < exAdvScandata.GetPayload().size(); i++) {
-            exAdvDatas.push_back(exAdvScandata.GetPayload()[i]);
-        }
-        LOG_INFO("[BleAdvertiserImpl] %{public}s: Advertising Data Data=%{public}s %{public}d",
-            __func__,
-            BleUtils::ConvertIntToHexString(exAdvDatas).c_str(),
-            exAdvScandata.GetPayload().size());
+    const std::string *payload = nullptr;
+    int ret = EncodeAdvData(pimpl->advStartHandle_, scanResponse, settings, txPowerLevel, true, payload);
+    if (ret != BT_NO_ERROR) {
+        return ret;
     }
     // fragment data
-    return ExResDataFragment(exAdvScandata);
+    return SetExAdvPayloadToGap(pimpl->advStartHandle_, *payload, true, pimpl->pendingFragments_);
 }
 
 int BleAdvertiserImpl::SetAdvEnableToGap(bool isEnable) const
@@ -1075,20 +1088,340 @@ int BleAdvertiserImpl::SetExAdvEnableToGap(uint8_t advHandle, bool isEnable) con
 int BleAdvertiserImpl::SetExAdvBatchEnableToGap(bool isEnable) const
 {
     LOG_DEBUG("[BleAdvertiserImpl] %{public}s", __func__);
-    std::vector<GapExAdvSet> advSets;
+    std::vector<uint8_t> advHandles;
     auto iter = pimpl->advHandleSettingDatas_.begin();
     for (; iter != pimpl->advHandleSettingDatas_.end(); iter++) {
         if (iter->second.timer_ != nullptr) {
             iter->second.timer_->Stop();
         }
+        advHandles.push_back(iter->first);
+    }
+    return SetExAdvBatchEnableToGap(isEnable, advHandles);
+}
 
+int BleAdvertiserImpl::SetExAdvBatchEnableToGap(bool isEnable, const std::vector<uint8_t> &advHandles) const
+{
+    LOG_DEBUG("[BleAdvertiserImpl] %{public}s", __func__);
+    std::vector<GapExAdvSet> advSets;
+    for (auto advHandle : advHandles) {
         GapExAdvSet exAdvSets;
-        exAdvSets.advHandle = iter->first;
+        exAdvSets.advHandle = advHandle;
         exAdvSets.duration = 0;
         exAdvSets.maxExAdvEvt = 0;
         advSets.push_back(exAdvSets);
     }
-    return GAPIF_LeExAdvSetEnable(isEnable, advSets.size(), &advSets[0]);
+    return GAPIF_LeExAdvSetEnable(isEnable, advSets.size(), advSets.data());
+}
+
+bool BleAdvertiserImpl::IsExAdvBusy() const
+{
+    return pimpl->isExAdvStarting_ || pimpl->isExAdvStopping_ ||
+           (pimpl->rotateHandle_ != BLE_INVALID_ADVERTISING_HANDLE) || (!pimpl->updateEvents_.empty());
+}
+
+bool BleAdvertiserImpl::IsSameAdvParam(const BleAdvertiserSettingsImpl &lhs, const BleAdvertiserSettingsImpl &rhs)
+{
+    return (lhs.IsConnectable() == rhs.IsConnectable()) && (lhs.IsLegacyMode() == rhs.IsLegacyMode()) &&
+           (lhs.GetInterval() == rhs.GetInterval()) && (lhs.GetTxPower() == rhs.GetTxPower()) &&
+           (lhs.GetPrimaryPhy() == rhs.GetPrimaryPhy()) && (lhs.GetSecondaryPhy() == rhs.GetSecondaryPhy());
+}
+
+void BleAdvertiserImpl::QueueAdvertisingUpdate(const BleAdvertiserSettingsImpl &settings,
+    const BleAdvertiserDataImpl &advData, const BleAdvertiserDataImpl &scanResponse, uint8_t advHandle)
+{
+    LOG_DEBUG("[BleAdvertiserImpl] %{public}s:handle = %u.", __func__, advHandle);
+
+    /// A later restart of the same set replaces the queued one.
+    BleAdvertiserUpdateData &update = pimpl->pendingUpdates_[advHandle];
+    update.settings_ = settings;
+    update.advData_ = advData;
+    update.rspData_ = scanResponse;
+    ScheduleAdvertisingUpdates();
+}
+
+void BleAdvertiserImpl::ScheduleAdvertisingUpdates()
+{
+    bool isPending =
+        (!pimpl->pendingUpdates_.empty()) || (!pimpl->pendingStops_.empty()) || (!pimpl->pendingRotations_.empty());
+    if (pimpl->isUpdateScheduled_ || (!isPending) || IsExAdvBusy()) {
+        return;
+    }
+    pimpl->isUpdateScheduled_ = true;
+    dispatcher_->PostTask(std::bind(&BleAdvertiserImpl::FlushAdvertisingUpdates, this));
+}
+
+void BleAdvertiserImpl::FlushAdvertisingUpdates()
+{
+    LOG_DEBUG("[BleAdvertiserImpl] %{public}s", __func__);
+
+    std::lock_guard<std::recursive_mutex> lk(pimpl->mutex_);
+    pimpl->isUpdateScheduled_ = false;
+    if (IsExAdvBusy()) {
+        /// Rescheduled once the running sequence completes
+        return;
+    }
+
+    /// Stops go first, then address rotations, each one a sequence of its own.
+    while (!pimpl->pendingStops_.empty()) {
+        uint8_t advHandle = *pimpl->pendingStops_.begin();
+        pimpl->pendingStops_.erase(pimpl->pendingStops_.begin());
+        StopAdvertising(advHandle);
+        if (IsExAdvBusy()) {
+            return;
+        }
+    }
+    while (!pimpl->pendingRotations_.empty()) {
+        uint8_t advHandle = *pimpl->pendingRotations_.begin();
+        pimpl->pendingRotations_.erase(pimpl->pendingRotations_.begin());
+        RotateAddress(advHandle);
+        if (IsExAdvBusy()) {
+            return;
+        }
+    }
+
+    /// Sets that are not running go through the regular start sequence, one at a time.
+    for (auto iter = pimpl->pendingUpdates_.begin(); iter != pimpl->pendingUpdates_.end(); ++iter) {
+        auto setIter = pimpl->advHandleSettingDatas_.find(iter->first);
+        if ((setIter == pimpl->advHandleSettingDatas_.end()) ||
+            (setIter->second.advStatus_ != ADVERTISE_FAILED_ALREADY_STARTED)) {
+            uint8_t advHandle = iter->first;
+            BleAdvertiserUpdateData update = std::move(iter->second);
+            pimpl->pendingUpdates_.erase(iter);
+            StartAdvertising(update.settings_, update.advData_, update.rspData_, advHandle);
+            ScheduleAdvertisingUpdates();
+            return;
+        }
+    }
+
+    std::map<uint8_t, BleAdvertiserUpdateData> updates;
+    updates.swap(pimpl->pendingUpdates_);
+    UpdateAdvertisingSets(updates);
+}
+
+void BleAdvertiserImpl::UpdateAdvertisingSets(std::map<uint8_t, BleAdvertiserUpdateData> &updates)
+{
+    LOG_DEBUG("[BleAdvertiserImpl] %{public}s:sets = %{public}zu", __func__, updates.size());
+
+    struct UpdatePlan {
+        uint8_t advHandle_ = BLE_INVALID_ADVERTISING_HANDLE;
+        const std::string *advPayload_ = nullptr;
+        const std::string *rspPayload_ = nullptr;
+    };
+    std::vector<UpdatePlan> plans;
+    std::vector<uint8_t> paramHandles;
+    std::vector<uint8_t> restartHandles;
+    for (auto &update : updates) {
+        auto iter = pimpl->advHandleSettingDatas_.find(update.first);
+        uint8_t advHandle = update.first;
+        pimpl->updateResults_[advHandle] = BT_NO_ERROR;
+        pimpl->updateDatas_[advHandle] = std::move(update.second);
+        /// The payloads of a set with new parameters carry the tx power the controller selects for them, so they
+        /// are written once the parameters completed.
+        const BleAdvertiserSettingsImpl &settings = pimpl->updateDatas_[advHandle].settings_;
+        if (!IsSameAdvParam(iter->second.settings_, settings)) {
+            paramHandles.push_back(advHandle);
+            restartHandles.push_back(advHandle);
+            continue;
+        }
+
+        const BleAdvertiserEncodedSet &encodedSet = pimpl->encodedDatas_[advHandle];
+        int8_t txPower = encodedSet.hasSelectedTxPower_ ? encodedSet.selectedTxPower_ : settings.GetTxPower();
+        UpdatePlan plan;
+        plan.advHandle_ = advHandle;
+        int ret = EncodeAdvertisingUpdate(advHandle, txPower, plan.advPayload_, plan.rspPayload_);
+        if (ret != BT_NO_ERROR) {
+            pimpl->updateResults_[advHandle] = ret;
+            continue;
+        }
+        /// Fragmented payloads can only be written while the set is disabled.
+        if (((plan.advPayload_ != nullptr) && (plan.advPayload_->size() > BLE_EX_ADV_PAYLOAD_DATA_LEN)) ||
+            ((plan.rspPayload_ != nullptr) && (plan.rspPayload_->size() > BLE_EX_ADV_PAYLOAD_DATA_LEN))) {
+            restartHandles.push_back(advHandle);
+        }
+        plans.push_back(plan);
+    }
+
+    if (!restartHandles.empty()) {
+        int ret = SetExAdvBatchEnableToGap(false, restartHandles);
+        if (ret != BT_NO_ERROR) {
+            LOG_ERROR("[BleAdvertiserImpl] %{public}s:Disable advertising sets failed! %{public}d", __func__, ret);
+            for (auto advHandle : restartHandles) {
+                pimpl->updateResults_[advHandle] = ret;
+            }
+        } else {
+            pimpl->updateEvents_.push_back(BLE_INVALID_ADVERTISING_HANDLE);
+            pimpl->updateRestartHandles_ = restartHandles;
+        }
+    }
+
+    for (auto advHandle : paramHandles) {
+        if (pimpl->updateResults_[advHandle] != BT_NO_ERROR) {
+            continue;
+        }
+        int ret = SetExAdvParamToGap(advHandle, pimpl->updateDatas_[advHandle].settings_);
+        if (ret != BT_NO_ERROR) {
+            pimpl->updateResults_[advHandle] = ret;
+        } else {
+            pimpl->updateEvents_.push_back(advHandle);
+        }
+    }
+
+    for (auto &plan : plans) {
+        if (pimpl->updateResults_[plan.advHandle_] != BT_NO_ERROR) {
+            continue;
+        }
+        int ret = SendAdvertisingUpdate(plan.advHandle_, plan.advPayload_, plan.rspPayload_);
+        if (ret != BT_NO_ERROR) {
+            pimpl->updateResults_[plan.advHandle_] = ret;
+        }
+    }
+
+    if (pimpl->updateEvents_.empty()) {
+        RestartAdvertisingUpdateSets();
+    }
+}
+
+int BleAdvertiserImpl::EncodeAdvertisingUpdate(
+    uint8_t advHandle, int8_t txPower, const std::string *&advPayload, const std::string *&rspPayload)
+{
+    advPayload = nullptr;
+    rspPayload = nullptr;
+    auto iter = pimpl->advHandleSettingDatas_.find(advHandle);
+    auto dataIter = pimpl->updateDatas_.find(advHandle);
+    if ((iter == pimpl->advHandleSettingDatas_.end()) || (dataIter == pimpl->updateDatas_.end())) {
+        return BT_BAD_PARAM;
+    }
+    const BleAdvertiserSettingsImpl &settings = dataIter->second.settings_;
+    /// A new mode changes which payloads the set carries, so both are rewritten.
+    bool isModeChanged = (iter->second.settings_.IsConnectable() != settings.IsConnectable()) ||
+                         (iter->second.settings_.IsLegacyMode() != settings.IsLegacyMode());
+
+    BleAdvertiserEncodedSet &encodedSet = pimpl->encodedDatas_[advHandle];
+    if (settings.IsConnectable() || settings.IsLegacyMode()) {
+        uint32_t generation = encodedSet.adv_.generation_;
+        int ret = EncodeAdvData(advHandle, dataIter->second.advData_, settings, txPower, false, advPayload);
+        if (ret != BT_NO_ERROR) {
+            return ret;
+        }
+        if ((!isModeChanged) && (generation == encodedSet.adv_.generation_)) {
+            advPayload = nullptr;
+        }
+    }
+    if ((!settings.IsConnectable()) || settings.IsLegacyMode()) {
+        uint32_t generation = encodedSet.rsp_.generation_;
+        int ret = EncodeAdvData(advHandle, dataIter->second.rspData_, settings, txPower, true, rspPayload);
+        if (ret != BT_NO_ERROR) {
+            return ret;
+        }
+        if ((!isModeChanged) && (generation == encodedSet.rsp_.generation_)) {
+            rspPayload = nullptr;
+        }
+    }
+    return BT_NO_ERROR;
+}
+
+int BleAdvertiserImpl::SendAdvertisingUpdate(
+    uint8_t advHandle, const std::string *advPayload, const std::string *rspPayload)
+{
+    int ret = BT_NO_ERROR;
+    size_t fragments = 0;
+    if (advPayload != nullptr) {
+        ret = SetExAdvPayloadToGap(advHandle, *advPayload, false, fragments);
+        pimpl->updateEvents_.insert(pimpl->updateEvents_.end(), fragments, advHandle);
+    }
+    if ((ret == BT_NO_ERROR) && (rspPayload != nullptr)) {
+        ret = SetExAdvPayloadToGap(advHandle, *rspPayload, true, fragments);
+        pimpl->updateEvents_.insert(pimpl->updateEvents_.end(), fragments, advHandle);
+    }
+    return ret;
+}
+
+void BleAdvertiserImpl::RestartAdvertisingUpdateSets()
+{
+    LOG_DEBUG("[BleAdvertiserImpl] %{public}s", __func__);
+
+    std::vector<uint8_t> enableHandles;
+    for (auto advHandle : pimpl->updateRestartHandles_) {
+        if (pimpl->updateResults_[advHandle] == BT_NO_ERROR) {
+            enableHandles.push_back(advHandle);
+        }
+    }
+    pimpl->updateRestartHandles_.clear();
+    if (!enableHandles.empty()) {
+        int ret = SetExAdvBatchEnableToGap(true, enableHandles);
+        if (ret == BT_NO_ERROR) {
+            pimpl->updateEvents_.push_back(BLE_INVALID_ADVERTISING_HANDLE);
+            return;
+        }
+        LOG_ERROR("[BleAdvertiserImpl] %{public}s:Enable advertising sets failed! %{public}d", __func__, ret);
+        for (auto advHandle : enableHandles) {
+            pimpl->updateResults_[advHandle] = ret;
+        }
+    }
+    AdvertisingUpdateComplete();
+}
+
+void BleAdvertiserImpl::AdvertisingUpdateResult(int status, bool isParamSet, int8_t txPower)
+{
+    LOG_DEBUG("[BleAdvertiserImpl] %{public}s", __func__);
+
+    std::lock_guard<std::recursive_mutex> lk(pimpl->mutex_);
+    uint8_t advHandle = pimpl->updateEvents_.front();
+    pimpl->updateEvents_.pop_front();
+    if (status != BT_NO_ERROR) {
+        LOG_ERROR("[BleAdvertiserImpl] %{public}s:handle = %u, status = %{public}d", __func__, advHandle, status);
+        for (auto &result : pimpl->updateResults_) {
+            bool isTarget = (advHandle == BLE_INVALID_ADVERTISING_HANDLE) || (result.first == advHandle);
+            if (isTarget && (result.second == BT_NO_ERROR)) {
+                result.second = status;
+            }
+        }
+    } else if (isParamSet && (pimpl->updateResults_[advHandle] == BT_NO_ERROR)) {
+        BleAdvertiserEncodedSet &encodedSet = pimpl->encodedDatas_[advHandle];
+        encodedSet.hasSelectedTxPower_ = true;
+        encodedSet.selectedTxPower_ = txPower;
+        const std::string *advPayload = nullptr;
+        const std::string *rspPayload = nullptr;
+        int ret = EncodeAdvertisingUpdate(advHandle, txPower, advPayload, rspPayload);
+        if (ret == BT_NO_ERROR) {
+            ret = SendAdvertisingUpdate(advHandle, advPayload, rspPayload);
+        }
+        if (ret != BT_NO_ERROR) {
+            pimpl->updateResults_[advHandle] = ret;
+        }
+    }
+    if (pimpl->updateEvents_.empty()) {
+        RestartAdvertisingUpdateSets();
+    }
+}
+
+void BleAdvertiserImpl::AdvertisingUpdateComplete()
+{
+    LOG_DEBUG("[BleAdvertiserImpl] %{public}s", __func__);
+
+    std::map<uint8_t, int> results;
+    results.swap(pimpl->updateResults_);
+    std::map<uint8_t, BleAdvertiserUpdateData> datas;
+    datas.swap(pimpl->updateDatas_);
+    for (auto &result : results) {
+        auto iter = pimpl->advHandleSettingDatas_.find(result.first);
+        if (result.second == BT_NO_ERROR) {
+            auto dataIter = datas.find(result.first);
+            if ((iter != pimpl->advHandleSettingDatas_.end()) && (dataIter != datas.end())) {
+                iter->second.settings_ = dataIter->second.settings_;
+                iter->second.advData_ = dataIter->second.advData_;
+                iter->second.rspData_ = dataIter->second.rspData_;
+            }
+            callback_->OnStartResultEvent(BT_NO_ERROR, result.first);
+            continue;
+        }
+        if (iter != pimpl->advHandleSettingDatas_.end()) {
+            iter->second.advStatus_ = ADVERTISE_FAILED_INTERNAL_ERROR;
+        }
+        callback_->OnStartResultEvent(result.second, result.first, BLE_ADV_START_FAILED_OP_CODE);
+        RemoveAdvHandle(result.first);
+    }
+    ScheduleAdvertisingUpdates();
 }
 
 void BleAdvertiserImpl::SetMinInterval(uint16_t mininterval) const
@@ -1171,6 +1504,18 @@ void BleAdvertiserImpl::RemoveAdvHandle(uint8_t handle) const
             pimpl->advCreateHandles_.end());
     }
 
+    if (handle == pimpl->advStartHandle_) {
+        pimpl->isExAdvStarting_ = false;
+        pimpl->pendingFragments_ = 0;
+    }
+    if (handle == pimpl->rotateHandle_) {
+        pimpl->rotateHandle_ = BLE_INVALID_ADVERTISING_HANDLE;
+        pimpl->isRotateDisabled_ = false;
+    }
+    pimpl->encodedDatas_.erase(handle);
+    pimpl->pendingStops_.erase(handle);
+    pimpl->pendingRotations_.erase(handle);
+
     auto iter = pimpl->advHandleSettingDatas_.begin();
     while (iter != pimpl->advHandleSettingDatas_.end()) {
         if (iter->first == handle) {
@@ -1189,6 +1534,19 @@ void BleAdvertiserImpl::RemoveAllAdvHandle(int status) const
 {
     LOG_DEBUG("[BleAdvertiserImpl] %{public}s", __func__);
     pimpl->advCreateHandles_.clear();
+    pimpl->isExAdvStarting_ = false;
+    pimpl->pendingFragments_ = 0;
+    pimpl->encodedDatas_.clear();
+    pimpl->pendingUpdates_.clear();
+    pimpl->updateEvents_.clear();
+    pimpl->updateResults_.clear();
+    pimpl->updateDatas_.clear();
+    pimpl->updateRestartHandles_.clear();
+    pimpl->pendingStops_.clear();
+    pimpl->pendingRotations_.clear();
+    pimpl->isExAdvStopping_ = false;
+    pimpl->rotateHandle_ = BLE_INVALID_ADVERTISING_HANDLE;
+    pimpl->isRotateDisabled_ = false;
     for (auto iter = pimpl->advHandleSettingDatas_.begin(); iter != pimpl->advHandleSettingDatas_.end(); iter++) {
         if (iter->second.timer_ != nullptr) {
             iter->second.timer_->Stop();
@@ -1444,7 +1802,8 @@ void BleAdvertiserImpl::GapExAdvSetRandAddrResultEvt(int status) const
         return;
     }
     std::lock_guard<std::recursive_mutex> lk(pimpl->mutex_);
-    if (pimpl->isStopAdv_) {
+    /// Stops are held back while an address rotation is in flight, so the rotated set is always enabled again.
+    if (pimpl->isStopAdv_ && (pimpl->rotateHandle_ == BLE_INVALID_ADVERTISING_HANDLE)) {
         return;
     }
     int ret = SetExAdvEnableToGap(pimpl->advStartHandle_, true);
@@ -1473,6 +1832,9 @@ void BleAdvertiserImpl::GapExAdvParamSetCompleteEvt(int status, int8_t txPower)
         RemoveAdvHandle(pimpl->advStartHandle_);
         return;
     }
+    BleAdvertiserEncodedSet &encodedSet = pimpl->encodedDatas_[pimpl->advStartHandle_];
+    encodedSet.hasSelectedTxPower_ = true;
+    encodedSet.selectedTxPower_ = txPower;
     if ((iter->second.settings_.IsConnectable()) || (iter->second.settings_.IsLegacyMode())) {
         int ret = SetExAdvDataToGap(iter->second.advData_, iter->second.settings_, txPower);
         if (ret != BT_NO_ERROR) {
@@ -1509,6 +1871,10 @@ void BleAdvertiserImpl::GapExAdvDataSetCompleteEvt(int status, int8_t txPower)
         RemoveAdvHandle(pimpl->advStartHandle_);
         return;
     }
+    /// Wait for the last fragment
+    if ((pimpl->pendingFragments_ > 0) && (--pimpl->pendingFragments_ > 0)) {
+        return;
+    }
 
     if (exAdvDataIter->second.settings_.IsLegacyMode()) {
         int ret = SetExAdvScanRspDataToGap(exAdvDataIter->second.rspData_, exAdvDataIter->second.settings_, txPower);
@@ -1520,13 +1886,16 @@ void BleAdvertiserImpl::GapExAdvDataSetCompleteEvt(int status, int8_t txPower)
         }
     } else {
         /// Generate rpa address
-        if ((BleConfig::GetInstance().GetBleAddrType() == BLE_ADDR_TYPE_RPA) && (pimpl->operationLast_)) {
+        if (BleConfig::GetInstance().GetBleAddrType() == BLE_ADDR_TYPE_RPA) {
             std::unique_lock<std::mutex> exAdvDataLock(pimpl->rpamutex_);
             int ret = GAPIF_LeGenResPriAddr(&BleAdvertiserImpl::GenResPriAddrResult, this);
             if (ret != BT_NO_ERROR) {
                 LOG_ERROR("[BleAdvertiserImpl] %{public}s:GAP_LeGenResPriAddrAsync failed!", __func__);
+                exAdvDataIter->second.advStatus_ = ADVERTISE_FAILED_INTERNAL_ERROR;
+                callback_->OnStartResultEvent(ret, pimpl->advStartHandle_, BLE_ADV_START_FAILED_OP_CODE);
+                RemoveAdvHandle(pimpl->advStartHandle_);
             }
-        } else if (pimpl->operationLast_) {
+        } else {
             int ret = SetExAdvEnableToGap(pimpl->advStartHandle_, true);
             if (ret != BT_NO_ERROR) {
                 LOG_ERROR("Start ex advertising failed!");
@@ -1555,14 +1924,21 @@ void BleAdvertiserImpl::GapExAdvScanRspDataSetCompleteEvt(int status)
         RemoveAdvHandle(pimpl->advStartHandle_);
         return;
     }
-    if ((BleConfig::GetInstance().GetBleAddrType() == BLE_ADDR_TYPE_RPA) && (pimpl->operationLast_)) {
+    /// Wait for the last fragment
+    if ((pimpl->pendingFragments_ > 0) && (--pimpl->pendingFragments_ > 0)) {
+        return;
+    }
+    if (BleConfig::GetInstance().GetBleAddrType() == BLE_ADDR_TYPE_RPA) {
         /// Generate rpa address
         std::unique_lock<std::mutex> exAdvScanResLock(pimpl->rpamutex_);
         int ret = GAPIF_LeGenResPriAddr(&BleAdvertiserImpl::GenResPriAddrResult, this);
         if (ret != BT_NO_ERROR) {
             LOG_ERROR("[BleAdvertiserImpl] %{public}s:GAP_LeGenResPriAddrAsync failed!", __func__);
+            exAdvScanDataIter->second.advStatus_ = ADVERTISE_FAILED_INTERNAL_ERROR;
+            callback_->OnStartResultEvent(ret, pimpl->advStartHandle_, BLE_ADV_START_FAILED_OP_CODE);
+            RemoveAdvHandle(pimpl->advStartHandle_);
         }
-    } else if (pimpl->operationLast_) {
+    } else {
         int ret = SetExAdvEnableToGap(pimpl->advStartHandle_, true);
         if (ret != BT_NO_ERROR) {
             LOG_ERROR("Start ex advertising failed!");
@@ -1590,6 +1966,7 @@ void BleAdvertiserImpl::GapExAdvStartCompleteEvt(int status)
         RemoveAdvHandle(pimpl->advStartHandle_);
         return;
     }
+    pimpl->isExAdvStarting_ = false;
 
     callback_->OnStartResultEvent(status, pimpl->advStartHandle_);
     if (BleConfig::GetInstance().GetBleAddrType() == BLE_ADDR_TYPE_RPA) {
@@ -1742,6 +2119,14 @@ void BleAdvertiserImpl::HandleGapExAdvEvent(const BLE_GAP_CB_EVENT &event, int s
 {
     LOG_INFO("[BleAdvertiserImpl] %{public}s:HandleGapExAdvEvent [event no: %{public}d].", __func__, (int)event);
 
+    bool isSetEvent = (event == BLE_GAP_EX_ADV_PARAM_SET_COMPLETE_EVT) ||
+                      (event == BLE_GAP_EX_ADV_DATA_SET_COMPLETE_EVT) ||
+                      (event == BLE_GAP_EX_ADV_SCAN_RSP_DATA_SET_COMPLETE_EVT);
+    if (isSetEvent && (!pimpl->updateEvents_.empty())) {
+        AdvertisingUpdateResult(status, event == BLE_GAP_EX_ADV_PARAM_SET_COMPLETE_EVT, txPower);
+        return;
+    }
+
     switch (event) {
         case BLE_GAP_EX_ADV_SET_RAND_ADDR_RESULT_EVT:
             GapExAdvSetRandAddrResultEvt(status);
@@ -1786,6 +2171,7 @@ void BleAdvertiserImpl::HandleGapExAdvEvent(const BLE_GAP_CB_EVENT &event, int s
             LOG_ERROR("[BleAdvertiserImpl] %{public}s:Invalid event! %{public}d.", __func__, event);
             break;
     }
+    ScheduleAdvertisingUpdates();
 }
 
 void BleAdvertiserImpl::TimerCallback(void *context, uint8_t advHandle)
@@ -1823,27 +2209,83 @@ void BleAdvertiserImpl::TimerCallbackEx(void *context, uint8_t advHandle)
 
     auto *advertiser = static_cast<BleAdvertiserImpl *>(context);
     if ((advertiser != nullptr) && (advertiser->dispatcher_ != nullptr)) {
-        /// Stop adv
-        auto iter = advertiser->pimpl->advHandleSettingDatas_.find(advHandle);
-        if (iter == advertiser->pimpl->advHandleSettingDatas_.end()) {
-            LOG_ERROR("[BleAdvertiserImpl] %{public}s:AdvHandleSettingDatas is empty!", __func__);
+        advertiser->dispatcher_->PostTask(std::bind(&BleAdvertiserImpl::RotateAddress, advertiser, advHandle));
+    }
+}
+
+void BleAdvertiserImpl::RotateAddress(uint8_t advHandle)
+{
+    LOG_DEBUG("[BleAdvertiserImpl] %{public}s:handle = %u.", __func__, advHandle);
+
+    std::lock_guard<std::recursive_mutex> lk(pimpl->mutex_);
+    auto iter = pimpl->advHandleSettingDatas_.find(advHandle);
+    if (iter == pimpl->advHandleSettingDatas_.end()) {
+        LOG_ERROR("[BleAdvertiserImpl] %{public}s:AdvHandleSettingDatas is empty!", __func__);
+        return;
+    }
+    if (IsExAdvBusy()) {
+        /// Rotated once the running sequence completes, so its enable and disable are not taken for one of its commands.
+        pimpl->pendingRotations_.insert(advHandle);
+        return;
+    }
+
+    /// Stop adv, the address is set and the set enabled again in RotateAddressResult
+    pimpl->rotateHandle_ = advHandle;
+    pimpl->isRotateDisabled_ = false;
+    pimpl->advStartHandle_ = advHandle;
+    int ret = SetExAdvEnableToGap(advHandle, false);
+    if (ret != BT_NO_ERROR) {
+        LOG_ERROR("[BleAdvertiserImpl] %{public}s:Stop advertising failed! %{public}d", __func__, ret);
+        pimpl->rotateHandle_ = BLE_INVALID_ADVERTISING_HANDLE;
+        ScheduleAdvertisingUpdates();
+    }
+}
+
+void BleAdvertiserImpl::RotateAddressResult(int status)
+{
+    LOG_DEBUG("[BleAdvertiserImpl] %{public}s:status = %{public}d.", __func__, status);
+
+    uint8_t advHandle = pimpl->rotateHandle_;
+    auto iter = pimpl->advHandleSettingDatas_.find(advHandle);
+    if (iter == pimpl->advHandleSettingDatas_.end()) {
+        LOG_ERROR("[BleAdvertiserImpl] %{public}s:invalid handle! %u.", __func__, advHandle);
+        pimpl->rotateHandle_ = BLE_INVALID_ADVERTISING_HANDLE;
+        ScheduleAdvertisingUpdates();
+        return;
+    }
+
+    int ret = status;
+    if (!pimpl->isRotateDisabled_) {
+        if (status != BT_NO_ERROR) {
+            /// Still advertising with the previous address
+            LOG_ERROR("[BleAdvertiserImpl] %{public}s:Stop advertising failed! %{public}d", __func__, status);
+            pimpl->rotateHandle_ = BLE_INVALID_ADVERTISING_HANDLE;
+            ScheduleAdvertisingUpdates();
             return;
         }
-        advertiser->dispatcher_->PostTask(
-            std::bind(&BleAdvertiserImpl::SetExAdvEnableToGap, advertiser, advHandle, false));
-
-        std::unique_lock<std::mutex> exAdvLock(advertiser->pimpl->rpamutex_);
-        advertiser->pimpl->advStartHandle_ = advHandle;
-        int ret = GAPIF_LeGenResPriAddr(&BleAdvertiserImpl::GenResPriAddrResult, advertiser);
-        if (ret != BT_NO_ERROR) {
-            LOG_ERROR("[BleAdvertiserImpl] %{public}s:GAP_LeGenResPriAddrAsync failed!", __func__);
+        pimpl->isRotateDisabled_ = true;
+        std::unique_lock<std::mutex> rotateLock(pimpl->rpamutex_);
+        ret = GAPIF_LeGenResPriAddr(&BleAdvertiserImpl::GenResPriAddrResult, this);
+        if (ret == BT_NO_ERROR) {
+            return;
         }
-        if (advertiser->pimpl->cvfull_.wait_for(exAdvLock, std::chrono::seconds(BLE_THREAD_WAIT_TIMEOUT)) ==
-            std::cv_status::timeout) {
-            LOG_ERROR("[BleAdvertiserImpl] %{public}s:GAP_LeGenResPriAddrAsync timeout!", __func__);
+        LOG_ERROR("[BleAdvertiserImpl] %{public}s:GAP_LeGenResPriAddrAsync failed!", __func__);
+        /// Start adv with the previous address
+        ret = SetExAdvEnableToGap(advHandle, true);
+        if (ret == BT_NO_ERROR) {
+            return;
         }
-        /// Start adv in GenResPriAddrResult->GenResPriAddrResultTask
     }
+
+    pimpl->rotateHandle_ = BLE_INVALID_ADVERTISING_HANDLE;
+    pimpl->isRotateDisabled_ = false;
+    if (ret != BT_NO_ERROR) {
+        LOG_ERROR("[BleAdvertiserImpl] %{public}s:Start advertising failed! %{public}d", __func__, ret);
+        iter->second.advStatus_ = ADVERTISE_FAILED_INTERNAL_ERROR;
+        callback_->OnStartResultEvent(ret, advHandle, BLE_ADV_START_FAILED_OP_CODE);
+        RemoveAdvHandle(advHandle);
+    }
+    ScheduleAdvertisingUpdates();
 }
 
 void BleAdvertiserImpl::GenResPriAddrResultTask(uint8_t result, BtAddr btAddr) const
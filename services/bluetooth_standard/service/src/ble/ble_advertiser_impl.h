@@ -18,6 +18,7 @@
 
 #include <map>
 #include <mutex>
+#include <vector>
 
 #include "adapter_manager.h"
 #include "ble_defs.h"
@@ -30,6 +31,8 @@
  * @brief The Bluetooth subsystem.
  */
 namespace bluetooth {
+struct BleAdvertiserUpdateData;
+
 /**
  * @brief BLE advertiser wrap data.
  */
@@ -81,6 +84,7 @@ public:
 
     /**
      * @brief Start Bluetooth LE Advertising.
+     *        Restarting a running extended set only rewrites its changed parameters and payloads.
      *
      * @param [in] Advertising parameters.
      * @param [in] Advertising data.
@@ -193,9 +197,11 @@ private:
     /**
      * @brief Set extend avertising parameter to gap
      *
+     * @param [in] avertising handle.
+     * @param [in] Avertising setting parameter.
      * @return @c status.
      */
-    int SetExAdvParamToGap(const BleAdvertiserSettingsImpl &settings) const;
+    int SetExAdvParamToGap(uint8_t advHandle, const BleAdvertiserSettingsImpl &settings) const;
 
     /**
      * @brief Set avertising parameter
@@ -205,6 +211,20 @@ private:
      */
     void SetAdvParam(const BleAdvertiserSettingsImpl &settings) const;
 
+    /**
+     * @brief Encode avertising or scan response data with local name and txpower, cached per handle
+     *
+     * @param [in] avertising handle.
+     * @param [in] avertising data.
+     * @param [in] avertising setting data.
+     * @param [in] local txpower.
+     * @param [in] true for scan response data.
+     * @param [out] encoded payload, valid until the handle is removed.
+     * @return @c status.
+     */
+    int EncodeAdvData(uint8_t advHandle, const BleAdvertiserDataImpl &data, const BleAdvertiserSettingsImpl &settings,
+        int8_t txPowerLevel, bool isScanRsp, const std::string *&payload) const;
+
     /**
      * @brief Set avertising data to gap
      *
@@ -270,6 +290,44 @@ private:
      */
     int SetExAdvBatchEnableToGap(bool isEnable) const;
 
+    /**
+     * @brief Set extend avertising batch enable status of the given sets
+     *
+     * @param [in] avertising enable.
+     * @param [in] avertising handles.
+     * @return @c status.
+     */
+    int SetExAdvBatchEnableToGap(bool isEnable, const std::vector<uint8_t> &advHandles) const;
+
+    /**
+     * @brief Write extend avertising or scan response payload to gap, fragmented as needed
+     *
+     * @param [in] avertising handle.
+     * @param [in] encoded payload.
+     * @param [in] true for scan response data.
+     * @param [out] number of data commands sent.
+     * @return @c status.
+     */
+    int SetExAdvPayloadToGap(uint8_t advHandle, const std::string &payload, bool isScanRsp, size_t &fragments) const;
+
+    /// Restart of running extended sets, coalesced into one batch per flush
+    bool IsExAdvBusy() const;
+    static bool IsSameAdvParam(const BleAdvertiserSettingsImpl &lhs, const BleAdvertiserSettingsImpl &rhs);
+    void QueueAdvertisingUpdate(const BleAdvertiserSettingsImpl &settings, const BleAdvertiserDataImpl &advData,
+        const BleAdvertiserDataImpl &scanResponse, uint8_t advHandle);
+    void ScheduleAdvertisingUpdates();
+    void FlushAdvertisingUpdates();
+    void UpdateAdvertisingSets(std::map<uint8_t, BleAdvertiserUpdateData> &updates);
+    int EncodeAdvertisingUpdate(
+        uint8_t advHandle, int8_t txPower, const std::string *&advPayload, const std::string *&rspPayload);
+    int SendAdvertisingUpdate(uint8_t advHandle, const std::string *advPayload, const std::string *rspPayload);
+    void RestartAdvertisingUpdateSets();
+    void AdvertisingUpdateResult(int status, bool isParamSet = false, int8_t txPower = 0);
+    void AdvertisingUpdateComplete();
+    /// Resolvable private address rotation of an extended set, held back while another sequence is in flight
+    void RotateAddress(uint8_t advHandle);
+    void RotateAddressResult(int status);
+
     /**
      * @brief Register avertising callback to gap
      *
@@ -360,8 +418,6 @@ private:
     void GapExAdvTerminatedAdvSetEvt(int status, uint8_t handle) const;
     void StartLegacyAdvOrExAdv(uint8_t advHandle);
     static int GetMaxAdvertisingDataLength(const BleAdvertiserSettingsImpl &settings);
-    int ExAdvDataFragment(const BleAdvertiserDataImpl &data) const;
-    int ExResDataFragment(const BleAdvertiserDataImpl &data) const;
     void GenResPriAddrResultTask(uint8_t result, BtAddr btAddr) const;
 
     void StartAllAdvertising(const STOP_ALL_ADV_TYPE &stopAllAdvType, bool isStartAdv) const;
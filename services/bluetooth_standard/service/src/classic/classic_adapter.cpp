@@ -77,7 +77,6 @@ void ClassicAdapter::StartUp()
 
     eirData_.SetDataMaxLength(MAX_EXTEND_INQUIRY_RESPONSE_LEN);
     timer_ = std::make_unique<utility::Timer>(std::bind(&ClassicAdapter::ScanModeTimeout, this));
-    hwTimer_ = std::make_unique<utility::Timer>(std::bind(&ClassicAdapter::HwProcessTimeout, this));
 
     bool ret = RegisterCallback();
     ClassicUtils::CheckReturnValue("ClassicAdapter", "RegisterCallback", ret);
@@ -89,6 +88,7 @@ void ClassicAdapter::StartUp()
     ClassicUtils::CheckReturnValue("ClassicAdapter", "SetSecurityMode", ret);
 
     LoadPairedDeviceInfo();
+    nameResolver_.Initialize();
 
     GetContext()->OnEnable(ADAPTER_NAME_CLASSIC, ret);
 }
@@ -151,12 +151,12 @@ void ClassicAdapter::DisablePairProcess()
 {
     LOG_DEBUG("[ClassicAdapter]::%{public}s", __func__);
     for (auto &device : devices_) {
-        if (device.second->GetPairedStatus() == PAIR_PAIRING) {
+        if (device->GetPairedStatus() == PAIR_PAIRING) {
             bool result =
-                (BTM_AclDisconnect(device.second->GetConnectionHandle(), BTM_ACL_DISCONNECT_REASON) == BT_NO_ERROR);
+                (BTM_AclDisconnect(device->GetConnectionHandle(), BTM_ACL_DISCONNECT_REASON) == BT_NO_ERROR);
             ClassicUtils::CheckReturnValue("ClassicAdapter", "BTM_AclDisconnect", result);
-            device.second->SetPairedStatus(PAIR_NONE);
-            if (device.second->IsBondedFromLocal() && (!pinMode_)) {
+            device->SetPairedStatus(PAIR_NONE);
+            if (device->IsBondedFromLocal() && (!pinMode_)) {
                 waitPairResult_ = true;
             }
         }
@@ -167,14 +167,12 @@ void ClassicAdapter::DisablePairProcess()
 void ClassicAdapter::FreeMemory()
 {
     LOG_DEBUG("[ClassicAdapter]::%{public}s", __func__);
-    devices_.clear();
+    devices_.Clear();
 
     hfService_ = nullptr;
     agService_ = nullptr;
 
-    if (hwTimer_ != nullptr) {
-        hwTimer_->Stop();
-    }
+    nameResolver_.Reset();
 
     if (timer_ != nullptr) {
         timer_->Stop();
@@ -249,7 +247,7 @@ void ClassicAdapter::LoadPairedDeviceInfo()
         } else {
             std::shared_ptr<ClassicRemoteDevice> remote = adapterProperties_.GetPairedDevice(addr);
             if (remote != nullptr) {
-                devices_.insert(std::make_pair(addr, remote));
+                devices_.Insert(remote);
             }
         }
     }
@@ -258,8 +256,8 @@ void ClassicAdapter::LoadPairedDeviceInfo()
 void ClassicAdapter::SavePairedDevices() const
 {
     for (auto &device : devices_) {
-        if (device.second->IsPaired()) {
-            adapterProperties_.SavePairedDeviceInfo(device.second);
+        if (device->IsPaired()) {
+            adapterProperties_.SavePairedDeviceInfo(device);
         }
     }
     adapterProperties_.SaveConfigFile();
@@ -516,20 +514,23 @@ void ClassicAdapter::ResetScanMode()
     SetScanMode(mode);
 }
 
-void ClassicAdapter::HwProcessTimeout()
+void ClassicAdapter::RemoteNameProcessTimeout(const std::string &addr)
 {
     LOG_DEBUG("[ClassicAdapter]::%{public}s", __func__);
 
     if (GetDispatcher() != nullptr) {
-        GetDispatcher()->PostTask(std::bind(&ClassicAdapter::HwTimeout, this));
+        GetDispatcher()->PostTask(std::bind(&ClassicAdapter::RemoteNameTimeout, this, addr));
     }
 }
 
-void ClassicAdapter::HwTimeout()
+void ClassicAdapter::RemoteNameTimeout(const std::string &addr)
 {
-    LOG_DEBUG("[ClassicAdapter]::%{public}s", __func__);
-    bool ret = CancelGetRemoteName();
-    ClassicUtils::CheckReturnValue("ClassicAdapter", "CancelGetRemoteName", ret);
+    LOG_DEBUG("[ClassicAdapter]::%{public}s address: %{public}s", __func__, addr.c_str());
+
+    std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
+    if (nameResolver_.Timeout(addr)) {
+        ContinueRemoteNameDiscovery();
+    }
 }
 
 int ClassicAdapter::GetBondableMode() const
@@ -545,7 +546,7 @@ bool ClassicAdapter::SetBondableMode(int mode) const
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
     for (auto &device : devices_) {
-        if (device.second->GetPairedStatus() == PAIR_PAIRING) {
+        if (device->GetPairedStatus() == PAIR_PAIRING) {
             LOG_WARN("[ClassicAdapter]::%{public}s failed, because of PAIR_PAIRING.", __func__);
             return false;
         }
@@ -597,8 +598,8 @@ bool ClassicAdapter::CancelBtDiscovery()
         ClassicUtils::CheckReturnValue("ClassicAdapter", "GAPIF_InquiryCancel", ret);
     } else {
         discoveryState_ = DISCOVERY_STOPED;
-        ret = CancelGetRemoteName();
-        ClassicUtils::CheckReturnValue("ClassicAdapter", "CancelGetRemoteName", ret);
+        ret = nameResolver_.CancelAll();
+        ClassicUtils::CheckReturnValue("ClassicAdapter", "CancelAll", ret);
     }
 
     return ret;
@@ -993,8 +994,8 @@ void ClassicAdapter::HandleInquiryResult(
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
     discoveryState_ = DISCOVERYING;
 
-    RawAddress device = RawAddress::ConvertToString(addr.addr);
-    std::shared_ptr<ClassicRemoteDevice> remoteDevice = FindRemoteDevice(device);
+    std::shared_ptr<ClassicRemoteDevice> remoteDevice = devices_.FindOrCreate(addr.addr);
+    RawAddress device(remoteDevice->GetAddress());
     int cod = (classOfDevice & CLASS_OF_DEVICE_RANGE);
     if (cod != remoteDevice->GetDeviceClass()) {
         remoteDevice->SetDeviceClass(cod);
@@ -1004,28 +1005,36 @@ void ClassicAdapter::HandleInquiryResult(
     remoteDevice->SetDeviceType(REMOTE_TYPE_BREDR);
     remoteDevice->SetRssi(rssi);
     if (!eir.empty()) {
-        ParserEirData(remoteDevice, eir);
+        /// Devices repeat the same EIR in every response, only parse it again when it changes or while the name is
+        /// unknown, the parse is what queues the name request again after a failed one.
+        bool isEirChanged = devices_.UpdateEir(addr.addr, eir);
+        if (isEirChanged || remoteDevice->GetRemoteName().empty()) {
+            ParserEirData(remoteDevice, eir);
+        }
     } else {
         if (remoteDevice->GetRemoteName().empty()) {
             remoteDevice->SetNameNeedGet(true);
         }
     }
+    if (remoteDevice->GetNameNeedGet()) {
+        std::string cachedName;
+        if (nameResolver_.GetCachedName(device.GetAddress(), cachedName)) {
+            remoteDevice->SetNameNeedGet(false);
+            if (cachedName != remoteDevice->GetRemoteName()) {
+                remoteDevice->SetRemoteName(cachedName);
+                SendRemoteNameChanged(device, cachedName);
+            }
+        } else {
+            devices_.QueueNameRequest(*remoteDevice);
+        }
+    }
 
     SendDiscoveryResult(device);
 }
 
 std::shared_ptr<ClassicRemoteDevice> ClassicAdapter::FindRemoteDevice(const RawAddress &device)
 {
-    std::shared_ptr<ClassicRemoteDevice> remoteDevice;
-    auto it = devices_.find(device.GetAddress());
-    if (it != devices_.end()) {
-        remoteDevice = it->second;
-    } else {
-        remoteDevice = std::make_shared<ClassicRemoteDevice>(device.GetAddress());
-        devices_.insert(std::make_pair(device.GetAddress(), remoteDevice));
-    }
-
-    return remoteDevice;
+    return devices_.FindOrCreate(device.GetAddress());
 }
 
 void ClassicAdapter::HandleInquiryComplete(uint8_t status)
@@ -1040,6 +1049,7 @@ void ClassicAdapter::HandleInquiryComplete(uint8_t status)
     discoveryEndMs_ = currentTime;
 
     if ((cancelDiscovery_) || (!DiscoverRemoteName())) {
+        nameResolver_.SaveCache();
         discoveryState_ = DISCOVERY_STOPED;
         SendDiscoveryStateChanged(discoveryState_);
         receiveInquiryComplete_ = false;
@@ -1062,19 +1072,7 @@ bool ClassicAdapter::DiscoverRemoteName()
         return false;
     }
 
-    for (auto device : devices_) {
-        if (device.second->GetNameNeedGet()) {
-            device.second->SetNameNeedGet(false);
-            remoteNameAddr_ = device.second->GetAddress();
-            RawAddress rawAddr = RawAddress(remoteNameAddr_);
-            BtAddr btAddr = ConvertToBtAddr(rawAddr);
-            bool ret = GetRemoteName(btAddr);
-            ClassicUtils::CheckReturnValue("ClassicAdapter", "GetRemoteName", ret);
-            return true;
-        }
-    }
-
-    return false;
+    return nameResolver_.Schedule();
 }
 
 BtAddr ClassicAdapter::ConvertToBtAddr(const RawAddress &device) const
@@ -1089,25 +1087,30 @@ void ClassicAdapter::ReceiveRemoteName(uint8_t status, const BtAddr &addr, const
 {
     LOG_DEBUG("[ClassicAdapter]::%{public}s status: %u", __func__, status);
 
-    if (hwTimer_ != nullptr) {
-        hwTimer_->Stop();
-    }
-
+    std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
+    RawAddress device = RawAddress::ConvertToString(addr.addr);
+    nameResolver_.Complete(device.GetAddress(), status);
     if (status == BT_NO_ERROR) {
         std::vector<uint8_t> nameVec(name, (name + MAX_LOC_BT_NAME_LEN));
         std::string deviceName(nameVec.begin(), nameVec.end());
         deviceName = deviceName.c_str();
-        RawAddress device = RawAddress::ConvertToString(addr.addr);
         std::shared_ptr<ClassicRemoteDevice> remoteDevice = FindRemoteDevice(device);
         if (deviceName != remoteDevice->GetRemoteName()) {
             remoteDevice->SetRemoteName(deviceName);
             SendRemoteNameChanged(device, deviceName);
         }
+        nameResolver_.UpdateCachedName(device.GetAddress(), deviceName);
     }
 
+    ContinueRemoteNameDiscovery();
+}
+
+void ClassicAdapter::ContinueRemoteNameDiscovery()
+{
     if (receiveInquiryComplete_) {
         if (!DiscoverRemoteName()) {
             std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
+            nameResolver_.SaveCache();
             discoveryState_ = DISCOVERY_STOPED;
             SendDiscoveryStateChanged(discoveryState_);
             receiveInquiryComplete_ = false;
@@ -1115,18 +1118,6 @@ void ClassicAdapter::ReceiveRemoteName(uint8_t status, const BtAddr &addr, const
     }
 }
 
-bool ClassicAdapter::CancelGetRemoteName() const
-{
-    LOG_DEBUG("[ClassicAdapter]::%{public}s", __func__);
-
-    RawAddress rawAddr = RawAddress(remoteNameAddr_);
-    BtAddr btAddr = ConvertToBtAddr(rawAddr);
-    bool ret = (GAPIF_GetRemoteNameCancel(&btAddr) == BT_NO_ERROR);
-    ClassicUtils::CheckReturnValue("ClassicAdapter", "GAPIF_GetRemoteNameCancel", ret);
-
-    return ret;
-}
-
 void ClassicAdapter::SendDiscoveryStateChanged(int discoveryState) const
 {
     LOG_DEBUG("[ClassicAdapter]::%{public}s state: %{public}d", __func__, discoveryState);
@@ -1231,10 +1222,10 @@ void ClassicAdapter::UserConfirmAutoReply(const RawAddress &device, int reqType,
 {
     LOG_DEBUG("[ClassicAdapter]::%{public}s address: %{public}s, accept: %{public}d", __func__, device.GetAddress().c_str(), accept);
 
-    auto it = devices_.find(device.GetAddress());
-    if (it != devices_.end()) {
-        it->second->SetPairConfirmState(PAIR_CONFIRM_STATE_USER_CONFIRM_REPLY);
-        it->second->SetPairConfirmType(PAIR_CONFIRM_TYPE_INVALID);
+    auto remoteDevice = devices_.Find(device.GetAddress());
+    if (remoteDevice != nullptr) {
+        remoteDevice->SetPairConfirmState(PAIR_CONFIRM_STATE_USER_CONFIRM_REPLY);
+        remoteDevice->SetPairConfirmType(PAIR_CONFIRM_TYPE_INVALID);
     }
 
     switch (reqType) {
@@ -1615,15 +1606,13 @@ void ClassicAdapter::ReceiveEncryptionChange(const BtAddr &addr, uint8_t status)
     }
 }
 
-bool ClassicAdapter::GetRemoteName(const BtAddr &addr) const
+bool ClassicAdapter::GetRemoteName(const BtAddr &addr)
 {
     LOG_DEBUG("[ClassicAdapter]::%{public}s", __func__);
 
-    bool ret = (GAPIF_GetRemoteName(&addr) == BT_NO_ERROR);
+    std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
+    bool ret = nameResolver_.Request(RawAddress::ConvertToString(addr.addr).GetAddress());
     ClassicUtils::CheckReturnValue("ClassicAdapter", "GAPIF_GetRemoteName", ret);
-    if (ret && (hwTimer_ != nullptr)) {
-        hwTimer_->Start(DEFAULT_HW_TIMEOUT);
-    }
 
     return ret;
 }
@@ -1634,9 +1623,9 @@ std::string ClassicAdapter::GetDeviceName(const RawAddress &device) const
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
     std::string remoteName = "";
-    auto it = devices_.find(device.GetAddress());
-    if (it != devices_.end()) {
-        remoteName = it->second->GetRemoteName();
+    auto remoteDevice = devices_.Find(device.GetAddress());
+    if (remoteDevice != nullptr) {
+        remoteName = remoteDevice->GetRemoteName();
     }
 
     return remoteName;
@@ -1648,9 +1637,9 @@ std::vector<Uuid> ClassicAdapter::GetDeviceUuids(const RawAddress &device) const
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
     std::vector<Uuid> uuids;
-    auto it = devices_.find(device.GetAddress());
-    if (it != devices_.end()) {
-        uuids = it->second->GetDeviceUuids();
+    auto remoteDevice = devices_.Find(device.GetAddress());
+    if (remoteDevice != nullptr) {
+        uuids = remoteDevice->GetDeviceUuids();
     }
     return uuids;
 }
@@ -1742,9 +1731,9 @@ bool ClassicAdapter::IsAclConnected(const RawAddress &device) const
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
     bool isAclConnected = false;
-    auto it = devices_.find(device.GetAddress());
-    if (it != devices_.end()) {
-        isAclConnected = it->second->IsAclConnected();
+    auto remoteDevice = devices_.Find(device.GetAddress());
+    if (remoteDevice != nullptr) {
+        isAclConnected = remoteDevice->IsAclConnected();
     }
 
     return isAclConnected;
@@ -1756,9 +1745,9 @@ bool ClassicAdapter::IsAclEncrypted(const RawAddress &device) const
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
     bool isAclEncrypted = false;
-    auto it = devices_.find(device.GetAddress());
-    if (it != devices_.end()) {
-        isAclEncrypted = it->second->IsAclEncrypted();
+    auto remoteDevice = devices_.Find(device.GetAddress());
+    if (remoteDevice != nullptr) {
+        isAclEncrypted = remoteDevice->IsAclEncrypted();
     }
 
     return isAclEncrypted;
@@ -1775,9 +1764,9 @@ bool ClassicAdapter::IsBondedFromLocal(const RawAddress &device) const
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
     bool isBondedFromLocal = false;
-    auto it = devices_.find(device.GetAddress());
-    if (it != devices_.end()) {
-        isBondedFromLocal = it->second->IsBondedFromLocal();
+    auto remoteDevice = devices_.Find(device.GetAddress());
+    if (remoteDevice != nullptr) {
+        isBondedFromLocal = remoteDevice->IsBondedFromLocal();
     }
 
     return isBondedFromLocal;
@@ -1788,8 +1777,8 @@ std::vector<RawAddress> ClassicAdapter::GetPairedDevices() const
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
     std::vector<RawAddress> pairedList;
     for (auto &device : devices_) {
-        if (device.second->IsPaired() == true) {
-            RawAddress rawAddr(device.second->GetAddress());
+        if (device->IsPaired() == true) {
+            RawAddress rawAddr(device->GetAddress());
             pairedList.push_back(rawAddr);
         }
     }
@@ -1832,14 +1821,14 @@ bool ClassicAdapter::CancelPairing(const RawAddress &device)
     LOG_DEBUG("[ClassicAdapter]::%{public}s", __func__);
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
-    auto it = devices_.find(device.GetAddress());
-    if (it == devices_.end() || (it->second->GetPairedStatus() != PAIR_PAIRING)) {
+    auto remoteDevice = devices_.Find(device.GetAddress());
+    if (remoteDevice == nullptr || (remoteDevice->GetPairedStatus() != PAIR_PAIRING)) {
         LOG_ERROR("%{public}s failed, because of not in PAIR_PAIRING!", __func__);
         return false;
     }
 
-    it->second->SetPairedStatus(PAIR_CANCELING);
-    int pairConfirmState = it->second->GetPairConfirmState();
+    remoteDevice->SetPairedStatus(PAIR_CANCELING);
+    int pairConfirmState = remoteDevice->GetPairConfirmState();
     if (pairConfirmState == PAIR_CONFIRM_STATE_USER_CONFIRM_REPLY) {
         BtAddr btAddr = ConvertToBtAddr(device);
         bool ret = (GAPIF_CancelAuthenticationReq(&btAddr) == BT_NO_ERROR);
@@ -1848,8 +1837,8 @@ bool ClassicAdapter::CancelPairing(const RawAddress &device)
     }
 
     if (pairConfirmState == PAIR_CONFIRM_STATE_USER_CONFIRM) {
-        int pairConfirmType = it->second->GetPairConfirmType();
-        RawAddress address(it->second->GetAddress());
+        int pairConfirmType = remoteDevice->GetPairConfirmType();
+        RawAddress address(remoteDevice->GetAddress());
         UserConfirmAutoReply(address, pairConfirmType, false);
     }
     return true;
@@ -1860,17 +1849,17 @@ bool ClassicAdapter::RemovePair(const RawAddress &device)
     LOG_DEBUG("[ClassicAdapter]::%{public}s address %{public}s", __func__, device.GetAddress().c_str());
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
-    auto it = devices_.find(device.GetAddress());
-    if ((it == devices_.end()) || (it->second->IsPaired() == false)) {
+    auto remoteDevice = devices_.Find(device.GetAddress());
+    if ((remoteDevice == nullptr) || (remoteDevice->IsPaired() == false)) {
         LOG_WARN("RemovePair failed, because of not find the paired device!");
         return false;
     } else {
-        it->second->SetPairedStatus(PAIR_NONE);
-        DeleteLinkKey(it->second);
-        adapterProperties_.RemovePairedDeviceInfo(it->second->GetAddress());
+        remoteDevice->SetPairedStatus(PAIR_NONE);
+        DeleteLinkKey(remoteDevice);
+        adapterProperties_.RemovePairedDeviceInfo(remoteDevice->GetAddress());
         adapterProperties_.SaveConfigFile();
-        if (it->second->IsAclConnected()) {
-            bool ret = (BTM_AclDisconnect(it->second->GetConnectionHandle(), BTM_ACL_DISCONNECT_REASON) == BT_NO_ERROR);
+        if (remoteDevice->IsAclConnected()) {
+            bool ret = (BTM_AclDisconnect(remoteDevice->GetConnectionHandle(), BTM_ACL_DISCONNECT_REASON) == BT_NO_ERROR);
             ClassicUtils::CheckReturnValue("ClassicAdapter", "BTM_AclDisconnect", ret);
         }
     }
@@ -1886,16 +1875,16 @@ bool ClassicAdapter::RemoveAllPairs()
     LOG_DEBUG("[ClassicAdapter]::%{public}s", __func__);
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
     std::vector<RawAddress> removeDevices;
-    for (auto it = devices_.begin(); it != devices_.end(); it++) {
-        if (it->second->IsPaired() == true) {
-            it->second->SetPairedStatus(PAIR_NONE);
-            DeleteLinkKey(it->second);
-            adapterProperties_.RemovePairedDeviceInfo(it->second->GetAddress());
-            RawAddress device = RawAddress(it->second->GetAddress());
+    for (auto &remoteDevice : devices_) {
+        if (remoteDevice->IsPaired() == true) {
+            remoteDevice->SetPairedStatus(PAIR_NONE);
+            DeleteLinkKey(remoteDevice);
+            adapterProperties_.RemovePairedDeviceInfo(remoteDevice->GetAddress());
+            RawAddress device = RawAddress(remoteDevice->GetAddress());
             removeDevices.push_back(device);
-            if (it->second->IsAclConnected()) {
+            if (remoteDevice->IsAclConnected()) {
                 bool ret =
-                    (BTM_AclDisconnect(it->second->GetConnectionHandle(), BTM_ACL_DISCONNECT_REASON) == BT_NO_ERROR);
+                    (BTM_AclDisconnect(remoteDevice->GetConnectionHandle(), BTM_ACL_DISCONNECT_REASON) == BT_NO_ERROR);
                 ClassicUtils::CheckReturnValue("ClassicAdapter", "BTM_AclDisconnect", ret);
             }
         }
@@ -1913,11 +1902,11 @@ int ClassicAdapter::GetPairState(const RawAddress &device) const
 {
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
     int pairState = PAIR_NONE;
-    auto it = devices_.find(device.GetAddress());
-    if (it == devices_.end()) {
+    auto remoteDevice = devices_.Find(device.GetAddress());
+    if (remoteDevice == nullptr) {
         return pairState;
     } else {
-        pairState = it->second->GetPairedStatus();
+        pairState = remoteDevice->GetPairedStatus();
     }
 
     LOG_DEBUG("[ClassicAdapter]::%{public}s state: %{public}d", __func__, pairState);
@@ -1930,18 +1919,18 @@ bool ClassicAdapter::SetDevicePairingConfirmation(const RawAddress &device, bool
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
     bool ret = false;
-    auto it = devices_.find(device.GetAddress());
-    if ((it == devices_.end()) || (it->second->GetPairedStatus() == PAIR_PAIRED) ||
-        (it->second->GetPairedStatus() == PAIR_NONE)) {
+    auto remoteDevice = devices_.Find(device.GetAddress());
+    if ((remoteDevice == nullptr) || (remoteDevice->GetPairedStatus() == PAIR_PAIRED) ||
+        (remoteDevice->GetPairedStatus() == PAIR_NONE)) {
         LOG_ERROR("[ClassicAdapter]::%{public}s failed, not in pairing state.", __func__);
         return ret;
     }
 
-    it->second->SetPairConfirmState(PAIR_CONFIRM_STATE_USER_CONFIRM_REPLY);
-    it->second->SetPairConfirmType(PAIR_CONFIRM_TYPE_INVALID);
+    remoteDevice->SetPairConfirmState(PAIR_CONFIRM_STATE_USER_CONFIRM_REPLY);
+    remoteDevice->SetPairConfirmType(PAIR_CONFIRM_TYPE_INVALID);
 
     BtAddr btAddr = ConvertToBtAddr(device);
-    if (it->second->GetPairedStatus() == PAIR_CANCELING || accept == false) {
+    if (remoteDevice->GetPairedStatus() == PAIR_CANCELING || accept == false) {
         ret = (GAPIF_UserConfirmRsp(&btAddr, GAP_NOT_ACCEPT) == BT_NO_ERROR);
     } else {
         ret = (GAPIF_UserConfirmRsp(&btAddr, GAP_ACCEPT) == BT_NO_ERROR);
@@ -1957,18 +1946,18 @@ bool ClassicAdapter::SetDevicePasskey(const RawAddress &device, int passkey, boo
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
     bool ret = false;
-    auto it = devices_.find(device.GetAddress());
-    if ((it == devices_.end()) || (it->second->GetPairedStatus() == PAIR_NONE) ||
-        (it->second->GetPairedStatus() == PAIR_PAIRED)) {
+    auto remoteDevice = devices_.Find(device.GetAddress());
+    if ((remoteDevice == nullptr) || (remoteDevice->GetPairedStatus() == PAIR_NONE) ||
+        (remoteDevice->GetPairedStatus() == PAIR_PAIRED)) {
         LOG_ERROR("[ClassicAdapter]::%{public}s failed, not in pairing state.", __func__);
         return ret;
     }
 
-    it->second->SetPairConfirmType(PAIR_CONFIRM_TYPE_INVALID);
-    it->second->SetPairConfirmState(PAIR_CONFIRM_STATE_USER_CONFIRM_REPLY);
+    remoteDevice->SetPairConfirmType(PAIR_CONFIRM_TYPE_INVALID);
+    remoteDevice->SetPairConfirmState(PAIR_CONFIRM_STATE_USER_CONFIRM_REPLY);
 
     BtAddr btAddr = ConvertToBtAddr(device);
-    if (it->second->GetPairedStatus() == PAIR_CANCELING || accept == false) {
+    if (remoteDevice->GetPairedStatus() == PAIR_CANCELING || accept == false) {
         ret = (GAPIF_UserPasskeyRsp(&btAddr, GAP_NOT_ACCEPT, passkey) == BT_NO_ERROR);
     } else {
         ret = (GAPIF_UserPasskeyRsp(&btAddr, GAP_ACCEPT, passkey) == BT_NO_ERROR);
@@ -1983,8 +1972,8 @@ bool ClassicAdapter::PairRequestReply(const RawAddress &device, bool accept) con
     LOG_DEBUG("[ClassicAdapter]::%{public}s, accept = %{public}d", __func__, accept);
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
-    auto it = devices_.find(device.GetAddress());
-    if ((it == devices_.end()) || (it->second->GetPairedStatus() != PAIR_PAIRING)) {
+    auto remoteDevice = devices_.Find(device.GetAddress());
+    if ((remoteDevice == nullptr) || (remoteDevice->GetPairedStatus() != PAIR_PAIRING)) {
         LOG_ERROR("[ClassicAdapter]::%{public}s failed, not in pairing state.", __func__);
         return false;
     }
@@ -2071,28 +2060,28 @@ void ClassicAdapter::ReceiveDisconnectionComplete(uint8_t status, uint16_t conne
     }
 
     for (auto &device : devices_) {
-        if (connectionHandle != device.second->GetConnectionHandle()) {
+        if (connectionHandle != device->GetConnectionHandle()) {
             continue;
         }
-        device.second->SetAclConnectState(CONNECTION_STATE_DISCONNECTED);
+        device->SetAclConnectState(CONNECTION_STATE_DISCONNECTED);
 
         LOG_DEBUG("pinMode = %{public}d", pinMode_);
         /// Passive pairing failed and pair mode is PinCode.
         /// For 960 compatibility
         /// When ACL disconnect and current pari state is in PAIR_PAIRING or PAIR_CANCELING, set pair state to
         /// PAIR_NONE.
-        if ((pinMode_) || (device.second->GetPairedStatus() == PAIR_PAIRING) ||
-            (device.second->GetPairedStatus() == PAIR_CANCELING)) {
+        if ((pinMode_) || (device->GetPairedStatus() == PAIR_PAIRING) ||
+            (device->GetPairedStatus() == PAIR_CANCELING)) {
             pinMode_ = false;
             /// Passive pairing failed, delete the link key.
-            DeleteLinkKey(device.second);
+            DeleteLinkKey(device);
             /// Set the pair flag and pair state.
-            device.second->SetPairedStatus(PAIR_NONE);
+            device->SetPairedStatus(PAIR_NONE);
             /// Send the failed notification to APP.
-            bool bondFromLocal = device.second->IsBondedFromLocal();
+            bool bondFromLocal = device->IsBondedFromLocal();
             LOG_DEBUG("bondFromLocal = %{public}d", bondFromLocal);
             if (!bondFromLocal) {
-                RawAddress address(device.second->GetAddress());
+                RawAddress address(device->GetAddress());
                 SendPairStatusChanged(ADAPTER_BREDR, address, PAIR_NONE);
             }
         }
@@ -2204,9 +2193,9 @@ bool ClassicAdapter::SetDevicePin(const RawAddress &device, const std::string &p
     LOG_DEBUG("[ClassicAdapter]::%{public}s", __func__);
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
-    auto it = devices_.find(device.GetAddress());
-    if ((it == devices_.end()) || (it->second->GetPairedStatus() == PAIR_NONE) ||
-        (it->second->GetPairedStatus() == PAIR_PAIRED)) {
+    auto remoteDevice = devices_.Find(device.GetAddress());
+    if ((remoteDevice == nullptr) || (remoteDevice->GetPairedStatus() == PAIR_NONE) ||
+        (remoteDevice->GetPairedStatus() == PAIR_PAIRED)) {
         LOG_ERROR("[ClassicAdapter]::%{public}s failed, not in pairing state.", __func__);
         return false;
     }
@@ -2218,9 +2207,9 @@ bool ClassicAdapter::SetDevicePin(const RawAddress &device, const std::string &p
     }
 
     uint8_t accept = GAP_ACCEPT;
-    it->second->SetPairConfirmState(PAIR_CONFIRM_STATE_USER_CONFIRM_REPLY);
-    it->second->SetPairConfirmType(PAIR_CONFIRM_TYPE_INVALID);
-    if (it->second->GetPairedStatus() == PAIR_CANCELING) {
+    remoteDevice->SetPairConfirmState(PAIR_CONFIRM_STATE_USER_CONFIRM_REPLY);
+    remoteDevice->SetPairConfirmType(PAIR_CONFIRM_TYPE_INVALID);
+    if (remoteDevice->GetPairedStatus() == PAIR_CANCELING) {
         accept = GAP_NOT_ACCEPT;
     }
 
@@ -2257,9 +2246,9 @@ int ClassicAdapter::ClassicAdapter::GetDeviceType(const RawAddress &device) cons
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
     int type = INVALID_VALUE;
-    auto it = devices_.find(device.GetAddress());
-    if (it != devices_.end()) {
-        type = it->second->GetDeviceType();
+    auto remoteDevice = devices_.Find(device.GetAddress());
+    if (remoteDevice != nullptr) {
+        type = remoteDevice->GetDeviceType();
     }
 
     return type;
@@ -2271,9 +2260,9 @@ int ClassicAdapter::GetDeviceClass(const RawAddress &device) const
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
     int cod = INVALID_VALUE;
-    auto it = devices_.find(device.GetAddress());
-    if (it != devices_.end()) {
-        cod = it->second->GetDeviceClass();
+    auto remoteDevice = devices_.Find(device.GetAddress());
+    if (remoteDevice != nullptr) {
+        cod = remoteDevice->GetDeviceClass();
     }
 
     return cod;
@@ -2285,9 +2274,9 @@ std::string ClassicAdapter::GetAliasName(const RawAddress &device) const
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
     std::string alias = INVALID_NAME;
-    auto it = devices_.find(device.GetAddress());
-    if (it != devices_.end()) {
-        alias = it->second->GetAliasName();
+    auto remoteDevice = devices_.Find(device.GetAddress());
+    if (remoteDevice != nullptr) {
+        alias = remoteDevice->GetAliasName();
     }
 
     return alias;
@@ -2299,10 +2288,10 @@ bool ClassicAdapter::SetAliasName(const RawAddress &device, const std::string &n
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
     bool ret = false;
-    auto it = devices_.find(device.GetAddress());
-    if (it != devices_.end()) {
-        if (name != it->second->GetAliasName()) {
-            ret = it->second->SetAliasName(name);
+    auto remoteDevice = devices_.Find(device.GetAddress());
+    if (remoteDevice != nullptr) {
+        if (name != remoteDevice->GetAliasName()) {
+            ret = remoteDevice->SetAliasName(name);
             if (ret == false) {
                 LOG_ERROR("ClassicAdapter::SetAliasName failed");
             } else {
@@ -2378,9 +2367,9 @@ int ClassicAdapter::GetDeviceBatteryLevel(const RawAddress &device) const
 {
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
     int batteryLevel = 0;
-    auto it = devices_.find(device.GetAddress());
-    if (it != devices_.end()) {
-        batteryLevel = it->second->GetBatteryLevel();
+    auto remoteDevice = devices_.Find(device.GetAddress());
+    if (remoteDevice != nullptr) {
+        batteryLevel = remoteDevice->GetBatteryLevel();
     }
     LOG_DEBUG("[ClassicAdapter]::%{public}s, batteryLevel: %{public}d", __func__, batteryLevel);
     return batteryLevel;
@@ -2391,9 +2380,9 @@ void ClassicAdapter::SetDeviceBatteryLevel(const RawAddress &device, int battery
     LOG_DEBUG("[ClassicAdapter]::%{public}s, addr: %{public}s, batteryLevel: %{public}d", __func__, device.GetAddress().c_str(), batteryLevel);
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
-    auto it = devices_.find(device.GetAddress());
-    if (it != devices_.end()) {
-        it->second->SetBatteryLevel(batteryLevel);
+    auto remoteDevice = devices_.Find(device.GetAddress());
+    if (remoteDevice != nullptr) {
+        remoteDevice->SetBatteryLevel(batteryLevel);
     }
     
     SendRemoteBatteryLevelChanged(device, batteryLevel);
@@ -16,7 +16,6 @@
 #ifndef CLASSIC_ADAPTER_H
 #define CLASSIC_ADAPTER_H
 
-#include <map>
 #include <vector>
 
 #include "base_def.h"
@@ -25,7 +24,10 @@
 #include "classic_adapter_properties.h"
 #include "classic_battery_observer.h"
 #include "classic_bluetooth_data.h"
+#include "classic_defs.h"
 #include "classic_remote_device.h"
+#include "classic_remote_device_table.h"
+#include "classic_remote_name_resolver.h"
 #include "context.h"
 #include "gap_if.h"
 #include "interface_adapter_classic.h"
@@ -664,11 +666,12 @@ private:
     void ScanModeTimeout();
 
     /**
-     * @brief Hw(Controller) process timeout.
+     * @brief Remote name request timeout.
      *
+     * @param addr Device address.
      */
-    void HwProcessTimeout();
-    void HwTimeout();
+    void RemoteNameProcessTimeout(const std::string &addr);
+    void RemoteNameTimeout(const std::string &addr);
 
     /**
      * @brief Register callback.
@@ -689,7 +692,7 @@ private:
      * @return Returns <b>true</b> if the operation is successful;
      *         returns <b>false</b> if the operation fails.
      */
-    bool GetRemoteName(const BtAddr &addr) const;
+    bool GetRemoteName(const BtAddr &addr);
 
     /**
      * @brief Set link key.
@@ -1043,7 +1046,7 @@ private:
     void FreeMemory();
     void DisableBTM();
     bool DiscoverRemoteName();
-    bool CancelGetRemoteName() const;
+    void ContinueRemoteNameDiscovery();
     void SearchRemoteUuids(const RawAddress &device, uint16_t uuid);
     void ResetScanMode();
     void DeleteLinkKey(std::shared_ptr<ClassicRemoteDevice> remoteDevice) const;
@@ -1053,7 +1056,6 @@ private:
     void PinCodeReq(const BtAddr &addr);
     ClassicAdapterProperties &adapterProperties_;
     std::unique_ptr<utility::Timer> timer_ {};
-    std::unique_ptr<utility::Timer> hwTimer_ {};
     int discoveryState_ {};
     int scanMode_ {};
     long discoveryEndMs_ {};
@@ -1065,8 +1067,9 @@ private:
     bool waitPairResult_ {};
     uint16_t searchUuid_ {};
     std::vector<Uuid> uuids_ {};
-    std::string remoteNameAddr_ {INVALID_MAC_ADDRESS};
-    std::map<std::string, std::shared_ptr<ClassicRemoteDevice>> devices_ {};
+    ClassicRemoteDeviceTable devices_ {REMOTE_DEVICE_TABLE_CAPACITY};
+    ClassicRemoteNameResolver nameResolver_ {
+        devices_, std::bind(&ClassicAdapter::RemoteNameProcessTimeout, this, std::placeholders::_1)};
     BtmAclCallbacks btmAclCbs_ {};
     ClassicBluetoothData eirData_ {};
     std::unique_ptr<ClassicBatteryObserverHf> batteryObserverHf_ {};
@@ -15,6 +15,7 @@
 
 #include "classic_config.h"
 
+#include <cstdlib>
 #include <vector>
 
 #include "bt_def.h"
@@ -373,4 +374,55 @@ std::string ClassicConfig::GetRemoteUuids(const std::string &subSection) const
 
     return uuids;
 }
+
+std::vector<std::string> ClassicConfig::GetNameCacheAddrList() const
+{
+    std::vector<std::string> addrList;
+    if (!config_->GetSubSections(SECTION_BREDR_NAME_CACHE, addrList)) {
+        LOG_INFO("[ClassicConfig]::%{public}s failed!", __func__);
+    }
+
+    return addrList;
+}
+
+bool ClassicConfig::GetCachedRemoteName(const std::string &subSection, std::string &name, int64_t &updateTime) const
+{
+    std::string time = "";
+    if ((!config_->GetValue(SECTION_BREDR_NAME_CACHE, subSection, PROPERTY_DEVICE_NAME, name)) ||
+        (!config_->GetValue(SECTION_BREDR_NAME_CACHE, subSection, PROPERTY_NAME_UPDATE_TIME, time))) {
+        LOG_INFO("[ClassicConfig]::%{public}s failed!", __func__);
+        return false;
+    }
+
+    char *end = nullptr;
+    updateTime = strtoll(time.c_str(), &end, DECIMAL_BASE);
+    if ((end == time.c_str()) || (*end != '\0')) {
+        LOG_WARN("[ClassicConfig]::%{public}s invalid time %{public}s", __func__, time.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+bool ClassicConfig::SetCachedRemoteName(const std::string &subSection, const std::string &name, int64_t updateTime) const
+{
+    if ((!config_->SetValue(SECTION_BREDR_NAME_CACHE, subSection, PROPERTY_DEVICE_NAME, name)) ||
+        (!config_->SetValue(SECTION_BREDR_NAME_CACHE, subSection, PROPERTY_NAME_UPDATE_TIME,
+            std::to_string(updateTime)))) {
+        LOG_WARN("[ClassicConfig]::%{public}s failed!", __func__);
+        return false;
+    }
+
+    return true;
+}
+
+bool ClassicConfig::RemoveCachedRemoteName(const std::string &subSection) const
+{
+    if (!config_->RemoveSection(SECTION_BREDR_NAME_CACHE, subSection)) {
+        LOG_INFO("[ClassicConfig]::%{public}s failed!", __func__);
+        return false;
+    }
+
+    return true;
+}
 }  // namespace bluetooth
\ No newline at end of file
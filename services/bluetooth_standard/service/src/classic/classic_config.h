@@ -340,6 +340,44 @@ public:
      */
     std::string GetRemoteUuids(const std::string &subSection) const;
 
+    /**
+     * @brief Get the addresses of devices in the remote name cache.
+     *
+     * @return Returns the cached device address list.
+     */
+    std::vector<std::string> GetNameCacheAddrList() const;
+
+    /**
+     * @brief Get a cached remote device name.
+     *
+     * @param subSection Device address.
+     * @param name Cached device name.
+     * @param updateTime Seconds since the epoch when the name was read.
+     * @return Returns <b>true</b> if the operation is successful;
+     *         returns <b>false</b> if the operation fails.
+     */
+    bool GetCachedRemoteName(const std::string &subSection, std::string &name, int64_t &updateTime) const;
+
+    /**
+     * @brief Cache a remote device name.
+     *
+     * @param subSection Device address.
+     * @param name Device name.
+     * @param updateTime Seconds since the epoch when the name was read.
+     * @return Returns <b>true</b> if the operation is successful;
+     *         returns <b>false</b> if the operation fails.
+     */
+    bool SetCachedRemoteName(const std::string &subSection, const std::string &name, int64_t updateTime) const;
+
+    /**
+     * @brief Remove a cached remote device name.
+     *
+     * @param subSection Device address.
+     * @return Returns <b>true</b> if the operation is successful;
+     *         returns <b>false</b> if the operation fails.
+     */
+    bool RemoveCachedRemoteName(const std::string &subSection) const;
+
 private:
     /**
      * @brief A constructor used to create a <b>ClassicConfig</b> instance.
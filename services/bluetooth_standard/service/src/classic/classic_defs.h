@@ -36,10 +36,19 @@ constexpr int DEFAULT_CLASS_OF_DEVICE = 0x2A0104;
 constexpr int DEFAULT_SCANMODE_DURATION_MILLIS = 120000;
 constexpr int DEFAULT_DISCOVERY_TIMEOUT_MS = 12800;
 constexpr int DISCOVERY_DEVICE_LIST_MAX = 30;
+constexpr int REMOTE_DEVICE_TABLE_CAPACITY = 512;
 constexpr int DEFAULT_INQ_MAX_DURATION = 10;
 constexpr int DEFAULT_INQ_MIN_DURATION = 1;
 
-constexpr int DEFAULT_HW_TIMEOUT = 5000;
+/// Remote name resolution
+constexpr int DEFAULT_REMOTE_NAME_REQUESTS = 2;
+constexpr int REMOTE_NAME_REQUEST_TIMEOUT_MS = 5000;
+constexpr int REMOTE_NAME_CACHE_CAPACITY = 256;
+constexpr int64_t REMOTE_NAME_CACHE_TTL_SEC = 30 * 24 * 60 * 60;
+constexpr uint8_t REMOTE_NAME_STATUS_PAGE_TIMEOUT = 0x04;
+constexpr uint8_t REMOTE_NAME_STATUS_MEMORY_CAPACITY_EXCEEDED = 0x07;
+constexpr uint8_t REMOTE_NAME_STATUS_CONNECTION_LIMIT_EXCEEDED = 0x09;
+constexpr uint8_t REMOTE_NAME_STATUS_COMMAND_DISALLOWED = 0x0C;
 constexpr int MILLISECOND_UNIT = 1000;
 constexpr int MOVE_ONE_BYTE = 8;
 constexpr int COD_SIZE = 3;
@@ -74,6 +83,7 @@ constexpr int MAC_ADDRESS_LENGTH = 6;
 
 constexpr int SDP_UUDIID_NUM = 1;
 constexpr int HEX_FORMAT_SIZE = 3;
+constexpr int DECIMAL_BASE = 10;
 
 constexpr int UUID128_BYTES_TYPE = 16;
 constexpr int UUID32_BYTES_TYPE = 4;
@@ -189,6 +189,13 @@ void ClassicRemoteDevice::SetRssi(int rssi)
     rssi_ = rssi;
 }
 
+int ClassicRemoteDevice::GetRssi() const
+{
+    LOG_DEBUG("[ClassicRemoteDevice]::%{public}s rssi = %{public}d", __func__, rssi_);
+
+    return rssi_;
+}
+
 void ClassicRemoteDevice::SetConnectionHandle(int handle)
 {
     LOG_DEBUG("[ClassicRemoteDevice]::%{public}s connectionHandle = %{public}d", __func__, handle);
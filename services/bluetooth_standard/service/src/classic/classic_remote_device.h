@@ -193,6 +193,13 @@ public:
      */
     void SetRssi(int rssi);
 
+    /**
+     * @brief Get rssi value.
+     *
+     * @return Returns rssi value from the last inquiry result.
+     */
+    int GetRssi() const;
+
     /**
      * @brief Set device type.
      *
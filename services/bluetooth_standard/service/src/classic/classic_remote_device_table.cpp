@@ -0,0 +1,258 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "classic_remote_device_table.h"
+
+#include <limits>
+#include <string_view>
+
+#include "classic_defs.h"
+#include "log.h"
+#include "raw_address.h"
+
+namespace bluetooth {
+namespace {
+constexpr int HEX_BASE = 16;
+constexpr int HEX_DIGIT_BITS = 4;
+constexpr int HEX_ALPHA_OFFSET = 10;
+}  // namespace
+
+ClassicRemoteDeviceTable::ClassicRemoteDeviceTable(size_t capacity) : capacity_(capacity)
+{}
+
+ClassicRemoteDeviceTable::~ClassicRemoteDeviceTable()
+{
+    Clear();
+}
+
+uint64_t ClassicRemoteDeviceTable::MakeKey(const uint8_t addr[BT_ADDRESS_SIZE])
+{
+    uint64_t key = 0;
+    for (int i = BT_ADDRESS_SIZE - 1; i >= 0; i--) {
+        key = (key << MOVE_ONE_BYTE) | addr[i];
+    }
+    return key;
+}
+
+uint64_t ClassicRemoteDeviceTable::MakeKey(const std::string &addr)
+{
+    uint64_t key = 0;
+    for (char c : addr) {
+        int digit;
+        if ((c >= '0') && (c <= '9')) {
+            digit = c - '0';
+        } else if ((c >= 'A') && (c <= 'F')) {
+            digit = c - 'A' + HEX_ALPHA_OFFSET;
+        } else if ((c >= 'a') && (c <= 'f')) {
+            digit = c - 'a' + HEX_ALPHA_OFFSET;
+        } else {
+            continue;
+        }
+        key = (key << HEX_DIGIT_BITS) | static_cast<uint64_t>(digit % HEX_BASE);
+    }
+    return key;
+}
+
+ClassicRemoteDeviceTable::Entry *ClassicRemoteDeviceTable::FindEntry(uint64_t key) const
+{
+    auto it = index_.find(key);
+    return (it != index_.end()) ? &*it->second : nullptr;
+}
+
+std::shared_ptr<ClassicRemoteDevice> ClassicRemoteDeviceTable::Find(const std::string &addr) const
+{
+    Entry *entry = FindEntry(MakeKey(addr));
+    return (entry != nullptr) ? entry->device : nullptr;
+}
+
+std::shared_ptr<ClassicRemoteDevice> ClassicRemoteDeviceTable::FindOrCreate(const uint8_t addr[BT_ADDRESS_SIZE])
+{
+    uint64_t key = MakeKey(addr);
+    Entry *entry = FindEntry(key);
+    if (entry != nullptr) {
+        Touch(*entry);
+        return entry->device;
+    }
+
+    RawAddress device = RawAddress::ConvertToString(addr);
+    return CreateEntry(key, std::make_shared<ClassicRemoteDevice>(device.GetAddress())).device;
+}
+
+std::shared_ptr<ClassicRemoteDevice> ClassicRemoteDeviceTable::FindOrCreate(const std::string &addr)
+{
+    uint64_t key = MakeKey(addr);
+    Entry *entry = FindEntry(key);
+    if (entry != nullptr) {
+        Touch(*entry);
+        return entry->device;
+    }
+
+    return CreateEntry(key, std::make_shared<ClassicRemoteDevice>(addr)).device;
+}
+
+void ClassicRemoteDeviceTable::Insert(const std::shared_ptr<ClassicRemoteDevice> &device)
+{
+    uint64_t key = MakeKey(device->GetAddress());
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        Erase(it->second);
+    }
+    CreateEntry(key, device);
+}
+
+ClassicRemoteDeviceTable::Entry &ClassicRemoteDeviceTable::CreateEntry(
+    uint64_t key, const std::shared_ptr<ClassicRemoteDevice> &device)
+{
+    EvictIfFull();
+    Entry entry;
+    entry.key = key;
+    entry.device = device;
+    entries_.push_front(entry);
+    index_[key] = entries_.begin();
+    return entries_.front();
+}
+
+void ClassicRemoteDeviceTable::Touch(Entry &entry)
+{
+    auto it = index_[entry.key];
+    if (it != entries_.begin()) {
+        entries_.splice(entries_.begin(), entries_, it);
+    }
+}
+
+void ClassicRemoteDeviceTable::Erase(EntryList::iterator it)
+{
+    UnlinkNameRequest(*it);
+    index_.erase(it->key);
+    entries_.erase(it);
+}
+
+bool ClassicRemoteDeviceTable::IsEvictable(const ClassicRemoteDevice &device)
+{
+    return (!device.IsPaired()) && (device.GetPairedStatus() == PAIR_NONE) && (!device.IsAclConnected());
+}
+
+void ClassicRemoteDeviceTable::EvictIfFull()
+{
+    if (entries_.size() < capacity_) {
+        return;
+    }
+    for (auto it = entries_.end(); it != entries_.begin();) {
+        --it;
+        if (IsEvictable(*it->device)) {
+            LOG_DEBUG("[ClassicRemoteDeviceTable]::%{public}s drop %{public}s", __func__, it->device->GetAddress().c_str());
+            Erase(it);
+            return;
+        }
+    }
+    LOG_WARN("[ClassicRemoteDeviceTable]::%{public}s all %{public}d devices are in use",
+        __func__, static_cast<int>(entries_.size()));
+}
+
+void ClassicRemoteDeviceTable::Clear()
+{
+    nameHead_ = nullptr;
+    nameTail_ = nullptr;
+    index_.clear();
+    entries_.clear();
+}
+
+size_t ClassicRemoteDeviceTable::Size() const
+{
+    return entries_.size();
+}
+
+bool ClassicRemoteDeviceTable::UpdateEir(const uint8_t addr[BT_ADDRESS_SIZE], const std::vector<uint8_t> &eir)
+{
+    Entry *entry = FindEntry(MakeKey(addr));
+    if (entry == nullptr) {
+        return true;
+    }
+    size_t hash = std::hash<std::string_view>()(
+        std::string_view(reinterpret_cast<const char *>(eir.data()), eir.size()));
+    if (entry->hasEirHash && (entry->eirHash == hash)) {
+        return false;
+    }
+    entry->eirHash = hash;
+    entry->hasEirHash = true;
+    return true;
+}
+
+void ClassicRemoteDeviceTable::QueueNameRequest(const ClassicRemoteDevice &device)
+{
+    Entry *entry = FindEntry(MakeKey(device.GetAddress()));
+    if ((entry == nullptr) || entry->nameQueued) {
+        return;
+    }
+    entry->nameQueued = true;
+    entry->namePrev = nameTail_;
+    entry->nameNext = nullptr;
+    if (nameTail_ != nullptr) {
+        nameTail_->nameNext = entry;
+    } else {
+        nameHead_ = entry;
+    }
+    nameTail_ = entry;
+}
+
+int ClassicRemoteDeviceTable::NameRequestRssi(const ClassicRemoteDevice &device)
+{
+    /// Plain inquiry results carry no RSSI, order those after every measured one.
+    int rssi = device.GetRssi();
+    return (rssi == INVALID_VALUE) ? std::numeric_limits<int>::min() : rssi;
+}
+
+std::shared_ptr<ClassicRemoteDevice> ClassicRemoteDeviceTable::PopNameRequest()
+{
+    Entry *best = nullptr;
+    int bestRssi = std::numeric_limits<int>::min();
+    Entry *entry = nameHead_;
+    while (entry != nullptr) {
+        Entry *next = entry->nameNext;
+        if (!entry->device->GetNameNeedGet()) {
+            UnlinkNameRequest(*entry);
+        } else if ((best == nullptr) || (NameRequestRssi(*entry->device) > bestRssi)) {
+            best = entry;
+            bestRssi = NameRequestRssi(*entry->device);
+        }
+        entry = next;
+    }
+    if (best == nullptr) {
+        return nullptr;
+    }
+    UnlinkNameRequest(*best);
+    return best->device;
+}
+
+void ClassicRemoteDeviceTable::UnlinkNameRequest(Entry &entry)
+{
+    if (!entry.nameQueued) {
+        return;
+    }
+    if (entry.namePrev != nullptr) {
+        entry.namePrev->nameNext = entry.nameNext;
+    } else {
+        nameHead_ = entry.nameNext;
+    }
+    if (entry.nameNext != nullptr) {
+        entry.nameNext->namePrev = entry.namePrev;
+    } else {
+        nameTail_ = entry.namePrev;
+    }
+    entry.namePrev = nullptr;
+    entry.nameNext = nullptr;
+    entry.nameQueued = false;
+}
+}  // namespace bluetooth
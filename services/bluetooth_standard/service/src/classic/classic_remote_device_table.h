@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @addtogroup Bluetooth
+ * @{
+ *
+ * @brief Defines the table of remote devices known by the classic adapter.
+ *
+ */
+
+/**
+ * @file classic_remote_device_table.h
+ *
+ * @brief Classic remote device table class.
+ *
+ */
+
+#ifndef CLASSIC_REMOTE_DEVICE_TABLE_H
+#define CLASSIC_REMOTE_DEVICE_TABLE_H
+
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base_def.h"
+#include "btstack.h"
+#include "classic_remote_device.h"
+
+namespace bluetooth {
+/**
+ * @brief Remote devices keyed by the 48-bit address.
+ *
+ * Devices are kept in least recently used order. When the table is full, the least recently used device
+ * that is neither paired, pairing nor connected is dropped. Devices waiting for a remote name request are
+ * linked into a list through their table entries.
+ *
+ * Not thread safe, callers hold the adapter lock.
+ */
+class ClassicRemoteDeviceTable {
+private:
+    struct Entry {
+        uint64_t key {};
+        std::shared_ptr<ClassicRemoteDevice> device {};
+        size_t eirHash {};
+        bool hasEirHash {false};
+        bool nameQueued {false};
+        Entry *namePrev {nullptr};
+        Entry *nameNext {nullptr};
+    };
+    using EntryList = std::list<Entry>;
+
+public:
+    /**
+     * @brief Iterates the devices from the most to the least recently used.
+     *
+     */
+    class ConstIterator {
+    public:
+        explicit ConstIterator(EntryList::const_iterator it) : it_(it)
+        {}
+        const std::shared_ptr<ClassicRemoteDevice> &operator*() const
+        {
+            return it_->device;
+        }
+        ConstIterator &operator++()
+        {
+            ++it_;
+            return *this;
+        }
+        bool operator!=(const ConstIterator &other) const
+        {
+            return it_ != other.it_;
+        }
+
+    private:
+        EntryList::const_iterator it_;
+    };
+
+    /**
+     * @brief A constructor used to create a <b>ClassicRemoteDeviceTable</b> instance.
+     *
+     * @param capacity Number of devices above which unused ones are dropped.
+     */
+    explicit ClassicRemoteDeviceTable(size_t capacity);
+
+    /**
+     * @brief A destructor used to delete the <b>ClassicRemoteDeviceTable</b> instance.
+     *
+     */
+    ~ClassicRemoteDeviceTable();
+
+    /**
+     * @brief Find a device.
+     *
+     * @param addr Device address in "XX:XX:XX:XX:XX:XX" format.
+     * @return Returns the device, or nullptr if not found.
+     */
+    std::shared_ptr<ClassicRemoteDevice> Find(const std::string &addr) const;
+
+    /**
+     * @brief Find a device, creating it if not found. Marks the device as most recently used.
+     *
+     * @param addr Device address in the stack byte order.
+     * @return Returns the device.
+     */
+    std::shared_ptr<ClassicRemoteDevice> FindOrCreate(const uint8_t addr[BT_ADDRESS_SIZE]);
+
+    /**
+     * @brief Find a device, creating it if not found. Marks the device as most recently used.
+     *
+     * @param addr Device address in "XX:XX:XX:XX:XX:XX" format.
+     * @return Returns the device.
+     */
+    std::shared_ptr<ClassicRemoteDevice> FindOrCreate(const std::string &addr);
+
+    /**
+     * @brief Add a device, replacing any device with the same address.
+     *
+     * @param device Remote device.
+     */
+    void Insert(const std::shared_ptr<ClassicRemoteDevice> &device);
+
+    /**
+     * @brief Remove all devices.
+     *
+     */
+    void Clear();
+
+    /**
+     * @brief Get the number of devices.
+     *
+     * @return Returns the number of devices.
+     */
+    size_t Size() const;
+
+    /**
+     * @brief Check whether the EIR of a device differs from the one seen last time, and remember it.
+     *
+     * @param addr Device address in the stack byte order.
+     * @param eir Extended inquiry response data.
+     * @return Returns <b>true</b> if the EIR needs parsing;
+     *         returns <b>false</b> if it hashes the same as last time.
+     */
+    bool UpdateEir(const uint8_t addr[BT_ADDRESS_SIZE], const std::vector<uint8_t> &eir);
+
+    /**
+     * @brief Queue a device for a remote name request. A device is queued at most once.
+     *
+     * @param device Remote device.
+     */
+    void QueueNameRequest(const ClassicRemoteDevice &device);
+
+    /**
+     * @brief Take the queued device with the strongest RSSI that still needs its name.
+     *
+     * @return Returns the device, or nullptr if none is waiting.
+     */
+    std::shared_ptr<ClassicRemoteDevice> PopNameRequest();
+
+    ConstIterator begin() const
+    {
+        return ConstIterator(entries_.cbegin());
+    }
+    ConstIterator end() const
+    {
+        return ConstIterator(entries_.cend());
+    }
+
+    static uint64_t MakeKey(const uint8_t addr[BT_ADDRESS_SIZE]);
+    static uint64_t MakeKey(const std::string &addr);
+
+private:
+    Entry *FindEntry(uint64_t key) const;
+    Entry &CreateEntry(uint64_t key, const std::shared_ptr<ClassicRemoteDevice> &device);
+    void Touch(Entry &entry);
+    void Erase(EntryList::iterator it);
+    void EvictIfFull();
+    void UnlinkNameRequest(Entry &entry);
+    static bool IsEvictable(const ClassicRemoteDevice &device);
+    static int NameRequestRssi(const ClassicRemoteDevice &device);
+
+    size_t capacity_ {};
+    EntryList entries_ {};
+    std::unordered_map<uint64_t, EntryList::iterator> index_ {};
+    Entry *nameHead_ {nullptr};
+    Entry *nameTail_ {nullptr};
+
+    DISALLOW_COPY_AND_ASSIGN(ClassicRemoteDeviceTable);
+};
+}  // namespace bluetooth
+
+#endif  // CLASSIC_REMOTE_DEVICE_TABLE_H
@@ -0,0 +1,260 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "classic_remote_name_resolver.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "adapter_config.h"
+#include "classic_config.h"
+#include "gap_if.h"
+#include "log.h"
+#include "raw_address.h"
+
+namespace bluetooth {
+ClassicRemoteNameResolver::ClassicRemoteNameResolver(ClassicRemoteDeviceTable &devices, const TimeoutCallback &timeout)
+    : devices_(devices), timeout_(timeout)
+{}
+
+ClassicRemoteNameResolver::~ClassicRemoteNameResolver()
+{}
+
+void ClassicRemoteNameResolver::Initialize()
+{
+    int maxRequests = DEFAULT_REMOTE_NAME_REQUESTS;
+    if (!AdapterConfig::GetInstance()->GetValue(SECTION_CLASSIC_ADAPTER, PROPERTY_REMOTE_NAME_REQUESTS, maxRequests)) {
+        LOG_INFO("[ClassicRemoteNameResolver]::%{public}s use default request limit", __func__);
+    }
+    maxRequests_ = std::clamp(maxRequests, 1, GAP_REMOTE_NAME_REQUEST_MAX);
+
+    LoadCache();
+}
+
+void ClassicRemoteNameResolver::Reset()
+{
+    requests_.clear();
+    SaveCache();
+}
+
+int64_t ClassicRemoteNameResolver::Now()
+{
+    return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+void ClassicRemoteNameResolver::LoadCache()
+{
+    ClassicConfig &config = ClassicConfig::GetInstance();
+    int64_t now = Now();
+    cache_.clear();
+    for (auto &addr : config.GetNameCacheAddrList()) {
+        CacheEntry entry;
+        if (config.GetCachedRemoteName(addr, entry.name, entry.updateTime) &&
+            (now - entry.updateTime < REMOTE_NAME_CACHE_TTL_SEC) && (entry.updateTime <= now)) {
+            cache_[addr] = entry;
+        } else {
+            config.RemoveCachedRemoteName(addr);
+            cacheChanged_ = true;
+        }
+    }
+    LOG_DEBUG("[ClassicRemoteNameResolver]::%{public}s %{public}d names", __func__, static_cast<int>(cache_.size()));
+}
+
+bool ClassicRemoteNameResolver::GetCachedName(const std::string &addr, std::string &name) const
+{
+    auto it = cache_.find(addr);
+    if ((it == cache_.end()) || (Now() - it->second.updateTime >= REMOTE_NAME_CACHE_TTL_SEC)) {
+        return false;
+    }
+
+    name = it->second.name;
+    return true;
+}
+
+void ClassicRemoteNameResolver::UpdateCachedName(const std::string &addr, const std::string &name)
+{
+    if (name.empty()) {
+        return;
+    }
+
+    ClassicConfig &config = ClassicConfig::GetInstance();
+    if ((cache_.find(addr) == cache_.end()) && (cache_.size() >= static_cast<size_t>(REMOTE_NAME_CACHE_CAPACITY))) {
+        auto oldest = std::min_element(cache_.begin(), cache_.end(), [](const auto &a, const auto &b) {
+            return a.second.updateTime < b.second.updateTime;
+        });
+        config.RemoveCachedRemoteName(oldest->first);
+        cache_.erase(oldest);
+    }
+
+    CacheEntry &entry = cache_[addr];
+    entry.name = name;
+    entry.updateTime = Now();
+    config.SetCachedRemoteName(addr, entry.name, entry.updateTime);
+    cacheChanged_ = true;
+}
+
+void ClassicRemoteNameResolver::SaveCache()
+{
+    if (!cacheChanged_) {
+        return;
+    }
+
+    ClassicConfig::GetInstance().Save();
+    cacheChanged_ = false;
+}
+
+std::vector<ClassicRemoteNameResolver::NameRequest>::iterator ClassicRemoteNameResolver::FindRequest(
+    const std::string &addr)
+{
+    return std::find_if(
+        requests_.begin(), requests_.end(), [&addr](const NameRequest &request) { return request.addr == addr; });
+}
+
+int ClassicRemoteNameResolver::Start(const std::string &addr)
+{
+    BtAddr btAddr;
+    RawAddress(addr).ConvertToUint8(btAddr.addr);
+    btAddr.type = BT_PUBLIC_DEVICE_ADDRESS;
+    int ret = GAPIF_GetRemoteName(&btAddr);
+    if (ret != BT_NO_ERROR) {
+        LOG_WARN("[ClassicRemoteNameResolver]::%{public}s %{public}s failed: %{public}d", __func__, addr.c_str(), ret);
+        return ret;
+    }
+
+    NameRequest request;
+    request.addr = addr;
+    request.timer = std::make_unique<utility::Timer>(std::bind(timeout_, addr));
+    request.timer->Start(REMOTE_NAME_REQUEST_TIMEOUT_MS);
+    requests_.push_back(std::move(request));
+    return ret;
+}
+
+bool ClassicRemoteNameResolver::Cancel(NameRequest &request)
+{
+    BtAddr btAddr;
+    RawAddress(request.addr).ConvertToUint8(btAddr.addr);
+    btAddr.type = BT_PUBLIC_DEVICE_ADDRESS;
+    request.canceling = true;
+    bool ret = (GAPIF_GetRemoteNameCancel(&btAddr) == BT_NO_ERROR);
+    if (!ret) {
+        LOG_WARN("[ClassicRemoteNameResolver]::%{public}s %{public}s failed", __func__, request.addr.c_str());
+    }
+
+    return ret;
+}
+
+void ClassicRemoteNameResolver::Requeue(const std::string &addr)
+{
+    std::shared_ptr<ClassicRemoteDevice> remoteDevice = devices_.Find(addr);
+    if (remoteDevice != nullptr) {
+        remoteDevice->SetNameNeedGet(true);
+        devices_.QueueNameRequest(*remoteDevice);
+    }
+}
+
+bool ClassicRemoteNameResolver::Request(const std::string &addr)
+{
+    if (FindRequest(addr) != requests_.end()) {
+        return true;
+    }
+
+    return (Start(addr) == BT_NO_ERROR);
+}
+
+bool ClassicRemoteNameResolver::Schedule()
+{
+    while (static_cast<int>(requests_.size()) < maxRequests_) {
+        std::shared_ptr<ClassicRemoteDevice> remoteDevice = devices_.PopNameRequest();
+        if (remoteDevice == nullptr) {
+            break;
+        }
+
+        remoteDevice->SetNameNeedGet(false);
+        std::string addr = remoteDevice->GetAddress();
+        if (FindRequest(addr) != requests_.end()) {
+            continue;
+        }
+        if (Start(addr) == GAP_ERR_OUT_OF_RES) {
+            /// Requests given up on still hold a slot in GAP until the controller completes them.
+            Requeue(addr);
+            break;
+        }
+    }
+
+    return !requests_.empty();
+}
+
+void ClassicRemoteNameResolver::Complete(const std::string &addr, uint8_t status)
+{
+    auto it = FindRequest(addr);
+    if (it == requests_.end()) {
+        return;
+    }
+    bool canceling = it->canceling;
+    requests_.erase(it);
+
+    switch (status) {
+        case REMOTE_NAME_STATUS_PAGE_TIMEOUT:
+            LOG_INFO("[ClassicRemoteNameResolver]::%{public}s %{public}s page timeout", __func__, addr.c_str());
+            break;
+        case REMOTE_NAME_STATUS_MEMORY_CAPACITY_EXCEEDED:
+        case REMOTE_NAME_STATUS_CONNECTION_LIMIT_EXCEEDED:
+        case REMOTE_NAME_STATUS_COMMAND_DISALLOWED:
+            /// The controller cannot page this many devices at once, stay below what it accepted.
+            maxRequests_ = std::max(1, static_cast<int>(requests_.size()));
+            LOG_INFO("[ClassicRemoteNameResolver]::%{public}s status 0x%{public}02x, request limit %{public}d",
+                __func__, status, maxRequests_);
+            if (!canceling) {
+                Requeue(addr);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+bool ClassicRemoteNameResolver::Timeout(const std::string &addr)
+{
+    auto it = FindRequest(addr);
+    if (it == requests_.end()) {
+        return false;
+    }
+
+    if (!it->canceling) {
+        LOG_INFO("[ClassicRemoteNameResolver]::%{public}s cancel %{public}s", __func__, addr.c_str());
+        Cancel(*it);
+        it->timer->Start(REMOTE_NAME_REQUEST_TIMEOUT_MS);
+        return false;
+    }
+
+    LOG_WARN("[ClassicRemoteNameResolver]::%{public}s give up %{public}s", __func__, addr.c_str());
+    requests_.erase(it);
+    return true;
+}
+
+bool ClassicRemoteNameResolver::CancelAll()
+{
+    bool ret = true;
+    for (auto &request : requests_) {
+        if (!request.canceling) {
+            ret &= Cancel(request);
+        }
+    }
+    requests_.clear();
+
+    return ret;
+}
+}  // namespace bluetooth
@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @addtogroup Bluetooth
+ * @{
+ *
+ * @brief Defines the remote name resolution used by the classic adapter.
+ *
+ */
+
+/**
+ * @file classic_remote_name_resolver.h
+ *
+ * @brief Classic remote name resolver class.
+ *
+ */
+
+#ifndef CLASSIC_REMOTE_NAME_RESOLVER_H
+#define CLASSIC_REMOTE_NAME_RESOLVER_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base_def.h"
+#include "classic_defs.h"
+#include "classic_remote_device_table.h"
+#include "timer.h"
+
+namespace bluetooth {
+/**
+ * @brief Issues Remote Name Requests and caches the names read.
+ *
+ * Several requests run at once, up to a configured limit that is lowered when the controller refuses a
+ * request for lack of resources. Queued devices are taken strongest RSSI first. Each request is cancelled
+ * if it has not completed in time. Names read are cached with a time to live and kept in the device
+ * config file, so devices seen again are not queried.
+ *
+ * Not thread safe, callers hold the adapter lock. The timeout callback runs on a timer thread.
+ */
+class ClassicRemoteNameResolver {
+public:
+    using TimeoutCallback = std::function<void(const std::string &addr)>;
+
+    /**
+     * @brief A constructor used to create a <b>ClassicRemoteNameResolver</b> instance.
+     *
+     * @param devices Devices whose name requests are queued.
+     * @param timeout Called on a timer thread when a request times out.
+     */
+    ClassicRemoteNameResolver(ClassicRemoteDeviceTable &devices, const TimeoutCallback &timeout);
+
+    /**
+     * @brief A destructor used to delete the <b>ClassicRemoteNameResolver</b> instance.
+     *
+     */
+    ~ClassicRemoteNameResolver();
+
+    /**
+     * @brief Read the request limit and load the name cache.
+     *
+     */
+    void Initialize();
+
+    /**
+     * @brief Drop all requests without cancelling them, and save the name cache.
+     *
+     */
+    void Reset();
+
+    /**
+     * @brief Get a cached device name that has not expired.
+     *
+     * @param addr Device address.
+     * @param name Cached device name.
+     * @return Returns <b>true</b> if the name is cached;
+     *         returns <b>false</b> if it is not cached or has expired.
+     */
+    bool GetCachedName(const std::string &addr, std::string &name) const;
+
+    /**
+     * @brief Cache a device name read from the device.
+     *
+     * @param addr Device address.
+     * @param name Device name.
+     */
+    void UpdateCachedName(const std::string &addr, const std::string &name);
+
+    /**
+     * @brief Write the name cache to the device config file if it changed.
+     *
+     */
+    void SaveCache();
+
+    /**
+     * @brief Request the name of one device now, regardless of the request limit.
+     *
+     * @param addr Device address.
+     * @return Returns <b>true</b> if the operation is successful;
+     *         returns <b>false</b> if the operation fails.
+     */
+    bool Request(const std::string &addr);
+
+    /**
+     * @brief Start requests for queued devices until the request limit is reached.
+     *
+     * @return Returns <b>true</b> if any request is outstanding;
+     *         returns <b>false</b> if there is nothing left to resolve.
+     */
+    bool Schedule();
+
+    /**
+     * @brief Handle the completion of a request.
+     *
+     * @param addr Device address.
+     * @param status HCI status of the request.
+     */
+    void Complete(const std::string &addr, uint8_t status);
+
+    /**
+     * @brief Handle a request timeout. The first timeout cancels the request, the second gives it up.
+     *
+     * @param addr Device address.
+     * @return Returns <b>true</b> if the request was given up;
+     *         returns <b>false</b> if it is still outstanding.
+     */
+    bool Timeout(const std::string &addr);
+
+    /**
+     * @brief Cancel all outstanding requests.
+     *
+     * @return Returns <b>true</b> if the operation is successful;
+     *         returns <b>false</b> if the operation fails.
+     */
+    bool CancelAll();
+
+private:
+    struct NameRequest {
+        std::string addr {};
+        std::unique_ptr<utility::Timer> timer {};
+        bool canceling {false};
+    };
+
+    struct CacheEntry {
+        std::string name {};
+        int64_t updateTime {};
+    };
+
+    std::vector<NameRequest>::iterator FindRequest(const std::string &addr);
+    int Start(const std::string &addr);
+    bool Cancel(NameRequest &request);
+    void Requeue(const std::string &addr);
+    void LoadCache();
+    static int64_t Now();
+
+    ClassicRemoteDeviceTable &devices_;
+    TimeoutCallback timeout_ {};
+    int maxRequests_ {DEFAULT_REMOTE_NAME_REQUESTS};
+    std::vector<NameRequest> requests_ {};
+    std::unordered_map<std::string, CacheEntry> cache_ {};
+    bool cacheChanged_ {false};
+
+    DISALLOW_COPY_AND_ASSIGN(ClassicRemoteNameResolver);
+};
+}  // namespace bluetooth
+
+#endif  // CLASSIC_REMOTE_NAME_RESOLVER_H
@@ -55,6 +55,7 @@ const std::string PROPERTY_BLE_ADAPTER_ENABLE = "BleAdapterEnable";
 const std::string PROPERTY_SERVICE_ENABLE = "ServiceEnable";
 const std::string PROPERTY_MAX_CONNECTED_DEVICES = "MaxConnectedDevices";
 const std::string PROPERTY_MAP_VERSION = "Version";
+const std::string PROPERTY_REMOTE_NAME_REQUESTS = "RemoteNameRequests";
 
 const std::string PROPERTY_GATT_CLIENT_SERVICE = "GattClientService";
 const std::string PROPERTY_GATT_SERVER_SERVICE = "GattServerService";
@@ -15,21 +15,703 @@
 
 #include "adapter_device_config.h"
 
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
 #include <fstream>
+#include <map>
+#include <sstream>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <variant>
 
+#include "dispatcher.h"
 #include "log.h"
 #include "xml_parse.h"
 
 namespace bluetooth {
+namespace {
+/// Journal and snapshot share one record format:
+/// file   := magic(4) version(4) sequence(8) record*
+/// record := length(4) checksum(4) payload
+/// payload:= op(1) sequence(8) section subSection property [type(1) value]
+constexpr uint32_t STORE_MAGIC = 0x47464344;
+constexpr uint32_t STORE_VERSION = 1;
+constexpr size_t STORE_HEADER_SIZE = 16;
+constexpr size_t RECORD_HEADER_SIZE = 8;
+constexpr uint8_t RECORD_OP_SET = 1;
+constexpr uint8_t RECORD_OP_REMOVE_SECTION = 2;
+constexpr uint8_t VALUE_TYPE_INT = 0;
+constexpr uint8_t VALUE_TYPE_BOOL = 1;
+constexpr uint8_t VALUE_TYPE_STRING = 2;
+constexpr uint32_t FNV_OFFSET_BASIS = 2166136261U;
+constexpr uint32_t FNV_PRIME = 16777619U;
+constexpr int BYTE_BITS = 8;
+constexpr int HEX_BUFFER_SIZE = 16;
+/// Buffered journal records are written once they exceed this size even without Save().
+constexpr size_t JOURNAL_FLUSH_SIZE = 4 * 1024;
+/// A compaction is scheduled once the journal outgrows both this size and the last snapshot.
+constexpr size_t JOURNAL_COMPACT_SIZE = 64 * 1024;
+
+/// Values set through the typed API keep their type; values imported from XML stay raw strings and are converted
+/// with the XmlParse rules ("0x" hex for int, "true"/"false" for bool) when read.
+using ConfigValue = std::variant<int, bool, std::string>;
+using PropertyMap = std::unordered_map<std::string, ConfigValue>;
+/// The section level properties are stored under the empty subsection name.
+using SectionMap = std::unordered_map<std::string, PropertyMap>;
+
+bool ConvertValue(const ConfigValue &configValue, int &value)
+{
+    if (std::holds_alternative<int>(configValue)) {
+        value = std::get<int>(configValue);
+        return true;
+    }
+    if (!std::holds_alternative<std::string>(configValue)) {
+        return false;
+    }
+    const std::string &str = std::get<std::string>(configValue);
+    if (str.size() <= SIZEOF_0X) {
+        return false;
+    }
+    char *end = nullptr;
+    unsigned long result = std::strtoul(str.c_str() + SIZEOF_0X, &end, BASE_16);
+    if ((end == nullptr) || (*end != '\0')) {
+        return false;
+    }
+    value = static_cast<int>(result);
+    return true;
+}
+
+bool ConvertValue(const ConfigValue &configValue, std::string &value)
+{
+    if (std::holds_alternative<std::string>(configValue)) {
+        value = std::get<std::string>(configValue);
+    } else if (std::holds_alternative<bool>(configValue)) {
+        value = std::get<bool>(configValue) ? "true" : "false";
+    } else {
+        char buf[HEX_BUFFER_SIZE] = {0};
+        (void)snprintf(buf, sizeof(buf), "0x%X", static_cast<unsigned int>(std::get<int>(configValue)));
+        value = buf;
+    }
+    return true;
+}
+
+bool ConvertValue(const ConfigValue &configValue, bool &value)
+{
+    if (std::holds_alternative<bool>(configValue)) {
+        value = std::get<bool>(configValue);
+        return true;
+    }
+    if (!std::holds_alternative<std::string>(configValue)) {
+        return false;
+    }
+    const std::string &str = std::get<std::string>(configValue);
+    if (str == "true") {
+        value = true;
+    } else if (str == "false") {
+        value = false;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+uint32_t Checksum(const uint8_t *data, size_t len)
+{
+    uint32_t hash = FNV_OFFSET_BASIS;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= data[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+template<typename T>
+void PutUint(std::string &buf, T value)
+{
+    for (size_t i = 0; i < sizeof(T); i++) {
+        buf.push_back(static_cast<char>((value >> (i * BYTE_BITS)) & 0xFF));
+    }
+}
+
+template<typename T>
+void PutString(std::string &buf, const std::string &str)
+{
+    PutUint<T>(buf, static_cast<T>(str.size()));
+    buf.append(str);
+}
+
+class RecordReader {
+public:
+    RecordReader(const uint8_t *data, size_t len) : data_(data), len_(len)
+    {}
+
+    template<typename T>
+    bool GetUint(T &value)
+    {
+        if (len_ - pos_ < sizeof(T)) {
+            return false;
+        }
+        value = 0;
+        for (size_t i = 0; i < sizeof(T); i++) {
+            value |= static_cast<T>(data_[pos_ + i]) << (i * BYTE_BITS);
+        }
+        pos_ += sizeof(T);
+        return true;
+    }
+
+    template<typename T>
+    bool GetString(std::string &str)
+    {
+        T size = 0;
+        if (!GetUint(size) || (len_ - pos_ < size)) {
+            return false;
+        }
+        str.assign(reinterpret_cast<const char *>(data_ + pos_), size);
+        pos_ += size;
+        return true;
+    }
+
+private:
+    const uint8_t *data_ {nullptr};
+    size_t len_ {0};
+    size_t pos_ {0};
+};
+}  // namespace
+
 AdapterDeviceConfig *AdapterDeviceConfig::g_instance = nullptr;
 
 struct AdapterDeviceConfig::impl {
-    utility::XmlParse parse_ {};
+    explicit impl(std::mutex &mutex) : mutex_(mutex)
+    {}
+    ~impl();
+
+    bool Load();
+    bool Reload();
+    bool Save();
+    bool CopyBaseFile() const;
+
+    template<typename T>
+    bool GetValue(const std::string &section, const std::string &subSection, const std::string &property, T &value);
+    template<typename T>
+    bool SetValue(const std::string &section, const std::string &subSection, const std::string &property, T value);
+    bool GetSubSections(const std::string &section, std::vector<std::string> &subSections) const;
+    bool RemoveSection(const std::string &section, const std::string &subSection);
+
+    void Clear();
+    bool ImportXml();
+    bool ReplayFile(const std::string &path, bool isSnapshot, size_t &records);
+    bool ApplyRecord(const uint8_t *payload, size_t len, bool isSnapshot);
+    void AppendRecord(std::string &buf, uint8_t op, uint64_t sequence, const std::string &section,
+        const std::string &subSection, const std::string &property, const ConfigValue *value) const;
+    void Journal(uint8_t op, const std::string &section, const std::string &subSection, const std::string &property,
+        const ConfigValue *value);
+    std::string Serialize(uint64_t sequence) const;
+    bool WriteFile(const std::string &path, const std::string &content) const;
+    bool OpenJournal(bool truncate);
+    void CloseJournal();
+    bool FlushJournal(bool sync);
+    bool Checkpoint();
+    void ScheduleCompaction();
+    void Compact();
+
+    std::mutex &mutex_;
+    std::unordered_map<std::string, SectionMap> sections_ {};
     std::string fileName_ {"bt_device_config.xml"};
     std::string filePath_ {BT_CONFIG_PATH + fileName_};
     std::string fileBasePath_ {BT_CONFIG_PATH_BASE + fileName_};
+    std::string snapshotPath_ {BT_CONFIG_PATH + "bt_device_config.db"};
+    std::string journalPath_ {BT_CONFIG_PATH + "bt_device_config.journal"};
+    int journalFd_ {-1};
+    std::string journalBuffer_ {};
+    size_t journalSize_ {0};
+    size_t snapshotSize_ {0};
+    uint64_t sequence_ {0};
+    uint64_t snapshotSequence_ {0};
+    uint32_t generation_ {0};
+    bool compactPending_ {false};
+    utility::Dispatcher dispatcher_ {"bt-device-config"};
 };
 
+AdapterDeviceConfig::impl::~impl()
+{
+    dispatcher_.Uninitialize();
+    std::lock_guard<std::mutex> lg(mutex_);
+    FlushJournal(true);
+    CloseJournal();
+}
+
+bool AdapterDeviceConfig::impl::CopyBaseFile() const
+{
+    std::ifstream fin(fileBasePath_, std::ios::in | std::ios::binary);
+    if (!fin) {
+        return false;
+    }
+    std::ofstream fout(filePath_, std::ios::out | std::ios::trunc);
+    if (!fout) {
+        return false;
+    }
+    fout << fin.rdbuf();
+    return true;
+}
+
+void AdapterDeviceConfig::impl::Clear()
+{
+    generation_++;
+    sections_.clear();
+    journalBuffer_.clear();
+    sequence_ = 0;
+    snapshotSequence_ = 0;
+    snapshotSize_ = 0;
+}
+
+bool AdapterDeviceConfig::impl::ImportXml()
+{
+    utility::XmlParse parse;
+    if (!parse.Load(filePath_)) {
+        if (!CopyBaseFile() || !parse.Load(filePath_)) {
+            return false;
+        }
+    }
+
+    std::vector<std::string> sections;
+    parse.GetSections(sections);
+    for (auto &section : sections) {
+        std::vector<std::string> subSections;
+        parse.GetSubSections(section, subSections);
+        subSections.push_back("");
+        for (auto &subSection : subSections) {
+            std::map<std::string, std::string> properties;
+            parse.GetProperties(section, subSection, properties);
+            if (properties.empty()) {
+                continue;
+            }
+            PropertyMap &propertyMap = sections_[section][subSection];
+            for (auto &property : properties) {
+                propertyMap[property.first] = std::move(property.second);
+            }
+        }
+    }
+    LOG_INFO("%{public}s: imported %{public}zu sections from %{public}s",
+        __FUNCTION__, sections_.size(), filePath_.c_str());
+    return true;
+}
+
+bool AdapterDeviceConfig::impl::ApplyRecord(const uint8_t *payload, size_t len, bool isSnapshot)
+{
+    RecordReader reader(payload, len);
+    uint8_t op = 0;
+    uint64_t sequence = 0;
+    std::string section;
+    std::string subSection;
+    std::string property;
+    if (!reader.GetUint(op) || !reader.GetUint(sequence) || !reader.GetString<uint16_t>(section) ||
+        !reader.GetString<uint16_t>(subSection) || !reader.GetString<uint16_t>(property)) {
+        return false;
+    }
+
+    /// Journal records already covered by the snapshot are parsed but not applied again.
+    bool apply = isSnapshot || (sequence > snapshotSequence_);
+    if (op == RECORD_OP_REMOVE_SECTION) {
+        if (apply) {
+            auto it = sections_.find(section);
+            if (it != sections_.end()) {
+                it->second.erase(subSection);
+            }
+        }
+    } else if (op == RECORD_OP_SET) {
+        uint8_t type = 0;
+        ConfigValue value;
+        if (!reader.GetUint(type)) {
+            return false;
+        }
+        if (type == VALUE_TYPE_INT) {
+            uint32_t intValue = 0;
+            if (!reader.GetUint(intValue)) {
+                return false;
+            }
+            value = static_cast<int>(intValue);
+        } else if (type == VALUE_TYPE_BOOL) {
+            uint8_t boolValue = 0;
+            if (!reader.GetUint(boolValue)) {
+                return false;
+            }
+            value = (boolValue != 0);
+        } else {
+            std::string strValue;
+            if (!reader.GetString<uint32_t>(strValue)) {
+                return false;
+            }
+            value = std::move(strValue);
+        }
+        if (apply) {
+            sections_[section][subSection][property] = std::move(value);
+        }
+    } else {
+        return false;
+    }
+
+    if (sequence > sequence_) {
+        sequence_ = sequence;
+    }
+    return true;
+}
+
+bool AdapterDeviceConfig::impl::ReplayFile(const std::string &path, bool isSnapshot, size_t &records)
+{
+    records = 0;
+    std::ifstream fin(path, std::ios::in | std::ios::binary);
+    if (!fin) {
+        return false;
+    }
+    std::stringstream content;
+    content << fin.rdbuf();
+    std::string data = content.str();
+    const uint8_t *buf = reinterpret_cast<const uint8_t *>(data.data());
+
+    RecordReader header(buf, data.size());
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint64_t sequence = 0;
+    if (!header.GetUint(magic) || !header.GetUint(version) || !header.GetUint(sequence) ||
+        (magic != STORE_MAGIC) || (version != STORE_VERSION)) {
+        LOG_WARN("%{public}s: %{public}s has no valid header", __FUNCTION__, path.c_str());
+        return false;
+    }
+
+    size_t pos = STORE_HEADER_SIZE;
+    while (data.size() - pos >= RECORD_HEADER_SIZE) {
+        RecordReader recordHeader(buf + pos, RECORD_HEADER_SIZE);
+        uint32_t length = 0;
+        uint32_t checksum = 0;
+        recordHeader.GetUint(length);
+        recordHeader.GetUint(checksum);
+        const uint8_t *payload = buf + pos + RECORD_HEADER_SIZE;
+        if ((data.size() - pos - RECORD_HEADER_SIZE < length) || (Checksum(payload, length) != checksum)) {
+            break;
+        }
+        if (!ApplyRecord(payload, length, isSnapshot)) {
+            break;
+        }
+        pos += RECORD_HEADER_SIZE + length;
+        records++;
+    }
+
+    if (isSnapshot) {
+        snapshotSequence_ = sequence;
+        snapshotSize_ = data.size();
+        if (sequence > sequence_) {
+            sequence_ = sequence;
+        }
+    }
+    if (pos != data.size()) {
+        /// A torn tail is the expected result of a crash during an append, the records before it are kept.
+        LOG_WARN("%{public}s: %{public}s truncated at %{public}zu of %{public}zu bytes",
+            __FUNCTION__, path.c_str(), pos, data.size());
+        return false;
+    }
+    return true;
+}
+
+void AdapterDeviceConfig::impl::AppendRecord(std::string &buf, uint8_t op, uint64_t sequence,
+    const std::string &section, const std::string &subSection, const std::string &property,
+    const ConfigValue *value) const
+{
+    std::string payload;
+    PutUint<uint8_t>(payload, op);
+    PutUint<uint64_t>(payload, sequence);
+    PutString<uint16_t>(payload, section);
+    PutString<uint16_t>(payload, subSection);
+    PutString<uint16_t>(payload, property);
+    if (value != nullptr) {
+        if (std::holds_alternative<int>(*value)) {
+            PutUint<uint8_t>(payload, VALUE_TYPE_INT);
+            PutUint<uint32_t>(payload, static_cast<uint32_t>(std::get<int>(*value)));
+        } else if (std::holds_alternative<bool>(*value)) {
+            PutUint<uint8_t>(payload, VALUE_TYPE_BOOL);
+            PutUint<uint8_t>(payload, std::get<bool>(*value) ? 1 : 0);
+        } else {
+            PutUint<uint8_t>(payload, VALUE_TYPE_STRING);
+            PutString<uint32_t>(payload, std::get<std::string>(*value));
+        }
+    }
+
+    PutUint<uint32_t>(buf, static_cast<uint32_t>(payload.size()));
+    PutUint<uint32_t>(buf, Checksum(reinterpret_cast<const uint8_t *>(payload.data()), payload.size()));
+    buf.append(payload);
+}
+
+std::string AdapterDeviceConfig::impl::Serialize(uint64_t sequence) const
+{
+    std::string buf;
+    PutUint<uint32_t>(buf, STORE_MAGIC);
+    PutUint<uint32_t>(buf, STORE_VERSION);
+    PutUint<uint64_t>(buf, sequence);
+    for (auto &section : sections_) {
+        for (auto &subSection : section.second) {
+            for (auto &property : subSection.second) {
+                AppendRecord(buf, RECORD_OP_SET, 0, section.first, subSection.first, property.first, &property.second);
+            }
+        }
+    }
+    return buf;
+}
+
+bool AdapterDeviceConfig::impl::WriteFile(const std::string &path, const std::string &content) const
+{
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        LOG_ERROR("%{public}s: open %{public}s failed", __FUNCTION__, path.c_str());
+        return false;
+    }
+    size_t written = 0;
+    while (written < content.size()) {
+        ssize_t ret = write(fd, content.data() + written, content.size() - written);
+        if (ret <= 0) {
+            break;
+        }
+        written += static_cast<size_t>(ret);
+    }
+    bool result = (written == content.size()) && (fsync(fd) == 0);
+    close(fd);
+    if (!result) {
+        LOG_ERROR("%{public}s: write %{public}s failed", __FUNCTION__, path.c_str());
+    }
+    return result;
+}
+
+bool AdapterDeviceConfig::impl::OpenJournal(bool truncate)
+{
+    CloseJournal();
+    int flags = O_WRONLY | O_CREAT | O_APPEND | (truncate ? O_TRUNC : 0);
+    journalFd_ = open(journalPath_.c_str(), flags, S_IRUSR | S_IWUSR);
+    if (journalFd_ < 0) {
+        LOG_ERROR("%{public}s: open %{public}s failed", __FUNCTION__, journalPath_.c_str());
+        return false;
+    }
+    struct stat st = {};
+    if ((fstat(journalFd_, &st) == 0) && (st.st_size > 0)) {
+        journalSize_ = static_cast<size_t>(st.st_size);
+        return true;
+    }
+    std::string header;
+    PutUint<uint32_t>(header, STORE_MAGIC);
+    PutUint<uint32_t>(header, STORE_VERSION);
+    PutUint<uint64_t>(header, 0);
+    journalBuffer_.insert(0, header);
+    journalSize_ = 0;
+    return true;
+}
+
+void AdapterDeviceConfig::impl::CloseJournal()
+{
+    if (journalFd_ >= 0) {
+        close(journalFd_);
+        journalFd_ = -1;
+    }
+}
+
+bool AdapterDeviceConfig::impl::FlushJournal(bool sync)
+{
+    if (journalFd_ < 0) {
+        return false;
+    }
+    size_t written = 0;
+    while (written < journalBuffer_.size()) {
+        ssize_t ret = write(journalFd_, journalBuffer_.data() + written, journalBuffer_.size() - written);
+        if (ret <= 0) {
+            LOG_ERROR("%{public}s: write journal failed", __FUNCTION__);
+            journalBuffer_.erase(0, written);
+            journalSize_ += written;
+            return false;
+        }
+        written += static_cast<size_t>(ret);
+    }
+    journalSize_ += written;
+    journalBuffer_.clear();
+    return !sync || (fdatasync(journalFd_) == 0);
+}
+
+void AdapterDeviceConfig::impl::Journal(uint8_t op, const std::string &section, const std::string &subSection,
+    const std::string &property, const ConfigValue *value)
+{
+    AppendRecord(journalBuffer_, op, ++sequence_, section, subSection, property, value);
+    if (journalBuffer_.size() >= JOURNAL_FLUSH_SIZE) {
+        FlushJournal(false);
+    }
+}
+
+bool AdapterDeviceConfig::impl::Checkpoint()
+{
+    std::string snapshot = Serialize(sequence_);
+    std::string tmpPath = snapshotPath_ + ".tmp";
+    if (!WriteFile(tmpPath, snapshot) || (rename(tmpPath.c_str(), snapshotPath_.c_str()) != 0)) {
+        return false;
+    }
+    snapshotSequence_ = sequence_;
+    snapshotSize_ = snapshot.size();
+    journalBuffer_.clear();
+    return OpenJournal(true);
+}
+
+void AdapterDeviceConfig::impl::ScheduleCompaction()
+{
+    if (compactPending_ || (journalSize_ < JOURNAL_COMPACT_SIZE) || (journalSize_ < snapshotSize_)) {
+        return;
+    }
+    compactPending_ = true;
+    dispatcher_.PostTask(std::bind(&AdapterDeviceConfig::impl::Compact, this));
+}
+
+void AdapterDeviceConfig::impl::Compact()
+{
+    std::string snapshot;
+    uint64_t sequence = 0;
+    uint32_t generation = 0;
+    {
+        std::lock_guard<std::mutex> lg(mutex_);
+        compactPending_ = false;
+        if (sequence_ == snapshotSequence_) {
+            return;
+        }
+        sequence = sequence_;
+        generation = generation_;
+        snapshot = Serialize(sequence);
+    }
+
+    /// The snapshot is written without the lock held, so Get/Set are not blocked by fsync. Journal records appended
+    /// meanwhile carry a higher sequence and are replayed on top of it.
+    std::string tmpPath = snapshotPath_ + ".tmp";
+    if (!WriteFile(tmpPath, snapshot)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lg(mutex_);
+    if ((generation != generation_) || (rename(tmpPath.c_str(), snapshotPath_.c_str()) != 0)) {
+        remove(tmpPath.c_str());
+        return;
+    }
+    snapshotSequence_ = sequence;
+    snapshotSize_ = snapshot.size();
+    if (sequence == sequence_) {
+        journalBuffer_.clear();
+        OpenJournal(true);
+    }
+    LOG_DEBUG("%{public}s: snapshot %{public}zu bytes at sequence %{public}llu",
+        __FUNCTION__, snapshot.size(), static_cast<unsigned long long>(sequence));
+}
+
+bool AdapterDeviceConfig::impl::Load()
+{
+    Clear();
+    CloseJournal();
+    dispatcher_.Initialize();
+
+    size_t records = 0;
+    bool needCheckpoint = false;
+    if (!ReplayFile(snapshotPath_, true, records) && (records == 0)) {
+        /// No usable snapshot: this is the one-time migration from the XML document.
+        Clear();
+        if (!ImportXml()) {
+            return false;
+        }
+        needCheckpoint = true;
+    }
+    bool journalClean = ReplayFile(journalPath_, false, records);
+    if (records != 0) {
+        needCheckpoint = true;
+    }
+    if (!journalClean && (access(journalPath_.c_str(), F_OK) == 0)) {
+        /// New records must not be appended behind a torn tail.
+        needCheckpoint = true;
+    }
+
+    if (needCheckpoint) {
+        return Checkpoint();
+    }
+    return OpenJournal(false);
+}
+
+bool AdapterDeviceConfig::impl::Reload()
+{
+    if (!CopyBaseFile()) {
+        return false;
+    }
+    Clear();
+    CloseJournal();
+    remove(snapshotPath_.c_str());
+    remove(journalPath_.c_str());
+    if (!ImportXml()) {
+        return false;
+    }
+    return Checkpoint();
+}
+
+bool AdapterDeviceConfig::impl::Save()
+{
+    bool ret = FlushJournal(true);
+    ScheduleCompaction();
+    return ret;
+}
+
+template<typename T>
+bool AdapterDeviceConfig::impl::GetValue(
+    const std::string &section, const std::string &subSection, const std::string &property, T &value)
+{
+    auto sectionIt = sections_.find(section);
+    if (sectionIt == sections_.end()) {
+        return false;
+    }
+    auto subSectionIt = sectionIt->second.find(subSection);
+    if (subSectionIt == sectionIt->second.end()) {
+        return false;
+    }
+    auto propertyIt = subSectionIt->second.find(property);
+    if (propertyIt == subSectionIt->second.end()) {
+        return false;
+    }
+    return ConvertValue(propertyIt->second, value);
+}
+
+template<typename T>
+bool AdapterDeviceConfig::impl::SetValue(
+    const std::string &section, const std::string &subSection, const std::string &property, T value)
+{
+    ConfigValue &configValue = sections_[section][subSection][property];
+    if (std::holds_alternative<T>(configValue) && (std::get<T>(configValue) == value)) {
+        /// Repeated updates of an unchanged value (name, RSSI, ...) do not touch the journal.
+        return true;
+    }
+    configValue = std::move(value);
+    Journal(RECORD_OP_SET, section, subSection, property, &configValue);
+    return true;
+}
+
+bool AdapterDeviceConfig::impl::GetSubSections(const std::string &section, std::vector<std::string> &subSections) const
+{
+    auto sectionIt = sections_.find(section);
+    if (sectionIt == sections_.end()) {
+        return false;
+    }
+    for (auto &subSection : sectionIt->second) {
+        if (!subSection.first.empty()) {
+            subSections.push_back(subSection.first);
+        }
+    }
+    return (subSections.size() != 0);
+}
+
+bool AdapterDeviceConfig::impl::RemoveSection(const std::string &section, const std::string &subSection)
+{
+    auto sectionIt = sections_.find(section);
+    if ((sectionIt == sections_.end()) || (sectionIt->second.erase(subSection) == 0)) {
+        return false;
+    }
+    Journal(RECORD_OP_REMOVE_SECTION, section, subSection, "", nullptr);
+    return true;
+}
+
 IAdapterDeviceConfig *AdapterDeviceConfig::GetInstance()
 {
     if (g_instance == nullptr) {
@@ -40,7 +722,7 @@ IAdapterDeviceConfig *AdapterDeviceConfig::GetInstance()
     return static_cast<IAdapterDeviceConfig *>(g_instance);
 }
 
-AdapterDeviceConfig::AdapterDeviceConfig() : pimpl(std::make_unique<impl>()){};
+AdapterDeviceConfig::AdapterDeviceConfig() : pimpl(std::make_unique<impl>(mutex_)){};
 
 AdapterDeviceConfig::~AdapterDeviceConfig()
 {}
@@ -48,117 +730,102 @@ AdapterDeviceConfig::~AdapterDeviceConfig()
 bool AdapterDeviceConfig::Load()
 {
     std::lock_guard<std::mutex> lg(mutex_);
-    if (pimpl->parse_.Load(pimpl->filePath_)) {
-        return true;
-    } else {
-        if (!Reload()) {
-            return false;
-        }
-        return pimpl->parse_.Load(pimpl->filePath_);
-    }
+    return pimpl->Load();
 }
 
 bool AdapterDeviceConfig::Reload()
 {
-    std::ifstream fin(pimpl->fileBasePath_, std::ios::in | std::ios::binary);
-    if (!fin) {
-        return false;
-    }
-    std::ofstream fout(pimpl->filePath_, std::ios::out | std::ios::trunc);
-    if (!fout) {
-        return false;
-    }
-    fout << fin.rdbuf();
-    return true;
+    std::lock_guard<std::mutex> lg(mutex_);
+    return pimpl->Reload();
 }
 
 bool AdapterDeviceConfig::Save()
 {
     std::lock_guard<std::mutex> lg(mutex_);
-    return pimpl->parse_.Save();
+    return pimpl->Save();
 }
 
 bool AdapterDeviceConfig::SetValue(const std::string &section, const std::string &property, const int &value)
 {
     std::lock_guard<std::mutex> lg(mutex_);
-    return pimpl->parse_.SetValue(section, property, value);
+    return pimpl->SetValue(section, "", property, value);
 }
 
 bool AdapterDeviceConfig::SetValue(const std::string &section, const std::string &property, const std::string &value)
 {
     std::lock_guard<std::mutex> lg(mutex_);
-    return pimpl->parse_.SetValue(section, property, value);
+    return pimpl->SetValue(section, "", property, value);
 }
 
 bool AdapterDeviceConfig::GetValue(const std::string &section, const std::string &property, int &value)
 {
     std::lock_guard<std::mutex> lg(mutex_);
-    return pimpl->parse_.GetValue(section, property, value);
+    return pimpl->GetValue(section, "", property, value);
 }
 
 bool AdapterDeviceConfig::GetValue(const std::string &section, const std::string &property, std::string &value)
 {
     std::lock_guard<std::mutex> lg(mutex_);
 
-    return pimpl->parse_.GetValue(section, property, value);
+    return pimpl->GetValue(section, "", property, value);
 }
 
 bool AdapterDeviceConfig::GetValue(const std::string &section, const std::string &property, bool &value)
 {
     std::lock_guard<std::mutex> lg(mutex_);
-    return pimpl->parse_.GetValue(section, property, value);
+    return pimpl->GetValue(section, "", property, value);
 }
 
 bool AdapterDeviceConfig::SetValue(
     const std::string &section, const std::string &subSection, const std::string &property, const int &value)
 {
     std::lock_guard<std::mutex> lg(mutex_);
-    return pimpl->parse_.SetValue(section, subSection, property, value);
+    return pimpl->SetValue(section, subSection, property, value);
 }
 bool AdapterDeviceConfig::SetValue(
     const std::string &section, const std::string &subSection, const std::string &property, const std::string &value)
 {
     std::lock_guard<std::mutex> lg(mutex_);
-    return pimpl->parse_.SetValue(section, subSection, property, value);
+    return pimpl->SetValue(section, subSection, property, value);
 }
 
 bool AdapterDeviceConfig::SetValue(
     const std::string &section, const std::string &subSection, const std::string &property, const bool &value)
 {
     std::lock_guard<std::mutex> lg(mutex_);
-    return pimpl->parse_.SetValue(section, subSection, property, value);
+    return pimpl->SetValue(section, subSection, property, value);
 }
 
 bool AdapterDeviceConfig::GetValue(
     const std::string &section, const std::string &subSection, const std::string &property, int &value)
 {
     std::lock_guard<std::mutex> lg(mutex_);
-    return pimpl->parse_.GetValue(section, subSection, property, value);
+    return pimpl->GetValue(section, subSection, property, value);
 }
 
 bool AdapterDeviceConfig::GetValue(
     const std::string &section, const std::string &subSection, const std::string &property, std::string &value)
 {
     std::lock_guard<std::mutex> lg(mutex_);
-    return pimpl->parse_.GetValue(section, subSection, property, value);
+    return pimpl->GetValue(section, subSection, property, value);
 }
 
 bool AdapterDeviceConfig::GetValue(
     const std::string &section, const std::string &subSection, const std::string &property, bool &value)
 {
     std::lock_guard<std::mutex> lg(mutex_);
-    return pimpl->parse_.GetValue(section, subSection, property, value);
+    return pimpl->GetValue(section, subSection, property, value);
 }
 
 bool AdapterDeviceConfig::GetSubSections(const std::string &section, std::vector<std::string> &subSections)
 {
     std::lock_guard<std::mutex> lg(mutex_);
-    return pimpl->parse_.GetSubSections(section, subSections);
+    return pimpl->GetSubSections(section, subSections);
 }
 
 bool AdapterDeviceConfig::RemoveSection(const std::string &section, const std::string &subSection)
 {
     std::lock_guard<std::mutex> lg(mutex_);
-    return pimpl->parse_.RemoveSection(section, subSection);
+    return pimpl->RemoveSection(section, subSection);
 }
-}  // namespace bluetooth
\ No newline at end of file
+}  // namespace bluetooth
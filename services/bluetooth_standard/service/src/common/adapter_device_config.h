@@ -44,6 +44,7 @@ const std::string PROPERTY_PAIR_FLAG = "PairFlag";
 const std::string PROPERTY_BOND_FROM_LOCAL = "BondFromLocal";
 const std::string PROPERTY_URI = "uri";
 const std::string PROPERTY_REMOTE_UUIDS = "RemoteUuids";
+const std::string PROPERTY_NAME_UPDATE_TIME = "NameUpdateTime";
 
 const std::string PROPERTY_BLE_ROLES = "BleRoles";
 const std::string PROPERTY_BLE_MODE_1_LEVEL = "BleModel1Level";
@@ -80,6 +81,8 @@ const std::string SECTION_BLE_PAIRED_LIST = "Ble Paired Device List";
 
 const std::string SECTION_BREDR_PAIRED_LIST = "Classic Paired Device List";
 
+const std::string SECTION_BREDR_NAME_CACHE = "Classic Remote Name Cache";
+
 const std::string SECTION_GENERIC_ATTRIBUTE_SERVICE = "Generic Attribute Service";
 const std::string PROPERTY_GATT_TRANSPORT = "GattTransport";
 const std::string PROPERTY_GATTS_START_HANDLE = "GattsStartHandle";
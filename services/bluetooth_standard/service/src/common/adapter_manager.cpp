@@ -21,6 +21,7 @@
 #include "btm.h"
 #include "btstack.h"
 #include "log.h"
+#include "perf_counter.h"
 
 #include "adapter_config.h"
 #include "adapter_device_config.h"
@@ -37,6 +38,9 @@
 namespace bluetooth {
 // data define
 const int TRANSPORT_MAX = 2;
+const uint32_t PERCENTILE_MEDIAN = 50;
+const uint32_t PERCENTILE_TAIL = 99;
+const uint32_t PERCENTILE_MAX = 100;
 
 struct AdapterInfo {
     AdapterInfo(std::unique_ptr<IAdapter> instance, std::unique_ptr<AdapterStateMachine> stateMachine)
@@ -743,4 +747,28 @@ int AdapterManager::GetPowerMode(const std::string &address) const
     RawAddress addr = RawAddress(address);
     return static_cast<int>(IPowerManager::GetInstance().GetPowerMode(addr));
 }
+
+std::string AdapterManager::GetPerformanceCounters() const
+{
+    LOG_DEBUG("%{public}s start", __PRETTY_FUNCTION__);
+
+    PerfSnapshotData snapshot;
+    PerfSnapshot(&snapshot);
+
+    std::string result;
+    for (int id = 0; id < PERF_COUNTER_MAX; id++) {
+        result += PerfCounterName(static_cast<PerfCounterId>(id));
+        result += " " + std::to_string(snapshot.counters[id]) + "\n";
+    }
+    for (int id = 0; id < PERF_HISTOGRAM_MAX; id++) {
+        const PerfHistogramData &histogram = snapshot.histograms[id];
+        uint64_t mean = (histogram.count > 0) ? (histogram.sum / histogram.count) : 0;
+        result += PerfHistogramName(static_cast<PerfHistogramId>(id));
+        result += " count=" + std::to_string(histogram.count) + " mean=" + std::to_string(mean) +
+                  " p50<=" + std::to_string(PerfHistogramPercentile(&histogram, PERCENTILE_MEDIAN)) +
+                  " p99<=" + std::to_string(PerfHistogramPercentile(&histogram, PERCENTILE_TAIL)) +
+                  " max<=" + std::to_string(PerfHistogramPercentile(&histogram, PERCENTILE_MAX)) + "\n";
+    }
+    return result;
+}
 }  // namespace bluetooth
\ No newline at end of file
@@ -222,6 +222,15 @@ public:
      */
     int GetPowerMode(const std::string &address) const override;
 
+    /**
+     * @brief Get a snapshot of the stack performance counters and histograms.
+     *
+     * @return Returns one "name value" line per counter and one line per histogram with
+     *         its sample count, mean and approximate percentiles.
+     * @since 6
+     */
+    std::string GetPerformanceCounters() const override;
+
     /**
      * @brief Stop bluetooth adapter and profile service.
      *
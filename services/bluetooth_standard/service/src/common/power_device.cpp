@@ -14,13 +14,16 @@
  */
 
 #include "power_device.h"
+#include <chrono>
 #include <cstring>
 #include <memory>
 #include <mutex>
 #include "btm.h"
 #include "log.h"
 #include "message.h"
+#include "perf_counter.h"
 #include "power_state_machine.h"
+#include "power_traffic_policy.h"
 #include "securec.h"
 
 namespace bluetooth {
@@ -40,6 +43,8 @@ public:
     int controlInterval_ {};
     std::unique_ptr<PowerTimer> sniffDelayTimer_ = nullptr;
     std::mutex mutex_ {};
+    PowerTrafficPolicy trafficPolicy_ {};
+    std::chrono::steady_clock::time_point lastTrafficSample_ {};
 
     DISALLOW_COPY_AND_ASSIGN(impl);
 };
@@ -160,6 +165,57 @@ void PowerDevice::ModeChangeCallBack(uint8_t status, uint8_t currentMode, uint16
     }
 }
 
+void PowerDevice::SampleTraffic()
+{
+    BtAddr btAddr;
+    (void)memset_s(&btAddr, sizeof(btAddr), 0, sizeof(btAddr));
+    pimpl->rawAddr_.ConvertToUint8(btAddr.addr);
+
+    BtmAclTrafficStats stats;
+    if (BTM_GetAclTrafficStats(&btAddr, &stats) != BT_NO_ERROR) {
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    uint32_t elapsedMs = 0;
+    if (pimpl->lastTrafficSample_ != std::chrono::steady_clock::time_point()) {
+        elapsedMs = static_cast<uint32_t>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(now - pimpl->lastTrafficSample_).count());
+    }
+    pimpl->lastTrafficSample_ = now;
+
+    PowerTrafficDecision decision = pimpl->trafficPolicy_.Update(
+        stats.txBytes + stats.rxBytes, stats.txPackets + stats.rxPackets, stats.idleMs, elapsedMs);
+    switch (decision) {
+        case PowerTrafficDecision::ACTIVE:
+            LOG_DEBUG("PM_: %{public}s, link busy\n", __FUNCTION__);
+            PerfCounterAdd(PERF_COUNTER_PM_ACTIVE_DECISIONS, 1);
+            SetPowerMode();
+            break;
+        case PowerTrafficDecision::SNIFF:
+            LOG_DEBUG("PM_: %{public}s, link idle for %{public}u ms\n", __FUNCTION__, stats.idleMs);
+            PerfCounterAdd(PERF_COUNTER_PM_SNIFF_DECISIONS, 1);
+            /// The hold has been served, a delay started by a profile status update must not add to it.
+            StopDelayTimer();
+            SetPowerMode();
+            break;
+        case PowerTrafficDecision::HELD:
+            PerfCounterAdd(PERF_COUNTER_PM_SNIFF_HELD, 1);
+            break;
+        default:
+            break;
+    }
+}
+
+void PowerDevice::WakeForTraffic()
+{
+    if (pimpl->trafficPolicy_.Wake()) {
+        LOG_DEBUG("PM_: %{public}s, data to send\n", __FUNCTION__);
+        PerfCounterAdd(PERF_COUNTER_PM_ACTIVE_DECISIONS, 1);
+        SetPowerMode();
+    }
+}
+
 void PowerDevice::SniffSubratingCompleteCallback(uint8_t status) const
 {
     LOG_DEBUG("PM_: %{public}s, line: %{public}d\n", __FUNCTION__, __LINE__);
@@ -180,6 +236,18 @@ PowerInfo PowerDevice::CalcMaxPower() const
             maxPower = itSpec;
         }
     }
+
+    /// The traffic only tunes the power mode of the links some profile has an opinion on.
+    PowerInfo trafficPower = pimpl->trafficPolicy_.GetPowerInfo();
+    if ((maxPower.powerMode_ == PowerModeLevel::NO_ACTION) || (trafficPower.powerMode_ == PowerModeLevel::NO_ACTION)) {
+        return maxPower;
+    }
+    if (trafficPower.powerMode_ > maxPower.powerMode_) {
+        maxPower.powerMode_ = trafficPower.powerMode_;
+    }
+    if (maxPower.powerMode_ != PowerModeLevel::LEVEL_ACTIVE) {
+        maxPower.timeout_ = trafficPower.timeout_;
+    }
     return maxPower;
 }
 
@@ -192,6 +260,10 @@ PowerSsrLevel PowerDevice::CalcLowestSsrLevel() const
             lowestLevel = level;
         }
     }
+    PowerSsrLevel trafficLevel = pimpl->trafficPolicy_.GetSsrLevel();
+    if ((trafficLevel != PowerSsrLevel::NO_ACTION) && (trafficLevel < lowestLevel)) {
+        lowestLevel = trafficLevel;
+    }
     return lowestLevel;
 }
 
@@ -106,6 +106,20 @@ public:
      * @since 6
      */
     void SniffSubratingCompleteCallback(uint8_t status) const;
+
+    /**
+     * @brief Sample the ACL traffic of the link, and update the power mode on a decision of the traffic policy.
+     *
+     * @since 6
+     */
+    void SampleTraffic();
+
+    /**
+     * @brief Leave sniff mode at once for data about to be sent, the traffic policy releases the link again.
+     *
+     * @since 6
+     */
+    void WakeForTraffic();
 private:
     /**
      * @brief Send SetActiveMode message to power state machine.
@@ -123,14 +137,14 @@ private:
     void SetSniffMode(PowerInfo requestPower);
 
     /**
-     * @brief Calculate max power mode, base on current profiles and status.
+     * @brief Calculate max power mode, base on current profiles and status, raised by the traffic of the link.
      *
      * @since 6
      */
     PowerInfo CalcMaxPower() const;
 
     /**
-     * @brief Calculate lowest ssr level, base on current profiles and status.
+     * @brief Calculate lowest ssr level, base on current profiles and status, and the traffic of the link.
      *
      * @since 6
      */
@@ -18,11 +18,13 @@
 #include <list>
 #include <map>
 #include <mutex>
+#include <set>
 #include <string>
 #include "adapter_manager.h"
 #include "btm.h"
 #include "log.h"
 #include "power_device.h"
+#include "power_traffic_policy.h"
 #include "timer.h"
 
 namespace bluetooth {
@@ -64,11 +66,16 @@ void PowerManager::Uninitialize()
 /// PowerManager class
 struct PowerManager::impl {
 public:
-    explicit impl(utility::Dispatcher &dispatcher) : dispatcher_(dispatcher)
+    explicit impl(utility::Dispatcher &dispatcher)
+        : dispatcher_(dispatcher),
+          trafficTimer_(std::make_unique<utility::Timer>(std::bind(&PowerManager::impl::TrafficTimeout, this)))
     {
         LOG_DEBUG("PM_: impl %{public}s start, line: %{public}d\n", __FUNCTION__, __LINE__);
     };
-    ~impl(){};
+    ~impl()
+    {
+        trafficTimer_->Stop();
+    };
 
     std::mutex mutex_ {};
     std::atomic_bool isEnabled_ = false;
@@ -77,6 +84,16 @@ public:
     utility::Dispatcher &dispatcher_;
     std::map<RawAddress, std::shared_ptr<PowerDevice>> powerDevices_ {};
     std::map<uint16_t, RawAddress> connectionHandles_ {};
+    // Samples the ACL traffic of the connected links while there is any.
+    std::unique_ptr<utility::Timer> trafficTimer_ {nullptr};
+    // Links in sniff mode not woken yet, checked by every write.
+    std::mutex sniffingMutex_ {};
+    std::set<RawAddress> sniffingDevices_ {};
+
+    void TrafficTimeout();
+    void SampleTraffic();
+    void WakeProcess(const RawAddress rawAddr);
+    void UpdateSniffingDevice(const RawAddress &rawAddr, bool isSniffing);
 
     void PowerProcess(const RequestStatus status, const std::string &profileName, const RawAddress rawAddr);
     void UpdatePowerDevicesInfo(const RawAddress rawAddr, const std::string &profileName, const RequestStatus status);
@@ -128,7 +145,11 @@ void PowerManager::Disable()
     pimpl->isEnabled_ = false;
     BTM_DeregisterPmCallbacks(&pimpl->btmPmCallbacks_);
     BTM_DeregisterAclCallbacks(&pimpl->btmAclCallbacks_);
+    pimpl->trafficTimer_->Stop();
     pimpl->powerDevices_.clear();
+    pimpl->connectionHandles_.clear();
+    std::lock_guard<std::mutex> lock(pimpl->sniffingMutex_);
+    pimpl->sniffingDevices_.clear();
 }
 
 void PowerManager::StatusUpdate(
@@ -169,6 +190,58 @@ void PowerManager::impl::PowerProcess(
     }
 }
 
+void PowerManager::DataTransmit(const RawAddress &addr) const
+{
+    if (!pimpl->isEnabled_) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(pimpl->sniffingMutex_);
+        // Woken once, the following writes find the link gone until it sniffs again.
+        if (pimpl->sniffingDevices_.erase(addr) == 0) {
+            return;
+        }
+    }
+    pimpl->dispatcher_.PostTask(std::bind(&PowerManager::impl::WakeProcess, pimpl.get(), addr));
+}
+
+void PowerManager::impl::WakeProcess(const RawAddress rawAddr)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto iter = powerDevices_.find(rawAddr);
+    if (iter != powerDevices_.end()) {
+        iter->second->WakeForTraffic();
+    }
+}
+
+void PowerManager::impl::UpdateSniffingDevice(const RawAddress &rawAddr, bool isSniffing)
+{
+    std::lock_guard<std::mutex> lock(sniffingMutex_);
+    if (isSniffing) {
+        sniffingDevices_.insert(rawAddr);
+    } else {
+        sniffingDevices_.erase(rawAddr);
+    }
+}
+
+void PowerManager::impl::TrafficTimeout()
+{
+    if (isEnabled_) {
+        dispatcher_.PostTask(std::bind(&PowerManager::impl::SampleTraffic, this));
+    }
+}
+
+void PowerManager::impl::SampleTraffic()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (auto &its : connectionHandles_) {
+        auto iter = powerDevices_.find(its.second);
+        if (iter != powerDevices_.end()) {
+            iter->second->SampleTraffic();
+        }
+    }
+}
+
 void PowerManager::impl::UpdatePowerDevicesInfo(
     const RawAddress rawAddr, const std::string &profileName, const RequestStatus status)
 {
@@ -209,6 +282,9 @@ void PowerManager::impl::ModeChangeCallBackProcess(
         powerDevices_[rawAddr] = std::make_shared<PowerDevice>(rawAddr, dispatcher_);
     }
     powerDevices_[rawAddr]->ModeChangeCallBack(status, currentMode, interval);
+    if (status == 0) {
+        UpdateSniffingDevice(rawAddr, currentMode == BTM_PM_SNIFF_MODE);
+    }
 }
 
 void PowerManager::impl::ModeChangeCallBack(
@@ -252,6 +328,9 @@ void PowerManager::impl::ConnectionCompleteCallBackProcess(const RawAddress rawA
         LOG_DEBUG("PM_: ConnectionCompleteCallBackProcess(), create powerDevices\n");
         powerDevices_[rawAddr] = std::make_shared<PowerDevice>(rawAddr, dispatcher_);
     }
+    if (connectionHandles_.empty()) {
+        trafficTimer_->Start(POWER_TRAFFIC_SAMPLE_PERIOD_MS, true);
+    }
     connectionHandles_[connectionHandle] = rawAddr;
 }
 
@@ -280,7 +359,11 @@ void PowerManager::impl::DisconnectionCompleteCallBackProcess(uint8_t status, ui
             }
             LOG_DEBUG("PM_: DisconnectionCompleteCallBackProcess(), delete powerDevices, addr=%{public}s\n",
                 iter->second.GetAddress().c_str());
+            UpdateSniffingDevice(iter->second, false);
             connectionHandles_.erase(iter);
+            if (connectionHandles_.empty()) {
+                trafficTimer_->Stop();
+            }
         }
     }
 }
@@ -112,6 +112,15 @@ public:
      * @since 6
      */
     virtual BTPowerMode GetPowerMode(const RawAddress &addr) const = 0;
+
+    /**
+     * @brief Report data about to be sent to a peer, a sniffing link leaves sniff mode at once.
+     *        Cheap enough for every write, a task is only posted for a sniffing link.
+     *
+     * @param addr Peer Address.
+     * @since 6
+     */
+    virtual void DataTransmit(const RawAddress &addr) const = 0;
 };
 
 /**
@@ -197,6 +206,15 @@ public:
      */
     BTPowerMode GetPowerMode(const RawAddress &addr) const override;
 
+    /**
+     * @brief Report data about to be sent to a peer, a sniffing link leaves sniff mode at once.
+     *        Cheap enough for every write, a task is only posted for a sniffing link.
+     *
+     * @param addr Peer Address.
+     * @since 6
+     */
+    void DataTransmit(const RawAddress &addr) const override;
+
 private:
     DISALLOW_COPY_AND_ASSIGN(PowerManager);
     DECLARE_IMPL();
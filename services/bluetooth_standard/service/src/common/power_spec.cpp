@@ -81,7 +81,7 @@ const std::map<RequestStatus, PowerInfo> PowerSpec::MODE_SPEC_PBAP_PSE = {
 };
 
 const std::map<RequestStatus, PowerInfo> PowerSpec::MODE_SPEC_SPP = {
-    {RequestStatus::CONNECT_ON, PowerInfo(PowerModeLevel::LEVEL_ACTIVE, SNIFF_DELAYSET_TIMEOUT_5000_MS)},
+    {RequestStatus::CONNECT_ON, PowerInfo(PowerModeLevel::LEVEL_LOW, SNIFF_DELAYSET_TIMEOUT_5000_MS)},
     {RequestStatus::SCO_ON, PowerInfo(PowerModeLevel::NO_ACTION, 0)},
     {RequestStatus::SCO_OFF, PowerInfo(PowerModeLevel::NO_ACTION, 0)},
     {RequestStatus::IDLE, PowerInfo(PowerModeLevel::LEVEL_LOW, SNIFF_DELAYSET_TIMEOUT_5000_MS)},
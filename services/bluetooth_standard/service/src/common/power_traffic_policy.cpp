@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "power_traffic_policy.h"
+#include <algorithm>
+#include "timer.h"
+
+namespace bluetooth {
+namespace {
+// The hold has been served by the policy, so the sniff delay timer only has to fire; a 0 ms timer never does.
+constexpr int SNIFF_DELAY_MS = 1;
+// Weight of the history in the average gap, out of GAP_AVERAGE_WEIGHT_TOTAL.
+constexpr uint32_t GAP_AVERAGE_WEIGHT_HISTORY = 3;
+constexpr uint32_t GAP_AVERAGE_WEIGHT_TOTAL = 4;
+}  // namespace
+
+PowerTrafficDecision PowerTrafficPolicy::Update(uint64_t bytes, uint64_t packets, uint32_t idleMs, uint32_t elapsedMs)
+{
+    if (!hasBaseline_ || (elapsedMs == 0) || (bytes < lastBytes_) || (packets < lastPackets_)) {
+        hasBaseline_ = true;
+        lastBytes_ = bytes;
+        lastPackets_ = packets;
+        /// The idle time before the first burst says nothing about the gaps between bursts.
+        hasTraffic_ = false;
+        gapMs_ = 0;
+        return PowerTrafficDecision::NONE;
+    }
+
+    uint64_t deltaBytes = bytes - lastBytes_;
+    uint64_t deltaPackets = packets - lastPackets_;
+    lastBytes_ = bytes;
+    lastPackets_ = packets;
+
+    bool wasHeld = false;
+    if (deltaPackets != 0) {
+        /// Gaps shorter than a sample period are not seen, the traffic is continuous at this scale.
+        /// A gap longer than the max hold ends a traffic pattern, the average restarts from the next gap.
+        if (gapMs_ > POWER_TRAFFIC_MAX_HOLD_MS) {
+            gapAverageMs_ = 0;
+        } else if (gapMs_ != 0) {
+            gapAverageMs_ = (gapAverageMs_ == 0) ?
+                gapMs_ : ((gapAverageMs_ * GAP_AVERAGE_WEIGHT_HISTORY + gapMs_) / GAP_AVERAGE_WEIGHT_TOTAL);
+        }
+        gapMs_ = 0;
+        hasTraffic_ = true;
+        wasHeld = isHeld_;
+        isHeld_ = false;
+    } else if (hasTraffic_) {
+        gapMs_ = idleMs;
+    }
+
+    bool isBusy = (deltaPackets * MS_PER_SECOND >= uint64_t(POWER_TRAFFIC_BUSY_PACKETS_PER_SECOND) * elapsedMs) ||
+                  (deltaBytes * MS_PER_SECOND >= uint64_t(POWER_TRAFFIC_BUSY_BYTES_PER_SECOND) * elapsedMs);
+    if (isBusy && (state_ != State::ACTIVE)) {
+        state_ = State::ACTIVE;
+        return PowerTrafficDecision::ACTIVE;
+    }
+
+    /// Light traffic neither wakes a sniffing link nor decides for an unknown one.
+    if (state_ != State::ACTIVE) {
+        return PowerTrafficDecision::NONE;
+    }
+
+    if (wasHeld) {
+        return PowerTrafficDecision::HELD;
+    }
+
+    if (idleMs >= GetHoldMs()) {
+        state_ = State::SNIFF;
+        return PowerTrafficDecision::SNIFF;
+    }
+
+    if (idleMs >= POWER_TRAFFIC_MIN_HOLD_MS) {
+        isHeld_ = true;
+    }
+    return PowerTrafficDecision::NONE;
+}
+
+bool PowerTrafficPolicy::Wake()
+{
+    isHeld_ = false;
+    if (state_ == State::ACTIVE) {
+        return false;
+    }
+    state_ = State::ACTIVE;
+    return true;
+}
+
+PowerInfo PowerTrafficPolicy::GetPowerInfo() const
+{
+    switch (state_) {
+        case State::ACTIVE:
+            return PowerInfo(PowerModeLevel::LEVEL_ACTIVE, 0);
+        case State::SNIFF:
+            if ((gapAverageMs_ != 0) && (gapAverageMs_ < POWER_TRAFFIC_SHORT_GAP_MS)) {
+                return PowerInfo(PowerModeLevel::LEVEL_MID, SNIFF_DELAY_MS);
+            }
+            return PowerInfo(PowerModeLevel::LEVEL_LOW, SNIFF_DELAY_MS);
+        default:
+            return PowerInfo(PowerModeLevel::NO_ACTION, 0);
+    }
+}
+
+PowerSsrLevel PowerTrafficPolicy::GetSsrLevel() const
+{
+    if (state_ != State::SNIFF) {
+        return PowerSsrLevel::NO_ACTION;
+    }
+    if ((gapAverageMs_ != 0) && (gapAverageMs_ < POWER_TRAFFIC_SHORT_GAP_MS)) {
+        return PowerSsrLevel::SSR1;
+    }
+    return PowerSsrLevel::SSR2;
+}
+
+uint32_t PowerTrafficPolicy::GetHoldMs() const
+{
+    /// Bridging a gap costs more than the mode changes around it.
+    if (gapAverageMs_ * 2 > POWER_TRAFFIC_MAX_HOLD_MS) {
+        return POWER_TRAFFIC_MIN_HOLD_MS;
+    }
+    return std::max<uint32_t>(gapAverageMs_ * 2, POWER_TRAFFIC_MIN_HOLD_MS);
+}
+}  // namespace bluetooth
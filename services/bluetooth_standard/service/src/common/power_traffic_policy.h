@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef POWER_TRAFFIC_POLICY_H
+#define POWER_TRAFFIC_POLICY_H
+
+#include <cstdint>
+#include "base_def.h"
+#include "power_spec.h"
+
+namespace bluetooth {
+// The period the ACL traffic of the connected links is sampled at.
+#define POWER_TRAFFIC_SAMPLE_PERIOD_MS 200
+// A link moving at least this many packets or bytes per second is busy and is put in active mode at once.
+#define POWER_TRAFFIC_BUSY_PACKETS_PER_SECOND 15
+#define POWER_TRAFFIC_BUSY_BYTES_PER_SECOND 2048
+// The bounds of the time a link stays active after its last packet.
+#define POWER_TRAFFIC_MIN_HOLD_MS 1000
+#define POWER_TRAFFIC_MAX_HOLD_MS 10000
+// Bursts closer than this on average are served by the mid sniff level and no subrating.
+#define POWER_TRAFFIC_SHORT_GAP_MS 2000
+
+/**
+ * @brief Represents the decision of the traffic policy on one sample.
+ *
+ * @since 6
+ */
+enum class PowerTrafficDecision : int {
+    NONE = 0,  // Nothing to change.
+    ACTIVE,    // The link became busy, it has to leave sniff mode.
+    SNIFF,     // The link has been idle long enough, it may enter sniff mode.
+    HELD,      // The link became busy again in an idle gap longer than the min hold, it was kept active.
+};
+
+/**
+ * @brief Represents the traffic driven power policy of one ACL link.
+ *
+ * @details Fast attack, slow release: a busy sample puts the link in active mode at once, while the link is only let
+ *          back into sniff mode after an idle time of twice the average gap between bursts, bounded by
+ *          POWER_TRAFFIC_MIN_HOLD_MS and POWER_TRAFFIC_MAX_HOLD_MS. Gaps too long to bridge are released after the
+ *          min hold, and a gap longer than the max hold restarts the average. Data sent wakes the link through
+ *          Wake() without waiting for a sample. The sniff level and the subrating are picked from the average gap.
+ *
+ * @since 6
+ */
+class PowerTrafficPolicy {
+public:
+    /**
+     * @brief A constructor used to create an <b>PowerTrafficPolicy</b> instance.
+     *
+     * @since 6
+     */
+    PowerTrafficPolicy() = default;
+
+    /**
+     * @brief A destructor used to delete the <b>PowerTrafficPolicy</b> instance.
+     *
+     * @since 6
+     */
+    ~PowerTrafficPolicy() = default;
+
+    /**
+     * @brief Update the policy with a sample of the ACL traffic.
+     *
+     * @param bytes Bytes sent and received on the link since it was established.
+     * @param packets Packets sent and received on the link since it was established.
+     * @param idleMs Time since the last packet sent or received.
+     * @param elapsedMs Time since the previous sample, 0 for the first one.
+     * @return Returns the decision on this sample.
+     * @since 6
+     */
+    PowerTrafficDecision Update(uint64_t bytes, uint64_t packets, uint32_t idleMs, uint32_t elapsedMs);
+
+    /**
+     * @brief Put the link in active mode at once, as data is about to be sent, without waiting for the next sample.
+     *
+     * @return Returns <b>true</b> if the link was not active for the policy.
+     * @since 6
+     */
+    bool Wake();
+
+    /**
+     * @brief Get the power mode requested by the traffic.
+     *
+     * @return Returns <b>PowerModeLevel::NO_ACTION</b> until the link has been busy once, then the active level or
+     *         the sniff level to enter without further delay.
+     * @since 6
+     */
+    PowerInfo GetPowerInfo() const;
+
+    /**
+     * @brief Get the sniff subrating level requested by the traffic.
+     *
+     * @return Returns PowerSsrLevel, <b>PowerSsrLevel::NO_ACTION</b> until the link has been busy once.
+     * @since 6
+     */
+    PowerSsrLevel GetSsrLevel() const;
+
+    /**
+     * @brief Get the time the link stays active after its last packet.
+     *
+     * @return Returns the hold time(ms).
+     * @since 6
+     */
+    uint32_t GetHoldMs() const;
+
+private:
+    enum class State : int {
+        NONE = 0,
+        ACTIVE,
+        SNIFF,
+    };
+
+    State state_ {State::NONE};
+    bool hasBaseline_ {false};
+    uint64_t lastBytes_ {0};
+    uint64_t lastPackets_ {0};
+    // A packet has been seen since the baseline, the gaps are measured from then on.
+    bool hasTraffic_ {false};
+    // The idle time of the previous sample if it saw no packet, the length of the gap so far.
+    uint32_t gapMs_ {0};
+    // The average gap between bursts, 0 until one has been seen.
+    uint32_t gapAverageMs_ {0};
+    // The link has been idle longer than the min hold in the current gap.
+    bool isHeld_ {false};
+
+    DISALLOW_COPY_AND_ASSIGN(PowerTrafficPolicy);
+};
+}  // namespace bluetooth
+
+#endif  // POWER_TRAFFIC_POLICY_H
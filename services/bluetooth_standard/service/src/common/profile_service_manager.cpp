@@ -16,6 +16,7 @@
 #include "profile_service_manager.h"
 
 #include <algorithm>
+#include <chrono>
 
 #include "bt_def.h"
 #include "log.h"
@@ -25,6 +26,7 @@
 #include "class_creator.h"
 #include "profile_info.h"
 #include "profile_list.h"
+#include "timer.h"
 
 namespace bluetooth {
 class ProfileServicesContextCallback : public utility::IContextCallback {
@@ -85,6 +87,25 @@ enum ServiceStateID {
     TURNING_OFF = BTStateID::STATE_TURNING_OFF,
     TURN_OFF = BTStateID::STATE_TURN_OFF,
     WAIT_TURN_ON,
+    WAIT_DEPENDENCIES,
+};
+
+// A profile that does not report its enable or disable result within this time is treated as failed.
+const int PROFILE_TRANSITION_TIMEOUT_MS = 10000;
+
+// Profiles enabled only once the listed profiles are on. Profiles not listed start concurrently.
+// Disabling stays fully concurrent: the GATT server only reports disabled once the GATT client has shut down
+// the shared connection manager, so waiting for dependents to stop first would stall.
+const std::map<std::string, std::vector<std::string>> PROFILE_DEPENDENCIES = {
+    // The GATT client starts the connection manager that delivers ATT connections to the GATT server.
+    {PROFILE_NAME_GATT_SERVER, {PROFILE_NAME_GATT_CLIENT}},
+};
+
+struct ProfileTransition {
+    std::unique_ptr<utility::Timer> timer_ = nullptr;
+    std::chrono::steady_clock::time_point start_ {};
+    bool enable_ = false;
+    bool pending_ = false;
 };
 
 struct ProfileServiceManager::impl {
@@ -94,6 +115,8 @@ struct ProfileServiceManager::impl {
     ProfilesList<IProfile *> startedProfiles_ = {};
     ProfilesList<ServiceStateID> profilesState_ = {};
     std::unique_ptr<ProfileServicesContextCallback> contextCallback_ = nullptr;
+    std::map<std::string, ProfileTransition> transitions_ = {};
+    std::map<BTTransport, std::chrono::steady_clock::time_point> transportStart_ = {};
 
     DISALLOW_COPY_AND_ASSIGN(impl);
 };
@@ -206,6 +229,7 @@ IProfile *ProfileServiceManager::GetProfileService(const std::string &name) cons
 bool ProfileServiceManager::Enable(const BTTransport transport) const
 {
     LOG_DEBUG("%{public}s transport is %{public}d", __PRETTY_FUNCTION__, transport);
+    pimpl->transportStart_[transport] = std::chrono::steady_clock::now();
 
     if (IsAllEnabled(transport)) {
         LOG_DEBUG("%{public}s OK", __PRETTY_FUNCTION__);
@@ -283,18 +307,127 @@ void ProfileServiceManager::EnableProfiles(const BTTransport transport) const
         }
 
         if (pimpl->profilesState_.Get(transport, name) == ServiceStateID::TURN_OFF) {
-            pimpl->profilesState_.SetProfile(transport, name, ServiceStateID::TURNING_ON);
-            LOG_DEBUG("%{public}s transport %{public}d %{public}s enable", __PRETTY_FUNCTION__, transport, name.c_str());
-            IProfile *profile = nullptr;
-            if (pimpl->startedProfiles_.Find(transport, name, profile)) {
-                profile->GetContext()->Enable();
-            } else {
-                LOG_DEBUG("%{public}s startedProfiles_ is not find", __PRETTY_FUNCTION__);
+            pimpl->profilesState_.SetProfile(transport, name, ServiceStateID::WAIT_DEPENDENCIES);
+        }
+    }
+
+    EnableReadyProfiles(transport);
+}
+
+bool ProfileServiceManager::IsDependencyReady(const BTTransport transport, const std::string &name, bool &failed) const
+{
+    failed = false;
+    auto it = PROFILE_DEPENDENCIES.find(name);
+    if (it == PROFILE_DEPENDENCIES.end()) {
+        return true;
+    }
+
+    bool ready = true;
+    for (auto &dependency : it->second) {
+        ServiceStateID state = ServiceStateID::TURN_ON;
+        if (!pimpl->profilesState_.Find(transport, dependency, state)) {
+            // Not configured for this transport.
+            continue;
+        }
+        if (state == ServiceStateID::TURN_OFF) {
+            failed = true;
+            return false;
+        }
+        if (state != ServiceStateID::TURN_ON) {
+            ready = false;
+        }
+    }
+    return ready;
+}
+
+void ProfileServiceManager::EnableReadyProfiles(const BTTransport transport) const
+{
+    FOR_EACH_LIST(it, pimpl->profilesState_, transport)
+    {
+        std::string name = it.first;
+        if (pimpl->profilesState_.Get(transport, name) != ServiceStateID::WAIT_DEPENDENCIES) {
+            continue;
+        }
+
+        bool failed = false;
+        if (!IsDependencyReady(transport, name, failed)) {
+            if (failed) {
+                LOG_ERROR("%{public}s transport %{public}d %{public}s dependency failed",
+                    __PRETTY_FUNCTION__, transport, name.c_str());
+                pimpl->profilesState_.SetProfile(transport, name, ServiceStateID::TURN_OFF);
             }
+            continue;
+        }
+
+        pimpl->profilesState_.SetProfile(transport, name, ServiceStateID::TURNING_ON);
+        LOG_DEBUG("%{public}s transport %{public}d %{public}s enable", __PRETTY_FUNCTION__, transport, name.c_str());
+        IProfile *profile = nullptr;
+        if (pimpl->startedProfiles_.Find(transport, name, profile)) {
+            StartProfileTransition(*profile, name, true);
+        } else {
+            LOG_DEBUG("%{public}s startedProfiles_ is not find", __PRETTY_FUNCTION__);
         }
     }
 }
 
+void ProfileServiceManager::StartProfileTransition(IProfile &profile, const std::string &name, bool enable) const
+{
+    ProfileTransition &transition = pimpl->transitions_[name];
+    if (transition.timer_ == nullptr) {
+        transition.timer_ = std::make_unique<utility::Timer>([this, name]() {
+            pimpl->dispatcher_.PostTask([this, name]() {
+                ProfileTransitionTimeout(name, pimpl->transitions_[name].enable_);
+            });
+        });
+    }
+    transition.enable_ = enable;
+    transition.pending_ = true;
+    transition.start_ = std::chrono::steady_clock::now();
+    transition.timer_->Start(PROFILE_TRANSITION_TIMEOUT_MS, false);
+
+    // Run on the profile's own dispatcher so that profiles doing synchronous work there start in parallel.
+    utility::Context *context = profile.GetContext();
+    if (enable) {
+        context->GetDispatcher()->PostTask(std::bind(&utility::Context::Enable, context));
+    } else {
+        context->GetDispatcher()->PostTask(std::bind(&utility::Context::Disable, context));
+    }
+}
+
+void ProfileServiceManager::FinishProfileTransition(const std::string &name, bool enable, bool ret) const
+{
+    auto it = pimpl->transitions_.find(name);
+    if ((it == pimpl->transitions_.end()) || (!it->second.pending_) || (it->second.enable_ != enable)) {
+        return;
+    }
+    it->second.pending_ = false;
+    it->second.timer_->Stop();
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - it->second.start_);
+    LOG_INFO("%{public}s %{public}s %{public}s ret %{public}d in %{public}lld ms", __PRETTY_FUNCTION__,
+        name.c_str(), enable ? "enable" : "disable", ret, static_cast<long long>(elapsed.count()));
+}
+
+void ProfileServiceManager::ProfileTransitionTimeout(const std::string &name, bool enable) const
+{
+    auto it = pimpl->transitions_.find(name);
+    if ((it == pimpl->transitions_.end()) || (!it->second.pending_) || (it->second.enable_ != enable)) {
+        return;
+    }
+    LOG_ERROR("%{public}s %{public}s %{public}s timeout", __PRETTY_FUNCTION__, name.c_str(),
+        enable ? "enable" : "disable");
+    if (enable) {
+        EnableCompleteProcess(name, false);
+        // The profile is marked off, a late successful enable must not leave it running.
+        IProfile *profile = nullptr;
+        if (pimpl->startedProfiles_.Find(name, profile)) {
+            StartProfileTransition(*profile, name, false);
+        }
+    } else {
+        DisableCompleteProcess(name, false);
+    }
+}
+
 void ProfileServiceManager::OnEnable(const std::string &name, bool ret) const
 {
     LOG_DEBUG("%{public}s, name=%{public}s, ret=%{public}d\n", __PRETTY_FUNCTION__, name.c_str(), ret);
@@ -304,12 +437,14 @@ void ProfileServiceManager::EnableCompleteProcess(const std::string &name, bool
 {
     ServiceStateID newState = ret ? ServiceStateID::TURN_ON : ServiceStateID::TURN_OFF;
     std::string profileName = name;
+    FinishProfileTransition(profileName, true, ret);
 
     ServiceStateID state = ServiceStateID::TURN_OFF;
     if ((pimpl->profilesState_.Find(BTTransport::ADAPTER_BREDR, profileName, state)) &&
         (state == ServiceStateID::TURNING_ON)) {
         LOG_DEBUG("%{public}s BREDR %{public}s complete ret %{public}d", __PRETTY_FUNCTION__, profileName.c_str(), ret);
         pimpl->profilesState_.SetProfile(BTTransport::ADAPTER_BREDR, profileName, newState);
+        EnableReadyProfiles(BTTransport::ADAPTER_BREDR);
         if (!IsProfilesTurning(BTTransport::ADAPTER_BREDR)) {
             EnableCompleteNotify(BTTransport::ADAPTER_BREDR);
         }
@@ -319,6 +454,7 @@ void ProfileServiceManager::EnableCompleteProcess(const std::string &name, bool
         (state == ServiceStateID::TURNING_ON)) {
         LOG_DEBUG("%{public}s BLE %{public}s complete ret %{public}d", __PRETTY_FUNCTION__, profileName.c_str(), ret);
         pimpl->profilesState_.SetProfile(BTTransport::ADAPTER_BLE, profileName, newState);
+        EnableReadyProfiles(BTTransport::ADAPTER_BLE);
         if (!IsProfilesTurning(BTTransport::ADAPTER_BLE)) {
             EnableCompleteNotify(BTTransport::ADAPTER_BLE);
         }
@@ -349,6 +485,10 @@ void ProfileServiceManager::EnableCompleteNotify(const BTTransport transport) co
     int turnOnProfileCount = std::count_if(pimpl->profilesState_.GetProfiles(transport)->begin(),
         pimpl->profilesState_.GetProfiles(transport)->end(),
         [](const auto &temp) -> bool { return temp.second == ServiceStateID::TURN_ON; });
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - pimpl->transportStart_[transport]);
+    LOG_INFO("%{public}s transport %{public}d profiles enabled in %{public}lld ms", __PRETTY_FUNCTION__, transport,
+        static_cast<long long>(elapsed.count()));
 
     if (turnOnProfileCount == pimpl->profilesState_.Size(transport)) {
         LOG_DEBUG("%{public}s OK transport %{public}d turnOnProfileCount %{public}d", __PRETTY_FUNCTION__, transport, turnOnProfileCount);
@@ -362,6 +502,7 @@ void ProfileServiceManager::EnableCompleteNotify(const BTTransport transport) co
 bool ProfileServiceManager::Disable(const BTTransport transport) const
 {
     LOG_DEBUG("%{public}s transport is %{public}d", __PRETTY_FUNCTION__, transport);
+    pimpl->transportStart_[transport] = std::chrono::steady_clock::now();
 
     if (IsAllDisabled(transport)) {
         LOG_DEBUG("%{public}s OK", __PRETTY_FUNCTION__);
@@ -436,12 +577,17 @@ void ProfileServiceManager::DisableProfiles(const BTTransport transport) const
             }
         }
 
+        if (pimpl->profilesState_.Get(transport, name) == ServiceStateID::WAIT_DEPENDENCIES) {
+            // Never started, nothing to stop.
+            pimpl->profilesState_.SetProfile(transport, name, ServiceStateID::TURN_OFF);
+        }
+
         if (pimpl->profilesState_.Get(transport, name) == ServiceStateID::TURN_ON) {
             pimpl->profilesState_.SetProfile(transport, name, ServiceStateID::TURNING_OFF);
             LOG_DEBUG("%{public}s transport %{public}d %{public}s disable", __PRETTY_FUNCTION__, transport, name.c_str());
             IProfile *profile = nullptr;
             if (pimpl->startedProfiles_.Find(transport, name, profile)) {
-                profile->GetContext()->Disable();
+                StartProfileTransition(*profile, name, false);
             }
         }
     }
@@ -456,6 +602,7 @@ void ProfileServiceManager::OnDisable(const std::string &name, bool ret) const
 void ProfileServiceManager::DisableCompleteProcess(const std::string &name, bool ret) const
 {
     std::string profileName = name;
+    FinishProfileTransition(profileName, false, ret);
 
     ServiceStateID state = ServiceStateID::TURN_OFF;
     if ((pimpl->profilesState_.Find(BTTransport::ADAPTER_BREDR, profileName, state)) &&
@@ -483,6 +630,10 @@ void ProfileServiceManager::DisableCompleteNotify(const BTTransport transport) c
     int turnOffProfileCount = std::count_if(pimpl->profilesState_.GetProfiles(transport)->begin(),
         pimpl->profilesState_.GetProfiles(transport)->end(),
         [](const auto &temp) -> bool { return temp.second == ServiceStateID::TURN_OFF; });
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - pimpl->transportStart_[transport]);
+    LOG_INFO("%{public}s transport %{public}d profiles disabled in %{public}lld ms", __PRETTY_FUNCTION__, transport,
+        static_cast<long long>(elapsed.count()));
 
     if (turnOffProfileCount == pimpl->profilesState_.Size(transport)) {
         LOG_DEBUG(
@@ -503,7 +654,7 @@ void ProfileServiceManager::CheckWaitEnableProfiles(const std::string &name, con
         IProfile *profile = nullptr;
         if (pimpl->startedProfiles_.Find(transport, name, profile)) {
             pimpl->profilesState_.SetProfile(transport, name, ServiceStateID::TURNING_ON);
-            profile->GetContext()->Enable();
+            StartProfileTransition(*profile, name, true);
         }
     }
 }
@@ -213,6 +213,11 @@ private:
     bool IsProfilesTurning(const BTTransport transport) const;
     bool IsAllDisabled(const BTTransport transport) const;
     void CheckWaitEnableProfiles(const std::string &name, const BTTransport transport) const;
+    bool IsDependencyReady(const BTTransport transport, const std::string &name, bool &failed) const;
+    void EnableReadyProfiles(const BTTransport transport) const;
+    void StartProfileTransition(IProfile &profile, const std::string &name, bool enable) const;
+    void FinishProfileTransition(const std::string &name, bool enable, bool ret) const;
+    void ProfileTransitionTimeout(const std::string &name, bool enable) const;
 
     DISALLOW_COPY_AND_ASSIGN(ProfileServiceManager);
     DECLARE_IMPL();
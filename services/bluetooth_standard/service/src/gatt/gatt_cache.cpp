@@ -14,14 +14,97 @@
  */
 
 #include "gatt_cache.h"
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "bt_def.h"
 #include "gatt_defines.h"
+#include "log.h"
+#include "securec.h"
 
 namespace bluetooth {
 using Descriptors = std::pair<std::map<uint16_t, GattCache::Descriptor> *, uint16_t>;
 
+namespace {
+/*
+ * Cache file layout, little endian:
+ *   header: magic(4) version(2) record count(2) database hash(16)
+ *   record: type(1) properties(1) handle(2) handle1(2) handle2(2) uuid(16)
+ * service: handle1 is end handle. include service: handle1/handle2 are start/end handle of included service.
+ * characteristic: handle1 is value handle.
+ */
+constexpr uint32_t CACHE_FILE_MAGIC = 0x43544147;
+constexpr uint16_t CACHE_FILE_VERSION = 0x0001;
+constexpr size_t DATABASE_HASH_SIZE = 16;
+constexpr size_t CACHE_HEADER_SIZE = 24;
+constexpr size_t CACHE_HEADER_COUNT_OFFSET = 6;
+constexpr size_t CACHE_HEADER_HASH_OFFSET = 8;
+constexpr size_t CACHE_RECORD_SIZE = 24;
+constexpr size_t CACHE_RECORD_UUID_OFFSET = 8;
+constexpr size_t CACHE_MAX_RECORD_COUNT = 0xFFFF;
+constexpr uint8_t BYTE_SHIFT = 8;
+
+enum CacheRecordType : uint8_t {
+    RECORD_PRIMARY_SERVICE = 1,
+    RECORD_SECONDARY_SERVICE,
+    RECORD_INCLUDE_SERVICE,
+    RECORD_CHARACTERISTIC,
+    RECORD_DESCRIPTOR,
+};
+
+void PutUint16(std::vector<uint8_t> &out, uint16_t value)
+{
+    out.push_back(static_cast<uint8_t>(value));
+    out.push_back(static_cast<uint8_t>(value >> BYTE_SHIFT));
+}
+
+void PutUint32(std::vector<uint8_t> &out, uint32_t value)
+{
+    for (size_t i = 0; i < sizeof(uint32_t); i++) {
+        out.push_back(static_cast<uint8_t>(value >> (i * BYTE_SHIFT)));
+    }
+}
+
+uint16_t GetUint16(const uint8_t *data)
+{
+    return static_cast<uint16_t>(data[0] | (data[1] << BYTE_SHIFT));
+}
+
+uint32_t GetUint32(const uint8_t *data)
+{
+    uint32_t value = 0;
+    for (size_t i = 0; i < sizeof(uint32_t); i++) {
+        value |= static_cast<uint32_t>(data[i]) << (i * BYTE_SHIFT);
+    }
+    return value;
+}
+
+void PutRecord(std::vector<uint8_t> &out, uint8_t type, uint8_t properties, const uint16_t (&handles)[3],
+    const Uuid &uuid)
+{
+    out.push_back(type);
+    out.push_back(properties);
+    for (uint16_t handle : handles) {
+        PutUint16(out, handle);
+    }
+    uint8_t uuid128[DATABASE_HASH_SIZE] = {0};
+    uuid.ConvertToBytesLE(uuid128, sizeof(uuid128));
+    out.insert(out.end(), uuid128, uuid128 + sizeof(uuid128));
+}
+}  // namespace
+
+GattCache::MappedFile::~MappedFile()
+{
+    if (addr_ != nullptr) {
+        munmap(addr_, size_);
+    }
+}
+
 void GattCache::AddService(const Service &service)
 {
+    Materialize();
     auto it = services_.emplace(service.handle_, service);
     if (!it.second) {
         it.first->second.endHandle_ = service.endHandle_;
@@ -32,10 +115,15 @@ void GattCache::AddService(const Service &service)
 void GattCache::Clear()
 {
     services_.clear();
+    valueHandleMap_.clear();
+    storedFile_ = nullptr;
+    isValid_ = false;
+    isComplete_ = false;
 }
 
 int GattCache::AddIncludeService(uint16_t serviceHandle, const IncludeService &includeService)
 {
+    Materialize();
     auto it = services_.find(serviceHandle);
     if (it != services_.end()) {
         it->second.includeServices_.push_back(includeService);
@@ -48,6 +136,7 @@ int GattCache::AddIncludeService(uint16_t serviceHandle, const IncludeService &i
 
 int GattCache::AddCharacteristic(uint16_t serviceHandle, const Characteristic &characteristic)
 {
+    Materialize();
     auto it = services_.find(serviceHandle);
     if (it != services_.end()) {
         auto result = it->second.characteristics_.emplace(characteristic.handle_, characteristic);
@@ -64,6 +153,7 @@ int GattCache::AddCharacteristic(uint16_t serviceHandle, const Characteristic &c
 
 int GattCache::AddDescriptor(uint16_t cccHandle, const Descriptor &descriptor)
 {
+    Materialize();
     for (auto &sIt : services_) {
         auto cIt = sIt.second.characteristics_.find(cccHandle);
         if (cIt != sIt.second.characteristics_.end()) {
@@ -78,6 +168,7 @@ int GattCache::AddDescriptor(uint16_t cccHandle, const Descriptor &descriptor)
 
 const GattCache::Characteristic *GattCache::GetCharacteristic(int16_t valueHandle)
 {
+    Materialize();
     auto it = valueHandleMap_.find(valueHandle);
     if (it != valueHandleMap_.end()) {
         auto svc = services_.find(it->second.first);
@@ -93,6 +184,7 @@ const GattCache::Characteristic *GattCache::GetCharacteristic(int16_t valueHandl
 
 const GattCache::Descriptor *GattCache::GetDescriptor(int16_t valueHandle)
 {
+    Materialize();
     auto it = valueHandleMap_.find(valueHandle);
     if (it == valueHandleMap_.end()) {
         return nullptr;
@@ -112,8 +204,9 @@ const GattCache::Descriptor *GattCache::GetDescriptor(int16_t valueHandle)
     return &descriptor->second;
 }
 
-uint16_t GattCache::GetCharacteristicEndHandle(uint16_t serviceHandle, uint16_t cccHandle) const
+uint16_t GattCache::GetCharacteristicEndHandle(uint16_t serviceHandle, uint16_t cccHandle)
 {
+    Materialize();
     auto svc = services_.find(serviceHandle);
     if (svc == services_.end()) {
         return INVALID_ATTRIBUTE_HANDLE;
@@ -133,11 +226,13 @@ uint16_t GattCache::GetCharacteristicEndHandle(uint16_t serviceHandle, uint16_t
 
 std::map<uint16_t, GattCache::Service> &GattCache::GetServices()
 {
+    Materialize();
     return services_;
 }
 
 std::vector<GattCache::IncludeService> *GattCache::GetIncludeServices(uint16_t serviceHandle)
 {
+    Materialize();
     auto service = services_.find(serviceHandle);
     if (service != services_.end()) {
         return &service->second.includeServices_;
@@ -147,6 +242,7 @@ std::vector<GattCache::IncludeService> *GattCache::GetIncludeServices(uint16_t s
 
 std::map<uint16_t, GattCache::Characteristic> *GattCache::GetCharacteristics(uint16_t serviceHandle)
 {
+    Materialize();
     auto service = services_.find(serviceHandle);
     if (service != services_.end()) {
         return &service->second.characteristics_;
@@ -156,6 +252,7 @@ std::map<uint16_t, GattCache::Characteristic> *GattCache::GetCharacteristics(uin
 
 Descriptors GattCache::GetDescriptors(uint16_t cccHandle)
 {
+    Materialize();
     for (auto &service : services_) {
         auto it = service.second.characteristics_.find(cccHandle);
         if (it != service.second.characteristics_.end()) {
@@ -167,135 +264,208 @@ Descriptors GattCache::GetDescriptors(uint16_t cccHandle)
 
 const std::string GattCache::GATT_STORAGE_PRIFIX = "gatt_storage_cache_";
 
-int GattCache::StoredToFile(const GattDevice& address) const
+bool GattCache::SerializeTo(std::vector<uint8_t> &out) const
 {
-    std::vector<StorageBlob> storage;
-
+    size_t count = 0;
     for (auto &svc : services_) {
-        StorageBlob svcBlob = {};
-        svcBlob.handle_ = svc.second.handle_;
-        svcBlob.type_ = (svc.second.isPrimary_ ? Uuid::ConvertFrom16Bits(UUID_PRIMARY_SERVICE)
-                                               : Uuid::ConvertFrom16Bits(UUID_SECONDARY_SERVICE));
-        svcBlob.value_.service_.uuid_ = svc.second.uuid_;
-        svcBlob.value_.service_.endHandle_ = svc.second.endHandle_;
-        storage.push_back(svcBlob);
+        count++;
+        count += svc.second.includeServices_.size();
+        for (auto &ccc : svc.second.characteristics_) {
+            count += 1 + ccc.second.descriptors_.size();
+        }
+    }
+    if (count > CACHE_MAX_RECORD_COUNT) {
+        return false;
+    }
+    out.reserve(CACHE_HEADER_SIZE + count * CACHE_RECORD_SIZE);
+
+    PutUint32(out, CACHE_FILE_MAGIC);
+    PutUint16(out, CACHE_FILE_VERSION);
+    PutUint16(out, static_cast<uint16_t>(count));
+    out.insert(out.end(), databaseHash_.begin(), databaseHash_.end());
 
+    for (auto &svc : services_) {
+        PutRecord(out,
+            svc.second.isPrimary_ ? RECORD_PRIMARY_SERVICE : RECORD_SECONDARY_SERVICE,
+            0,
+            {svc.second.handle_, svc.second.endHandle_, 0},
+            svc.second.uuid_);
         for (auto &isvc : svc.second.includeServices_) {
-            StorageBlob isvcBlob = {};
-            isvcBlob.handle_ = isvc.handle_;
-            isvcBlob.type_ = Uuid::ConvertFrom16Bits(UUID_INCLUDE_SERVICE);
-            isvcBlob.value_.includeService_.handle_ = isvc.startHandle_;
-            isvcBlob.value_.includeService_.endHandle_ = isvc.endHandle_;
-            isvcBlob.value_.includeService_.uuid_ = isvc.uuid_;
-            storage.push_back(isvcBlob);
+            PutRecord(out, RECORD_INCLUDE_SERVICE, 0, {isvc.handle_, isvc.startHandle_, isvc.endHandle_}, isvc.uuid_);
         }
-
         for (auto &ccc : svc.second.characteristics_) {
-            StorageBlob cccBlob = {};
-            cccBlob.handle_ = ccc.second.handle_;
-            cccBlob.type_ = Uuid::ConvertFrom16Bits(UUID_CHARACTERISTIC);
-            cccBlob.value_.characteristic_.properties_ = ccc.second.properties_;
-            cccBlob.value_.characteristic_.valueHandle_ = ccc.second.valueHandle_;
-            cccBlob.value_.characteristic_.uuid_ = ccc.second.uuid_;
-            storage.push_back(cccBlob);
-
+            PutRecord(out,
+                RECORD_CHARACTERISTIC,
+                ccc.second.properties_,
+                {ccc.second.handle_, ccc.second.valueHandle_, 0},
+                ccc.second.uuid_);
             for (auto &desc : ccc.second.descriptors_) {
-                StorageBlob descBlob = {};
-                descBlob.handle_ = desc.second.handle_;
-                descBlob.type_ = desc.second.uuid_;
-                storage.push_back(descBlob);
+                PutRecord(out, RECORD_DESCRIPTOR, 0, {desc.second.handle_, 0, 0}, desc.second.uuid_);
             }
         }
     }
-
-    return WriteStorageBlobToFile(address, storage);
+    return true;
 }
 
-int GattCache::LoadFromFile(const GattDevice& address)
+int GattCache::StoredToFile(const GattDevice& address) const
 {
-    std::vector<StorageBlob> storage = ReadStorageBlobFromFile(address);
+    // Only a fully discovered database with a known hash can be validated on next connection.
+    if (!isComplete_ || databaseHash_.size() != DATABASE_HASH_SIZE) {
+        return GattStatus::GATT_SUCCESS;
+    }
 
-    uint16_t currentSvcHandle = 0;
-    uint16_t currentCccHandle = 0;
-    for (auto &item : storage) {
-        if (item.type_ == Uuid::ConvertFrom16Bits(UUID_PRIMARY_SERVICE) ||
-            item.type_ == Uuid::ConvertFrom16Bits(UUID_SECONDARY_SERVICE)) {
-            AddService(
-                GattCache::Service((item.type_ == Uuid::ConvertFrom16Bits(UUID_PRIMARY_SERVICE)) ? true : false,
-                    item.handle_,
-                    item.value_.service_.endHandle_,
-                    item.value_.service_.uuid_));
-            currentSvcHandle = item.handle_;
-        } else if (item.type_ == Uuid::ConvertFrom16Bits(UUID_INCLUDE_SERVICE)) {
-            AddIncludeService(currentSvcHandle,
-                GattCache::IncludeService(item.handle_,
-                    item.value_.includeService_.handle_,
-                    item.value_.includeService_.endHandle_,
-                    item.value_.includeService_.uuid_));
-        } else if (item.type_ == Uuid::ConvertFrom16Bits(UUID_CHARACTERISTIC)) {
-            AddCharacteristic(currentSvcHandle,
-                GattCache::Characteristic(item.handle_,
-                    item.value_.characteristic_.properties_,
-                    item.value_.characteristic_.valueHandle_,
-                    item.value_.characteristic_.uuid_));
-            currentCccHandle = item.handle_;
-        } else {
-            AddDescriptor(currentCccHandle, GattCache::Descriptor(item.handle_, item.type_));
-        }
+    std::vector<uint8_t> storage;
+    if (!SerializeTo(storage)) {
+        return GattStatus::INTERNAL_ERROR;
     }
 
-    return GattStatus::GATT_SUCCESS;
-}
+    std::string fileName = GenerateGattCacheFileName(address);
+    std::string tmpFileName = fileName + ".tmp";
+    FILE* fd = fopen(tmpFileName.c_str(), "wb");
+    if (fd == nullptr) {
+        return GattStatus::REQUEST_NOT_SUPPORT;
+    }
+    if (fwrite(storage.data(), 1, storage.size(), fd) != storage.size()) {
+        fclose(fd);
+        remove(tmpFileName.c_str());
+        return GattStatus::INTERNAL_ERROR;
+    }
+    fclose(fd);
 
-std::string GattCache::GenerateGattCacheFileName(const GattDevice &address)
-{
-    return (GATT_STORAGE_PRIFIX + address.addr_.GetAddress() + "_" +
-           ((address.transport_ == GATT_TRANSPORT_TYPE_CLASSIC) ? "CLASSIC" : "LE"));
+    if (rename(tmpFileName.c_str(), fileName.c_str()) != 0) {
+        remove(tmpFileName.c_str());
+        return GattStatus::INTERNAL_ERROR;
+    }
+
+    return GattStatus::GATT_SUCCESS;
 }
 
-int GattCache::WriteStorageBlobToFile(const GattDevice& address, std::vector<StorageBlob> &blob) const
+int GattCache::LoadFromFile(const GattDevice& address)
 {
-    FILE* fd = fopen(GenerateGattCacheFileName(address).c_str(), "wb");
-    if (fd == nullptr) {
+    storedFile_ = nullptr;
+    int fd = open(GenerateGattCacheFileName(address).c_str(), O_RDONLY);
+    if (fd < 0) {
         return GattStatus::REQUEST_NOT_SUPPORT;
     }
 
-    uint16_t blobSize = blob.size();
-    if (fwrite(&blobSize, sizeof(uint16_t), 1, fd) != 1) {
-        fclose(fd);
+    struct stat fileStat = {};
+    if (fstat(fd, &fileStat) != 0 || static_cast<size_t>(fileStat.st_size) < CACHE_HEADER_SIZE) {
+        close(fd);
         return GattStatus::INTERNAL_ERROR;
     }
-
-    if (fwrite(blob.data(), sizeof(StorageBlob), blobSize, fd) != blobSize) {
-        fclose(fd);
+    size_t size = static_cast<size_t>(fileStat.st_size);
+    void *addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        return GattStatus::INTERNAL_ERROR;
+    }
+    auto file = std::make_unique<MappedFile>(addr, size);
+
+    const uint8_t *data = file->Data();
+    uint32_t magic = GetUint32(data);
+    uint16_t version = GetUint16(data + sizeof(uint32_t));
+    uint16_t count = GetUint16(data + CACHE_HEADER_COUNT_OFFSET);
+    if (magic != CACHE_FILE_MAGIC || version != CACHE_FILE_VERSION ||
+        size != CACHE_HEADER_SIZE + count * CACHE_RECORD_SIZE) {
+        LOG_ERROR("%{public}s: invalid cache file, version %{public}hu", __FUNCTION__, version);
         return GattStatus::INTERNAL_ERROR;
     }
 
-    fclose(fd);
-
+    storedFile_ = std::move(file);
     return GattStatus::GATT_SUCCESS;
 }
 
-std::vector<GattCache::StorageBlob> GattCache::ReadStorageBlobFromFile(const GattDevice &address) const
+bool GattCache::HasStoredDatabase() const
 {
-    FILE* fd = fopen(GenerateGattCacheFileName(address).c_str(), "rb");
-    if (fd == nullptr) {
-        return std::vector<StorageBlob>();
+    return storedFile_ != nullptr;
+}
+
+bool GattCache::ValidateDatabaseHash(const uint8_t *hash, size_t len)
+{
+    databaseHash_.clear();
+    if (hash != nullptr && len == DATABASE_HASH_SIZE) {
+        databaseHash_.assign(hash, hash + len);
     }
 
-    uint16_t blobSize = 0;
-    if (fread(&blobSize, sizeof(uint16_t), 1, fd) != 1) {
-        fclose(fd);
-        return std::vector<StorageBlob>();
+    if (storedFile_ != nullptr && databaseHash_.size() == DATABASE_HASH_SIZE &&
+        memcmp(storedFile_->Data() + CACHE_HEADER_HASH_OFFSET, databaseHash_.data(), DATABASE_HASH_SIZE) == 0) {
+        isValid_ = true;
+        isComplete_ = false;
+    } else {
+        storedFile_ = nullptr;
+        isValid_ = false;
     }
+    return isValid_;
+}
 
-    std::vector<StorageBlob> blob(blobSize, {0, {}, {}});
-    if (fread(blob.data(), sizeof(StorageBlob), blobSize, fd) != blobSize) {
-        fclose(fd);
-        return std::vector<StorageBlob>();
+bool GattCache::IsValid() const
+{
+    return isValid_;
+}
+
+void GattCache::Invalidate()
+{
+    // The hash read on connect describes the database before the change, it must not validate the rediscovered one.
+    databaseHash_.clear();
+    isValid_ = false;
+}
+
+void GattCache::SetComplete()
+{
+    isComplete_ = true;
+    isValid_ = databaseHash_.size() == DATABASE_HASH_SIZE;
+}
+
+void GattCache::Materialize()
+{
+    if (storedFile_ == nullptr || !isValid_) {
+        return;
     }
+    auto file = std::move(storedFile_);
+    services_.clear();
+    valueHandleMap_.clear();
 
-    fclose(fd);
-    return blob;
+    const uint8_t *data = file->Data();
+    uint16_t count = GetUint16(data + CACHE_HEADER_COUNT_OFFSET);
+    const uint8_t *record = data + CACHE_HEADER_SIZE;
+    uint16_t currentSvcHandle = 0;
+    uint16_t currentCccHandle = 0;
+    for (uint16_t i = 0; i < count; i++, record += CACHE_RECORD_SIZE) {
+        uint8_t type = record[0];
+        uint8_t properties = record[1];
+        uint16_t handle = GetUint16(record + sizeof(uint16_t));
+        uint16_t handle1 = GetUint16(record + sizeof(uint16_t) * 0x02);
+        uint16_t handle2 = GetUint16(record + sizeof(uint16_t) * 0x03);
+        Uuid uuid = Uuid::ConvertFromBytesLE(record + CACHE_RECORD_UUID_OFFSET, DATABASE_HASH_SIZE);
+        switch (type) {
+            case RECORD_PRIMARY_SERVICE:
+            case RECORD_SECONDARY_SERVICE:
+                AddService(GattCache::Service(type == RECORD_PRIMARY_SERVICE, handle, handle1, uuid));
+                currentSvcHandle = handle;
+                break;
+            case RECORD_INCLUDE_SERVICE:
+                AddIncludeService(currentSvcHandle, GattCache::IncludeService(handle, handle1, handle2, uuid));
+                break;
+            case RECORD_CHARACTERISTIC:
+                AddCharacteristic(currentSvcHandle, GattCache::Characteristic(handle, properties, handle1, uuid));
+                currentCccHandle = handle;
+                break;
+            case RECORD_DESCRIPTOR:
+                AddDescriptor(currentCccHandle, GattCache::Descriptor(handle, uuid));
+                break;
+            default:
+                LOG_ERROR("%{public}s: invalid record type %{public}hhu", __FUNCTION__, type);
+                services_.clear();
+                valueHandleMap_.clear();
+                isValid_ = false;
+                return;
+        }
+    }
+}
+
+std::string GattCache::GenerateGattCacheFileName(const GattDevice &address)
+{
+    return (GATT_STORAGE_PRIFIX + address.addr_.GetAddress() + "_" +
+           ((address.transport_ == GATT_TRANSPORT_TYPE_CLASSIC) ? "CLASSIC" : "LE"));
 }
-}  // namespace bluetooth
\ No newline at end of file
+}  // namespace bluetooth
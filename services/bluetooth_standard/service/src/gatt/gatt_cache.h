@@ -18,6 +18,7 @@
 
 #include <cstdint>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 #include "base_def.h"
@@ -98,37 +99,33 @@ public:
     Descriptors GetDescriptors(uint16_t cccHandle);
     const GattCache::Characteristic *GetCharacteristic(int16_t valueHandle);
     const GattCache::Descriptor *GetDescriptor(int16_t valueHandle);
-    uint16_t GetCharacteristicEndHandle(uint16_t serviceHandle, uint16_t cccHandle) const;
+    uint16_t GetCharacteristicEndHandle(uint16_t serviceHandle, uint16_t cccHandle);
 
     int StoredToFile(const GattDevice& address) const;
     int LoadFromFile(const GattDevice& address);
+    bool HasStoredDatabase() const;
+    bool ValidateDatabaseHash(const uint8_t *hash, size_t len);
+    bool IsValid() const;
+    void Invalidate();
+    void SetComplete();
 
     GattCache(GattCache &&src) = default;
     GattCache &operator=(GattCache &&src) = default;
 
 private:
-    struct StorageBlob {
-        uint16_t handle_;
-        Uuid type_;
-
-        union {
-            struct {
-                Uuid uuid_;
-                uint16_t endHandle_;
-            } service_;
-
-            struct {
-                uint16_t handle_;
-                uint16_t endHandle_;
-                Uuid uuid_;
-            } includeService_;
-
-            struct {
-                uint8_t properties_;
-                uint16_t valueHandle_;
-                Uuid uuid_;
-            } characteristic_;
-        } value_;
+    // Read only mapping of a cache file.
+    struct MappedFile {
+        MappedFile(void *addr, size_t size) : addr_(addr), size_(size)
+        {}
+        ~MappedFile();
+        const uint8_t *Data() const
+        {
+            return static_cast<const uint8_t *>(addr_);
+        }
+
+        void *addr_ = nullptr;
+        size_t size_ = 0;
+        DISALLOW_COPY_AND_ASSIGN(MappedFile);
     };
 
     static const std::string GATT_STORAGE_PRIFIX;
@@ -139,10 +136,16 @@ private:
     // if value handle belong to descriptor, parent handle is characteristic handle witch descriptor belong to.
     // else parent handle is characteristic handle.
     std::map<uint16_t, std::pair<uint16_t, uint16_t>> valueHandleMap_ = {};
+    // Cache file loaded on connect, turned into services_ on first access once the database hash matches.
+    std::unique_ptr<MappedFile> storedFile_ = nullptr;
+    // Database Hash read from remote on this connection.
+    std::vector<uint8_t> databaseHash_ = {};
+    bool isValid_ = false;
+    bool isComplete_ = false;
 
     static std::string GenerateGattCacheFileName(const GattDevice &address);
-    int WriteStorageBlobToFile(const GattDevice& address, std::vector<StorageBlob> &blob) const;
-    std::vector<StorageBlob> ReadStorageBlobFromFile(const GattDevice &address) const;
+    void Materialize();
+    bool SerializeTo(std::vector<uint8_t> &out) const;
 
     DISALLOW_COPY_AND_ASSIGN(GattCache);
 };
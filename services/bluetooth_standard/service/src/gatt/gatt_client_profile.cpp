@@ -14,6 +14,9 @@
  */
 
 #include "gatt_client_profile.h"
+#include <algorithm>
+#include <set>
+#include <vector>
 #include "att.h"
 #include "bt_def.h"
 #include "gatt_connection_manager.h"
@@ -25,14 +28,55 @@
 namespace bluetooth {
 struct GattClientProfile::impl {
     class GattConnectionObserverImplement;
+    /**
+     * @brief Database discovery of one connection. Each stage sweeps the whole handle range with one request type and
+     * assigns the returned attributes to their owners by handle, instead of issuing requests service by service.
+     */
+    struct DiscoveryPlan {
+        enum Stage { SERVICES, INCLUDE_SERVICES, INCLUDE_UUIDS, CHARACTERISTICS, DESCRIPTORS };
+        struct Characteristic {
+            uint16_t handle_;
+            uint16_t valueHandle_;
+            uint16_t serviceHandle_;
+            uint16_t serviceEndHandle_;
+        };
+        // descriptor ranges separated by no more handles than this are swept by one request
+        static constexpr uint16_t DESCRIPTOR_SWEEP_MAX_GAP = 4;
+        // request that started the discovery, its id tags the ATT requests
+        int reqId_ = 0;
+        // every request completed by the discovery, a request on a link already discovering joins the running plan
+        std::vector<int> waiters_ = {};
+        Stage stage_ = SERVICES;
+        // last handle swept by include and characteristic discovery
+        uint16_t endHandle_ = MAX_ATTRIBUTE_HANDLE;
+        // start and end handle of every service, sorted by start handle
+        std::vector<std::pair<uint16_t, uint16_t>> services_ = {};
+        // include services whose 128bit uuid must be read, as <service handle, include service>
+        std::vector<std::pair<uint16_t, GattCache::IncludeService>> includes_ = {};
+        std::vector<Characteristic> characteristics_ = {};
+        // handle ranges that may hold descriptors, sorted and disjoint
+        std::vector<std::pair<uint16_t, uint16_t>> descriptorRanges_ = {};
+        size_t rangeIndex_ = 0;
+        // characteristic handle owning each handle from descriptorBase_, 0 if the handle is not a descriptor
+        std::vector<uint16_t> descriptorOwner_ = {};
+        uint16_t descriptorBase_ = 0;
+
+        const std::pair<uint16_t, uint16_t> *FindService(uint16_t handle) const;
+        uint16_t FindDescriptorOwner(uint16_t handle) const;
+        void BuildDescriptorRanges();
+    };
     GattClientProfileCallback *pClientCallBack_ = nullptr;
     int connectionObserverId_ = 0;
     utility::Dispatcher *dispatcher_;
     std::map<uint16_t, GattCache> cacheMap_ = {};
     std::map<uint16_t, MtuInfo> mtuInfo_ = {};
     std::list<std::pair<uint16_t, GattRequestInfo>> requestList_ = {};
-    std::list<std::pair<uint16_t, GattRequestInfo>> responseList_ = {};
+    // requests waiting for response, per connection
+    std::map<uint16_t, std::list<std::pair<uint16_t, GattRequestInfo>>> responseList_ = {};
+    std::map<uint16_t, DiscoveryPlan> discoveryPlans_ = {};
     std::list<std::pair<uint16_t, ReadValCache>> readValCache_ = {};
+    // connections waiting for Database Hash
+    std::set<uint16_t> hashReading_ = {};
     std::unique_ptr<GattConnectionObserverImplement> connectionCallBack_ = {};
     GattClientProfile *profile_ = nullptr;
     impl(GattClientProfileCallback *pClientCallbackFunc, utility::Dispatcher *dispatcher, GattClientProfile &profile)
@@ -120,13 +164,22 @@ struct GattClientProfile::impl {
     void AddReadValueCache(uint16_t connectHandle, uint16_t handle, uint16_t offset, Buffer *data);
     uint8_t *GetReadValueCache(uint16_t connectHandle, uint16_t handle);
     void CreateCache(uint16_t connectHandle, const GattDevice device);
+    void ReadDatabaseHash(uint16_t connectHandle);
+    void DatabaseHashParsing(uint16_t connectHandle, const uint8_t *value, size_t len);
     void DeleteCache(uint16_t connectHandle, const GattDevice device);
     void DeleteList(uint16_t connectHandle);
     std::list<std::pair<uint16_t, GattRequestInfo>>::iterator FindIteratorByRequestInfor(uint16_t connectHandle);
-    std::list<std::pair<uint16_t, GattRequestInfo>>::iterator FindIteratorByResponesInfor(
-        uint16_t handle, uint16_t respType);
-    std::list<std::pair<uint16_t, GattRequestInfo>>::iterator FindIteratorByResponesInfor(
-        uint16_t handle, ResponesType respType);
+    static std::list<std::pair<uint16_t, GattRequestInfo>>::iterator FindIteratorByResponesInfor(
+        std::list<std::pair<uint16_t, GattRequestInfo>> &respList, uint16_t respType);
+    void DiscoverDatabaseParsing(uint16_t connectHandle, uint16_t event, AttEventData *data, Buffer *buffer,
+        std::list<std::pair<uint16_t, GattRequestInfo>>::iterator iter);
+    void DiscoverDatabaseServicesParsing(uint16_t connectHandle, DiscoveryPlan &plan, AttEventData *data);
+    void DiscoverDatabaseIncludesParsing(uint16_t connectHandle, DiscoveryPlan &plan, AttEventData *data);
+    void DiscoverDatabaseIncludeUuidParsing(uint16_t connectHandle, DiscoveryPlan &plan, Buffer *buffer);
+    void DiscoverDatabaseCharacteristicsParsing(uint16_t connectHandle, DiscoveryPlan &plan, AttEventData *data);
+    void DiscoverDatabaseDescriptorsParsing(uint16_t connectHandle, DiscoveryPlan &plan, AttEventData *data);
+    void DiscoverDatabaseNext(uint16_t connectHandle, DiscoveryPlan &plan, uint16_t startHandle);
+    void DiscoverDatabaseComplete(uint16_t connectHandle, int result);
 };
 /**
  * @brief A constructor used to create <pClientCallbackFunc> and <dispatcher> instance..
@@ -158,7 +211,9 @@ void GattClientProfile::Enable() const
     pimpl->cacheMap_.clear();
     pimpl->requestList_.clear();
     pimpl->responseList_.clear();
+    pimpl->discoveryPlans_.clear();
     pimpl->mtuInfo_.clear();
+    pimpl->hashReading_.clear();
     pimpl->RegisterCallbackToATT();
 }
 /**
@@ -418,6 +473,31 @@ void GattClientProfile::DiscoverAllCharacteristicDescriptors(
             *pimpl->cacheMap_.find(connectHandle)->second.GetDescriptors(startHandle).first);
     }
 }
+/**
+ * @brief This procedure is used by a client to discover the whole database of a server: primary services, include
+ * services, characteristics and descriptors. Each stage sweeps the handle range of all services, so the number of
+ * round trips depends on the database size instead of the number of services.
+ *
+ * @param reqId Indicates request id.
+ * @param connectHandle Indicates identify a connection.
+ * @since 6.0
+ */
+void GattClientProfile::DiscoverDatabase(int reqId, uint16_t connectHandle) const
+{
+    LOG_INFO("%{public}s: connectHandle is %hu.", __FUNCTION__, connectHandle);
+    auto running = pimpl->discoveryPlans_.find(connectHandle);
+    if (running != pimpl->discoveryPlans_.end()) {
+        LOG_INFO("%{public}s: join the running discovery of request %{public}d", __FUNCTION__, running->second.reqId_);
+        running->second.waiters_.push_back(reqId);
+        return;
+    }
+    // Only a new sweep starts from an empty cache, a joining request must not wipe what the running one has found.
+    ClearCacheMap(connectHandle);
+    auto &plan = pimpl->discoveryPlans_[connectHandle];
+    plan.reqId_ = reqId;
+    plan.waiters_.push_back(reqId);
+    pimpl->DiscoverDatabaseNext(connectHandle, plan, MIN_ATTRIBUTE_HANDLE);
+}
 /**
  * @brief This sub-procedure is used to read a Characteristic Value from a server.
  *
@@ -768,6 +848,58 @@ uint16_t GattClientProfile::GetCharacteristicEndHandle(
     }
     return 0;
 }
+/**
+ * @brief Check whether the cache matches the remote database, so discovery can be skipped.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @return Returns true if the cache is valid.
+ * @since 6.0
+ */
+bool GattClientProfile::IsCacheValid(uint16_t connectHandle) const
+{
+    auto cache = pimpl->cacheMap_.find(connectHandle);
+    if (cache != pimpl->cacheMap_.end()) {
+        return cache->second.IsValid();
+    }
+    return false;
+}
+/**
+ * @brief Check whether the Database Hash of the connection is being read.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @return Returns true if the Database Hash is being read.
+ * @since 6.0
+ */
+bool GattClientProfile::IsCacheValidating(uint16_t connectHandle) const
+{
+    return pimpl->hashReading_.find(connectHandle) != pimpl->hashReading_.end();
+}
+/**
+ * @brief Mark the cache as fully discovered, it is stored when the device disconnected.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @since 6.0
+ */
+void GattClientProfile::SetCacheComplete(uint16_t connectHandle) const
+{
+    auto cache = pimpl->cacheMap_.find(connectHandle);
+    if (cache != pimpl->cacheMap_.end()) {
+        cache->second.SetComplete();
+    }
+}
+/**
+ * @brief Invalidate the cache when remote database changed, next discovery is done over the air.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @since 6.0
+ */
+void GattClientProfile::InvalidateCache(uint16_t connectHandle) const
+{
+    auto cache = pimpl->cacheMap_.find(connectHandle);
+    if (cache != pimpl->cacheMap_.end()) {
+        cache->second.Invalidate();
+    }
+}
 
 /**
  * @brief This sub-procedure is used by the client to obtain services.
@@ -846,13 +978,18 @@ void GattClientProfile::impl::ReceiveData(
     } else if (event == ATT_HANDLE_VALUE_INDICATION_ID) {
         object->IndicationParsing(connectHandle, data, buffer);
     } else {
-        auto attResp = object->FindIteratorByResponesInfor(connectHandle, event);
-        if (attResp == object->responseList_.end()) {
+        auto respList = object->responseList_.find(connectHandle);
+        if (respList == object->responseList_.end()) {
+            LOG_INFO("%{public}s: attResp is null", __FUNCTION__);
+            return;
+        }
+        auto attResp = FindIteratorByResponesInfor(respList->second, event);
+        if (attResp == respList->second.end()) {
             LOG_INFO("%{public}s: attResp is null", __FUNCTION__);
             return;
         }
         object->ReceiveDataProcess(connectHandle, event, data, buffer, attResp);
-        object->responseList_.erase(attResp);
+        respList->second.erase(attResp);
     }
 }
 /**
@@ -869,6 +1006,11 @@ void GattClientProfile::impl::ReceiveData(
 void GattClientProfile::impl::ReceiveDataProcess(uint16_t connectHandle, uint16_t event, AttEventData *data,
     Buffer *buffer, std::list<std::pair<uint16_t, GattRequestInfo>>::iterator attResp)
 {
+    if (attResp->second.reqType_ == DISCOVER_DATABASE) {
+        DiscoverDatabaseParsing(connectHandle, event, data, buffer, attResp);
+        return;
+    }
+
     switch (event) {
         case ATT_ERROR_RESPONSE_ID:
             ErrorResponseParsing(connectHandle, data, attResp);
@@ -1012,6 +1154,12 @@ void GattClientProfile::impl::IndicateRequestRetToService(
             break;
         case WRITE_WITHOUT_RESPONSE:
             break;
+        case READ_DATABASE_HASH:
+            DatabaseHashParsing(connectHandle, nullptr, 0);
+            break;
+        case DISCOVER_DATABASE:
+            DiscoverDatabaseComplete(connectHandle, ret);
+            break;
         default:
             LOG_ERROR("%{public}s: request type is not find!", __FUNCTION__);
             break;
@@ -1061,8 +1209,9 @@ void GattClientProfile::impl::AddResponseList(void)
 {
     auto iter = requestList_.begin();
     if (iter != requestList_.end()) {
-        responseList_.emplace_back(*iter);
-        LOG_INFO("%{public}s: responseList size: %{public}d", __FUNCTION__, responseList_.size());
+        auto &respList = responseList_[iter->first];
+        respList.emplace_back(*iter);
+        LOG_INFO("%{public}s: responseList size: %{public}zu", __FUNCTION__, respList.size());
         dispatcher_->PostTask(std::bind(&impl::RemoveRequestList, this, iter));
     }
 }
@@ -1511,6 +1660,431 @@ void GattClientProfile::impl::DiscoverAllCharacteristicDescriptorsParsing(
         ATT_FindInformationRequest(connectHandle, ++attHandle, iter->second.endHandle_);
     }
 }
+/**
+ * @brief Find the service containing the attribute.
+ *
+ * @param handle Indicates attribute handle.
+ * @return Returns start and end handle of the service, nullptr if the handle is outside of all services.
+ * @since 6.0
+ */
+const std::pair<uint16_t, uint16_t> *GattClientProfile::impl::DiscoveryPlan::FindService(uint16_t handle) const
+{
+    auto it = std::upper_bound(services_.begin(), services_.end(), std::make_pair(handle, MAX_ATTRIBUTE_HANDLE));
+    if (it == services_.begin()) {
+        return nullptr;
+    }
+    --it;
+    return (handle <= it->second) ? &(*it) : nullptr;
+}
+/**
+ * @brief Find the characteristic owning the descriptor.
+ *
+ * @param handle Indicates attribute handle.
+ * @return Returns characteristic handle, INVALID_ATTRIBUTE_HANDLE if the handle is not a descriptor.
+ * @since 6.0
+ */
+uint16_t GattClientProfile::impl::DiscoveryPlan::FindDescriptorOwner(uint16_t handle) const
+{
+    if (handle < descriptorBase_ || static_cast<size_t>(handle - descriptorBase_) >= descriptorOwner_.size()) {
+        return INVALID_ATTRIBUTE_HANDLE;
+    }
+    return descriptorOwner_[handle - descriptorBase_];
+}
+/**
+ * @brief Build the handle ranges that may hold descriptors: from the handle after the characteristic value to the
+ * handle before the next characteristic declaration or the end of the service.
+ *
+ * @since 6.0
+ */
+void GattClientProfile::impl::DiscoveryPlan::BuildDescriptorRanges()
+{
+    std::vector<uint16_t> owners;
+    std::sort(characteristics_.begin(), characteristics_.end(),
+        [](const Characteristic &a, const Characteristic &b) { return a.handle_ < b.handle_; });
+    for (size_t i = 0; i < characteristics_.size(); i++) {
+        auto &ccc = characteristics_[i];
+        uint16_t endHandle = ccc.serviceEndHandle_;
+        if (i + 1 < characteristics_.size() && characteristics_[i + 1].serviceHandle_ == ccc.serviceHandle_) {
+            endHandle = characteristics_[i + 1].handle_ - MIN_ATTRIBUTE_HANDLE;
+        }
+        if (ccc.valueHandle_ < endHandle) {
+            descriptorRanges_.emplace_back(ccc.valueHandle_ + MIN_ATTRIBUTE_HANDLE, endHandle);
+            owners.push_back(ccc.handle_);
+        }
+    }
+    if (descriptorRanges_.empty()) {
+        return;
+    }
+
+    descriptorBase_ = descriptorRanges_.front().first;
+    descriptorOwner_.assign(descriptorRanges_.back().second - descriptorBase_ + 1, INVALID_ATTRIBUTE_HANDLE);
+    for (size_t i = 0; i < descriptorRanges_.size(); i++) {
+        std::fill(descriptorOwner_.begin() + (descriptorRanges_[i].first - descriptorBase_),
+            descriptorOwner_.begin() + (descriptorRanges_[i].second - descriptorBase_ + 1),
+            owners[i]);
+    }
+}
+/**
+ * @brief This sub-procedure is used by the client to send the next request of database discovery.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @param plan Indicates discovery plan of the connection.
+ * @param startHandle Indicates starting handle of the request, INVALID_ATTRIBUTE_HANDLE if the stage is done.
+ * @since 6.0
+ */
+void GattClientProfile::impl::DiscoverDatabaseNext(uint16_t connectHandle, DiscoveryPlan &plan, uint16_t startHandle)
+{
+    BtUuid primarySvcUuid = {BT_UUID_16, {UUID_PRIMARY_SERVICE}};
+    BtUuid includeSvcUuid = {BT_UUID_16, {UUID_INCLUDE_SERVICE}};
+    BtUuid characteristicUuid = {BT_UUID_16, {UUID_CHARACTERISTIC}};
+
+    while (true) {
+        switch (plan.stage_) {
+            case DiscoveryPlan::SERVICES:
+                if (startHandle != INVALID_ATTRIBUTE_HANDLE) {
+                    requestList_.emplace_back(connectHandle,
+                        GattRequestInfo(DISCOVER_DATABASE, startHandle, MAX_ATTRIBUTE_HANDLE, plan.reqId_));
+                    ATT_ReadByGroupTypeRequest(connectHandle, startHandle, MAX_ATTRIBUTE_HANDLE, &primarySvcUuid);
+                    return;
+                }
+                if (plan.services_.empty()) {
+                    DiscoverDatabaseComplete(connectHandle, GATT_SUCCESS);
+                    return;
+                }
+                std::sort(plan.services_.begin(), plan.services_.end());
+                plan.endHandle_ = plan.services_.back().second;
+                plan.stage_ = DiscoveryPlan::INCLUDE_SERVICES;
+                startHandle = plan.services_.front().first;
+                break;
+            case DiscoveryPlan::INCLUDE_SERVICES:
+                if (startHandle != INVALID_ATTRIBUTE_HANDLE && startHandle <= plan.endHandle_) {
+                    requestList_.emplace_back(
+                        connectHandle, GattRequestInfo(DISCOVER_DATABASE, startHandle, plan.endHandle_, plan.reqId_));
+                    ATT_ReadByTypeRequest(connectHandle, startHandle, plan.endHandle_, &includeSvcUuid);
+                    return;
+                }
+                plan.stage_ = DiscoveryPlan::INCLUDE_UUIDS;
+                break;
+            case DiscoveryPlan::INCLUDE_UUIDS:
+                if (!plan.includes_.empty()) {
+                    startHandle = plan.includes_.back().second.startHandle_;
+                    requestList_.emplace_back(
+                        connectHandle, GattRequestInfo(DISCOVER_DATABASE, startHandle, startHandle, plan.reqId_));
+                    ATT_ReadRequest(connectHandle, startHandle);
+                    return;
+                }
+                // Secondary services found by include declarations may lie after the last primary service.
+                plan.endHandle_ = plan.services_.back().second;
+                plan.stage_ = DiscoveryPlan::CHARACTERISTICS;
+                startHandle = plan.services_.front().first;
+                break;
+            case DiscoveryPlan::CHARACTERISTICS:
+                if (startHandle != INVALID_ATTRIBUTE_HANDLE && startHandle <= plan.endHandle_) {
+                    requestList_.emplace_back(
+                        connectHandle, GattRequestInfo(DISCOVER_DATABASE, startHandle, plan.endHandle_, plan.reqId_));
+                    ATT_ReadByTypeRequest(connectHandle, startHandle, plan.endHandle_, &characteristicUuid);
+                    return;
+                }
+                plan.BuildDescriptorRanges();
+                plan.stage_ = DiscoveryPlan::DESCRIPTORS;
+                startHandle = plan.descriptorRanges_.empty() ? INVALID_ATTRIBUTE_HANDLE
+                                                             : plan.descriptorRanges_.front().first;
+                break;
+            case DiscoveryPlan::DESCRIPTORS: {
+                auto &ranges = plan.descriptorRanges_;
+                // Skip the handles between candidate ranges, they hold no descriptors.
+                while (plan.rangeIndex_ < ranges.size() &&
+                       (startHandle == INVALID_ATTRIBUTE_HANDLE || ranges[plan.rangeIndex_].second < startHandle)) {
+                    plan.rangeIndex_++;
+                }
+                if (plan.rangeIndex_ >= ranges.size()) {
+                    DiscoverDatabaseComplete(connectHandle, GATT_SUCCESS);
+                    return;
+                }
+                startHandle = std::max(startHandle, ranges[plan.rangeIndex_].first);
+                // Ranges separated by a few handles are cheaper to cover with one request.
+                uint16_t endHandle = ranges[plan.rangeIndex_].second;
+                for (size_t i = plan.rangeIndex_ + 1;
+                     i < ranges.size() && ranges[i].first - endHandle <= DiscoveryPlan::DESCRIPTOR_SWEEP_MAX_GAP;
+                     i++) {
+                    endHandle = ranges[i].second;
+                }
+                requestList_.emplace_back(
+                    connectHandle, GattRequestInfo(DISCOVER_DATABASE, startHandle, endHandle, plan.reqId_));
+                ATT_FindInformationRequest(connectHandle, startHandle, endHandle);
+                return;
+            }
+            default:
+                return;
+        }
+    }
+}
+/**
+ * @brief This sub-procedure is used by the client to process responses of database discovery.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @param event Indicates client callback event id.
+ * @param data Indicates att data.
+ * @param buffer Indicates att data.
+ * @param iter Indicates iterator of client request information.
+ * @since 6.0
+ */
+void GattClientProfile::impl::DiscoverDatabaseParsing(uint16_t connectHandle, uint16_t event, AttEventData *data,
+    Buffer *buffer, std::list<std::pair<uint16_t, GattRequestInfo>>::iterator iter)
+{
+    auto plan = discoveryPlans_.find(connectHandle);
+    if (plan == discoveryPlans_.end()) {
+        LOG_ERROR("%{public}s: No discovery plan of connectHandle %hu", __FUNCTION__, connectHandle);
+        return;
+    }
+
+    switch (event) {
+        case ATT_READ_BY_GROUP_TYPE_RESPONSE_ID:
+            DiscoverDatabaseServicesParsing(connectHandle, plan->second, data);
+            break;
+        case ATT_READ_BY_TYPE_RESPONSE_ID:
+            if (plan->second.stage_ == DiscoveryPlan::INCLUDE_SERVICES) {
+                DiscoverDatabaseIncludesParsing(connectHandle, plan->second, data);
+            } else {
+                DiscoverDatabaseCharacteristicsParsing(connectHandle, plan->second, data);
+            }
+            break;
+        case ATT_READ_RESPONSE_ID:
+            DiscoverDatabaseIncludeUuidParsing(connectHandle, plan->second, buffer);
+            break;
+        case ATT_FIND_INFORMATION_RESPONSE_ID:
+            DiscoverDatabaseDescriptorsParsing(connectHandle, plan->second, data);
+            break;
+        case ATT_ERROR_RESPONSE_ID:
+            if (plan->second.stage_ == DiscoveryPlan::INCLUDE_UUIDS) {
+                // The include service is kept without uuid, as the single service discovery does.
+                DiscoverDatabaseIncludeUuidParsing(connectHandle, plan->second, nullptr);
+            } else if (data->attErrorResponse.errorCode == ATT_ATTRIBUTE_NOT_FOUND) {
+                DiscoverDatabaseNext(
+                    connectHandle, plan->second, static_cast<uint16_t>(iter->second.endHandle_ + MIN_ATTRIBUTE_HANDLE));
+            } else {
+                DiscoverDatabaseComplete(connectHandle, ConvertResponseErrorCode(data->attErrorResponse.errorCode));
+            }
+            break;
+        case ATT_TRANSACTION_TIME_OUT_ID:
+            GattRequestTimeoutParsing(iter->second.reqId_, connectHandle, iter->second.reqType_);
+            break;
+        default:
+            LOG_ERROR("GATT client profile: %{public}s. It's invalid opcode.", __FUNCTION__);
+            break;
+    }
+}
+/**
+ * @brief This sub-procedure is used by the client to process primary services of database discovery.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @param plan Indicates discovery plan of the connection.
+ * @param data Indicates att data.
+ * @since 6.0
+ */
+void GattClientProfile::impl::DiscoverDatabaseServicesParsing(
+    uint16_t connectHandle, DiscoveryPlan &plan, AttEventData *data)
+{
+    auto cache = cacheMap_.find(connectHandle);
+    uint16_t endHandle = MAX_ATTRIBUTE_HANDLE;
+    uint16_t num = data->attReadByGroupTypeResponse.readGroupResponse.num;
+    uint16_t len = data->attReadByGroupTypeResponse.readGroupResponse.length;
+    uint8_t value[UUID_128BIT_LEN] = {0};
+    uint8_t uuidLen = len - sizeof(uint16_t) - sizeof(endHandle);
+
+    for (uint16_t i = 0; i < num; i++) {
+        uint8_t offset = 0;
+        auto attribute = data->attReadByGroupTypeResponse.readGroupResponse.attributeData + i;
+        uint16_t startHandle = attribute->attHandle;
+        endHandle = attribute->groupEndHandle;
+        SplitDataPackage(value, UUID_128BIT_LEN, &offset, attribute->attributeValue, uuidLen);
+        Uuid uuid = SplitUuidPackage(value, uuidLen);
+        plan.services_.emplace_back(startHandle, endHandle);
+        dispatcher_->PostTask(std::bind(
+            &GattCache::AddService, &cache->second, std::move(GattCache::Service(true, startHandle, endHandle, uuid))));
+    }
+    DiscoverDatabaseNext(connectHandle, plan, static_cast<uint16_t>(endHandle + MIN_ATTRIBUTE_HANDLE));
+}
+/**
+ * @brief This sub-procedure is used by the client to process include services of database discovery.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @param plan Indicates discovery plan of the connection.
+ * @param data Indicates att data.
+ * @since 6.0
+ */
+void GattClientProfile::impl::DiscoverDatabaseIncludesParsing(
+    uint16_t connectHandle, DiscoveryPlan &plan, AttEventData *data)
+{
+    auto cache = cacheMap_.find(connectHandle);
+    uint16_t isvcHandle = INVALID_ATTRIBUTE_HANDLE;
+    uint8_t len = data->attReadByTypeResponse.readHandleListNum.len;
+    uint16_t num = data->attReadByTypeResponse.readHandleListNum.valueNum;
+
+    for (uint16_t i = 0; i < num; i++) {
+        uint8_t offset = 0;
+        auto attribute = data->attReadByTypeResponse.readHandleListNum.valueList + i;
+        isvcHandle = attribute->attHandle.attHandle;
+        uint16_t startHandle = SplitDataPackageToUint16(attribute->attributeValue, &offset);
+        uint16_t endHandle = SplitDataPackageToUint16(attribute->attributeValue, &offset);
+        auto service = plan.FindService(isvcHandle);
+        if (service == nullptr) {
+            LOG_ERROR("%{public}s: Include service %hu is outside of services", __FUNCTION__, isvcHandle);
+            continue;
+        }
+        uint16_t serviceHandle = service->first;
+
+        if (len == FIND_INCLUDE_SERVICE_LENGTH_16BIT) {
+            Uuid uuid = Uuid::ConvertFrom16Bits(SplitDataPackageToUint16(attribute->attributeValue, &offset));
+            dispatcher_->PostTask(std::bind(&GattCache::AddIncludeService,
+                &cache->second,
+                serviceHandle,
+                std::move(GattCache::IncludeService(isvcHandle, startHandle, endHandle, uuid))));
+            dispatcher_->PostTask(std::bind(&GattCache::AddService,
+                &cache->second,
+                std::move(GattCache::Service(false, startHandle, endHandle, uuid))));
+        } else {
+            plan.includes_.emplace_back(serviceHandle, GattCache::IncludeService(isvcHandle, startHandle, endHandle));
+        }
+
+        auto it = std::lower_bound(
+            plan.services_.begin(), plan.services_.end(), std::make_pair(startHandle, INVALID_ATTRIBUTE_HANDLE));
+        if (it == plan.services_.end() || it->first != startHandle) {
+            plan.services_.emplace(it, startHandle, endHandle);
+        }
+    }
+    DiscoverDatabaseNext(connectHandle,
+        plan,
+        (num == 0) ? INVALID_ATTRIBUTE_HANDLE : static_cast<uint16_t>(isvcHandle + MIN_ATTRIBUTE_HANDLE));
+}
+/**
+ * @brief This sub-procedure is used by the client to process 128bit uuid of include service of database discovery.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @param plan Indicates discovery plan of the connection.
+ * @param buffer Indicates 128bit uuid, nullptr if reading failed.
+ * @since 6.0
+ */
+void GattClientProfile::impl::DiscoverDatabaseIncludeUuidParsing(
+    uint16_t connectHandle, DiscoveryPlan &plan, Buffer *buffer)
+{
+    auto cache = cacheMap_.find(connectHandle);
+    auto &include = plan.includes_.back();
+
+    if (buffer != nullptr && BufferGetSize(buffer) == UUID_128BIT_LEN) {
+        include.second.uuid_ = Uuid::ConvertFromBytesLE((uint8_t *)BufferPtr(buffer), UUID_128BIT_LEN);
+    }
+    dispatcher_->PostTask(std::bind(&GattCache::AddIncludeService, &cache->second, include.first, include.second));
+    dispatcher_->PostTask(std::bind(&GattCache::AddService,
+        &cache->second,
+        std::move(GattCache::Service(
+            false, include.second.startHandle_, include.second.endHandle_, include.second.uuid_))));
+    plan.includes_.pop_back();
+    DiscoverDatabaseNext(connectHandle, plan, INVALID_ATTRIBUTE_HANDLE);
+}
+/**
+ * @brief This sub-procedure is used by the client to process characteristics of database discovery.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @param plan Indicates discovery plan of the connection.
+ * @param data Indicates att data.
+ * @since 6.0
+ */
+void GattClientProfile::impl::DiscoverDatabaseCharacteristicsParsing(
+    uint16_t connectHandle, DiscoveryPlan &plan, AttEventData *data)
+{
+    auto cache = cacheMap_.find(connectHandle);
+    uint16_t handle = INVALID_ATTRIBUTE_HANDLE;
+    uint16_t len = data->attReadByTypeResponse.readHandleListNum.len;
+    uint16_t num = data->attReadByTypeResponse.readHandleListNum.valueNum;
+    uint8_t value[GATT_VALUE_LEN_MAX] = {0};
+    uint8_t uuidLen = len - sizeof(handle) - sizeof(uint8_t) - sizeof(uint16_t);
+
+    for (uint16_t i = 0; i < num; i++) {
+        uint8_t offset = 0;
+        auto attribute = data->attReadByTypeResponse.readHandleListNum.valueList + i;
+        handle = attribute->attHandle.attHandle;
+        uint8_t properties = SplitDataPackageToUint8(attribute->attributeValue, &offset);
+        uint16_t valueHandle = SplitDataPackageToUint16(attribute->attributeValue, &offset);
+        SplitDataPackage(value, GATT_VALUE_LEN_MAX, &offset, attribute->attributeValue, uuidLen);
+        Uuid uuid = SplitUuidPackage(value, uuidLen);
+        auto service = plan.FindService(handle);
+        if (service == nullptr) {
+            LOG_ERROR("%{public}s: Characteristic %hu is outside of services", __FUNCTION__, handle);
+            continue;
+        }
+
+        plan.characteristics_.push_back({handle, valueHandle, service->first, service->second});
+        dispatcher_->PostTask(std::bind(&GattCache::AddCharacteristic,
+            &cache->second,
+            service->first,
+            std::move(GattCache::Characteristic(handle, properties, valueHandle, uuid))));
+    }
+    DiscoverDatabaseNext(connectHandle,
+        plan,
+        (num == 0) ? INVALID_ATTRIBUTE_HANDLE : static_cast<uint16_t>(handle + MIN_ATTRIBUTE_HANDLE));
+}
+/**
+ * @brief This sub-procedure is used by the client to process descriptors of database discovery.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @param plan Indicates discovery plan of the connection.
+ * @param data Indicates att data.
+ * @since 6.0
+ */
+void GattClientProfile::impl::DiscoverDatabaseDescriptorsParsing(
+    uint16_t connectHandle, DiscoveryPlan &plan, AttEventData *data)
+{
+    Uuid uuid;
+    auto cache = cacheMap_.find(connectHandle);
+    uint16_t attHandle = INVALID_ATTRIBUTE_HANDLE;
+    uint16_t num = data->attFindInformationResponse.findInforRsponse.pairNum;
+    uint8_t format = data->attFindInformationResponse.findInforRsponse.format;
+
+    for (uint16_t i = 0; i < num; i++) {
+        if (format == UUID_16BIT_FORMAT) {
+            uuid = Uuid::ConvertFrom16Bits(
+                data->attFindInformationResponse.findInforRsponse.handleUuidPairs[i].uuid.uuid16);
+        } else if (format == UUID_128BIT_FORMAT) {
+            uuid = Uuid::ConvertFromBytesLE(
+                data->attFindInformationResponse.findInforRsponse.handleUuidPairs[i].uuid.uuid128, UUID_128BIT_LEN);
+        } else {
+            LOG_ERROR("%{public}s: FindInformationResponse format is failed. Format = %hhu", __FUNCTION__, format);
+            DiscoverDatabaseComplete(connectHandle, GATT_FAILURE);
+            return;
+        }
+        attHandle = data->attFindInformationResponse.findInforRsponse.handleUuidPairs[i].attHandle;
+        // Declarations and values between the swept ranges are not descriptors.
+        uint16_t cccHandle = plan.FindDescriptorOwner(attHandle);
+        if (cccHandle != INVALID_ATTRIBUTE_HANDLE) {
+            dispatcher_->PostTask(std::bind(
+                &GattCache::AddDescriptor, &cache->second, cccHandle, std::move(GattCache::Descriptor(attHandle, uuid))));
+        }
+    }
+    DiscoverDatabaseNext(connectHandle,
+        plan,
+        (num == 0) ? INVALID_ATTRIBUTE_HANDLE : static_cast<uint16_t>(attHandle + MIN_ATTRIBUTE_HANDLE));
+}
+/**
+ * @brief This sub-procedure is used by the client to finish database discovery.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @param result Indicates discovery result.
+ * @since 6.0
+ */
+void GattClientProfile::impl::DiscoverDatabaseComplete(uint16_t connectHandle, int result)
+{
+    auto plan = discoveryPlans_.find(connectHandle);
+    if (plan == discoveryPlans_.end()) {
+        return;
+    }
+    std::vector<int> waiters = std::move(plan->second.waiters_);
+    discoveryPlans_.erase(plan);
+    LOG_INFO("%{public}s: connectHandle is %hu, result is %{public}d", __FUNCTION__, connectHandle, result);
+    for (int reqId : waiters) {
+        pClientCallBack_->OnDiscoverDatabaseEvent(reqId, result, connectHandle);
+    }
+}
 /**
  * @brief This sub-procedure is used by the client to process read characteristic value.
  *
@@ -1709,6 +2283,13 @@ void GattClientProfile::impl::SplitReadByTypeRsp(
     uint16_t connectHandle, AttEventData *data, std::list<std::pair<uint16_t, GattRequestInfo>>::iterator iter)
 {
     LOG_INFO("%{public}s: connectHandle is %hu, respType is %{public}d.", __FUNCTION__, connectHandle, iter->second.reqType_);
+    if (iter->second.reqType_ == READ_DATABASE_HASH) {
+        uint16_t len = data->attReadByTypeResponse.readHandleListNum.len;
+        DatabaseHashParsing(connectHandle,
+            data->attReadByTypeResponse.readHandleListNum.valueList->attributeValue,
+            (len > sizeof(uint16_t)) ? (len - sizeof(uint16_t)) : 0);
+        return;
+    }
     switch (data->attReadByTypeResponse.readHandleListNum.len) {
         case DISCOVER_CHARACTERISTIC_LENGTH_16BIT:
         case DISCOVER_CHARACTERISTIC_LENGTH_128BIT:
@@ -1850,6 +2431,9 @@ void GattClientProfile::impl::SplitReadByTypeReqErrorParsing(
             pClientCallBack_->OnReadCharacteristicValueEvent(
                 iter->second.reqId_, iter->second.startHandle_, sharedPtr, 0, GATT_SUCCESS);
             break;
+        case READ_DATABASE_HASH:
+            DatabaseHashParsing(connectHandle, nullptr, 0);
+            break;
         case FIND_INCLUDE_SERVICE:
             pClientCallBack_->OnFindIncludedServicesEvent(iter->second.reqId_,
                 GATT_SUCCESS,
@@ -2125,7 +2709,7 @@ std::list<std::pair<uint16_t, GattRequestInfo>>::iterator GattClientProfile::imp
 }
 
 std::list<std::pair<uint16_t, GattRequestInfo>>::iterator GattClientProfile::impl::FindIteratorByResponesInfor(
-    uint16_t handle, uint16_t respType)
+    std::list<std::pair<uint16_t, GattRequestInfo>> &respList, uint16_t respType)
 {
     ResponesType type;
     std::list<std::pair<uint16_t, GattRequestInfo>>::iterator iter;
@@ -2158,26 +2742,10 @@ std::list<std::pair<uint16_t, GattRequestInfo>>::iterator GattClientProfile::imp
         case ATT_PREPARE_WRITE_RESPONSE_ID:
         case ATT_EXECUTE_WRITE_RESPONSE_ID:
         default:
-            for (iter = responseList_.begin(); iter != responseList_.end(); iter++) {
-                if (handle == iter->first) {
-                    break;
-                }
-            }
-            return iter;
-    }
-    for (iter = responseList_.begin(); iter != responseList_.end(); iter++) {
-        if (handle == iter->first && type == iter->second.reqType_) {
-            break;
-        }
+            return respList.begin();
     }
-    return iter;
-}
-std::list<std::pair<uint16_t, GattRequestInfo>>::iterator GattClientProfile::impl::FindIteratorByResponesInfor(
-    uint16_t handle, ResponesType respType)
-{
-    std::list<std::pair<uint16_t, GattRequestInfo>>::iterator iter;
-    for (iter = responseList_.begin(); iter != responseList_.end(); iter++) {
-        if (handle == iter->first && respType == iter->second.reqType_) {
+    for (iter = respList.begin(); iter != respList.end(); iter++) {
+        if (type == iter->second.reqType_ || DISCOVER_DATABASE == iter->second.reqType_) {
             break;
         }
     }
@@ -2195,7 +2763,48 @@ void GattClientProfile::impl::CreateCache(uint16_t connectHandle, const GattDevi
     auto cache = cacheMap_.emplace(connectHandle, std::move(GattCache()));
     if (device.isEncryption_ == true) {
         cache.first->second.LoadFromFile(device);
+        // The hash validates the stored cache, or is stored with the cache discovered on this connection.
+        ReadDatabaseHash(connectHandle);
+    }
+}
+/**
+ * @brief Read Database Hash characteristic of remote device.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @since 6.0
+ */
+void GattClientProfile::impl::ReadDatabaseHash(uint16_t connectHandle)
+{
+    BtUuid hashUuid = {BT_UUID_16, {UUID_DATABASE_HASH}};
+    hashReading_.emplace(connectHandle);
+    requestList_.emplace_back(connectHandle,
+        GattRequestInfo(READ_DATABASE_HASH,
+            MIN_ATTRIBUTE_HANDLE,
+            MAX_ATTRIBUTE_HANDLE,
+            Uuid::ConvertFrom16Bits(UUID_DATABASE_HASH),
+            0));
+    ATT_ReadByTypeRequest(connectHandle, MIN_ATTRIBUTE_HANDLE, MAX_ATTRIBUTE_HANDLE, &hashUuid);
+}
+/**
+ * @brief Validate the cache with the Database Hash read from remote device.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @param value Indicates Database Hash value, nullptr if remote device doesn't support.
+ * @param len Indicates value length.
+ * @since 6.0
+ */
+void GattClientProfile::impl::DatabaseHashParsing(uint16_t connectHandle, const uint8_t *value, size_t len)
+{
+    hashReading_.erase(connectHandle);
+    auto cache = cacheMap_.find(connectHandle);
+    if (cache == cacheMap_.end()) {
+        return;
     }
+    bool isStored = cache->second.HasStoredDatabase();
+    bool isValid = cache->second.ValidateDatabaseHash(value, len);
+    LOG_INFO("%{public}s: connectHandle is %hu, stored cache: %{public}d, valid: %{public}d",
+        __FUNCTION__, connectHandle, isStored, isValid);
+    pClientCallBack_->OnCacheValidatedEvent(connectHandle, isValid);
 }
 /**
  * @brief Delete cache when gatt is disconnected.
@@ -2212,6 +2821,7 @@ void GattClientProfile::impl::DeleteCache(uint16_t connectHandle, const GattDevi
             cache->second.StoredToFile(device);
         }
         cacheMap_.erase(cache);
+        hashReading_.erase(connectHandle);
         LOG_INFO("%{public}s, Device cache successfully deleted", __FUNCTION__);
     } else {
         LOG_ERROR("%{public}s:  Device cache does not exist", __FUNCTION__);
@@ -2300,14 +2910,8 @@ void GattClientProfile::impl::DeleteList(uint16_t connectHandle)
         }
     }
 
-    auto respList = responseList_.begin();
-    while (respList != responseList_.end()) {
-        if (connectHandle == respList->first) {
-            responseList_.erase(respList++);
-        } else {
-            respList++;
-        }
-    }
+    responseList_.erase(connectHandle);
+    discoveryPlans_.erase(connectHandle);
 }
 /**
  * @brief Indicates connect or disconnect.
@@ -59,6 +59,7 @@ public:
         int reqId, uint16_t connectHandle, uint16_t startHandle, uint16_t endHandle, const Uuid &uuid) const;
     void DiscoverAllCharacteristicDescriptors(
         int reqId, uint16_t connectHandle, uint16_t startHandle, uint16_t endHandle) const;
+    void DiscoverDatabase(int reqId, uint16_t connectHandle) const;
     void ReadCharacteristicValue(int reqId, uint16_t connectHandle, uint16_t handle) const;
     void ReadUsingCharacteristicByUuid(int reqId, uint16_t connectHandle, const Uuid &uuid) const;
     void ReadLongCharacteristicValue(int reqId, uint16_t connectHandle, uint16_t handle) const;
@@ -88,6 +89,10 @@ public:
     const GattCache::Service *GetService(uint16_t connectHandle, int16_t handle) const;
     const GattCache::Characteristic *GetCharacteristic(uint16_t connectHandle, int16_t valueHandle) const;
     const GattCache::Descriptor *GetDescriptor(uint16_t connectHandle, int16_t valueHandle) const;
+    bool IsCacheValid(uint16_t connectHandle) const;
+    bool IsCacheValidating(uint16_t connectHandle) const;
+    void SetCacheComplete(uint16_t connectHandle) const;
+    void InvalidateCache(uint16_t connectHandle) const;
     DISALLOW_COPY_AND_ASSIGN(GattClientProfile);
 
 private:
@@ -55,6 +55,7 @@ public:
         uint16_t serviceHandle, const std::map<uint16_t, GattCache::Characteristic> &characteristics){};
     virtual void OnDiscoverAllCharacteristicDescriptorsEvent(int reqId, int result, uint16_t serviceHandle,
         uint16_t characteristicHandle, const std::map<uint16_t, GattCache::Descriptor> &descriptors){};
+    virtual void OnDiscoverDatabaseEvent(int reqId, int result, uint16_t connectHandle){};
     virtual void OnReadCharacteristicValueEvent(int reqId, uint16_t handle, GattValue &value, size_t len, int result){};
     virtual void OnWriteCharacteristicValueEvent(int reqId, uint16_t connectHandle, uint16_t handle, int result){};
     virtual void OnWriteLongCharacteristicValueEvent(int reqId, uint16_t connectHandle, uint16_t handle, int result){};
@@ -67,6 +68,7 @@ public:
     virtual void OnReliableWriteCharacteristicValueEvent(
         int reqId, uint16_t handle, GattValue &value, size_t len, int result){};
     virtual void OnExecuteWriteValueEvent(int reqId, uint16_t connectHandle, int result){};
+    virtual void OnCacheValidatedEvent(uint16_t connectHandle, bool isValid){};
     virtual ~GattClientProfileCallback()
     {}
 };
@@ -15,7 +15,6 @@
 
 #include "gatt_client_service.h"
 #include <future>
-#include <queue>
 #include <set>
 #include "class_creator.h"
 #include "gatt_cache.h"
@@ -31,18 +30,14 @@
 namespace bluetooth {
 struct ClientApplication {
     struct Discover {
-        struct Task {
-            enum Type { SERVICE, INCLUDE_SERVICE, CHARACTERISTICS, DESCRIPTOR };
-            int type_ = 0;
-            uint16_t startHandle_ = 0;
-            uint16_t endHandle_ = 0;
-        };
-        std::queue<Task> tasks_ = {};
-        std::set<uint16_t> discovered_ = {};
+        // the whole database is discovered by one profile procedure
+        bool running_ = false;
+        // discovery is deferred until the cache is validated
+        bool waitCache_ = false;
         ClientApplication &client_;
         GattClientProfile &profile_;
 
-        bool DiscoverNext(int appId);
+        void Start(int appId);
         void Clear();
         Discover(ClientApplication &client, GattClientProfile &profile) : client_(client), profile_(profile)
         {}
@@ -111,14 +106,7 @@ struct GattClientService::impl : public GattServiceBase {
     void RequestConnectionPriority(int appId, int connPriority);
     void GetServices(int appId, std::promise<void> &promise, std::vector<Service> &services);
 
-    void OnDiscoverAllPrimaryServicesEvent(
-        int requestId, int ret, uint16_t connectHandle, const std::map<uint16_t, GattCache::Service> &services);
-    void OnFindIncludedServicesEvent(int requestId, int ret, uint16_t connectHandle, uint16_t serviceHandle,
-        const std::vector<GattCache::IncludeService> &services);
-    void OnDiscoverAllCharacteristicOfServiceEvent(int requestId, int ret, uint16_t connectHandle,
-        uint16_t serviceHandle, const std::map<uint16_t, GattCache::Characteristic> &characteristics);
-    void OnDiscoverAllCharacteristicDescriptorsEvent(
-        int requestId, int ret, uint16_t serviceHandle, uint16_t characteristicHandle);
+    void OnDiscoverDatabaseEvent(int requestId, int ret, uint16_t connectHandle);
     void OnReadCharacteristicValueEvent(
         int requestId, uint16_t valueHandle, GattValue &value, size_t length, int ret);
     void OnWriteCharacteristicValueEvent(int requestId, uint16_t connectHandle, uint16_t valueHandle, int ret);
@@ -128,6 +116,8 @@ struct GattClientService::impl : public GattServiceBase {
     void OnCharacteristicNotifyEvent(
         uint16_t connectHandle, uint16_t valueHandle, GattValue &value, size_t length, bool needConfirm);
     void OnExchangeMtuEvent(int requestId, uint16_t connectHandle, uint16_t rxMtu, bool status);
+    void OnCacheValidatedEvent(uint16_t connectHandle, bool isValid);
+    void OnDiscoveryComplete(ClientApplication &client, int ret);
     void OnConnect(const GattDevice &device, uint16_t connectionHandle, int ret);
     void OnDisconnect(const GattDevice &device, uint16_t connectionHandle, int ret);
     void OnConnectionChanged(const GattDevice &device, int state);
@@ -456,51 +446,10 @@ private:
 
 class GattClientService::impl::GattClientProfileCallbackImplement : public GattClientProfileCallback {
 public:
-    void OnDiscoverAllPrimaryServicesEvent(
-        int reqId, int ret, uint16_t connectHandle, const std::map<uint16_t, GattCache::Service> &services) override
+    void OnDiscoverDatabaseEvent(int reqId, int ret, uint16_t connectHandle) override
     {
-        service_.GetDispatcher()->PostTask(std::bind(&impl::OnDiscoverAllPrimaryServicesEvent,
-            service_.pimpl.get(),
-            reqId,
-            ret,
-            connectHandle,
-            std::ref(services)));
-    }
-
-    void OnFindIncludedServicesEvent(int reqId, int ret, uint16_t connectHandle, uint16_t serviceHandle,
-        const std::vector<GattCache::IncludeService> &services) override
-    {
-        service_.GetDispatcher()->PostTask(std::bind(&impl::OnFindIncludedServicesEvent,
-            service_.pimpl.get(),
-            reqId,
-            ret,
-            connectHandle,
-            serviceHandle,
-            std::ref(services)));
-    }
-
-    void OnDiscoverAllCharacteristicOfServiceEvent(int reqId, int ret, uint16_t connectHandle, uint16_t serviceHandle,
-        const std::map<uint16_t, GattCache::Characteristic> &characteristics) override
-    {
-        service_.GetDispatcher()->PostTask(std::bind(&impl::OnDiscoverAllCharacteristicOfServiceEvent,
-            service_.pimpl.get(),
-            reqId,
-            ret,
-            connectHandle,
-            serviceHandle,
-            std::ref(characteristics)));
-    }
-
-    void OnDiscoverAllCharacteristicDescriptorsEvent(
-        int reqId, int ret, uint16_t serviceHandle, uint16_t characteristicHandle,
-        const std::map<uint16_t, GattCache::Descriptor> &descriptors) override
-    {
-        service_.GetDispatcher()->PostTask(std::bind(&impl::OnDiscoverAllCharacteristicDescriptorsEvent,
-            service_.pimpl.get(),
-            reqId,
-            ret,
-            serviceHandle,
-            characteristicHandle));
+        service_.GetDispatcher()->PostTask(
+            std::bind(&impl::OnDiscoverDatabaseEvent, service_.pimpl.get(), reqId, ret, connectHandle));
     }
 
     void OnReadCharacteristicValueEvent(
@@ -547,6 +496,12 @@ public:
             std::bind(&impl::OnExchangeMtuEvent, service_.pimpl.get(), reqId, connectHandle, rxMtu, status));
     }
 
+    void OnCacheValidatedEvent(uint16_t connectHandle, bool isValid) override
+    {
+        service_.GetDispatcher()->PostTask(
+            std::bind(&impl::OnCacheValidatedEvent, service_.pimpl.get(), connectHandle, isValid));
+    }
+
     GattClientProfileCallbackImplement(GattClientService &service) : service_(service)
     {}
     ~GattClientProfileCallbackImplement()
@@ -662,21 +617,24 @@ void GattClientService::impl::DiscoveryServices(int appId)
             return;
         }
 
-        if (client.discover_.tasks_.size() != 0) {
+        if (client.discover_.running_ || client.discover_.waitCache_) {
             client.callback_.OnServicesDiscovered(GattStatus::REMOTE_DEVICE_BUSY);
             return;
         }
 
-        profile_->ClearCacheMap(client.connection_.GetHandle());
-        client.discover_.Clear();
+        if (profile_->IsCacheValidating(client.connection_.GetHandle())) {
+            client.discover_.waitCache_ = true;
+            return;
+        }
 
-        ClientApplication::Discover::Task task = {};
-        task.type_ = ClientApplication::Discover::Task::Type::SERVICE;
-        task.startHandle_ = MIN_ATTRIBUTE_HANDLE;
-        task.endHandle_ = MAX_ATTRIBUTE_HANDLE;
-        client.discover_.tasks_.push(task);
+        // The stored database matches Database Hash of remote device, no need to discover again.
+        if (profile_->IsCacheValid(client.connection_.GetHandle())) {
+            client.callback_.OnServicesDiscovered(GattStatus::GATT_SUCCESS);
+            return;
+        }
 
-        client.discover_.DiscoverNext(appId);
+        client.discover_.Clear();
+        client.discover_.Start(appId);
     }
 }
 
@@ -814,8 +772,7 @@ void GattClientService::impl::GetServices(
     promise.set_value();
 }
 
-void GattClientService::impl::OnDiscoverAllPrimaryServicesEvent(
-    int requestId, int ret, uint16_t connectHandle, const std::map<uint16_t, GattCache::Service> &services)
+void GattClientService::impl::OnDiscoverDatabaseEvent(int requestId, int ret, uint16_t connectHandle)
 {
     auto it = GetValidApplication(requestId);
     if (it.has_value()) {
@@ -823,102 +780,7 @@ void GattClientService::impl::OnDiscoverAllPrimaryServicesEvent(
             GattUpdatePowerStatus(it.value()->second.connection_.GetDevice().addr_);
         }
 
-        if (GattStatus::GATT_SUCCESS == ret) {
-            for (auto &serv : services) {
-                ClientApplication::Discover::Task task = {};
-                task.type_ = ClientApplication::Discover::Task::Type::INCLUDE_SERVICE;
-                task.startHandle_ = serv.second.handle_;
-                task.endHandle_ = serv.second.endHandle_;
-                it.value()->second.discover_.tasks_.push(task);
-
-                task.type_ = ClientApplication::Discover::Task::Type::CHARACTERISTICS;
-                it.value()->second.discover_.tasks_.push(task);
-            }
-            if (!it.value()->second.discover_.DiscoverNext(requestId)) {
-                return;
-            }
-        }
-
-        it.value()->second.discover_.Clear();
-        it.value()->second.callback_.OnServicesDiscovered(ret);
-    }
-}
-
-void GattClientService::impl::OnFindIncludedServicesEvent(int requestId, int ret, uint16_t connectHandle,
-    uint16_t serviceHandle, const std::vector<GattCache::IncludeService> &services)
-{
-    auto it = GetValidApplication(requestId);
-    if (it.has_value()) {
-        if (it.value()->second.connection_.GetDevice().transport_ == GATT_TRANSPORT_TYPE_CLASSIC) {
-            GattUpdatePowerStatus(it.value()->second.connection_.GetDevice().addr_);
-        }
-
-        if (GattStatus::GATT_SUCCESS == ret) {
-            for (auto &serv : services) {
-                ClientApplication::Discover::Task task = {};
-                task.type_ = ClientApplication::Discover::Task::Type::SERVICE;
-                task.startHandle_ = serv.startHandle_;
-                task.endHandle_ = serv.startHandle_;
-
-                it.value()->second.discover_.tasks_.push(task);
-            }
-            if (!it.value()->second.discover_.DiscoverNext(requestId)) {
-                return;
-            }
-        }
-
-        it.value()->second.discover_.Clear();
-        it.value()->second.callback_.OnServicesDiscovered(ret);
-    }
-}
-
-void GattClientService::impl::OnDiscoverAllCharacteristicOfServiceEvent(int requestId, int ret, uint16_t connectHandle,
-    uint16_t serviceHandle, const std::map<uint16_t, GattCache::Characteristic> &characteristics)
-{
-    auto it = GetValidApplication(requestId);
-    if (it.has_value()) {
-        if (it.value()->second.connection_.GetDevice().transport_ == GATT_TRANSPORT_TYPE_CLASSIC) {
-            GattUpdatePowerStatus(it.value()->second.connection_.GetDevice().addr_);
-        }
-
-        if (GattStatus::GATT_SUCCESS == ret) {
-            for (auto &ccc : characteristics) {
-                ClientApplication::Discover::Task task = {};
-                task.type_ = ClientApplication::Discover::Task::Type::DESCRIPTOR;
-                task.startHandle_ = ccc.second.handle_;
-                task.endHandle_ = profile_->GetCharacteristicEndHandle(
-                    it.value()->second.connection_.GetHandle(), serviceHandle, ccc.second.handle_);
-
-                it.value()->second.discover_.tasks_.push(task);
-            }
-
-            if (!it.value()->second.discover_.DiscoverNext(requestId)) {
-                return;
-            }
-        }
-
-        it.value()->second.discover_.Clear();
-        it.value()->second.callback_.OnServicesDiscovered(ret);
-    }
-}
-
-void GattClientService::impl::OnDiscoverAllCharacteristicDescriptorsEvent(int requestId, int ret,
-    uint16_t serviceHandle, uint16_t characteristicHandle)
-{
-    auto it = GetValidApplication(requestId);
-    if (it.has_value()) {
-        if (it.value()->second.connection_.GetDevice().transport_ == GATT_TRANSPORT_TYPE_CLASSIC) {
-            GattUpdatePowerStatus(it.value()->second.connection_.GetDevice().addr_);
-        }
-
-        if (GattStatus::GATT_SUCCESS == ret) {
-            if (!it.value()->second.discover_.DiscoverNext(requestId)) {
-                return;
-            }
-        }
-
-        it.value()->second.discover_.Clear();
-        it.value()->second.callback_.OnServicesDiscovered(ret);
+        OnDiscoveryComplete(it.value()->second, ret);
     }
 }
 
@@ -1015,6 +877,7 @@ void GattClientService::impl::OnCharacteristicNotifyEvent(
         }
 
         if (Uuid::ConvertFrom16Bits(UUID_SERVICE_CHANGED) == ccc->uuid_) {
+            profile_->InvalidateCache(connectHandle);
             client.value()->second.callback_.OnServicesChanged(std::vector<Service>());
         } else {
             Characteristic gattCCC(ccc->uuid_, ccc->handle_, ccc->properties_);
@@ -1025,6 +888,30 @@ void GattClientService::impl::OnCharacteristicNotifyEvent(
     }
 }
 
+void GattClientService::impl::OnCacheValidatedEvent(uint16_t connectHandle, bool isValid)
+{
+    auto appIds = handleMap_.find(connectHandle);
+    if (appIds == handleMap_.end()) {
+        return;
+    }
+    for (int appId : appIds->second) {
+        auto client = GetValidApplication(appId);
+        if (client.has_value() && client.value()->second.discover_.waitCache_) {
+            client.value()->second.discover_.waitCache_ = false;
+            DiscoveryServices(appId);
+        }
+    }
+}
+
+void GattClientService::impl::OnDiscoveryComplete(ClientApplication &client, int ret)
+{
+    client.discover_.Clear();
+    if (GattStatus::GATT_SUCCESS == ret) {
+        profile_->SetCacheComplete(client.connection_.GetHandle());
+    }
+    client.callback_.OnServicesDiscovered(ret);
+}
+
 void GattClientService::impl::OnExchangeMtuEvent(int requestId, uint16_t connectHandle, uint16_t rxMtu, bool status)
 {
     auto it = GetValidApplication(requestId);
@@ -1118,6 +1005,7 @@ void GattClientService::impl::OnDisconnect(const GattDevice &device, uint16_t co
 
             client.connection_.SetHandle(0);
             client.connection_.SetMtu(0);
+            client.discover_.Clear();
             client.connState_ = static_cast<int>(BTConnectState::DISCONNECTED);
             client.callback_.OnConnectionStateChanged(ret, client.connState_);
         }
@@ -1226,51 +1114,16 @@ void GattClientService::impl::GattUpdatePowerStatus(const RawAddress &addr)
     IPowerManager::GetInstance().StatusUpdate(RequestStatus::IDLE, PROFILE_NAME_GATT_CLIENT, addr);
 }
 
-bool ClientApplication::Discover::DiscoverNext(int appId)
+void ClientApplication::Discover::Start(int appId)
 {
-    bool doOnce = true;
-    do {
-        if (tasks_.empty()) {
-            return true;
-        }
-
-        auto &task = tasks_.front();
-        switch (task.type_) {
-            case Task::Type::SERVICE:
-                if (discovered_.emplace(task.startHandle_).second) {
-                    profile_.DiscoverAllPrimaryServices(
-                        appId, client_.connection_.GetHandle(), task.startHandle_, task.endHandle_);
-                } else {
-                    doOnce = false;
-                }
-                break;
-            case Task::Type::INCLUDE_SERVICE:
-                profile_.FindIncludedServices(
-                    appId, client_.connection_.GetHandle(), task.startHandle_, task.endHandle_);
-                break;
-            case Task::Type::CHARACTERISTICS:
-                profile_.DiscoverAllCharacteristicOfService(
-                    appId, client_.connection_.GetHandle(), task.startHandle_, task.endHandle_);
-                break;
-            case Task::Type::DESCRIPTOR:
-                profile_.DiscoverAllCharacteristicDescriptors(
-                    appId, client_.connection_.GetHandle(), task.startHandle_, task.endHandle_);
-                break;
-            default:
-                break;
-        }
-        tasks_.pop();
-    } while (!doOnce);
-
-    return false;
+    running_ = true;
+    profile_.DiscoverDatabase(appId, client_.connection_.GetHandle());
 }
 
 void ClientApplication::Discover::Clear()
 {
-    while (tasks_.size() != 0) {
-        tasks_.pop();
-    }
-    discovered_.clear();
+    running_ = false;
+    waitCache_ = false;
 }
 
 void GattClientService::Enable()
@@ -43,7 +43,9 @@ enum ResponesType {
     RELIABLE_WRITE_VALUE,
     EXECUTE_WRITE_VALUE,
     EXCHANGE_MTU,
-    SEND_INDICATION
+    SEND_INDICATION,
+    READ_DATABASE_HASH,
+    DISCOVER_DATABASE
 };
 
 enum ReadByTypeResponseLen {
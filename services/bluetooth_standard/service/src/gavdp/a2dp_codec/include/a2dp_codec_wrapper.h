@@ -34,6 +34,11 @@ public:
     virtual uint32_t Read(uint8_t **buf, uint32_t size) = 0;
     // pktTimeStamp will be added in packet's head.
     virtual bool EnqueuePacket(const Packet *packet, size_t frames, uint32_t bytes, uint32_t pktTimeStamp) const = 0;
+    // Number of packets not yet sent over the air, the encoder lowers its bitrate while it grows.
+    virtual size_t GetTransmitQueueLength() const
+    {
+        return 0;
+    }
 };
 
 // A2dp encoder interface
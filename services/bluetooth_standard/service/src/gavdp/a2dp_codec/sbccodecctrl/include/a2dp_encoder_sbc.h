@@ -105,6 +105,12 @@ struct SBCEncoderParams {
     uint16_t bitRate;          // exp: 328.
 };
 
+struct A2dpSbcBitPoolState {
+    int16_t minBitPool;   // Lowest bitpool accepted by the peer.
+    int16_t maxBitPool;   // Bitpool calculated from the target bitrate.
+    uint32_t clearTicks;  // Consecutive ticks without congestion.
+};
+
 struct A2dpSbcEncoderCb {
     uint16_t mtuSize;
     bool isPeerEdr;          // Whether peer device supports EDR.
@@ -114,6 +120,7 @@ struct A2dpSbcEncoderCb {
     SBCEncoderParams sbcEncoderParams;
     A2dpSBCFeedingParams feedingParams;
     A2dpSbcFeedingState feedingState;
+    A2dpSbcBitPoolState bitPoolState;
     uint8_t pcmBuffer[A2DP_SBC_MAX_PACKET_SIZE];
     uint8_t pcmRemain[A2DP_SBC_MAX_PACKET_SIZE];
     uint16_t offsetPCM;
@@ -125,17 +132,22 @@ public:
         A2dpEncoderObserver *observer);
     ~A2dpSbcEncoder();
     void ResetFeedingState(void) override;
+    void SetTransmitQueueLength(size_t length) override;
     void SendFrames(uint64_t timeStampUs) override;
     void UpdateEncoderParam() override;
 
 private:
     sbc::IEncoderBase* sbcEncoder_ = nullptr;
+    sbc::CodecParam sbcParam_ {};
     std::unique_ptr<A2dpSBCDynamicLibCtrl> codecLib_ = nullptr;
     CODECSbcLib *codecSbcEncoderLib_ = nullptr;
     void updateParam(void);
-    bool A2dpSbcReadFeeding(uint32_t *bytesRead) const;
+    bool A2dpSbcReadFeeding(uint32_t needBytes, uint32_t *bytesRead);
     void A2dpSbcCalculateEncBitPool(uint16_t samplingFreq, uint16_t minBitPool, uint16_t maxBitPool);
-    void A2dpSbcEncodeFrames(void);
+    uint16_t A2dpSbcGetPcmBytesPerFrame(void) const;
+    uint32_t A2dpSbcGetFramesToEncode(uint64_t timeStampUs, uint16_t pcmBytesPerFrame);
+    void A2dpSbcAdaptBitPool(void);
+    uint32_t A2dpSbcEncodeFrames(uint32_t frames);
     void CalculateSbcPCMRemain(uint16_t codecSize, uint32_t bytesNum, uint8_t *numOfFrame);
     void UpdateMtuSize(void);
     static uint16_t A2dpSbcGetSampleRate(const uint8_t *codecInfo);
@@ -157,7 +169,6 @@ private:
     void EnqueuePacket(Packet *pkt,
         size_t frames, const uint32_t bytes, uint32_t timeStamp, const uint16_t frameSize) const;
     A2dpSbcEncoderCb a2dpSbcEncoderCb_ {};
-    bool isFirstTimeToReadData_ = false;
     DISALLOW_COPY_AND_ASSIGN(A2dpSbcEncoder);
 };
 }  // namespace bluetooth
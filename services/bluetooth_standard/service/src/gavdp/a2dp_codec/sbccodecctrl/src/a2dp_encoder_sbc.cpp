@@ -14,12 +14,14 @@
  */
 
 #include "../include/a2dp_encoder_sbc.h"
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 #include <mutex>
 #include "../../include/a2dp_sbc_param_ctrl.h"
 #include "log.h"
 #include "packet.h"
+#include "perf_counter.h"
 #include "securec.h"
 
 namespace bluetooth {
@@ -42,8 +44,15 @@ const int FRAGMENT_SIZE_TWO = 2;
 const int FRAGMENT_SIZE_THREE = 3;
 const int VALUE_TWO = 2;
 
-sbc::CodecParam g_sbcEncode = {};
-
+// Media clock: after a stall at most this many ticks of pcm are caught up, the rest is dropped to bound latency.
+const int MAX_CATCH_UP_TICKS = 3;
+const int NS_TO_US = 1000;
+// Adaptive bitpool: ACL packets queued for the link.
+const size_t CONGESTION_HIGH_WATERMARK = 5;
+const size_t CONGESTION_LOW_WATERMARK = 2;
+const int BIT_POOL_DECREASE_STEP = 4;
+const int BIT_POOL_INCREASE_STEP = 1;
+const uint32_t BIT_POOL_INCREASE_TICKS = 10;
 
 std::recursive_mutex g_sbcMutex {};
 A2dpSbcEncoder::A2dpSbcEncoder(
@@ -55,7 +64,6 @@ A2dpSbcEncoder::A2dpSbcEncoder(
     a2dpSbcEncoderCb_.peerSupports3mbps = peerParams->peerSupports3mbps;
     a2dpSbcEncoderCb_.peerMtu = peerParams->peermtu;
     a2dpSbcEncoderCb_.timestamp = 0;
-    isFirstTimeToReadData_ = false;
     codecLib_ = std::make_unique<A2dpSBCDynamicLibCtrl>(true);
     codecSbcEncoderLib_ = codecLib_->LoadCodecSbcLib();
     if (codecSbcEncoderLib_ == nullptr) {
@@ -83,21 +91,105 @@ void A2dpSbcEncoder::ResetFeedingState(void)
         a2dpSbcEncoderCb_.feedingParams.sampleRate * a2dpSbcEncoderCb_.feedingParams.bitsPerSample /
         BIT_SBC_NUMBER_PER_SAMPLE * a2dpSbcEncoderCb_.feedingParams.channelCount * A2DP_SBC_ENCODER_INTERVAL_MS /
         MS_TO_US;
+}
 
-    isFirstTimeToReadData_ = false;
+void A2dpSbcEncoder::SetTransmitQueueLength(size_t length)
+{
+    std::lock_guard<std::recursive_mutex> lock(g_sbcMutex);
+    transmitQueueLength_ = length;
 }
 
 void A2dpSbcEncoder::SendFrames(uint64_t timeStampUs)
 {
     std::lock_guard<std::recursive_mutex> lock(g_sbcMutex);
 
-    if (!isFirstTimeToReadData_) {
-        for (int iTimes = 0; iTimes < READ_THREE_TIMES; iTimes++) {
-            A2dpSbcEncodeFrames();
+    A2dpSbcAdaptBitPool();
+
+    uint16_t pcmBytesPerFrame = A2dpSbcGetPcmBytesPerFrame();
+    uint32_t frames = A2dpSbcGetFramesToEncode(timeStampUs, pcmBytesPerFrame);
+    // After a stall more frames may be due than the pcm buffer holds, they are sent in several packets.
+    while (frames > 0) {
+        uint32_t encodedFrames = A2dpSbcEncodeFrames(frames);
+        if (encodedFrames == 0) {
+            break;
         }
-        isFirstTimeToReadData_ = true;
+        frames -= (encodedFrames < frames) ? encodedFrames : frames;
+    }
+}
+
+uint16_t A2dpSbcEncoder::A2dpSbcGetPcmBytesPerFrame(void) const
+{
+    uint16_t channelMode = (sbcParam_.channelMode == sbc::SBC_CHANNEL_MODE_MONO) ? CHANNEL_ONE : CHANNEL_TWO;
+    uint16_t subbands = sbcParam_.subbands ? SUBBAND8 : SUBBAND4;
+    const uint16_t blocks = SUBBAND4 + (sbcParam_.blocks * SUBBAND4);
+    return subbands * blocks * channelMode * VALUE_TWO;
+}
+
+uint32_t A2dpSbcEncoder::A2dpSbcGetFramesToEncode(uint64_t timeStampUs, uint16_t pcmBytesPerFrame)
+{
+    A2dpSbcFeedingState &state = a2dpSbcEncoderCb_.feedingState;
+    const uint64_t tickUs = A2DP_SBC_ENCODER_INTERVAL_MS * MS_TO_US;
+    uint64_t elapsedUs = tickUs;
+    if (state.lastFrameTimestampNs == 0) {
+        // Prime the sink with a few ticks of audio when the stream starts.
+        elapsedUs = tickUs * READ_THREE_TIMES;
+    } else if (timeStampUs * NS_TO_US > state.lastFrameTimestampNs) {
+        elapsedUs = timeStampUs - state.lastFrameTimestampNs / NS_TO_US;
     } else {
-        A2dpSbcEncodeFrames();
+        elapsedUs = 0;
+    }
+    state.lastFrameTimestampNs = timeStampUs * NS_TO_US;
+
+    if (elapsedUs > tickUs * MAX_CATCH_UP_TICKS) {
+        LOG_WARN("[SbcEncoder] %{public}s timer late %{public}llu us, drop the backlog", __func__,
+            static_cast<unsigned long long>(elapsedUs - tickUs));
+        elapsedUs = tickUs * MAX_CATCH_UP_TICKS;
+    }
+
+    // Count the pcm bytes played by the sink during the elapsed time, the division remainder is carried over so
+    // the timer jitter and the 44.1kHz fraction never accumulate into a drift.
+    uint64_t scaled = elapsedUs * state.bytesPerTick + static_cast<uint64_t>(state.aaFeedResidue);
+    state.aaFeedCounter += static_cast<int32_t>(scaled / tickUs);
+    state.aaFeedResidue = static_cast<int32_t>(scaled % tickUs);
+    state.counter++;
+
+    if ((pcmBytesPerFrame == 0) || (state.aaFeedCounter < pcmBytesPerFrame)) {
+        return 0;
+    }
+    uint32_t frames = static_cast<uint32_t>(state.aaFeedCounter) / pcmBytesPerFrame;
+    state.aaFeedCounter -= static_cast<int32_t>(frames * pcmBytesPerFrame);
+    state.aaFrameCounter += frames;
+    return frames;
+}
+
+void A2dpSbcEncoder::A2dpSbcAdaptBitPool(void)
+{
+    A2dpSbcBitPoolState &state = a2dpSbcEncoderCb_.bitPoolState;
+    int16_t bitPool = a2dpSbcEncoderCb_.sbcEncoderParams.bitPool;
+
+    if (transmitQueueLength_ >= CONGESTION_HIGH_WATERMARK) {
+        state.clearTicks = 0;
+        bitPool -= BIT_POOL_DECREASE_STEP;
+    } else if (transmitQueueLength_ <= CONGESTION_LOW_WATERMARK) {
+        // Step back up slowly so a short burst of congestion does not make the bitrate oscillate.
+        if (++state.clearTicks >= BIT_POOL_INCREASE_TICKS) {
+            state.clearTicks = 0;
+            bitPool += BIT_POOL_INCREASE_STEP;
+        }
+    } else {
+        state.clearTicks = 0;
+    }
+
+    if (bitPool < state.minBitPool) {
+        bitPool = state.minBitPool;
+    } else if (bitPool > state.maxBitPool) {
+        bitPool = state.maxBitPool;
+    }
+    if (bitPool != a2dpSbcEncoderCb_.sbcEncoderParams.bitPool) {
+        LOG_INFO("[SbcEncoder] %{public}s [queue:%{public}zu] [bitpool:%{public}d->%{public}d]", __func__,
+            transmitQueueLength_, a2dpSbcEncoderCb_.sbcEncoderParams.bitPool, bitPool);
+        a2dpSbcEncoderCb_.sbcEncoderParams.bitPool = bitPool;
+        ConvertBitpoolParamToSBCParam();
     }
 }
 
@@ -260,16 +352,16 @@ void A2dpSbcEncoder::SetSBCParam()
     ConvertBlockParamToSBCParam();
     ConvertAllocationParamToSBCParam();
     ConvertBitpoolParamToSBCParam();
-    g_sbcEncode.endian = sbc::SBC_ENDIANESS_LE;
+    sbcParam_.endian = sbc::SBC_ENDIANESS_LE;
     sbcEncoder_ = codecSbcEncoderLib_->sbcEncoder.createSbcEncode();
     LOG_INFO("[SbcEncoder] %{public}s[freq:%u][mode:%u][sub:%u][block:%u][alc:%u][bitpool:%u]\n",
         __func__,
-        g_sbcEncode.frequency,
-        g_sbcEncode.channelMode,
-        g_sbcEncode.subbands,
-        g_sbcEncode.blocks,
-        g_sbcEncode.allocation,
-        g_sbcEncode.bitpool);
+        sbcParam_.frequency,
+        sbcParam_.channelMode,
+        sbcParam_.subbands,
+        sbcParam_.blocks,
+        sbcParam_.allocation,
+        sbcParam_.bitpool);
 }
 
 void A2dpSbcEncoder::updateParam(void)
@@ -313,19 +405,24 @@ void A2dpSbcEncoder::UpdateEncoderParam(void)
     }
 
     A2dpSbcCalculateEncBitPool(samplingFreq, minBitPool, maxBitPool);
+    a2dpSbcEncoderCb_.bitPoolState.maxBitPool = encParams->bitPool;
+    a2dpSbcEncoderCb_.bitPoolState.minBitPool = std::min<int16_t>(minBitPool, encParams->bitPool);
+    a2dpSbcEncoderCb_.bitPoolState.clearTicks = 0;
     SetSBCParam();
     UpdateMtuSize();
 }
 
-bool A2dpSbcEncoder::A2dpSbcReadFeeding(uint32_t *bytesRead) const
+bool A2dpSbcEncoder::A2dpSbcReadFeeding(uint32_t needBytes, uint32_t *bytesRead)
 {
     uint8_t *pcmBuffer = nullptr;
-    uint16_t needReadPcmData = 0;
-    uint16_t actualReadPcmData = observer_->Read(&pcmBuffer, needReadPcmData);
+    uint32_t actualReadPcmData = observer_->Read(&pcmBuffer, needBytes);
+    uint32_t space = A2DP_SBC_MAX_PACKET_SIZE - a2dpSbcEncoderCb_.offsetPCM;
+    if (actualReadPcmData > space) {
+        actualReadPcmData = space;
+    }
     if (actualReadPcmData && pcmBuffer != nullptr) {
         LOG_INFO("[Feeding][offsetPCM:%u][readBytes:%u]", a2dpSbcEncoderCb_.offsetPCM, actualReadPcmData);
-        (void)memcpy_s(((uint8_t *)&a2dpSbcEncoderCb_.pcmBuffer[a2dpSbcEncoderCb_.offsetPCM]), 
-            A2DP_SBC_MAX_PACKET_SIZE,
+        (void)memcpy_s(&a2dpSbcEncoderCb_.pcmBuffer[a2dpSbcEncoderCb_.offsetPCM], space,
             pcmBuffer, actualReadPcmData);
         *bytesRead = actualReadPcmData;
         return true;
@@ -340,19 +437,19 @@ void A2dpSbcEncoder::ConvertFreqParamToSBCParam(void)
     SBCEncoderParams *encParams = &a2dpSbcEncoderCb_.sbcEncoderParams;
     switch (encParams->samplingFreq) {
         case SBC_SAMPLE_RATE_16000:
-            g_sbcEncode.frequency = sbc::SBC_FREQ_16000;
+            sbcParam_.frequency = sbc::SBC_FREQ_16000;
             break;
         case SBC_SAMPLE_RATE_32000:
-            g_sbcEncode.frequency = sbc::SBC_FREQ_32000;
+            sbcParam_.frequency = sbc::SBC_FREQ_32000;
             break;
         case SBC_SAMPLE_RATE_44100:
-            g_sbcEncode.frequency = sbc::SBC_FREQ_44100;
+            sbcParam_.frequency = sbc::SBC_FREQ_44100;
             break;
         case SBC_SAMPLE_RATE_48000:
-            g_sbcEncode.frequency = sbc::SBC_FREQ_48000;
+            sbcParam_.frequency = sbc::SBC_FREQ_48000;
             break;
         default:
-            g_sbcEncode.frequency = sbc::SBC_FREQ_44100;
+            sbcParam_.frequency = sbc::SBC_FREQ_44100;
             break;
     }
 }
@@ -362,19 +459,19 @@ void A2dpSbcEncoder::ConvertModeParamToSBCParam(void)
     SBCEncoderParams *encParams = &a2dpSbcEncoderCb_.sbcEncoderParams;
     switch (encParams->channelMode) {
         case SBC_MONO:
-            g_sbcEncode.channelMode = sbc::SBC_CHANNEL_MODE_MONO;
+            sbcParam_.channelMode = sbc::SBC_CHANNEL_MODE_MONO;
             break;
         case SBC_DUAL:
-            g_sbcEncode.channelMode = sbc::SBC_CHANNEL_MODE_DUAL_CHANNEL;
+            sbcParam_.channelMode = sbc::SBC_CHANNEL_MODE_DUAL_CHANNEL;
             break;
         case SBC_STEREO:
-            g_sbcEncode.channelMode = sbc::SBC_CHANNEL_MODE_STEREO;
+            sbcParam_.channelMode = sbc::SBC_CHANNEL_MODE_STEREO;
             break;
         case SBC_JOINT_STEREO:
-            g_sbcEncode.channelMode = sbc::SBC_CHANNEL_MODE_JOINT_STEREO;
+            sbcParam_.channelMode = sbc::SBC_CHANNEL_MODE_JOINT_STEREO;
             break;
         default:
-            g_sbcEncode.channelMode = sbc::SBC_CHANNEL_MODE_STEREO;
+            sbcParam_.channelMode = sbc::SBC_CHANNEL_MODE_STEREO;
             break;
     }
 }
@@ -384,13 +481,13 @@ void A2dpSbcEncoder::ConvertSubbandsParamToSBCParam(void)
     SBCEncoderParams *encParams = &a2dpSbcEncoderCb_.sbcEncoderParams;
     switch (encParams->subBands) {
         case SBC_SUBBAND_4:
-            g_sbcEncode.subbands = sbc::SBC_SUBBAND4;
+            sbcParam_.subbands = sbc::SBC_SUBBAND4;
             break;
         case SBC_SUBBAND_8:
-            g_sbcEncode.subbands = sbc::SBC_SUBBAND8;
+            sbcParam_.subbands = sbc::SBC_SUBBAND8;
             break;
         default:
-            g_sbcEncode.subbands = sbc::SBC_SUBBAND8;
+            sbcParam_.subbands = sbc::SBC_SUBBAND8;
             break;
     }
 }
@@ -400,19 +497,19 @@ void A2dpSbcEncoder::ConvertBlockParamToSBCParam(void)
     SBCEncoderParams *encParams = &a2dpSbcEncoderCb_.sbcEncoderParams;
     switch (encParams->numOfBlocks) {
         case SBC_BLOCKS_4:
-            g_sbcEncode.blocks = sbc::SBC_BLOCK4;
+            sbcParam_.blocks = sbc::SBC_BLOCK4;
             break;
         case SBC_BLOCKS_8:
-            g_sbcEncode.blocks = sbc::SBC_BLOCK8;
+            sbcParam_.blocks = sbc::SBC_BLOCK8;
             break;
         case SBC_BLOCKS_12:
-            g_sbcEncode.blocks = sbc::SBC_BLOCK12;
+            sbcParam_.blocks = sbc::SBC_BLOCK12;
             break;
         case SBC_BLOCKS_16:
-            g_sbcEncode.blocks = sbc::SBC_BLOCK16;
+            sbcParam_.blocks = sbc::SBC_BLOCK16;
             break;
         default:
-            g_sbcEncode.blocks = sbc::SBC_BLOCK16;
+            sbcParam_.blocks = sbc::SBC_BLOCK16;
             break;
     }
 }
@@ -422,13 +519,13 @@ void A2dpSbcEncoder::ConvertAllocationParamToSBCParam(void)
     SBCEncoderParams *encParams = &a2dpSbcEncoderCb_.sbcEncoderParams;
     switch (encParams->allocationMethod) {
         case SBC_LOUDNESS:
-            g_sbcEncode.allocation = sbc::SBC_ALLOCATION_LOUDNESS;
+            sbcParam_.allocation = sbc::SBC_ALLOCATION_LOUDNESS;
             break;
         case SBC_SNR:
-            g_sbcEncode.allocation = sbc::SBC_ALLOCATION_SNR;
+            sbcParam_.allocation = sbc::SBC_ALLOCATION_SNR;
             break;
         default:
-            g_sbcEncode.allocation = sbc::SBC_ALLOCATION_LOUDNESS;
+            sbcParam_.allocation = sbc::SBC_ALLOCATION_LOUDNESS;
             break;
     }
 }
@@ -436,7 +533,7 @@ void A2dpSbcEncoder::ConvertAllocationParamToSBCParam(void)
 void A2dpSbcEncoder::ConvertBitpoolParamToSBCParam(void)
 {
     SBCEncoderParams *encParams = &a2dpSbcEncoderCb_.sbcEncoderParams;
-    g_sbcEncode.bitpool = encParams->bitPool;
+    sbcParam_.bitpool = encParams->bitPool;
 }
 
 void A2dpSbcEncoder::CalculateSbcPCMRemain(uint16_t codecSize, uint32_t bytesNum, uint8_t *numOfFrame)
@@ -455,27 +552,38 @@ void A2dpSbcEncoder::CalculateSbcPCMRemain(uint16_t codecSize, uint32_t bytesNum
     }
 }
 
-void A2dpSbcEncoder::A2dpSbcEncodeFrames(void)
+uint32_t A2dpSbcEncoder::A2dpSbcEncodeFrames(uint32_t frames)
 {
     size_t encoded = 0;
     SBCEncoderParams *encParams = &a2dpSbcEncoderCb_.sbcEncoderParams;
     uint16_t blocksXsubbands = encParams->subBands * encParams->numOfBlocks;
-    uint16_t channelMode = (g_sbcEncode.channelMode == sbc::SBC_CHANNEL_MODE_MONO) ? CHANNEL_ONE : CHANNEL_TWO;
-    uint16_t subbands = g_sbcEncode.subbands ? SUBBAND8 : SUBBAND4;
-    const uint16_t blocks = SUBBAND4 + (g_sbcEncode.blocks * SUBBAND4);
-    uint16_t codecSize = subbands * blocks * channelMode * VALUE_TWO;
+    uint16_t channelMode = (sbcParam_.channelMode == sbc::SBC_CHANNEL_MODE_MONO) ? CHANNEL_ONE : CHANNEL_TWO;
+    uint16_t codecSize = A2dpSbcGetPcmBytesPerFrame();
+    uint32_t maxFrames = (A2DP_SBC_MAX_PACKET_SIZE - a2dpSbcEncoderCb_.offsetPCM) / codecSize;
+    if (maxFrames > UINT8_MAX) {
+        maxFrames = UINT8_MAX;
+    }
+    if (frames > maxFrames) {
+        frames = maxFrames;
+    }
+    uint32_t needBytes = frames * codecSize - a2dpSbcEncoderCb_.offsetPCM;
     Packet *pkt = PacketMalloc(A2DP_SBC_FRAGMENT_HEADER, 0, 0);
     uint32_t bytesNum = 0;
     uint8_t numOfFrame = 0;
-    if (A2dpSbcReadFeeding(&bytesNum)) {
+    uint8_t frameIter = 0;
+    if (A2dpSbcReadFeeding(needBytes, &bytesNum)) {
+        if (bytesNum < needBytes) {
+            LOG_WARN("[SbcEncoder] %{public}s pcm underrun [need:%u] [read:%u]", __func__, needBytes, bytesNum);
+        }
         CalculateSbcPCMRemain(codecSize, bytesNum, &numOfFrame);
-        uint8_t frameIter = 0;
         uint16_t pcmOffset = 0;
         while (numOfFrame) {
             uint8_t outputBuf[A2DP_SBC_HQ_DUAL_BP_53_FRAME_SIZE] = {};
-            int16_t outputLen = sbcEncoder_->SBCEncode(g_sbcEncode, &a2dpSbcEncoderCb_.pcmBuffer[pcmOffset],
+            uint64_t encodeStartUs = PerfClockUs();
+            int16_t outputLen = sbcEncoder_->SBCEncode(sbcParam_, &a2dpSbcEncoderCb_.pcmBuffer[pcmOffset],
                                                        blocksXsubbands * channelMode, outputBuf,
                                                        sizeof(outputBuf), &encoded);
+            PerfHistogramRecord(PERF_HISTOGRAM_A2DP_ENCODE_US, PerfClockUs() - encodeStartUs);
             if (outputLen < 0) {
                 LOG_ERROR("err occur.");
             }
@@ -500,6 +608,7 @@ void A2dpSbcEncoder::A2dpSbcEncodeFrames(void)
         }
     }
     PacketFree(pkt);
+    return frameIter;
 }
 
 void A2dpSbcEncoder::EnqueuePacket(
@@ -14,7 +14,9 @@
  */
 
 #include "a2dp_codec_thread.h"
-#include <sys/time.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include "a2dp_decoder_aac.h"
 #include "a2dp_encoder_aac.h"
 #include "a2dp_decoder_sbc.h"
@@ -25,25 +27,175 @@ namespace bluetooth {
 const int ENCODE_TIMER_SBC = 20;
 const int ENCODE_TIMER_AAC = 25;
 #define PCM_DATA_ENCODED_TIMER(isSbc) (isSbc ? ENCODE_TIMER_SBC : ENCODE_TIMER_AAC)
+// A group lagging further behind the fastest one loses the oldest pcm data, one second of 48 kHz 16 bit stereo.
+const size_t PCM_SOURCE_MAX_SIZE = 192000;
 A2dpCodecThread *A2dpCodecThread::g_instance = nullptr;
 std::recursive_mutex g_codecMutex {};
 A2dpCodecThread::A2dpCodecThread(const std::string &name) : name_(name)
 {
     LOG_INFO("[A2dpCodecThread]%{public}s\n", __func__);
     dispatcher_ = std::make_unique<Dispatcher>(name);
-    auto callbackFunc = std::bind(&A2dpCodecThread::SignalingTimeoutCallback, this);
-    signalingTimer_ = std::make_unique<utility::Timer>(callbackFunc);
 }
 
-A2dpCodecThread::~A2dpCodecThread()
+uint32_t A2dpPcmSource::Read(A2dpEncoderObserver &observer, uint64_t &position, uint8_t **buf, uint32_t size)
+{
+    if (position < base_) {
+        LOG_WARN("[A2dpPcmSource]%{public}s reader lost %{public}llu bytes\n", __func__,
+            static_cast<unsigned long long>(base_ - position));
+        position = base_;
+    }
+
+    uint64_t end = End();
+    if (position + size > end) {
+        uint8_t *pcm = nullptr;
+        uint32_t need = static_cast<uint32_t>(position + size - end);
+        uint32_t readBytes = observer.Read(&pcm, need);
+        if ((readBytes < need) || (pcm == nullptr)) {
+            return 0;
+        }
+        data_.insert(data_.end(), pcm, pcm + need);
+        if (data_.size() > PCM_SOURCE_MAX_SIZE) {
+            Trim(std::min<uint64_t>(position, End() - PCM_SOURCE_MAX_SIZE));
+        }
+    }
+
+    *buf = data_.data() + (position - base_);
+    position += size;
+    return size;
+}
+
+void A2dpPcmSource::Trim(uint64_t position)
+{
+    if (position <= base_) {
+        return;
+    }
+    size_t count = static_cast<size_t>(std::min<uint64_t>(position - base_, data_.size()));
+    data_.erase(data_.begin(), data_.begin() + count);
+    base_ += count;
+}
+
+void A2dpPcmSource::Reset()
+{
+    base_ += data_.size();
+    data_.clear();
+}
+
+A2dpEncoderGroup::A2dpEncoderGroup(const A2dpEncoderInitPeerParams &peerParams, const A2dpCodecConfig &config,
+    A2dpPcmSource &pcmSource, const std::function<void()> &tick)
+    : peerParams_(peerParams),
+      codecIndex_(config.GetCodecIndex()),
+      pcmSource_(pcmSource),
+      pcmPosition_(pcmSource.End()),
+      timer_(std::make_unique<utility::Timer>(tick))
+{
+    config.CopyOutOtaCodecConfig(codecInfo_);
+    isSbc_ = (codecIndex_ == A2DP_SINK_CODEC_INDEX_SBC) || (codecIndex_ == A2DP_SOURCE_CODEC_INDEX_SBC);
+}
+
+A2dpEncoderGroup::~A2dpEncoderGroup()
+{
+    timer_->Stop();
+}
+
+void A2dpEncoderGroup::StartTimer()
+{
+    pcmPosition_ = pcmSource_.End();
+    timer_->Stop();
+    timer_->Start(PCM_DATA_ENCODED_TIMER(isSbc_), true);
+}
+
+void A2dpEncoderGroup::StopTimer()
+{
+    timer_->Stop();
+}
+
+bool A2dpEncoderGroup::Matches(const A2dpEncoderInitPeerParams &peerParams, const A2dpCodecConfig &config) const
+{
+    // The peer parameters decide the packet size, so they must match as well as the codec information.
+    if ((config.GetCodecIndex() != codecIndex_) || (peerParams.isPeerEdr != peerParams_.isPeerEdr) ||
+        (peerParams.peerSupports3mbps != peerParams_.peerSupports3mbps) ||
+        (peerParams.peermtu != peerParams_.peermtu)) {
+        return false;
+    }
+    uint8_t codecInfo[A2DP_CODEC_SIZE] = {0};
+    config.CopyOutOtaCodecConfig(codecInfo);
+    return memcmp(codecInfo, codecInfo_, A2DP_CODEC_SIZE) == 0;
+}
+
+void A2dpEncoderGroup::AddStream(uint16_t handle, A2dpCodecConfig &config, A2dpEncoderObserver &observer)
+{
+    streams_[handle] = {&config, &observer};
+    if (encoder_ == nullptr) {
+        CreateEncoder(config);
+        encoderOwner_ = handle;
+    }
+    LOG_INFO("[A2dpEncoderGroup]%{public}s handle(%u) streams(%zu)\n", __func__, handle, streams_.size());
+}
+
+void A2dpEncoderGroup::RemoveStream(uint16_t handle)
+{
+    streams_.erase(handle);
+    if (streams_.empty()) {
+        encoder_ = nullptr;
+    } else if (handle == encoderOwner_) {
+        // The encoder refers to the codec configuration of the removed stream, rebuild it from another one.
+        encoderOwner_ = streams_.begin()->first;
+        CreateEncoder(*streams_.begin()->second.config);
+    }
+    LOG_INFO("[A2dpEncoderGroup]%{public}s handle(%u) streams(%zu)\n", __func__, handle, streams_.size());
+}
+
+void A2dpEncoderGroup::CreateEncoder(A2dpCodecConfig &config)
 {
     encoder_ = nullptr;
+    if (isSbc_) {
+        encoder_ = std::make_unique<A2dpSbcEncoder>(&peerParams_, &config, this);
+    } else {
+        encoder_ = std::make_unique<A2dpAacEncoder>(&peerParams_, &config, this);
+    }
+}
+
+uint32_t A2dpEncoderGroup::Read(uint8_t **buf, uint32_t size)
+{
+    // All streams play the same audio, so the pcm data is read once for the whole group and shared with the others.
+    if (streams_.empty()) {
+        return 0;
+    }
+    return pcmSource_.Read(*streams_.begin()->second.observer, pcmPosition_, buf, size);
+}
+
+bool A2dpEncoderGroup::EnqueuePacket(const Packet *packet, size_t frames, uint32_t bytes, uint32_t pktTimeStamp) const
+{
+    bool ret = false;
+    for (auto &it : streams_) {
+        Packet *refPacket = PacketRefMalloc(packet);
+        if (refPacket == nullptr) {
+            continue;
+        }
+        if (it.second.observer->EnqueuePacket(refPacket, frames, bytes, pktTimeStamp)) {
+            ret = true;
+        }
+        PacketFree(refPacket);
+    }
+    return ret;
+}
+
+size_t A2dpEncoderGroup::GetTransmitQueueLength() const
+{
+    size_t length = 0;
+    for (auto &it : streams_) {
+        length = std::max(length, it.second.observer->GetTransmitQueueLength());
+    }
+    return length;
+}
+
+A2dpCodecThread::~A2dpCodecThread()
+{
+    streamEncoders_.clear();
+    encoderGroups_.clear();
     decoder_ = nullptr;
-    signalingTimer_ = nullptr;
-    signalingTimer_ = nullptr;
     dispatcher_ = nullptr;
     g_instance = nullptr;
-    isSbc_ = false;
 }
 
 bool A2dpCodecThread::PostMessage(const utility::Message msg, const A2dpEncoderInitPeerParams &peerParams,
@@ -65,6 +217,12 @@ A2dpCodecThread *A2dpCodecThread::GetInstance()
     return g_instance;
 }
 
+A2dpCodecThread *A2dpCodecThread::FindInstance()
+{
+    std::lock_guard<std::recursive_mutex> lock(g_codecMutex);
+    return g_instance;
+}
+
 void A2dpCodecThread::StartA2dpCodecThread()
 {
     dispatcher_->Initialize();
@@ -77,8 +235,8 @@ void A2dpCodecThread::StopA2dpCodecThread()
 
     dispatcher_->Uninitialize();
 
-    if (signalingTimer_ != nullptr) {
-        signalingTimer_->Stop();
+    for (auto &it : encoderGroups_) {
+        it.second->StopTimer();
     }
     threadInit = false;
 }
@@ -86,20 +244,15 @@ void A2dpCodecThread::StopA2dpCodecThread()
 void A2dpCodecThread::ProcessMessage(utility::Message msg, const A2dpEncoderInitPeerParams &peerParams,
     A2dpCodecConfig *config, A2dpEncoderObserver *observer, A2dpDecoderObserver *decObserver)
 {
-    struct timeval tv = {};
-    struct timezone tz = {};
-    gettimeofday(&tv, &tz);
     std::lock_guard<std::recursive_mutex> lock(g_codecMutex);
     switch (msg.what_) {
         case A2DP_AUDIO_RECONFIGURE:
-            if (encoder_ != nullptr) {
-                encoder_->UpdateEncoderParam();
+            for (auto &it : encoderGroups_) {
+                it.second->GetEncoder()->UpdateEncoderParam();
             }
             break;
         case A2DP_PCM_PUSH:
-            if (encoder_ != nullptr) {
-                encoder_->SendFrames(tv.tv_usec);
-            }
+            PushPcm(static_cast<uint32_t>(msg.arg1_));
             break;
         case A2DP_FRAME_READY:
             if (msg.arg2_ != nullptr && decoder_ != nullptr) {
@@ -108,14 +261,13 @@ void A2dpCodecThread::ProcessMessage(utility::Message msg, const A2dpEncoderInit
             free((uint8_t *)msg.arg2_);
             break;
         case A2DP_PCM_ENCODED:
-            if (config == nullptr) {
+            if ((config == nullptr) || (observer == nullptr)) {
                 return;
             }
-            if (encoder_ != nullptr) {
-                A2dpEncoder* encoder = encoder_.release();
-                delete encoder;
-            }
-            SourceEncode(peerParams, *config, *observer);
+            SourceEncode(static_cast<uint16_t>(msg.arg1_), peerParams, *config, *observer);
+            break;
+        case A2DP_STREAM_REMOVED:
+            RemoveEncoderStream(static_cast<uint16_t>(msg.arg1_));
             break;
         case A2DP_FRAME_DECODED:
             if (config == nullptr) {
@@ -132,21 +284,52 @@ void A2dpCodecThread::ProcessMessage(utility::Message msg, const A2dpEncoderInit
     }
 }
 
-void A2dpCodecThread::StartTimer() const
+void A2dpCodecThread::PushPcm(uint32_t groupId)
+{
+    auto it = encoderGroups_.find(groupId);
+    if (it == encoderGroups_.end()) {
+        return;
+    }
+    A2dpEncoderGroup &group = *it->second;
+
+    // A monotonic clock, the encoders measure the real tick interval against it.
+    uint64_t timeStampUs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+    group.GetEncoder()->SetTransmitQueueLength(group.GetTransmitQueueLength());
+    group.GetEncoder()->SendFrames(timeStampUs);
+
+    uint64_t position = pcmSource_.End();
+    for (auto &item : encoderGroups_) {
+        position = std::min(position, item.second->GetPcmPosition());
+    }
+    pcmSource_.Trim(position);
+}
+
+void A2dpCodecThread::StartTimer()
 {
-    if (signalingTimer_ != nullptr) {
-        signalingTimer_->Start(PCM_DATA_ENCODED_TIMER(isSbc_), true);
+    std::lock_guard<std::recursive_mutex> lock(g_codecMutex);
+    if (!timerStarted_) {
+        pcmSource_.Reset();
+        for (auto &it : encoderGroups_) {
+            it.second->StartTimer();
+        }
+        timerStarted_ = true;
     }
 }
 
-void A2dpCodecThread::StopTimer() const
+void A2dpCodecThread::StopTimer()
 {
-    if (signalingTimer_ != nullptr) {
-        signalingTimer_->Stop();
+    std::lock_guard<std::recursive_mutex> lock(g_codecMutex);
+    if (!streamEncoders_.empty()) {
+        LOG_INFO("[A2dpCodecThread]%{public}s %zu streams still encoding\n", __func__, streamEncoders_.size());
+        return;
     }
-    if (encoder_ != nullptr) {
-        encoder_->ResetFeedingState();
+    timerStarted_ = false;
+    for (auto &it : encoderGroups_) {
+        it.second->StopTimer();
+        it.second->GetEncoder()->ResetFeedingState();
     }
+    pcmSource_.Reset();
 }
 
 bool A2dpCodecThread::GetInitStatus() const
@@ -154,40 +337,70 @@ bool A2dpCodecThread::GetInitStatus() const
     return threadInit;
 }
 void A2dpCodecThread::SourceEncode(
-    const A2dpEncoderInitPeerParams &peerParams, const A2dpCodecConfig &config, const A2dpEncoderObserver &observer)
+    uint16_t handle, const A2dpEncoderInitPeerParams &peerParams, A2dpCodecConfig &config, A2dpEncoderObserver &observer)
 {
-    LOG_INFO("[A2dpCodecThread]%{public}s index:%u\n", __func__, config.GetCodecIndex());
+    LOG_INFO("[A2dpCodecThread]%{public}s handle:%u index:%u\n", __func__, handle, config.GetCodecIndex());
     switch (config.GetCodecIndex()) {
         case A2DP_SINK_CODEC_INDEX_SBC:
         case A2DP_SOURCE_CODEC_INDEX_SBC:
-            isSbc_ = true;
-            encoder_ = std::make_unique<A2dpSbcEncoder>(&const_cast<A2dpEncoderInitPeerParams &>(peerParams),
-                &const_cast<A2dpCodecConfig &>(config),
-                &const_cast<A2dpEncoderObserver &>(observer));
-            if (signalingTimer_ != nullptr) {
-                signalingTimer_->Stop();
-                signalingTimer_->Start(PCM_DATA_ENCODED_TIMER(isSbc_), true);
-            }
-            break;
         case A2DP_SOURCE_CODEC_INDEX_AAC:
         case A2DP_SINK_CODEC_INDEX_AAC:
-            isSbc_ = false;
-            encoder_ = std::make_unique<A2dpAacEncoder>(&const_cast<A2dpEncoderInitPeerParams &>(peerParams),
-                &const_cast<A2dpCodecConfig &>(config),
-                &const_cast<A2dpEncoderObserver &>(observer));
-            if (signalingTimer_ != nullptr) {
-                signalingTimer_->Stop();
-                signalingTimer_->Start(PCM_DATA_ENCODED_TIMER(isSbc_), true);
-            }
             break;
         default:
+            return;
+    }
+
+    // The stream may have been reconfigured, so it is always regrouped.
+    RemoveEncoderStream(handle);
+
+    A2dpEncoderGroup *group = nullptr;
+    uint32_t groupId = 0;
+    for (auto &it : encoderGroups_) {
+        if (it.second->Matches(peerParams, config)) {
+            groupId = it.first;
+            group = it.second.get();
             break;
+        }
+    }
+    if (group == nullptr) {
+        groupId = nextGroupId_++;
+        auto tick = std::bind(&A2dpCodecThread::SignalingTimeoutCallback, this, groupId);
+        encoderGroups_[groupId] = std::make_unique<A2dpEncoderGroup>(peerParams, config, pcmSource_, tick);
+        group = encoderGroups_[groupId].get();
+        group->AddStream(handle, config, observer);
+        // Each group pushes at the frame interval of its own codec.
+        group->StartTimer();
+    } else {
+        group->AddStream(handle, config, observer);
+    }
+    streamEncoders_[handle] = groupId;
+    timerStarted_ = true;
+}
+
+void A2dpCodecThread::RemoveEncoderStream(uint16_t handle)
+{
+    auto it = streamEncoders_.find(handle);
+    if (it == streamEncoders_.end()) {
+        return;
+    }
+    uint32_t groupId = it->second;
+    streamEncoders_.erase(it);
+    auto group = encoderGroups_.find(groupId);
+    if (group != encoderGroups_.end()) {
+        group->second->RemoveStream(handle);
+        if (group->second->IsEmpty()) {
+            encoderGroups_.erase(group);
+        }
+    }
+    if (streamEncoders_.empty()) {
+        pcmSource_.Reset();
+        timerStarted_ = false;
     }
 }
 
-void A2dpCodecThread::SignalingTimeoutCallback() const
+void A2dpCodecThread::SignalingTimeoutCallback(uint32_t groupId) const
 {
-    utility::Message msg(A2DP_PCM_PUSH, 0, nullptr);
+    utility::Message msg(A2DP_PCM_PUSH, groupId, nullptr);
     A2dpEncoderInitPeerParams peerParams = {};
 
     PostMessage(msg, peerParams, nullptr, nullptr, nullptr);
@@ -18,8 +18,11 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <list>
+#include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "a2dp_codec/include/a2dp_codec_wrapper.h"
 #include "a2dp_codec/include/a2dp_codec_config.h"
@@ -28,6 +31,7 @@
 #include "base_def.h"
 #include "dispatcher.h"
 #include "message.h"
+#include "timer.h"
 
 namespace bluetooth {
 using utility::Dispatcher;
@@ -40,6 +44,172 @@ using utility::Message;
 #define A2DP_FRAME_DECODED 5
 #define A2DP_FRAME_READY 6
 #define A2DP_PCM_PUSH 7
+#define A2DP_STREAM_REMOVED 8
+
+/**
+ * @brief The pcm data of the audio source. It is pulled once from the source and replayed to every encoder group
+ *        from the position of the group, so each group gets the whole audio at its own pace.
+ *
+ * @since 6.0
+ */
+class A2dpPcmSource {
+public:
+    A2dpPcmSource() = default;
+    ~A2dpPcmSource() = default;
+
+    /**
+     * @brief Read the pcm data at a position, pulling it from the audio source when no group has read that far.
+     *
+     * @param[in] observer The observer that pulls the pcm data from the audio source.
+     * @param[in,out] position The position of the reader, advanced by the bytes read.
+     * @param[out] buf The pcm data, valid until the next read.
+     * @param[in] size The number of bytes to read.
+     * @return The number of bytes read, 0 if the audio source has not enough data.
+     * @since 6.0
+     */
+    uint32_t Read(A2dpEncoderObserver &observer, uint64_t &position, uint8_t **buf, uint32_t size);
+
+    /**
+     * @brief Get the position of the newest pcm data, a new reader starts from there.
+     *
+     * @since 6.0
+     */
+    uint64_t End() const
+    {
+        return base_ + data_.size();
+    }
+
+    /**
+     * @brief Drop the pcm data before a position, every reader has consumed it.
+     *
+     * @param[in] position The position of the slowest reader.
+     * @since 6.0
+     */
+    void Trim(uint64_t position);
+
+    /**
+     * @brief Drop all the pcm data.
+     *
+     * @since 6.0
+     */
+    void Reset();
+
+private:
+    // The position of data_[0] in the audio.
+    uint64_t base_ = 0;
+    std::vector<uint8_t> data_ {};
+    DISALLOW_COPY_AND_ASSIGN(A2dpPcmSource);
+};
+
+/**
+ * @brief One encoder shared by all the streams that negotiated an identical codec configuration.
+ *        Every encoded packet is reference-shared to the observer of each stream.
+ *
+ * @since 6.0
+ */
+class A2dpEncoderGroup : public A2dpEncoderObserver {
+public:
+    /**
+     * @brief A constructor used to create an <b>A2dpEncoderGroup</b> instance.
+     *
+     * @param[in] peerParams The peer parameters used by the encoder.
+     * @param[in] config The negotiated codec configuration.
+     * @param[in] pcmSource The pcm data shared by all the groups.
+     * @param[in] tick The callback of the push timer of the group, called in the thread of the timer.
+     * @since 6.0
+     */
+    A2dpEncoderGroup(const A2dpEncoderInitPeerParams &peerParams, const A2dpCodecConfig &config,
+        A2dpPcmSource &pcmSource, const std::function<void()> &tick);
+    ~A2dpEncoderGroup() override;
+
+    /**
+     * @brief Check whether a stream can join this group.
+     *
+     * @param[in] peerParams The peer parameters of the stream.
+     * @param[in] config The negotiated codec configuration of the stream.
+     * @return true if the stream produces an identical media packets, otherwise false.
+     * @since 6.0
+     */
+    bool Matches(const A2dpEncoderInitPeerParams &peerParams, const A2dpCodecConfig &config) const;
+
+    /**
+     * @brief Add a stream to the group, the encoder is created for the first stream.
+     *
+     * @param[in] handle The AVDTP stream handle.
+     * @param[in] config The negotiated codec configuration of the stream.
+     * @param[in] observer The observer that sends the media packets of the stream.
+     * @since 6.0
+     */
+    void AddStream(uint16_t handle, A2dpCodecConfig &config, A2dpEncoderObserver &observer);
+
+    /**
+     * @brief Remove a stream from the group.
+     *
+     * @param[in] handle The AVDTP stream handle.
+     * @since 6.0
+     */
+    void RemoveStream(uint16_t handle);
+
+    bool IsEmpty() const
+    {
+        return streams_.empty();
+    }
+
+    bool IsSbc() const
+    {
+        return isSbc_;
+    }
+
+    A2dpEncoder *GetEncoder() const
+    {
+        return encoder_.get();
+    }
+
+    uint64_t GetPcmPosition() const
+    {
+        return pcmPosition_;
+    }
+
+    /**
+     * @brief Start the push timer at the frame interval of the codec, and read the pcm data from the newest one.
+     *
+     * @since 6.0
+     */
+    void StartTimer();
+
+    /**
+     * @brief Stop the push timer.
+     *
+     * @since 6.0
+     */
+    void StopTimer();
+
+    uint32_t Read(uint8_t **buf, uint32_t size) override;
+    bool EnqueuePacket(const Packet *packet, size_t frames, uint32_t bytes, uint32_t pktTimeStamp) const override;
+    // The most congested stream limits the bitrate of the shared encoder.
+    size_t GetTransmitQueueLength() const override;
+
+private:
+    struct StreamInfo {
+        A2dpCodecConfig *config;
+        A2dpEncoderObserver *observer;
+    };
+
+    void CreateEncoder(A2dpCodecConfig &config);
+
+    A2dpEncoderInitPeerParams peerParams_ {};
+    A2dpCodecIndex codecIndex_ {};
+    uint8_t codecInfo_[A2DP_CODEC_SIZE] {};
+    bool isSbc_ = false;
+    // The stream whose codec configuration is referenced by the encoder.
+    uint16_t encoderOwner_ = 0;
+    std::map<uint16_t, StreamInfo> streams_ {};
+    std::unique_ptr<A2dpEncoder> encoder_ = nullptr;
+    A2dpPcmSource &pcmSource_;
+    uint64_t pcmPosition_ = 0;
+    std::unique_ptr<utility::Timer> timer_ = nullptr;
+    DISALLOW_COPY_AND_ASSIGN(A2dpEncoderGroup);
+};
 
 class A2dpCodecThread {
 public:
@@ -59,6 +229,14 @@ public:
      */
     static A2dpCodecThread *GetInstance();
 
+    /**
+     * @brief Get the A2dpCodecThread object without creating it.
+     *
+     * @return Returns the A2dpCodecThread object, nullptr if it does not exist.
+     * @since 6.0
+     */
+    static A2dpCodecThread *FindInstance();
+
     /**
      * @brief Start a A2dpCodecThread object.
      *
@@ -117,16 +295,16 @@ public:
         A2dpEncoderObserver *observer, A2dpDecoderObserver *decObserver);
 
     /**
-     * @brief Start the timer
+     * @brief Start the push timers of the encoder groups.
      * @since 6.0
      */
-    void StartTimer() const;
+    void StartTimer();
 
     /**
-     * @brief Stop the timer
+     * @brief Stop the push timers, they keep running while any stream is still encoding.
      * @since 6.0
      */
-    void StopTimer() const;
+    void StopTimer();
 
     /**
      * @brief Get the init status
@@ -136,12 +314,20 @@ public:
 
 private:
     /**
-     * @brief Source side  encode
+     * @brief Source side encode, the stream joins the encoder of an identical configuration or gets a new one.
      *
      * @since 6.0
      */
-    void SourceEncode(const A2dpEncoderInitPeerParams &peerParams, const A2dpCodecConfig &config,
-        const A2dpEncoderObserver &observer);
+    void SourceEncode(uint16_t handle, const A2dpEncoderInitPeerParams &peerParams, A2dpCodecConfig &config,
+        A2dpEncoderObserver &observer);
+
+    /**
+     * @brief Remove a stream from the encoder it shares, stop the timer when no stream is left.
+     *
+     * @param[in] handle The AVDTP stream handle.
+     * @since 6.0
+     */
+    void RemoveEncoderStream(uint16_t handle);
 
     /**
      * @brief Source side  encode
@@ -151,20 +337,32 @@ private:
     void SinkDecode(const A2dpCodecConfig &config, A2dpDecoderObserver &observer);
 
     /**
-     * @brief Timer to push pcm data
+     * @brief Timer to push pcm data to an encoder group.
+     *
+     * @param[in] groupId The id of the encoder group.
+     * @since 6.0
+     */
+    void SignalingTimeoutCallback(uint32_t groupId) const;
+
+    /**
+     * @brief Encode the pcm data of one tick of an encoder group.
      *
+     * @param[in] groupId The id of the encoder group.
      * @since 6.0
      */
-    void SignalingTimeoutCallback() const;
+    void PushPcm(uint32_t groupId);
 
     std::string name_ {};
     std::unique_ptr<Dispatcher> dispatcher_ {};
-    std::unique_ptr<A2dpEncoder> encoder_ = nullptr;
+    A2dpPcmSource pcmSource_ {};
+    // The groups by id, a tick posted by the timer of a removed group finds no group.
+    std::map<uint32_t, std::unique_ptr<A2dpEncoderGroup>> encoderGroups_ {};
+    std::map<uint16_t, uint32_t> streamEncoders_ {};
+    uint32_t nextGroupId_ = 0;
     std::unique_ptr<A2dpDecoder> decoder_ = nullptr;
-    std::unique_ptr<utility::Timer> signalingTimer_ = nullptr;
     static A2dpCodecThread *g_instance;
     bool threadInit = false;
-    bool isSbc_ = false;
+    bool timerStarted_ = false;
 };
 }  // namespace bluetooth
 
@@ -19,6 +19,7 @@
 #include "a2dp_codec_thread.h"
 #include "a2dp_service.h"
 #include "adapter_config.h"
+#include "btm.h"
 #include "log.h"
 #include "power_manager.h"
 #include "profile_config.h"
@@ -127,9 +128,10 @@ uint32_t A2dpCodecEncoderObserver::Read(uint8_t **buf, uint32_t size)
     }
 }
 
-A2dpCodecEncoderObserver::A2dpCodecEncoderObserver(uint16_t streamHandle)
+A2dpCodecEncoderObserver::A2dpCodecEncoderObserver(uint16_t streamHandle, const BtAddr &peerAddr)
 {
     streamHandle_ = streamHandle;
+    peerAddr_ = peerAddr;
 }
 
 bool A2dpCodecEncoderObserver::EnqueuePacket(const Packet *packet, size_t frames, uint32_t bytes,
@@ -149,6 +151,15 @@ bool A2dpCodecEncoderObserver::EnqueuePacket(const Packet *packet, size_t frames
     return ret;
 }
 
+size_t A2dpCodecEncoderObserver::GetTransmitQueueLength() const
+{
+    uint16_t queueLength = 0;
+    if (BTM_GetAclTxQueueLength(&peerAddr_, &queueLength) != BT_NO_ERROR) {
+        return 0;
+    }
+    return queueLength;
+}
+
 void A2dpCodecDecoderObserver::DataAvailable(uint8_t *buf, uint32_t size)
 {
     LOG_INFO("[A2dpStream] %{public}s )\n", __func__);
@@ -234,6 +245,14 @@ A2dpProfilePeer::~A2dpProfilePeer()
 {
     LOG_INFO("[A2dpProfilePeer]%{public}s\n", __func__);
 
+    // The shared encoder must not reference the observer and codec configuration of this peer any more, there is
+    // nothing to remove once the codec thread is gone.
+    A2dpCodecThread *codecThread = A2dpCodecThread::FindInstance();
+    if ((encoderObserver_ != nullptr) && (codecThread != nullptr)) {
+        utility::Message msg(A2DP_STREAM_REMOVED, GetStreamHandle(), nullptr);
+        A2dpEncoderInitPeerParams peerParams = {};
+        codecThread->ProcessMessage(msg, peerParams, nullptr, nullptr, nullptr);
+    }
     if (codecConfig_ != nullptr) {
         delete codecConfig_;
     }
@@ -874,7 +893,7 @@ void A2dpProfilePeer::SelectCodecInfo(A2dpCodecCapability &userConfig, uint8_t *
 void A2dpProfilePeer::NotifyEncoder()
 {
     A2dpCodecThread *codecThread = A2dpCodecThread::GetInstance();
-    utility::Message msg(A2DP_PCM_ENCODED, localRole_, nullptr);
+    utility::Message msg(A2DP_PCM_ENCODED, GetStreamHandle(), nullptr);
     A2dpEncoderInitPeerParams peerParams = {};
     A2dpCodecConfig *config = nullptr;
 
@@ -896,7 +915,7 @@ void A2dpProfilePeer::NotifyEncoder()
         LOG_INFO("[A2dpProfilePeer]%{public}s edr(%{public}d) 3Mb(%{public}d) \n", __func__, peerParams.isPeerEdr,
             peerParams.peerSupports3mbps);
         if (encoderObserver_ == nullptr) {
-            encoderObserver_ = std::make_unique<A2dpCodecEncoderObserver>(GetStreamHandle());
+            encoderObserver_ = std::make_unique<A2dpCodecEncoderObserver>(GetStreamHandle(), peerAddress_);
         }
         codecThread->ProcessMessage(msg, peerParams, config, encoderObserver_.get(), nullptr);
     } else {
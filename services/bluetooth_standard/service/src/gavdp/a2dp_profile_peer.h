@@ -144,14 +144,17 @@ private:
 
 class A2dpCodecEncoderObserver : public A2dpEncoderObserver {
 public:
-    explicit A2dpCodecEncoderObserver(uint16_t streamHandle);
+    A2dpCodecEncoderObserver(uint16_t streamHandle, const BtAddr &peerAddr);
     ~A2dpCodecEncoderObserver() = default;
     uint32_t Read(uint8_t **buf, uint32_t size) override;
     // pktTimeStamp will be added in packet's head.
     bool EnqueuePacket(const Packet *packet, size_t frames, uint32_t bytes, uint32_t pktTimeStamp) const override;
+    // ACL packets of the peer link that are not completed by the controller.
+    size_t GetTransmitQueueLength() const override;
 
 private:
     uint16_t streamHandle_ = 0;
+    BtAddr peerAddr_ {};
 };
 
 class A2dpCodecDecoderObserver : public A2dpDecoderObserver {
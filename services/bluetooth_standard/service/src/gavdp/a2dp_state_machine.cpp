@@ -774,6 +774,20 @@ bool A2dpStateStreaming::Dispatch(const utility::Message &msg)
     A2dpAvdtp avdtp(role);
     uint8_t label = 0;
 
+    switch (msg.what_) {
+        case EVT_SUSPEND_IND:
+        case EVT_SUSPEND_CFM:
+        case EVT_CLOSE_IND:
+        case EVT_CLOSE_CFM:
+        case EVT_DISCONNECT_IND:
+            if (role == A2DP_ROLE_SOURCE) {
+                RemoveEncoderStream(msgData.stream.handle);
+            }
+            break;
+        default:
+            break;
+    }
+
     switch (msg.what_) {
         case EVT_GET_ALLCAP_REQ:
             avdtp.GetAllCapabilityReq(msgData.stream.addr, msgData.stream.acpSeid, label);
@@ -812,6 +826,16 @@ bool A2dpStateStreaming::Dispatch(const utility::Message &msg)
     return true;
 }
 
+void A2dpStateStreaming::RemoveEncoderStream(uint16_t handle) const
+{
+    A2dpCodecThread *codecThread = A2dpCodecThread::GetInstance();
+    utility::Message msg(A2DP_STREAM_REMOVED, handle, nullptr);
+    A2dpEncoderInitPeerParams peerParams = {};
+
+    // Other sinks may keep streaming the same audio, only this stream leaves the shared encoder.
+    codecThread->ProcessMessage(msg, peerParams, nullptr, nullptr, nullptr);
+}
+
 void A2dpStateStreaming::SetStateName(std::string state)
 {
     std::lock_guard<std::recursive_mutex> lock(g_stateMutex);
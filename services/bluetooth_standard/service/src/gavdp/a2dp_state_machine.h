@@ -526,6 +526,13 @@ private:
      */
     void ProcessSuspendInd(A2dpAvdtMsgData msgData, uint8_t role);
 
+    /**
+     * @brief Remove the stream from the encoder of codec thread.
+     * @param[in] handle The handle of stream
+     * @since 6.0
+     */
+    void RemoveEncoderStream(uint16_t handle) const;
+
     /**
      * @brief Set current state
      *
@@ -15,7 +15,6 @@
 
 #include "hfp_ag_command_parser.h"
 
-#include <cstring>
 #include <string>
 
 #include "hfp_ag_defines.h"
@@ -31,143 +30,69 @@ HfpAgCommandParser &HfpAgCommandParser::GetInstance()
 void HfpAgCommandParser::Read(HfpAgDataConnection &dataConn) const
 {
     Packet *pkt = nullptr;
-    Buffer *buf = nullptr;
-    uint8_t *pData = nullptr;
 
     dataConn.ReadData(&pkt);
     if (pkt != nullptr) {
-        auto len = PacketPayloadSize(pkt);
-        buf = PacketContinuousPayload(pkt);
-        pData = (uint8_t *)BufferPtr(buf);
-
-        std::vector<uint8_t> data(pData, pData + len);
-        Parse(dataConn, data, len);
+        Buffer *buf = PacketContinuousPayload(pkt);
+        if (buf != nullptr) {
+            dataConn.atTokenizer_.Feed((uint8_t *)BufferPtr(buf), PacketPayloadSize(pkt),
+                [this, &dataConn](std::string_view line) { Parse(dataConn, line); });
+        }
         PacketFree(pkt);
     }
 }
 
-void HfpAgCommandParser::Parse(HfpAgDataConnection &dataConn, std::vector<uint8_t> &data, size_t len) const
+void HfpAgCommandParser::Parse(HfpAgDataConnection &dataConn, std::string_view line) const
 {
-    std::string cmd;
+    std::string_view cmd;
     std::string arg;
-    size_t cmdLen = 0;
-    int cmdType = HFP_AG_CMD_UNKNOWN;
-
-    if (data.empty() == true) {
-        LOG_DEBUG("[HFP AG]%{public}s():data is nullptr", __FUNCTION__);
-        return;
-    }
-
-    for (size_t pos = 0; pos < len; pos++) {
-        // skip null characters
-        if (data[pos] == '\0') {
-            continue;
-        }
-        std::vector<uint8_t> partData(data.begin() + pos, data.end());
-        cmdType = Extract(partData, cmd, arg, cmdLen, len - pos);
-        pos += cmdLen;
-        HfpAgCommandProcessor::GetInstance().Handle(dataConn, cmd, arg, cmdType);
-    }
-    return;
+    int cmdType = Extract(line, cmd, arg);
+    HfpAgCommandProcessor::GetInstance().Handle(dataConn, cmd, arg, cmdType);
 }
 
-int HfpAgCommandParser::Extract(std::vector<uint8_t> &data,
-                                std::string &cmd,
-                                std::string &arg,
-                                size_t &cmdLen,
-                                size_t len) const
+int HfpAgCommandParser::Extract(std::string_view line, std::string_view &cmd, std::string &arg)
 {
-    HfpAgCommandParser::CommandPosition position {0, 0, 0, 0, 0, false, false};
-    GetCommandPosition(data, len, position);
-    LOG_DEBUG("[HFP AG]%{public}s():headValid[%{public}d], tailValid[%{public}d], startPos[%hu], setPos[%hu], getPos[%hu], endPos[%hu]",
-        __FUNCTION__,
-        position.headValid,
-        position.tailValid,
-        position.startPos,
-        position.setPos,
-        position.getPos,
-        position.endPos);
-
-    if (!position.headValid || !position.tailValid || position.endPos < HFP_AG_AT_HEAD_SIZE ||
-        (position.setPos >= position.endPos) || (position.getPos >= position.endPos)) {
-        cmdLen = position.pos;
+    // skip any characters before the "AT" head
+    size_t startPos = 0;
+    while ((startPos + 1 < line.size()) &&
+           !((line[startPos] == 'A' || line[startPos] == 'a') &&
+           (line[startPos + 1] == 'T' || line[startPos + 1] == 't'))) {
+        startPos++;
+    }
+    if (startPos + HFP_AG_AT_HEAD_SIZE > line.size()) {
         LOG_DEBUG("[HFP AG]%{public}s():HFP_AG_CMD_INVALID", __FUNCTION__);
         return HFP_AG_CMD_INVALID;
     }
+    line.remove_prefix(startPos);
 
     int type;
-    cmdLen = position.endPos - position.startPos + 1;
-    // cmd include cmd itself and cmd arguments
-    cmd = std::string((char *)&data[position.startPos], cmdLen);
-    if (cmd.compare(0, ATA_LENGTH, "ATA", 0, ATA_LENGTH) == 0) {
+    size_t opPos = line.find_first_of("=?");
+    if (line.compare(0, ATA_LENGTH, "ATA") == 0) {
         type = HFP_AG_CMD_EXEC;
-        cmd = "ATA";
-    } else if (cmd.compare(0, ATD_LENGTH, "ATD", 0, ATD_LENGTH) == 0) {
+        cmd = line.substr(0, ATA_LENGTH);
+    } else if (line.compare(0, ATD_LENGTH, "ATD") == 0) {
         type = HFP_AG_CMD_EXEC;
-        arg = std::string(cmd, ATD_LENGTH, cmd.length() - (ATD_LENGTH - 1));
-        cmd = "ATD";
-    } else if (!position.setPos && !position.getPos) {
+        cmd = line.substr(0, ATD_LENGTH);
+        arg = std::string(line.substr(ATD_LENGTH));
+    } else if (opPos == std::string_view::npos) {
         type = HFP_AG_CMD_EXEC;
-        cmd = cmd.substr(0, cmd.length() - (AT_EXEC_OPERATOR_LENGTH + 1));
-    } else if (!position.setPos && position.getPos) {
-        type = HFP_AG_CMD_GET;
-        cmd = cmd.substr(0, cmd.length() - (AT_GET_OPERATOR_LENGTH + 1));
-    } else if (position.setPos && !position.getPos) {
-        type = HFP_AG_CMD_SET;
-        ExtractArg(cmd, arg);
-    } else if (position.setPos == position.getPos - 1) {
+        cmd = line;
+    } else if (line[opPos] == '?') {
+        type = (opPos + 1 == line.size()) ? HFP_AG_CMD_GET : HFP_AG_CMD_UNKNOWN;
+        cmd = line.substr(0, opPos);
+    } else if (line.substr(opPos) == AT_TEST_OPERATOR) {
         type = HFP_AG_CMD_TEST;
-        cmd = cmd.substr(0, cmd.length() - (AT_TEST_OPERATOR_LENGTH + 1));
+        cmd = line.substr(0, opPos);
+    } else if (line.find('?', opPos) == std::string_view::npos) {
+        type = HFP_AG_CMD_SET;
+        cmd = line.substr(0, opPos);
+        arg = std::string(line.substr(opPos + 1));
     } else {
         type = HFP_AG_CMD_UNKNOWN;
+        cmd = line.substr(0, opPos);
     }
-    LOG_DEBUG(
-        "[HFP AG]%{public}s():cmd[%{public}s], arg[%{public}s], type[%{public}d], cmdLen[%zu]",
-        __FUNCTION__, cmd.c_str(), arg.c_str(), type, cmdLen);
+    LOG_DEBUG("[HFP AG]%{public}s():arg[%{public}s], type[%{public}d], cmdLen[%zu]",
+        __FUNCTION__, arg.c_str(), type, cmd.size());
     return type;
 }
-
-void HfpAgCommandParser::GetCommandPosition(const std::vector<uint8_t> &data,
-                                            size_t len,
-                                            HfpAgCommandParser::CommandPosition &position) const
-{
-    for (position.pos = 0; position.pos < len; position.pos++) {
-        if (data[position.pos] == 'A' || data[position.pos] == 'a') {
-            if ((position.pos + 1 < (int)len) &&
-                ((data[position.pos + 1] == 'T') || (data[position.pos + 1] == 't'))) {
-                position.startPos = position.pos;
-                position.headValid = true;
-            }
-        }
-
-        if (data[position.pos] == '=') {
-            position.setPos = position.pos;
-        }
-        if (data[position.pos] == '?') {
-            position.getPos = position.pos;
-        }
-
-        if (((data[position.pos] == '\r') || (data[position.pos] == '\n')) &&
-            (position.pos > position.startPos) &&
-            (position.headValid)) {
-            position.tailValid = true;
-            position.endPos = position.pos;
-            break;
-        }
-    }
-}
-
-void HfpAgCommandParser::ExtractArg(std::string &cmd, std::string &arg) const
-{
-    for (auto it : g_atCmdMap) {
-        if (cmd.find(it.first) != std::string::npos) {
-            // -2 because '\r' and '=' occupied two chars
-            arg = std::string(cmd, it.first.length() + 1,
-                              cmd.length() - it.first.length() - (AT_SET_OPERATOR_LENGTH + 1));
-            cmd = it.first;
-            break;
-        }
-    }
-    LOG_DEBUG("[HFP AG]%{public}s():cmd[%{public}s] arg[%{public}s]", __FUNCTION__, cmd.c_str(), arg.c_str());
-}
 }  // namespace bluetooth
\ No newline at end of file
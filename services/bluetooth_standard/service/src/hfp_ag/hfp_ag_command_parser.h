@@ -18,8 +18,7 @@
 
 #include <cstdint>
 #include <string>
-#include <unordered_map>
-#include <vector>
+#include <string_view>
 
 #include "base_def.h"
 #include "hfp_ag_command_processor.h"
@@ -38,19 +37,6 @@ public:
      */
     static HfpAgCommandParser &GetInstance();
 
-    /**
-     * @brief Struct for store command position.
-     */
-    struct CommandPosition {
-        uint16_t pos;
-        uint16_t endPos;
-        uint16_t setPos;
-        uint16_t getPos;
-        uint16_t startPos;
-        bool headValid;
-        bool tailValid;
-    };
-
     /**
      * @brief Read data from data link.
      *
@@ -59,43 +45,22 @@ public:
     void Read(HfpAgDataConnection &dataConn) const;
 
     /**
-     * @brief Parse data bufffer.
+     * @brief Parse one complete AT command line and dispatch it.
      *
      * @param dataConn Data connection.
-     * @param data Data buffer pointer.
-     * @param len Data buffer length.
+     * @param line AT command line without the trailing <cr>.
      */
-    void Parse(HfpAgDataConnection &dataConn, std::vector<uint8_t> &data, size_t len) const;
+    void Parse(HfpAgDataConnection &dataConn, std::string_view line) const;
 
     /**
-     * @brief Extract At command from data buffer.
+     * @brief Extract At command from command line.
      *
-     * @param data Data buffer pointer.
-     * @param cmd AT command.
+     * @param line AT command line without the trailing <cr>.
+     * @param cmd AT command, refers to line.
      * @param arg AT command argument.
-     * @param cmdLen AT command length include command & argument.
-     * @param len Data buffer length.
      * @return Returns error code of the result.
      */
-    int Extract(std::vector<uint8_t> &data, std::string &cmd, std::string &arg, size_t &cmdLen, size_t len) const;
-
-    /**
-     * @brief Extract command argument for AT Setter command.
-     *
-     * @param cmd AT command.
-     * @param arg AT command argument.
-     */
-    void ExtractArg(std::string &cmd, std::string &arg) const;
-
-    /**
-     * @brief Get the Command Position object.
-     *
-     * @param data Data buffer pointer.
-     * @param len Data buffer length.
-     * @param pos Data buffer position.
-     */
-    void GetCommandPosition(const std::vector<uint8_t> &data, size_t len,
-                            HfpAgCommandParser::CommandPosition &pos) const;
+    static int Extract(std::string_view line, std::string_view &cmd, std::string &arg);
 
 private:
     HfpAgCommandParser() = default;
@@ -105,14 +70,7 @@ private:
     inline static constexpr int HFP_AG_AT_HEAD_SIZE = 2;
     inline static constexpr int ATA_LENGTH = 3;
     inline static constexpr int ATD_LENGTH = 3;
-    inline static constexpr int AT_EXEC_OPERATOR_LENGTH = 0;    // operator ""
-    inline static constexpr int AT_GET_OPERATOR_LENGTH = 1;     // operator "?"
-    inline static constexpr int AT_SET_OPERATOR_LENGTH = 1;     // operator "="
-    inline static constexpr int AT_TEST_OPERATOR_LENGTH = 2;    // operator "=?"
-
-    std::unordered_map<std::string, HfpAgCommandProcessor::HfpAgAtHandler> &g_atCmdMap {
-        HfpAgCommandProcessor::GetInstance().GetAtCmdMap()
-    };
+    inline static constexpr std::string_view AT_TEST_OPERATOR = "=?";
 };
 }  // namespace bluetooth
 #endif // HFP_AG_COMMAND_PARSER_H
\ No newline at end of file
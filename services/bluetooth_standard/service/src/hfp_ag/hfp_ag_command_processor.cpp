@@ -26,111 +26,137 @@
 #include "securec.h"
 
 namespace bluetooth {
-std::unordered_map<std::string, HfpAgCommandProcessor::HfpAgAtHandler> HfpAgCommandProcessor::g_atCmdMap = {
-    std::make_pair<std::string, HfpAgAtHandler>("AT+BRSF", {&HfpAgCommandProcessor::AtEmptyFn,
-                                                            &HfpAgCommandProcessor::BrsfSetter,
-                                                            &HfpAgCommandProcessor::AtEmptyFn,
-                                                            &HfpAgCommandProcessor::AtEmptyFn}),
-    std::make_pair<std::string, HfpAgAtHandler>("AT+CCWA", {&HfpAgCommandProcessor::AtEmptyFn,
-                                                            &HfpAgCommandProcessor::CcwaSetter,
-                                                            &HfpAgCommandProcessor::AtEmptyFn,
-                                                            &HfpAgCommandProcessor::AtEmptyFn}),
-    std::make_pair<std::string, HfpAgAtHandler>("AT+CLIP", {&HfpAgCommandProcessor::AtEmptyFn,
-                                                            &HfpAgCommandProcessor::ClipSetter,
-                                                            &HfpAgCommandProcessor::AtEmptyFn,
-                                                            &HfpAgCommandProcessor::AtEmptyFn}),
-    std::make_pair<std::string, HfpAgAtHandler>("AT+CMER", {&HfpAgCommandProcessor::AtEmptyFn,
-                                                            &HfpAgCommandProcessor::CmerSetter,
-                                                            &HfpAgCommandProcessor::AtEmptyFn,
-                                                            &HfpAgCommandProcessor::AtEmptyFn}),
-    std::make_pair<std::string, HfpAgAtHandler>("AT+CMEE", {&HfpAgCommandProcessor::AtEmptyFn,
-                                                            &HfpAgCommandProcessor::CmeeSetter,
-                                                            &HfpAgCommandProcessor::AtEmptyFn,
-                                                            &HfpAgCommandProcessor::AtEmptyFn}),
-    std::make_pair<std::string, HfpAgAtHandler>("AT+BCC", {&HfpAgCommandProcessor::AtEmptyFn,
-                                                           &HfpAgCommandProcessor::AtEmptyFn,
-                                                           &HfpAgCommandProcessor::AtEmptyFn,
-                                                           &HfpAgCommandProcessor::BccExecuter}),
-    std::make_pair<std::string, HfpAgAtHandler>("ATA", {&HfpAgCommandProcessor::AtEmptyFn,
-                                                        &HfpAgCommandProcessor::AtEmptyFn,
-                                                        &HfpAgCommandProcessor::AtEmptyFn,
-                                                        &HfpAgCommandProcessor::AtaExecuter}),
-    std::make_pair<std::string, HfpAgAtHandler>("ATD", {&HfpAgCommandProcessor::AtEmptyFn,
-                                                        &HfpAgCommandProcessor::AtEmptyFn,
-                                                        &HfpAgCommandProcessor::AtEmptyFn,
-                                                        &HfpAgCommandProcessor::AtdExecuter}),
-    std::make_pair<std::string, HfpAgAtHandler>("AT+VGS", {&HfpAgCommandProcessor::AtEmptyFn,
-                                                           &HfpAgCommandProcessor::VgsSetter,
-                                                           &HfpAgCommandProcessor::AtEmptyFn,
-                                                           &HfpAgCommandProcessor::AtEmptyFn}),
-    std::make_pair<std::string, HfpAgAtHandler>("AT+VGM", {&HfpAgCommandProcessor::AtEmptyFn,
-                                                           &HfpAgCommandProcessor::VgmSetter,
-                                                           &HfpAgCommandProcessor::AtEmptyFn,
-                                                           &HfpAgCommandProcessor::AtEmptyFn}),
-    std::make_pair<std::string, HfpAgAtHandler>("AT+CHLD", {&HfpAgCommandProcessor::AtEmptyFn,
-                                                            &HfpAgCommandProcessor::ChldSetter,
-                                                            &HfpAgCommandProcessor::ChldTester,
-                                                            &HfpAgCommandProcessor::AtEmptyFn}),
-    std::make_pair<std::string, HfpAgAtHandler>("AT+CHUP", {&HfpAgCommandProcessor::AtEmptyFn,
-                                                            &HfpAgCommandProcessor::AtEmptyFn,
-                                                            &HfpAgCommandProcessor::AtEmptyFn,
-                                                            &HfpAgCommandProcessor::ChupExecuter}),
-    std::make_pair<std::string, HfpAgAtHandler>("AT+CIND", {&HfpAgCommandProcessor::CindGetter,
-                                                            &HfpAgCommandProcessor::AtEmptyFn,
-                                                            &HfpAgCommandProcessor::CindTester,
-                                                            &HfpAgCommandProcessor::AtEmptyFn}),
-    std::make_pair<std::string, HfpAgAtHandler>("AT+VTS", {&HfpAgCommandProcessor::AtEmptyFn,
-                                                           &HfpAgCommandProcessor::VtsSetter,
-                                                           &HfpAgCommandProcessor::AtEmptyFn,
-                                                           &HfpAgCommandProcessor::AtEmptyFn}),
-    std::make_pair<std::string, HfpAgAtHandler>("AT+BLDN", {&HfpAgCommandProcessor::AtEmptyFn,
-                                                            &HfpAgCommandProcessor::AtEmptyFn,
-                                                            &HfpAgCommandProcessor::AtEmptyFn,
-                                                            &HfpAgCommandProcessor::BldnExecuter}),
-    std::make_pair<std::string, HfpAgAtHandler>("AT+BVRA", {&HfpAgCommandProcessor::AtEmptyFn,
-                                                            &HfpAgCommandProcessor::BvraSetter,
-                                                            &HfpAgCommandProcessor::AtEmptyFn,
-                                                            &HfpAgCommandProcessor::AtEmptyFn}),
-    std::make_pair<std::string, HfpAgAtHandler>("AT+NREC", {&HfpAgCommandProcessor::AtEmptyFn,
-                                                            &HfpAgCommandProcessor::NrecSetter,
-                                                            &HfpAgCommandProcessor::AtEmptyFn,
-                                                            &HfpAgCommandProcessor::AtEmptyFn}),
-    std::make_pair<std::string, HfpAgAtHandler>("AT+CNUM", {&HfpAgCommandProcessor::AtEmptyFn,
-                                                            &HfpAgCommandProcessor::AtEmptyFn,
-                                                            &HfpAgCommandProcessor::AtEmptyFn,
-                                                            &HfpAgCommandProcessor::CnumExecuter}),
-    std::make_pair<std::string, HfpAgAtHandler>("AT+CLCC", {&HfpAgCommandProcessor::AtEmptyFn,
-                                                            &HfpAgCommandProcessor::AtEmptyFn,
-                                                            &HfpAgCommandProcessor::AtEmptyFn,
-                                                            &HfpAgCommandProcessor::ClccExecuter}),
-    std::make_pair<std::string, HfpAgAtHandler>("AT+COPS", {&HfpAgCommandProcessor::CopsGetter,
-                                                            &HfpAgCommandProcessor::CopsSetter,
-                                                            &HfpAgCommandProcessor::AtEmptyFn,
-                                                            &HfpAgCommandProcessor::AtEmptyFn}),
-    std::make_pair<std::string, HfpAgAtHandler>("AT+BIA", {&HfpAgCommandProcessor::AtEmptyFn,
-                                                           &HfpAgCommandProcessor::BiaSetter,
-                                                           &HfpAgCommandProcessor::AtEmptyFn,
-                                                           &HfpAgCommandProcessor::AtEmptyFn}),
-    std::make_pair<std::string, HfpAgAtHandler>("AT+BCS", {&HfpAgCommandProcessor::AtEmptyFn,
-                                                           &HfpAgCommandProcessor::BcsSetter,
-                                                           &HfpAgCommandProcessor::AtEmptyFn,
-                                                           &HfpAgCommandProcessor::AtEmptyFn}),
-    std::make_pair<std::string, HfpAgAtHandler>("AT+BIND", {&HfpAgCommandProcessor::BindGetter,
-                                                            &HfpAgCommandProcessor::BindSetter,
-                                                            &HfpAgCommandProcessor::BindTester,
-                                                            &HfpAgCommandProcessor::AtEmptyFn}),
-    std::make_pair<std::string, HfpAgAtHandler>("AT+BIEV", {&HfpAgCommandProcessor::AtEmptyFn,
-                                                            &HfpAgCommandProcessor::BievSetter,
-                                                            &HfpAgCommandProcessor::AtEmptyFn,
-                                                            &HfpAgCommandProcessor::AtEmptyFn}),
-    std::make_pair<std::string, HfpAgAtHandler>("AT+BAC", {&HfpAgCommandProcessor::AtEmptyFn,
-                                                           &HfpAgCommandProcessor::BacSetter,
-                                                           &HfpAgCommandProcessor::AtEmptyFn,
-                                                           &HfpAgCommandProcessor::AtEmptyFn}),
-    std::make_pair<std::string, HfpAgAtHandler>("AT+BTRH", {&HfpAgCommandProcessor::BtrhGetter,
-                                                            &HfpAgCommandProcessor::BtrhSetter,
-                                                            &HfpAgCommandProcessor::AtEmptyFn,
-                                                            &HfpAgCommandProcessor::AtEmptyFn})
+const HfpAgCommandProcessor::HfpAgAtHandler HfpAgCommandProcessor::AT_CMD_HANDLERS[AT_CMD_NUM] = {
+    // AT+BRSF
+    {&HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::BrsfSetter,
+     &HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::AtEmptyFn},
+    // AT+CCWA
+    {&HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::CcwaSetter,
+     &HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::AtEmptyFn},
+    // AT+CLIP
+    {&HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::ClipSetter,
+     &HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::AtEmptyFn},
+    // AT+CMER
+    {&HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::CmerSetter,
+     &HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::AtEmptyFn},
+    // AT+CMEE
+    {&HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::CmeeSetter,
+     &HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::AtEmptyFn},
+    // AT+BCC
+    {&HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::BccExecuter},
+    // ATA
+    {&HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::AtaExecuter},
+    // ATD
+    {&HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::AtdExecuter},
+    // AT+VGS
+    {&HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::VgsSetter,
+     &HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::AtEmptyFn},
+    // AT+VGM
+    {&HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::VgmSetter,
+     &HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::AtEmptyFn},
+    // AT+CHLD
+    {&HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::ChldSetter,
+     &HfpAgCommandProcessor::ChldTester,
+     &HfpAgCommandProcessor::AtEmptyFn},
+    // AT+CHUP
+    {&HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::ChupExecuter},
+    // AT+CIND
+    {&HfpAgCommandProcessor::CindGetter,
+     &HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::CindTester,
+     &HfpAgCommandProcessor::AtEmptyFn},
+    // AT+VTS
+    {&HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::VtsSetter,
+     &HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::AtEmptyFn},
+    // AT+BLDN
+    {&HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::BldnExecuter},
+    // AT+BVRA
+    {&HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::BvraSetter,
+     &HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::AtEmptyFn},
+    // AT+NREC
+    {&HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::NrecSetter,
+     &HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::AtEmptyFn},
+    // AT+CNUM
+    {&HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::CnumExecuter},
+    // AT+CLCC
+    {&HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::ClccExecuter},
+    // AT+COPS
+    {&HfpAgCommandProcessor::CopsGetter,
+     &HfpAgCommandProcessor::CopsSetter,
+     &HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::AtEmptyFn},
+    // AT+BIA
+    {&HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::BiaSetter,
+     &HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::AtEmptyFn},
+    // AT+BCS
+    {&HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::BcsSetter,
+     &HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::AtEmptyFn},
+    // AT+BIND
+    {&HfpAgCommandProcessor::BindGetter,
+     &HfpAgCommandProcessor::BindSetter,
+     &HfpAgCommandProcessor::BindTester,
+     &HfpAgCommandProcessor::AtEmptyFn},
+    // AT+BIEV
+    {&HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::BievSetter,
+     &HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::AtEmptyFn},
+    // AT+BAC
+    {&HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::BacSetter,
+     &HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::AtEmptyFn},
+    // AT+BTRH
+    {&HfpAgCommandProcessor::BtrhGetter,
+     &HfpAgCommandProcessor::BtrhSetter,
+     &HfpAgCommandProcessor::AtEmptyFn,
+     &HfpAgCommandProcessor::AtEmptyFn}
 };
 
 int HfpAgCommandProcessor::StoiTryCatch(HfpAgDataConnection &dataConn, const std::string &arg)
@@ -173,28 +199,30 @@ void HfpAgCommandProcessor::SendAtCommand(const HfpAgDataConnection &dataConn, c
 }
 
 void HfpAgCommandProcessor::Handle(
-    HfpAgDataConnection &dataConn, const std::string &cmd, const std::string &arg, int cmdType) 
+    HfpAgDataConnection &dataConn, std::string_view cmd, const std::string &arg, int cmdType)
 {
-    LOG_DEBUG("[HFP AG]%{public}s():cmd[%{public}s], arg[%{public}s], Type[%{public}d]", __FUNCTION__, cmd.c_str(), arg.c_str(), cmdType);
-    auto it = g_atCmdMap.find(cmd);
-    if (it == g_atCmdMap.end()) {
+    int index = AT_CMD_TABLE.Find(cmd);
+    if (index == AT_CMD_TABLE.INVALID_INDEX) {
         SendErrorCode(dataConn, HFP_AG_ERROR_AG_FAILURE);
-        LOG_ERROR("[HFP AG]%{public}s():%{public}s command handler not found", __FUNCTION__, cmd.c_str());
+        LOG_ERROR("[HFP AG]%{public}s():%{public}s command handler not found", __FUNCTION__, std::string(cmd).c_str());
         return;
     }
+    LOG_DEBUG("[HFP AG]%{public}s():cmd[%{public}s], arg[%{public}s], Type[%{public}d]",
+        __FUNCTION__, AT_CMD_TABLE.Name(index).data(), arg.c_str(), cmdType);
 
+    const HfpAgAtHandler &handler = AT_CMD_HANDLERS[index];
     switch (cmdType) {
         case HFP_AG_CMD_SET:
-            (this->*(it->second.setter))(dataConn, arg);
+            (this->*(handler.setter))(dataConn, arg);
             break;
         case HFP_AG_CMD_GET:
-            (this->*(it->second.getter))(dataConn, arg);
+            (this->*(handler.getter))(dataConn, arg);
             break;
         case HFP_AG_CMD_TEST:
-            (this->*(it->second.tester))(dataConn, arg);
+            (this->*(handler.tester))(dataConn, arg);
             break;
         case HFP_AG_CMD_EXEC:
-            (this->*(it->second.executer))(dataConn, arg);
+            (this->*(handler.executer))(dataConn, arg);
             break;
         case HFP_AG_CMD_UNKNOWN:
             LOG_DEBUG("[HFP AG]%{public}s():HFP_AG_CMD_UNKNOWN", __FUNCTION__);
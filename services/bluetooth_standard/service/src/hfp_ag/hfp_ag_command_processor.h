@@ -16,9 +16,11 @@
 #ifndef HFP_AG_COMMAND_PROCESSOR_H
 #define HFP_AG_COMMAND_PROCESSOR_H
 
+#include <array>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 
+#include "at_command_tokenizer.h"
 #include "hfp_ag_data_connection.h"
 
 namespace bluetooth {
@@ -59,16 +61,6 @@ public:
      */
     static HfpAgCommandProcessor &GetInstance();
 
-    /**
-     * @brief Get the AT command map.
-     *
-     * @return Returns the AT command map.
-     */
-    std::unordered_map<std::string, HfpAgCommandProcessor::HfpAgAtHandler> &GetAtCmdMap()
-    {
-        return g_atCmdMap;
-    }
-
     /**
      * @brief Send Error command.
      *
@@ -357,7 +349,18 @@ public:
      * @param cmdType AT command type.
      */
     void Handle(
-        HfpAgDataConnection &dataConn, const std::string &cmd, const std::string &arg, int cmdType);
+        HfpAgDataConnection &dataConn, std::string_view cmd, const std::string &arg, int cmdType);
+
+    /**
+     * @brief Check whether a command name is handled by AG.
+     *
+     * @param cmd AT command.
+     * @return Returns true if the command has a handler, else return false.
+     */
+    static bool IsSupported(std::string_view cmd)
+    {
+        return AT_CMD_TABLE.Find(cmd) != AT_CMD_TABLE.INVALID_INDEX;
+    }
 
 private:
     HfpAgCommandProcessor() = default;
@@ -365,7 +368,16 @@ private:
     static int StoiTryCatch(HfpAgDataConnection &dataConn, const std::string &arg);
     DISALLOW_COPY_AND_ASSIGN(HfpAgCommandProcessor);
 
-    static std::unordered_map<std::string, HfpAgCommandProcessor::HfpAgAtHandler> g_atCmdMap;
+    // AT command names, AT_CMD_HANDLERS keeps the same order
+    static constexpr size_t AT_CMD_NUM = 26;
+    static constexpr std::array<std::string_view, AT_CMD_NUM> AT_CMD_NAMES {
+        "AT+BRSF", "AT+CCWA", "AT+CLIP", "AT+CMER", "AT+CMEE", "AT+BCC", "ATA", "ATD", "AT+VGS", "AT+VGM", "AT+CHLD",
+        "AT+CHUP", "AT+CIND", "AT+VTS", "AT+BLDN", "AT+BVRA", "AT+NREC", "AT+CNUM", "AT+CLCC", "AT+COPS", "AT+BIA",
+        "AT+BCS", "AT+BIND", "AT+BIEV", "AT+BAC", "AT+BTRH"
+    };
+    static constexpr utility::AtCommandTable<AT_CMD_NUM> AT_CMD_TABLE {AT_CMD_NAMES};
+    static_assert(AT_CMD_TABLE.IsPerfect(), "AG AT command names have no perfect hash");
+    static const HfpAgAtHandler AT_CMD_HANDLERS[AT_CMD_NUM];
     static inline const std::string HEAD = "\r\n";
     static inline const std::string TAIL = "\r\n";
     static inline const std::string OK = "OK";
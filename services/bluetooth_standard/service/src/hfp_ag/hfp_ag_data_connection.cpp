@@ -129,6 +129,7 @@ bool HfpAgDataConnection::IsEscoS4Support() const
 
 int HfpAgDataConnection::Connect()
 {
+    atTokenizer_.Reset();
     return rfcommConnection_.Connect();
 }
 
@@ -165,6 +166,7 @@ int HfpAgDataConnection::GetRole() const
 
 void HfpAgDataConnection::SetConnectionHandle(uint16_t handle)
 {
+    atTokenizer_.Reset();
     rfcommConnection_.SetConnectionHandle(handle);
 }
 
@@ -21,6 +21,7 @@
 #include <string>
 #include <vector>
 
+#include "at_command_tokenizer.h"
 #include "base_def.h"
 #include "hfp_ag_defines.h"
 #include "hfp_ag_rfcomm_connection.h"
@@ -196,6 +197,7 @@ private:
     static void ProcessDataConnectionCallback(uint16_t handle, uint32_t eventId);
 
     friend class HfpAgProfile;
+    friend class HfpAgCommandParser;
     friend class HfpAgCommandProcessor;
 
     static uint32_t g_localFeatures;
@@ -248,6 +250,9 @@ private:
     std::vector<HfIndicator> remoteHfIndicators_ {};
     HfpAgRfcommConnection rfcommConnection_ {&HfpAgDataConnection::DataConnectionCallback};
 
+    // Keeps a partially received AT command across RFCOMM packets
+    utility::AtCommandTokenizer atTokenizer_ {};
+
     // Ring Timeout
     static inline constexpr int RING_TIMEOUT_MS = 3000;
 
@@ -15,8 +15,6 @@
 
 #include "hfp_hf_command_parser.h"
 
-#include <cstring>
-
 #include "hfp_hf_defines.h"
 #include "packet.h"
 
@@ -31,68 +29,42 @@ void HfpHfCommandParser::Read(
     HfpHfDataConnection &dataConn, HfpHfCommandProcessor &commandProcessor)
 {
     Packet *pkt = nullptr;
-    Buffer *buf = nullptr;
-    uint8_t *pData = nullptr;
 
     dataConn.ReadData(&pkt);
     if (pkt != nullptr) {
-        auto len = PacketPayloadSize(pkt);
-        buf = PacketContinuousPayload(pkt);
-        pData = (uint8_t *)BufferPtr(buf);
-
-        std::vector<uint8_t> data(pData, pData + len);
-        Parse(dataConn, commandProcessor, data, len);
+        Buffer *buf = PacketContinuousPayload(pkt);
+        if (buf != nullptr) {
+            dataConn.atTokenizer_.Feed((uint8_t *)BufferPtr(buf), PacketPayloadSize(pkt),
+                [this, &dataConn, &commandProcessor](std::string_view line) {
+                    Parse(dataConn, commandProcessor, line);
+                });
+        }
         PacketFree(pkt);
     }
 }
 
-void HfpHfCommandParser::ParseBody(HfpHfDataConnection &dataConn,
-    HfpHfCommandProcessor &commandProcessor, std::vector<uint8_t> &data, size_t &pos, const size_t len)
+void HfpHfCommandParser::Parse(
+    HfpHfDataConnection &dataConn, HfpHfCommandProcessor &commandProcessor, std::string_view line) const
 {
-    for (auto &it : g_atCmdMap) {
-        if (!strncmp(it.first.c_str(), (char *)(&data[pos]), it.first.length())) {
-            // command body matched
-            size_t bodyPos = pos;
-            while (!(data[pos] == '\r' && data[pos + 1] == '\n')) {
-                pos++;
-            }
-
-            if (pos + 1 < len) {
-                // command tail "\r\n" matched
-                size_t tailPos = pos;
-                pos++;
-                std::string arg {(char *)&data[bodyPos + it.first.length()], tailPos - it.first.length() - bodyPos};
-                LOG_DEBUG("[HFP HF]%{public}s():cmd[%{public}s], arg[%{public}s]", __FUNCTION__, it.first.c_str(), arg.c_str());
-                commandProcessor.ProcessCommand(dataConn, it.first, arg);
-                break;
-            } else {
-                LOG_DEBUG("[HFP HF]%{public}s():Command format invalid!", __FUNCTION__);
-                break;
-            }
-        }
+    std::string_view cmd;
+    std::string arg;
+    Extract(line, cmd, arg);
+    if (!HfpHfCommandProcessor::IsSupported(cmd)) {
+        LOG_DEBUG("[HFP HF]%{public}s():Command format invalid!", __FUNCTION__);
+        return;
     }
+    commandProcessor.ProcessCommand(dataConn, cmd, arg);
 }
 
-void HfpHfCommandParser::Parse(HfpHfDataConnection &dataConn,
-    HfpHfCommandProcessor &commandProcessor, std::vector<uint8_t> &data, size_t len)
+void HfpHfCommandParser::Extract(std::string_view line, std::string_view &cmd, std::string &arg)
 {
-    if (data.empty() == true) {
-        LOG_DEBUG("[HFP HF]%{public}s():data is nullptr", __FUNCTION__);
-        return;
-    }
-
-    for (size_t pos = 0; pos < len; pos++) {
-        // skip null characters
-        if (data[pos] == '\0') {
-            continue;
-        }
-
-        if (pos + 1 < len && (data[pos] == '\r' && data[pos + 1] == '\n')) {
-            // command head "\r\n" matched, skip it
-            pos += AT_HEAD_SIZE;
-            ParseBody(dataConn, commandProcessor, data, pos, len);
-        }
+    // extended result codes are "+XXXX: arg", basic result codes take the whole line
+    size_t colonPos = line.find(':');
+    if ((line.front() == '+') && (colonPos != std::string_view::npos)) {
+        cmd = line.substr(0, colonPos + 1);
+        arg = std::string(line.substr(colonPos + 1));
+    } else {
+        cmd = line;
     }
-    return;
 }
 }  // namespace bluetooth
\ No newline at end of file
@@ -17,7 +17,7 @@
 
 #include <cstdint>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 
 #include "base_def.h"
 #include "hfp_hf_command_processor.h"
@@ -45,27 +45,27 @@ public:
     void Read(HfpHfDataConnection &dataConn, HfpHfCommandProcessor &commandProcessor);
 
     /**
-     * @brief Parse data bufffer.
+     * @brief Parse one complete result code line and dispatch it.
      *
      * @param dataConn Data connection.
      * @param commandProcessor Command processor pointer.
-     * @param data Data buffer pointer.
-     * @param len Data buffer length.
+     * @param line Result code line without the surrounding <cr><lf>.
      */
-    void Parse(HfpHfDataConnection &dataConn, HfpHfCommandProcessor &commandProcessor,
-        std::vector<uint8_t> &data, size_t len);
+    void Parse(HfpHfDataConnection &dataConn, HfpHfCommandProcessor &commandProcessor, std::string_view line) const;
+
+    /**
+     * @brief Extract result code from line.
+     *
+     * @param line Result code line without the surrounding <cr><lf>.
+     * @param cmd Result code name, refers to line.
+     * @param arg Result code argument.
+     */
+    static void Extract(std::string_view line, std::string_view &cmd, std::string &arg);
 
 private:
-    inline static constexpr int AT_HEAD_SIZE = 2;
-    void ParseBody(HfpHfDataConnection &dataConn,
-        HfpHfCommandProcessor &commandProcessor, std::vector<uint8_t> &data, size_t &pos, const size_t len);
     HfpHfCommandParser() = default;
     ~HfpHfCommandParser() = default;
     DISALLOW_COPY_AND_ASSIGN(HfpHfCommandParser);
-
-    std::unordered_map<std::string, HfpHfCommandProcessor::HfpHfAtHandler> &g_atCmdMap {
-        HfpHfCommandProcessor::GetAtCmdMap()
-    };
 };
 }  // namespace bluetooth
 #endif // HFP_HF_COMMAND_PARSER_H
\ No newline at end of file
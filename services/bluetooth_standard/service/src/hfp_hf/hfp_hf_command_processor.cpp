@@ -22,37 +22,37 @@
 #include "securec.h"
 
 namespace bluetooth {
-std::unordered_map<std::string, HfpHfCommandProcessor::HfpHfAtHandler> HfpHfCommandProcessor::g_atCmdMap = {
-    std::make_pair<std::string, HfpHfAtHandler>("OK", {&HfpHfCommandProcessor::ProcessOK}),
-    std::make_pair<std::string, HfpHfAtHandler>("ERROR", {&HfpHfCommandProcessor::ProcessErrorCmd}),
-    std::make_pair<std::string, HfpHfAtHandler>("+CME ERROR:", {&HfpHfCommandProcessor::ProcessCmeError}),
-    std::make_pair<std::string, HfpHfAtHandler>("RING", {&HfpHfCommandProcessor::ProcessRing}),
-    std::make_pair<std::string, HfpHfAtHandler>("+CLIP:", {&HfpHfCommandProcessor::ProcessClip}),
-    std::make_pair<std::string, HfpHfAtHandler>("+BRSF:", {&HfpHfCommandProcessor::ProcessBrsf}),
-    std::make_pair<std::string, HfpHfAtHandler>("+CIND:", {&HfpHfCommandProcessor::ProcessCind}),
-    std::make_pair<std::string, HfpHfAtHandler>("+CHLD:", {&HfpHfCommandProcessor::ProcessChld}),
-    std::make_pair<std::string, HfpHfAtHandler>("+BIND:", {&HfpHfCommandProcessor::ProcessBind}),
-    std::make_pair<std::string, HfpHfAtHandler>("+CIEV:", {&HfpHfCommandProcessor::ProcessCiev}),
-    std::make_pair<std::string, HfpHfAtHandler>("+CCWA:", {&HfpHfCommandProcessor::ProcessCcwa}),
-    std::make_pair<std::string, HfpHfAtHandler>("+BCS:", {&HfpHfCommandProcessor::ProcessBcs}),
-    std::make_pair<std::string, HfpHfAtHandler>("+CLCC:", {&HfpHfCommandProcessor::ProcessClcc}),
-    std::make_pair<std::string, HfpHfAtHandler>("+BSIR:", {&HfpHfCommandProcessor::ProcessBsir}),
-    std::make_pair<std::string, HfpHfAtHandler>("+BVRA:", {&HfpHfCommandProcessor::ProcessBvra}),
-    std::make_pair<std::string, HfpHfAtHandler>("+CNUM:", {&HfpHfCommandProcessor::ProcessCnum}),
-    std::make_pair<std::string, HfpHfAtHandler>("+VGM:", {&HfpHfCommandProcessor::ProcessVgm}),
-    std::make_pair<std::string, HfpHfAtHandler>("+VGS:", {&HfpHfCommandProcessor::ProcessVgs}),
-    std::make_pair<std::string, HfpHfAtHandler>("+COPS:", {&HfpHfCommandProcessor::ProcessCops}),
-    std::make_pair<std::string, HfpHfAtHandler>("+BTRH:", {&HfpHfCommandProcessor::ProcessBtrh}),
-    std::make_pair<std::string, HfpHfAtHandler>("BUSY", {&HfpHfCommandProcessor::ProcessBusy}),
-    std::make_pair<std::string, HfpHfAtHandler>("DELAYED", {&HfpHfCommandProcessor::ProcessDelayed}),
-    std::make_pair<std::string, HfpHfAtHandler>("NO CARRIER", {&HfpHfCommandProcessor::ProcessNoCarrier}),
-    std::make_pair<std::string, HfpHfAtHandler>("NO ANSWER", {&HfpHfCommandProcessor::ProcessNoAnswer}),
-    std::make_pair<std::string, HfpHfAtHandler>("BLOCKLISTED", {&HfpHfCommandProcessor::ProcessBlocklisted}),
+const HfpHfCommandProcessor::HfpHfAtHandler HfpHfCommandProcessor::AT_CMD_HANDLERS[AT_CMD_NUM] = {
+    {&HfpHfCommandProcessor::ProcessOK},  // OK
+    {&HfpHfCommandProcessor::ProcessErrorCmd},  // ERROR
+    {&HfpHfCommandProcessor::ProcessCmeError},  // +CME ERROR:
+    {&HfpHfCommandProcessor::ProcessRing},  // RING
+    {&HfpHfCommandProcessor::ProcessClip},  // +CLIP:
+    {&HfpHfCommandProcessor::ProcessBrsf},  // +BRSF:
+    {&HfpHfCommandProcessor::ProcessCind},  // +CIND:
+    {&HfpHfCommandProcessor::ProcessChld},  // +CHLD:
+    {&HfpHfCommandProcessor::ProcessBind},  // +BIND:
+    {&HfpHfCommandProcessor::ProcessCiev},  // +CIEV:
+    {&HfpHfCommandProcessor::ProcessCcwa},  // +CCWA:
+    {&HfpHfCommandProcessor::ProcessBcs},  // +BCS:
+    {&HfpHfCommandProcessor::ProcessClcc},  // +CLCC:
+    {&HfpHfCommandProcessor::ProcessBsir},  // +BSIR:
+    {&HfpHfCommandProcessor::ProcessBvra},  // +BVRA:
+    {&HfpHfCommandProcessor::ProcessCnum},  // +CNUM:
+    {&HfpHfCommandProcessor::ProcessVgm},  // +VGM:
+    {&HfpHfCommandProcessor::ProcessVgs},  // +VGS:
+    {&HfpHfCommandProcessor::ProcessCops},  // +COPS:
+    {&HfpHfCommandProcessor::ProcessBtrh},  // +BTRH:
+    {&HfpHfCommandProcessor::ProcessBusy},  // BUSY
+    {&HfpHfCommandProcessor::ProcessDelayed},  // DELAYED
+    {&HfpHfCommandProcessor::ProcessNoCarrier},  // NO CARRIER
+    {&HfpHfCommandProcessor::ProcessNoAnswer},  // NO ANSWER
+    {&HfpHfCommandProcessor::ProcessBlocklisted},  // BLOCKLISTED
 };
 
-std::unordered_map<std::string, HfpHfCommandProcessor::HfpHfAtHandler> &HfpHfCommandProcessor::GetAtCmdMap()
+bool HfpHfCommandProcessor::IsSupported(std::string_view cmd)
 {
-    return g_atCmdMap;
+    return AT_CMD_TABLE.Find(cmd) != AT_CMD_TABLE.INVALID_INDEX;
 }
 
 int HfpHfCommandProcessor::StoiTryCatch(const std::string &arg)
@@ -72,20 +72,20 @@ void HfpHfCommandProcessor::Init(const std::string& address)
 }
 
 void HfpHfCommandProcessor::ProcessCommand(
-    HfpHfDataConnection &dataConn, const std::string &cmd, const std::string &arg)
+    HfpHfDataConnection &dataConn, std::string_view cmd, const std::string &arg)
 {
-    LOG_DEBUG("[HFP HF]%{public}s():command[%{public}s], arg[%{public}s]", __FUNCTION__, cmd.c_str(), arg.c_str());
-
-    auto it = g_atCmdMap.find(cmd);
-    if (it == g_atCmdMap.end()) {
-        LOG_ERROR("[HFP HF]%{public}s():%{public}s command handler not found", __FUNCTION__, cmd.c_str());
+    int index = AT_CMD_TABLE.Find(cmd);
+    if (index == AT_CMD_TABLE.INVALID_INDEX) {
+        LOG_ERROR("[HFP HF]%{public}s():%{public}s command handler not found", __FUNCTION__, std::string(cmd).c_str());
         return;
     }
+    LOG_DEBUG("[HFP HF]%{public}s():command[%{public}s], arg[%{public}s]",
+        __FUNCTION__, AT_CMD_TABLE.Name(index).data(), arg.c_str());
 
     auto newArg = arg;
     newArg.erase(remove_if(newArg.begin(), newArg.end(), isspace), newArg.end());
 
-    (this->*(it->second.fn))(dataConn, newArg);
+    (this->*(AT_CMD_HANDLERS[index].fn))(dataConn, newArg);
 }
 
 void HfpHfCommandProcessor::ProcessOK(HfpHfDataConnection &dataConn, const std::string &arg)
@@ -16,12 +16,14 @@
 #ifndef HFP_HF_COMMAND_PROCESSOR_H
 #define HFP_HF_COMMAND_PROCESSOR_H
 
+#include <array>
 #include <cstdint>
 #include <queue>
 #include <string>
+#include <string_view>
 #include <tuple>
-#include <unordered_map>
 
+#include "at_command_tokenizer.h"
 #include "hfp_hf_data_connection.h"
 #include "timer.h"
 
@@ -85,11 +87,12 @@ public:
     };
 
     /**
-     * @brief Get the AT command map.
+     * @brief Check whether a result code name is handled by HF.
      *
-     * @return Returns the AT command map.
+     * @param cmd Result code name, such as "OK" or "+CIND:".
+     * @return Returns true if the result code has a handler, else return false.
      */
-    static std::unordered_map<std::string, HfpHfCommandProcessor::HfpHfAtHandler> &GetAtCmdMap();
+    static bool IsSupported(std::string_view cmd);
 
     /**
      * @brief Construct a new HfpHfCommandProcessor object.
@@ -131,7 +134,7 @@ public:
      * @param cmd AT command.
      * @param arg AT command argument.
      */
-    void ProcessCommand(HfpHfDataConnection &dataConn, const std::string &cmd, const std::string &arg);
+    void ProcessCommand(HfpHfDataConnection &dataConn, std::string_view cmd, const std::string &arg);
 
     /**
      * @brief Clear up after disconnection.
@@ -189,7 +192,16 @@ private:
     inline static constexpr int CHLD_SUB_ARGS_NUMBER = 2;
     inline static constexpr int BIND_SET_ARGS_NUMBER = 2;
 
-    static std::unordered_map<std::string, HfpHfCommandProcessor::HfpHfAtHandler> g_atCmdMap;
+    // Result code names, AT_CMD_HANDLERS keeps the same order
+    static constexpr size_t AT_CMD_NUM = 25;
+    static constexpr std::array<std::string_view, AT_CMD_NUM> AT_CMD_NAMES {
+        "OK", "ERROR", "+CME ERROR:", "RING", "+CLIP:", "+BRSF:", "+CIND:", "+CHLD:", "+BIND:", "+CIEV:", "+CCWA:",
+        "+BCS:", "+CLCC:", "+BSIR:", "+BVRA:", "+CNUM:", "+VGM:", "+VGS:", "+COPS:", "+BTRH:", "BUSY", "DELAYED",
+        "NO CARRIER", "NO ANSWER", "BLOCKLISTED"
+    };
+    static constexpr utility::AtCommandTable<AT_CMD_NUM> AT_CMD_TABLE {AT_CMD_NAMES};
+    static_assert(AT_CMD_TABLE.IsPerfect(), "HF result code names have no perfect hash");
+    static const HfpHfAtHandler AT_CMD_HANDLERS[AT_CMD_NUM];
     static int StoiTryCatch(const std::string &arg);
     void RespondTimeout();
     void SendQueuedAtCommand(HfpHfDataConnection &dataConn);
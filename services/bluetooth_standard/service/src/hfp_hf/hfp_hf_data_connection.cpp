@@ -114,6 +114,7 @@ uint32_t HfpHfDataConnection::GetLocalFeatures()
 
 int HfpHfDataConnection::Connect()
 {
+    atTokenizer_.Reset();
     return rfcommConnection_.Connect();
 }
 
@@ -150,6 +151,7 @@ int HfpHfDataConnection::GetRole() const
 
 void HfpHfDataConnection::SetConnectionHandle(uint16_t handle)
 {
+    atTokenizer_.Reset();
     rfcommConnection_.SetConnectionHandle(handle);
 }
 
@@ -21,6 +21,7 @@
 #include <string>
 #include <vector>
 
+#include "at_command_tokenizer.h"
 #include "base_def.h"
 #include "hfp_hf_defines.h"
 #include "hfp_hf_rfcomm_connection.h"
@@ -204,6 +205,7 @@ private:
     static void ProcessDataConnectionCallback(uint16_t handle, uint32_t eventId);
 
     friend class HfpHfProfile;
+    friend class HfpHfCommandParser;
     friend class HfpHfCommandProcessor;
 
     static inline const std::string BIND_SETTINGS = "1,2";  // Enhanced Driver Status & Battery Level Status
@@ -231,6 +233,9 @@ private:
     };
     HfpHfRfcommConnection rfcommConnection_ {&HfpHfDataConnection::DataConnectionCallback};
 
+    // Keeps a partially received AT command across RFCOMM packets
+    utility::AtCommandTokenizer atTokenizer_ {};
+
     DISALLOW_COPY_AND_ASSIGN(HfpHfDataConnection);
 };
 }  // namespace bluetooth
@@ -28,6 +28,7 @@
  *
  */
 #include "map_mce_data_analyse.h"
+#include <algorithm>
 #include <codecvt>
 #include <cstring>
 #include <fstream>
@@ -38,36 +39,6 @@
 #include "map_mce_xml.h"
 
 namespace bluetooth {
-MceSplitString::MceSplitString(const std::string &target, const std::string &filter)
-{
-    LOG_INFO("%{public}s execute", __PRETTY_FUNCTION__);
-    targetString_ = target;
-    filterString_ = filter;
-    count_ = 0;
-    maxCount_ = targetString_.size();
-}
-
-MceSplitString::~MceSplitString()
-{
-    LOG_INFO("%{public}s execute", __PRETTY_FUNCTION__);
-}
-
-std::string MceSplitString::NextWord()
-{
-    LOG_INFO("%{public}s execute", __PRETTY_FUNCTION__);
-    int begin = count_;
-    for (; count_ < maxCount_; count_++) {
-        if (filterString_.find(targetString_[count_]) != std::string::npos) {
-            if (begin == count_) {
-                begin++;
-            } else {
-                break;
-            }
-        }
-    }
-    return targetString_.substr(begin, count_ - begin);
-}
-
 MceCombineNode::MceCombineNode()
 {
     stream_.str("");
@@ -108,154 +79,203 @@ std::string MceCombineNode::GetCombineString() const
     return stream_.str();
 }
 
-MceBMessageNode::MceBMessageNode()
+namespace {
+constexpr std::string_view BMSG_BEGIN_BMSG = "BEGIN:BMSG";
+constexpr std::string_view BMSG_END_BMSG = "END:BMSG";
+constexpr std::string_view BMSG_BEGIN_MSG = "BEGIN:MSG";
+constexpr std::string_view BMSG_END_MSG = "END:MSG";
+constexpr std::string_view BMSG_BEGIN = "BEGIN:";
+constexpr std::string_view BMSG_END = "END:";
+constexpr std::string_view BMSG_LINE_BREAK = "\r\n";
+// keys of MceBMessageTokenizer::Property, in the same order
+constexpr std::string_view BMSG_PROPERTY_KEYS[MceBMessageTokenizer::PROPERTY_MAX] = {
+    "VERSION", "STATUS", "TYPE", "FOLDER", "EXTENDEDDATA", "PARTID", "ENCODING", "CHARSET",
+    "LANGUAGE", "LENGTH", "N", "FN", "TEL", "EMAIL", "X-BT-UID", "X-BT-UCI"
+};
+
+bool StartsWith(std::string_view str, std::string_view prefix)
 {
-    LOG_INFO("%{public}s execute", __PRETTY_FUNCTION__);
+    return (str.size() >= prefix.size()) && (str.compare(0, prefix.size(), prefix) == 0);
 }
 
-MceBMessageNode::MceBMessageNode(const std::list<std::string> &list, const std::string &name)
+bool IsLineBreak(char c)
 {
-    LOG_INFO("%{public}s execute", __PRETTY_FUNCTION__);
-    MceConstructNode(list, name);
+    return (c == '\r') || (c == '\n');
 }
+}  // namespace
 
-void MceBMessageNode::MceConstructNode(const std::list<std::string> &list, const std::string &name)
+MceBMessageTokenizer::MceBMessageTokenizer(std::string_view object) : object_(object)
 {
-    LOG_INFO("%{public}s execute", __PRETTY_FUNCTION__);
-    wordList_ = list;
-    name_ = name;
+    if (!Tokenize()) {
+        // format error, drop the nodes
+        nodes_.clear();
+        values_.clear();
+        AddNode(NODE_INVALID, "BMSG");
+    }
 }
 
-MceBMessageNode::~MceBMessageNode()
+MceBMessageTokenizer::~MceBMessageTokenizer()
+{}
+
+bool MceBMessageTokenizer::Tokenize()
 {
-    LOG_INFO("%{public}s execute", __PRETTY_FUNCTION__);
+    std::vector<int> openNodes;
+    size_t msgBegin = std::string_view::npos;
+    bool beginFound = false;
+    bool msgFound = false;
+    size_t pos = 0;
+
+    while (pos < object_.size()) {
+        size_t lineBegin = object_.find_first_not_of(BMSG_LINE_BREAK, pos);
+        if (lineBegin == std::string_view::npos) {
+            break;
+        }
+        pos = object_.find_first_of(BMSG_LINE_BREAK, lineBegin);
+        if (pos == std::string_view::npos) {
+            pos = object_.size();
+        }
+        std::string_view line = object_.substr(lineBegin, pos - lineBegin);
+
+        if (!beginFound) {
+            if (line != BMSG_BEGIN_BMSG) {
+                LOG_ERROR("%{public}s not find BEGIN:BMSG", __PRETTY_FUNCTION__);
+                return false;
+            }
+            beginFound = true;
+            openNodes.push_back(AddNode(NODE_INVALID, "BMSG"));
+            continue;
+        }
+        // the message content is opaque until END:MSG
+        if (msgBegin != std::string_view::npos) {
+            if (line == BMSG_END_MSG) {
+                if (!msgFound) {
+                    SetMsgText(msgBegin, lineBegin);
+                    msgFound = true;
+                }
+                msgBegin = std::string_view::npos;
+            }
+            continue;
+        }
+        if (line == BMSG_END_BMSG) {
+            return true;
+        }
+        if (line == BMSG_BEGIN_MSG) {
+            msgBegin = lineBegin;
+        } else if (StartsWith(line, BMSG_BEGIN)) {
+            openNodes.push_back(AddNode(openNodes.back(), line.substr(BMSG_BEGIN.size())));
+        } else if (StartsWith(line, BMSG_END)) {
+            if (openNodes.size() > 1) {
+                openNodes.pop_back();
+            }
+        } else {
+            AddProperty(openNodes.back(), line);
+        }
+    }
+    LOG_ERROR("%{public}s not find END:BMSG", __PRETTY_FUNCTION__);
+    return false;
 }
 
-MceBMessageNode MceBMessageNode::GetNextChild()
+int MceBMessageTokenizer::AddNode(int parent, std::string_view name)
 {
-    LOG_INFO("%{public}s execute", __PRETTY_FUNCTION__);
-    std::list<std::string> nextNode;
-    std::string nextName = "";
-    std::string begin;
-    int beginNum;
-    int beginLength = strlen("BEGIN:");
-    int endLength = strlen("END:");
-
-    while (wordList_.size() != 0) {
-        begin = wordList_.front();
-        wordList_.pop_front();
-
-        if ((begin.size() >= (std::size_t)beginLength) && (begin.substr(0, (std::size_t)beginLength) == "BEGIN:")) {
-            nextName = begin.substr(beginLength);
-            break;
+    int index = nodes_.size();
+    Node &node = nodes_.emplace_back();
+    node.name = name;
+    std::fill(std::begin(node.firstValue), std::end(node.firstValue), NODE_INVALID);
+    std::fill(std::begin(node.lastValue), std::end(node.lastValue), NODE_INVALID);
+    if (parent != NODE_INVALID) {
+        Node &parentNode = nodes_[parent];
+        if (parentNode.lastChild == NODE_INVALID) {
+            parentNode.firstChild = index;
+        } else {
+            nodes_[parentNode.lastChild].nextSibling = index;
         }
+        parentNode.lastChild = index;
     }
+    return index;
+}
 
-    std::string end;
-    beginNum = 0;
-    MceBMessageNode node;
-    if (nextName == "") {
-        return node;
+void MceBMessageTokenizer::AddProperty(int node, std::string_view line)
+{
+    size_t colon = line.find(':');
+    if (colon == std::string_view::npos) {
+        return;
     }
-    while (wordList_.size() != 0) {
-        end = wordList_.front();
-        wordList_.pop_front();
-        if ((end.size() >= (std::size_t)beginLength) && (end.substr(0, (std::size_t)beginLength) == "BEGIN:")) {
-            beginNum++;
+    std::string_view key = line.substr(0, colon);
+    for (int property = 0; property < PROPERTY_MAX; property++) {
+        if (key != BMSG_PROPERTY_KEYS[property]) {
+            continue;
         }
-        if ((end.size() >= (std::size_t)endLength) && (end.substr(0, (std::size_t)endLength) == "END:")) {
-            if (beginNum == 0) {
-                node.MceConstructNode(nextNode, nextName);
-                break;
-            } else {
-                beginNum--;
-            }
+        int index = values_.size();
+        values_.push_back({line.substr(colon + 1), NODE_INVALID});
+        Node &owner = nodes_[node];
+        if (owner.lastValue[property] == NODE_INVALID) {
+            owner.firstValue[property] = index;
+        } else {
+            values_[owner.lastValue[property]].next = index;
         }
-        nextNode.push_back(end);  // do not put "BEGIN:" or "END:" to the list
+        owner.lastValue[property] = index;
+        return;
     }
-    return node;
 }
 
-std::string MceBMessageNode::GetNodeName() const
+void MceBMessageTokenizer::SetMsgText(size_t begin, size_t end)
 {
-    LOG_INFO("%{public}s execute", __PRETTY_FUNCTION__);
-    return name_;
+    // skip "BEGIN:MSG" and its line break
+    begin += BMSG_BEGIN_MSG.size() + 1;
+    if ((begin < object_.size()) && IsLineBreak(object_[begin])) {
+        begin++;
+    }
+    // drop the line break before "END:MSG"
+    end--;
+    if ((end > 0) && IsLineBreak(object_[end - 1])) {
+        end--;
+    }
+    if (end > begin) {
+        msgText_ = object_.substr(begin, end - begin);
+    }
 }
 
-std::string MceBMessageNode::GetNodeValue() const
+int MceBMessageTokenizer::GetRoot() const
 {
-    LOG_INFO("%{public}s execute", __PRETTY_FUNCTION__);
-    return value_;
+    return 0;
 }
 
-std::string MceBMessageNode::GetParamValue(std::string param) const
+int MceBMessageTokenizer::GetFirstChild(int node) const
 {
-    LOG_INFO("%{public}s execute", __PRETTY_FUNCTION__);
-    std::string value;
-    std::string curWold;
-    int beginNum;
-    std::string beginEnd;
-    int beginLength = strlen("BEGIN:");
-    int endLength = strlen("END:");
-
-    beginNum = 0;
-    for (auto it = wordList_.begin(); it != wordList_.end(); it++) {
-        curWold = *it;
-        if ((beginEnd.size() >= (std::size_t)beginLength) &&
-            (beginEnd.substr(0, (std::size_t)beginLength) == "BEGIN:")) {
-            beginNum++;
-        }
-        if ((beginEnd.size() >= (std::size_t)endLength) && (beginEnd.substr(0, (std::size_t)endLength) == "END:")) {
-            if (beginNum == 0) {
-                break;
-            } else {
-                beginNum--;
-            }
-        }
-        // not in the sub node
-        if ((beginNum == 0) && (curWold.size() >= param.size()) && (param == curWold.substr(0, param.size()))) {
-            value = curWold.substr(param.size());
-            break;
-        }
+    return nodes_[node].firstChild;
+}
+
+int MceBMessageTokenizer::GetNextSibling(int node) const
+{
+    return nodes_[node].nextSibling;
+}
+
+std::string_view MceBMessageTokenizer::GetNodeName(int node) const
+{
+    return nodes_[node].name;
+}
+
+std::string MceBMessageTokenizer::GetParamValue(int node, Property property) const
+{
+    int index = nodes_[node].firstValue[property];
+    if (index == NODE_INVALID) {
+        return "";
     }
-    return value;
+    return std::string(values_[index].value);
 }
 
-std::vector<std::string> MceBMessageNode::GetParamValueList(std::string param) const
+std::vector<std::string> MceBMessageTokenizer::GetParamValueList(int node, Property property) const
 {
-    LOG_INFO("%{public}s execute", __PRETTY_FUNCTION__);
-    std::string cWord;
-    std::string beginEnd;
-    std::string value;
     std::vector<std::string> retValue;
-    int bNum = 0;
-    int eLength = strlen("END:");
-    int bLength = strlen("BEGIN:");
-    for (auto it = wordList_.begin(); it != wordList_.end(); it++) {
-        cWord = *it;
-        if ((beginEnd.size() >= (std::size_t)bLength) && (beginEnd.substr(0, (std::size_t)bLength) == "BEGIN:")) {
-            bNum++;
-        }
-        if ((beginEnd.size() >= (std::size_t)eLength) && (beginEnd.substr(0, (std::size_t)eLength) == "END:")) {
-            if (bNum == 0) {
-                break;
-            } else {
-                bNum--;
-            }
-        }
-        // not in the sub node
-        if ((bNum == 0) && (cWord.size() >= param.size()) && (param == cWord.substr(0, param.size()))) {
-            value = cWord.substr(param.size());
-            retValue.push_back(value);
-        }
+    for (int index = nodes_[node].firstValue[property]; index != NODE_INVALID; index = values_[index].next) {
+        retValue.emplace_back(values_[index].value);
     }
     return retValue;
 }
 
-int MceBMessageNode::GetSize() const
+std::string_view MceBMessageTokenizer::GetMsgText() const
 {
-    LOG_INFO("%{public}s execute", __PRETTY_FUNCTION__);
-    return wordList_.size();
+    return msgText_;
 }
 
 MceBmessageParamMakeStringObject::MceBmessageParamMakeStringObject(const IProfileBMessageStruct &param)
@@ -432,17 +452,13 @@ void MceBmessageParamMakeStringObject::MakeVcard(std::vector<IProfileMapVcard> v
 }
 
 MceBmessageParamAnalyser::MceBmessageParamAnalyser(const std::string &object)
-{
-    LOG_INFO("%{public}s execute", __PRETTY_FUNCTION__);
-    msgStr_ = object;
-}
+    : msgStr_(object), tokenizer_(msgStr_)
+{}
 
 void MceBmessageParamAnalyser::StartAnalyse()
 {
-    LOG_INFO("%{public}s execute", __PRETTY_FUNCTION__);
-    MceBMessageNode nodeLevel1;
-    MceBMessageNode nodeLevel2;
-    MceBMessageNode nodeLevel3;
+    int nodeLevel2 = MceBMessageTokenizer::NODE_INVALID;
+    int nodeLevel3 = MceBMessageTokenizer::NODE_INVALID;
 
     // init
     bMsgParamStruct_.originator_.clear();
@@ -450,351 +466,244 @@ void MceBmessageParamAnalyser::StartAnalyse()
     bMsgParamStruct_.envelope_.recipientLevel2_.clear();
     bMsgParamStruct_.envelope_.recipientLevel3_.clear();
     bMsgParamStruct_.envelope_.msgBody_.body_content = "";
+    msgNode_ = MceBMessageTokenizer::NODE_INVALID;
 
-    MakeWordList();
-    MceBMessageNode rootNode(wordList_, "BMSG");
+    int rootNode = tokenizer_.GetRoot();
     PickUpBMessageProperty(rootNode);
 
-    nodeLevel1 = rootNode.GetNextChild();
-    while (int(nodeLevel1.GetSize()) != 0) {
-        if (nodeLevel1.GetNodeName() == "VCARD") {
+    for (int nodeLevel1 = tokenizer_.GetFirstChild(rootNode); nodeLevel1 != MceBMessageTokenizer::NODE_INVALID;
+         nodeLevel1 = tokenizer_.GetNextSibling(nodeLevel1)) {
+        if (tokenizer_.GetNodeName(nodeLevel1) == "VCARD") {
             PickUpBMessagePropertyOriginator(nodeLevel1);
-        } else if (nodeLevel1.GetNodeName() == "BENV") {
-            nodeLevel2 = PickUpRecipientLevel1(nodeLevel1);
+        } else if (tokenizer_.GetNodeName(nodeLevel1) == "BENV") {
+            nodeLevel2 = PickUpRecipient(nodeLevel1, MCE_RECIPIENT_LEVEL1);
         } else {
             // error
             LOG_ERROR("%{public}s BMessage format error!", __PRETTY_FUNCTION__);
         }
-        nodeLevel1 = rootNode.GetNextChild();
     }
 
-    if (nodeLevel2.GetSize() != 0) {
-        nodeLevel3 = PickUpRecipientLevel2(nodeLevel2);
+    if (nodeLevel2 != MceBMessageTokenizer::NODE_INVALID) {
+        nodeLevel3 = PickUpRecipient(nodeLevel2, MCE_RECIPIENT_LEVEL2);
     }
 
-    if (nodeLevel3.GetSize() != 0) {
-        PickUpRecipientLevel3(nodeLevel3);
+    if (nodeLevel3 != MceBMessageTokenizer::NODE_INVALID) {
+        PickUpRecipient(nodeLevel3, MCE_RECIPIENT_LEVEL3);
     }
 
     PickUpMsgBodyProperty();
     PickUpMsgBodyText();
 }
 
-void MceBmessageParamAnalyser::MakeWordList()
-{
-    std::string filter("\r\n");
-    MceSplitString stringData(msgStr_, filter);
-    std::string word = stringData.NextWord();
-
-    wordList_.clear();
-
-    // make word list
-    if (word == "BEGIN:BMSG") {
-        word = stringData.NextWord();
-        while (word != "END:BMSG") {
-            if (word != "") {
-                wordList_.push_back(word);
-                word = stringData.NextWord();
-            } else {
-                // format error clear list
-                wordList_.clear();
-                LOG_ERROR("%{public}s not find END:BMSG", __PRETTY_FUNCTION__);
-                break;
-            }
-        }
-    } else {
-        LOG_ERROR("%{public}s not find BEGIN:BMSG", __PRETTY_FUNCTION__);
-    }
-}
-
 MceBmessageParamAnalyser::~MceBmessageParamAnalyser()
-{
-    LOG_INFO("%{public}s execute", __PRETTY_FUNCTION__);
-}
+{}
 
 IProfileBMessageStruct MceBmessageParamAnalyser::GetMsgStruct() const
 {
-    LOG_INFO("%{public}s execute", __PRETTY_FUNCTION__);
     return bMsgParamStruct_;
 }
 
-MceBMessageNode MceBmessageParamAnalyser::GetFirstChildNode()
-{
-    LOG_INFO("%{public}s execute", __PRETTY_FUNCTION__);
-    MakeWordList();
-    MceBMessageNode fistNode(wordList_, "BMSG");
-    return fistNode;
-}
-
-int MceBmessageParamAnalyser::GetSize() const
-{
-    LOG_INFO("%{public}s execute", __PRETTY_FUNCTION__);
-    return wordList_.size();
-}
-
 std::string MceBmessageParamAnalyser::GetMsgText()
 {
-    LOG_INFO("%{public}s execute", __PRETTY_FUNCTION__);
     PickUpMsgBodyText();
     return bMsgParamStruct_.envelope_.msgBody_.body_content;
 }
 
-void MceBmessageParamAnalyser::PickUpBMessageProperty(const MceBMessageNode &node)
+void MceBmessageParamAnalyser::PickUpBMessageProperty(int node)
 {
-    LOG_INFO("%{public}s execute", __PRETTY_FUNCTION__);
     std::string tempStr;
 
-    bMsgParamStruct_.version_property = node.GetParamValue("VERSION:");
-    bMsgParamStruct_.readstatus_property =
-        MceUtilityConvertFormat::ConvertStringToMapMessageStatus(node.GetParamValue("STATUS:"));
-    bMsgParamStruct_.extendeddata_property = node.GetParamValue("EXTENDEDDATA:");
+    bMsgParamStruct_.version_property = tokenizer_.GetParamValue(node, MceBMessageTokenizer::PROPERTY_VERSION);
+    bMsgParamStruct_.readstatus_property = MceUtilityConvertFormat::ConvertStringToMapMessageStatus(
+        tokenizer_.GetParamValue(node, MceBMessageTokenizer::PROPERTY_STATUS));
+    bMsgParamStruct_.extendeddata_property =
+        tokenizer_.GetParamValue(node, MceBMessageTokenizer::PROPERTY_EXTENDEDDATA);
     // "FOLDER:"
-    tempStr = node.GetParamValue("FOLDER:");
+    tempStr = tokenizer_.GetParamValue(node, MceBMessageTokenizer::PROPERTY_FOLDER);
     std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> converter;
     bMsgParamStruct_.folder_property = converter.from_bytes(tempStr);
     // "TYPE:"
-    tempStr = node.GetParamValue("TYPE:");
+    tempStr = tokenizer_.GetParamValue(node, MceBMessageTokenizer::PROPERTY_TYPE);
     bMsgParamStruct_.type_property = MceUtilityConvertFormat::ConvertStringToMessageType(tempStr);
 }
 
-void MceBmessageParamAnalyser::PickUpBMessagePropertyOriginator(const MceBMessageNode &node)
+IProfileMapVcard MceBmessageParamAnalyser::PickUpVcard(int node) const
 {
-    LOG_INFO("%{public}s execute", __PRETTY_FUNCTION__);
     IProfileMapVcard vcard;
-    vcard.VERSION = node.GetParamValue("VERSION:");        // shall be included
-    vcard.N = node.GetParamValue("N:");                    // shall be included
-    vcard.TEL = node.GetParamValueList("TEL:");            // may be used
-    vcard.EMAIL = node.GetParamValueList("EMAIL:");        // may be used
-    vcard.X_BT_UID = node.GetParamValueList("X-BT-UID:");  // bmsg V1.1
-    vcard.X_BT_UCI = node.GetParamValueList("X-BT-UCI:");  // bmsg V1.1
-    vcard.FN = node.GetParamValue("FN:");                  // vcard 3.0 , shall be included
+    vcard.VERSION = tokenizer_.GetParamValue(node, MceBMessageTokenizer::PROPERTY_VERSION);  // shall be included
+    vcard.N = tokenizer_.GetParamValue(node, MceBMessageTokenizer::PROPERTY_N);              // shall be included
+    vcard.TEL = tokenizer_.GetParamValueList(node, MceBMessageTokenizer::PROPERTY_TEL);      // may be used
+    vcard.EMAIL = tokenizer_.GetParamValueList(node, MceBMessageTokenizer::PROPERTY_EMAIL);  // may be used
+    vcard.X_BT_UID = tokenizer_.GetParamValueList(node, MceBMessageTokenizer::PROPERTY_X_BT_UID);  // bmsg V1.1
+    vcard.X_BT_UCI = tokenizer_.GetParamValueList(node, MceBMessageTokenizer::PROPERTY_X_BT_UCI);  // bmsg V1.1
+    vcard.FN = tokenizer_.GetParamValue(node, MceBMessageTokenizer::PROPERTY_FN);  // vcard 3.0 , shall be included
+    return vcard;
+}
 
+void MceBmessageParamAnalyser::PickUpBMessagePropertyOriginator(int node)
+{
     if (bMsgParamStruct_.originator_.size() == 0) {
-        bMsgParamStruct_.originator_.push_back(vcard);
+        bMsgParamStruct_.originator_.push_back(PickUpVcard(node));
     } else {
         // error , only one originator_
-        LOG_ERROR("%{public}s execute", __PRETTY_FUNCTION__);
+        LOG_ERROR("%{public}s more than one originator", __PRETTY_FUNCTION__);
     }
 }
 
-MceBMessageNode MceBmessageParamAnalyser::PickUpRecipientLevel1(MceBMessageNode &node)
+int MceBmessageParamAnalyser::PickUpRecipient(int node, MceAnalyseEnumType level)
 {
-    LOG_INFO("%{public}s execute", __PRETTY_FUNCTION__);
-    MceBMessageNode nodeLevelXPlus1;
-    MceBMessageNode nexLevelRecipient;
-    IProfileMapVcard vcard1;
-
-    if (node.GetNodeName() != "BENV") {
-        return nexLevelRecipient;
+    int nexLevelRecipient = MceBMessageTokenizer::NODE_INVALID;
+    std::vector<IProfileMapVcard> *recipient = &bMsgParamStruct_.envelope_.recipientLevel1_;
+    if (level == MCE_RECIPIENT_LEVEL2) {
+        recipient = &bMsgParamStruct_.envelope_.recipientLevel2_;
+    } else if (level == MCE_RECIPIENT_LEVEL3) {
+        recipient = &bMsgParamStruct_.envelope_.recipientLevel3_;
     }
 
-    bMsgParamStruct_.envelope_.maxLevelOfEnvelope_ = MCE_RECIPIENT_LEVEL1;
-    nodeLevelXPlus1 = node.GetNextChild();
-    while (int(nodeLevelXPlus1.GetSize()) != 0) {
-        if (nodeLevelXPlus1.GetNodeName() == "VCARD") {
-            vcard1.VERSION = nodeLevelXPlus1.GetParamValue("VERSION:");        // shall be included
-            vcard1.N = nodeLevelXPlus1.GetParamValue("N:");                    // shall be included
-            vcard1.TEL = nodeLevelXPlus1.GetParamValueList("TEL:");            // may be used
-            vcard1.EMAIL = nodeLevelXPlus1.GetParamValueList("EMAIL:");        // may be used
-            vcard1.X_BT_UID = nodeLevelXPlus1.GetParamValueList("X-BT-UID:");  // bmsg V1.1
-            vcard1.X_BT_UCI = nodeLevelXPlus1.GetParamValueList("X-BT-UCI:");  // bmsg V1.1
-            vcard1.FN = nodeLevelXPlus1.GetParamValue("FN:");                  // vcard 3.0 , shall be included
-            bMsgParamStruct_.envelope_.recipientLevel1_.push_back(vcard1);
-        }
-        if ((nodeLevelXPlus1.GetNodeName() == "BBODY") && (msgNode_.GetSize() == 0)) {
-            msgNode_ = nodeLevelXPlus1;
-        }
-        if ((nodeLevelXPlus1.GetNodeName() == "BENV") && (nexLevelRecipient.GetSize() == 0)) {
-            nexLevelRecipient = nodeLevelXPlus1;
+    bMsgParamStruct_.envelope_.maxLevelOfEnvelope_ = level;
+    for (int child = tokenizer_.GetFirstChild(node); child != MceBMessageTokenizer::NODE_INVALID;
+         child = tokenizer_.GetNextSibling(child)) {
+        std::string_view name = tokenizer_.GetNodeName(child);
+        if (name == "VCARD") {
+            recipient->push_back(PickUpVcard(child));
+        } else if (name == "BBODY") {
+            // the innermost envelope holds the body
+            if ((msgNode_ == MceBMessageTokenizer::NODE_INVALID) || (level == MCE_RECIPIENT_LEVEL3)) {
+                msgNode_ = child;
+            }
+        } else if ((name == "BENV") && (level != MCE_RECIPIENT_LEVEL3) &&
+                   (nexLevelRecipient == MceBMessageTokenizer::NODE_INVALID)) {
+            nexLevelRecipient = child;
         }
-        nodeLevelXPlus1 = node.GetNextChild();
     }
     return nexLevelRecipient;
 }
 
-MceBMessageNode MceBmessageParamAnalyser::PickUpRecipientLevel2(MceBMessageNode &node)
+void MceBmessageParamAnalyser::PickUpMsgBodyProperty()
 {
-    LOG_INFO("%{public}s execute", __PRETTY_FUNCTION__);
-    MceBMessageNode nodeLevelXPlus2;
-    MceBMessageNode nexLevelRecipient;
-    IProfileMapVcard vcard2;
-
-    if (node.GetNodeName() != "BENV") {
-        return nexLevelRecipient;
+    if (msgNode_ != MceBMessageTokenizer::NODE_INVALID) {
+        bMsgParamStruct_.envelope_.msgBody_.bodyPartID =
+            tokenizer_.GetParamValue(msgNode_, MceBMessageTokenizer::PROPERTY_PARTID);
+        bMsgParamStruct_.envelope_.msgBody_.body_encoding =
+            tokenizer_.GetParamValue(msgNode_, MceBMessageTokenizer::PROPERTY_ENCODING);
+        bMsgParamStruct_.envelope_.msgBody_.body_charset =
+            tokenizer_.GetParamValue(msgNode_, MceBMessageTokenizer::PROPERTY_CHARSET);
+        bMsgParamStruct_.envelope_.msgBody_.body_language =
+            tokenizer_.GetParamValue(msgNode_, MceBMessageTokenizer::PROPERTY_LANGUAGE);
+        std::string tempStr = tokenizer_.GetParamValue(msgNode_, MceBMessageTokenizer::PROPERTY_LENGTH);
+        bMsgParamStruct_.envelope_.msgBody_.body_content_length = atoi(tempStr.c_str());
     }
+}
 
-    bMsgParamStruct_.envelope_.maxLevelOfEnvelope_ = MCE_RECIPIENT_LEVEL2;
-    nodeLevelXPlus2 = node.GetNextChild();
-    while (int(nodeLevelXPlus2.GetSize()) != 0) {
-        if (nodeLevelXPlus2.GetNodeName() == "VCARD") {
-            vcard2.VERSION = nodeLevelXPlus2.GetParamValue("VERSION:");        // shall be included
-            vcard2.N = nodeLevelXPlus2.GetParamValue("N:");                    // shall be included
-            vcard2.TEL = nodeLevelXPlus2.GetParamValueList("TEL:");            // may be used
-            vcard2.EMAIL = nodeLevelXPlus2.GetParamValueList("EMAIL:");        // may be used
-            vcard2.X_BT_UID = nodeLevelXPlus2.GetParamValueList("X-BT-UID:");  // bmsg V1.1
-            vcard2.X_BT_UCI = nodeLevelXPlus2.GetParamValueList("X-BT-UCI:");  // bmsg V1.1
-            vcard2.FN = nodeLevelXPlus2.GetParamValue("FN:");                  // vcard 3.0 , shall be included
-            bMsgParamStruct_.envelope_.recipientLevel2_.push_back(vcard2);
-        }
-        if ((nodeLevelXPlus2.GetNodeName() == "BBODY") && (msgNode_.GetSize() == 0)) {
-            msgNode_ = nodeLevelXPlus2;
-        }
-        if ((nodeLevelXPlus2.GetNodeName() == "BENV") && (nexLevelRecipient.GetSize() == 0)) {
-            nexLevelRecipient = nodeLevelXPlus2;
-        }
-        nodeLevelXPlus2 = node.GetNextChild();
-    }
-    return nexLevelRecipient;
+void MceBmessageParamAnalyser::PickUpMsgBodyText()
+{
+    bMsgParamStruct_.envelope_.msgBody_.body_content = std::string(tokenizer_.GetMsgText());
 }
 
-void MceBmessageParamAnalyser::PickUpRecipientLevel3(MceBMessageNode &node)
+MceConversationListingParser::MceConversationListingParser() : parser_(*this)
+{}
+
+MceConversationListingParser::~MceConversationListingParser()
+{}
+
+void MceConversationListingParser::Feed(const uint8_t *data, size_t len)
 {
-    LOG_INFO("%{public}s execute", __PRETTY_FUNCTION__);
-    MceBMessageNode nodeLevelXPlus3;
-    IProfileMapVcard vcard3;
+    object_.append(reinterpret_cast<const char *>(data), len);
+    parser_.Feed(data, len);
+}
 
-    if (node.GetNodeName() != "BENV") {
-        return;
-    }
+const std::vector<IProfileConversation> &MceConversationListingParser::GetList() const
+{
+    return list_;
+}
 
-    bMsgParamStruct_.envelope_.maxLevelOfEnvelope_ = MCE_RECIPIENT_LEVEL3;
-    nodeLevelXPlus3 = node.GetNextChild();
-    while (int(nodeLevelXPlus3.GetSize()) != 0) {
-        if (nodeLevelXPlus3.GetNodeName() == "VCARD") {
-            vcard3.VERSION = nodeLevelXPlus3.GetParamValue("VERSION:");        // shall be included
-            vcard3.N = nodeLevelXPlus3.GetParamValue("N:");                    // shall be included
-            vcard3.TEL = nodeLevelXPlus3.GetParamValueList("TEL:");            // may be used
-            vcard3.EMAIL = nodeLevelXPlus3.GetParamValueList("EMAIL:");        // may be used
-            vcard3.X_BT_UID = nodeLevelXPlus3.GetParamValueList("X-BT-UID:");  // bmsg V1.1
-            vcard3.X_BT_UCI = nodeLevelXPlus3.GetParamValueList("X-BT-UCI:");  // bmsg V1.1
-            vcard3.FN = nodeLevelXPlus3.GetParamValue("FN:");                  // vcard 3.0 , shall be included
-            bMsgParamStruct_.envelope_.recipientLevel3_.push_back(vcard3);
-        }
-        if (nodeLevelXPlus3.GetNodeName() == "BBODY") {
-            msgNode_ = nodeLevelXPlus3;
-        }
-        nodeLevelXPlus3 = node.GetNextChild();
-    }
+const std::string &MceConversationListingParser::GetVersion() const
+{
+    return version_;
 }
 
-void MceBmessageParamAnalyser::PickUpMsgBodyProperty()
+std::vector<IProfileConversation> MceConversationListingParser::TakeList()
 {
-    LOG_INFO("%{public}s execute", __PRETTY_FUNCTION__);
-    if (msgNode_.GetSize() != 0) {
-        bMsgParamStruct_.envelope_.msgBody_.bodyPartID = msgNode_.GetParamValue("PARTID:");
-        bMsgParamStruct_.envelope_.msgBody_.body_encoding = msgNode_.GetParamValue("ENCODING:");
-        bMsgParamStruct_.envelope_.msgBody_.body_charset = msgNode_.GetParamValue("CHARSET:");
-        bMsgParamStruct_.envelope_.msgBody_.body_language = msgNode_.GetParamValue("LANGUAGE:");
-        std::string tempStr = msgNode_.GetParamValue("LENGTH:");
-        bMsgParamStruct_.envelope_.msgBody_.body_content_length = atoi(tempStr.c_str());
+    return std::move(list_);
+}
+
+std::string MceConversationListingParser::TakeStringObject()
+{
+    return std::move(object_);
+}
+
+void MceConversationListingParser::OnElementBegin(
+    MceListingElement element, int depth, const MceListingParser &parser)
+{
+    if ((depth == 0) && (element == MceListingElement::CONVO_LISTING)) {
+        isListing_ = true;
+        version_ = parser.Attribute(MceListingAttribute::VERSION);
+    } else if (isListing_ && (depth == 1) && (element == MceListingElement::CONVERSATION)) {
+        inConversation_ = true;
+        conversation_ = IProfileConversation {};
+        PickUpConversation(conversation_, parser);
+    } else if (inConversation_ && (depth == 2) && (element == MceListingElement::PARTICIPANT)) {
+        IProfileParticipant participant;
+        PickUpParticipant(participant, parser);
+        conversation_.participantList_.push_back(std::move(participant));
     }
 }
 
-void MceBmessageParamAnalyser::PickUpMsgBodyText()
+void MceConversationListingParser::OnElementEnd(MceListingElement element, int depth)
 {
-    LOG_INFO("%{public}s execute", __PRETTY_FUNCTION__);
-    int next = 1;
-    int msgBegin = 0;
-    int msgEnd = 0;
-    int endMsgLength = strlen("END:MSG");
-    int beginMsgLength = strlen("BEGIN:MSG");
-
-    // pickup the msg text
-    for (int i = 0; i < int(msgStr_.size()); i++) {
-        if (msgBegin == 0) {
-            if (msgStr_.substr(i, beginMsgLength) == "BEGIN:MSG") {
-                i = i + beginMsgLength + 1;
-                msgBegin = i;
-            }
-            if ((msgBegin != 0) && ((msgStr_.substr(i, 1) == "\r") || (msgStr_.substr(i, 1) == "\n"))) {
-                i++;
-                msgBegin = i;
-            }
-            continue;
-        }
-        if (msgStr_.substr(i, endMsgLength) == "END:MSG") {
-            next = 1;
-            if ((msgStr_.substr(i - next - 1, 1) == "\r") || (msgStr_.substr(i - next - 1, 1) == "\n")) {
-                next++;
-            }
-            msgEnd = i - next;
-            if (msgEnd > msgBegin) {
-                bMsgParamStruct_.envelope_.msgBody_.body_content = msgStr_.substr(msgBegin, msgEnd - msgBegin);
-            } else {
-                bMsgParamStruct_.envelope_.msgBody_.body_content = "";
-            }
-            break;
-        }
+    if (inConversation_ && (depth == 1) && (element == MceListingElement::CONVERSATION)) {
+        inConversation_ = false;
+        list_.push_back(std::move(conversation_));
     }
 }
 
-void MceTypesConversationListing::PickUpParticipant(IProfileParticipant &data, const MceXmlNode &node)
+void MceConversationListingParser::PickUpParticipant(IProfileParticipant &data, const MceListingParser &parser)
 {
-    LOG_INFO("%{public}s execute", __PRETTY_FUNCTION__);
-    data.uci = node.Attribute("uci").AsString();
-    data.display_name = node.Attribute("display_name").AsString();
-    data.chat_state = node.Attribute("chat_state").AsString();
-    data.last_activity = node.Attribute("last_activity").AsString();
-    data.x_bt_uid = node.Attribute("x_bt_uid").AsString();
-    data.name = node.Attribute("name").AsString();
-    data.presence_availability = node.Attribute("presence_availability").AsString();
-    data.presence_text = node.Attribute("presence_text").AsString();
-    data.priority = node.Attribute("priority").AsString();
+    data.uci = parser.Attribute(MceListingAttribute::UCI);
+    data.display_name = parser.Attribute(MceListingAttribute::DISPLAY_NAME);
+    data.chat_state = parser.Attribute(MceListingAttribute::CHAT_STATE);
+    data.last_activity = parser.Attribute(MceListingAttribute::LAST_ACTIVITY);
+    data.x_bt_uid = parser.Attribute(MceListingAttribute::X_BT_UID);
+    data.name = parser.Attribute(MceListingAttribute::NAME);
+    data.presence_availability = parser.Attribute(MceListingAttribute::PRESENCE_AVAILABILITY);
+    data.presence_text = parser.Attribute(MceListingAttribute::PRESENCE_TEXT);
+    data.priority = parser.Attribute(MceListingAttribute::PRIORITY);
 }
 
-void MceTypesConversationListing::PickUpConversation(IProfileConversation &data, const MceXmlNode &node)
+void MceConversationListingParser::PickUpConversation(IProfileConversation &data, const MceListingParser &parser)
 {
-    LOG_INFO("%{public}s execute", __PRETTY_FUNCTION__);
-    IProfileParticipant participants;
-
-    data.id = node.Attribute("id").AsString();
-    data.name = node.Attribute("name").AsString();
-    data.last_activity = node.Attribute("last_activity").AsString();
-    data.read_status = node.Attribute("read_status").AsString();
-    data.version_counter = node.Attribute("version_counter").AsString();
-    data.summary = node.Attribute("summary").AsString();
-
-    for (MceXmlNode covNode = node.FirstChild(); !covNode.Empty(); covNode = covNode.NextSibling()) {
-        std::string checkName(covNode.Name());
-        if (checkName == "participant") {
-            PickUpParticipant(participants, covNode);
-            // push to vector list
-            data.participantList_.push_back(participants);
-        }
-    }
+    data.id = parser.Attribute(MceListingAttribute::ID);
+    data.name = parser.Attribute(MceListingAttribute::NAME);
+    data.last_activity = parser.Attribute(MceListingAttribute::LAST_ACTIVITY);
+    data.read_status = parser.Attribute(MceListingAttribute::READ_STATUS);
+    data.version_counter = parser.Attribute(MceListingAttribute::VERSION_COUNTER);
+    data.summary = parser.Attribute(MceListingAttribute::SUMMARY);
 }
 
 int MceTypesConversationListing::BuildObjectData(
     const IProfileConversationListingParamStruct &stringParam, const std::string &stringObject)
 {
-    LOG_INFO("%{public}s execute", __PRETTY_FUNCTION__);
-    int ret = RET_NO_ERROR;
-    conversationListingParam_ = stringParam;
-    conversationListingObject_ = stringObject;
-    IProfileConversation converOutline;
-
-    MceXmlDoc xmlDoc {};
-    xmlDoc.LoadString(conversationListingObject_.c_str());
-    MceXmlNode rootNode = xmlDoc.Child("MAP-convo-listing");
+    MceConversationListingParser parser;
+    parser.Feed(reinterpret_cast<const uint8_t *>(stringObject.data()), stringObject.size());
+    return BuildObjectData(stringParam, parser);
+}
 
-    // init
-    conversationList_.clear();
+int MceTypesConversationListing::BuildObjectData(
+    const IProfileConversationListingParamStruct &stringParam, MceConversationListingParser &parser)
+{
+    conversationListingParam_ = stringParam;
+    conversationListingParam_.Version = parser.GetVersion();
+    conversationListingObject_ = parser.TakeStringObject();
+    conversationList_ = parser.TakeList();
+    return RET_NO_ERROR;
+}
 
-    if (!rootNode.Empty()) {
-        // version
-        conversationListingParam_.Version = rootNode.Attribute("version").AsString();
-
-        for (MceXmlNode covNode = rootNode.FirstChild(); !covNode.Empty(); covNode = covNode.NextSibling()) {
-            std::string checkName(covNode.Name());
-            if (checkName == "conversation") {
-                converOutline.participantList_.clear();
-                PickUpConversation(converOutline, covNode);
-                // push to vector list
-                conversationList_.push_back(converOutline);
-            }
-        }
-    }
-    return ret;
+int MceTypesConversationListing::BuildPartialObjectData(const MceConversationListingParser &parser, size_t first)
+{
+    const std::vector<IProfileConversation> &list = parser.GetList();
+    conversationListingParam_.Version = parser.GetVersion();
+    conversationList_.assign(list.begin() + std::min(first, list.size()), list.end());
+    return RET_NO_ERROR;
 }
 
 std::vector<IProfileConversation> MceTypesConversationListing::GetList() const
@@ -815,72 +724,123 @@ std::string MceTypesConversationListing::GetStringObject() const
     return conversationListingObject_;
 }
 
-void MceTypesMessagesListing::PickupOutlineParam(IProfileMessageOutline &msgOutline, const MceXmlNode &msgNode)
+MceMessagesListingParser::MceMessagesListingParser() : parser_(*this)
+{}
+
+MceMessagesListingParser::~MceMessagesListingParser()
+{}
+
+void MceMessagesListingParser::Feed(const uint8_t *data, size_t len)
+{
+    object_.append(reinterpret_cast<const char *>(data), len);
+    parser_.Feed(data, len);
+}
+
+const std::vector<IProfileMessageOutline> &MceMessagesListingParser::GetList() const
+{
+    return list_;
+}
+
+const std::string &MceMessagesListingParser::GetVersion() const
+{
+    return version_;
+}
+
+std::vector<IProfileMessageOutline> MceMessagesListingParser::TakeList()
+{
+    return std::move(list_);
+}
+
+std::string MceMessagesListingParser::TakeStringObject()
+{
+    return std::move(object_);
+}
+
+void MceMessagesListingParser::OnElementBegin(MceListingElement element, int depth, const MceListingParser &parser)
+{
+    if ((depth == 0) && (element == MceListingElement::MSG_LISTING)) {
+        isListing_ = true;
+        version_ = parser.Attribute(MceListingAttribute::VERSION);
+    } else if (isListing_ && (depth == 1) && (element == MceListingElement::MSG)) {
+        IProfileMessageOutline msgOutline;
+        PickupOutlineParam(msgOutline, parser);
+        list_.push_back(std::move(msgOutline));
+    }
+}
+
+void MceMessagesListingParser::OnElementEnd(MceListingElement element, int depth)
+{}
+
+void MceMessagesListingParser::PickupOutlineParam(IProfileMessageOutline &msgOutline, const MceListingParser &parser)
 {
     // Attribute
-    msgOutline.handle = msgNode.Attribute("handle").AsString();
-    msgOutline.subject = msgNode.Attribute("subject").AsString();
-    msgOutline.datetime = msgNode.Attribute("datetime").AsString();
-    msgOutline.sender_name = msgNode.Attribute("sender_name").AsString();
-    msgOutline.sender_addressing = msgNode.Attribute("sender_addressing").AsString();
-    msgOutline.replyto_addressing = msgNode.Attribute("replyto_addressing").AsString();
-    msgOutline.recipient_name = msgNode.Attribute("recipient_name").AsString();
-    msgOutline.recipient_addressing = msgNode.Attribute("recipient_addressing").AsString();
+    msgOutline.handle = parser.Attribute(MceListingAttribute::HANDLE);
+    msgOutline.subject = parser.Attribute(MceListingAttribute::SUBJECT);
+    msgOutline.datetime = parser.Attribute(MceListingAttribute::DATETIME);
+    msgOutline.sender_name = parser.Attribute(MceListingAttribute::SENDER_NAME);
+    msgOutline.sender_addressing = parser.Attribute(MceListingAttribute::SENDER_ADDRESSING);
+    msgOutline.replyto_addressing = parser.Attribute(MceListingAttribute::REPLYTO_ADDRESSING);
+    msgOutline.recipient_name = parser.Attribute(MceListingAttribute::RECIPIENT_NAME);
+    msgOutline.recipient_addressing = parser.Attribute(MceListingAttribute::RECIPIENT_ADDRESSING);
 
     // "Type"
-    std::string tempStr = msgNode.Attribute("type").AsString();
+    std::string tempStr = parser.Attribute(MceListingAttribute::TYPE);
     msgOutline.type = MceUtilityConvertFormat::ConvertStringToMessageType(tempStr);
 
     // "receptionStatus"
-    tempStr = msgNode.Attribute("receptionStatus").AsString();
+    tempStr = parser.Attribute(MceListingAttribute::RECEPTION_STATUS);
     msgOutline.receptionStatus = MceUtilityConvertFormat::ConvertStringToMsgReceptionStatus(tempStr);
 
-    msgOutline.size = msgNode.Attribute("size").AsInt();
-    msgOutline.attachment_size = msgNode.Attribute("attachment_size").AsInt();
-    msgOutline.text = MceUtilityConvertFormat::ConvertStringToMapBoolType(msgNode.Attribute("text").AsString());
+    msgOutline.size = parser.AttributeAsInt(MceListingAttribute::SIZE);
+    msgOutline.attachment_size = parser.AttributeAsInt(MceListingAttribute::ATTACHMENT_SIZE);
+    msgOutline.text = MceUtilityConvertFormat::ConvertStringToMapBoolType(parser.Attribute(MceListingAttribute::TEXT));
     msgOutline.read =
-        MceUtilityConvertFormat::ConvertYesNoStringToMapMessageStatus(msgNode.Attribute("read").AsString());
-    msgOutline.sent = MceUtilityConvertFormat::ConvertStringToMapBoolType(msgNode.Attribute("sent").AsString());
+        MceUtilityConvertFormat::ConvertYesNoStringToMapMessageStatus(parser.Attribute(MceListingAttribute::READ));
+    msgOutline.sent = MceUtilityConvertFormat::ConvertStringToMapBoolType(parser.Attribute(MceListingAttribute::SENT));
     msgOutline.protected_ =
-        MceUtilityConvertFormat::ConvertStringToMapBoolType(msgNode.Attribute("protected").AsString());
-    msgOutline.priority = MceUtilityConvertFormat::ConvertStringToMapBoolType(msgNode.Attribute("priority").AsString());
+        MceUtilityConvertFormat::ConvertStringToMapBoolType(parser.Attribute(MceListingAttribute::PROTECTED));
+    msgOutline.priority =
+        MceUtilityConvertFormat::ConvertStringToMapBoolType(parser.Attribute(MceListingAttribute::PRIORITY));
     // "delivery_status" V1.1
-    tempStr = msgNode.Attribute("delivery_status").AsString();
+    tempStr = parser.Attribute(MceListingAttribute::DELIVERY_STATUS);
     msgOutline.delivery_status = MceUtilityConvertFormat::ConvertStringToMsgDeliveryStatus(tempStr);
 
-    msgOutline.conversation_id = msgNode.Attribute("conversation_id").AsString();
-    msgOutline.conversation_name = msgNode.Attribute("conversation_name").AsString();
+    msgOutline.conversation_id = parser.Attribute(MceListingAttribute::CONVERSATION_ID);
+    msgOutline.conversation_name = parser.Attribute(MceListingAttribute::CONVERSATION_NAME);
 
     // "direction"  V1.1
-    tempStr = msgNode.Attribute("direction").AsString();
+    tempStr = parser.Attribute(MceListingAttribute::DIRECTION);
     msgOutline.direction = MceUtilityConvertFormat::ConvertStringToMsgDirection(tempStr);
 
     // mime types
-    msgOutline.attachment_mime_types = msgNode.Attribute("attachment_mime_types").AsString();
+    msgOutline.attachment_mime_types = parser.Attribute(MceListingAttribute::ATTACHMENT_MIME_TYPES);
 }
 
 int MceTypesMessagesListing::BuildObjectData(
     const IProfileMessagesListingParamStruct &stringParam, const std::string &stringObject)
 {
-    LOG_INFO("%{public}s enter", __PRETTY_FUNCTION__);
-    int ret = RET_NO_ERROR;
-    IProfileMessageOutline msgOutline;
-    std::string tempStr;
+    MceMessagesListingParser parser;
+    parser.Feed(reinterpret_cast<const uint8_t *>(stringObject.data()), stringObject.size());
+    return BuildObjectData(stringParam, parser);
+}
+
+int MceTypesMessagesListing::BuildObjectData(
+    const IProfileMessagesListingParamStruct &stringParam, MceMessagesListingParser &parser)
+{
     messagesListingParam_ = stringParam;
-    MessagesListingObject_ = stringObject;
-    MceXmlDoc xmlDoc {};
-    xmlDoc.LoadString(MessagesListingObject_.c_str());
-    MceXmlNode rootNode = xmlDoc.Child("MAP-msg-listing");
-    if (!rootNode.Empty()) {
-        messagesListingParam_.Version = rootNode.Attribute("version").AsString();  // version
-        for (MceXmlNode msgNode = rootNode.FirstChild(); !msgNode.Empty(); msgNode = msgNode.NextSibling()) {
-            PickupOutlineParam(msgOutline, msgNode);
-            // push to vector list
-            messageList_.push_back(msgOutline);
-        }
-    }
-    LOG_INFO("%{public}s end, msglist size = %{public}d", __PRETTY_FUNCTION__, int(messageList_.size()));
-    return ret;
+    messagesListingParam_.Version = parser.GetVersion();
+    MessagesListingObject_ = parser.TakeStringObject();
+    messageList_ = parser.TakeList();
+    LOG_INFO("%{public}s msglist size = %{public}d", __PRETTY_FUNCTION__, int(messageList_.size()));
+    return RET_NO_ERROR;
+}
+
+int MceTypesMessagesListing::BuildPartialObjectData(const MceMessagesListingParser &parser, size_t first)
+{
+    const std::vector<IProfileMessageOutline> &list = parser.GetList();
+    messagesListingParam_.Version = parser.GetVersion();
+    messageList_.assign(list.begin() + std::min(first, list.size()), list.end());
+    return RET_NO_ERROR;
 }
 
 std::vector<IProfileMessageOutline> MceTypesMessagesListing::GetList() const
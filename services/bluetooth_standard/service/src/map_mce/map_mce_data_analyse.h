@@ -36,8 +36,11 @@
 #include <map>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
+#include "base_def.h"
 #include "interface_profile_map_mce.h"
+#include "map_mce_listing_parser.h"
 #include "map_mce_xml.h"
 
 namespace bluetooth {
@@ -46,37 +49,6 @@ enum MceAnalyseEnumType {
     MCE_RECIPIENT_LEVEL2 = 2,
     MCE_RECIPIENT_LEVEL3 = 3
 };
-/**
- * @brief split string
- */
-class MceSplitString {
-public:
-    /**
-     * @brief Construct a new Mce Split String object
-     * @param  target   target string
-     * @param  filter   split filter
-     */
-    MceSplitString(const std::string &target, const std::string &filter);
-    /**
-     * @brief Destroy the Mce Split String object
-     */
-    ~MceSplitString();
-    /**
-     * @brief next word
-     * @return std::string string of next word
-     */
-    std::string NextWord();
-
-private:
-    // count number
-    int count_ = 0;
-    // max of count
-    int maxCount_ = 0;
-    // target string
-    std::string targetString_ = "";
-    // filter string
-    std::string filterString_ = "";
-};
 /**
  * @brief mce combine node
  */
@@ -123,70 +95,131 @@ private:
     std::ostringstream stream_ {};
 };
 /**
- * @brief mce bmessage node
+ * @brief bMessage tokenizer
+ * Splits a bMessage into lines in one pass and indexes every BEGIN:/END: block as a node. Nodes are kept in a flat
+ * array linked to their first child and next sibling, and the known property lines of a node are indexed by key, so a
+ * lookup does not rescan the message. The MSG block content is not tokenized, only its offsets are kept.
+ * Property values point into the message string, which must outlive the tokenizer.
  */
-class MceBMessageNode {
+class MceBMessageTokenizer {
 public:
-    /**
-     * @brief Construct a new Mce B Message Node object
+    static constexpr int NODE_INVALID = -1;
+    enum Property : uint8_t {
+        PROPERTY_VERSION = 0,
+        PROPERTY_STATUS,
+        PROPERTY_TYPE,
+        PROPERTY_FOLDER,
+        PROPERTY_EXTENDEDDATA,
+        PROPERTY_PARTID,
+        PROPERTY_ENCODING,
+        PROPERTY_CHARSET,
+        PROPERTY_LANGUAGE,
+        PROPERTY_LENGTH,
+        PROPERTY_N,
+        PROPERTY_FN,
+        PROPERTY_TEL,
+        PROPERTY_EMAIL,
+        PROPERTY_X_BT_UID,
+        PROPERTY_X_BT_UCI,
+        PROPERTY_MAX
+    };
+    /**
+     * @brief Construct a new Mce BMessage Tokenizer object
+     * @param  object           bmessage string
+     */
+    explicit MceBMessageTokenizer(std::string_view object);
+    /**
+     * @brief Destroy the Mce BMessage Tokenizer object
+     */
+    ~MceBMessageTokenizer();
+    /**
+     * @brief Get the root BMSG node, which has no child or property if the message is not well formed
+     * @return int
      */
-    MceBMessageNode();
+    int GetRoot() const;
     /**
-     * @brief Construct a new Mce B Message Node object
-     * @param  list             string list
-     * @param  name             node name
+     * @brief Get the first child of a node
+     * @param  node             node index
+     * @return int  NODE_INVALID if the node has no child
      */
-    MceBMessageNode(const std::list<std::string> &list, const std::string &name);
+    int GetFirstChild(int node) const;
     /**
-     * @brief Destroy the Mce B Message Node object
+     * @brief Get the next sibling of a node
+     * @param  node             node index
+     * @return int  NODE_INVALID if the node is the last child
      */
-    ~MceBMessageNode();
+    int GetNextSibling(int node) const;
     /**
-     * @brief  Mce Construct Node
-     * @param  list             string list
-     * @param  name             node name
+     * @brief Get the Node Name object
+     * @param  node             node index
+     * @return std::string_view
      */
-    void MceConstructNode(const std::list<std::string> &list, const std::string &name);
+    std::string_view GetNodeName(int node) const;
     /**
-     * @brief Get the Next Child object
-     * @return MceBMessageNode
+     * @brief Get the first value of a property at the level of the node
+     * @param  node             node index
+     * @param  property         property key
+     * @return std::string      empty if the node has no such property
      */
-    MceBMessageNode GetNextChild();
+    std::string GetParamValue(int node, Property property) const;
     /**
-     * @brief Get the Node Name object
-     * @return std::string
+     * @brief Get all values of a property at the level of the node
+     * @param  node             node index
+     * @param  property         property key
+     * @return std::vector<std::string>
      */
-    std::string GetNodeName() const;
+    std::vector<std::string> GetParamValueList(int node, Property property) const;
     /**
-     * @brief Get the Node Value object
-     * @return std::string
+     * @brief Get the content of the first MSG block
+     * @return std::string_view
      */
-    std::string GetNodeValue() const;
-    /**
-     * @brief Get the Parameter Value object
-     * @param  param            parameter
-     * @return std::string
+    std::string_view GetMsgText() const;
+
+private:
+    struct Node {
+        std::string_view name {};
+        int firstChild = NODE_INVALID;
+        int lastChild = NODE_INVALID;
+        int nextSibling = NODE_INVALID;
+        int firstValue[PROPERTY_MAX];
+        int lastValue[PROPERTY_MAX];
+    };
+    struct Value {
+        std::string_view value {};
+        int next = NODE_INVALID;
+    };
+    /**
+     * @brief Tokenize the message
+     * @return bool  false if BEGIN:BMSG or END:BMSG is missing
+     */
+    bool Tokenize();
+    /**
+     * @brief  Add a node under the parent
+     * @param  parent           parent node index
+     * @param  name             node name
+     * @return int
      */
-    std::string GetParamValue(std::string param) const;
+    int AddNode(int parent, std::string_view name);
     /**
-     * @brief Get the Parameter Value List object
-     * @param  param            parameter
-     * @return std::vector<std::string>
+     * @brief  Add a property line to the node
+     * @param  node             node index
+     * @param  line             property line
      */
-    std::vector<std::string> GetParamValueList(std::string param) const;
+    void AddProperty(int node, std::string_view line);
     /**
-     * @brief Get the Size object
-     * @return int
+     * @brief  Record the MSG block content
+     * @param  begin            offset of the BEGIN:MSG line
+     * @param  end              offset of the END:MSG line
      */
-    int GetSize() const;
-
-private:
-    // node name
-    std::string name_ = "";
-    // node value
-    std::string value_ = "";
-    // string list
-    std::list<std::string> wordList_ {};
+    void SetMsgText(size_t begin, size_t end);
+    // message string
+    std::string_view object_ {};
+    // nodes, the root is the first one
+    std::vector<Node> nodes_ {};
+    // property values
+    std::vector<Value> values_ {};
+    // content of the first MSG block
+    std::string_view msgText_ {};
 };
 /**
  * @brief Mce Bmessage Parameter Make String Object
@@ -264,16 +297,6 @@ public:
      * @return IProfileBMessageStruct
      */
     IProfileBMessageStruct GetMsgStruct() const;
-    /**
-     * @brief Get the First Child Node object
-     * @return MceBMessageNode
-     */
-    MceBMessageNode GetFirstChildNode();
-    /**
-     * @brief Get the Size object
-     * @return int
-     */
-    int GetSize() const;
     /**
      * @brief Start Analyse Process
      */
@@ -285,37 +308,29 @@ public:
     std::string GetMsgText();
 
 private:
-    /**
-     * @brief make word list
-     */
-    void MakeWordList();
     /**
      * @brief  PickUp BMessage Property
      * @param  node             message node
      */
-    void PickUpBMessageProperty(const MceBMessageNode &node);
+    void PickUpBMessageProperty(int node);
     /**
      * @brief  PickUp BMessage Property Originator
      * @param  node             message node
      */
-    void PickUpBMessagePropertyOriginator(const MceBMessageNode &node);
+    void PickUpBMessagePropertyOriginator(int node);
     /**
-     * @brief  PickUp Recipient Level1
-     * @param  node             message node
-     * @return MceBMessageNode
+     * @brief  PickUp Recipient of one envelope level
+     * @param  node             envelope node
+     * @param  level            envelope level
+     * @return int  the next level envelope node
      */
-    MceBMessageNode PickUpRecipientLevel1(MceBMessageNode &node);
+    int PickUpRecipient(int node, MceAnalyseEnumType level);
     /**
-     * @brief  PickUp Recipient Level2
-     * @param  node             message node
-     * @return MceBMessageNode
-     */
-    MceBMessageNode PickUpRecipientLevel2(MceBMessageNode &node);
-    /**
-     * @brief  PickUp Recipient Level3
-     * @param  node             message node
+     * @brief  PickUp Vcard
+     * @param  node             vcard node
+     * @return IProfileMapVcard
      */
-    void PickUpRecipientLevel3(MceBMessageNode &node);
+    IProfileMapVcard PickUpVcard(int node) const;
     /**
      * @brief PickUp Message Body Property
      */
@@ -326,12 +341,88 @@ private:
     void PickUpMsgBodyText();
     // message string object
     std::string msgStr_ = "";
-    // word string list
-    std::list<std::string> wordList_ {};
+    // message tokens
+    MceBMessageTokenizer tokenizer_;
     // bmessage parameter
     IProfileBMessageStruct bMsgParamStruct_ {};
     // message node
-    MceBMessageNode msgNode_ {};
+    int msgNode_ = MceBMessageTokenizer::NODE_INVALID;
+
+    DISALLOW_COPY_AND_ASSIGN(MceBmessageParamAnalyser);
+};
+/**
+ * @brief Mce Conversation Listing Parser
+ * Builds the conversations while the listing object is fed in pieces, a conversation is added to the list when its
+ * end tag is parsed.
+ */
+class MceConversationListingParser : private MceListingParser::Handler {
+public:
+    /**
+     * @brief Construct a new Mce Conversation Listing Parser object
+     */
+    MceConversationListingParser();
+    /**
+     * @brief Destroy the Mce Conversation Listing Parser object
+     */
+    ~MceConversationListingParser();
+    /**
+     * @brief  Feed a piece of the listing object
+     * @param  data             data
+     * @param  len              data length
+     */
+    void Feed(const uint8_t *data, size_t len);
+    /**
+     * @brief Get the List object
+     * @return const std::vector<IProfileConversation>&
+     */
+    const std::vector<IProfileConversation> &GetList() const;
+    /**
+     * @brief Get the Version object
+     * @return const std::string&
+     */
+    const std::string &GetVersion() const;
+    /**
+     * @brief Take the List object out of the parser
+     * @return std::vector<IProfileConversation>
+     */
+    std::vector<IProfileConversation> TakeList();
+    /**
+     * @brief Take the String Object out of the parser
+     * @return std::string
+     */
+    std::string TakeStringObject();
+
+private:
+    void OnElementBegin(MceListingElement element, int depth, const MceListingParser &parser) override;
+    void OnElementEnd(MceListingElement element, int depth) override;
+    /**
+     * @brief  PickUp Participant
+     * @param  data             Participant data
+     * @param  parser           parser at the participant element
+     */
+    static void PickUpParticipant(IProfileParticipant &data, const MceListingParser &parser);
+    /**
+     * @brief  PickUp Conversation
+     * @param  data             Conversation data
+     * @param  parser           parser at the conversation element
+     */
+    static void PickUpConversation(IProfileConversation &data, const MceListingParser &parser);
+    // xml parser
+    MceListingParser parser_;
+    // root element is MAP-convo-listing
+    bool isListing_ = false;
+    // a conversation element is open
+    bool inConversation_ = false;
+    // conversation being parsed
+    IProfileConversation conversation_ {};
+    // listing version
+    std::string version_ = "";
+    // conversation list
+    std::vector<IProfileConversation> list_ {};
+    // conversationListing Object
+    std::string object_ = "";
+
+    DISALLOW_COPY_AND_ASSIGN(MceConversationListingParser);
 };
 /**
  * @brief Mce Types Conversation Listing
@@ -345,6 +436,20 @@ public:
      * @return int
      */
     int BuildObjectData(const IProfileConversationListingParamStruct &stringParam, const std::string &stringObject);
+    /**
+     * @brief  Build Object Data from a parser fed with the whole object, the list and object are moved out
+     * @param  stringParam      string parameter
+     * @param  parser           listing parser
+     * @return int
+     */
+    int BuildObjectData(const IProfileConversationListingParamStruct &stringParam, MceConversationListingParser &parser);
+    /**
+     * @brief  Build Object Data with the conversations parsed so far, from the first one not reported yet
+     * @param  parser           listing parser
+     * @param  first            index of the first conversation
+     * @return int
+     */
+    int BuildPartialObjectData(const MceConversationListingParser &parser, size_t first);
     /**
      * @brief Get the List object
      * @return std::vector<IProfileConversation>
@@ -362,18 +467,6 @@ public:
     std::string GetStringObject() const;
 
 private:
-    /**
-     * @brief  PickUp Participant
-     * @param  data             Participant data
-     * @param  node             xml node
-     */
-    static void PickUpParticipant(IProfileParticipant &data, const MceXmlNode &node);
-    /**
-     * @brief  PickUp Conversation
-     * @param  data             Conversation data
-     * @param  node             xml node
-     */
-    static void PickUpConversation(IProfileConversation &data, const MceXmlNode &node);
     // conversation list
     std::vector<IProfileConversation> conversationList_ {};
     // conversationListing Parameter
@@ -381,6 +474,69 @@ private:
     // conversationListing Object
     std::string conversationListingObject_ = "";
 };
+/**
+ * @brief Mce Messages Listing Parser
+ * Builds the message outlines while the listing object is fed in pieces.
+ */
+class MceMessagesListingParser : private MceListingParser::Handler {
+public:
+    /**
+     * @brief Construct a new Mce Messages Listing Parser object
+     */
+    MceMessagesListingParser();
+    /**
+     * @brief Destroy the Mce Messages Listing Parser object
+     */
+    ~MceMessagesListingParser();
+    /**
+     * @brief  Feed a piece of the listing object
+     * @param  data             data
+     * @param  len              data length
+     */
+    void Feed(const uint8_t *data, size_t len);
+    /**
+     * @brief Get the List object
+     * @return const std::vector<IProfileMessageOutline>&
+     */
+    const std::vector<IProfileMessageOutline> &GetList() const;
+    /**
+     * @brief Get the Version object
+     * @return const std::string&
+     */
+    const std::string &GetVersion() const;
+    /**
+     * @brief Take the List object out of the parser
+     * @return std::vector<IProfileMessageOutline>
+     */
+    std::vector<IProfileMessageOutline> TakeList();
+    /**
+     * @brief Take the String Object out of the parser
+     * @return std::string
+     */
+    std::string TakeStringObject();
+
+private:
+    void OnElementBegin(MceListingElement element, int depth, const MceListingParser &parser) override;
+    void OnElementEnd(MceListingElement element, int depth) override;
+    /**
+     * @brief  Pickup Outline Parameter
+     * @param  outline          outline Parameter
+     * @param  parser           parser at the msg element
+     */
+    static void PickupOutlineParam(IProfileMessageOutline &msgOutline, const MceListingParser &parser);
+    // xml parser
+    MceListingParser parser_;
+    // root element is MAP-msg-listing
+    bool isListing_ = false;
+    // listing version
+    std::string version_ = "";
+    // message list
+    std::vector<IProfileMessageOutline> list_ {};
+    // message listing object
+    std::string object_ = "";
+
+    DISALLOW_COPY_AND_ASSIGN(MceMessagesListingParser);
+};
 /**
  * @brief Mce Types MessagesListing
  */
@@ -393,6 +549,20 @@ public:
      * @return int
      */
     int BuildObjectData(const IProfileMessagesListingParamStruct &stringParam, const std::string &stringObject);
+    /**
+     * @brief  Build Object Data from a parser fed with the whole object, the list and object are moved out
+     * @param  stringParam      parameter
+     * @param  parser           listing parser
+     * @return int
+     */
+    int BuildObjectData(const IProfileMessagesListingParamStruct &stringParam, MceMessagesListingParser &parser);
+    /**
+     * @brief  Build Object Data with the outlines parsed so far, from the first one not reported yet
+     * @param  parser           listing parser
+     * @param  first            index of the first outline
+     * @return int
+     */
+    int BuildPartialObjectData(const MceMessagesListingParser &parser, size_t first);
     /**
      * @brief Get the List object
      * @return std::vector<IProfileMessageOutline>
@@ -416,12 +586,6 @@ private:
     IProfileMessagesListingParamStruct messagesListingParam_ {};
     // message listing object
     std::string MessagesListingObject_ = "";
-    /**
-     * @brief  Pickup Outline Parameter
-     * @param  outline          outline Parameter
-     * @param  node             xml node
-     */
-    static void PickupOutlineParam(IProfileMessageOutline &msgOutline, const MceXmlNode &msgNode);
 };
 /**
  * @brief Mce Types BMessage
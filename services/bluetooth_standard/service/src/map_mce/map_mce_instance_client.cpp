@@ -355,7 +355,7 @@ int MapMceInstanceClient::ClientSendRequest(std::unique_ptr<MapMceInstanceReques
     LOG_INFO("%{public}s execute", __PRETTY_FUNCTION__);
     std::lock_guard<std::recursive_mutex> lock(mceSendRequestMutex_);
 
-    int ret = req->SendRequest(*obexClientIns_);
+    int ret = SendRequestInternal(*req);
     if (ret == BT_NO_ERROR) {
         currentRequestPtr_ = std::move(req);
         currentRequestPtr_->SaveReq();
@@ -364,6 +364,16 @@ int MapMceInstanceClient::ClientSendRequest(std::unique_ptr<MapMceInstanceReques
     return ret;
 }
 
+int MapMceInstanceClient::SendRequestInternal(MapMceInstanceRequest &req)
+{
+    // listing entries are reported as they arrive, ahead of the complete listing
+    req.SetPartialResponseCallback([this](MapRequestResponseAction &retAction) {
+        std::lock_guard<std::recursive_mutex> lock(mceSendRequestMutex_);
+        ExcuteCallbackToFramework(retAction, MapExecuteStatus::CONTINUE);
+    });
+    return req.SendRequest(*obexClientIns_);
+}
+
 // call by stm
 void MapMceInstanceClient::ClientSaveRequest(std::unique_ptr<MapMceInstanceRequest> &req)
 {
@@ -513,7 +523,7 @@ int MapMceInstanceClient::ClientSendSavedRequest()
         // send request continue
         nextReq = std::move(masRequestQue_.front());
         masRequestQue_.pop_front();
-        ret = nextReq->SendRequest(*obexClientIns_);
+        ret = SendRequestInternal(*nextReq);
         if (ret == BT_NO_ERROR) {
             currentRequestPtr_ = std::move(nextReq);
             break;
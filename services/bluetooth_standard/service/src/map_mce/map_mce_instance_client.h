@@ -298,6 +298,12 @@ private:
      * @param  resCode
      */
     void ExcuteCallbackToFramework(MapRequestResponseAction &retAction, MapExecuteStatus resCode);
+    /**
+     * @brief Send a request, reporting its listing entries as they arrive
+     * @param  req
+     * @return int
+     */
+    int SendRequestInternal(MapMceInstanceRequest &req);
     /**
      * @brief Set the Obex Config object
      */
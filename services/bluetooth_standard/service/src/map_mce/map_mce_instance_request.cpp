@@ -149,6 +149,16 @@ MapMceRequestConfig MapMceInstanceRequest::GetRequestConfig() const
     return config_;
 }
 
+void MapMceInstanceRequest::SetPartialResponseCallback(const PartialResponseCallback &callback)
+{
+    partialResponseCallback_ = callback;
+}
+
+const MapMceInstanceRequest::PartialResponseCallback &MapMceInstanceRequest::GetPartialResponseCallback() const
+{
+    return partialResponseCallback_;
+}
+
 int MapMceInstanceRequest::MapMessageTypeToFrameworkMask(MapMessageType type) const
 {
     uint8_t mask;
@@ -1200,11 +1210,21 @@ int MapMceRequestGetConversationListing::SendRequest(ObexMpClient &obexIns)
 
     header->AppendItemAppParams(appParams);
 
-    // make writer object
-    std::shared_ptr<ObexBodyObject> writer = std::make_shared<ObexArrayBodyObject>();
+    // make writer object, the conversations are parsed and reported as the packets arrive
+    PartialResponseCallback callback = GetPartialResponseCallback();
+    body_ = std::make_shared<MapMceListingBodyObject<MceConversationListingParser>>(
+        [callback](const MceConversationListingParser &parser, size_t first) {
+            if (!callback) {
+                return;
+            }
+            MapRequestResponseAction action;
+            action.action_ = MapActionType::GET_CONVERSATION_LISTING;
+            action.conversationList_.BuildPartialObjectData(parser, first);
+            callback(action);
+        });
 
     // send request
-    ret = obexIns.Get(*header, writer);
+    ret = obexIns.Get(*header, body_);
     if (ret != BT_NO_ERROR) {
         LOG_ERROR("%{public}s obex Put error,ret=%{public}d ", __PRETTY_FUNCTION__, ret);
     }
@@ -1270,26 +1290,14 @@ int MapMceRequestGetConversationListing::ProcessResponse(
     rescode = resp.GetFieldCode();
     if (rescode == uint8_t(ObexRspCode::SUCCESS)) {
         MapMceGetItemAppParams(paramData, resp);
-        // get body
-        auto convObject = resp.GetExtendBodyObject();
-        uint8_t convBuf[MCE_MAX_LENGTH_OF_RESPONSE_BUFFER];
-        size_t bufLen = 1;
-        std::ostringstream convStream;
-        while ((bufLen != 0) && (convObject != 0)) {
-            bufLen = convObject->Read(convBuf, MCE_MAX_LENGTH_OF_RESPONSE_BUFFER - 1);
-            if ((bufLen != 0) && (bufLen < MCE_MAX_LENGTH_OF_RESPONSE_BUFFER)) {
-                convBuf[bufLen] = 0;
-                convStream << (char *)convBuf;
-            }
-        }
-        if (convStream.str().size() != 0) {
-            retAction.conversationList_.BuildObjectData(paramData, convStream.str());
+        // the body has been parsed as it arrived
+        if (body_ != nullptr) {
+            retAction.conversationList_.BuildObjectData(paramData, body_->GetParser());
         }
 #ifdef MCE_DEBUG_RECEIVE_DATA
-        LOG_INFO("GetConversationListing list size=%{public}d, strlength=%{public}d, convStream size=%{public}d",
+        LOG_INFO("GetConversationListing list size=%{public}d, strlength=%{public}d",
             int(retAction.conversationList_.GetList().size()),
-            int(retAction.conversationList_.GetStringObject().size()),
-            int(convStream.str().size()));
+            int(retAction.conversationList_.GetStringObject().size()));
         LOG_INFO("GetConversationListing stringObject=%{public}s", retAction.conversationList_.GetStringObject().c_str());
 #endif
     }
@@ -1429,11 +1437,21 @@ int MapMceRequestGetMessagesListing::SendRequest(ObexMpClient &obexIns)
         msgPara_.FilterReadStatus);
 #endif
 
-    // make writer object
-    std::shared_ptr<ObexBodyObject> writer = std::make_shared<ObexArrayBodyObject>();
+    // make writer object, the messages are parsed and reported as the packets arrive
+    PartialResponseCallback callback = GetPartialResponseCallback();
+    body_ = std::make_shared<MapMceListingBodyObject<MceMessagesListingParser>>(
+        [callback](const MceMessagesListingParser &parser, size_t first) {
+            if (!callback) {
+                return;
+            }
+            MapRequestResponseAction action;
+            action.action_ = MapActionType::GET_MESSAGES_LISTING;
+            action.messageList_.BuildPartialObjectData(parser, first);
+            callback(action);
+        });
 
     // send request
-    ret = obexIns.Get(*header, writer);
+    ret = obexIns.Get(*header, body_);
     if (ret != BT_NO_ERROR) {
         LOG_ERROR("%{public}s obex put error", __PRETTY_FUNCTION__);
     }
@@ -1504,25 +1522,13 @@ int MapMceRequestGetMessagesListing::ProcessResponse(
     int rescode = resp.GetFieldCode();
     if (rescode == uint8_t(ObexRspCode::SUCCESS)) {
         MapMceGetItemAppParams(rcvData, resp);
-        // get body
-        auto msgListObject = resp.GetExtendBodyObject();
-        uint8_t msgListBuf[MCE_MAX_LENGTH_OF_RESPONSE_BUFFER];
-        size_t msgLBufLen = 1;
-        stream_.clear();
-        while ((msgLBufLen != 0) && (msgListObject != 0)) {
-            msgLBufLen = msgListObject->Read(msgListBuf, MCE_MAX_LENGTH_OF_RESPONSE_BUFFER - 1);
-            if ((msgLBufLen != 0) && (msgLBufLen < MCE_MAX_LENGTH_OF_RESPONSE_BUFFER)) {
-                msgListBuf[msgLBufLen] = 0;
-                stream_ << (char *)msgListBuf;
-            }
-        }
-        if (stream_.str().size() != 0) {
-            retAction.messageList_.BuildObjectData(rcvData, stream_.str());
+        // the body has been parsed as it arrived
+        if (body_ != nullptr) {
+            retAction.messageList_.BuildObjectData(rcvData, body_->GetParser());
         }
 #ifdef MCE_DEBUG_RECEIVE_DATA
         LOG_INFO("GetMessagesListing ListingSize=%{public}d", rcvData.ListingSize);
-        LOG_INFO("GetMessagesListing stringObject stream length=%{public}d,str obj length=%{public}d, msglist size=%{public}d",
-            int(stream_.str().size()),
+        LOG_INFO("GetMessagesListing str obj length=%{public}d, msglist size=%{public}d",
             int(retAction.messageList_.GetStringObject().size()),
             int(retAction.messageList_.GetList().size()));
         LOG_INFO("GetMessagesListing stringObject=%{public}s", retAction.messageList_.GetStringObject().c_str());
@@ -32,7 +32,9 @@
 #define MAP_MCE_INSTANCE_REQUEST_H
 
 #include <cstdint>
+#include <functional>
 #include <list>
+#include <memory>
 #include <string>
 #include <vector>
 #include "../obex/obex_headers.h"
@@ -194,6 +196,7 @@ struct MapMceRequestConfig {
  */
 class MapMceInstanceRequest {
 public:
+    using PartialResponseCallback = std::function<void(MapRequestResponseAction &retAction)>;
     /**
      * @brief Construct a new Map Mce Instance Request object
      */
@@ -256,8 +259,18 @@ public:
      * @return Request Config
      */
     MapMceRequestConfig GetRequestConfig() const;
+    /**
+     * @brief Set the Partial Response Callback object
+     * @param  callback   called on the obex thread with the listing entries received so far
+     */
+    void SetPartialResponseCallback(const PartialResponseCallback &callback);
 
 protected:
+    /**
+     * @brief Get the Partial Response Callback object
+     * @return const PartialResponseCallback&  empty if partial responses are not wanted
+     */
+    const PartialResponseCallback &GetPartialResponseCallback() const;
     /**
      * @brief  Trans MapMessageType To IprofileMask
      * @param  type     Message Type
@@ -286,6 +299,62 @@ private:
     std::string ownerUci_ = "";
     // config parameter
     MapMceRequestConfig config_ {};
+    // partial response callback
+    PartialResponseCallback partialResponseCallback_ {};
+};
+
+/**
+ * @brief Listing body object
+ * Writer of a listing GET. The body is parsed as the OBEX packets arrive, and the entries completed by each packet
+ * are reported through the callback.
+ */
+template <typename Parser>
+class MapMceListingBodyObject : public ObexBodyObject {
+public:
+    using EntriesCallback = std::function<void(const Parser &parser, size_t first)>;
+    /**
+     * @brief Construct a new Map Mce Listing Body Object object
+     * @param  callback   called with the parser and the index of the first new entry
+     */
+    explicit MapMceListingBodyObject(const EntriesCallback &callback) : callback_(callback)
+    {}
+    ~MapMceListingBodyObject() override = default;
+    size_t Read(uint8_t *buf, size_t bufLen) override
+    {
+        return 0;
+    }
+    size_t Write(const uint8_t *buf, size_t bufLen) override
+    {
+        parser_.Feed(buf, bufLen);
+        size_t size = parser_.GetList().size();
+        if ((size > reported_) && callback_) {
+            callback_(parser_, reported_);
+            reported_ = size;
+        }
+        return bufLen;
+    }
+    int Close() override
+    {
+        return 0;
+    }
+    /**
+     * @brief Get the Parser object
+     * @return Parser&
+     */
+    Parser &GetParser()
+    {
+        return parser_;
+    }
+
+private:
+    // listing parser
+    Parser parser_ {};
+    // entries callback
+    EntriesCallback callback_ {};
+    // number of entries reported
+    size_t reported_ = 0;
+
+    DISALLOW_COPY_AND_ASSIGN(MapMceListingBodyObject);
 };
 
 /**
@@ -612,6 +681,7 @@ public:
 private:
     void SetAppendParam(ObexTlvParamters &appParams);
     IProfileGetConversationListingParameters converPara_ {};
+    std::shared_ptr<MapMceListingBodyObject<MceConversationListingParser>> body_ = nullptr;
     static void MapMceGetItemAppParams(IProfileConversationListingParamStruct &data, const ObexHeader &resp);
 };
 
@@ -632,7 +702,7 @@ private:
     void SendRequestSetAppParamsStep1(ObexTlvParamters &appParams);
     void SendRequestSetAppParamsStep2(ObexTlvParamters &appParams);
     IProfileGetMessagesListingParameters msgPara_ {};
-    std::ostringstream stream_ {};
+    std::shared_ptr<MapMceListingBodyObject<MceMessagesListingParser>> body_ = nullptr;
 };
 
 /**
@@ -0,0 +1,325 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "map_mce_listing_parser.h"
+#include <cstdlib>
+#include <unordered_map>
+#include "log.h"
+
+namespace bluetooth {
+namespace {
+constexpr std::string_view LISTING_COMMENT_OPEN = "<!--";
+constexpr std::string_view LISTING_SPACES = " \t\r\n";
+constexpr size_t LISTING_MAX_MARKUP_LENGTH = 0x10000;
+constexpr int LISTING_COMMENT_CLOSE_DASHES = 2;
+constexpr int LISTING_DECIMAL = 10;
+constexpr int LISTING_HEX = 16;
+constexpr uint32_t UTF8_MAX_1_BYTE = 0x7F;
+constexpr uint32_t UTF8_MAX_2_BYTES = 0x7FF;
+constexpr uint32_t UTF8_MAX_3_BYTES = 0xFFFF;
+constexpr uint32_t UTF8_MAX_CODE_POINT = 0x10FFFF;
+constexpr uint32_t UTF8_CONTINUATION = 0x80;
+constexpr uint32_t UTF8_CONTINUATION_MASK = 0x3F;
+constexpr uint32_t UTF8_LEAD_2_BYTES = 0xC0;
+constexpr uint32_t UTF8_LEAD_3_BYTES = 0xE0;
+constexpr uint32_t UTF8_LEAD_4_BYTES = 0xF0;
+constexpr int UTF8_SHIFT = 6;
+
+void AppendUtf8(uint32_t code, std::string &out)
+{
+    if (code <= UTF8_MAX_1_BYTE) {
+        out += static_cast<char>(code);
+    } else if (code <= UTF8_MAX_2_BYTES) {
+        out += static_cast<char>(UTF8_LEAD_2_BYTES | (code >> UTF8_SHIFT));
+        out += static_cast<char>(UTF8_CONTINUATION | (code & UTF8_CONTINUATION_MASK));
+    } else if (code <= UTF8_MAX_3_BYTES) {
+        out += static_cast<char>(UTF8_LEAD_3_BYTES | (code >> (UTF8_SHIFT + UTF8_SHIFT)));
+        out += static_cast<char>(UTF8_CONTINUATION | ((code >> UTF8_SHIFT) & UTF8_CONTINUATION_MASK));
+        out += static_cast<char>(UTF8_CONTINUATION | (code & UTF8_CONTINUATION_MASK));
+    } else {
+        out += static_cast<char>(UTF8_LEAD_4_BYTES | (code >> (UTF8_SHIFT + UTF8_SHIFT + UTF8_SHIFT)));
+        out += static_cast<char>(UTF8_CONTINUATION | ((code >> (UTF8_SHIFT + UTF8_SHIFT)) & UTF8_CONTINUATION_MASK));
+        out += static_cast<char>(UTF8_CONTINUATION | ((code >> UTF8_SHIFT) & UTF8_CONTINUATION_MASK));
+        out += static_cast<char>(UTF8_CONTINUATION | (code & UTF8_CONTINUATION_MASK));
+    }
+}
+
+// Decode the entity between '&' and ';', returns false if it is not a known entity.
+bool DecodeEntity(std::string_view entity, std::string &out)
+{
+    static const std::unordered_map<std::string_view, char> entities = {
+        {"lt", '<'}, {"gt", '>'}, {"amp", '&'}, {"quot", '"'}, {"apos", '\''},
+    };
+    if ((entity.size() > 1) && (entity[0] == '#')) {
+        bool isHex = (entity[1] == 'x') || (entity[1] == 'X');
+        std::string digits(entity.substr(isHex ? 2 : 1));
+        char *end = nullptr;
+        unsigned long code = strtoul(digits.c_str(), &end, isHex ? LISTING_HEX : LISTING_DECIMAL);
+        if (digits.empty() || (*end != '\0') || (code == 0) || (code > UTF8_MAX_CODE_POINT)) {
+            return false;
+        }
+        AppendUtf8(code, out);
+        return true;
+    }
+    auto it = entities.find(entity);
+    if (it == entities.end()) {
+        return false;
+    }
+    out += it->second;
+    return true;
+}
+}  // namespace
+
+MceListingParser::MceListingParser(Handler &handler) : handler_(handler)
+{}
+
+MceListingParser::~MceListingParser()
+{}
+
+void MceListingParser::Feed(const uint8_t *data, size_t len)
+{
+    std::string_view input(reinterpret_cast<const char *>(data), len);
+    // a markup continued from the previous piece starts at 0
+    size_t markupBegin = 0;
+
+    for (size_t i = 0; i < input.size(); i++) {
+        char c = input[i];
+        switch (state_) {
+            case State::TEXT:
+                if (c == '<') {
+                    state_ = State::MARKUP;
+                    markupBegin = i;
+                    commentMatch_ = 1;
+                }
+                break;
+            case State::MARKUP:
+                if (commentMatch_ < LISTING_COMMENT_OPEN.size()) {
+                    commentMatch_ = (c == LISTING_COMMENT_OPEN[commentMatch_]) ? (commentMatch_ + 1) : SIZE_MAX;
+                    if (commentMatch_ == LISTING_COMMENT_OPEN.size()) {
+                        state_ = State::COMMENT;
+                        commentDashes_ = 0;
+                        pending_.clear();
+                        break;
+                    }
+                }
+                if ((c == '"') || (c == '\'')) {
+                    quote_ = c;
+                    state_ = State::QUOTE;
+                } else if (c == '>') {
+                    state_ = State::TEXT;
+                    if (pending_.empty()) {
+                        ParseMarkup(input.substr(markupBegin, i + 1 - markupBegin));
+                    } else {
+                        pending_.append(input.substr(0, i + 1));
+                        ParseMarkup(pending_);
+                        pending_.clear();
+                    }
+                }
+                break;
+            case State::QUOTE:
+                if (c == quote_) {
+                    state_ = State::MARKUP;
+                }
+                break;
+            case State::COMMENT:
+                if ((c == '>') && (commentDashes_ >= LISTING_COMMENT_CLOSE_DASHES)) {
+                    state_ = State::TEXT;
+                }
+                commentDashes_ = (c == '-') ? (commentDashes_ + 1) : 0;
+                break;
+            default:
+                break;
+        }
+    }
+
+    if ((state_ == State::MARKUP) || (state_ == State::QUOTE)) {
+        pending_.append(input.substr(markupBegin));
+        if (pending_.size() > LISTING_MAX_MARKUP_LENGTH) {
+            LOG_ERROR("%{public}s markup too long, dropped", __PRETTY_FUNCTION__);
+            pending_.clear();
+            state_ = State::TEXT;
+        }
+    }
+}
+
+const std::string &MceListingParser::Attribute(MceListingAttribute attribute) const
+{
+    return attributes_[static_cast<int>(attribute)];
+}
+
+int MceListingParser::AttributeAsInt(MceListingAttribute attribute) const
+{
+    const std::string &value = attributes_[static_cast<int>(attribute)];
+    return value.empty() ? 0 : atoi(value.c_str());
+}
+
+void MceListingParser::ParseMarkup(std::string_view markup)
+{
+    // strip '<' and '>'
+    std::string_view tag = markup.substr(1, markup.size() - 2);
+    if (tag.empty() || (tag[0] == '?') || (tag[0] == '!')) {
+        // declaration, doctype or CDATA
+        return;
+    }
+
+    if (tag[0] == '/') {
+        std::string_view name = tag.substr(1, tag.find_first_of(LISTING_SPACES) - 1);
+        if (depth_ > 0) {
+            depth_--;
+        }
+        handler_.OnElementEnd(InternElement(name), depth_);
+        return;
+    }
+
+    bool isEmptyElement = (tag.back() == '/');
+    if (isEmptyElement) {
+        tag.remove_suffix(1);
+    }
+    size_t nameEnd = tag.find_first_of(LISTING_SPACES);
+    MceListingElement element = InternElement(tag.substr(0, nameEnd));
+
+    for (int i = 0; attributeMask_ != 0; i++, attributeMask_ >>= 1) {
+        if (attributeMask_ & 1) {
+            attributes_[i].clear();
+        }
+    }
+    if (nameEnd != std::string_view::npos) {
+        ParseAttributes(tag.substr(nameEnd));
+    }
+
+    handler_.OnElementBegin(element, depth_, *this);
+    if (isEmptyElement) {
+        handler_.OnElementEnd(element, depth_);
+    } else {
+        depth_++;
+    }
+}
+
+void MceListingParser::ParseAttributes(std::string_view attributes)
+{
+    size_t pos = 0;
+    while (true) {
+        size_t nameBegin = attributes.find_first_not_of(LISTING_SPACES, pos);
+        if (nameBegin == std::string_view::npos) {
+            return;
+        }
+        size_t equal = attributes.find('=', nameBegin);
+        if (equal == std::string_view::npos) {
+            return;
+        }
+        size_t quote = attributes.find_first_not_of(LISTING_SPACES, equal + 1);
+        if ((quote == std::string_view::npos) || ((attributes[quote] != '"') && (attributes[quote] != '\''))) {
+            return;
+        }
+        size_t valueEnd = attributes.find(attributes[quote], quote + 1);
+        if (valueEnd == std::string_view::npos) {
+            return;
+        }
+        std::string_view name = attributes.substr(nameBegin, equal - nameBegin);
+        name = name.substr(0, name.find_first_of(LISTING_SPACES));
+        MceListingAttribute attribute = InternAttribute(name);
+        if (attribute != MceListingAttribute::MAX) {
+            int index = static_cast<int>(attribute);
+            Unescape(attributes.substr(quote + 1, valueEnd - quote - 1), attributes_[index]);
+            attributeMask_ |= (1ULL << index);
+        }
+        pos = valueEnd + 1;
+    }
+}
+
+void MceListingParser::Unescape(std::string_view value, std::string &out)
+{
+    size_t special = value.find_first_of("&\t\r\n");
+    if (special == std::string_view::npos) {
+        out.assign(value);
+        return;
+    }
+
+    out.assign(value.substr(0, special));
+    for (size_t i = special; i < value.size(); i++) {
+        char c = value[i];
+        if ((c == '\t') || (c == '\r') || (c == '\n')) {
+            // attribute value normalization
+            out += ' ';
+            continue;
+        }
+        if (c == '&') {
+            size_t semicolon = value.find(';', i + 1);
+            if ((semicolon != std::string_view::npos) &&
+                DecodeEntity(value.substr(i + 1, semicolon - i - 1), out)) {
+                i = semicolon;
+                continue;
+            }
+        }
+        out += c;
+    }
+}
+
+MceListingElement MceListingParser::InternElement(std::string_view name)
+{
+    static const std::unordered_map<std::string_view, MceListingElement> elements = {
+        {"MAP-msg-listing", MceListingElement::MSG_LISTING},
+        {"msg", MceListingElement::MSG},
+        {"MAP-convo-listing", MceListingElement::CONVO_LISTING},
+        {"conversation", MceListingElement::CONVERSATION},
+        {"participant", MceListingElement::PARTICIPANT},
+    };
+    auto it = elements.find(name);
+    return (it == elements.end()) ? MceListingElement::UNKNOWN : it->second;
+}
+
+MceListingAttribute MceListingParser::InternAttribute(std::string_view name)
+{
+    static const std::unordered_map<std::string_view, MceListingAttribute> attributes = {
+        {"version", MceListingAttribute::VERSION},
+        {"handle", MceListingAttribute::HANDLE},
+        {"subject", MceListingAttribute::SUBJECT},
+        {"datetime", MceListingAttribute::DATETIME},
+        {"sender_name", MceListingAttribute::SENDER_NAME},
+        {"sender_addressing", MceListingAttribute::SENDER_ADDRESSING},
+        {"replyto_addressing", MceListingAttribute::REPLYTO_ADDRESSING},
+        {"recipient_name", MceListingAttribute::RECIPIENT_NAME},
+        {"recipient_addressing", MceListingAttribute::RECIPIENT_ADDRESSING},
+        {"type", MceListingAttribute::TYPE},
+        {"receptionStatus", MceListingAttribute::RECEPTION_STATUS},
+        {"size", MceListingAttribute::SIZE},
+        {"attachment_size", MceListingAttribute::ATTACHMENT_SIZE},
+        {"text", MceListingAttribute::TEXT},
+        {"read", MceListingAttribute::READ},
+        {"sent", MceListingAttribute::SENT},
+        {"protected", MceListingAttribute::PROTECTED},
+        {"priority", MceListingAttribute::PRIORITY},
+        {"delivery_status", MceListingAttribute::DELIVERY_STATUS},
+        {"conversation_id", MceListingAttribute::CONVERSATION_ID},
+        {"conversation_name", MceListingAttribute::CONVERSATION_NAME},
+        {"direction", MceListingAttribute::DIRECTION},
+        {"attachment_mime_types", MceListingAttribute::ATTACHMENT_MIME_TYPES},
+        {"id", MceListingAttribute::ID},
+        {"name", MceListingAttribute::NAME},
+        {"last_activity", MceListingAttribute::LAST_ACTIVITY},
+        {"read_status", MceListingAttribute::READ_STATUS},
+        {"version_counter", MceListingAttribute::VERSION_COUNTER},
+        {"summary", MceListingAttribute::SUMMARY},
+        {"uci", MceListingAttribute::UCI},
+        {"display_name", MceListingAttribute::DISPLAY_NAME},
+        {"chat_state", MceListingAttribute::CHAT_STATE},
+        {"x_bt_uid", MceListingAttribute::X_BT_UID},
+        {"presence_availability", MceListingAttribute::PRESENCE_AVAILABILITY},
+        {"presence_text", MceListingAttribute::PRESENCE_TEXT},
+    };
+    auto it = attributes.find(name);
+    return (it == attributes.end()) ? MceListingAttribute::MAX : it->second;
+}
+}  // namespace bluetooth
@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @addtogroup Bluetooth
+ * @{
+ *
+ * @brief Defines map client listing parser object.
+ *
+ */
+
+/**
+ * @file map_mce_listing_parser.h
+ *
+ * @brief map client listing parser header file .
+ *
+ */
+
+#ifndef MAP_MCE_LISTING_PARSER_H
+#define MAP_MCE_LISTING_PARSER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "base_def.h"
+
+namespace bluetooth {
+/**
+ * @brief element names of the listing objects
+ */
+enum class MceListingElement : uint8_t {
+    MSG_LISTING = 0,   // MAP-msg-listing
+    MSG,               // msg
+    CONVO_LISTING,     // MAP-convo-listing
+    CONVERSATION,      // conversation
+    PARTICIPANT,       // participant
+    UNKNOWN
+};
+/**
+ * @brief attribute names of the listing objects
+ */
+enum class MceListingAttribute : uint8_t {
+    VERSION = 0,
+    HANDLE,
+    SUBJECT,
+    DATETIME,
+    SENDER_NAME,
+    SENDER_ADDRESSING,
+    REPLYTO_ADDRESSING,
+    RECIPIENT_NAME,
+    RECIPIENT_ADDRESSING,
+    TYPE,
+    RECEPTION_STATUS,
+    SIZE,
+    ATTACHMENT_SIZE,
+    TEXT,
+    READ,
+    SENT,
+    PROTECTED,
+    PRIORITY,
+    DELIVERY_STATUS,
+    CONVERSATION_ID,
+    CONVERSATION_NAME,
+    DIRECTION,
+    ATTACHMENT_MIME_TYPES,
+    ID,
+    NAME,
+    LAST_ACTIVITY,
+    READ_STATUS,
+    VERSION_COUNTER,
+    SUMMARY,
+    UCI,
+    DISPLAY_NAME,
+    CHAT_STATE,
+    X_BT_UID,
+    PRESENCE_AVAILABILITY,
+    PRESENCE_TEXT,
+    MAX
+};
+/**
+ * @brief Pull parser of the MAP listing objects
+ * The listing is fed in pieces as the OBEX packets arrive. Only the markup is parsed: element and attribute names
+ * are interned into enum IDs, attribute values are unescaped into strings reused for every element, text content is
+ * skipped. A tag split across two pieces is carried over to the next Feed().
+ */
+class MceListingParser {
+public:
+    /**
+     * @brief listing parser handler
+     */
+    class Handler {
+    public:
+        virtual ~Handler() = default;
+        /**
+         * @brief  element begin, the attributes are valid during the call
+         * @param  element          element name
+         * @param  depth            depth of the element, the root is 0
+         * @param  parser           parser to read the attributes from
+         */
+        virtual void OnElementBegin(MceListingElement element, int depth, const MceListingParser &parser) = 0;
+        /**
+         * @brief  element end
+         * @param  element          element name
+         * @param  depth            depth of the element, the root is 0
+         */
+        virtual void OnElementEnd(MceListingElement element, int depth) = 0;
+    };
+    /**
+     * @brief Construct a new Mce Listing Parser object
+     * @param  handler          handler of the elements
+     */
+    explicit MceListingParser(Handler &handler);
+    /**
+     * @brief Destroy the Mce Listing Parser object
+     */
+    ~MceListingParser();
+    /**
+     * @brief  Feed a piece of the listing object
+     * @param  data             data
+     * @param  len              data length
+     */
+    void Feed(const uint8_t *data, size_t len);
+    /**
+     * @brief Get the Attribute value of the current element
+     * @param  attribute        attribute name
+     * @return const std::string&  empty if the element has no such attribute
+     */
+    const std::string &Attribute(MceListingAttribute attribute) const;
+    /**
+     * @brief Get the Attribute value of the current element as int
+     * @param  attribute        attribute name
+     * @return int  0 if the element has no such attribute
+     */
+    int AttributeAsInt(MceListingAttribute attribute) const;
+
+private:
+    enum class State : uint8_t { TEXT, MARKUP, QUOTE, COMMENT };
+    /**
+     * @brief  Parse one complete markup, from '<' to '>'
+     * @param  markup           markup
+     */
+    void ParseMarkup(std::string_view markup);
+    /**
+     * @brief  Parse the attributes of a start tag
+     * @param  attributes       attribute list of the tag
+     */
+    void ParseAttributes(std::string_view attributes);
+    /**
+     * @brief  Unescape the entity references of an attribute value
+     * @param  value            raw value
+     * @param  out              unescaped value
+     */
+    static void Unescape(std::string_view value, std::string &out);
+    static MceListingElement InternElement(std::string_view name);
+    static MceListingAttribute InternAttribute(std::string_view name);
+    // element handler
+    Handler &handler_;
+    // scanner state
+    State state_ = State::TEXT;
+    // quote of the attribute value being scanned
+    char quote_ = 0;
+    // number of leading characters of the markup matching "<!--", or past the end if not a comment
+    size_t commentMatch_ = 0;
+    // number of '-' just before the current character in a comment
+    int commentDashes_ = 0;
+    // markup carried over from the previous piece
+    std::string pending_ {};
+    // depth of the next element
+    int depth_ = 0;
+    // attribute values of the current element
+    std::string attributes_[static_cast<int>(MceListingAttribute::MAX)] {};
+    // bit mask of the attributes set by the current element
+    uint64_t attributeMask_ = 0;
+
+    DISALLOW_COPY_AND_ASSIGN(MceListingParser);
+};
+}  // namespace bluetooth
+#endif  // MAP_MCE_LISTING_PARSER_H
@@ -15,8 +15,10 @@
 
 #include "map_mse_resource.h"
 #include <iomanip>
+#include <mutex>
 #include <sstream>
 #include <algorithm>
+#include "securec.h"
 
 namespace bluetooth {
 const std::string MapMseResource::XML_TAG_CONVO_LISTING = "MAP-convo-listing";
@@ -58,6 +60,7 @@ MapMseResource::MapMseResource(MapMseMnscli &mnsClient, utility::Dispatcher &dis
 {
     MSE_LOG_INFO("%{public}s Enter", __PRETTY_FUNCTION__);
     masId_ = instance_.GetMasId();
+    pool_ = std::make_shared<DataAccessPool>();
     observerMap_[masId_] = std::make_unique<EventObserver>(*this);
     for (auto iter = observerMap_.begin(); iter != observerMap_.end(); iter++) {
         stub::MapService::GetInstance()->RegisterObserver(
@@ -402,19 +405,16 @@ void MapMseResource::AddWhereSql(const MapMseParams &appParameter, std::string &
             }
         }
     }
-    sql.append(" order by m.datetime desc");
-    if (appParameter.maxListCount_ != 0x0) {
-        sql.append(" limit ?");
-        sql.append(" offset ?");
-    }
 }
 
-std::string MapMseResource::GetMsglistSql(const MapMseParams &appParameter, const std::string &folderName)
+std::string MapMseResource::GetMsglistSql(
+    const MapMseParams &appParameter, const std::string &folderName, bool countOnly)
 {
-    std::string sql = "select m.handle,m.subject,m.datetime,m.sender_name,m.sender_addressing,m.replyto_addressing,"
-          "m.recipient_name,m.recipient_addressing,m.type,m.size,m.text,m.reception_status,m.attachment_size,"
-          "m.priority,m.read,m.sent,m.protected,m.delivery_status,m.conversation_id,m.conversation_name,"
-          "m.direction,m.attachment_mime_types from MessageList m where 1 = 1";
+    std::string sql = countOnly ? "select m.read from MessageList m where 1 = 1" :
+        "select m.handle,m.subject,m.datetime,m.sender_name,m.sender_addressing,m.replyto_addressing,"
+        "m.recipient_name,m.recipient_addressing,m.type,m.size,m.text,m.reception_status,m.attachment_size,"
+        "m.priority,m.read,m.sent,m.protected,m.delivery_status,m.conversation_id,m.conversation_name,"
+        "m.direction,m.attachment_mime_types from MessageList m where 1 = 1";
     if (folderName != "") {
         sql.append(" and m.folder = ?");
     }
@@ -455,6 +455,17 @@ std::string MapMseResource::GetMsglistSql(const MapMseParams &appParameter, cons
         }
     }
     AddWhereSql(appParameter, sql);
+    // without MaxListCount the count covers every matching message, so it doesn't need the order
+    if (!countOnly || appParameter.maxListCount_ != 0x0) {
+        sql.append(" order by m.datetime desc");
+    }
+    if (appParameter.maxListCount_ != 0x0) {
+        sql.append(" limit ?");
+        sql.append(" offset ?");
+    }
+    if (countOnly) {
+        return "select count(*), ifnull(max(read = 0), 0) from (" + sql + ")";
+    }
     return sql;
 }
 
@@ -574,108 +585,6 @@ void MapMseResource::SetMsglistParam(
     }
 }
 
-std::vector<std::unique_ptr<MseMessageElement>> MapMseResource::GetMessageListContent(
-    const std::string &folderName, const MapMseParams &appParameter)
-{
-    std::vector<std::unique_ptr<MseMessageElement>> messageList;
-    auto dataProvider = DataAccess::GetConnection(DEFAULT_MAP_MSE_DB_FILE);
-    if (!dataProvider) {
-        return messageList;
-    }
-    std::string sql = GetMsglistSql(appParameter, folderName);
-    auto stmt = dataProvider->CreateStatement(sql);
-    if (!stmt) {
-        return messageList;
-    }
-    SetMsglistParam(*stmt, appParameter, folderName);
-    auto dataResult = stmt->Query();
-    while (dataResult->Next()) {
-        auto messageEle = std::make_unique<MseMessageElement>();
-        int index = 0;
-        messageEle->handle_ = dataResult->GetString(index++);
-        std::string subject = dataResult->GetString(index++);
-        if (appParameter.subjectLength_ != nullptr) {
-            std::size_t end = *appParameter.subjectLength_;
-            subject = subject.substr(0, end);
-        }
-        messageEle->subject_ = subject;
-        messageEle->dateTime_ = dataResult->GetString(index++);
-        messageEle->senderName_ = dataResult->GetString(index++);
-        messageEle->senderAddressing_ = dataResult->GetString(index++);
-        messageEle->replytoAddressing_ = dataResult->GetString(index++);
-        messageEle->recipientName_ = dataResult->GetString(index++);
-        messageEle->recipientAddressing_ = dataResult->GetString(index++);
-        messageEle->type_ = MessageType(dataResult->GetInt(index++));
-        messageEle->size_ = dataResult->GetInt(index++);
-        messageEle->text_ = (dataResult->GetInt(index++) == 1) ? "yes" : "no";
-        messageEle->receptionStatus_ = dataResult->GetString(index++);
-        messageEle->attachmentSize_ = dataResult->GetInt(index++);
-        messageEle->priority_ = (dataResult->GetInt(index++) == 1) ? "yes" : "no";
-        messageEle->read_ = (dataResult->GetInt(index++) == 1) ? true : false;
-        messageEle->sent_ = (dataResult->GetInt(index++) == 1) ? "yes" : "no";
-        messageEle->protected_ = (dataResult->GetInt(index++) == 1) ? "yes" : "no";
-        messageEle->deliveryStatus_ = dataResult->GetString(index++);  // Messages-Listing Format Version 1.1
-        messageEle->conversationId_ = dataResult->GetString(index++);
-        messageEle->conversationName_ = dataResult->GetString(index++);
-        messageEle->direction_ = dataResult->GetString(index++);
-        messageEle->attachmentMimeTypes_ = dataResult->GetString(index++);
-        messageList.push_back(std::move(messageEle));
-    }
-    return messageList;
-}
-
-std::string MapMseResource::GetBodyXml(const std::string &folderName, const MapMseParams &appParameter,
-    const std::string &version, uint16_t &listSize, uint8_t &unRead)
-{
-    auto messageList = GetMessageListContent(folderName, appParameter);
-    listSize = messageList.size();
-    if (listSize == 0) {
-        return "";
-    }
-    return GetPrivateBodyXml(messageList, version, unRead, appParameter.parameterMask_);
-}
-
-void MapMseResource::AddVer10Node(xmlNodePtr &node, MseMessageElement &msg, uint8_t &unRead, long paraMask)
-{
-    xmlNewProp(node, BAD_CAST "handle", BAD_CAST msg.handle_.c_str());
-    if (CheckParameterMask(SUBJECT_MASK, msg.subject_, paraMask, true))
-        xmlNewProp(node, BAD_CAST "subject", BAD_CAST msg.subject_.c_str());
-    if (CheckParameterMask(DATETIME_MASK, msg.dateTime_, paraMask, true))
-        xmlNewProp(node, BAD_CAST "datetime", BAD_CAST msg.dateTime_.c_str());
-    if (CheckParameterMask(SENDER_NAME_MASK, msg.senderName_, paraMask))
-        xmlNewProp(node, BAD_CAST "sender_name", BAD_CAST msg.senderName_.c_str());
-    if (CheckParameterMask(SENDER_ADDRESSING_MASK, msg.senderAddressing_, paraMask))
-        xmlNewProp(node, BAD_CAST "sender_addressing", BAD_CAST msg.senderAddressing_.c_str());
-    if (CheckParameterMask(REPLYTO_ADDRESSING, msg.replytoAddressing_, paraMask))
-        xmlNewProp(node, BAD_CAST "replyto_addressing", BAD_CAST msg.replytoAddressing_.c_str());
-    if (CheckParameterMask(RECIPIENT_NAME_MASK, msg.recipientName_, paraMask))
-        xmlNewProp(node, BAD_CAST "recipient_name", BAD_CAST msg.recipientName_.c_str());
-    if (CheckParameterMask(RECIPIENT_ADDRESSING_MASK, msg.recipientAddressing_, paraMask, true))
-        xmlNewProp(node, BAD_CAST "recipient_addressing", BAD_CAST msg.recipientAddressing_.c_str());
-    if (static_cast<int>(msg.type_) > 0) {
-        if (CheckParameterMask(TYPE_MASK, std::to_string(static_cast<int>(msg.type_)), paraMask, true))
-            xmlNewProp(node, BAD_CAST "type", BAD_CAST ChangeType(msg.type_).c_str());
-    }
-    if (CheckParameterMask(SIZE_MASK, std::to_string(msg.size_), paraMask, true))
-        xmlNewProp(node, BAD_CAST "size", BAD_CAST std::to_string(msg.size_).c_str());
-    if (CheckParameterMask(TEXT_MASK, msg.text_, paraMask))
-        xmlNewProp(node, BAD_CAST "text", BAD_CAST msg.text_.c_str());
-    if (CheckParameterMask(RECEPTION_STATUS_MASK, msg.receptionStatus_, paraMask, true))
-        xmlNewProp(node, BAD_CAST "reception_status", BAD_CAST msg.receptionStatus_.c_str());
-    if (CheckParameterMask(ATTACHMENT_SIZE_MASK, std::to_string(msg.attachmentSize_), paraMask, true))
-        xmlNewProp(node, BAD_CAST "attachment_size", BAD_CAST std::to_string(msg.attachmentSize_).c_str());
-    if (CheckParameterMask(PRIORITY_MASK, msg.priority_, paraMask))
-        xmlNewProp(node, BAD_CAST "priority", BAD_CAST msg.priority_.c_str());
-    std::string read = msg.read_ ? "yes" : "no";
-    unRead = msg.read_ ? 0 : 1;
-    if (CheckParameterMask(READ_MASK, read, paraMask))
-        xmlNewProp(node, BAD_CAST "read", BAD_CAST read.c_str());
-    if (CheckParameterMask(SENT_MASK, msg.sent_, paraMask))
-        xmlNewProp(node, BAD_CAST "sent", BAD_CAST msg.sent_.c_str());
-    if (CheckParameterMask(PROTECTED_MASK, msg.protected_, paraMask))
-        xmlNewProp(node, BAD_CAST "protected", BAD_CAST msg.protected_.c_str());
-}
-
 std::string MapMseResource::ChangeType(MessageType type)
 {
     if (MessageType::EMAIL == type) {
@@ -693,44 +602,6 @@ std::string MapMseResource::ChangeType(MessageType type)
     }
 }
 
-std::string MapMseResource::GetPrivateBodyXml(std::vector<std::unique_ptr<MseMessageElement>> &messageList,
-    const std::string &version, uint8_t &unRead, long paraMask)
-{
-    xmlChar *xmlbuff;
-    int buffersize;
-    std::ostringstream oss;
-
-    xmlDocPtr doc = xmlNewDoc(BAD_CAST MAP_V10.c_str());
-    xmlNodePtr root_node = xmlNewNode(NULL, BAD_CAST "MAP-msg-listing");
-    xmlDocSetRootElement(doc, root_node);
-    xmlNewProp(root_node, BAD_CAST "version", BAD_CAST version.c_str());
-
-    for (auto &iter : messageList) {
-        xmlNodePtr node = xmlNewNode(NULL, BAD_CAST"msg");
-        xmlAddChild(root_node, node);
-
-        AddVer10Node(node, *iter, unRead, paraMask);
-        if (MAP_V11 == version) {
-            if (CheckParameterMask(DELIVERY_STATUS_MASK, iter->deliveryStatus_, paraMask))
-                xmlNewProp(node, BAD_CAST"delivery_status", BAD_CAST iter->deliveryStatus_.c_str());
-            if (CheckParameterMask(CONVERSATION_ID_MASK, iter->conversationId_, paraMask, true))
-                xmlNewProp(node, BAD_CAST"conversation_id", BAD_CAST iter->conversationId_.c_str());
-            if (CheckParameterMask(CONVERSATION_NAME_MASK, iter->conversationName_, paraMask))
-                xmlNewProp(node, BAD_CAST"conversation_name", BAD_CAST iter->conversationName_.c_str());
-            if (CheckParameterMask(DIRECTION_MASK, iter->direction_, paraMask, true))
-                xmlNewProp(node, BAD_CAST"direction", BAD_CAST iter->direction_.c_str());
-            if (CheckParameterMask(ATTACHMENT_NIME_MASK, iter->attachmentMimeTypes_, paraMask))
-                xmlNewProp(node, BAD_CAST"attachment_mime_types", BAD_CAST iter->attachmentMimeTypes_.c_str());
-        }
-    }
-    xmlDocDumpFormatMemory(doc, &xmlbuff, &buffersize, 1);
-    oss << xmlbuff;
-    xmlFree(xmlbuff);
-    xmlFreeDoc(doc);
-
-    return oss.str();
-}
-
 bool MapMseResource::CheckParameterMask(uint32_t mask, std::string para, long paraMask, bool required)
 {
     if (para.size() > 0) {
@@ -746,16 +617,290 @@ bool MapMseResource::CheckParameterMask(uint32_t mask, std::string para, long pa
     return false;
 }
 
-void MapMseResource::GetListingSize(
+// Statements of the message database kept open for the instance, so a listing request neither opens the database
+// nor prepares its query again.
+class MapMseResource::DataAccessPool {
+public:
+    DataAccessPool() = default;
+    ~DataAccessPool() = default;
+
+    std::unique_ptr<IDataStatement> Acquire(const std::string &sql)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = idle_.find(sql);
+        if (it != idle_.end()) {
+            auto stmt = std::move(it->second);
+            idle_.erase(it);
+            return stmt;
+        }
+        if (!dataAccess_) {
+            dataAccess_ = DataAccess::GetConnection(DEFAULT_MAP_MSE_DB_FILE);
+            if (!dataAccess_) {
+                MSE_LOG_ERROR("can't open %{public}s", DEFAULT_MAP_MSE_DB_FILE.c_str());
+                return nullptr;
+            }
+        }
+        return dataAccess_->CreateStatement(sql);
+    }
+
+    void Release(const std::string &sql, std::unique_ptr<IDataStatement> stmt)
+    {
+        if (!stmt) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (idle_.size() >= MAX_IDLE_STATEMENTS) {
+            idle_.erase(idle_.begin());
+        }
+        idle_.emplace(sql, std::move(stmt));
+    }
+
+private:
+    static const size_t MAX_IDLE_STATEMENTS = 8;
+    std::mutex mutex_ {};
+    // declared before idle_, the statements must be released before their connection
+    std::unique_ptr<DataAccess> dataAccess_ {};
+    std::unordered_multimap<std::string, std::unique_ptr<IDataStatement>> idle_ {};
+    DISALLOW_COPY_AND_ASSIGN(DataAccessPool);
+};
+
+// Messages listing written from the query cursor when OBEX asks for the next packet, so the folder is never held
+// in memory. At most one msg element is buffered.
+class MapMseResource::MessageListingBody : public ObexBodyObject {
+public:
+    MessageListingBody(std::shared_ptr<DataAccessPool> pool, const std::string &sql,
+        std::unique_ptr<IDataStatement> stmt, const MapMseParams &appParameter, const std::string &version)
+        : pool_(std::move(pool)), sql_(sql), stmt_(std::move(stmt)), version_(version),
+          paraMask_(appParameter.parameterMask_)
+    {
+        if (appParameter.subjectLength_ != nullptr) {
+            subjectLength_ = *appParameter.subjectLength_;
+        }
+        result_ = stmt_->Query();
+        pending_ = "<?xml version=\"1.0\"?>\n<MAP-msg-listing version=\"";
+        AppendEscaped(pending_, version_);
+        pending_.append("\">\n");
+    }
+    ~MessageListingBody() override
+    {
+        Finish();
+    }
+
+    size_t Read(uint8_t *buf, size_t bufLen) override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t readSize = 0;
+        while (readSize < bufLen) {
+            if (pendingIndex_ >= pending_.size() && !FillPending()) {
+                break;
+            }
+            size_t copySize = std::min(bufLen - readSize, pending_.size() - pendingIndex_);
+            if (memcpy_s(buf + readSize, bufLen - readSize, pending_.data() + pendingIndex_, copySize) != EOK) {
+                MSE_LOG_ERROR("memcpy_s failed");
+                break;
+            }
+            readSize += copySize;
+            pendingIndex_ += copySize;
+        }
+        return readSize;
+    }
+
+    size_t Write(const uint8_t *buf, size_t bufLen) override
+    {
+        return 0;
+    }
+
+    int Close() override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Finish();
+        pending_.clear();
+        pendingIndex_ = 0;
+        return 0;
+    }
+
+private:
+    bool FillPending()
+    {
+        pending_.clear();
+        pendingIndex_ = 0;
+        if (finished_) {
+            return false;
+        }
+        if (result_ && result_->Next()) {
+            AppendMessage(*result_);
+        } else {
+            pending_ = "</MAP-msg-listing>\n";
+            Finish();
+        }
+        return true;
+    }
+
+    // return the statement to the pool as soon as the listing is over
+    void Finish()
+    {
+        if (finished_) {
+            return;
+        }
+        finished_ = true;
+        result_ = nullptr;
+        pool_->Release(sql_, std::move(stmt_));
+    }
+
+    void AppendMessage(IDataResult &row)
+    {
+        int index = 0;
+        std::string handle = row.GetString(index++);
+        std::string subject = row.GetString(index++).substr(0, subjectLength_);
+        std::string dateTime = row.GetString(index++);
+        std::string senderName = row.GetString(index++);
+        std::string senderAddressing = row.GetString(index++);
+        std::string replytoAddressing = row.GetString(index++);
+        std::string recipientName = row.GetString(index++);
+        std::string recipientAddressing = row.GetString(index++);
+        int type = row.GetInt(index++);
+        std::string size = std::to_string(row.GetInt(index++));
+        std::string text = (row.GetInt(index++) == 1) ? "yes" : "no";
+        std::string receptionStatus = row.GetString(index++);
+        std::string attachmentSize = std::to_string(row.GetInt(index++));
+        std::string priority = (row.GetInt(index++) == 1) ? "yes" : "no";
+        std::string read = (row.GetInt(index++) == 1) ? "yes" : "no";
+        std::string sent = (row.GetInt(index++) == 1) ? "yes" : "no";
+        std::string protect = (row.GetInt(index++) == 1) ? "yes" : "no";
+
+        pending_.append("  <msg");
+        AppendAttribute("handle", handle);
+        AppendAttribute(SUBJECT_MASK, "subject", subject, true);
+        AppendAttribute(DATETIME_MASK, "datetime", dateTime, true);
+        AppendAttribute(SENDER_NAME_MASK, "sender_name", senderName);
+        AppendAttribute(SENDER_ADDRESSING_MASK, "sender_addressing", senderAddressing);
+        AppendAttribute(REPLYTO_ADDRESSING, "replyto_addressing", replytoAddressing);
+        AppendAttribute(RECIPIENT_NAME_MASK, "recipient_name", recipientName);
+        AppendAttribute(RECIPIENT_ADDRESSING_MASK, "recipient_addressing", recipientAddressing, true);
+        if (type > 0 && CheckParameterMask(TYPE_MASK, std::to_string(type), paraMask_, true)) {
+            AppendAttribute("type", ChangeType(MessageType(type)));
+        }
+        AppendAttribute(SIZE_MASK, "size", size, true);
+        AppendAttribute(TEXT_MASK, "text", text);
+        AppendAttribute(RECEPTION_STATUS_MASK, "reception_status", receptionStatus, true);
+        AppendAttribute(ATTACHMENT_SIZE_MASK, "attachment_size", attachmentSize, true);
+        AppendAttribute(PRIORITY_MASK, "priority", priority);
+        AppendAttribute(READ_MASK, "read", read);
+        AppendAttribute(SENT_MASK, "sent", sent);
+        AppendAttribute(PROTECTED_MASK, "protected", protect);
+        if (MAP_V11 == version_) {
+            // Messages-Listing Format Version 1.1
+            AppendAttribute(DELIVERY_STATUS_MASK, "delivery_status", row.GetString(index++));
+            AppendAttribute(CONVERSATION_ID_MASK, "conversation_id", row.GetString(index++), true);
+            AppendAttribute(CONVERSATION_NAME_MASK, "conversation_name", row.GetString(index++));
+            AppendAttribute(DIRECTION_MASK, "direction", row.GetString(index++), true);
+            AppendAttribute(ATTACHMENT_NIME_MASK, "attachment_mime_types", row.GetString(index++));
+        }
+        pending_.append("/>\n");
+    }
+
+    void AppendAttribute(uint32_t mask, const char *name, const std::string &value, bool required = false)
+    {
+        if (CheckParameterMask(mask, value, paraMask_, required)) {
+            AppendAttribute(name, value);
+        }
+    }
+
+    void AppendAttribute(const char *name, const std::string &value)
+    {
+        pending_.append(" ").append(name).append("=\"");
+        AppendEscaped(pending_, value);
+        pending_.append("\"");
+    }
+
+    static void AppendEscaped(std::string &xml, const std::string &value)
+    {
+        for (char c : value) {
+            switch (c) {
+                case '&':
+                    xml.append("&amp;");
+                    break;
+                case '<':
+                    xml.append("&lt;");
+                    break;
+                case '>':
+                    xml.append("&gt;");
+                    break;
+                case '"':
+                    xml.append("&quot;");
+                    break;
+                case '\n':
+                    xml.append("&#10;");
+                    break;
+                case '\r':
+                    xml.append("&#13;");
+                    break;
+                case '\t':
+                    xml.append("&#9;");
+                    break;
+                default:
+                    xml.push_back(c);
+                    break;
+            }
+        }
+    }
+
+    // declared before stmt_ and result_, they must be released before the pool
+    std::shared_ptr<DataAccessPool> pool_ {};
+    std::string sql_ {};
+    std::unique_ptr<IDataStatement> stmt_ {};
+    std::unique_ptr<IDataResult> result_ {};
+    std::string version_ {};
+    long paraMask_ = -1;
+    size_t subjectLength_ = std::string::npos;
+    bool finished_ = false;
+    std::string pending_ {};
+    size_t pendingIndex_ = 0;
+    std::mutex mutex_ {};
+    DISALLOW_COPY_AND_ASSIGN(MessageListingBody);
+};
+
+bool MapMseResource::CountMessageList(
     const std::string &folderName, const MapMseParams &appParameter, uint16_t &listSize, uint8_t &unRead)
 {
-    auto messagesList = GetMessageListContent(folderName, appParameter);
-    listSize = messagesList.size();
-    bool isExist = std::any_of(messagesList.begin(), messagesList.end(),
-        [](const std::unique_ptr<bluetooth::MseMessageElement>& item) {return !item->read_;});
-    if (isExist) {
-        unRead = 1;
+    std::string sql = GetMsglistSql(appParameter, folderName, true);
+    auto stmt = pool_->Acquire(sql);
+    if (!stmt) {
+        return false;
+    }
+    SetMsglistParam(*stmt, appParameter, folderName);
+    bool ret = false;
+    {
+        auto dataResult = stmt->Query();
+        if (dataResult && dataResult->Next()) {
+            listSize = static_cast<uint16_t>(std::min(dataResult->GetInt(0), static_cast<int>(UINT16_MAX)));
+            unRead = (dataResult->GetInt(1) != 0) ? 1 : 0;
+            ret = true;
+        }
+    }
+    pool_->Release(sql, std::move(stmt));
+    return ret;
+}
+
+std::shared_ptr<ObexBodyObject> MapMseResource::GetListingBody(const std::string &folderName,
+    const MapMseParams &appParameter, const std::string &version, uint16_t &listSize, uint8_t &unRead)
+{
+    if (!CountMessageList(folderName, appParameter, listSize, unRead) || listSize == 0) {
+        return nullptr;
+    }
+    std::string sql = GetMsglistSql(appParameter, folderName, false);
+    auto stmt = pool_->Acquire(sql);
+    if (!stmt) {
+        return nullptr;
     }
+    SetMsglistParam(*stmt, appParameter, folderName);
+    return std::make_shared<MessageListingBody>(pool_, sql, std::move(stmt), appParameter, version);
+}
+
+void MapMseResource::GetListingSize(
+    const std::string &folderName, const MapMseParams &appParameter, uint16_t &listSize, uint8_t &unRead)
+{
+    CountMessageList(folderName, appParameter, listSize, unRead);
 }
 
 std::string MapMseResource::GetMessage(
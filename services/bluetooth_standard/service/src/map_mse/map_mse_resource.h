@@ -17,9 +17,11 @@
 #define MAP_MSE_RESOURCE_H
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
+#include "../obex/obex_body.h"
 #include "data_access.h"
 #include "dispatcher.h"
 #include "log.h"
@@ -31,33 +33,6 @@
 #include "stub/map_service.h"
 
 namespace bluetooth {
-struct MseMessageElement {
-    // Messages-Listing Format Version 1.0
-    std::string handle_ = "";
-    std::string subject_ = "";
-    std::string dateTime_ = "";
-    std::string senderName_ = "";
-    std::string senderAddressing_ = "";
-    std::string replytoAddressing_ = "";
-    std::string recipientName_ = "";
-    std::string recipientAddressing_ = "";
-    MessageType type_ = MessageType::NONE;
-    int size_ = -1;
-    std::string text_ = "";
-    std::string receptionStatus_ = "";
-    int attachmentSize_ = -1;
-    std::string priority_ = "";
-    bool read_ = false;
-    std::string sent_ = "";
-    std::string protected_ = "";
-    // Messages-Listing Format Version 1.1
-    std::string deliveryStatus_ = "";
-    std::string conversationId_ = "";
-    std::string conversationName_ = "";
-    std::string direction_ = "";
-    std::string attachmentMimeTypes_ = "";
-    bool msgTypeAppParamSet_ = false;
-};
 struct MseParticipant {
     std::string uci_ = "";
     std::string name_ = "";
@@ -83,7 +58,8 @@ class MapMseResource {
 public:
     explicit MapMseResource(MapMseMnscli &mnsClient, utility::Dispatcher &dispatcher, MapMseInstance &instance);
     virtual ~MapMseResource();
-    std::string GetBodyXml(const std::string &folderName, const MapMseParams &appParameter,
+    // Messages listing streamed from the database as OBEX reads it, nullptr if no message matches.
+    std::shared_ptr<ObexBodyObject> GetListingBody(const std::string &folderName, const MapMseParams &appParameter,
         const std::string &version, uint16_t &listSize, uint8_t &unRead);
     void GetListingSize(
         const std::string &folderName, const MapMseParams &appParameter, uint16_t &listSize, uint8_t &unRead);
@@ -192,13 +168,16 @@ private:
     static const uint32_t FILTER_MASK_PARTICIPANT_CHATSTATE_CHANGED = 1 << 12;
     static const uint32_t FILTER_MASK_EXTENDED_DATA_CHANGED = 1 << 13;
     static const uint32_t FILTER_MASK_MESSAGE_REMOVED = 1 << 14;
-    std::string GetMsglistSql(const MapMseParams &appParameter, const std::string &folderName);
+    class DataAccessPool;
+    class MessageListingBody;
+    // countOnly selects the number of matching messages and whether any of them is unread.
+    static std::string GetMsglistSql(const MapMseParams &appParameter, const std::string &folderName, bool countOnly);
     static void AddWhereSql(const MapMseParams &appParameter, std::string &sql);
     static void SetContacts(IDataStatement &ids, const MapMseParams &appParameter, int &index);
     static std::vector<int> GetMsgTypeParam(uint8_t mask);
     void SetMsglistParam(IDataStatement &ids, const MapMseParams &appParameter, const std::string &folderName);
-    std::vector<std::unique_ptr<MseMessageElement>> GetMessageListContent(
-        const std::string &folderName, const MapMseParams &appParameter);
+    bool CountMessageList(
+        const std::string &folderName, const MapMseParams &appParameter, uint16_t &listSize, uint8_t &unRead);
     static std::vector<MapMseVcard> GetVCardData(
         std::unique_ptr<DataAccess> &dataAccess, const std::string handle, const int isOriginator = 0);
     static std::string GetCvslistSql(const MapMseParams &appParameter);
@@ -209,10 +188,7 @@ private:
     std::vector<MseParticipant> GetParticipantContent(
         IDataStatement &ids, const MapMseParams &appParameter, const std::string &convoId);
     std::vector<std::unique_ptr<MseConvoLstElement>> GetConvoLstContent(const MapMseParams &appParameter);
-    void AddVer10Node(xmlNodePtr &node, MseMessageElement &msg, uint8_t &unRead, long paraMask);
     static std::string ChangeType(MessageType type);
-    std::string GetPrivateBodyXml(std::vector<std::unique_ptr<MseMessageElement>> &messageList,
-        const std::string &version, uint8_t &unRead, long paraMask);
     static bool CheckParameterMask(uint32_t mask, std::string para, long paraMask, bool required = false);
     void ParticipantsToXml(xmlNodePtr &node, std::vector<MseParticipant> &contacts, long paraMask);
     void SendEventReport(const std::string &addr, const std::string &event, const std::string &type);
@@ -220,6 +196,7 @@ private:
     MapMseMnscli *mnsClient_ = nullptr;
     utility::Dispatcher &dispatcher_;
     MapMseInstance &instance_;
+    std::shared_ptr<DataAccessPool> pool_ {};
     uint8_t masId_ = 0;
     std::atomic_uint8_t reportVersion_ = 0x0;
     std::unordered_map<std::string, uint32_t> eventFilterMaskMap_ {};
@@ -574,12 +574,7 @@ void MapMseServer::GetMessageListing(ObexServerSession &session, const ObexHeade
     if (appParams->maxListCount_ == 0x0) {
         content_.GetListingSize(name, *appParams, listingSize, unMessage);
     } else {
-        auto body = content_.GetBodyXml(name, *appParams, messageListingVersion_, listingSize, unMessage);
-        MSE_LOG_INFO("body : %{public}s ", body.c_str());
-        if (body != "") {
-            bodyObj = std::make_shared<ObexArrayBodyObject>();
-            bodyObj->Write((uint8_t *)body.data(), body.size());
-        }
+        bodyObj = content_.GetListingBody(name, *appParams, messageListingVersion_, listingSize, unMessage);
     }
     ObexTlvParamters obexAppPrarams;
     CreateOutputAppPrarams(obexAppPrarams, listingSize, unMessage);
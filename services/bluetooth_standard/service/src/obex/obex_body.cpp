@@ -14,12 +14,36 @@
  */
 
 #include "obex_body.h"
+#include <cerrno>
 #include <cstring>
+#include <fcntl.h>
 #include <memory>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "log.h"
 #include "obex_types.h"
+#include "securec.h"
 
 namespace bluetooth {
+Buffer *ObexBodyObject::ReadBuffer(size_t bufLen)
+{
+    if (bufLen == 0) {
+        return nullptr;
+    }
+    Buffer *buffer = BufferMalloc(bufLen);
+    if (buffer == nullptr) {
+        return nullptr;
+    }
+    size_t readSize = Read(static_cast<uint8_t *>(BufferPtr(buffer)), bufLen);
+    if (readSize >= bufLen) {
+        return buffer;
+    }
+    Buffer *slice = (readSize == 0) ? nullptr : BufferSliceMalloc(buffer, 0, readSize);
+    BufferFree(buffer);
+    return slice;
+}
+
 ObexArrayBodyObject::ObexArrayBodyObject(const uint8_t *buf, size_t bufLen)
 {
     auto ret = PrivateWrite(buf, bufLen);
@@ -36,8 +60,9 @@ size_t ObexArrayBodyObject::Read(uint8_t *buf, size_t bufLen)
     if (remainSize < readSize) {
         readSize = remainSize;
     }
-    for (size_t i = 0; i < readSize; i++) {
-        buf[i] = body_[index_++];
+    if (readSize > 0) {
+        (void)memcpy_s(buf, bufLen, &body_[index_], readSize);
+        index_ += readSize;
     }
     OBEX_LOG_DEBUG("ObexArrayBodyObject::Read: %zu / %zu", index_, body_.size());
     return readSize;
@@ -60,4 +85,159 @@ int ObexArrayBodyObject::Close()
     std::lock_guard<std::mutex> lock(mutex_);
     return 0;
 }
-}  // namespace bluetooth
\ No newline at end of file
+
+// ObexFileBodyObject
+ObexFileBodyObject::ObexFileBodyObject(const std::string &file, Mode mode)
+{
+    int flags = (mode == Mode::READ) ? O_RDONLY : (O_WRONLY | O_CREAT | O_TRUNC);
+    const mode_t fileMode = 0660;
+    fd_ = open(file.c_str(), flags | O_CLOEXEC, fileMode);
+    if (fd_ < 0) {
+        OBEX_LOG_ERROR("%{public}s, open %{public}s failed, errno=%{public}d", __PRETTY_FUNCTION__, file.c_str(), errno);
+    }
+}
+
+ObexFileBodyObject::ObexFileBodyObject(int fd, bool ownFd) : fd_(fd), ownFd_(ownFd)
+{
+    off_t offset = lseek(fd_, 0, SEEK_CUR);
+    offset_ = (offset < 0) ? 0 : offset;
+}
+
+ObexFileBodyObject::~ObexFileBodyObject()
+{
+    Close();
+}
+
+size_t ObexFileBodyObject::Read(uint8_t *buf, size_t bufLen)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fd_ < 0) {
+        return 0;
+    }
+    // A short read means the end of the body to the sender, so read until the buffer is full or the file ends.
+    size_t readSize = 0;
+    while (readSize < bufLen) {
+        ssize_t ret = pread(fd_, buf + readSize, bufLen - readSize, offset_);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret <= 0) {
+            if (ret < 0) {
+                OBEX_LOG_ERROR("%{public}s, pread failed, errno=%{public}d", __PRETTY_FUNCTION__, errno);
+            }
+            break;
+        }
+        readSize += static_cast<size_t>(ret);
+        offset_ += ret;
+    }
+    OBEX_LOG_DEBUG("ObexFileBodyObject::Read: %zu, offset %{public}lld", readSize, static_cast<long long>(offset_));
+    return readSize;
+}
+
+size_t ObexFileBodyObject::Write(const uint8_t *buf, size_t bufLen)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fd_ < 0) {
+        OBEX_LOG_ERROR("%{public}s, file is not opened", __PRETTY_FUNCTION__);
+        return 0;
+    }
+    size_t writeSize = 0;
+    while (writeSize < bufLen) {
+        ssize_t ret = pwrite(fd_, buf + writeSize, bufLen - writeSize, offset_);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret <= 0) {
+            OBEX_LOG_ERROR("%{public}s, pwrite failed, errno=%{public}d", __PRETTY_FUNCTION__, errno);
+            break;
+        }
+        writeSize += static_cast<size_t>(ret);
+        offset_ += ret;
+    }
+    return writeSize;
+}
+
+int ObexFileBodyObject::Close()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    int ret = 0;
+    if (fd_ >= 0 && ownFd_) {
+        ret = close(fd_);
+    }
+    fd_ = -1;
+    return ret;
+}
+
+bool ObexFileBodyObject::IsOpen() const
+{
+    return fd_ >= 0;
+}
+
+// ObexMmapBodyObject
+ObexMmapBodyObject::ObexMmapBodyObject(const std::string &file)
+{
+    int fd = open(file.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        OBEX_LOG_ERROR("%{public}s, open %{public}s failed, errno=%{public}d", __PRETTY_FUNCTION__, file.c_str(), errno);
+        return;
+    }
+    struct stat st = {};
+    if ((fstat(fd, &st) == 0) && (st.st_size > 0)) {
+        void *data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+            data_ = static_cast<uint8_t *>(data);
+            size_ = static_cast<size_t>(st.st_size);
+            // The body is sent front to back once, let the kernel read ahead and drop pages behind.
+            (void)madvise(data_, size_, MADV_SEQUENTIAL);
+        } else {
+            OBEX_LOG_ERROR("%{public}s, mmap failed, errno=%{public}d", __PRETTY_FUNCTION__, errno);
+        }
+    }
+    close(fd);
+}
+
+ObexMmapBodyObject::~ObexMmapBodyObject()
+{
+    Close();
+}
+
+size_t ObexMmapBodyObject::Read(uint8_t *buf, size_t bufLen)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t readSize = bufLen;
+    size_t remainSize = size_ - index_;
+    if (remainSize < readSize) {
+        readSize = remainSize;
+    }
+    if (readSize > 0) {
+        (void)memcpy_s(buf, bufLen, data_ + index_, readSize);
+        index_ += readSize;
+    }
+    OBEX_LOG_DEBUG("ObexMmapBodyObject::Read: %zu / %zu", index_, size_);
+    return readSize;
+}
+
+size_t ObexMmapBodyObject::Write(const uint8_t *buf, size_t bufLen)
+{
+    OBEX_LOG_ERROR("%{public}s, read-only body object", __PRETTY_FUNCTION__);
+    return 0;
+}
+
+int ObexMmapBodyObject::Close()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    int ret = 0;
+    if (data_ != nullptr) {
+        ret = munmap(data_, size_);
+        data_ = nullptr;
+    }
+    size_ = 0;
+    index_ = 0;
+    return ret;
+}
+
+bool ObexMmapBodyObject::IsOpen() const
+{
+    return data_ != nullptr;
+}
+}  // namespace bluetooth
@@ -19,7 +19,11 @@
 #include <cstdint>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <vector>
+#include <sys/types.h>
+#include "base_def.h"
+#include "buffer.h"
 
 namespace bluetooth {
 class ObexBodyObject {
@@ -28,6 +32,9 @@ public:
     virtual size_t Read(uint8_t *buf, size_t bufLen) = 0;
     virtual size_t Write(const uint8_t *buf, size_t bufLen) = 0;
     virtual int Close() = 0;
+    // Read up to bufLen bytes into a new buffer, which is attached to the outgoing packet without copy.
+    // Returns nullptr when no more data.
+    virtual Buffer *ReadBuffer(size_t bufLen);
 };
 
 class ObexArrayBodyObject : public ObexBodyObject {
@@ -45,5 +52,45 @@ private:
     size_t index_ = 0;
     std::mutex mutex_ {};
 };
+
+// Body object backed by a file descriptor, the object is streamed by pread/pwrite and never held in memory.
+class ObexFileBodyObject : public ObexBodyObject {
+public:
+    enum class Mode : uint8_t { READ, WRITE };
+    // Open a file, WRITE creates or truncates it.
+    explicit ObexFileBodyObject(const std::string &file, Mode mode = Mode::WRITE);
+    // Use an opened file descriptor from its current offset, ownFd closes it with the object.
+    ObexFileBodyObject(int fd, bool ownFd);
+    virtual ~ObexFileBodyObject();
+    size_t Read(uint8_t *buf, size_t bufLen) override;
+    size_t Write(const uint8_t *buf, size_t bufLen) override;
+    int Close() override;
+    bool IsOpen() const;
+
+private:
+    int fd_ = -1;
+    bool ownFd_ = true;
+    off_t offset_ = 0;
+    std::mutex mutex_ {};
+    DISALLOW_COPY_AND_ASSIGN(ObexFileBodyObject);
+};
+
+// Read-only body object that maps the whole file, Read is a plain memcpy from the mapping.
+class ObexMmapBodyObject : public ObexBodyObject {
+public:
+    explicit ObexMmapBodyObject(const std::string &file);
+    virtual ~ObexMmapBodyObject();
+    size_t Read(uint8_t *buf, size_t bufLen) override;
+    size_t Write(const uint8_t *buf, size_t bufLen) override;
+    int Close() override;
+    bool IsOpen() const;
+
+private:
+    uint8_t *data_ = nullptr;
+    size_t size_ = 0;
+    size_t index_ = 0;
+    std::mutex mutex_ {};
+    DISALLOW_COPY_AND_ASSIGN(ObexMmapBodyObject);
+};
 }  // namespace bluetooth
 #endif  // OBEX_BODY_H
@@ -451,6 +451,16 @@ void ObexHeader::AppendBytes(const uint8_t headerId, const uint8_t *byteBuf, con
     Append(header);
 }
 
+void ObexHeader::AppendBuffer(const uint8_t headerId, const Buffer *buffer)
+{
+    if (buffer == nullptr) {
+        AppendBytes(headerId, nullptr, 0);
+        return;
+    }
+    std::unique_ptr<ObexOptionalHeader> header = std::make_unique<ObexOptionalBufferHeader>(headerId, buffer);
+    Append(header);
+}
+
 void ObexHeader::AppendWord(const uint8_t headerId, const uint32_t word)
 {
     std::unique_ptr<ObexOptionalHeader> header = std::make_unique<ObexOptionalWordHeader>(headerId, word);
@@ -518,6 +528,16 @@ void ObexHeader::AppendItemEndBody(const uint8_t *endBody, const uint16_t length
     AppendBytes(ObexHeader::END_OF_BODY, endBody, length);
 }
 
+void ObexHeader::AppendItemBody(const Buffer *body)
+{
+    AppendBuffer(ObexHeader::BODY, body);
+}
+
+void ObexHeader::AppendItemEndBody(const Buffer *endBody)
+{
+    AppendBuffer(ObexHeader::END_OF_BODY, endBody);
+}
+
 void ObexHeader::AppendItemWho(const uint8_t *who, const uint16_t length)
 {
     AppendBytes(ObexHeader::WHO, who, length);
@@ -808,7 +828,15 @@ bool ObexHeader::GetItemSrmp() const
 
 std::unique_ptr<ObexPacket> ObexHeader::Build() const
 {
-    auto obexPacket = std::make_unique<ObexPacket>(packetLength_);
+    // Referenced buffers are not copied into the packet buffer, they are linked into the packet after it.
+    uint16_t refLength = 0;
+    for (auto &headerItem : optionalHeaders_) {
+        if (headerItem->GetBuffer() != nullptr) {
+            refLength += headerItem->GetHeaderDataSize();
+        }
+    }
+    std::vector<std::pair<uint16_t, const Buffer *>> refBuffers {};
+    auto obexPacket = std::make_unique<ObexPacket>(packetLength_ - refLength);
     uint8_t *packetBuf = obexPacket->GetBuffer();
     uint16_t pos = 0;
     packetBuf[pos++] = code_;
@@ -834,14 +862,40 @@ std::unique_ptr<ObexPacket> ObexHeader::Build() const
             ObexUtils::SetBufData16(packetBuf, pos, headerItem->GetHeaderTotalSize());
             pos += UINT16_LENGTH;
         }
-        (void)memcpy_s(
-            &packetBuf[pos], packetLength_ - pos, headerItem->GetBytes().get(), headerItem->GetHeaderDataSize());
+        if (headerItem->GetBuffer() != nullptr) {
+            refBuffers.emplace_back(pos, headerItem->GetBuffer());
+            continue;
+        }
+        (void)memcpy_s(&packetBuf[pos], packetLength_ - refLength - pos, headerItem->GetBytes().get(),
+            headerItem->GetHeaderDataSize());
         if (!isBigEndian && headerItem->GetHeaderUnitLen() > 1) {
             ObexUtils::DataReverse(&packetBuf[pos], headerItem->GetHeaderDataSize(), headerItem->GetHeaderUnitLen());
         }
         pos += headerItem->GetHeaderDataSize();
     }
-    return obexPacket;
+    if (refBuffers.empty()) {
+        return obexPacket;
+    }
+
+    // Chain slices of the packet buffer and the referenced buffers, no data is copied.
+    Buffer *copied = PacketContinuousPayload(&obexPacket->GetPacket());
+    Packet *packet = PacketMalloc(0, 0, 0);
+    uint16_t start = 0;
+    for (auto &ref : refBuffers) {
+        if (ref.first > start) {
+            Buffer *slice = BufferSliceMalloc(copied, start, ref.first - start);
+            PacketPayloadAddLast(packet, slice);
+            BufferFree(slice);
+        }
+        PacketPayloadAddLast(packet, ref.second);
+        start = ref.first;
+    }
+    if (pos > start) {
+        Buffer *slice = BufferSliceMalloc(copied, start, pos - start);
+        PacketPayloadAddLast(packet, slice);
+        BufferFree(slice);
+    }
+    return std::make_unique<ObexPacket>(*packet);
 }
 
 const std::shared_ptr<ObexBodyObject> &ObexHeader::GetExtendBodyObject() const
@@ -1016,6 +1070,44 @@ std::unique_ptr<ObexOptionalHeader> ObexOptionalBytesHeader::Clone() const
     return std::make_unique<ObexOptionalBytesHeader>(GetHeaderId(), data_.data(), dataSize_, unitLen_);
 }
 
+// ObexOptionalBufferHeader
+ObexOptionalBufferHeader::ObexOptionalBufferHeader(const uint8_t headerId, const Buffer *buffer)
+    : ObexOptionalBytesHeader(headerId, nullptr, 0)
+{
+    buffer_ = BufferRefMalloc(buffer);
+    dataSize_ = BufferGetSize(buffer_);
+}
+
+ObexOptionalBufferHeader::~ObexOptionalBufferHeader()
+{
+    BufferFree(buffer_);
+}
+
+std::unique_ptr<uint8_t[]> ObexOptionalBufferHeader::GetBytes() const
+{
+    if (dataSize_ < 1) {
+        return nullptr;
+    }
+    auto buf = std::make_unique<uint8_t[]>(dataSize_);
+    (void)memcpy_s(buf.get(), dataSize_, BufferPtr(buffer_), dataSize_);
+    return buf;
+}
+
+const Buffer *ObexOptionalBufferHeader::GetBuffer() const
+{
+    return buffer_;
+}
+
+std::string ObexOptionalBufferHeader::GetHeaderClassTypeName() const
+{
+    return "ObexOptionalBufferHeader";
+}
+
+std::unique_ptr<ObexOptionalHeader> ObexOptionalBufferHeader::Clone() const
+{
+    return std::make_unique<ObexOptionalBufferHeader>(GetHeaderId(), buffer_);
+}
+
 // ObexOptionalStringHeader
 ObexOptionalStringHeader::ObexOptionalStringHeader(const uint8_t headerId, const std::string &str)
     : ObexOptionalBytesHeader(headerId, (uint8_t *)(str.c_str()), (str.size() == 0) ? 0 : (str.size() + 1), 1)
@@ -236,6 +236,11 @@ public:
     virtual ObexHeaderDataType GetHeaderClassType() const = 0;
     virtual std::string GetHeaderClassTypeName() const = 0;
     virtual std::unique_ptr<uint8_t[]> GetBytes() const = 0;
+    // The data buffer of a header that references its data instead of holding a copy.
+    virtual const Buffer *GetBuffer() const
+    {
+        return nullptr;
+    }
 
 protected:
     ObexOptionalHeader(uint8_t headerId);
@@ -259,6 +264,21 @@ protected:
     std::vector<uint8_t> data_ {};
 };
 
+// Bytes header that references a shared buffer, used for the body of outgoing packets.
+class ObexOptionalBufferHeader : public ObexOptionalBytesHeader {
+public:
+    ObexOptionalBufferHeader(const uint8_t headerId, const Buffer *buffer);
+    virtual ~ObexOptionalBufferHeader();
+    std::unique_ptr<uint8_t[]> GetBytes() const override;
+    const Buffer *GetBuffer() const override;
+    std::string GetHeaderClassTypeName() const override;
+    std::unique_ptr<ObexOptionalHeader> Clone() const override;
+
+private:
+    Buffer *buffer_ = nullptr;
+    DISALLOW_COPY_AND_ASSIGN(ObexOptionalBufferHeader);
+};
+
 class ObexOptionalByteHeader : public ObexOptionalBytesHeader {
 public:
     ObexOptionalByteHeader(const uint8_t headerId, const uint8_t byte);
@@ -431,6 +451,9 @@ public:
     void AppendItemHttp(const uint8_t *http, const uint16_t length);
     void AppendItemBody(const uint8_t *body, const uint16_t length);
     void AppendItemEndBody(const uint8_t *endBody, const uint16_t length);
+    // buffer is referenced by the header and the built packet, it is not copied
+    void AppendItemBody(const Buffer *body);
+    void AppendItemEndBody(const Buffer *endBody);
     void AppendItemWho(const uint8_t *who, const uint16_t length);
     void AppendItemObjectClass(const uint8_t *objectClass, const uint16_t length);
 
@@ -532,6 +555,7 @@ private:
     void AppendUnicode(const uint8_t headerId, const std::u16string &text);
     void AppendByte(const uint8_t headerId, const uint8_t byte);
     void AppendBytes(const uint8_t headerId, const uint8_t *byteBuf, const uint32_t size);
+    void AppendBuffer(const uint8_t headerId, const Buffer *buffer);
     void AppendWord(const uint8_t headerId, const uint32_t word);
     void AppendString(const uint8_t headerId, const std::string &str);
     void AppendTlvTriplets(const uint8_t headerId, ObexTlvParamters &tlvParamters);
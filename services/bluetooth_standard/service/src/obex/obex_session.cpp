@@ -210,23 +210,22 @@ ObexClientSendObject::ObexClientSendObject(
 
 bool ObexClientSendObject::SetBodyToHeader(ObexHeader &header, const uint16_t &remainLength)
 {
-    auto buf = std::make_unique<uint8_t[]>(remainLength);
-    int cnt = bodyReader_->Read(buf.get(), remainLength);
-    if (cnt < 0) {
-        return false;
-    }
+    // The body is read straight into a buffer that the request packet references.
+    Buffer *body = bodyReader_->ReadBuffer(remainLength);
+    int cnt = (body != nullptr) ? BufferGetSize(body) : 0;
     if (cnt < remainLength) {
         isDone_ = true;
     }
     if (isDone_) {
         OBEX_LOG_DEBUG("GetNextReqHeader Add End-Body count %{public}d", cnt);
         header.SetFinalBit(true);
-        header.AppendItemEndBody(buf.get(), cnt);
+        header.AppendItemEndBody(body);
     } else {
         OBEX_LOG_DEBUG("GetNextReqHeader Add Body count %{public}d", cnt);
         header.SetFinalBit(false);
-        header.AppendItemBody(buf.get(), cnt);
+        header.AppendItemBody(body);
     }
+    BufferFree(body);
     return true;
 }
 
@@ -540,23 +539,22 @@ void ObexServerSendObject::SetSrmParam(ObexHeader &header)
 
 bool ObexServerSendObject::SetBodyToHeader(ObexHeader &header, const uint16_t &remainLength)
 {
-    auto buf = std::make_unique<uint8_t[]>(remainLength);
-    int cnt = bodyReader_->Read(buf.get(), remainLength);
-    if (cnt < 0) {
-        return false;
-    }
+    // The body is read straight into a buffer that the response packet references.
+    Buffer *body = bodyReader_->ReadBuffer(remainLength);
+    int cnt = (body != nullptr) ? BufferGetSize(body) : 0;
     if (cnt < remainLength) {
         isDone_ = true;
     }
     if (isDone_) {
         OBEX_LOG_DEBUG("GetNextRespHeader Add End-Body count %{public}d", cnt);
         header.SetRespCode(static_cast<uint8_t>(ObexRspCode::SUCCESS));
-        header.AppendItemEndBody(buf.get(), cnt);
+        header.AppendItemEndBody(body);
     } else {
         OBEX_LOG_DEBUG("GetNextRespHeader Add Body count %{public}d", cnt);
         header.SetRespCode(static_cast<uint8_t>(ObexRspCode::CONTINUE));
-        header.AppendItemBody(buf.get(), cnt);
+        header.AppendItemBody(body);
     }
+    BufferFree(body);
     return true;
 }
 
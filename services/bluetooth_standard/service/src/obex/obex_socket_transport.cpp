@@ -223,6 +223,15 @@ void ObexClientSocketTransport::TransportObserver::OnDataAvailable(DataTransport
         std::bind(&ObexClientSocketTransport::TransportObserver::ProcessOnDataAvailable, this, transport, pkt));
 }
 
+// when several packets are received from L2CAP at once
+void ObexClientSocketTransport::TransportObserver::OnDataBatchAvailable(
+    DataTransport *transport, const std::vector<Packet *> &pkts)
+{
+    OBEX_LOG_DEBUG("[%{public}s] Call %{public}s", obexTran_.tranKey_.c_str(), __PRETTY_FUNCTION__);
+    obexTran_.dispatcher_.PostTask(
+        std::bind(&ObexClientSocketTransport::TransportObserver::ProcessOnDataBatchAvailable, this, transport, pkts));
+}
+
 // The event is triggered when peer or RFCOMM/L2CAP is not available to receive data.
 void ObexClientSocketTransport::TransportObserver::OnDataBusy(DataTransport *transport, uint8_t isBusy)
 {
@@ -298,6 +307,18 @@ void ObexClientSocketTransport::TransportObserver::ProcessOnDataAvailable(DataTr
     obexTran_.observer_.OnTransportDataAvailable(obexTran_, *obexPacket);
 }
 
+// The event is triggered when several packets are received from stack at once.
+void ObexClientSocketTransport::TransportObserver::ProcessOnDataBatchAvailable(
+    DataTransport *transport, const std::vector<Packet *> &pkts)
+{
+    OBEX_LOG_DEBUG("[%{public}s] Call %{public}s", obexTran_.tranKey_.c_str(), __PRETTY_FUNCTION__);
+    for (auto pkt : pkts) {
+        // pkt is delete by ObexPacket
+        auto obexPacket = std::make_unique<ObexPacket>(*pkt);
+        obexTran_.observer_.OnTransportDataAvailable(obexTran_, *obexPacket);
+    }
+}
+
 // The event is triggered when process is failed.
 void ObexClientSocketTransport::TransportObserver::ProcessOnTransportError(int errType)
 {
@@ -512,6 +533,15 @@ void ObexServerSocketTransport::TransportObserver::OnDataAvailable(DataTransport
         std::bind(&ObexServerSocketTransport::TransportObserver::ProcessOnDataAvailable, this, transport, pkt));
 }
 
+// when several packets are received from L2CAP at once
+void ObexServerSocketTransport::TransportObserver::OnDataBatchAvailable(
+    DataTransport *transport, const std::vector<Packet *> &pkts)
+{
+    OBEX_LOG_DEBUG("[%{public}s] Call %{public}s", mainTran_.tranKey_.c_str(), __PRETTY_FUNCTION__);
+    mainTran_.dispatcher_.PostTask(
+        std::bind(&ObexServerSocketTransport::TransportObserver::ProcessOnDataBatchAvailable, this, transport, pkts));
+}
+
 // when peer is not available to receive data, or RFCOMM's send queue is full
 void ObexServerSocketTransport::TransportObserver::OnTransportError(DataTransport *transport, int errType)
 {
@@ -658,6 +688,26 @@ void ObexServerSocketTransport::TransportObserver::ProcessOnDataAvailable(DataTr
     }
 }
 
+// The event is triggered when several packets are received from stack at once.
+void ObexServerSocketTransport::TransportObserver::ProcessOnDataBatchAvailable(
+    DataTransport *transport, const std::vector<Packet *> &pkts)
+{
+    OBEX_LOG_DEBUG("[%{public}s] Call %{public}s", mainTran_.tranKey_.c_str(), __PRETTY_FUNCTION__);
+    for (auto pkt : pkts) {
+        // Looked up per packet, handling one packet may close the sub transport.
+        auto it = mainTran_.subTranMap_.find(transport);
+        if (it == mainTran_.subTranMap_.end()) {
+            OBEX_LOG_ERROR("[%{public}s] Receive data on sub transport, but it isn't exists in subTransportMap!",
+                mainTran_.tranKey_.c_str());
+            PacketFree(pkt);
+            continue;
+        }
+        // pkt is delete by ObexPacket
+        auto obexPacket = std::make_unique<ObexPacket>(*pkt);
+        mainTran_.observer_.OnTransportDataAvailable(*it->second, *obexPacket);
+    }
+}
+
 void ObexServerSocketTransport::TransportObserver::ProcessOnDataBusy(DataTransport *transport, uint8_t isBusy)
 {
     OBEX_LOG_INFO("[%{public}s] Call %{public}s, isBusy %{public}d", mainTran_.tranKey_.c_str(), __PRETTY_FUNCTION__, int(isBusy));
@@ -19,6 +19,7 @@
 #include <atomic>
 #include <cstdint>
 #include <unordered_map>
+#include <vector>
 #include "dispatcher.h"
 #include "obex_packet.h"
 #include "obex_transport.h"
@@ -98,6 +99,7 @@ private:
         // The event is triggered when data is received from stack.
         void OnDataAvailable(DataTransport *transport, Packet *pkt) override;
         void OnDataAvailable(DataTransport *transport) override;
+        void OnDataBatchAvailable(DataTransport *transport, const std::vector<Packet *> &pkts) override;
         // The event is triggered when peer or RFCOMM/L2CAP is not available to receive data.
         void OnDataBusy(DataTransport *transport, uint8_t isBusy) override;
         // The event is triggered when process is failed.
@@ -113,6 +115,7 @@ private:
         void ProcessOnDisconnectSuccess();
         // The event is triggered when data is received from stack.
         void ProcessOnDataAvailable(DataTransport *transport, Packet *pkt);
+        void ProcessOnDataBatchAvailable(DataTransport *transport, const std::vector<Packet *> &pkts);
         // The event is triggered when peer or RFCOMM/L2CAP is not available to receive data.
         void ProcessOnDataBusy(uint8_t isBusy);
         // The event is triggered when process is failed.
@@ -170,6 +173,7 @@ private:
         // The event is triggered when data is received from stack.
         void OnDataAvailable(DataTransport *transport, Packet *pkt) override;
         void OnDataAvailable(DataTransport *transport) override;
+        void OnDataBatchAvailable(DataTransport *transport, const std::vector<Packet *> &pkts) override;
         // The event is triggered when peer or RFCOMM/L2CAP is not available to receive data.
         void OnDataBusy(DataTransport *transport, uint8_t isBusy) override;
         // The event is triggered when process is failed.
@@ -189,6 +193,7 @@ private:
         void ProcessOnDisconnectSuccess(DataTransport *transport);
         // The event is triggered when data is received from stack.
         void ProcessOnDataAvailable(DataTransport *transport, Packet *pkt);
+        void ProcessOnDataBatchAvailable(DataTransport *transport, const std::vector<Packet *> &pkts);
         // The event is triggered when peer or RFCOMM/L2CAP is not available to receive data.
         void ProcessOnDataBusy(DataTransport *transport, uint8_t isBusy);
         // The event is triggered when process is failed.
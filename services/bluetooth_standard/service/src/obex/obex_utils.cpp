@@ -99,9 +99,9 @@ uint64_t ObexUtils::GetBufData64(const uint8_t *bigEndData, uint16_t pos)
 
 std::string ObexUtils::ToDebugString(Packet &obexPacket)
 {
-    Buffer *tmpBuffer = PacketContinuousPayload(&obexPacket);
-    uint8_t *packetBuf = (uint8_t *)BufferPtr(tmpBuffer);
-    size_t packetBufSize = BufferGetSize(tmpBuffer);
+    // Only read what is printed, the packet may link body buffers that must not be merged for a log.
+    uint8_t packetBuf[DEBUG_MAX_DATA_LEN + 1] = {0};
+    size_t packetBufSize = PacketRead(&obexPacket, packetBuf, 0, sizeof(packetBuf));
     return ToDebugString(packetBuf, packetBufSize, true);
 }
 
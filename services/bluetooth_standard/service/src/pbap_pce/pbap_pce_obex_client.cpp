@@ -18,45 +18,6 @@
 #include "pbap_pce_service.h"
 
 namespace bluetooth {
-ObexFileBodyObject::ObexFileBodyObject(const std::string &file)
-{
-    OpenOutFile(file);
-}
-
-void ObexFileBodyObject::OpenOutFile(const std::string &file)
-{
-    ofs_.open(file, std::ios::out);
-    if (!ofs_.is_open()) {
-        PBAP_PCE_LOG_ERROR("%{public}s file  open failed", __PRETTY_FUNCTION__);
-    } else {
-        PBAP_PCE_LOG_DEBUG("%{public}s file=%{public}s  opened.", __PRETTY_FUNCTION__, file.c_str());
-    }
-}
-
-size_t ObexFileBodyObject::Read(uint8_t *buf, size_t bufLen)
-{
-    size_t readSize = bufLen;
-    return readSize;
-}
-
-size_t ObexFileBodyObject::Write(const uint8_t *buf, size_t bufLen)
-{
-    if (ofs_.is_open()) {
-        auto buffer = reinterpret_cast<const char*>(buf);
-        ofs_.write(buffer, bufLen);
-        PBAP_PCE_LOG_DEBUG("%{public}s write file bufLen=%zu", __PRETTY_FUNCTION__, bufLen);
-    } else {
-        PBAP_PCE_LOG_ERROR("%{public}s file  open failed", __PRETTY_FUNCTION__);
-    }
-    return bufLen;
-}
-
-int ObexFileBodyObject::Close()
-{
-    ofs_.close();
-    return 0;
-}
-
 PbapPceObexClient::PbapPceObexClient(const ObexClientConfig &config, PbapPceService &pceService)
     : obexConfig_(config), pceService_(pceService)
 {
@@ -29,20 +29,6 @@
 #include "pbap_pce_service.h"
 
 namespace bluetooth {
-class ObexFileBodyObject : public ObexBodyObject {
-public:
-    explicit ObexFileBodyObject(const std::string &file);
-    ObexFileBodyObject() = default;
-    virtual ~ObexFileBodyObject() = default;
-    size_t Read(uint8_t *buf, size_t bufLen) override;
-    size_t Write(const uint8_t *buf, size_t bufLen) override;
-    int Close() override;
-
-private:
-    void OpenOutFile(const std::string &file);
-    std::ofstream ofs_ {};
-};
-
 /**
  * @brief obex client
  * wrap obex client
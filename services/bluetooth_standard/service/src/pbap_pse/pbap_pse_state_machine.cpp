@@ -476,9 +476,11 @@ void PseConnected::SendPhoneBookResponse(ObexServerSession &obexSession, const O
     }
     auto resp = ObexHeader::CreateResponse(ObexRspCode::SUCCESS);
     respAppParams.AddToObexHeader(*resp);
-    std::shared_ptr<ObexArrayBodyObject> bodyObject = nullptr;
+    std::shared_ptr<ObexBodyObject> bodyObject = nullptr;
     // ADD BODY
-    if (!pbResult.phoneBookSizeOnly_ && pbResult.result_.size() > 0) {
+    if (!pbResult.phoneBookSizeOnly_ && pbResult.bodyObject_ != nullptr) {
+        bodyObject = pbResult.bodyObject_;
+    } else if (!pbResult.phoneBookSizeOnly_ && pbResult.result_.size() > 0) {
             PBAP_PSE_LOG_DEBUG("pbResult.result_.size() = %{public}d", pbResult.result_.size());
             bodyObject = std::make_shared<ObexArrayBodyObject>(pbResult.result_.data(), pbResult.result_.size());
     }
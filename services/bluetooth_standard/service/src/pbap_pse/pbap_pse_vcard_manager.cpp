@@ -18,23 +18,171 @@
 #include <cstring>
 #include <exception>
 #include <functional>
+#include <mutex>
 #include <set>
 #include <sstream>
+#include <tuple>
 #include "../obex/obex_utils.h"
 #include "data_access.h"
 #include "log.h"
 #include "pbap_pse_def.h"
+#include "securec.h"
 #include "stub/vcard_util.h"
 
 using namespace stub;
 
 namespace bluetooth {
+// Keeps opened connections of the phonebook database, so a request does not pay for opening the database.
+class PbapPseDataAccessPool {
+public:
+    class Connection {
+    public:
+        Connection(const std::string &dbFile, std::unique_ptr<DataAccess> dataAccess)
+            : dbFile_(dbFile), dataAccess_(std::move(dataAccess))
+        {}
+        ~Connection()
+        {
+            PbapPseDataAccessPool::Release(dbFile_, std::move(dataAccess_));
+        }
+        const std::unique_ptr<DataAccess> &Get() const
+        {
+            return dataAccess_;
+        }
+
+    private:
+        std::string dbFile_ {};
+        std::unique_ptr<DataAccess> dataAccess_ {};
+        DISALLOW_COPY_AND_ASSIGN(Connection);
+    };
+
+    static std::unique_ptr<Connection> Acquire(const std::string &dbFile)
+    {
+        std::unique_ptr<DataAccess> dataAccess = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (dbFile_ == dbFile && !idle_.empty()) {
+                dataAccess = std::move(idle_.back());
+                idle_.pop_back();
+            }
+        }
+        if (!dataAccess) {
+            dataAccess = DataAccess::GetConnection(dbFile);
+        }
+        if (!dataAccess) {
+            PBAP_PSE_LOG_ERROR("can't open %{public}s", dbFile.c_str());
+            return nullptr;
+        }
+        return std::make_unique<Connection>(dbFile, std::move(dataAccess));
+    }
+
+    static void Release(const std::string &dbFile, std::unique_ptr<DataAccess> dataAccess)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (dbFile_ != dbFile) {
+            idle_.clear();
+            dbFile_ = dbFile;
+        }
+        if (idle_.size() < MAX_IDLE_CONNECTIONS) {
+            idle_.push_back(std::move(dataAccess));
+        }
+    }
+
+    static void Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        idle_.clear();
+    }
+
+private:
+    static const size_t MAX_IDLE_CONNECTIONS = 2;
+    static std::mutex mutex_;
+    static std::string dbFile_;
+    static std::vector<std::unique_ptr<DataAccess>> idle_;
+};
+
+std::mutex PbapPseDataAccessPool::mutex_ {};
+std::string PbapPseDataAccessPool::dbFile_ = "";
+std::vector<std::unique_ptr<DataAccess>> PbapPseDataAccessPool::idle_ {};
+
+// Serialized vCards keyed by (vcard uid, output version, property selector, X-BT features).
+// All entries belong to one database version stamp and are dropped when the stamp changes.
+class PbapPseVcardCache {
+public:
+    using Key = std::tuple<int64_t, int, uint64_t, uint32_t>;
+
+    static void Validate(const std::string &stamp)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stamp_ == stamp && !stamp.empty()) {
+            return;
+        }
+        PBAP_PSE_LOG_DEBUG("vcard cache invalidated, %{public}zu entries", vcards_.size());
+        vcards_.clear();
+        size_ = 0;
+        stamp_ = stamp;
+    }
+
+    static bool Find(const Key &key, std::vector<uint8_t> &vcardBytes)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = vcards_.find(key);
+        if (it == vcards_.end()) {
+            return false;
+        }
+        vcardBytes = it->second;
+        return true;
+    }
+
+    static void Insert(const std::string &stamp, const Key &key, const std::vector<uint8_t> &vcardBytes)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // built from an older database version, or the database can't tell its version
+        if (stamp.empty() || stamp != stamp_) {
+            return;
+        }
+        if (size_ + vcardBytes.size() > MAX_CACHE_SIZE) {
+            return;
+        }
+        if (vcards_.emplace(key, vcardBytes).second) {
+            size_ += vcardBytes.size();
+        }
+    }
+
+    static void Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        vcards_.clear();
+        size_ = 0;
+        stamp_.clear();
+    }
+
+private:
+    static const size_t MAX_CACHE_SIZE = 4 * 1024 * 1024;
+    static std::mutex mutex_;
+    static std::string stamp_;
+    static std::map<Key, std::vector<uint8_t>> vcards_;
+    static size_t size_;
+};
+
+std::mutex PbapPseVcardCache::mutex_ {};
+std::string PbapPseVcardCache::stamp_ = "";
+std::map<PbapPseVcardCache::Key, std::vector<uint8_t>> PbapPseVcardCache::vcards_ {};
+size_t PbapPseVcardCache::size_ = 0;
+
 class PbapPseVcardDataAccess {
 public:
+    struct VcardBuildParam {
+        VCardVersion outVer = VCardVersion::VER_2_1;
+        std::vector<std::string> mandatoryProperties {};
+        std::string propertyWhere = "";
+        uint64_t propertySelector = 0;  // 0 means all properties
+        uint32_t supportedFeatures = 0;
+        std::string dbStamp = "";
+    };
     struct SetPullvCardEntryParam {
         std::u16string folderId = u"";
         std::u16string entryId = u"";
-        uint32_t supportedFeatures = 0;
+        VcardBuildParam buildParam {};
     };
     static void SetPullvCardListingSize(const std::unique_ptr<DataAccess> &dataAccess, const std::u16string &folderId,
         PbapPseVcardManager::PhoneBookResult &result, const PbapPseAppParams &pbapAppParams)
@@ -160,13 +308,14 @@ public:
         result.phoneBookSize_ = count;
     }
 
-    static void SetPhoneBook(const std::unique_ptr<DataAccess> &dataAccess, const std::u16string &folderId,
-        PbapPseVcardManager::PhoneBookResult &result, const PbapPseAppParams &pbapAppParams,
-        const uint32_t &supportedFeatures)
-    {
-        PBAP_PSE_LOG_INFO("%{public}s ", __PRETTY_FUNCTION__);
-        auto vcardUids = SelectPhoneBookVcardUids(dataAccess, folderId, pbapAppParams);
+    static void SetPhoneBook(std::unique_ptr<PbapPseDataAccessPool::Connection> connection,
+        const std::u16string &folderId, PbapPseVcardManager::PhoneBookResult &result,
+        const PbapPseAppParams &pbapAppParams, const VcardBuildParam &buildParam);
 
+    static VcardBuildParam GetVcardBuildParam(
+        const PbapPseAppParams &pbapAppParams, const uint32_t &supportedFeatures, const std::string &dbStamp)
+    {
+        VcardBuildParam param;
         // 5.1.4.2 Format :vCard2.1, vCard3.0
         bool isOutVcard21 = true;  // The format vCard 2.1 shall be the default format if this header is not specified.
         if (pbapAppParams.GetFormat()) {
@@ -179,34 +328,82 @@ public:
         std::vector<std::string> includeProperties;
         // Mandatory properties for vCard 2.1 are VERSION ,N and TEL.
         // Mandatory properties for vCard 3.0 are VERSION, N, FN and TEL.
-        std::vector<std::string> mandatoryProperties;
-        mandatoryProperties.push_back("VERSION");
-        mandatoryProperties.push_back("N");
+        param.mandatoryProperties.push_back("VERSION");
+        param.mandatoryProperties.push_back("N");
         if (!isOutVcard21) {
-            mandatoryProperties.push_back("FN");
+            param.mandatoryProperties.push_back("FN");
         }
-        mandatoryProperties.push_back("TEL");
+        param.mandatoryProperties.push_back("TEL");
         if (pbapAppParams.GetPropertySelector()) {
             includeProperties = PbapPseVcardManager::GetIncludeProperties(*pbapAppParams.GetPropertySelector());
             if (includeProperties.size() > 0) {
+                param.propertySelector = *pbapAppParams.GetPropertySelector();
                 includeProperties.insert(
-                    includeProperties.end(), mandatoryProperties.begin(), mandatoryProperties.end());
+                    includeProperties.end(), param.mandatoryProperties.begin(), param.mandatoryProperties.end());
             }
         }
-        const VCardVersion outVer = isOutVcard21 ? VCardVersion::VER_2_1 : VCardVersion::VER_3_0;
-
-        std::function<void(VCard &)> fun = [&mandatoryProperties, &result, &outVer](VCard &vcard) {
-            // 5.1.4.1 all Mandatory here means that the PSE shall always return the properties VERSION, N and TEL
-            // vCard 2.1 or VERSION, N, FN and TEL for a vCard 3.0.
-            AddMissProperties(vcard, mandatoryProperties);
+        param.outVer = isOutVcard21 ? VCardVersion::VER_2_1 : VCardVersion::VER_3_0;
+        param.propertyWhere = GetPropertySelectorWhere(includeProperties);
+        param.supportedFeatures = supportedFeatures;
+        param.dbStamp = dbStamp;
+        return param;
+    }
 
-            if (vcard.Properties().size() > 0) {
-                std::vector<uint8_t> vcardBytes = VCardUtil::Build(vcard, outVer);
-                result.result_.insert(result.result_.end(), vcardBytes.begin(), vcardBytes.end());
+    // Serialize one vCard, from cache if the same vCard was built with the same parameters.
+    // stmt is the prepared property query, created on the first cache miss.
+    static std::vector<uint8_t> BuildVcard(const std::unique_ptr<DataAccess> &dataAccess,
+        std::unique_ptr<IDataStatement> &stmt, const std::pair<int64_t, int> &vcardUid, const VcardBuildParam &param)
+    {
+        uint32_t xBtFeatures = param.supportedFeatures &
+            (PBAP_FEATURES_X_BT_UCI_VCARD_PROPERTY | PBAP_FEATURES_X_BT_UID_VCARD_PROPERTY);
+        PbapPseVcardCache::Key key(
+            vcardUid.first, static_cast<int>(param.outVer), param.propertySelector, xBtFeatures);
+        std::vector<uint8_t> vcardBytes;
+        if (PbapPseVcardCache::Find(key, vcardBytes)) {
+            return vcardBytes;
+        }
+        if (!stmt) {
+            stmt = dataAccess->CreateStatement(GetSelectPhoneBookVcardListSql(param.propertyWhere));
+            if (!stmt) {
+                PBAP_PSE_LOG_ERROR("Error in CreateStatement");
+                return vcardBytes;
             }
-        };
-        SelectPhoneBookVcardList(
-            dataAccess, vcardUids, GetPropertySelectorWhere(includeProperties), supportedFeatures, fun);
+        }
+        VCard vcard;
+        SelectVcard(stmt, vcardUid, param.supportedFeatures, vcard);
+        // 5.1.4.1 all Mandatory here means that the PSE shall always return the properties VERSION, N and TEL
+        // vCard 2.1 or VERSION, N, FN and TEL for a vCard 3.0.
+        AddMissProperties(vcard, param.mandatoryProperties);
+        if (vcard.Properties().size() > 0) {
+            vcardBytes = VCardUtil::Build(vcard, param.outVer);
+        }
+        PbapPseVcardCache::Insert(param.dbStamp, key, vcardBytes);
+        return vcardBytes;
+    }
+
+    // The folder versions change with every vCard change, together with the database identifier they tell whether
+    // a cached vCard is still valid.
+    static std::string GetDbVersionStamp(const std::unique_ptr<DataAccess> &dataAccess)
+    {
+        std::string stamp = "";
+        auto stmtDbId = dataAccess->CreateStatement("select db_id from vcard_db_id limit 1");
+        auto stmtFolder = dataAccess->CreateStatement(
+            "select folder_id, primary_folder_version from vcard_folder order by folder_id");
+        if (!stmtDbId || !stmtFolder) {
+            return stamp;
+        }
+        auto dbIdResult = stmtDbId->Query();
+        auto folderResult = stmtFolder->Query();
+        if (!dbIdResult || !folderResult) {
+            return stamp;
+        }
+        if (dbIdResult->Next()) {
+            stamp += dbIdResult->GetString(0);
+        }
+        while (folderResult->Next()) {
+            stamp += ";" + folderResult->GetString(0) + ":" + folderResult->GetString(1);
+        }
+        return stamp;
     }
 
     static void SetPullvCardEntry(
@@ -221,44 +418,11 @@ public:
             result.rspCode_ = ObexRspCode::NOT_FOUND;
             return;
         }
-        // 5.1.4.2 Format :vCard2.1, vCard3.0
-        bool isOutVcard21 = true;  // The format vCard 2.1 shall be the default format if this header is not specified.
-        if (pbapAppParams.GetFormat()) {
-            // 0x00 = 2.1 0x01 = 3.0
-            isOutVcard21 = (0x00 == *pbapAppParams.GetFormat());
-        }
-
-        // 5.1.4.1 PropertySelector :PropertyMask (64-bit value)
-        std::vector<std::string> includeProperties;
-        // Mandatory properties for vCard 2.1 are VERSION ,N and TEL.
-        // Mandatory properties for vCard 3.0 are VERSION, N, FN and TEL.
-        std::vector<std::string> mandatoryProperties;
-        mandatoryProperties.push_back("VERSION");
-        mandatoryProperties.push_back("N");
-        if (!isOutVcard21) {
-            mandatoryProperties.push_back("FN");
-        }
-        mandatoryProperties.push_back("TEL");
-        if (pbapAppParams.GetPropertySelector()) {
-            includeProperties = PbapPseVcardManager::GetIncludeProperties(*pbapAppParams.GetPropertySelector());
-            if (includeProperties.size() > 0) {
-                includeProperties.insert(
-                    includeProperties.end(), mandatoryProperties.begin(), mandatoryProperties.end());
-            }
+        std::unique_ptr<IDataStatement> stmt = nullptr;
+        for (auto &vcardUid : vcardUids) {
+            std::vector<uint8_t> vcardBytes = BuildVcard(dataAccess, stmt, vcardUid, param.buildParam);
+            result.result_.insert(result.result_.end(), vcardBytes.begin(), vcardBytes.end());
         }
-        const VCardVersion outVer = isOutVcard21 ? VCardVersion::VER_2_1 : VCardVersion::VER_3_0;
-        std::function<void(VCard &)> fun = [&mandatoryProperties, &result, &outVer](VCard &vcard) {
-            // 5.1.4.1 all Mandatory here means that the PSE shall always return the properties VERSION, N and TEL
-            // vCard 2.1 or VERSION, N, FN and TEL for a vCard 3.0.
-            AddMissProperties(vcard, mandatoryProperties);
-
-            if (vcard.Properties().size() > 0) {
-                std::vector<uint8_t> vcardBytes = VCardUtil::Build(vcard, outVer);
-                result.result_.insert(result.result_.end(), vcardBytes.begin(), vcardBytes.end());
-            }
-        };
-        SelectPhoneBookVcardList(
-            dataAccess, vcardUids, GetPropertySelectorWhere(includeProperties), param.supportedFeatures, fun);
     }
 
     static void SetDbId(const std::unique_ptr<DataAccess> &dataAccess, PbapPseVcardManager::PhoneBookResult &result)
@@ -503,51 +667,38 @@ private:
         return true;
     }
 
-    static bool SelectPhoneBookVcardList(const std::unique_ptr<DataAccess> &dataAccess,
-        const std::vector<std::pair<int64_t, int>> &vcardUids, const std::string whereSql,
-        const uint32_t &supportedFeatures, const std::function<void(VCard &)> &handleFun)
+    static void SelectVcard(const std::unique_ptr<IDataStatement> &stmt, const std::pair<int64_t, int> &vcardUid,
+        const uint32_t &supportedFeatures, VCard &vcard)
     {
-        PBAP_PSE_LOG_INFO("%{public}s ", __PRETTY_FUNCTION__);
-        std::string select = GetSelectPhoneBookVcardListSql(whereSql);
-        auto stmt = dataAccess->CreateStatement(select);
-        if (!stmt) {
-            PBAP_PSE_LOG_ERROR("Error in CreateStatement");
-            return false;
+        int64_t uid = vcardUid.first;
+        bool isCurVcard21 = (vcardUid.second == 0);
+        stmt->ClearParams();
+        stmt->SetParamInt64(1, uid);
+        auto dataResult = stmt->Query();
+        if (!dataResult) {
+            return;
         }
-        for (size_t i = 0; i < vcardUids.size(); i++) {
-            auto pair = vcardUids.at(i);
-            int64_t vcardUid = pair.first;
-            int vcardVer = pair.second;
-            stmt->ClearParams();
-            stmt->SetParamInt64(1, vcardUid);
-            bool isCurVcard21 = (vcardVer == 0);
-            auto dataResult = stmt->Query();
-            VCard vcard;
-            const VCardVersion curVer = isCurVcard21 ? VCardVersion::VER_2_1 : VCardVersion::VER_3_0;
-            while (dataResult->Next()) {
-                int index = 0;
-                int vcardHandleId = dataResult->GetInt(index++);
-                int vcardVersion = dataResult->GetInt(index++);
-                std::string propertyGroup = dataResult->GetString(index++);
-                std::string propertyId = dataResult->GetString(index++);
-                if (!IsNeedInclude(propertyId, supportedFeatures)) {
-                    continue;
-                }
-                std::string propertyDetails = dataResult->GetString(index++);
-                std::string propertyValue = dataResult->GetString(index++);
-                PBAP_PSE_LOG_DEBUG("[%{public}d]: %lld\t%{public}d\t%{public}d\t%{public}s\t%{public}s\t%{public}s",
-                    i,
-                    vcardUid,
-                    vcardHandleId,
-                    vcardVersion,
-                    propertyId.c_str(),
-                    propertyDetails.c_str(),
-                    propertyValue.c_str());
-                vcard.AddProperty(VCardProperty(curVer, propertyGroup, propertyId, propertyValue, propertyDetails));
+        const VCardVersion curVer = isCurVcard21 ? VCardVersion::VER_2_1 : VCardVersion::VER_3_0;
+        while (dataResult->Next()) {
+            int index = 0;
+            int vcardHandleId = dataResult->GetInt(index++);
+            int vcardVersion = dataResult->GetInt(index++);
+            std::string propertyGroup = dataResult->GetString(index++);
+            std::string propertyId = dataResult->GetString(index++);
+            if (!IsNeedInclude(propertyId, supportedFeatures)) {
+                continue;
             }
-            handleFun(vcard);
+            std::string propertyDetails = dataResult->GetString(index++);
+            std::string propertyValue = dataResult->GetString(index++);
+            PBAP_PSE_LOG_DEBUG("%lld\t%{public}d\t%{public}d\t%{public}s\t%{public}s\t%{public}s",
+                uid,
+                vcardHandleId,
+                vcardVersion,
+                propertyId.c_str(),
+                propertyDetails.c_str(),
+                propertyValue.c_str());
+            vcard.AddProperty(VCardProperty(curVer, propertyGroup, propertyId, propertyValue, propertyDetails));
         }
-        return true;
     }
 
     static std::vector<std::pair<int64_t, int>> SelectVcardEntryUid(const std::unique_ptr<DataAccess> &dataAccess,
@@ -690,6 +841,91 @@ private:
     }
 };
 
+// Phonebook body that serializes vCards only when OBEX asks for the next packet, so the first packet is sent
+// without waiting for the whole phonebook and the memory in use is bounded by one vCard.
+class PbapPseVcardBodyObject : public ObexBodyObject {
+public:
+    PbapPseVcardBodyObject(std::unique_ptr<PbapPseDataAccessPool::Connection> connection,
+        std::vector<std::pair<int64_t, int>> vcardUids, const PbapPseVcardDataAccess::VcardBuildParam &buildParam)
+        : connection_(std::move(connection)), vcardUids_(std::move(vcardUids)), buildParam_(buildParam)
+    {}
+    ~PbapPseVcardBodyObject() override = default;
+
+    size_t Read(uint8_t *buf, size_t bufLen) override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t readSize = 0;
+        while (readSize < bufLen) {
+            if (pendingIndex_ >= pending_.size() && !FillPending()) {
+                break;
+            }
+            size_t copySize = std::min(bufLen - readSize, pending_.size() - pendingIndex_);
+            if (memcpy_s(buf + readSize, bufLen - readSize, pending_.data() + pendingIndex_, copySize) != EOK) {
+                PBAP_PSE_LOG_ERROR("memcpy_s failed");
+                break;
+            }
+            readSize += copySize;
+            pendingIndex_ += copySize;
+        }
+        return readSize;
+    }
+
+    size_t Write(const uint8_t *buf, size_t bufLen) override
+    {
+        return 0;
+    }
+
+    int Close() override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // return the connection to pool as soon as the transfer is over
+        stmt_ = nullptr;
+        connection_ = nullptr;
+        nextIndex_ = vcardUids_.size();
+        pending_.clear();
+        pendingIndex_ = 0;
+        return 0;
+    }
+
+private:
+    bool FillPending()
+    {
+        pending_.clear();
+        pendingIndex_ = 0;
+        while (pending_.empty() && connection_ != nullptr && nextIndex_ < vcardUids_.size()) {
+            pending_ = PbapPseVcardDataAccess::BuildVcard(
+                connection_->Get(), stmt_, vcardUids_.at(nextIndex_++), buildParam_);
+        }
+        return !pending_.empty();
+    }
+
+    // declared before stmt_, the statement must be released before its connection
+    std::unique_ptr<PbapPseDataAccessPool::Connection> connection_ {};
+    std::unique_ptr<IDataStatement> stmt_ {};
+    std::vector<std::pair<int64_t, int>> vcardUids_ {};
+    size_t nextIndex_ = 0;
+    PbapPseVcardDataAccess::VcardBuildParam buildParam_ {};
+    std::vector<uint8_t> pending_ {};
+    size_t pendingIndex_ = 0;
+    std::mutex mutex_ {};
+    DISALLOW_COPY_AND_ASSIGN(PbapPseVcardBodyObject);
+};
+
+void PbapPseVcardDataAccess::SetPhoneBook(std::unique_ptr<PbapPseDataAccessPool::Connection> connection,
+    const std::u16string &folderId, PbapPseVcardManager::PhoneBookResult &result,
+    const PbapPseAppParams &pbapAppParams, const VcardBuildParam &buildParam)
+{
+    PBAP_PSE_LOG_INFO("%{public}s ", __PRETTY_FUNCTION__);
+    auto vcardUids = SelectPhoneBookVcardUids(connection->Get(), folderId, pbapAppParams);
+    if (vcardUids.size() == 0) {
+        PBAP_PSE_LOG_DEBUG("SelectPhoneBookVcardUids size = 0");
+        return;
+    }
+    PBAP_PSE_LOG_DEBUG("stream %{public}zu vcards", vcardUids.size());
+    result.bodyObject_ =
+        std::make_shared<PbapPseVcardBodyObject>(std::move(connection), std::move(vcardUids), buildParam);
+}
+
 const std::map<char16_t, uint8_t> PbapPseVcardManager::VCARD_HANDLE_CHAR_MAP = {
     {'0', 0},
     {'1', 1},
@@ -770,6 +1006,8 @@ std::string PbapPseVcardManager::g_pbapDbFile = PBAP_PSE_DEFAULT_DB_FILE;
 void PbapPseVcardManager::SetDbFile(const std::string dbFile)
 {
     g_pbapDbFile = dbFile;
+    PbapPseDataAccessPool::Clear();
+    PbapPseVcardCache::Clear();
 }
 
 void PbapPseVcardManager::PullPhoneBook(std::u16string nameWithFolder, const PbapPseAppParams &pbapAppParams,
@@ -787,11 +1025,12 @@ void PbapPseVcardManager::PullPhoneBook(std::u16string nameWithFolder, const Pba
         return;
     }
 
-    auto dataAccess = DataAccess::GetConnection(g_pbapDbFile);
-    if (!dataAccess) {
+    auto connection = PbapPseDataAccessPool::Acquire(g_pbapDbFile);
+    if (!connection) {
         result.rspCode_ = ObexRspCode::NOT_FOUND;
         return;
     }
+    const std::unique_ptr<DataAccess> &dataAccess = connection->Get();
 
     const std::u16string &folderId = target->second;
     if (pbapAppParams.GetMaxListCount()) {
@@ -812,7 +1051,10 @@ void PbapPseVcardManager::PullPhoneBook(std::u16string nameWithFolder, const Pba
     }
     if (!result.phoneBookSizeOnly_) {
         PBAP_PSE_LOG_DEBUG("GetPhoneBook");
-        PbapPseVcardDataAccess::SetPhoneBook(dataAccess, folderId, result, pbapAppParams, supportedFeatures);
+        std::string dbStamp = PbapPseVcardDataAccess::GetDbVersionStamp(dataAccess);
+        PbapPseVcardCache::Validate(dbStamp);
+        auto buildParam = PbapPseVcardDataAccess::GetVcardBuildParam(pbapAppParams, supportedFeatures, dbStamp);
+        PbapPseVcardDataAccess::SetPhoneBook(std::move(connection), folderId, result, pbapAppParams, buildParam);
     }
 }
 
@@ -834,11 +1076,12 @@ void PbapPseVcardManager::PullvCardListing(std::u16string currentPath, std::u16s
         result.rspCode_ = ObexRspCode::NOT_FOUND;
         return;
     }
-    auto dataAccess = DataAccess::GetConnection(g_pbapDbFile);
-    if (!dataAccess) {
+    auto connection = PbapPseDataAccessPool::Acquire(g_pbapDbFile);
+    if (!connection) {
         result.rspCode_ = ObexRspCode::NOT_FOUND;
         return;
     }
+    const std::unique_ptr<DataAccess> &dataAccess = connection->Get();
     const std::u16string &folderId = target->second;
 
     if (pbapAppParams.GetMaxListCount()) {
@@ -879,11 +1122,12 @@ void PbapPseVcardManager::PullvCardEntry(std::u16string currentPath, std::u16str
         }
         folderId = target->second;
     }
-    auto dataAccess = DataAccess::GetConnection(g_pbapDbFile);
-    if (!dataAccess) {
+    auto connection = PbapPseDataAccessPool::Acquire(g_pbapDbFile);
+    if (!connection) {
         result.rspCode_ = ObexRspCode::NOT_FOUND;
         return;
     }
+    const std::unique_ptr<DataAccess> &dataAccess = connection->Get();
     if (IsSupportedDbVer(supportedFeatures)) {
         PbapPseVcardDataAccess::SetDbId(dataAccess, result);
         if (result.rspCode_ != ObexRspCode::SUCCESS) {
@@ -891,8 +1135,10 @@ void PbapPseVcardManager::PullvCardEntry(std::u16string currentPath, std::u16str
         }
     }
 
+    std::string dbStamp = PbapPseVcardDataAccess::GetDbVersionStamp(dataAccess);
+    PbapPseVcardCache::Validate(dbStamp);
     PbapPseVcardDataAccess::SetPullvCardEntryParam param = {
-        folderId, entryId, supportedFeatures
+        folderId, entryId, PbapPseVcardDataAccess::GetVcardBuildParam(pbapAppParams, supportedFeatures, dbStamp)
     };
     PbapPseVcardDataAccess::SetPullvCardEntry(dataAccess, param, pbapAppParams, result);
 }
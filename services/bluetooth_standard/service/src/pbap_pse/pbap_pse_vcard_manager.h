@@ -19,7 +19,9 @@
 #include <cstdint>
 #include <cstring>
 #include <map>
+#include <memory>
 #include <vector>
+#include "../obex/obex_body.h"
 #include "../obex/obex_types.h"
 #include "pbap_pse_app_params.h"
 
@@ -36,6 +38,7 @@ public:
         std::vector<uint8_t> secondaryFolderVersion_ {};  // VCard SecondaryFolderVersion 16 bytes
         std::vector<uint8_t> databaseIdentifier_ {};      // VCard DatabaseIdentifier 16 bytes
         std::vector<uint8_t> result_ {};                  // VCard bytes with utf-8
+        std::shared_ptr<ObexBodyObject> bodyObject_ {};  // VCards streamed on read, used instead of result_
     };
     static void SetDbFile(const std::string dbFile);
     virtual ~PbapPseVcardManager() = default;
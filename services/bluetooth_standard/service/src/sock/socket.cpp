@@ -836,8 +836,8 @@ int Socket::TransportWrite(Packet *subPkt)
 {
     LOG_INFO("[sock]%{public}s", __func__);
 
-    RawAddress rawAddr = RawAddress::ConvertToString(this->remoteAddr_.addr);
-    IPowerManager::GetInstance().StatusUpdate(RequestStatus::BUSY, PROFILE_NAME_SPP, rawAddr);
+    // The power manager picks the sniff mode from the traffic, only a sniffing link needs waking up first.
+    IPowerManager::GetInstance().DataTransmit(RawAddress::ConvertToString(this->remoteAddr_.addr));
 
     int ret = 0;
     if (this->isNewSocket_) {
@@ -849,7 +849,6 @@ int Socket::TransportWrite(Packet *subPkt)
     } else {
         ret = this->sockTransport_->Write(subPkt);
     }
-    IPowerManager::GetInstance().StatusUpdate(RequestStatus::IDLE, PROFILE_NAME_SPP, rawAddr);
     return ret;
 }
 
@@ -31,6 +31,7 @@
 #define TRANSPORT_H
 
 #include <stdint.h>
+#include <vector>
 #include "packet.h"
 #include "raw_address.h"
 
@@ -93,6 +94,20 @@ public:
      */
     virtual void OnDataAvailable(DataTransport *transport, Packet *pkt) = 0;
 
+    /**
+     * @brief The event is triggered when several packets were received from stack at once.
+     *        The observer takes ownership of every packet, the default delivers them one by one.
+     *
+     * @param transport the pointer of the transport.
+     * @param pkts received packets, oldest first.
+     */
+    virtual void OnDataBatchAvailable(DataTransport *transport, const std::vector<Packet *> &pkts)
+    {
+        for (auto pkt : pkts) {
+            OnDataAvailable(transport, pkt);
+        }
+    }
+
     /**
      * @brief The event is triggered when peer or RFCOMM/L2CAP is not available to receive data.
      *
@@ -43,6 +43,12 @@ static const int L2CAP_CONFIG_FLUSHTTIMEOUT = 0xFFFF;
 static const int L2CAP_CONFIG_FCS = 0x01;
 static const int L2CAP_CONFIG_RFC_MODE = 0x03;
 
+// Received packets queued per L2CAP channel. Local busy is set at the high-water mark, leaving room for a
+// full ERTM transmit window still in flight, and cleared once the queue drains below the low-water mark.
+static const int L2CAP_RECV_QUEUE_CAPACITY = 128;
+static const int L2CAP_RECV_QUEUE_HIGH_WATER = 64;
+static const int L2CAP_RECV_QUEUE_LOW_WATER = 16;
+
 /**
  * @brief L2cap transport information.
  */
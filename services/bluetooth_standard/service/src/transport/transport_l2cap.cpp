@@ -37,6 +37,10 @@ L2capTransport::L2capTransport(L2capTransportInfo &createInfo)
 
 L2capTransport::~L2capTransport()
 {
+    Packet *pkt = nullptr;
+    while (recvQueue_.TryPop(pkt)) {
+        PacketFree(pkt);
+    }
 }
 
 int L2capTransport::Connect()
@@ -193,12 +197,13 @@ L2capTransport *L2capTransport::AddTransportInternal(RawAddress addr, uint16_t l
 
 L2capTransport *L2capTransport::FindClientTransport(uint16_t lcid)
 {
-    LOG_INFO("[L2capTransport]%{public}s lcid:%hu", __func__, lcid);
+    LOG_DEBUG("[L2capTransport]%{public}s lcid:%hu", __func__, lcid);
 
     L2capTransport *clientTransport = nullptr;
     std::lock_guard<std::recursive_mutex> lk(L2capTransport::g_clientTransportMutex);
-    if (g_clientTransportMap.find(lcid) != g_clientTransportMap.end()) {
-        clientTransport = g_clientTransportMap.at(lcid);
+    auto it = g_clientTransportMap.find(lcid);
+    if (it != g_clientTransportMap.end()) {
+        clientTransport = it->second;
     } else {
         LOG_DEBUG("[L2capTransport]%{public}s transport does not exist", __func__);
     }
@@ -225,7 +230,7 @@ L2capTransport *L2capTransport::FindAcceptTransport(L2capTransport *transport, u
 
 L2capTransport *L2capTransport::GetTransport(uint16_t lcid, void *ctx)
 {
-    LOG_INFO("[L2capTransport]%{public}s lcid:%hu", __func__, lcid);
+    LOG_DEBUG("[L2capTransport]%{public}s lcid:%hu", __func__, lcid);
 
     L2capTransport *transport = nullptr;
     if (ctx != nullptr) {
@@ -406,7 +411,7 @@ void L2capTransport::TransportDisconnectAbnormalCallback(uint16_t lcid, uint8_t
 
 void L2capTransport::TransportRecvDataCallback(uint16_t lcid, Packet *pkt, void *ctx)
 {
-    LOG_INFO("[L2capTransport]%{public}s lcid:%hu", __func__, lcid);
+    LOG_DEBUG("[L2capTransport]%{public}s lcid:%hu", __func__, lcid);
 
     L2capTransport *transport = GetTransport(lcid, ctx);
 
@@ -414,9 +419,41 @@ void L2capTransport::TransportRecvDataCallback(uint16_t lcid, Packet *pkt, void
         LOG_DEBUG("[L2capTransport]%{public}s transport does not exist", __func__);
         return;
     }
-    Packet *pktref = PacketRefMalloc(pkt);
-    transport->dispatcher_.PostTask(
-        std::bind(&L2capTransport::TransportRecvDataCallbackNative, transport, transport, lcid, pktref));
+
+    if (!transport->IsServer()) {
+        transport->EnqueueRecvData(transport, lcid, PacketRefMalloc(pkt));
+        return;
+    }
+
+    // Accepted transports are only deleted after leaving transportMap_, so queue under the lock.
+    std::lock_guard<std::mutex> lock(transport->transportMutex_);
+    auto it = transport->transportMap_.find(lcid);
+    if ((it == transport->transportMap_.end()) || (it->second == nullptr)) {
+        LOG_ERROR("[L2capTransport]%{public}s handle:%hu transport does not exist", __func__, lcid);
+        return;
+    }
+    it->second->EnqueueRecvData(transport, lcid, PacketRefMalloc(pkt));
+}
+
+void L2capTransport::EnqueueRecvData(L2capTransport *transport, uint16_t lcid, Packet *pkt)
+{
+    if (!recvQueue_.TryPush(pkt)) {
+        LOG_ERROR("[L2capTransport]%{public}s lcid:%hu receive queue full, drop packet", __func__, lcid);
+        PacketFree(pkt);
+    } else if (recvQueue_.Size() >= static_cast<size_t>(L2CAP_RECV_QUEUE_HIGH_WATER)) {
+        // Requested under the lock, so the L2CAP thread gets the set and clear requests in the order decided here.
+        std::lock_guard<std::mutex> lock(localBusyMutex_);
+        if (!localBusy_) {
+            LOG_INFO("[L2capTransport]%{public}s lcid:%hu set local busy", __func__, lcid);
+            localBusy_ = true;
+            L2CIF_LocalBusy(lcid, 1, nullptr);
+        }
+    }
+
+    if (!drainPending_.exchange(true)) {
+        transport->dispatcher_.PostTask(
+            std::bind(&L2capTransport::TransportRecvDataCallbackNative, transport, transport, lcid));
+    }
 }
 
 void L2capTransport::TransportRemoteBusyCallback(uint16_t lcid, uint8_t isBusy, void *ctx)
@@ -681,20 +718,56 @@ void L2capTransport::TransportDisconnectAbnormalCallbackNative(L2capTransport *t
     }
 }
 
-void L2capTransport::TransportRecvDataCallbackNative(L2capTransport *transport, uint16_t lcid, Packet *pkt)
+void L2capTransport::TransportRecvDataCallbackNative(L2capTransport *transport, uint16_t lcid)
 {
-    LOG_INFO("[L2capTransport]%{public}s lcid:%hu", __func__, lcid);
+    LOG_DEBUG("[L2capTransport]%{public}s lcid:%hu", __func__, lcid);
 
     if (!transport->IsServer()) {
-        transport->observer_.OnDataAvailable(transport, pkt);
+        transport->DrainRecvData(lcid);
         return;
     }
 
-    std::lock_guard<std::mutex> lock(transport->transportMutex_);
-    if (transport->transportMap_.find(lcid) != transport->transportMap_.end()) {
-        transport->observer_.OnDataAvailable(transport->transportMap_.at(lcid), pkt);
-    } else {
+    // Accepted transports leave transportMap_ on this dispatcher, so the one found stays valid here.
+    L2capTransport *l2capTransport = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(transport->transportMutex_);
+        auto it = transport->transportMap_.find(lcid);
+        if (it != transport->transportMap_.end()) {
+            l2capTransport = it->second;
+        }
+    }
+    if (l2capTransport == nullptr) {
         LOG_ERROR("[L2capTransport]%{public}s handle:%hu transport does not exist", __FUNCTION__, lcid);
+        return;
+    }
+    l2capTransport->DrainRecvData(lcid);
+}
+
+void L2capTransport::DrainRecvData(uint16_t lcid)
+{
+    // Cleared before draining, so a packet queued from now on posts another drain.
+    drainPending_.store(false);
+
+    Packet *pkt = nullptr;
+    while (recvQueue_.TryPop(pkt)) {
+        recvBatch_.push_back(pkt);
+    }
+
+    if (!recvBatch_.empty()) {
+        LOG_DEBUG("[L2capTransport]%{public}s lcid:%hu packets:%{public}d",
+            __func__, lcid, static_cast<int>(recvBatch_.size()));
+        observer_.OnDataBatchAvailable(this, recvBatch_);
+        recvBatch_.clear();
+    }
+
+    // Cleared once the batch is consumed, and only if the producer has not refilled the queue meanwhile.
+    if (recvQueue_.Size() <= static_cast<size_t>(L2CAP_RECV_QUEUE_LOW_WATER)) {
+        std::lock_guard<std::mutex> lock(localBusyMutex_);
+        if (localBusy_ && (recvQueue_.Size() <= static_cast<size_t>(L2CAP_RECV_QUEUE_LOW_WATER))) {
+            LOG_INFO("[L2capTransport]%{public}s lcid:%hu clear local busy", __func__, lcid);
+            localBusy_ = false;
+            L2CIF_LocalBusy(lcid, 0, nullptr);
+        }
     }
 }
 
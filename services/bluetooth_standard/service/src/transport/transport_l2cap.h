@@ -16,12 +16,15 @@
 #ifndef TRANSPORT_L2CAP_H
 #define TRANSPORT_L2CAP_H
 
+#include <atomic>
 #include <map>
 #include <mutex>
 #include <stdint.h>
+#include <vector>
 #include "l2cap_if.h"
 #include "packet.h"
 #include "raw_address.h"
+#include "spsc_ring.h"
 #include "transport_def.h"
 
 namespace bluetooth {
@@ -287,12 +290,29 @@ private:
     void TransportDisconnectAbnormalCallbackNative(L2capTransport *transport, uint16_t lcid, uint8_t reason);
 
     /**
-     * @brief L2cap event
+     * @brief Drain the receive queue of a channel and deliver the packets as one batch.
+     *
+     * @param transport the transport registered to L2CAP.
+     * @param lcid local channel id.
+     */
+    void TransportRecvDataCallbackNative(L2capTransport *transport, uint16_t lcid);
+
+    /**
+     * @brief Queue a received packet on this channel, called on the L2CAP thread.
+     *        Posts a drain task unless one is pending, and sets local busy at the high-water mark.
+     *
+     * @param transport the transport registered to L2CAP, the drain task runs on it.
+     * @param lcid local channel id.
+     * @param pkt received packet.
+     */
+    void EnqueueRecvData(L2capTransport *transport, uint16_t lcid, Packet *pkt);
+
+    /**
+     * @brief Take all queued packets of this channel and deliver them to the observer.
      *
      * @param lcid local channel id.
-     * @param result if the operation is successful, otherwise the operation fails.
      */
-    void TransportRecvDataCallbackNative(L2capTransport *transport, uint16_t lcid, Packet *pkt);
+    void DrainRecvData(uint16_t lcid);
 
     /**
      * @brief L2cap event
@@ -378,6 +398,15 @@ private:
     std::map<RawAddress, ConnectReqInfo> handleMap_ {};
     // The map manages the correspondence between new transport and rfcomm handle.
     std::map<L2capTransport *, RawAddress> remoteAddrMap_ {};
+    // Packets received on this channel, produced by the L2CAP thread and consumed by the dispatcher.
+    utility::SpscRing<Packet *> recvQueue_ {L2CAP_RECV_QUEUE_CAPACITY};
+    // Packets taken from recvQueue_ by one drain.
+    std::vector<Packet *> recvBatch_ {};
+    // A drain task is posted and has not started yet.
+    std::atomic_bool drainPending_ {false};
+    // Local busy is set on this channel, changed and requested to L2CAP under localBusyMutex_.
+    bool localBusy_ {false};
+    std::mutex localBusyMutex_ {};
     // the pointer of the DataTransportObserver
     DataTransportObserver &observer_;
     utility::Dispatcher &dispatcher_;
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "at_command_tokenizer.h"
+
+#include "log.h"
+
+namespace utility {
+void AtCommandTokenizer::Reset()
+{
+    pending_.clear();
+    overflow_ = false;
+}
+
+std::string_view AtCommandTokenizer::Trim(std::string_view line)
+{
+    // null characters and blanks between commands are ignored
+    size_t begin = 0;
+    while ((begin < line.size()) && ((line[begin] == '\0') || (line[begin] == ' '))) {
+        begin++;
+    }
+    size_t end = line.size();
+    while ((end > begin) && ((line[end - 1] == '\0') || (line[end - 1] == ' '))) {
+        end--;
+    }
+    return line.substr(begin, end - begin);
+}
+
+void AtCommandTokenizer::Append(const char *data, size_t len)
+{
+    if (overflow_) {
+        return;
+    }
+
+    if (pending_.size() + len > MAX_LINE_LENGTH) {
+        LOG_WARN("%{public}s(): line exceeds %{public}zu bytes, discard it", __FUNCTION__, MAX_LINE_LENGTH);
+        pending_.clear();
+        overflow_ = true;
+        return;
+    }
+    pending_.append(data, len);
+}
+}  // namespace utility
@@ -0,0 +1,255 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AT_COMMAND_TOKENIZER_H
+#define AT_COMMAND_TOKENIZER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "base_def.h"
+
+namespace utility {
+/**
+ * @brief Perfect hash table of AT command names, built at compile time.
+ *        Find() costs one hash of the name and one string compare.
+ *
+ * @tparam N Number of command names.
+ * @since 6
+ */
+template<size_t N>
+class AtCommandTable {
+public:
+    static constexpr int INVALID_INDEX = -1;
+
+    /**
+     * @brief Construct a new AtCommandTable object.
+     *
+     * @param names Command names, the index of a name is the value returned by Find().
+     * @since 6
+     */
+    constexpr explicit AtCommandTable(const std::array<std::string_view, N> &names) : names_(names)
+    {
+        for (uint32_t seed = 1; seed <= MAX_SEED; seed++) {
+            if (TryBuild(seed)) {
+                seed_ = seed;
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Check whether a collision free seed was found for the names.
+     *
+     * @return Returns true if the table is a perfect hash, else return false.
+     * @since 6
+     */
+    constexpr bool IsPerfect() const
+    {
+        return seed_ != 0;
+    }
+
+    /**
+     * @brief Find a command name.
+     *
+     * @param name Command name.
+     * @return Returns the index of the name, INVALID_INDEX if not in the table.
+     * @since 6
+     */
+    constexpr int Find(std::string_view name) const
+    {
+        uint8_t index = slots_[Hash(name, seed_) & SLOT_MASK];
+        if ((index == EMPTY_SLOT) || (names_[index] != name)) {
+            return INVALID_INDEX;
+        }
+        return index;
+    }
+
+    /**
+     * @brief Get the command name at index.
+     *
+     * @param index Command index.
+     * @return Returns the command name.
+     * @since 6
+     */
+    constexpr std::string_view Name(size_t index) const
+    {
+        return names_[index];
+    }
+
+    /**
+     * @brief Get the number of command names.
+     *
+     * @return Returns the number of command names.
+     * @since 6
+     */
+    static constexpr size_t Size()
+    {
+        return N;
+    }
+
+private:
+    static constexpr size_t SlotNum()
+    {
+        size_t num = 1;
+        while (num < N * SLOT_FACTOR) {
+            num <<= 1;
+        }
+        return num;
+    }
+
+    static constexpr uint32_t Hash(std::string_view name, uint32_t seed)
+    {
+        uint32_t hash = FNV_OFFSET_BASIS ^ (seed * FNV_PRIME);
+        for (char c : name) {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= FNV_PRIME;
+        }
+        return hash ^ (hash >> HASH_FOLD_SHIFT);
+    }
+
+    constexpr bool TryBuild(uint32_t seed)
+    {
+        for (auto &slot : slots_) {
+            slot = EMPTY_SLOT;
+        }
+        for (size_t i = 0; i < N; i++) {
+            uint8_t &slot = slots_[Hash(names_[i], seed) & SLOT_MASK];
+            if (slot != EMPTY_SLOT) {
+                return false;
+            }
+            slot = static_cast<uint8_t>(i);
+        }
+        return true;
+    }
+
+    static_assert(N < 0xFF, "AtCommandTable supports less than 255 names");
+
+    static constexpr size_t SLOT_FACTOR = 4;
+    static constexpr size_t SLOT_MASK = SlotNum() - 1;
+    static constexpr uint32_t MAX_SEED = 4096;
+    static constexpr uint32_t FNV_OFFSET_BASIS = 2166136261U;
+    static constexpr uint32_t FNV_PRIME = 16777619U;
+    static constexpr uint32_t HASH_FOLD_SHIFT = 16;
+    static constexpr uint8_t EMPTY_SLOT = 0xFF;
+
+    std::array<std::string_view, N> names_ {};
+    std::array<uint8_t, SlotNum()> slots_ {};
+    uint32_t seed_ {0};
+};
+
+/**
+ * @brief Incremental AT command tokenizer.
+ *        Splits a byte stream into lines terminated by <cr> or <lf>. Lines that are complete inside one buffer are
+ *        passed to the handler without copy; a line split across buffers is carried over to the next Feed().
+ *
+ * @since 6
+ */
+class AtCommandTokenizer {
+public:
+    /**
+     * @brief Construct a new AtCommandTokenizer object.
+     *
+     * @since 6
+     */
+    AtCommandTokenizer() = default;
+
+    /**
+     * @brief Destroy the AtCommandTokenizer object.
+     *
+     * @since 6
+     */
+    ~AtCommandTokenizer() = default;
+
+    /**
+     * @brief Feed received data to tokenizer.
+     *
+     * @param data Data buffer pointer.
+     * @param len Data buffer length.
+     * @param handler Called as handler(std::string_view line) for each complete non-empty line. The line is only
+     *                valid during the call.
+     * @since 6
+     */
+    template<typename Handler>
+    void Feed(const uint8_t *data, size_t len, Handler &&handler);
+
+    /**
+     * @brief Drop the partially received line.
+     *
+     * @since 6
+     */
+    void Reset();
+
+    /**
+     * @brief Get the partially received line length.
+     *
+     * @return Returns the pending length.
+     * @since 6
+     */
+    size_t PendingSize() const
+    {
+        return pending_.size();
+    }
+
+    static constexpr size_t MAX_LINE_LENGTH = 512;
+
+private:
+    static std::string_view Trim(std::string_view line);
+    void Append(const char *data, size_t len);
+
+    std::string pending_ {};
+    bool overflow_ {false};
+
+    DISALLOW_COPY_AND_ASSIGN(AtCommandTokenizer);
+};
+
+template<typename Handler>
+void AtCommandTokenizer::Feed(const uint8_t *data, size_t len, Handler &&handler)
+{
+    if (data == nullptr) {
+        return;
+    }
+
+    const char *chars = reinterpret_cast<const char *>(data);
+    size_t start = 0;
+    for (size_t pos = 0; pos < len; pos++) {
+        if ((chars[pos] != '\r') && (chars[pos] != '\n')) {
+            continue;
+        }
+
+        std::string_view line(chars + start, pos - start);
+        if (!pending_.empty() || overflow_) {
+            Append(line.data(), line.size());
+            line = overflow_ ? std::string_view() : std::string_view(pending_);
+        }
+        line = Trim(line);
+        if (!line.empty()) {
+            handler(line);
+        }
+        pending_.clear();
+        overflow_ = false;
+        start = pos + 1;
+    }
+
+    if (start < len) {
+        Append(chars + start, len - start);
+    }
+}
+}  // namespace utility
+
+#endif  // AT_COMMAND_TOKENIZER_H
@@ -15,6 +15,7 @@
 
 #include "dispatcher.h"
 #include "log.h"
+#include "perf_counter.h"
 
 namespace utility {
 static void EmptyTask()
@@ -43,7 +44,8 @@ void Dispatcher::Uninitialize()
     std::lock_guard<std::mutex> lock(mutex_);
     if (start_) {
         start_ = false;
-        taskQueue_.Push(std::bind(EmptyTask));
+        pendingTasks_.fetch_add(1, std::memory_order_relaxed);
+        taskQueue_.Push({std::bind(EmptyTask), PerfClockUs()});
         if (thread_ && thread_->joinable()) {
             thread_->join();
             thread_ = nullptr;
@@ -54,7 +56,8 @@ void Dispatcher::Uninitialize()
 void Dispatcher::PostTask(const std::function<void()> &task)
 {
     if (start_) {
-        taskQueue_.Push(std::move(task));
+        PerfHistogramRecord(PERF_HISTOGRAM_DISPATCHER_QUEUE_DEPTH, pendingTasks_.fetch_add(1, std::memory_order_relaxed));
+        taskQueue_.Push({task, PerfClockUs()});
     }
 }
 
@@ -69,9 +72,11 @@ void Dispatcher::Run(std::promise<void> promise)
     promise.set_value();
 
     while (start_) {
-        std::function<void()> task;
+        Task task;
         taskQueue_.Pop(task);
-        task();
+        pendingTasks_.fetch_sub(1, std::memory_order_relaxed);
+        PerfHistogramRecord(PERF_HISTOGRAM_DISPATCHER_TASK_LATENCY_US, PerfClockUs() - task.postedUs);
+        task.function();
     }
 
     // If there are tasks in the queue. will not execute them.
@@ -73,6 +73,11 @@ public:
     const std::string &Name() const;
 
 private:
+    struct Task {
+        std::function<void()> function {};
+        uint64_t postedUs {0};
+    };
+
     /**
      * @brief Run Dispatcher function.
      *
@@ -85,7 +90,8 @@ private:
     std::mutex mutex_ {};
     std::unique_ptr<std::thread> thread_ {nullptr};
     std::atomic_bool start_ = ATOMIC_FLAG_INIT;
-    utility::FixedQueue<std::function<void()>> taskQueue_ {};
+    std::atomic_uint pendingTasks_ {0};
+    utility::FixedQueue<Task> taskQueue_ {};
 
     DISALLOW_COPY_AND_ASSIGN(Dispatcher);
 };
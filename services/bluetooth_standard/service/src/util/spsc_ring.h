@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <memory>
+#include "base_def.h"
+
+namespace utility {
+/**
+ * @brief Bounded lock free queue for exactly one producer thread and one consumer thread.
+ *
+ * TryPush may only be called from the producer and TryPop only from the consumer. Size can be called from
+ * either side and is exact from the caller's own side.
+ */
+template<class T>
+class SpscRing {
+public:
+    /**
+     * @brief Construct a new SpscRing object
+     *
+     * @param capacity Ring's capacity, rounded up to a power of two.
+     * @since 6
+     */
+    explicit SpscRing(size_t capacity);
+
+    /**
+     * @brief Destroy the SpscRing object
+     *
+     * @since 6
+     */
+    ~SpscRing() = default;
+
+    /**
+     * @brief Try push one record into SpscRing, producer side only.
+     *
+     * @param record Push record.
+     * @return Success push record return true, return false if the ring is full.
+     * @since 6
+     */
+    bool TryPush(T record);
+
+    /**
+     * @brief Try pop one record from SpscRing, consumer side only.
+     *
+     * @param record Pop record object result.
+     * @return Success pop record return true, return false if the ring is empty.
+     * @since 6
+     */
+    bool TryPop(T &record);
+
+    /**
+     * @brief Get the number of records in SpscRing.
+     *
+     * @return Returns the number of records.
+     * @since 6
+     */
+    size_t Size() const;
+
+    /**
+     * @brief Get the capacity of SpscRing.
+     *
+     * @return Returns the capacity.
+     * @since 6
+     */
+    size_t Capacity() const
+    {
+        return mask_ + 1;
+    }
+
+private:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    static size_t RoundUpPowerOfTwo(size_t value);
+
+    size_t mask_ {0};
+    std::unique_ptr<T[]> buffer_ {};
+    // Written by the consumer only.
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_ {0};
+    // Written by the producer only.
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_ {0};
+
+    DISALLOW_COPY_AND_ASSIGN(SpscRing);
+};
+
+template<class T>
+SpscRing<T>::SpscRing(size_t capacity)
+    : mask_(RoundUpPowerOfTwo(capacity) - 1), buffer_(std::make_unique<T[]>(mask_ + 1))
+{}
+
+template<class T>
+size_t SpscRing<T>::RoundUpPowerOfTwo(size_t value)
+{
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+template<class T>
+bool SpscRing<T>::TryPush(T record)
+{
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) > mask_) {
+        return false;
+    }
+
+    buffer_[tail & mask_] = std::move(record);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+template<class T>
+bool SpscRing<T>::TryPop(T &record)
+{
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    record = std::move(buffer_[head & mask_]);
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+template<class T>
+size_t SpscRing<T>::Size() const
+{
+    size_t head = head_.load(std::memory_order_acquire);
+    size_t tail = tail_.load(std::memory_order_acquire);
+    return tail - head;
+}
+}  // namespace utility
+
+#endif  // SPSC_RING_H
@@ -407,6 +407,44 @@ bool XmlParse::GetSubSections(const std::string &section, std::vector<std::strin
     return true;
 }
 
+bool XmlParse::GetSections(std::vector<std::string> &sections)
+{
+    xmlNodePtr rootNode = xmlDocGetRootElement(pimpl->doc_);
+    if (rootNode == NULL) {
+        return false;
+    }
+    for (xmlNodePtr btSectionNode = rootNode->children; btSectionNode; btSectionNode = btSectionNode->next) {
+        xmlChar *btSectionNodeProp = xmlGetProp(btSectionNode, BAD_CAST "section");
+        if (btSectionNodeProp == NULL) {
+            continue;
+        }
+        sections.push_back((char *)btSectionNodeProp);
+        xmlFree(btSectionNodeProp);
+    }
+    return (sections.size() != 0);
+}
+
+bool XmlParse::GetProperties(
+    const std::string &section, const std::string &subSection, std::map<std::string, std::string> &properties)
+{
+    xmlNodePtr sectionNode = pimpl->IntHasSection(section, subSection);
+    if (sectionNode == NULL) {
+        return false;
+    }
+    for (xmlNodePtr btPropertyNode = sectionNode->children; btPropertyNode; btPropertyNode = btPropertyNode->next) {
+        xmlChar *btPropertyNodeProp = xmlGetProp(btPropertyNode, BAD_CAST "property");
+        if (btPropertyNodeProp == NULL) {
+            continue;
+        }
+        std::string value;
+        if (pimpl->GetValue(btPropertyNode, value)) {
+            properties[(char *)btPropertyNodeProp] = value;
+        }
+        xmlFree(btPropertyNodeProp);
+    }
+    return true;
+}
+
 bool XmlParse::RemoveSection(const std::string &section, const std::string &subSection)
 {
     xmlNodePtr rootNode = xmlDocGetRootElement(pimpl->doc_);
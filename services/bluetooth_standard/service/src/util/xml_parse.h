@@ -164,6 +164,27 @@ public:
      */
     bool GetSubSections(const std::string &section, std::vector<std::string> &subSections);
 
+    /**
+     * @brief Get all top level section names.
+     *
+     * @param sections Section names in document order.
+     * @return XML document has one or more sections return true, else return false.
+     * @since 6
+     */
+    bool GetSections(std::vector<std::string> &sections);
+
+    /**
+     * @brief Get all properties of a section as raw strings.
+     *
+     * @param section Xml section.
+     * @param subSection Xml subSection, empty for the section itself.
+     * @param properties Property name to raw node content.
+     * @return Specified section exists return true, else return false.
+     * @since 6
+     */
+    bool GetProperties(
+        const std::string &section, const std::string &subSection, std::map<std::string, std::string> &properties);
+
     /**
      * @brief Whether XML document has specified property.
      *
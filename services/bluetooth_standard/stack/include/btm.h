@@ -185,6 +185,35 @@ uint8_t BTSTACK_API BTM_GetAclTranspot(uint16_t connectionHandle);
  */
 int BTSTACK_API BTM_ReadRssi(const BtAddr *addr);
 
+/**
+ * @brief Get the number of ACL data packets of a BR/EDR connection that are queued in the host or held by the
+ *        controller and not completed yet. A growing value means the link is congested.
+ *
+ * @param addr Point to the remote address struct.
+ * @param queueLength Obtain the number of queued packets.
+ * @return Returns <b>BT_NO_ERROR</b> if the operation is successful; returns others if the operation fails.
+ */
+int BTSTACK_API BTM_GetAclTxQueueLength(const BtAddr *addr, uint16_t *queueLength);
+
+typedef struct {
+    uint64_t txPackets;
+    uint64_t txBytes;
+    uint64_t rxPackets;
+    uint64_t rxBytes;
+    uint32_t idleMs;  // Time since the last ACL data sent or received, or since the connection if none.
+} BtmAclTrafficStats;
+
+/**
+ * @brief Get the ACL data sent and received on a connection since it was established, for power policies to tell
+ *        a busy link from an idle one. Both directions are counted per L2CAP PDU, its basic header included, so the
+ *        counts are not affected by HCI fragmentation.
+ *
+ * @param addr Point to the remote address struct.
+ * @param stats Obtain the traffic statistics.
+ * @return Returns <b>BT_NO_ERROR</b> if the operation is successful; returns others if the operation fails.
+ */
+int BTSTACK_API BTM_GetAclTrafficStats(const BtAddr *addr, BtmAclTrafficStats *stats);
+
 #define BTM_ROLE_MASTER 0x00
 #define BTM_ROLE_SLAVE 0x01
 
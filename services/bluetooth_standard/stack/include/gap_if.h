@@ -205,6 +205,9 @@ typedef void (*GapEncryptionChangeCallback)(const BtAddr *addr, uint8_t status,
 #define GAP_INQUIRY_MODE_GENERAL 0x00
 #define GAP_INQUIRY_MODE_LIMITED 0x01
 
+/// Maximum number of remote name requests outstanding at the same time
+#define GAP_REMOTE_NAME_REQUEST_MAX 4
+
 /**
  * @brief       Device discover callback structure.
  */
@@ -473,9 +476,12 @@ BTSTACK_API int GAPIF_Inquiry(uint8_t mode, uint8_t inquiryLength);
 BTSTACK_API int GAPIF_InquiryCancel(void);
 
 /**
- * @brief       Get remote device name
+ * @brief       Get remote device name. Up to GAP_REMOTE_NAME_REQUEST_MAX requests to different devices
+ *              may be outstanding.
  * @param[in]   addr                target device address
  * @return      @c BT_NO_ERROR      : The function is executed successfully.
+ *              @c GAP_ERR_REPEATED : A request to this device is outstanding.
+ *              @c GAP_ERR_OUT_OF_RES : Too many requests are outstanding.
  *              @c otherwise        : The function is not executed successfully.
  */
 BTSTACK_API int GAPIF_GetRemoteName(const BtAddr *addr);
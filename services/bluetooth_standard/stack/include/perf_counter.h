@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @addtogroup Bluetooth
+ * @{
+ *
+ * @brief Bluetooth Basic tool library, This file is part of BTStack.
+ *        Runtime performance counters and histograms.
+ *
+ *        Updates go to one of several cache line aligned shards picked per thread, so concurrent
+ *        writers do not contend. A snapshot sums the shards and may be taken from any thread.
+ *
+ * @since 1.0
+ * @version 1.0
+ */
+
+#ifndef PERF_COUNTER_H
+#define PERF_COUNTER_H
+
+#include <stdint.h>
+
+#include "btstack.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    PERF_COUNTER_HCI_TX_PACKETS,
+    PERF_COUNTER_HCI_TX_BYTES,
+    PERF_COUNTER_HCI_RX_PACKETS,
+    PERF_COUNTER_HCI_RX_BYTES,
+    PERF_COUNTER_ACL_CREDIT_STALLS,     // ACL packets queued because the controller had no free buffer.
+    PERF_COUNTER_L2CAP_RETRANSMITS,     // ERTM I-frames sent again.
+    PERF_COUNTER_SCAN_REPORTS_DROPPED,  // LE advertising reports discarded before reaching a scan callback.
+    PERF_COUNTER_SNOOP_DROPS,           // Records not fully written to the btsnoop file.
+    PERF_COUNTER_PM_ACTIVE_DECISIONS,   // Links the traffic policy moved out of sniff mode.
+    PERF_COUNTER_PM_SNIFF_DECISIONS,    // Links the traffic policy let back into sniff mode.
+    PERF_COUNTER_PM_SNIFF_HELD,         // Idle gaps the traffic policy kept a link active through.
+    PERF_COUNTER_MAX,
+} PerfCounterId;
+
+typedef enum {
+    PERF_HISTOGRAM_ACL_CREDIT_STALL_US,         // Time ACL packets stayed queued waiting for controller buffers.
+    PERF_HISTOGRAM_ATT_QUEUE_WAIT_US,           // Time an ATT request waited behind an outstanding one.
+    PERF_HISTOGRAM_DISPATCHER_QUEUE_DEPTH,      // Tasks pending on a dispatcher when a new one is posted.
+    PERF_HISTOGRAM_DISPATCHER_TASK_LATENCY_US,  // Time from posting a dispatcher task to running it.
+    PERF_HISTOGRAM_A2DP_ENCODE_US,              // Time to encode one A2DP media frame.
+    PERF_HISTOGRAM_MAX,
+} PerfHistogramId;
+
+// Bucket 0 holds the value 0, bucket n holds values in [2^(n-1), 2^n), the last bucket everything above.
+#define PERF_HISTOGRAM_BUCKETS 32
+
+typedef struct {
+    uint64_t count;
+    uint64_t sum;
+    uint64_t buckets[PERF_HISTOGRAM_BUCKETS];
+} PerfHistogramData;
+
+typedef struct {
+    uint64_t counters[PERF_COUNTER_MAX];
+    PerfHistogramData histograms[PERF_HISTOGRAM_MAX];
+} PerfSnapshotData;
+
+/**
+ * @brief Add a value to a counter.
+ *
+ * @param id Counter id.
+ * @param value Value to add.
+ * @since 1.0
+ * @version 1.0
+ */
+BTSTACK_API void PerfCounterAdd(PerfCounterId id, uint64_t value);
+
+/**
+ * @brief Record one sample in a histogram.
+ *
+ * @param id Histogram id.
+ * @param value Sample value.
+ * @since 1.0
+ * @version 1.0
+ */
+BTSTACK_API void PerfHistogramRecord(PerfHistogramId id, uint64_t value);
+
+/**
+ * @brief Monotonic time in microseconds, for timing histogram samples.
+ *
+ * @return Microseconds since an unspecified point in the past.
+ * @since 1.0
+ * @version 1.0
+ */
+BTSTACK_API uint64_t PerfClockUs(void);
+
+/**
+ * @brief Sum all shards into a snapshot. Updates made during the call may or may not be included.
+ *
+ * @param snapshot Snapshot to fill.
+ * @since 1.0
+ * @version 1.0
+ */
+BTSTACK_API void PerfSnapshot(PerfSnapshotData *snapshot);
+
+/**
+ * @brief Clear all counters and histograms.
+ *
+ * @since 1.0
+ * @version 1.0
+ */
+BTSTACK_API void PerfReset(void);
+
+/**
+ * @brief Get the approximate value below which the given percentage of the samples fall.
+ *
+ * @param histogram Histogram from a snapshot.
+ * @param percentile Percentile, 0 to 100.
+ * @return Upper bound of the bucket holding the percentile, 0 if the histogram is empty.
+ * @since 1.0
+ * @version 1.0
+ */
+BTSTACK_API uint64_t PerfHistogramPercentile(const PerfHistogramData *histogram, uint32_t percentile);
+
+/**
+ * @brief Get the name of a counter.
+ *
+ * @param id Counter id.
+ * @return Counter name, "unknown" for an invalid id.
+ * @since 1.0
+ * @version 1.0
+ */
+BTSTACK_API const char *PerfCounterName(PerfCounterId id);
+
+/**
+ * @brief Get the name of a histogram.
+ *
+ * @param id Histogram id.
+ * @return Histogram name, "unknown" for an invalid id.
+ * @since 1.0
+ * @version 1.0
+ */
+BTSTACK_API const char *PerfHistogramName(PerfHistogramId id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // PERF_COUNTER_H
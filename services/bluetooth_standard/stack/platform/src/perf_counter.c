@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "perf_counter.h"
+#include <stdatomic.h>
+#include <string.h>
+#include <time.h>
+
+#define PERF_SHARDS 16
+#define PERF_CACHE_LINE 64
+#define PERF_PERCENT 100
+#define PERF_US_PER_SECOND 1000000ULL
+#define PERF_NS_PER_US 1000
+
+typedef struct {
+    atomic_uint_fast64_t count;
+    atomic_uint_fast64_t sum;
+    atomic_uint_fast64_t buckets[PERF_HISTOGRAM_BUCKETS];
+} PerfHistogramShard;
+
+// Each thread writes to one shard, so a shard's cache line is rarely shared between writers.
+typedef struct {
+    _Alignas(PERF_CACHE_LINE) atomic_uint_fast64_t counters[PERF_COUNTER_MAX];
+    PerfHistogramShard histograms[PERF_HISTOGRAM_MAX];
+} PerfShard;
+
+static PerfShard g_perfShards[PERF_SHARDS];
+static atomic_uint g_perfNextShard = 0;
+static _Thread_local PerfShard *g_perfThreadShard = NULL;
+
+static const char *const g_perfCounterNames[PERF_COUNTER_MAX] = {
+    "hci_tx_packets",
+    "hci_tx_bytes",
+    "hci_rx_packets",
+    "hci_rx_bytes",
+    "acl_credit_stalls",
+    "l2cap_retransmits",
+    "scan_reports_dropped",
+    "snoop_drops",
+    "pm_active_decisions",
+    "pm_sniff_decisions",
+    "pm_sniff_held",
+};
+
+static const char *const g_perfHistogramNames[PERF_HISTOGRAM_MAX] = {
+    "acl_credit_stall_us",
+    "att_queue_wait_us",
+    "dispatcher_queue_depth",
+    "dispatcher_task_latency_us",
+    "a2dp_encode_us",
+};
+
+static PerfShard *PerfGetThreadShard()
+{
+    PerfShard *shard = g_perfThreadShard;
+    if (shard == NULL) {
+        unsigned int index = atomic_fetch_add_explicit(&g_perfNextShard, 1, memory_order_relaxed) % PERF_SHARDS;
+        shard = &g_perfShards[index];
+        g_perfThreadShard = shard;
+    }
+    return shard;
+}
+
+static uint32_t PerfBucketIndex(uint64_t value)
+{
+    if (value == 0) {
+        return 0;
+    }
+    uint32_t index = (uint32_t)(64 - __builtin_clzll(value));
+    return (index < PERF_HISTOGRAM_BUCKETS) ? index : (PERF_HISTOGRAM_BUCKETS - 1);
+}
+
+void PerfCounterAdd(PerfCounterId id, uint64_t value)
+{
+    if ((uint32_t)id >= PERF_COUNTER_MAX) {
+        return;
+    }
+    atomic_fetch_add_explicit(&PerfGetThreadShard()->counters[id], value, memory_order_relaxed);
+}
+
+void PerfHistogramRecord(PerfHistogramId id, uint64_t value)
+{
+    if ((uint32_t)id >= PERF_HISTOGRAM_MAX) {
+        return;
+    }
+    PerfHistogramShard *histogram = &PerfGetThreadShard()->histograms[id];
+    atomic_fetch_add_explicit(&histogram->count, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&histogram->sum, value, memory_order_relaxed);
+    atomic_fetch_add_explicit(&histogram->buckets[PerfBucketIndex(value)], 1, memory_order_relaxed);
+}
+
+uint64_t PerfClockUs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * PERF_US_PER_SECOND + (uint64_t)ts.tv_nsec / PERF_NS_PER_US;
+}
+
+void PerfSnapshot(PerfSnapshotData *snapshot)
+{
+    if (snapshot == NULL) {
+        return;
+    }
+    (void)memset(snapshot, 0, sizeof(PerfSnapshotData));
+    for (int s = 0; s < PERF_SHARDS; s++) {
+        PerfShard *shard = &g_perfShards[s];
+        for (int c = 0; c < PERF_COUNTER_MAX; c++) {
+            snapshot->counters[c] += atomic_load_explicit(&shard->counters[c], memory_order_relaxed);
+        }
+        for (int h = 0; h < PERF_HISTOGRAM_MAX; h++) {
+            PerfHistogramShard *from = &shard->histograms[h];
+            PerfHistogramData *to = &snapshot->histograms[h];
+            to->count += atomic_load_explicit(&from->count, memory_order_relaxed);
+            to->sum += atomic_load_explicit(&from->sum, memory_order_relaxed);
+            for (int b = 0; b < PERF_HISTOGRAM_BUCKETS; b++) {
+                to->buckets[b] += atomic_load_explicit(&from->buckets[b], memory_order_relaxed);
+            }
+        }
+    }
+}
+
+void PerfReset(void)
+{
+    for (int s = 0; s < PERF_SHARDS; s++) {
+        PerfShard *shard = &g_perfShards[s];
+        for (int c = 0; c < PERF_COUNTER_MAX; c++) {
+            atomic_store_explicit(&shard->counters[c], 0, memory_order_relaxed);
+        }
+        for (int h = 0; h < PERF_HISTOGRAM_MAX; h++) {
+            PerfHistogramShard *histogram = &shard->histograms[h];
+            atomic_store_explicit(&histogram->count, 0, memory_order_relaxed);
+            atomic_store_explicit(&histogram->sum, 0, memory_order_relaxed);
+            for (int b = 0; b < PERF_HISTOGRAM_BUCKETS; b++) {
+                atomic_store_explicit(&histogram->buckets[b], 0, memory_order_relaxed);
+            }
+        }
+    }
+}
+
+uint64_t PerfHistogramPercentile(const PerfHistogramData *histogram, uint32_t percentile)
+{
+    if ((histogram == NULL) || (histogram->count == 0)) {
+        return 0;
+    }
+    if (percentile > PERF_PERCENT) {
+        percentile = PERF_PERCENT;
+    }
+    // Rank of the sample, rounded up so that any percentile above 0 needs at least one sample.
+    uint64_t rank = (histogram->count * percentile + PERF_PERCENT - 1) / PERF_PERCENT;
+    uint64_t seen = 0;
+    for (uint32_t b = 0; b < PERF_HISTOGRAM_BUCKETS; b++) {
+        seen += histogram->buckets[b];
+        if ((seen >= rank) && (seen > 0)) {
+            return (b == 0) ? 0 : ((1ULL << b) - 1);
+        }
+    }
+    return (1ULL << (PERF_HISTOGRAM_BUCKETS - 1)) - 1;
+}
+
+const char *PerfCounterName(PerfCounterId id)
+{
+    return ((uint32_t)id < PERF_COUNTER_MAX) ? g_perfCounterNames[id] : "unknown";
+}
+
+const char *PerfHistogramName(PerfHistogramId id)
+{
+    return ((uint32_t)id < PERF_HISTOGRAM_MAX) ? g_perfHistogramNames[id] : "unknown";
+}
@@ -27,6 +27,7 @@
 
 #include "alarm.h"
 #include "log.h"
+#include "perf_counter.h"
 
 #include "platform/include/allocator.h"
 
@@ -556,18 +557,48 @@ AttServerDataCallback *AttGetATTServerCallback()
     return &g_attServerCallback;
 }
 
+/**
+ * @brief remember when the request just appended to the instruction list was queued.
+ *
+ * @param connect Indicates the pointer to AttConnectInfo.
+ */
+static void AttRecordInstructQueued(AttConnectInfo *connect)
+{
+    connect->instructQueuedUs[connect->instructQueuedCount % ATT_INSTRUCT_QUEUED_SLOTS] = PerfClockUs();
+    connect->instructQueuedCount++;
+}
+
+/**
+ * @brief record how long the request at the head of the instruction list waited before being sent.
+ *        Requests are appended and sent in order, so the head is the n-th latest one queued, n being the list size.
+ *        Heads of lists longer than the remembered history are not recorded.
+ *
+ * @param connect Indicates the pointer to AttConnectInfo.
+ */
+static void AttRecordInstructQueueWait(const AttConnectInfo *connect)
+{
+    uint32_t pending = (uint32_t)ListGetSize(connect->instruct);
+    if ((pending == 0) || (pending > ATT_INSTRUCT_QUEUED_SLOTS) || (pending > connect->instructQueuedCount)) {
+        return;
+    }
+    uint32_t head = connect->instructQueuedCount - pending;
+    PerfHistogramRecord(PERF_HISTOGRAM_ATT_QUEUE_WAIT_US,
+        PerfClockUs() - connect->instructQueuedUs[head % ATT_INSTRUCT_QUEUED_SLOTS]);
+}
+
 /**
  * @brief initiative execut instructions by Scheduling.
  *
  * @param connect Indicates the pointer to AttConnectInfo.
  * @return Returns <b>0</b> if the operation is successful; returns <b>!0</b> if the operation fails.
  */
-int AttSendSequenceScheduling(const AttConnectInfo *connect)
+int AttSendSequenceScheduling(AttConnectInfo *connect)
 {
     LOG_INFO("%{public}s enter, listsize = %u", __FUNCTION__, ListGetSize(connect->instruct));
 
     int ret = BT_NO_ERROR;
 
+    AttRecordInstructQueued(connect);
     if (ListGetSize(connect->instruct) == 1) {
         ListNode *listNodePtr = ListGetFirstNode(connect->instruct);
         if (listNodePtr == NULL) {
@@ -576,6 +607,7 @@ int AttSendSequenceScheduling(const AttConnectInfo *connect)
             goto ATTSENDSEQUENCESCHEDULING_END;
         }
         Packet *packet = ListGetNodeData(listNodePtr);
+        AttRecordInstructQueueWait(connect);
         if (connect->transportType == BT_TRANSPORT_LE) {
             ret = L2CIF_LeSendFixChannelData(connect->aclHandle, (uint16_t)LE_CID, packet, LeRecvSendDataCallback);
         }
@@ -599,7 +631,7 @@ ATTSENDSEQUENCESCHEDULING_END:
  *
  * @param connect Indicates the pointer to AttConnectInfo.
  */
-void AttReceiveSequenceScheduling(const AttConnectInfo *connect)
+void AttReceiveSequenceScheduling(AttConnectInfo *connect)
 {
     LOG_INFO("%{public}s enter, listsize = %u, transportType = %hhu",
         __FUNCTION__,
@@ -615,6 +647,7 @@ void AttReceiveSequenceScheduling(const AttConnectInfo *connect)
             goto ATTRECEIVESEQUENCESCHEDULING_END;
         }
         Packet *PacketPtr = ListGetNodeData(listNodePtr);
+        AttRecordInstructQueueWait(connect);
         if (connect->transportType == BT_TRANSPORT_LE) {
             ret = L2CIF_LeSendFixChannelData(connect->aclHandle, (uint16_t)LE_CID, PacketPtr, LeRecvSendDataCallback);
         }
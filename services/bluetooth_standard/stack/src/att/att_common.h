@@ -94,6 +94,8 @@ extern "C" {
 #define IMMEDIATELY_WRITE_ALL_PENDING_PREPARED_VALUES 1
 #define CANCEL_ALL_PREPARED_WRITES 0
 
+#define ATT_INSTRUCT_QUEUED_SLOTS 16
+
 typedef struct AttConnectInfo {
     uint16_t aclHandle;
     union {
@@ -109,6 +111,8 @@ typedef struct AttConnectInfo {
     bool mtuFlag;
     uint8_t initPassConnFlag;
     List *instruct;
+    uint64_t instructQueuedUs[ATT_INSTRUCT_QUEUED_SLOTS];  // Enqueue times of the latest requests.
+    uint32_t instructQueuedCount;
     Alarm *alarm;
     bool serverSendFlag;
 } AttConnectInfo;
@@ -379,14 +383,14 @@ AttServerDataCallback *AttGetATTServerCallback();
  * @param connect Indicates the pointer to AttConnectInfo.
  * @return Returns <b>0</b> if the operation is successful; returns <b>!0</b> if the operation fails.
  */
-int AttSendSequenceScheduling(const AttConnectInfo *connect);
+int AttSendSequenceScheduling(AttConnectInfo *connect);
 
 /**
  * @brief execut instructions by Scheduling after receiving response.
  *
  * @param connect Indicates the pointer to AttConnectInfo.
  */
-void AttReceiveSequenceScheduling(const AttConnectInfo *connect);
+void AttReceiveSequenceScheduling(AttConnectInfo *connect);
 
 /**
  * @brief client call back copy.
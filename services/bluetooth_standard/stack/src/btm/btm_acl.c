@@ -16,10 +16,12 @@
 #include "btm_acl.h"
 
 #include <securec.h>
+#include <stdatomic.h>
 
 #include "hci/hci.h"
 #include "hci/hci_error.h"
 #include "log.h"
+#include "perf_counter.h"
 #include "platform/include/alarm.h"
 #include "platform/include/allocator.h"
 #include "platform/include/list.h"
@@ -47,6 +49,14 @@
 
 #define REQUEST_NOT_COMPLETED 0xff
 
+#define US_PER_MS 1000
+
+// Connection handles are 12 bits wide, so every handle the controller assigns indexes the table directly.
+#define ACL_HANDLE_TABLE_SIZE 0x1000
+#define ACL_HANDLE_MASK 0x0fff
+// Buckets of the address index, a power of 2.
+#define ACL_ADDR_BUCKET_COUNT 64
+
 typedef enum {
     CONNECTING,
     CONNECTED,
@@ -54,7 +64,7 @@ typedef enum {
     DISCONNECTED,
 } BtmAclConnectionState;
 
-typedef struct {
+typedef struct BtmAclConnection {
     uint16_t connectionHandle;
     uint8_t transport;
     BtAddr addr;
@@ -84,6 +94,7 @@ typedef struct {
     uint8_t remoteCod[COD_SIZE];
     BtAddr leLocalAddr;
     BtAddr lePeerAddr;
+    struct BtmAclConnection *addrNext;
 } BtmAclConnection;
 
 typedef struct {
@@ -91,6 +102,13 @@ typedef struct {
     void *context;
 } BtmAclCallbacksBlock;
 
+// Registered callbacks, never modified once published. Register and deregister publish a new array, so the event
+// handlers dispatch through a snapshot without taking a lock.
+typedef struct {
+    uint16_t count;
+    BtmAclCallbacksBlock blocks[];
+} BtmAclCallbacksArray;
+
 typedef enum {
     REMOTE_FEATURE_COMPLETE,
     REMOTE_EXTENDED_FEATURE_COMPLETE,
@@ -132,7 +150,13 @@ typedef struct {
 
 static List *g_aclList = NULL;
 static Mutex *g_aclListLock = NULL;
-static List *g_aclCallbackList = NULL;
+static BtmAclConnection *g_aclHandleTable[ACL_HANDLE_TABLE_SIZE] = {NULL};
+static BtmAclConnection *g_aclAddrTable[ACL_ADDR_BUCKET_COUNT] = {NULL};
+
+static BtmAclCallbacksArray g_aclNoCallbacks = {.count = 0};
+static BtmAclCallbacksArray *_Atomic g_aclCallbacks = &g_aclNoCallbacks;
+// Arrays replaced while an event handler may still dispatch through them, freed once the HCI events are stopped.
+static List *g_aclRetiredCallbacks = NULL;
 static Mutex *g_aclCallbackListLock = NULL;
 static List *g_remoteSupportRequestList = NULL;
 
@@ -182,19 +206,85 @@ static void FreeAclConnection(void *connection)
     MEM_CALLOC.free(connection);
 }
 
-static BtmAclCallbacksBlock *BtmAllocAclCallbacksBlock(const BtmAclCallbacks *callbacks, void *context)
+static BtmAclCallbacksArray *BtmAclGetCallbacks()
+{
+    return atomic_load_explicit(&g_aclCallbacks, memory_order_acquire);
+}
+
+static void BtmAclPublishCallbacks(BtmAclCallbacksArray *callbacks)
+{
+    BtmAclCallbacksArray *previous = atomic_exchange_explicit(&g_aclCallbacks, callbacks, memory_order_acq_rel);
+    if (previous != &g_aclNoCallbacks) {
+        ListAddLast(g_aclRetiredCallbacks, previous);
+    }
+}
+
+static void BtmAclClearCallbacks()
+{
+    BtmAclPublishCallbacks(&g_aclNoCallbacks);
+    ListClear(g_aclRetiredCallbacks);
+}
+
+static uint8_t BtmAclAddrHash(const uint8_t addr[BT_ADDRESS_SIZE], uint8_t transport)
+{
+    uint32_t hash = transport;
+    for (uint8_t i = 0; i < BT_ADDRESS_SIZE; i++) {
+        hash = (hash * 31) + addr[i];
+    }
+    return (uint8_t)(hash & (ACL_ADDR_BUCKET_COUNT - 1));
+}
+
+static void BtmAclAddConnection(BtmAclConnection *connection)
+{
+    if (connection == NULL) {
+        return;
+    }
+
+    // Appended to the bucket, so a lookup finds the oldest of connections sharing an address, as the list does.
+    BtmAclConnection **next = &g_aclAddrTable[BtmAclAddrHash(connection->addr.addr, connection->transport)];
+    while (*next != NULL) {
+        next = &(*next)->addrNext;
+    }
+    connection->addrNext = NULL;
+    *next = connection;
+
+    ListAddLast(g_aclList, connection);
+}
+
+static void BtmAclSetConnectionHandle(BtmAclConnection *connection, uint16_t connectionHandle)
+{
+    connection->connectionHandle = connectionHandle;
+    g_aclHandleTable[connectionHandle & ACL_HANDLE_MASK] = connection;
+}
+
+static void BtmAclRemoveConnection(BtmAclConnection *connection)
 {
-    BtmAclCallbacksBlock *block = MEM_CALLOC.alloc(sizeof(BtmAclCallbacksBlock));
-    if (block != NULL) {
-        block->callbacks = callbacks;
-        block->context = context;
+    if (connection == NULL) {
+        return;
+    }
+
+    BtmAclConnection **next = &g_aclAddrTable[BtmAclAddrHash(connection->addr.addr, connection->transport)];
+    while (*next != NULL) {
+        if (*next == connection) {
+            *next = connection->addrNext;
+            break;
+        }
+        next = &(*next)->addrNext;
     }
-    return block;
+
+    uint16_t index = connection->connectionHandle & ACL_HANDLE_MASK;
+    if (g_aclHandleTable[index] == connection) {
+        g_aclHandleTable[index] = NULL;
+    }
+
+    ListRemoveNode(g_aclList, connection);
 }
 
-static void BtmFreeAclCallbacksBlock(void *block)
+static void BtmAclClearConnections()
 {
-    MEM_CALLOC.free(block);
+    (void)memset_s(g_aclHandleTable, sizeof(g_aclHandleTable), 0, sizeof(g_aclHandleTable));
+    (void)memset_s(g_aclAddrTable, sizeof(g_aclAddrTable), 0, sizeof(g_aclAddrTable));
+    ListClear(g_aclList);
 }
 
 static void BtmAclAllocRes()
@@ -205,7 +295,7 @@ static void BtmAclAllocRes()
     g_remoteSupportRequestList = ListCreate(MEM_MALLOC.free);
 
     g_aclCallbackListLock = MutexCreate();
-    g_aclCallbackList = ListCreate(BtmFreeAclCallbacksBlock);
+    g_aclRetiredCallbacks = ListCreate(MEM_MALLOC.free);
 
     g_cleanupMutex = MutexCreate();
     g_cleanupEvent = SemaphoreCreate(0);
@@ -247,6 +337,7 @@ static void BtmAclFreeRes()
         g_cleanupTimer = NULL;
     }
     if (g_aclList != NULL) {
+        BtmAclClearConnections();
         ListDelete(g_aclList);
         g_aclList = NULL;
     }
@@ -262,9 +353,10 @@ static void BtmAclFreeRes()
         MutexDelete(g_aclCallbackListLock);
         g_aclCallbackListLock = NULL;
     }
-    if (g_aclCallbackList != NULL) {
-        ListDelete(g_aclCallbackList);
-        g_aclCallbackList = NULL;
+    if (g_aclRetiredCallbacks != NULL) {
+        BtmAclClearCallbacks();
+        ListDelete(g_aclRetiredCallbacks);
+        g_aclRetiredCallbacks = NULL;
     }
     if (g_leConnectionModeLock != NULL) {
         MutexDelete(g_leConnectionModeLock);
@@ -308,12 +400,12 @@ void BtmStopAcl()
     HCI_DeregisterEventCallbacks(&g_hciEventCallbacks);
 
     MutexLock(g_aclListLock);
-    ListClear(g_aclList);
+    BtmAclClearConnections();
     ListClear(g_remoteSupportRequestList);
     MutexUnlock(g_aclListLock);
 
     MutexLock(g_aclCallbackListLock);
-    ListClear(g_aclCallbackList);
+    BtmAclClearCallbacks();
     MutexUnlock(g_aclCallbackListLock);
 
     MutexLock(g_leConnectionCancelLock);
@@ -333,62 +425,35 @@ static bool IsEqualAddr(const uint8_t addr1[BT_ADDRESS_SIZE], const uint8_t addr
     return isEqual;
 }
 
-static BtmAclConnection *BtmAclFindConnectionByAddr(const BtAddr *addr)
+static BtmAclConnection *BtmAclFindConnectionByTransport(const BtAddr *addr, uint8_t transport)
 {
-    BtmAclConnection *connection = NULL;
-
-    ListNode *node = ListGetFirstNode(g_aclList);
-    while (node != NULL) {
-        connection = ListGetNodeData(node);
-        if (connection->transport == TRANSPORT_BREDR) {
-            if (IsEqualAddr(connection->addr.addr, addr->addr)) {
-                break;
-            }
+    BtmAclConnection *connection = g_aclAddrTable[BtmAclAddrHash(addr->addr, transport)];
+    while (connection != NULL) {
+        if (connection->transport == transport && IsEqualAddr(connection->addr.addr, addr->addr)) {
+            break;
         }
-        connection = NULL;
-        node = ListGetNextNode(node);
+        connection = connection->addrNext;
     }
 
     return connection;
 }
 
-static BtmAclConnection *BtmAclFindLeConnectionByAddr(const BtAddr *addr)
+static BtmAclConnection *BtmAclFindConnectionByAddr(const BtAddr *addr)
 {
-    BtmAclConnection *connection = NULL;
-
-    ListNode *node = ListGetFirstNode(g_aclList);
-    while (node != NULL) {
-        connection = ListGetNodeData(node);
-        if (connection->transport == TRANSPORT_LE) {
-            if (IsEqualAddr(connection->addr.addr, addr->addr)) {
-                break;
-            }
-        }
-        connection = NULL;
-        node = ListGetNextNode(node);
-    }
+    return BtmAclFindConnectionByTransport(addr, TRANSPORT_BREDR);
+}
 
-    return connection;
+static BtmAclConnection *BtmAclFindLeConnectionByAddr(const BtAddr *addr)
+{
+    return BtmAclFindConnectionByTransport(addr, TRANSPORT_LE);
 }
 
 static BtmAclConnection *BtmAclFindConnectionByHandle(uint16_t handle)
 {
-    BtmAclConnection *connection = NULL;
-
-    ListNode *node = ListGetFirstNode(g_aclList);
-    while (node != NULL) {
-        connection = ListGetNodeData(node);
-        if (connection != NULL) {
-            if (connection->connectionHandle == handle) {
-                break;
-            }
-            connection = NULL;
-        }
-
-        node = ListGetNextNode(node);
+    if (handle > ACL_HANDLE_MASK) {
+        return NULL;
     }
-
-    return connection;
+    return g_aclHandleTable[handle];
 }
 
 static int BtmAclCreateConnection(const BtAddr *addr)
@@ -450,12 +515,12 @@ int BTM_AclConnect(const BtAddr *addr)
                 connection->isInitiator = true;
                 connection->state = CONNECTING;
 
-                ListAddLast(g_aclList, connection);
+                BtmAclAddConnection(connection);
             }
 
             result = BtmAclCreateConnection(addr);
             if (result != BT_NO_ERROR) {
-                ListRemoveNode(g_aclList, connection);
+                BtmAclRemoveConnection(connection);
             }
 
             MutexUnlock(g_aclListLock);
@@ -512,7 +577,7 @@ static void BtmOnConnectionComplete(const HciConnectionCompleteEventParam *event
     BtmAclConnection *connection = BtmAclFindConnectionByAddr(&addr);
     if (connection != NULL) {
         if (eventParam->status == HCI_SUCCESS) {
-            connection->connectionHandle = eventParam->connectionHandle;
+            BtmAclSetConnectionHandle(connection, eventParam->connectionHandle);
             connection->state = CONNECTED;
 
             (void)memcpy_s(cod, COD_SIZE, connection->remoteCod, COD_SIZE);
@@ -522,7 +587,7 @@ static void BtmOnConnectionComplete(const HciConnectionCompleteEventParam *event
                 BtmAclTimeout,
                 connection);
         } else {
-            ListRemoveNode(g_aclList, connection);
+            BtmAclRemoveConnection(connection);
         }
     }
     MutexUnlock(g_aclListLock);
@@ -540,19 +605,13 @@ static void BtmOnConnectionComplete(const HciConnectionCompleteEventParam *event
     (void)memcpy_s(connectCompleteParam.classOfDevice, COD_SIZE, cod, COD_SIZE);
     connectCompleteParam.encyptionEnabled = eventParam->encryptionEnabled;
 
-    MutexLock(g_aclCallbackListLock);
-
-    ListNode *node = ListGetFirstNode(g_aclCallbackList);
-    BtmAclCallbacksBlock *block = NULL;
-    while (node != NULL) {
-        block = (BtmAclCallbacksBlock *)ListGetNodeData(node);
+    const BtmAclCallbacksArray *callbacks = BtmAclGetCallbacks();
+    for (uint16_t i = 0; i < callbacks->count; i++) {
+        const BtmAclCallbacksBlock *block = &callbacks->blocks[i];
         if (block->callbacks->connectionComplete != NULL) {
             block->callbacks->connectionComplete(&connectCompleteParam, block->context);
         }
-        node = ListGetNextNode(node);
     }
-
-    MutexUnlock(g_aclCallbackListLock);
 }
 
 static void BtmOnConnectionrequest(const HciConnectionRequestEventParam *eventParam)
@@ -598,7 +657,7 @@ static void BtmOnConnectionrequest(const HciConnectionRequestEventParam *eventPa
         }
     }
 
-    ListAddLast(g_aclList, connection);
+    BtmAclAddConnection(connection);
 
     HciAcceptConnectionReqestParam acceptParam = {
         .bdAddr = eventParam->bdAddr,
@@ -606,7 +665,7 @@ static void BtmOnConnectionrequest(const HciConnectionRequestEventParam *eventPa
     };
     int result = HCI_AcceptConnectionRequest(&acceptParam);
     if (result != BT_NO_ERROR) {
-        ListRemoveNode(g_aclList, connection);
+        BtmAclRemoveConnection(connection);
     }
 
     MutexUnlock(g_aclListLock);
@@ -813,7 +872,7 @@ int BTM_LeConnect(const BtAddr *addr)
 
             connection->lePeerAddr = leAddr;
 
-            ListAddLast(g_aclList, connection);
+            BtmAclAddConnection(connection);
         }
 
         result = BtmLeCreateConnection(&leAddr);
@@ -841,7 +900,7 @@ static void BtmRemoveAllConnectingLeConnection()
         connection = ListGetNodeData(node);
         node = ListGetNextNode(node);
         if (connection->transport == TRANSPORT_LE && connection->state == CONNECTING) {
-            ListRemoveNode(g_aclList, connection);
+            BtmAclRemoveConnection(connection);
         }
     }
 }
@@ -854,7 +913,7 @@ static void BtmUpdateLeConnectionOnConnectComplete(
     if (eventParam->status == HCI_SUCCESS) {
         BtmAclConnection *connection = BtmAclFindLeConnectionByAddr(addr);
         if (connection != NULL) {
-            connection->connectionHandle = eventParam->connectionHandle;
+            BtmAclSetConnectionHandle(connection, eventParam->connectionHandle);
             connection->state = CONNECTED;
 
             (void)memcpy_s(connection->lePeerAddr.addr, BT_ADDRESS_SIZE, eventParam->peerAddress.raw, BT_ADDRESS_SIZE);
@@ -867,7 +926,7 @@ static void BtmUpdateLeConnectionOnConnectComplete(
             }
 
             connection->addr = *addr;
-            connection->connectionHandle = eventParam->connectionHandle;
+            BtmAclSetConnectionHandle(connection, eventParam->connectionHandle);
             connection->transport = TRANSPORT_LE;
             connection->state = CONNECTED;
             connection->isInitiator = false;
@@ -883,7 +942,7 @@ static void BtmUpdateLeConnectionOnConnectComplete(
             (void)memcpy_s(connection->lePeerAddr.addr, BT_ADDRESS_SIZE, eventParam->peerAddress.raw, BT_ADDRESS_SIZE);
             connection->lePeerAddr.type = peerAddrType;
 
-            ListAddLast(g_aclList, connection);
+            BtmAclAddConnection(connection);
         }
     } else {
         BtmRemoveAllConnectingLeConnection();
@@ -896,28 +955,21 @@ static void BtmLeCancelConnectCallback(uint8_t status)
 {
     MutexLock(g_leConnectionCancelLock);
 
-    ListNode *node1 = ListGetFirstNode(g_leConnectionCancelList);
+    const BtmAclCallbacksArray *callbacks = BtmAclGetCallbacks();
+    ListNode *node = ListGetFirstNode(g_leConnectionCancelList);
     BtAddr *addr = NULL;
 
-    ListNode *node2 = NULL;
-    BtmAclCallbacksBlock *block = NULL;
-
-    while (node1 != NULL) {
-        addr = ListGetNodeData(node1);
-
-        MutexLock(g_aclCallbackListLock);
-        node2 = ListGetFirstNode(g_aclCallbackList);
+    while (node != NULL) {
+        addr = ListGetNodeData(node);
 
-        while (node2 != NULL) {
-            block = (BtmAclCallbacksBlock *)ListGetNodeData(node2);
+        for (uint16_t i = 0; i < callbacks->count; i++) {
+            const BtmAclCallbacksBlock *block = &callbacks->blocks[i];
             if (block->callbacks->leConnectionComplete != NULL) {
                 block->callbacks->leConnectionComplete(status, 0, addr, 0, block->context);
             }
-            node2 = ListGetNextNode(node2);
         }
-        MutexUnlock(g_aclCallbackListLock);
 
-        node1 = ListGetNextNode(node1);
+        node = ListGetNextNode(node);
     }
 
     ListClear(g_leConnectionCancelList);
@@ -936,23 +988,16 @@ static void BtmLeReadRemoteFeatures(uint16_t connectionHandle)
 static void BtmOnLeConnectCallback(
     const BtAddr *addrList, uint8_t addrCount, uint8_t status, uint16_t connectionHandle, uint16_t role)
 {
-    MutexLock(g_aclCallbackListLock);
-
-    ListNode *node = NULL;
-    BtmAclCallbacksBlock *block = NULL;
+    const BtmAclCallbacksArray *callbacks = BtmAclGetCallbacks();
 
     for (uint8_t i = 0; i < addrCount; i++) {
-        node = ListGetFirstNode(g_aclCallbackList);
-        while (node != NULL) {
-            block = (BtmAclCallbacksBlock *)ListGetNodeData(node);
+        for (uint16_t j = 0; j < callbacks->count; j++) {
+            const BtmAclCallbacksBlock *block = &callbacks->blocks[j];
             if (block->callbacks->leConnectionComplete != NULL) {
                 block->callbacks->leConnectionComplete(status, connectionHandle, addrList + i, role, block->context);
             }
-            node = ListGetNextNode(node);
         }
     }
-
-    MutexUnlock(g_aclCallbackListLock);
 }
 
 static void BtmGetLeConnectingAddr(BtAddr **addrList, uint8_t *addrCount)
@@ -1070,7 +1115,7 @@ static void BtmOnLeConnectionComplete(const HciLeConnectionCompleteEventParam *e
 static void BtmUpdateLeConnectionOnEnhancedConnectComplete(
     BtmAclConnection *connection, uint8_t peerAddrType, const HciLeEnhancedConnectionCompleteEventParam *eventParam)
 {
-    connection->connectionHandle = eventParam->connectionHandle;
+    BtmAclSetConnectionHandle(connection, eventParam->connectionHandle);
     connection->state = CONNECTED;
 
     if (!IsZeroAddress(eventParam->localResolvablePrivateAddress.raw)) {
@@ -1098,7 +1143,7 @@ static void BtmAllocLeConnectionOnEnhancedConnectComplete(
     }
 
     connection->addr = *addr;
-    connection->connectionHandle = eventParam->connectionHandle;
+    BtmAclSetConnectionHandle(connection, eventParam->connectionHandle);
     connection->transport = TRANSPORT_LE;
     connection->state = CONNECTED;
     connection->isInitiator = false;
@@ -1130,7 +1175,7 @@ static void BtmAllocLeConnectionOnEnhancedConnectComplete(
         connection->lePeerAddr.type = peerAddrType;
     }
 
-    ListAddLast(g_aclList, connection);
+    BtmAclAddConnection(connection);
 }
 
 static void BtmUpdateConnectionInfoOnLeEnhancedConnectionComplete(
@@ -1266,17 +1311,15 @@ static void BtmOnDisconnectComplete(const HciDisconnectCompleteEventParam *event
 
         if (eventParam->status == HCI_SUCCESS) {
             connection->state = DISCONNECTED;
-            ListRemoveNode(g_aclList, connection);
+            BtmAclRemoveConnection(connection);
             connection = NULL;
         }
     }
     MutexUnlock(g_aclListLock);
 
-    MutexLock(g_aclCallbackListLock);
-    ListNode *node = ListGetFirstNode(g_aclCallbackList);
-    BtmAclCallbacksBlock *block = NULL;
-    while (node != NULL) {
-        block = (BtmAclCallbacksBlock *)ListGetNodeData(node);
+    const BtmAclCallbacksArray *callbacks = BtmAclGetCallbacks();
+    for (uint16_t i = 0; i < callbacks->count; i++) {
+        const BtmAclCallbacksBlock *block = &callbacks->blocks[i];
         if (transport == TRANSPORT_BREDR) {
             if (block->callbacks->disconnectionComplete != NULL) {
                 block->callbacks->disconnectionComplete(
@@ -1288,9 +1331,7 @@ static void BtmOnDisconnectComplete(const HciDisconnectCompleteEventParam *event
                     eventParam->status, eventParam->connectionHandle, eventParam->reason, block->context);
             }
         }
-        node = ListGetNextNode(node);
     }
-    MutexUnlock(g_aclCallbackListLock);
 }
 
 static void BtmGetRemoteDeviceSupportRequests(
@@ -1538,17 +1579,13 @@ static void BtmOnReadRssiComplete(const HciReadRssiReturnParam *returnParam)
     }
     MutexUnlock(g_aclListLock);
 
-    MutexLock(g_aclCallbackListLock);
-    BtmAclCallbacksBlock *block = NULL;
-    ListNode *node = ListGetFirstNode(g_aclCallbackList);
-    while (node != NULL) {
-        block = ListGetNodeData(node);
+    const BtmAclCallbacksArray *callbacks = BtmAclGetCallbacks();
+    for (uint16_t i = 0; i < callbacks->count; i++) {
+        const BtmAclCallbacksBlock *block = &callbacks->blocks[i];
         if (block->callbacks->readRssiComplete != NULL) {
             block->callbacks->readRssiComplete(returnParam->status, &addr, returnParam->rssi, block->context);
         }
-        node = ListGetNextNode(node);
     }
-    MutexUnlock(g_aclCallbackListLock);
 }
 
 static void BtmAclOnCommandStatus(uint8_t status, uint16_t commandOpcode)
@@ -1573,13 +1610,23 @@ int BTM_RegisterAclCallbacks(const BtmAclCallbacks *callbacks, void *context)
         return BT_BAD_STATUS;
     }
 
-    BtmAclCallbacksBlock *block = BtmAllocAclCallbacksBlock(callbacks, context);
-    if (block == NULL) {
+    MutexLock(g_aclCallbackListLock);
+    const BtmAclCallbacksArray *current = BtmAclGetCallbacks();
+    BtmAclCallbacksArray *updated =
+        MEM_MALLOC.alloc(sizeof(BtmAclCallbacksArray) + sizeof(BtmAclCallbacksBlock) * (current->count + 1));
+    if (updated == NULL) {
+        MutexUnlock(g_aclCallbackListLock);
         return BT_NO_MEMORY;
     }
 
-    MutexLock(g_aclCallbackListLock);
-    ListAddLast(g_aclCallbackList, block);
+    for (uint16_t i = 0; i < current->count; i++) {
+        updated->blocks[i] = current->blocks[i];
+    }
+    updated->blocks[current->count].callbacks = callbacks;
+    updated->blocks[current->count].context = context;
+    updated->count = current->count + 1;
+
+    BtmAclPublishCallbacks(updated);
     MutexUnlock(g_aclCallbackListLock);
     return BT_NO_ERROR;
 }
@@ -1595,15 +1642,34 @@ int BTM_DeregisterAclCallbacks(const BtmAclCallbacks *callbacks)
     }
 
     MutexLock(g_aclCallbackListLock);
-    BtmAclCallbacksBlock *block = NULL;
-    ListNode *node = ListGetFirstNode(g_aclCallbackList);
-    while (node != NULL) {
-        block = ListGetNodeData(node);
-        if (block->callbacks == callbacks) {
-            ListRemoveNode(g_aclCallbackList, block);
-            break;
+    const BtmAclCallbacksArray *current = BtmAclGetCallbacks();
+    uint16_t index = 0;
+    while (index < current->count && current->blocks[index].callbacks != callbacks) {
+        index++;
+    }
+
+    if (index < current->count) {
+        BtmAclCallbacksArray *updated = &g_aclNoCallbacks;
+        if (current->count > 1) {
+            updated =
+                MEM_MALLOC.alloc(sizeof(BtmAclCallbacksArray) + sizeof(BtmAclCallbacksBlock) * (current->count - 1));
         }
-        node = ListGetNextNode(node);
+        if (updated == NULL) {
+            MutexUnlock(g_aclCallbackListLock);
+            return BT_NO_MEMORY;
+        }
+
+        if (updated != &g_aclNoCallbacks) {
+            uint16_t count = 0;
+            for (uint16_t i = 0; i < current->count; i++) {
+                if (i != index) {
+                    updated->blocks[count++] = current->blocks[i];
+                }
+            }
+            updated->count = count;
+        }
+
+        BtmAclPublishCallbacks(updated);
     }
     MutexUnlock(g_aclCallbackListLock);
     return BT_NO_ERROR;
@@ -1746,6 +1812,70 @@ int BTM_ReadRssi(const BtAddr *addr)
     return HCI_ReadRssi(&param);
 }
 
+int BTM_GetAclTxQueueLength(const BtAddr *addr, uint16_t *queueLength)
+{
+    if ((addr == NULL) || (queueLength == NULL)) {
+        return BT_BAD_PARAM;
+    }
+
+    if (!IS_INITIALIZED()) {
+        return BT_BAD_STATUS;
+    }
+
+    uint16_t handle = 0xffff;
+
+    MutexLock(g_aclListLock);
+    BtmAclConnection *connection = BtmAclFindConnectionByAddr(addr);
+    if (connection != NULL) {
+        handle = connection->connectionHandle;
+    } else {
+        MutexUnlock(g_aclListLock);
+        return BT_BAD_STATUS;
+    }
+    MutexUnlock(g_aclListLock);
+
+    return HCI_GetAclTxQueueLength(handle, queueLength);
+}
+
+int BTM_GetAclTrafficStats(const BtAddr *addr, BtmAclTrafficStats *stats)
+{
+    if ((addr == NULL) || (stats == NULL)) {
+        return BT_BAD_PARAM;
+    }
+
+    if (!IS_INITIALIZED()) {
+        return BT_BAD_STATUS;
+    }
+
+    uint16_t handle = 0xffff;
+
+    MutexLock(g_aclListLock);
+    BtmAclConnection *connection = BtmAclFindConnectionByAddr(addr);
+    if (connection != NULL) {
+        handle = connection->connectionHandle;
+    } else {
+        MutexUnlock(g_aclListLock);
+        return BT_BAD_STATUS;
+    }
+    MutexUnlock(g_aclListLock);
+
+    HciAclTrafficStats traffic;
+    int result = HCI_GetAclTrafficStats(handle, &traffic);
+    if (result != BT_NO_ERROR) {
+        return result;
+    }
+
+    uint64_t now = PerfClockUs();
+    uint64_t idleMs = (now > traffic.lastActivityUs) ? ((now - traffic.lastActivityUs) / US_PER_MS) : 0;
+    stats->txPackets = traffic.txPackets;
+    stats->txBytes = traffic.txBytes;
+    stats->rxPackets = traffic.rxPackets;
+    stats->rxBytes = traffic.rxBytes;
+    stats->idleMs = (idleMs > UINT32_MAX) ? UINT32_MAX : (uint32_t)idleMs;
+
+    return BT_NO_ERROR;
+}
+
 int BTM_GetLeConnectionAddress(uint16_t connectionHandle, BtAddr *localAddr, BtAddr *peerAddr)
 {
     if (!IS_INITIALIZED()) {
@@ -1860,7 +1990,7 @@ int BTM_AclCancelConnect(const BtAddr *addr)
     MutexLock(g_aclListLock);
     BtmAclConnection *connection = BtmAclFindConnectionByAddr(addr);
     if (connection != NULL) {
-        ListRemoveNode(g_aclList, connection);
+        BtmAclRemoveConnection(connection);
         HciCreateConnectionCancelParam param = {
             .bdAddr =
                 {
@@ -1911,7 +2041,7 @@ int BTM_LeCancelConnect(const BtAddr *addr)
 
             BtmStopAutoConnection();
 
-            ListRemoveNode(g_aclList, connection);
+            BtmAclRemoveConnection(connection);
         } else {
             reuslt = BT_BAD_STATUS;
         }
@@ -2123,17 +2253,13 @@ void BtmOnRoleChange(const HciRoleChangeEventParam *eventParam)
     };
     (void)memcpy_s(addr.addr, BT_ADDRESS_SIZE, eventParam->bdAddr.raw, BT_ADDRESS_SIZE);
 
-    MutexLock(g_aclCallbackListLock);
-    ListNode *node = ListGetFirstNode(g_aclCallbackList);
-    BtmAclCallbacksBlock *block = NULL;
-    while (node != NULL) {
-        block = (BtmAclCallbacksBlock *)ListGetNodeData(node);
+    const BtmAclCallbacksArray *callbacks = BtmAclGetCallbacks();
+    for (uint16_t i = 0; i < callbacks->count; i++) {
+        const BtmAclCallbacksBlock *block = &callbacks->blocks[i];
         if (block->callbacks->roleChange != NULL) {
             block->callbacks->roleChange(eventParam->status, &addr, eventParam->newRole, block->context);
         }
-        node = ListGetNextNode(node);
     }
-    MutexUnlock(g_aclCallbackListLock);
 }
 
 int BTM_SwitchRole(const BtAddr *addr, uint8_t role)
@@ -29,6 +29,7 @@
 #include "platform/include/thread.h"
 
 #include "btm.h"
+#include "perf_counter.h"
 #include "btm/btm_snoop_filter.h"
 
 #define SNOOP_INDENTIFICATION_PATTERN                  \
@@ -80,6 +81,7 @@ static char *g_outputPath = NULL;
 static FILE *g_outputFile = NULL;
 static bool g_hciLogOuput = false;
 static Mutex *g_outputMutex = NULL;
+static uint32_t g_cumulativeDrops = 0;  // Packets not fully written to g_outputFile since it was opened.
 
 static void GetH4HeaderAndPacketFlags(uint8_t type, uint8_t *h4Header, uint32_t *packetFlags)
 {
@@ -126,18 +128,22 @@ static void BtmSnoopOutput(uint8_t type, const uint8_t *data, uint16_t length)
     BtmSnoopPacketHeader header = {
         .originalLength = H2BE_32(originalLength),
         .includedLength = H2BE_32(includedLength),
-        .cumulativeDrops = H2BE_32(0),
         .packetFlags = H2BE_32(packetFlags),
         .timestamp = H2BE_64(timestamp),
     };
 
     MutexLock(g_outputMutex);
 
-    (void)fwrite(&header, 1, sizeof(BtmSnoopPacketHeader), g_outputFile);
-    (void)fwrite(&h4Header, 1, HCI_H4_HEADER_LEN, g_outputFile);
-    (void)fwrite(outputData, 1, includedLength - HCI_H4_HEADER_LEN, g_outputFile);
+    header.cumulativeDrops = H2BE_32(g_cumulativeDrops);
+    size_t dataLength = includedLength - HCI_H4_HEADER_LEN;
+    bool written = (fwrite(&header, 1, sizeof(BtmSnoopPacketHeader), g_outputFile) == sizeof(BtmSnoopPacketHeader)) &&
+                   (fwrite(&h4Header, 1, HCI_H4_HEADER_LEN, g_outputFile) == HCI_H4_HEADER_LEN) &&
+                   (fwrite(outputData, 1, dataLength, g_outputFile) == dataLength);
 
-    fflush(g_outputFile);
+    if ((fflush(g_outputFile) != 0) || !written) {
+        g_cumulativeDrops++;
+        PerfCounterAdd(PERF_COUNTER_SNOOP_DROPS, 1);
+    }
 
     if (outputData != data) {
         MEM_MALLOC.free((void *)outputData);
@@ -181,6 +187,7 @@ static bool BtmIsFileExists(const char *path)
 
 static void BtmPrepareSnoopFile()
 {
+    g_cumulativeDrops = 0;
     if (g_hciLogOuput) {
         bool exists = BtmIsFileExists(HCI_LOG_PATH);
         if (exists) {
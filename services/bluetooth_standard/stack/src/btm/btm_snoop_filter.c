@@ -30,10 +30,18 @@
 
 #define HCI_H4_HEADER_LEN 1
 
+#define RFCOMM_SCN_NUM 32
+
 static bool g_filter = false;
 static Mutex *g_filterMutex = NULL;
 static List *g_filterInfoList = NULL;
 
+// The RFCOMM channels of g_filterInfoList, rebuilt by every BTM_Add/Remove*ForLogging() so that the data path does
+// not walk the list.
+static uint32_t g_localScnMask = 0;
+static uint32_t g_remoteScnMask = 0;
+static uint8_t g_localScnModule[RFCOMM_SCN_NUM] = {0};
+
 static void FreeListNodeData(void *data)
 {
     MEM_MALLOC.free(data);
@@ -44,6 +52,34 @@ List *BtmGetFilterInfoList(void)
     return g_filterInfoList;
 }
 
+static void BtmCompileFilterInfo(void)
+{
+    g_localScnMask = 0;
+    g_remoteScnMask = 0;
+    (void)memset_s(g_localScnModule, sizeof(g_localScnModule), 0, sizeof(g_localScnModule));
+    if (g_filterInfoList == NULL) {
+        return;
+    }
+
+    ListNode *node = ListGetFirstNode(g_filterInfoList);
+    while (node != NULL) {
+        BtmSnoopFilterInfo *info = ListGetNodeData(node);
+        node = ListGetNextNode(node);
+
+        if (info->rfcommScn == 0 || info->rfcommScn >= RFCOMM_SCN_NUM) {
+            continue;
+        }
+        uint32_t bit = 1u << info->rfcommScn;
+        if (!info->isLocal) {
+            g_remoteScnMask |= bit;
+        } else if ((g_localScnMask & bit) == 0) {
+            // The first added wins, as in the list.
+            g_localScnMask |= bit;
+            g_localScnModule[info->rfcommScn] = info->module;
+        }
+    }
+}
+
 void BtmInitSnoopFilter(void)
 {
     g_filter = false;
@@ -93,6 +129,7 @@ void BtmDisableSnoopFilter(void)
         ListDelete(g_filterInfoList);
         g_filterInfoList = NULL;
     }
+    BtmCompileFilterInfo();
     MutexUnlock(g_filterMutex);
 }
 
@@ -148,9 +185,43 @@ bool BtmFindFilterInfoByInfoUseScn(void *nodeData, void *info)
     }
 }
 
+bool BtmFindFilterModuleByScn(bool isLocal, uint8_t scn, const BtAddr *remoteAddr, uint8_t *module)
+{
+    if (scn >= RFCOMM_SCN_NUM) {
+        return false;
+    }
+
+    uint32_t bit = 1u << scn;
+    if (isLocal) {
+        if ((g_localScnMask & bit) == 0) {
+            return false;
+        }
+        *module = g_localScnModule[scn];
+        return true;
+    }
+
+    if ((g_remoteScnMask & bit) == 0) {
+        return false;
+    }
+    BtmSnoopFilterInfo cmpInfo = {
+        .isLocal = false,
+        .rfcommScn = scn,
+        .remoteAddr = *remoteAddr,
+    };
+    BtmSnoopFilterInfo *info = ListForEachData(g_filterInfoList, BtmFindFilterInfoByInfoUseScn, &cmpInfo);
+    if (info == NULL) {
+        return false;
+    }
+    *module = info->module;
+    return true;
+}
+
 void BtmChangeIncludeLength(uint16_t *includedLength, uint16_t len)
 {
-    *includedLength = len + HCI_H4_HEADER_LEN;
+    // Only truncates: the packet is written from the original buffer.
+    if (len + HCI_H4_HEADER_LEN < *includedLength) {
+        *includedLength = len + HCI_H4_HEADER_LEN;
+    }
 }
 
 uint8_t *BtmCreateFilterBuffer(const uint16_t *includedLength, const uint8_t *data)
@@ -222,6 +293,7 @@ void BTM_AddLocalL2capPsmForLogging(uint8_t module, uint16_t psm)
     BtmSnoopFilterInfo *info = AllocFilterInfo(module, 0, psm, true, NULL);
     if (info != NULL) {
         ListAddLast(g_filterInfoList, info);
+        BtmCompileFilterInfo();
     }
     MutexUnlock(g_filterMutex);
 }
@@ -241,6 +313,7 @@ void BTM_AddRemoteL2capPsmForLogging(uint8_t module, uint16_t psm, const BtAddr
     BtmSnoopFilterInfo *info = AllocFilterInfo(module, 0, psm, false, remoteAddr);
     if (info != NULL) {
         ListAddLast(g_filterInfoList, info);
+        BtmCompileFilterInfo();
     }
     MutexUnlock(g_filterMutex);
 }
@@ -261,6 +334,7 @@ void BTM_RemoveLocalL2capPsmForLogging(uint8_t module, uint16_t psm)
     BtmSnoopFilterInfo *info = ListForEachData(g_filterInfoList, BtmFindFilterInfoByInfoUsePsm, &cmpInfo);
     if (info != NULL && info->module == module) {
         ListRemoveNode(g_filterInfoList, info);
+        BtmCompileFilterInfo();
     }
     MutexUnlock(g_filterMutex);
 }
@@ -285,6 +359,7 @@ void BTM_RemoveRemoteL2capPsmForLogging(uint8_t module, uint16_t psm, const BtAd
     BtmSnoopFilterInfo *info = ListForEachData(g_filterInfoList, BtmFindFilterInfoByInfoUsePsm, &cmpInfo);
     if (info != NULL && info->module == module) {
         ListRemoveNode(g_filterInfoList, info);
+        BtmCompileFilterInfo();
     }
     MutexUnlock(g_filterMutex);
 }
@@ -300,6 +375,7 @@ void BTM_AddLocalRfcommScnForLogging(uint8_t module, uint8_t scn)
     BtmSnoopFilterInfo *info = AllocFilterInfo(module, scn, 0, true, NULL);
     if (info != NULL) {
         ListAddLast(g_filterInfoList, info);
+        BtmCompileFilterInfo();
     }
     MutexUnlock(g_filterMutex);
 }
@@ -319,6 +395,7 @@ void BTM_AddRemoteRfcommScnForLogging(uint8_t module, uint8_t scn, const BtAddr
     BtmSnoopFilterInfo *info = AllocFilterInfo(module, scn, 0, false, remoteAddr);
     if (info != NULL) {
         ListAddLast(g_filterInfoList, info);
+        BtmCompileFilterInfo();
     }
     MutexUnlock(g_filterMutex);
 }
@@ -340,6 +417,7 @@ void BTM_RemoveLocalRfcommScnChannelForLogging(uint8_t module, uint8_t scn)
     BtmSnoopFilterInfo *info = ListForEachData(g_filterInfoList, BtmFindFilterInfoByInfoUseScn, &cmpInfo);
     if (info != NULL && info->module == module) {
         ListRemoveNode(g_filterInfoList, info);
+        BtmCompileFilterInfo();
     }
     MutexUnlock(g_filterMutex);
 }
@@ -352,10 +430,10 @@ void BTM_RemoveRemoteRfcommScnChannelForLogging(uint8_t module, uint8_t scn, con
         return;
     }
     BtmSnoopFilterInfo cmpInfo = {
-        .isLocal = true,
+        .isLocal = false,
         .rfcommScn = scn,
         .module = module,
-        .remoteAddr = {},
+        .remoteAddr = *remoteAddr,
     };
     LOG_INFO("%{public}s: module:%{public}d, " BT_ADDR_FMT " local scn:%02d",
         __FUNCTION__,
@@ -365,6 +443,7 @@ void BTM_RemoveRemoteRfcommScnChannelForLogging(uint8_t module, uint8_t scn, con
     BtmSnoopFilterInfo *info = ListForEachData(g_filterInfoList, BtmFindFilterInfoByInfoUseScn, &cmpInfo);
     if (info != NULL && info->module == module) {
         ListRemoveNode(g_filterInfoList, info);
+        BtmCompileFilterInfo();
     }
     MutexUnlock(g_filterMutex);
 }
\ No newline at end of file
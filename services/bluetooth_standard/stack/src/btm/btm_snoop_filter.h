@@ -54,6 +54,7 @@ void BtmHciFilter(uint8_t type, const uint8_t **data, uint16_t originalLength, u
 List *BtmGetFilterInfoList(void);
 bool BtmFindFilterInfoByInfoUsePsm(void *nodeData, void *info);
 bool BtmFindFilterInfoByInfoUseScn(void *nodeData, void *info);
+bool BtmFindFilterModuleByScn(bool isLocal, uint8_t scn, const BtAddr *remoteAddr, uint8_t *module);
 void BtmChangeIncludeLength(uint16_t *includedLength, uint16_t len);
 uint8_t *BtmCreateFilterBuffer(const uint16_t *includedLength, const uint8_t *data);
 void BtmFilterData(uint8_t *data, uint8_t length);
@@ -64,6 +64,12 @@
 #define AVRCP_PDU_ID_GET_ELEMENT_ATTR 0x20
 #define AVRCP_BROWSING_PDU_ID_GET_ITEM_ATTR 0x73
 
+#define ACL_HANDLE_TABLE_SIZE 0x1000
+#define ACL_HANDLE_MASK 0x0fff
+
+#define L2CAP_CID_BUCKET_COUNT 16
+#define L2CAP_CID_BUCKET_MASK (L2CAP_CID_BUCKET_COUNT - 1)
+
 typedef enum {
     DISCONNECTED,
     CONNECTING,
@@ -75,14 +81,19 @@ typedef enum {
     LE,
 } AclType;
 
+typedef struct FilterL2capChannelConnInfo FilterL2capChannelConnInfo;
+
 typedef struct {
     AclType type;
     uint16_t handle;
     BtAddr addr;
     bool prevPktIsFiltered;
+    // The channels of the connection hashed by CID, the local CID is used for C2H data, the remote CID for H2C data.
+    FilterL2capChannelConnInfo *localCidTable[L2CAP_CID_BUCKET_COUNT];
+    FilterL2capChannelConnInfo *remoteCidTable[L2CAP_CID_BUCKET_COUNT];
 } AclConnInfo;
 
-typedef struct {
+struct FilterL2capChannelConnInfo {
     ConnStatus status;
     uint8_t module;
     uint8_t headerLength;
@@ -91,13 +102,9 @@ typedef struct {
     uint16_t remoteCid;
     bool isInitiator;
     bool isAvdtpMedia;
-} FilterL2capChannelConnInfo;
-
-typedef struct {
-    uint16_t aclHandle;
-    uint16_t remoteCid;
-    uint8_t dlci;
-} RemoteSearchInfo;
+    FilterL2capChannelConnInfo *localCidNext;
+    FilterL2capChannelConnInfo *remoteCidNext;
+};
 
 #pragma pack(1)
 typedef struct {
@@ -133,6 +140,8 @@ typedef struct {
 static List *g_aclConnList = NULL;
 static List *g_filterL2capConnList = NULL;
 static List *g_filterRfcommConnList = NULL;
+// The connections of g_aclConnList indexed by handle.
+static AclConnInfo *g_aclConnTable[ACL_HANDLE_TABLE_SIZE] = {NULL};
 
 static void FreeListNodeData(void *data)
 {
@@ -172,6 +181,7 @@ void BtmDisableSnoopFilterAcl(void)
         ListDelete(g_aclConnList);
         g_aclConnList = NULL;
     }
+    (void)memset_s(g_aclConnTable, sizeof(g_aclConnTable), 0, sizeof(g_aclConnTable));
 
     BTM_RemoveLocalL2capPsmForLogging(BTM_HCI_LOG_FILTER_MODULE_RFCOMM, L2CAP_RFCOMM_PSM);
     BTM_RemoveLocalL2capPsmForLogging(BTM_HCI_LOG_FILTER_MODULE_AVDTP, L2CAP_AVDTP_PSM);
@@ -180,42 +190,79 @@ void BtmDisableSnoopFilterAcl(void)
     BTM_RemoveLocalL2capPsmForLogging(BTM_HCI_LOG_FILTER_MODULE_ATT, L2CAP_ATT_PSM);
 }
 
-static bool FindAclConnInfoByHandle(void *nodeData, void *handle)
+static AclConnInfo *FindAclConnInfoByHandle(uint16_t handle)
 {
-    if (((AclConnInfo *)nodeData)->handle == *(uint16_t *)handle) {
-        return true;
-    } else {
-        return false;
+    if (handle > ACL_HANDLE_MASK) {
+        return NULL;
     }
+    return g_aclConnTable[handle];
 }
 
-static bool FindL2capConnByLocalCid(void *nodeData, void *cid)
+static FilterL2capChannelConnInfo **L2capCidBucket(AclConnInfo *acl, bool isLocal, uint16_t cid)
 {
-    if (((FilterL2capChannelConnInfo *)nodeData)->localCid == *(uint16_t *)cid) {
-        return true;
-    } else {
-        return false;
+    return isLocal ? &acl->localCidTable[cid & L2CAP_CID_BUCKET_MASK]
+                   : &acl->remoteCidTable[cid & L2CAP_CID_BUCKET_MASK];
+}
+
+static FilterL2capChannelConnInfo **L2capCidNext(FilterL2capChannelConnInfo *l2capInfo, bool isLocal)
+{
+    return isLocal ? &l2capInfo->localCidNext : &l2capInfo->remoteCidNext;
+}
+
+static FilterL2capChannelConnInfo *FindL2capConnByCid(AclConnInfo *acl, bool isLocal, uint16_t cid)
+{
+    FilterL2capChannelConnInfo *l2capInfo = *L2capCidBucket(acl, isLocal, cid);
+    while (l2capInfo != NULL) {
+        if ((isLocal ? l2capInfo->localCid : l2capInfo->remoteCid) == cid) {
+            return l2capInfo;
+        }
+        l2capInfo = *L2capCidNext(l2capInfo, isLocal);
     }
+    return NULL;
 }
 
-static bool FindL2capConnByRemoteInfo(void *nodeData, void *info)
+static void UnlinkL2capConnCid(FilterL2capChannelConnInfo *l2capInfo, bool isLocal)
 {
-    if (((FilterL2capChannelConnInfo *)nodeData)->remoteCid == ((RemoteSearchInfo *)info)->remoteCid &&
-        ((FilterL2capChannelConnInfo *)nodeData)->acl->handle == ((RemoteSearchInfo *)info)->aclHandle) {
-        return true;
+    uint16_t cid = isLocal ? l2capInfo->localCid : l2capInfo->remoteCid;
+    if (cid == L2CAP_INVALID_CHANNEL_ID) {
+        return;
+    }
+
+    FilterL2capChannelConnInfo **link = L2capCidBucket(l2capInfo->acl, isLocal, cid);
+    while (*link != NULL) {
+        if (*link == l2capInfo) {
+            *link = *L2capCidNext(l2capInfo, isLocal);
+            return;
+        }
+        link = L2capCidNext(*link, isLocal);
+    }
+}
+
+static void SetL2capConnCid(FilterL2capChannelConnInfo *l2capInfo, bool isLocal, uint16_t cid)
+{
+    UnlinkL2capConnCid(l2capInfo, isLocal);
+    if (isLocal) {
+        l2capInfo->localCid = cid;
     } else {
-        return false;
+        l2capInfo->remoteCid = cid;
+    }
+
+    *L2capCidNext(l2capInfo, isLocal) = NULL;
+    if (cid != L2CAP_INVALID_CHANNEL_ID) {
+        FilterL2capChannelConnInfo **bucket = L2capCidBucket(l2capInfo->acl, isLocal, cid);
+        *L2capCidNext(l2capInfo, isLocal) = *bucket;
+        *bucket = l2capInfo;
     }
 }
 
-static bool ExistL2capConnIsAvdtpSignal(uint16_t aclHandle)
+static bool ExistL2capConnIsAvdtpSignal(const AclConnInfo *aclInfo)
 {
     ListNode *node = ListGetFirstNode(g_filterL2capConnList);
     while (node != NULL) {
         FilterL2capChannelConnInfo *l2capConn = ListGetNodeData(node);
         node = ListGetNextNode(node);
 
-        if (l2capConn->acl->handle == aclHandle && l2capConn->module == BTM_HCI_LOG_FILTER_MODULE_AVDTP &&
+        if (l2capConn->acl == aclInfo && l2capConn->module == BTM_HCI_LOG_FILTER_MODULE_AVDTP &&
             l2capConn->status == CONNECTED && !l2capConn->isAvdtpMedia) {
             return true;
         }
@@ -226,74 +273,85 @@ static bool ExistL2capConnIsAvdtpSignal(uint16_t aclHandle)
 static FilterL2capChannelConnInfo *AddL2capConnection(
     ConnStatus status, uint8_t module, uint16_t aclHandle, uint16_t localCid, uint16_t remoteCid)
 {
+    AclConnInfo *aclConnInfo = FindAclConnInfoByHandle(aclHandle);
+    if (aclConnInfo == NULL) {
+        return NULL;
+    }
+
     FilterL2capChannelConnInfo *l2capInfo = MEM_MALLOC.alloc(sizeof(FilterL2capChannelConnInfo));
     if (l2capInfo != NULL) {
-        AclConnInfo *aclConnInfo = ListForEachData(g_aclConnList, FindAclConnInfoByHandle, &aclHandle);
-        if (aclConnInfo != NULL) {
-            l2capInfo->acl = aclConnInfo;
-            l2capInfo->module = module;
-            l2capInfo->status = status;
-            l2capInfo->localCid = localCid;
-            l2capInfo->remoteCid = remoteCid;
-            l2capInfo->isAvdtpMedia = false;
-            l2capInfo->isInitiator = false;
-            l2capInfo->headerLength = sizeof(L2capBasicHeader);
-            ListAddLast(g_filterL2capConnList, l2capInfo);
-        }
+        l2capInfo->acl = aclConnInfo;
+        l2capInfo->module = module;
+        l2capInfo->status = status;
+        l2capInfo->localCid = L2CAP_INVALID_CHANNEL_ID;
+        l2capInfo->remoteCid = L2CAP_INVALID_CHANNEL_ID;
+        l2capInfo->isAvdtpMedia = false;
+        l2capInfo->isInitiator = false;
+        l2capInfo->headerLength = sizeof(L2capBasicHeader);
+        SetL2capConnCid(l2capInfo, true, localCid);
+        SetL2capConnCid(l2capInfo, false, remoteCid);
+        ListAddLast(g_filterL2capConnList, l2capInfo);
     }
 
     return l2capInfo;
 }
 
-static void RemoveL2capConnectionByLocalCid(uint16_t localCid)
+static void RemoveL2capConnection(FilterL2capChannelConnInfo *l2capInfo)
+{
+    UnlinkL2capConnCid(l2capInfo, true);
+    UnlinkL2capConnCid(l2capInfo, false);
+    ListRemoveNode(g_filterL2capConnList, l2capInfo);
+}
+
+static void RemoveL2capConnectionByLocalCid(AclConnInfo *aclInfo, uint16_t localCid)
 {
-    FilterL2capChannelConnInfo *l2capInfo = ListForEachData(g_filterL2capConnList, FindL2capConnByLocalCid, &localCid);
+    FilterL2capChannelConnInfo *l2capInfo = FindL2capConnByCid(aclInfo, true, localCid);
     if (l2capInfo != NULL) {
-        ListRemoveNode(g_filterL2capConnList, l2capInfo);
+        RemoveL2capConnection(l2capInfo);
     }
 }
 
-static void RemoveL2capConnectionByAclHandle(uint16_t aclHandle)
+static void RemoveL2capConnectionByAcl(const AclConnInfo *aclInfo)
 {
     ListNode *node = ListGetFirstNode(g_filterL2capConnList);
     while (node != NULL) {
         FilterL2capChannelConnInfo *l2capInfo = ListGetNodeData(node);
         node = ListGetNextNode(node);
 
-        if (l2capInfo->acl->handle == aclHandle) {
+        if (l2capInfo->acl == aclInfo) {
             ListRemoveNode(g_filterL2capConnList, l2capInfo);
         }
     }
 }
 
+static void RemoveAclConnection(uint16_t handle)
+{
+    AclConnInfo *info = FindAclConnInfoByHandle(handle);
+    if (info != NULL) {
+        RemoveL2capConnectionByAcl(info);
+        g_aclConnTable[handle] = NULL;
+        ListRemoveNode(g_aclConnList, info);
+    }
+}
+
 static void AddAclConnection(AclType type, uint16_t handle, const HciBdAddr *addr, uint8_t addrType)
 {
+    if (handle > ACL_HANDLE_MASK) {
+        return;
+    }
+    // A handle reused without its disconnection being seen.
+    RemoveAclConnection(handle);
+
     AclConnInfo *info = MEM_MALLOC.alloc(sizeof(AclConnInfo));
     if (info != NULL) {
+        (void)memset_s(info, sizeof(AclConnInfo), 0, sizeof(AclConnInfo));
         info->handle = handle;
         info->type = type;
         (void)memcpy_s(info->addr.addr, sizeof(info->addr.addr), addr->raw, sizeof(addr->raw));
         info->addr.type = addrType;
         info->prevPktIsFiltered = false;
         ListAddLast(g_aclConnList, info);
-    }
-}
-
-static void RemoveAclConnection(uint16_t handle)
-{
-    RemoveL2capConnectionByAclHandle(handle);
-
-    AclConnInfo *info = ListForEachData(g_aclConnList, FindAclConnInfoByHandle, &handle);
-    if (info != NULL) {
-        ListRemoveNode(g_aclConnList, info);
-    }
-}
-
-static void SetAclPrevPktIsFiltered(uint16_t handle, bool isFiltered)
-{
-    AclConnInfo *info = ListForEachData(g_aclConnList, FindAclConnInfoByHandle, &handle);
-    if (info != NULL) {
-        info->prevPktIsFiltered = isFiltered;
+        g_aclConnTable[handle] = info;
     }
 }
 
@@ -410,7 +468,7 @@ void BtmFilterCheckAndSaveAclConnInfo(const uint8_t **data, uint16_t originalLen
 }
 
 static void ProcessL2capConnectionRequest(
-    uint8_t type, const AclConnInfo *aclInfo, const L2capSignalingHeader *l2capsignalingHeader, const uint8_t *data)
+    uint8_t type, AclConnInfo *aclInfo, const L2capSignalingHeader *l2capsignalingHeader, const uint8_t *data)
 {
     uint16_t offset = 0;
     uint16_t *psm = (uint16_t *)(data + offset);
@@ -439,15 +497,15 @@ static void ProcessL2capConnectionRequest(
         }
         if (l2capInfo != NULL) {
             l2capInfo->isInitiator = (type == TRANSMISSON_TYPE_H2C_DATA);
-        }
-        if (*psm == L2CAP_AVDTP_PSM && ExistL2capConnIsAvdtpSignal(aclInfo->handle)) {
-            l2capInfo->isAvdtpMedia = true;
+            if (*psm == L2CAP_AVDTP_PSM && ExistL2capConnIsAvdtpSignal(aclInfo)) {
+                l2capInfo->isAvdtpMedia = true;
+            }
         }
     }
 }
 
 static void ProcessL2capConnectionResponse(
-    uint8_t type, const AclConnInfo *aclInfo, const L2capSignalingHeader *l2capsignalingHeader, const uint8_t *data)
+    uint8_t type, AclConnInfo *aclInfo, const L2capSignalingHeader *l2capsignalingHeader, const uint8_t *data)
 {
     uint16_t offset = 0;
     uint16_t *dcid = (uint16_t *)(data + offset);
@@ -461,33 +519,20 @@ static void ProcessL2capConnectionResponse(
         return;
     }
 
-    FilterL2capChannelConnInfo *connInfo = NULL;
-    if (type == TRANSMISSON_TYPE_H2C_DATA) {
-        RemoteSearchInfo remoteInfo = {
-            .aclHandle = aclInfo->handle,
-            .remoteCid = *scid,
-        };
-        connInfo = ListForEachData(g_filterL2capConnList, FindL2capConnByRemoteInfo, &remoteInfo);
-    } else {
-        connInfo = ListForEachData(g_filterL2capConnList, FindL2capConnByLocalCid, scid);
-    }
-
+    FilterL2capChannelConnInfo *connInfo =
+        FindL2capConnByCid(aclInfo, type != TRANSMISSON_TYPE_H2C_DATA, *scid);
     if (connInfo != NULL) {
         if (*result == L2CAP_CONNECTION_SUCCESSFUL) {
-            if (type == TRANSMISSON_TYPE_H2C_DATA) {
-                connInfo->localCid = *dcid;
-            } else {
-                connInfo->remoteCid = *dcid;
-            }
+            SetL2capConnCid(connInfo, type == TRANSMISSON_TYPE_H2C_DATA, *dcid);
             connInfo->status = CONNECTED;
         } else {
-            ListRemoveNode(g_filterL2capConnList, connInfo);
+            RemoveL2capConnection(connInfo);
         }
     }
 }
 
 static void ProcessL2capConfigurationRequest(
-    uint8_t type, const AclConnInfo *aclInfo, const L2capSignalingHeader *l2capsignalingHeader, const uint8_t *data)
+    uint8_t type, AclConnInfo *aclInfo, const L2capSignalingHeader *l2capsignalingHeader, const uint8_t *data)
 {
     uint16_t offset = 0;
     uint16_t *dcid = (uint16_t *)(data + offset);
@@ -504,17 +549,8 @@ static void ProcessL2capConfigurationRequest(
                 uint8_t mode = *(uint8_t *)(data + offset);
                 offset += sizeof(uint8_t);
 
-                FilterL2capChannelConnInfo *connInfo = NULL;
-                if (type == TRANSMISSON_TYPE_H2C_DATA) {
-                    RemoteSearchInfo remoteInfo = {
-                        .aclHandle = aclInfo->handle,
-                        .remoteCid = *dcid,
-                    };
-                    connInfo = ListForEachData(g_filterL2capConnList, FindL2capConnByRemoteInfo, &remoteInfo);
-                } else {
-                    connInfo = ListForEachData(g_filterL2capConnList, FindL2capConnByLocalCid, dcid);
-                }
-
+                FilterL2capChannelConnInfo *connInfo =
+                    FindL2capConnByCid(aclInfo, type != TRANSMISSON_TYPE_H2C_DATA, *dcid);
                 if (connInfo != NULL) {
                     connInfo->headerLength =
                         (mode == L2CAP_BASIC_MODE) ? sizeof(L2capBasicHeader) : sizeof(L2capNotBasicHeader);
@@ -528,7 +564,7 @@ static void ProcessL2capConfigurationRequest(
 }
 
 static void ProcessL2capConfigurationResponse(
-    uint8_t type, const AclConnInfo *aclInfo, const L2capSignalingHeader *l2capsignalingHeader, const uint8_t *data)
+    uint8_t type, AclConnInfo *aclInfo, const L2capSignalingHeader *l2capsignalingHeader, const uint8_t *data)
 {
     uint16_t offset = 0;
     uint16_t *scid = (uint16_t *)(data + offset);
@@ -550,17 +586,8 @@ static void ProcessL2capConfigurationResponse(
                 uint8_t mode = *(uint8_t *)(data + offset);
                 offset += sizeof(uint8_t);
 
-                FilterL2capChannelConnInfo *connInfo = NULL;
-                if (type == TRANSMISSON_TYPE_H2C_DATA) {
-                    RemoteSearchInfo remoteInfo = {
-                        .aclHandle = aclInfo->handle,
-                        .remoteCid = *scid,
-                    };
-                    connInfo = ListForEachData(g_filterL2capConnList, FindL2capConnByRemoteInfo, &remoteInfo);
-                } else {
-                    connInfo = ListForEachData(g_filterL2capConnList, FindL2capConnByLocalCid, scid);
-                }
-
+                FilterL2capChannelConnInfo *connInfo =
+                    FindL2capConnByCid(aclInfo, type != TRANSMISSON_TYPE_H2C_DATA, *scid);
                 if (connInfo != NULL) {
                     connInfo->headerLength =
                         (mode == L2CAP_BASIC_MODE) ? sizeof(L2capBasicHeader) : sizeof(L2capNotBasicHeader);
@@ -574,7 +601,7 @@ static void ProcessL2capConfigurationResponse(
 }
 
 static void ProcessL2capDisconnectionResponse(
-    uint8_t type, const AclConnInfo *aclInfo, const L2capSignalingHeader *l2capsignalingHeader, const uint8_t *data)
+    uint8_t type, AclConnInfo *aclInfo, const L2capSignalingHeader *l2capsignalingHeader, const uint8_t *data)
 {
     uint16_t offset = 0;
     uint16_t *dcid = (uint16_t *)(data + offset);
@@ -586,10 +613,10 @@ static void ProcessL2capDisconnectionResponse(
         return;
     }
 
-    RemoveL2capConnectionByLocalCid((type == TRANSMISSON_TYPE_H2C_DATA) ? *dcid : *scid);
+    RemoveL2capConnectionByLocalCid(aclInfo, (type == TRANSMISSON_TYPE_H2C_DATA) ? *dcid : *scid);
 }
 
-static void ProcessL2capConnInfo(uint8_t type, const AclConnInfo *aclInfo, const uint8_t *data, uint16_t originalLength)
+static void ProcessL2capConnInfo(uint8_t type, AclConnInfo *aclInfo, const uint8_t *data, uint16_t originalLength)
 {
     uint16_t offset = 0;
     L2capBasicHeader *l2capHeader = (L2capBasicHeader *)(data + offset);
@@ -624,45 +651,10 @@ static void ProcessL2capConnInfo(uint8_t type, const AclConnInfo *aclInfo, const
     }
 }
 
-static FilterL2capChannelConnInfo *SearchL2capChannelConnInfo(uint8_t type, uint16_t aclHandle, uint16_t channelId)
-{
-    if (type == TRANSMISSON_TYPE_H2C_DATA) {
-        RemoteSearchInfo remoteInfo = {
-            .aclHandle = aclHandle,
-            .remoteCid = channelId,
-        };
-        return ListForEachData(g_filterL2capConnList, FindL2capConnByRemoteInfo, &remoteInfo);
-    } else {
-        return ListForEachData(g_filterL2capConnList, FindL2capConnByLocalCid, &channelId);
-    }
-}
-
-static bool RfcommDlciFilterCheck(uint8_t type, uint16_t aclHandle, uint16_t channelId, uint8_t dlci, uint8_t *module)
+static bool RfcommDlciFilterCheck(const FilterL2capChannelConnInfo *l2capInfo, uint8_t dlci, uint8_t *module)
 {
-    AclConnInfo *aclInfo = ListForEachData(g_aclConnList, FindAclConnInfoByHandle, &aclHandle);
-    if (aclInfo == NULL) {
-        return false;
-    }
-
-    FilterL2capChannelConnInfo *l2capInfo = SearchL2capChannelConnInfo(type, aclHandle, channelId);
-    if (l2capInfo == NULL) {
-        return false;
-    }
-    BtmSnoopFilterInfo cmpinfo = {
-        .isLocal = !(l2capInfo->isInitiator ^ (dlci & 0x01)),
-        .rfcommScn = dlci >> RFCOMM_DLCI_SHIFT_SCN,
-    };
-    if (!cmpinfo.isLocal) {
-        cmpinfo.remoteAddr = aclInfo->addr;
-    }
-    BtmSnoopFilterInfo *btmSnoopFilterInfo =
-        ListForEachData(BtmGetFilterInfoList(), BtmFindFilterInfoByInfoUseScn, &cmpinfo);
-    if (btmSnoopFilterInfo == NULL) {
-        return false;
-    }
-    *module = btmSnoopFilterInfo->module;
-
-    return true;
+    bool isLocal = !(l2capInfo->isInitiator ^ (dlci & 0x01));
+    return BtmFindFilterModuleByScn(isLocal, dlci >> RFCOMM_DLCI_SHIFT_SCN, &l2capInfo->acl->addr, module);
 }
 
 static bool RfcommDataCheckFrameTypeUih(const uint8_t **data, uint16_t originalLength,
@@ -716,8 +708,6 @@ static bool RfcommDataFilterUseHfp(
         if (!memcmp(*data + offset, at, strlen(at))) {
             offset += strlen(at);
             BtmChangeIncludeLength(includedLength, offset);
-            uint8_t *copyData = BtmCreateFilterBuffer(includedLength, *data);
-            *data = copyData;
             return true;
         }
     }
@@ -731,7 +721,6 @@ static bool RfcommDataFilterUseHfp(
             if (!memcmp(*data + offset, at, strlen(at))) {
                 offset += strlen(at) + 1; /* '?' '=' other */
                 BtmChangeIncludeLength(includedLength, offset);
-                *data = BtmCreateFilterBuffer(includedLength, *data);
                 return true;
             }
         }
@@ -746,7 +735,6 @@ static bool RfcommDataFilterUseOther(
 
     if (RfcommDataCheckFrameTypeUih(data, originalLength, l2capInfo, &offset, NULL)) {
         BtmChangeIncludeLength(includedLength, offset);
-        *data = BtmCreateFilterBuffer(includedLength, *data);
         return true;
     }
     return false;
@@ -769,7 +757,6 @@ static bool L2capDataFilterUseGoepPbap(
     const uint8_t **data, uint16_t originalLength, uint16_t *includedLength, FilterL2capChannelConnInfo *l2capInfo)
 {
     BtmChangeIncludeLength(includedLength, sizeof(HciAclDataHeader) + l2capInfo->headerLength);
-    *data = BtmCreateFilterBuffer(includedLength, *data);
     return true;
 }
 
@@ -777,18 +764,13 @@ static bool L2capDataFilterUseGoepMap(
     const uint8_t **data, uint16_t originalLength, uint16_t *includedLength, FilterL2capChannelConnInfo *l2capInfo)
 {
     BtmChangeIncludeLength(includedLength, sizeof(HciAclDataHeader) + l2capInfo->headerLength);
-    *data = BtmCreateFilterBuffer(includedLength, *data);
     return true;
 }
 
-static bool L2capDataFilterUseRfcomm(uint8_t type, const uint8_t **data, uint16_t originalLength,
-    uint16_t *includedLength, FilterL2capChannelConnInfo *l2capInfo)
+static bool L2capDataFilterUseRfcomm(
+    const uint8_t **data, uint16_t originalLength, uint16_t *includedLength, FilterL2capChannelConnInfo *l2capInfo)
 {
-    uint16_t offset = 0;
-    HciAclDataHeader *hciHeader = (HciAclDataHeader *)(*data + offset);
-    offset += sizeof(HciAclDataHeader);
-    L2capBasicHeader *l2capHeader = (L2capBasicHeader *)(*data + offset);
-    offset += l2capInfo->headerLength;
+    uint16_t offset = sizeof(HciAclDataHeader) + l2capInfo->headerLength;
     const uint8_t *address = *data + offset;
     offset += sizeof(uint8_t);
 
@@ -799,7 +781,7 @@ static bool L2capDataFilterUseRfcomm(uint8_t type, const uint8_t **data, uint16_
     uint8_t module;
     bool isFiltered = false;
 
-    if (RfcommDlciFilterCheck(type, hciHeader->handle, l2capHeader->channelId, dlci, &module)) {
+    if (RfcommDlciFilterCheck(l2capInfo, dlci, &module)) {
         switch (module) {
             case BTM_HCI_LOG_FILTER_MODULE_HFP:
                 isFiltered = RfcommDataFilterUseHfp(data, originalLength, includedLength, l2capInfo);
@@ -820,7 +802,6 @@ static bool L2capDataFilterUseAvdtp(
     uint16_t offset = sizeof(HciAclDataHeader) + l2capInfo->headerLength + AVDT_MEDIA_PACKET_HEADER_LEN;
 
     BtmChangeIncludeLength(includedLength, offset);
-    *data = BtmCreateFilterBuffer(includedLength, *data);
     return true;
 }
 
@@ -841,7 +822,6 @@ static bool L2capDataFilterUseAvctp(
     offset += sizeof(uint8_t);
     if (*pduId == AVRCP_PDU_ID_GET_ELEMENT_ATTR) {
         BtmChangeIncludeLength(includedLength, offset);
-        *data = BtmCreateFilterBuffer(includedLength, *data);
     }
 
     return false;
@@ -855,7 +835,6 @@ static bool L2capDataFilterUseAvctpBrowsing(
     offset += sizeof(uint8_t);
     if (*pduId == AVRCP_BROWSING_PDU_ID_GET_ITEM_ATTR) {
         BtmChangeIncludeLength(includedLength, offset);
-        *data = BtmCreateFilterBuffer(includedLength, *data);
     }
 
     return false;
@@ -886,7 +865,6 @@ static bool L2capDataFilterUseAtt(
         case HANDLE_VALUE_INDICATION:
         case SIGNED_WRITE_COMMAND:
             BtmChangeIncludeLength(includedLength, offset);
-            *data = BtmCreateFilterBuffer(includedLength, *data);
             break;
         default:
             return false;
@@ -912,7 +890,6 @@ static bool L2capDataFilterUseSmp(
         case SMP_CODE_PAIRING_PUBLIC_KEY:
         case SMP_CODE_PAIRING_DHKEY_CHECK:
             BtmChangeIncludeLength(includedLength, offset);
-            *data = BtmCreateFilterBuffer(includedLength, *data);
             break;
         case SMP_CODE_IDENTITY_ADDR_INFO:
             offset += sizeof(uint8_t);
@@ -927,8 +904,8 @@ static bool L2capDataFilterUseSmp(
     return true;
 }
 
-static void L2capDataCheckFilter(uint8_t type, FilterL2capChannelConnInfo *connInfo, const uint8_t **data,
-    uint16_t originalLength, uint16_t *includedLength)
+static void L2capDataCheckFilter(
+    FilterL2capChannelConnInfo *connInfo, const uint8_t **data, uint16_t originalLength, uint16_t *includedLength)
 {
     bool isFiltered;
 
@@ -940,7 +917,7 @@ static void L2capDataCheckFilter(uint8_t type, FilterL2capChannelConnInfo *connI
             isFiltered = L2capDataFilterUseGoepMap(data, originalLength, includedLength, connInfo);
             break;
         case BTM_HCI_LOG_FILTER_MODULE_RFCOMM:
-            isFiltered = L2capDataFilterUseRfcomm(type, data, originalLength, includedLength, connInfo);
+            isFiltered = L2capDataFilterUseRfcomm(data, originalLength, includedLength, connInfo);
             break;
         case BTM_HCI_LOG_FILTER_MODULE_AVCTP:
             isFiltered = L2capDataFilterUseAvctp(data, originalLength, includedLength, connInfo);
@@ -964,7 +941,7 @@ static void L2capDataCheckFilter(uint8_t type, FilterL2capChannelConnInfo *connI
         default:
             return;
     }
-    SetAclPrevPktIsFiltered(connInfo->acl->handle, isFiltered);
+    connInfo->acl->prevPktIsFiltered = isFiltered;
 }
 
 void BtmFilterAclData(uint8_t type, const uint8_t **data, uint16_t originalLength, uint16_t *includedLength)
@@ -974,7 +951,7 @@ void BtmFilterAclData(uint8_t type, const uint8_t **data, uint16_t originalLengt
     offset += sizeof(HciAclDataHeader);
 
     uint16_t handle = hciHeader->handle;
-    AclConnInfo *aclInfo = ListForEachData(g_aclConnList, FindAclConnInfoByHandle, &handle);
+    AclConnInfo *aclInfo = FindAclConnInfoByHandle(handle);
     if (aclInfo == NULL) {
         return;
     }
@@ -982,7 +959,6 @@ void BtmFilterAclData(uint8_t type, const uint8_t **data, uint16_t originalLengt
     if (hciHeader->pbFlag == HCI_PACKET_BOUNDARY_CONTINUING) {
         if (aclInfo->prevPktIsFiltered) {
             BtmChangeIncludeLength(includedLength, sizeof(HciAclDataHeader));
-            *data = BtmCreateFilterBuffer(includedLength, *data);
         }
         return;
     } else {
@@ -996,10 +972,11 @@ void BtmFilterAclData(uint8_t type, const uint8_t **data, uint16_t originalLengt
 
     L2capBasicHeader *l2capHeader = (L2capBasicHeader *)(*data + offset);
 
-    FilterL2capChannelConnInfo *connInfo = SearchL2capChannelConnInfo(type, hciHeader->handle, l2capHeader->channelId);
+    FilterL2capChannelConnInfo *connInfo =
+        FindL2capConnByCid(aclInfo, type != TRANSMISSON_TYPE_H2C_DATA, l2capHeader->channelId);
     if (connInfo == NULL) {
         return;
     }
 
-    L2capDataCheckFilter(type, connInfo, data, originalLength, includedLength);
+    L2capDataCheckFilter(connInfo, data, originalLength, includedLength);
 }
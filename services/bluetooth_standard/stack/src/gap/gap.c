@@ -184,7 +184,9 @@ static void GapDisableTask(void *ctx)
         ListClear(g_gapMng.bredr.connectionInfoBlock.devicelist);
         g_gapMng.bredr.scanModeBlock.status = GAP_SCANMODE_STATUS_IDLE;
         g_gapMng.bredr.inquiryBlock.status = GAP_INQUIRY_STATUS_IDLE;
-        g_gapMng.bredr.remoteNameBlock.status = GAP_REMOTE_NAME_STATUS_IDLE;
+        for (int i = 0; i < GAP_REMOTE_NAME_REQUEST_MAX; i++) {
+            g_gapMng.bredr.remoteNameBlock.requests[i].status = GAP_REMOTE_NAME_STATUS_IDLE;
+        }
         g_gapMng.bredr.encryptionBlock.status = GAP_SET_ENCRYPTION_STATUS_IDLE;
         g_gapMng.bredr.isEnable = false;
     }
@@ -217,10 +217,34 @@ void GapInquiryCancelComplete(const HciInquiryCancelReturnParam *param)
     }
 }
 
+static RemoteNameRequest *GapFindRemoteNameRequest(const uint8_t addr[BT_ADDRESS_SIZE])
+{
+    RemoteNameBlock *remoteNameBlock = GapGetRemoteNameBlock();
+    for (int i = 0; i < GAP_REMOTE_NAME_REQUEST_MAX; i++) {
+        RemoteNameRequest *request = &remoteNameBlock->requests[i];
+        if ((request->status != GAP_REMOTE_NAME_STATUS_IDLE) &&
+            (memcmp(request->addr.addr, addr, BT_ADDRESS_SIZE) == 0)) {
+            return request;
+        }
+    }
+    return NULL;
+}
+
+static RemoteNameRequest *GapAllocRemoteNameRequest(void)
+{
+    RemoteNameBlock *remoteNameBlock = GapGetRemoteNameBlock();
+    for (int i = 0; i < GAP_REMOTE_NAME_REQUEST_MAX; i++) {
+        if (remoteNameBlock->requests[i].status == GAP_REMOTE_NAME_STATUS_IDLE) {
+            return &remoteNameBlock->requests[i];
+        }
+    }
+    return NULL;
+}
+
 int GAP_GetRemoteName(const BtAddr *addr)
 {
     int ret;
-    RemoteNameBlock *remoteNameBlock = NULL;
+    RemoteNameRequest *request = NULL;
     BtmInquiryInfo inquiryInfo;
 
     LOG_INFO("%{public}s:" BT_ADDR_FMT, __FUNCTION__, BT_ADDR_FMT_OUTPUT(addr->addr));
@@ -229,13 +253,18 @@ int GAP_GetRemoteName(const BtAddr *addr)
         return GAP_ERR_NOT_ENABLE;
     }
 
-    remoteNameBlock = GapGetRemoteNameBlock();
-    if (remoteNameBlock->status != GAP_REMOTE_NAME_STATUS_IDLE) {
-        ret = GAP_ERR_INVAL_STATE;
+    if (GapFindRemoteNameRequest(addr->addr) != NULL) {
+        return GAP_ERR_REPEATED;
+    }
+
+    request = GapAllocRemoteNameRequest();
+    if (request == NULL) {
+        ret = GAP_ERR_OUT_OF_RES;
     } else {
         HciRemoteNameRequestParam hciCmdParam = {0};
 
-        remoteNameBlock->status = GAP_REMOTE_NAME_STATUS_START;
+        request->status = GAP_REMOTE_NAME_STATUS_START;
+        (void)memcpy_s(&request->addr, sizeof(BtAddr), addr, sizeof(BtAddr));
         (void)memcpy_s(hciCmdParam.addr.raw, BT_ADDRESS_SIZE, addr->addr, BT_ADDRESS_SIZE);
 
         ret = BtmQueryInquiryInfoByAddr(addr, &inquiryInfo);
@@ -245,6 +274,9 @@ int GAP_GetRemoteName(const BtAddr *addr)
         }
 
         ret = HCI_RemoteNameRequest(&hciCmdParam);
+        if (ret != BT_NO_ERROR) {
+            request->status = GAP_REMOTE_NAME_STATUS_IDLE;
+        }
     }
 
     return ret;
@@ -253,13 +285,14 @@ int GAP_GetRemoteName(const BtAddr *addr)
 void GapOnGetRemoteNameComplete(const HciRemoteNameRequestCompleteEventParam *eventParam)
 {
     LOG_DEBUG("%{public}s:", __FUNCTION__);
-    RemoteNameBlock *remoteNameBlock = NULL;
+    RemoteNameRequest *request = NULL;
 
-    remoteNameBlock = GapGetRemoteNameBlock();
-    if (remoteNameBlock->status == GAP_REMOTE_NAME_STATUS_IDLE) {
+    request = GapFindRemoteNameRequest(eventParam->bdAddr.raw);
+    if (request == NULL) {
         LOG_ERROR("Error Status");
+    } else {
+        request->status = GAP_REMOTE_NAME_STATUS_IDLE;
     }
-    remoteNameBlock->status = GAP_REMOTE_NAME_STATUS_IDLE;
     BtAddr addr = BT_ADDR_NULL;
     GapChangeHCIAddr(&addr, &eventParam->bdAddr, BT_PUBLIC_DEVICE_ADDRESS);
 
@@ -272,7 +305,7 @@ void GapOnGetRemoteNameComplete(const HciRemoteNameRequestCompleteEventParam *ev
 int GAP_GetRemoteNameCancel(const BtAddr *addr)
 {
     int ret;
-    RemoteNameBlock *remoteNameBlock = NULL;
+    RemoteNameRequest *request = NULL;
 
     LOG_INFO("%{public}s:" BT_ADDR_FMT, __FUNCTION__, BT_ADDR_FMT_OUTPUT(addr->addr));
 
@@ -280,11 +313,11 @@ int GAP_GetRemoteNameCancel(const BtAddr *addr)
         return GAP_ERR_NOT_ENABLE;
     }
 
-    remoteNameBlock = GapGetRemoteNameBlock();
-    if (remoteNameBlock->status == GAP_REMOTE_NAME_STATUS_IDLE) {
+    request = GapFindRemoteNameRequest(addr->addr);
+    if (request == NULL) {
         ret = GAP_ERR_INVAL_STATE;
     } else {
-        remoteNameBlock->status = GAP_REMOTE_NAME_STATUS_CANCEL;
+        request->status = GAP_REMOTE_NAME_STATUS_CANCEL;
         HciRemoteNameRequestCancelParam hciCmdParam;
         (void)memcpy_s(hciCmdParam.addr.raw, BT_ADDRESS_SIZE, addr->addr, BT_ADDRESS_SIZE);
 
@@ -297,10 +330,10 @@ int GAP_GetRemoteNameCancel(const BtAddr *addr)
 void GapGetRemoteNameCancelComplete(const HciRemoteNameRequestCancelReturnParam *param)
 {
     LOG_DEBUG("%{public}s:", __FUNCTION__);
-    RemoteNameBlock *remoteNameBlock = NULL;
+    RemoteNameRequest *request = NULL;
 
-    remoteNameBlock = GapGetRemoteNameBlock();
-    if (remoteNameBlock->status == GAP_REMOTE_NAME_STATUS_CANCEL) {
+    request = GapFindRemoteNameRequest(param->addr.raw);
+    if ((request != NULL) && (request->status == GAP_REMOTE_NAME_STATUS_CANCEL)) {
         if (param->status != HCI_SUCCESS) {
             LOG_ERROR("Get Remote Name Cancel Fail. status = %hhu", param->status);
         }
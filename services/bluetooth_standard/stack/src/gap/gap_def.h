@@ -180,6 +180,11 @@ typedef struct {
 
 typedef struct {
     uint8_t status;
+    BtAddr addr;
+} RemoteNameRequest;
+
+typedef struct {
+    RemoteNameRequest requests[GAP_REMOTE_NAME_REQUEST_MAX];
 } RemoteNameBlock;
 
 typedef struct {
@@ -20,6 +20,7 @@
 
 #include "allocator.h"
 #include "log.h"
+#include "perf_counter.h"
 #include "thread.h"
 
 #include "btm/btm_thread.h"
@@ -744,6 +745,7 @@ static void GapRecvLeAdvertisingReportEvent(const HciLeAdvertisingReportEventPar
     hciParam.reports = MEM_MALLOC.alloc(hciParam.numReports * sizeof(HciLeAdvertisingReport));
     if (hciParam.reports == NULL) {
         LOG_ERROR("%{public}s: Alloc report error.", __FUNCTION__);
+        PerfCounterAdd(PERF_COUNTER_SCAN_REPORTS_DROPPED, hciParam.numReports);
         return;
     }
 
@@ -768,6 +770,7 @@ static void GapRecvLeAdvertisingReportEvent(const HciLeAdvertisingReportEventPar
             MEM_MALLOC.free(hciParam.reports[index].data);
         }
         MEM_MALLOC.free(hciParam.reports);
+        PerfCounterAdd(PERF_COUNTER_SCAN_REPORTS_DROPPED, hciParam.numReports);
         return;
     }
 
@@ -775,6 +778,7 @@ static void GapRecvLeAdvertisingReportEvent(const HciLeAdvertisingReportEventPar
         (TaskFunc)GapOnLeAdvertisingReportEvent, &hciParam, sizeof(hciParam), GapFreeLeAdvertisingReportEvent);
     if (ret != BT_NO_ERROR) {
         LOG_ERROR("%{public}s: Task error:%{public}d.", __FUNCTION__, ret);
+        PerfCounterAdd(PERF_COUNTER_SCAN_REPORTS_DROPPED, hciParam.numReports);
     }
 }
 
@@ -837,6 +841,7 @@ static void GapRecvLeExtendedAdvertisingReportEvent(const HciLeExtendedAdvertisi
     hciParam.reports = MEM_MALLOC.alloc(hciParam.numReports * sizeof(HciLeExtendedAdvertisingReport));
     if (hciParam.reports == NULL) {
         LOG_ERROR("%{public}s: Alloc report error.", __FUNCTION__);
+        PerfCounterAdd(PERF_COUNTER_SCAN_REPORTS_DROPPED, hciParam.numReports);
         return;
     }
 
@@ -861,6 +866,7 @@ static void GapRecvLeExtendedAdvertisingReportEvent(const HciLeExtendedAdvertisi
             MEM_MALLOC.free(hciParam.reports[i].data);
         }
         MEM_MALLOC.free(hciParam.reports);
+        PerfCounterAdd(PERF_COUNTER_SCAN_REPORTS_DROPPED, hciParam.numReports);
         return;
     }
 
@@ -870,6 +876,7 @@ static void GapRecvLeExtendedAdvertisingReportEvent(const HciLeExtendedAdvertisi
         GapFreeLeExtendedAdvertisingReportEvent);
     if (ret != BT_NO_ERROR) {
         LOG_ERROR("%{public}s: Task error:%{public}d.", __FUNCTION__, ret);
+        PerfCounterAdd(PERF_COUNTER_SCAN_REPORTS_DROPPED, hciParam.numReports);
     }
 }
 
@@ -18,6 +18,7 @@
 #include <stdbool.h>
 
 #include "btstack.h"
+#include "perf_counter.h"
 #include "platform/include/allocator.h"
 #include "platform/include/list.h"
 #include "platform/include/mutex.h"
@@ -30,6 +31,8 @@
 #define PACKET_BOUNDARY_CONTINUING 0x01
 #define PACKET_BOUNDARY_FIRST_FLUSHABLE 0x02
 
+#define L2CAP_BASIC_HEADER_LENGTH 4
+
 #define BROADCAST_POINT_TO_POINT 0x00
 #define BROADCAST_ACTIVE_SLAVE 0x01
 
@@ -42,16 +45,18 @@ typedef struct {
     uint16_t bcFlag : 2;
     uint16_t dataTotalLength;
 } HciAclDataHeader;
+#pragma pack()
 
 typedef struct {
     uint16_t connectionHandle;
     uint8_t transport;
+    HciAclTrafficStats traffic;
 } HciConnectionHandleBlock;
-#pragma pack()
 
 typedef struct {
     uint16_t connectionHandle;
-    uint16_t count;
+    uint16_t count;        // Packets sent to the controller and not completed yet.
+    uint16_t cachedCount;  // Packets waiting for a free controller buffer.
 } HciTxPackets;
 
 static uint16_t g_aclDataPacketLength = 0;
@@ -63,6 +68,7 @@ static Mutex *g_numOfAclDataPacketsLock = NULL;
 
 static List *g_aclDataCache = NULL;
 static Mutex *g_aclDataCacheLock = NULL;
+static uint64_t g_aclCreditStallStartUs = 0;  // When g_aclDataCache last became non-empty, 0 if it is empty.
 
 static bool g_sharedDataBuffers = false;
 static uint16_t g_leAclDataPacketLength = 0;
@@ -74,6 +80,7 @@ static Mutex *g_numOfLeDataPacketsLock = NULL;
 
 static List *g_leAclDataCache = NULL;
 static Mutex *g_leAclDataCacheLock = NULL;
+static uint64_t g_leCreditStallStartUs = 0;
 
 static List *g_hciAclCallbackList = NULL;
 static Mutex *g_hciAclCallbackListLock = NULL;
@@ -83,17 +90,18 @@ static Mutex *g_connectionHandleListLock = NULL;
 
 static HciConnectionHandleBlock *HciAllocConnectionHandleBlock(uint16_t connectionHandle, uint8_t transport)
 {
-    HciConnectionHandleBlock *block = MEM_MALLOC.alloc(sizeof(HciConnectionHandleBlock));
+    HciConnectionHandleBlock *block = MEM_CALLOC.alloc(sizeof(HciConnectionHandleBlock));
     if (block != NULL) {
         block->connectionHandle = connectionHandle;
         block->transport = transport;
+        block->traffic.lastActivityUs = PerfClockUs();
     }
     return block;
 }
 
 static void HciFreeConnectionHandleBlock(void *block)
 {
-    MEM_MALLOC.free(block);
+    MEM_CALLOC.free(block);
 }
 
 static HciConnectionHandleBlock *HciFindConnectionHandleBlock(uint16_t connectionHandle)
@@ -277,6 +285,27 @@ static void HciAddTxAclPacket(uint16_t connectionHandle)
     }
 }
 
+static void HciAddCachedAclPacket(uint16_t connectionHandle)
+{
+    HciTxPackets *entity = FindTxPacketsEntityByConnectionHandle(connectionHandle);
+    if (entity == NULL) {
+        entity = AllocTxPacketsEntity(connectionHandle);
+        ListAddLast(g_txAclPackets, entity);
+    }
+
+    if (entity != NULL) {
+        entity->cachedCount++;
+    }
+}
+
+static void HciRemoveCachedAclPacket(uint16_t connectionHandle)
+{
+    HciTxPackets *entity = FindTxPacketsEntityByConnectionHandle(connectionHandle);
+    if ((entity != NULL) && (entity->cachedCount > 0)) {
+        entity->cachedCount--;
+    }
+}
+
 static void HciOnAclPacketComplete(uint16_t connectionHandle, uint16_t count)
 {
     HciTxPackets *entity = FindTxPacketsEntityByConnectionHandle(connectionHandle);
@@ -298,6 +327,27 @@ static void HciAddTxLePacket(uint16_t connectionHandle)
     }
 }
 
+static void HciAddCachedLePacket(uint16_t connectionHandle)
+{
+    HciTxPackets *entity = FindLeTxPacketsEntityByConnectionHandle(connectionHandle);
+    if (entity == NULL) {
+        entity = AllocTxPacketsEntity(connectionHandle);
+        ListAddLast(g_txLePackets, entity);
+    }
+
+    if (entity != NULL) {
+        entity->cachedCount++;
+    }
+}
+
+static void HciRemoveCachedLePacket(uint16_t connectionHandle)
+{
+    HciTxPackets *entity = FindLeTxPacketsEntityByConnectionHandle(connectionHandle);
+    if ((entity != NULL) && (entity->cachedCount > 0)) {
+        entity->cachedCount--;
+    }
+}
+
 static void HciOnLePacketComplete(uint16_t connectionHandle, uint16_t count)
 {
     HciTxPackets *entity = FindLeTxPacketsEntityByConnectionHandle(connectionHandle);
@@ -441,6 +491,23 @@ static Packet **HciFargment(uint16_t handle, uint8_t flushable, Packet *packet,
     return fargmentedPackets;
 }
 
+static void HciCacheStalledPacket(List *cache, uint64_t *stallStartUs, Packet *packet)
+{
+    if (ListGetSize(cache) == 0) {
+        *stallStartUs = PerfClockUs();
+    }
+    ListAddLast(cache, packet);
+    PerfCounterAdd(PERF_COUNTER_ACL_CREDIT_STALLS, 1);
+}
+
+static void HciEndCreditStall(uint64_t *stallStartUs)
+{
+    if (*stallStartUs != 0) {
+        PerfHistogramRecord(PERF_HISTOGRAM_ACL_CREDIT_STALL_US, PerfClockUs() - *stallStartUs);
+        *stallStartUs = 0;
+    }
+}
+
 static int HciSendSinglePacket(uint16_t connectionHandle, Packet *packet)
 {
     int result = BT_NO_ERROR;
@@ -452,8 +519,9 @@ static int HciSendSinglePacket(uint16_t connectionHandle, Packet *packet)
         }
     } else {
         MutexLock(g_aclDataCacheLock);
-        ListAddLast(g_aclDataCache, packet);
+        HciCacheStalledPacket(g_aclDataCache, &g_aclCreditStallStartUs, packet);
         MutexUnlock(g_aclDataCacheLock);
+        HciAddCachedAclPacket(connectionHandle);
     }
     return result;
 }
@@ -507,8 +575,9 @@ static int HciSendLeSinglePacket(uint16_t connectionHandle, Packet *packet)
         }
     } else {
         MutexLock(g_leAclDataCacheLock);
-        ListAddLast(g_leAclDataCache, packet);
+        HciCacheStalledPacket(g_leAclDataCache, &g_leCreditStallStartUs, packet);
         MutexUnlock(g_leAclDataCacheLock);
+        HciAddCachedLePacket(connectionHandle);
     }
     return result;
 }
@@ -556,6 +625,7 @@ int HCI_SendAclData(uint16_t handle, uint8_t flushable, Packet *packet)
     HciConnectionHandleBlock *block = NULL;
 
     uint8_t transport = 0;
+    uint32_t size = PacketSize(packet);
 
     MutexLock(g_connectionHandleListLock);
 
@@ -582,16 +652,95 @@ int HCI_SendAclData(uint16_t handle, uint8_t flushable, Packet *packet)
             break;
     }
 
+    if (result == BT_NO_ERROR) {
+        block->traffic.txPackets++;
+        block->traffic.txBytes += size;
+        block->traffic.lastActivityUs = PerfClockUs();
+    }
+
+    MutexUnlock(g_connectionHandleListLock);
+
+    return result;
+}
+
+int HCI_GetAclTxQueueLength(uint16_t handle, uint16_t *queueLength)
+{
+    if (queueLength == NULL) {
+        return BT_BAD_PARAM;
+    }
+
+    HciTxPackets *entity = NULL;
+    uint8_t transport = HciAclGetTransport(handle);
+    if ((transport == TRANSPORT_BREDR) || ((transport == TRANSPORT_LE) && g_sharedDataBuffers)) {
+        MutexLock(g_numOfAclDataPacketsLock);
+        entity = FindTxPacketsEntityByConnectionHandle(handle);
+        *queueLength = (entity != NULL) ? (entity->count + entity->cachedCount) : 0;
+        MutexUnlock(g_numOfAclDataPacketsLock);
+    } else if (transport == TRANSPORT_LE) {
+        MutexLock(g_numOfLeDataPacketsLock);
+        entity = FindLeTxPacketsEntityByConnectionHandle(handle);
+        *queueLength = (entity != NULL) ? (entity->count + entity->cachedCount) : 0;
+        MutexUnlock(g_numOfLeDataPacketsLock);
+    } else {
+        return BT_BAD_STATUS;
+    }
+
+    return BT_NO_ERROR;
+}
+
+int HCI_GetAclTrafficStats(uint16_t handle, HciAclTrafficStats *stats)
+{
+    if (stats == NULL) {
+        return BT_BAD_PARAM;
+    }
+
+    int result = BT_BAD_STATUS;
+
+    MutexLock(g_connectionHandleListLock);
+
+    HciConnectionHandleBlock *block = HciFindConnectionHandleBlock(handle);
+    if (block != NULL) {
+        *stats = block->traffic;
+        result = BT_NO_ERROR;
+    }
+
     MutexUnlock(g_connectionHandleListLock);
 
     return result;
 }
 
+static void HciAclOnRxData(uint16_t connectionHandle, uint8_t pbFlag, const Packet *packet)
+{
+    // Counted per L2CAP PDU like the sent data: the start fragment carries the length of the whole PDU.
+    if (pbFlag == PACKET_BOUNDARY_CONTINUING) {
+        return;
+    }
+
+    uint8_t l2capHeader[L2CAP_BASIC_HEADER_LENGTH] = {0};
+    uint32_t size = PacketSize(packet);
+    if (PacketRead(packet, l2capHeader, 0, sizeof(l2capHeader)) == sizeof(l2capHeader)) {
+        size = sizeof(l2capHeader) + (uint32_t)(l2capHeader[0] | (l2capHeader[1] << 8));
+    }
+
+    MutexLock(g_connectionHandleListLock);
+
+    HciConnectionHandleBlock *block = HciFindConnectionHandleBlock(connectionHandle);
+    if (block != NULL) {
+        block->traffic.rxPackets++;
+        block->traffic.rxBytes += size;
+        block->traffic.lastActivityUs = PerfClockUs();
+    }
+
+    MutexUnlock(g_connectionHandleListLock);
+}
+
 void HciOnAclData(Packet *packet)
 {
     HciAclDataHeader header;
     PacketExtractHead(packet, (uint8_t *)&header, sizeof(header));
 
+    HciAclOnRxData(header.handle, header.pbFlag & 0x3, packet);
+
     MutexLock(g_hciAclCallbackListLock);
 
     HciAclCallbacks *callback = NULL;
@@ -620,12 +769,16 @@ static void HciSendCachedAclPackets()
         if (node != NULL) {
             packet = ListGetNodeData(node);
             ListRemoveNode(g_aclDataCache, packet);
+            if (ListGetSize(g_aclDataCache) == 0) {
+                HciEndCreditStall(&g_aclCreditStallStartUs);
+            }
         } else {
             packet = NULL;
         }
         MutexUnlock(g_aclDataCacheLock);
         if (packet != NULL) {
             uint16_t handle = HciGetAclHandleFromPacket(packet);
+            HciRemoveCachedAclPacket(handle);
             int result = HciAclPushToTxQueue(packet);
             if (result == BT_NO_ERROR) {
                 g_numOfAclDataPackets--;
@@ -661,12 +814,16 @@ static void HciSendCachedLePackets()
         if (node != NULL) {
             packet = ListGetNodeData(node);
             ListRemoveNode(g_leAclDataCache, packet);
+            if (ListGetSize(g_leAclDataCache) == 0) {
+                HciEndCreditStall(&g_leCreditStallStartUs);
+            }
         } else {
             packet = NULL;
         }
         MutexUnlock(g_leAclDataCacheLock);
         if (packet != NULL) {
             uint16_t handle = HciGetAclHandleFromPacket(packet);
+            HciRemoveCachedLePacket(handle);
             int result = HciAclPushToTxQueue(packet);
             if (result == BT_NO_ERROR) {
                 g_numOfLeDataPackets--;
@@ -16,15 +16,15 @@
 #include "hci_cmd.h"
 
 #include <securec.h>
+#include <stddef.h>
+#include <time.h>
 
 #include "btm/btm_thread.h"
 #include "btstack.h"
 #include "platform/include/alarm.h"
 #include "platform/include/allocator.h"
 #include "platform/include/bt_endian.h"
-#include "platform/include/list.h"
 #include "platform/include/mutex.h"
-#include "platform/include/queue.h"
 
 #include "hci/acl/hci_acl.h"
 #include "hci/hci.h"
@@ -35,10 +35,18 @@
 
 #include "hci_cmd_failure.h"
 
-#define MAX_QUEUE_SIZE 32
-
 #define CMD_TIMEOUT (10 * 1000)
 
+// Commands allocated beyond the pool fall back to the heap.
+#define CMD_POOL_SIZE 32
+
+// Number of in-flight opcode buckets, a power of 2.
+#define CMD_BUCKET_COUNT 16
+#define CMD_BUCKET(opCode) (((opCode) ^ ((opCode) >> 8)) & (CMD_BUCKET_COUNT - 1))
+
+#define MS_PER_SECOND 1000
+#define NS_PER_MS 1000000
+
 #pragma pack(1)
 typedef struct {
     uint16_t opCode;
@@ -46,29 +54,121 @@ typedef struct {
 } HciCmdHeader;
 #pragma pack()
 
+typedef struct {
+    HciCmd *first;
+    HciCmd *last;
+} HciCmdQueue;
+
 static uint8_t g_numberOfHciCmd = 1;
 static Mutex *g_lockNumberOfHciCmd = NULL;
 
-static Queue *g_cmdCache = NULL;
+// Commands waiting for the controller to accept more commands.
+static HciCmdQueue g_cmdCache = {0};
 
-static List *g_processingCmds = NULL;
+// Commands sent to the controller: indexed by opcode, and ordered by deadline for the shared timeout alarm.
+static HciCmd *g_processingCmds[CMD_BUCKET_COUNT] = {0};
+static HciCmdQueue g_timeoutQueue = {0};
+static Alarm *g_cmdTimeoutAlarm = NULL;
 static Mutex *g_lockProcessingCmds = NULL;
 
+// The pool and its lock live as long as the process: a command still owned by a caller when the HCI is closed is
+// returned to it afterwards.
+static HciCmd g_cmdPool[CMD_POOL_SIZE];
+static HciCmd *g_freeCmds = NULL;
+static Mutex *g_lockCmdPool = NULL;
+
 // Function declare
-static void HciFreeCmd(void *cmd);
+static void HciFreeCmd(HciCmd *cmd);
+static void HciCmdOnCmdTimeout(void *parameter);
 
-void HciInitCmd()
+static uint64_t HciCmdGetTime()
 {
-    g_cmdCache = QueueCreate(MAX_QUEUE_SIZE);
-    g_processingCmds = ListCreate(HciFreeCmd);
+    struct timespec ts = {0};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * MS_PER_SECOND + (uint64_t)ts.tv_nsec / NS_PER_MS;
+}
 
+static void HciCmdQueueAddLast(HciCmdQueue *queue, HciCmd *cmd)
+{
+    cmd->prev = queue->last;
+    cmd->next = NULL;
+    if (queue->last != NULL) {
+        queue->last->next = cmd;
+    } else {
+        queue->first = cmd;
+    }
+    queue->last = cmd;
+}
+
+static void HciCmdQueueRemove(HciCmdQueue *queue, HciCmd *cmd)
+{
+    if (cmd->prev != NULL) {
+        cmd->prev->next = cmd->next;
+    } else {
+        queue->first = cmd->next;
+    }
+    if (cmd->next != NULL) {
+        cmd->next->prev = cmd->prev;
+    } else {
+        queue->last = cmd->prev;
+    }
+    cmd->prev = NULL;
+    cmd->next = NULL;
+}
+
+static HciCmd *HciCmdQueueRemoveFirst(HciCmdQueue *queue)
+{
+    HciCmd *cmd = queue->first;
+    if (cmd != NULL) {
+        HciCmdQueueRemove(queue, cmd);
+    }
+    return cmd;
+}
+
+void HciInitCmd()
+{
     g_numberOfHciCmd = 1;
     g_lockNumberOfHciCmd = MutexCreate();
     g_lockProcessingCmds = MutexCreate();
+    g_cmdTimeoutAlarm = AlarmCreate("hci_cmd", false);
+
+    // Built once: commands freed after a close are already back in the list.
+    if (g_lockCmdPool == NULL) {
+        g_lockCmdPool = MutexCreate();
+        g_freeCmds = NULL;
+        for (int i = CMD_POOL_SIZE - 1; i >= 0; i--) {
+            g_cmdPool[i].pooled = true;
+            g_cmdPool[i].next = g_freeCmds;
+            g_freeCmds = &g_cmdPool[i];
+        }
+    }
 }
 
 void HciCloseCmd()
 {
+    if (g_cmdTimeoutAlarm != NULL) {
+        AlarmCancel(g_cmdTimeoutAlarm);
+        AlarmDelete(g_cmdTimeoutAlarm);
+        g_cmdTimeoutAlarm = NULL;
+    }
+
+    HciCmd *cmd = NULL;
+    while ((cmd = HciCmdQueueRemoveFirst(&g_cmdCache)) != NULL) {
+        HciFreeCmd(cmd);
+    }
+
+    g_timeoutQueue.first = NULL;
+    g_timeoutQueue.last = NULL;
+    for (int i = 0; i < CMD_BUCKET_COUNT; i++) {
+        cmd = g_processingCmds[i];
+        while (cmd != NULL) {
+            HciCmd *next = cmd->bucketNext;
+            HciFreeCmd(cmd);
+            cmd = next;
+        }
+        g_processingCmds[i] = NULL;
+    }
+
     if (g_lockProcessingCmds != NULL) {
         MutexDelete(g_lockProcessingCmds);
         g_lockProcessingCmds = NULL;
@@ -78,16 +178,6 @@ void HciCloseCmd()
         MutexDelete(g_lockNumberOfHciCmd);
         g_lockNumberOfHciCmd = NULL;
     }
-
-    if (g_cmdCache != NULL) {
-        QueueDelete(g_cmdCache, HciFreeCmd);
-        g_cmdCache = NULL;
-    }
-
-    if (g_processingCmds != NULL) {
-        ListDelete(g_processingCmds);
-        g_processingCmds = NULL;
-    }
 }
 
 static int HciCmdPushToTxQueue(HciCmd *cmd)
@@ -105,22 +195,73 @@ static int HciCmdPushToTxQueue(HciCmd *cmd)
     return result;
 }
 
+// Must be called with g_lockProcessingCmds held.
+static void HciCmdStartTimer()
+{
+    HciCmd *first = g_timeoutQueue.first;
+    if (first == NULL) {
+        AlarmCancel(g_cmdTimeoutAlarm);
+        return;
+    }
+
+    uint64_t now = HciCmdGetTime();
+    uint64_t timeout = (first->deadline > now) ? (first->deadline - now) : 0;
+    AlarmSet(g_cmdTimeoutAlarm, timeout, HciCmdOnCmdTimeout, NULL);
+}
+
+// Must be called with g_lockProcessingCmds held.
+static void HciCmdAddProcessing(HciCmd *cmd)
+{
+    cmd->bucketNext = NULL;
+    HciCmd **link = &g_processingCmds[CMD_BUCKET(cmd->opCode)];
+    while (*link != NULL) {
+        link = &(*link)->bucketNext;
+    }
+    *link = cmd;
+
+    cmd->deadline = HciCmdGetTime() + CMD_TIMEOUT;
+    HciCmdQueueAddLast(&g_timeoutQueue, cmd);
+    if (g_timeoutQueue.first == cmd) {
+        HciCmdStartTimer();
+    }
+}
+
+// Find the earliest sent command of opCode and remove it from the processing table.
+// Must be called with g_lockProcessingCmds held.
+static HciCmd *HciCmdRemoveProcessing(uint16_t opCode)
+{
+    HciCmd **link = &g_processingCmds[CMD_BUCKET(opCode)];
+    while ((*link != NULL) && ((*link)->opCode != opCode)) {
+        link = &(*link)->bucketNext;
+    }
+
+    HciCmd *cmd = *link;
+    if (cmd == NULL) {
+        return NULL;
+    }
+    *link = cmd->bucketNext;
+    cmd->bucketNext = NULL;
+
+    bool isFirst = (g_timeoutQueue.first == cmd);
+    HciCmdQueueRemove(&g_timeoutQueue, cmd);
+    if (isFirst) {
+        HciCmdStartTimer();
+    }
+    return cmd;
+}
+
 static void HciCmdTimeoutTask(void *context)
 {
-    HciCmd *pCmd = NULL;
     uint16_t opCode = 0;
 
     MutexLock(g_lockProcessingCmds);
-    ListNode *node = ListGetFirstNode(g_processingCmds);
-    while (node != NULL) {
-        pCmd = ListGetNodeData(node);
-        if (pCmd == context) {
-            opCode = pCmd->opCode;
-            break;
+    HciCmd *first = g_timeoutQueue.first;
+    if (first != NULL) {
+        if (first->deadline <= HciCmdGetTime()) {
+            opCode = first->opCode;
         } else {
-            pCmd = NULL;
+            HciCmdStartTimer();
         }
-        node = ListGetNextNode(node);
     }
     MutexUnlock(g_lockProcessingCmds);
 
@@ -141,34 +282,38 @@ static void HciCmdOnCmdTimeout(void *parameter)
     }
 }
 
+// Push cmd to the controller and register it as processing. Registration happens under g_lockProcessingCmds so the
+// completion of cmd cannot be handled before it.
+// Must be called with g_lockProcessingCmds held.
+static int HciCmdSendToController(HciCmd *cmd)
+{
+    int result = HciCmdPushToTxQueue(cmd);
+    if (result == BT_NO_ERROR) {
+        HciCmdAddProcessing(cmd);
+    }
+    return result;
+}
+
 void HciSetNumberOfHciCmd(uint8_t numberOfHciCmd)
 {
+    // Cached commands are sent under g_lockNumberOfHciCmd, so a command submitted meanwhile cannot overtake them.
     MutexLock(g_lockNumberOfHciCmd);
-
     g_numberOfHciCmd = numberOfHciCmd;
-
-    HciCmd *cmd = NULL;
-
+    MutexLock(g_lockProcessingCmds);
     while (g_numberOfHciCmd > 0) {
-        cmd = QueueTryDequeue(g_cmdCache);
-        if (cmd != NULL) {
-            int result = HciCmdPushToTxQueue(cmd);
-            if (result == BT_NO_ERROR) {
-                g_numberOfHciCmd--;
-
-                MutexLock(g_lockProcessingCmds);
-                AlarmSet(cmd->alarm, CMD_TIMEOUT, HciCmdOnCmdTimeout, cmd);
-                ListAddLast(g_processingCmds, cmd);
-                MutexUnlock(g_lockProcessingCmds);
-            } else {
-                HciFreeCmd(cmd);
-            }
-        } else {
+        HciCmd *cmd = HciCmdQueueRemoveFirst(&g_cmdCache);
+        if (cmd == NULL) {
             // No more cmd
             break;
         }
+        // A command that could not be pushed leaves the credit to the next one.
+        if (HciCmdSendToController(cmd) == BT_NO_ERROR) {
+            g_numberOfHciCmd--;
+        } else {
+            HciFreeCmd(cmd);
+        }
     }
-
+    MutexUnlock(g_lockProcessingCmds);
     MutexUnlock(g_lockNumberOfHciCmd);
 }
 
@@ -198,63 +343,93 @@ static Packet *HciCreateCmdPacketWithParam(uint16_t opCode, const void *param, u
     return packet;
 }
 
+static HciCmd *HciCmdPoolAlloc()
+{
+    HciCmd *cmd = NULL;
+    if (g_lockCmdPool != NULL) {
+        MutexLock(g_lockCmdPool);
+        cmd = g_freeCmds;
+        if (cmd != NULL) {
+            g_freeCmds = cmd->next;
+        }
+        MutexUnlock(g_lockCmdPool);
+    }
+
+    if (cmd == NULL) {
+        cmd = MEM_MALLOC.alloc(sizeof(HciCmd));
+        if (cmd != NULL) {
+            cmd->pooled = false;
+        }
+    }
+    return cmd;
+}
+
 HciCmd *HciAllocCmd(uint16_t opCode, const void *param, size_t paramLength)
 {
-    HciCmd *cmd = MEM_MALLOC.alloc(sizeof(HciCmd));
+    HciCmd *cmd = HciCmdPoolAlloc();
     if (cmd != NULL) {
+        bool pooled = cmd->pooled;
+        (void)memset_s(cmd, offsetof(HciCmd, paramBuffer), 0, offsetof(HciCmd, paramBuffer));
+        cmd->pooled = pooled;
         cmd->opCode = opCode;
         if (param != NULL && paramLength > 0) {
-            cmd->param = MEM_MALLOC.alloc(paramLength);
+            if (paramLength <= sizeof(cmd->paramBuffer)) {
+                cmd->param = cmd->paramBuffer;
+            } else {
+                cmd->param = MEM_MALLOC.alloc(paramLength);
+            }
             if (cmd->param != NULL) {
                 (void)memcpy_s(cmd->param, paramLength, param, paramLength);
             }
             cmd->packet = HciCreateCmdPacketWithParam(opCode, param, paramLength);
         } else {
             cmd->packet = HciCreateCmdPacket(opCode);
-            cmd->param = NULL;
         }
-        cmd->alarm = AlarmCreate(NULL, false);
     }
     return cmd;
 }
 
-static void HciFreeCmd(void *cmd)
+static void HciFreeCmd(HciCmd *cmd)
 {
-    HciCmd *hciCmd = (HciCmd *)cmd;
-    if (hciCmd != NULL) {
-        if (hciCmd->alarm != NULL) {
-            AlarmCancel(hciCmd->alarm);
-            AlarmDelete(hciCmd->alarm);
-        }
-        if (hciCmd->param != NULL) {
-            MEM_MALLOC.free(hciCmd->param);
-            hciCmd->param = NULL;
-        }
-        if (hciCmd->packet != NULL) {
-            PacketFree(hciCmd->packet);
-        }
+    if (cmd == NULL) {
+        return;
+    }
+
+    if (cmd->param != NULL && cmd->param != cmd->paramBuffer) {
+        MEM_MALLOC.free(cmd->param);
+    }
+    cmd->param = NULL;
+    if (cmd->packet != NULL) {
+        PacketFree(cmd->packet);
+        cmd->packet = NULL;
+    }
+
+    if (cmd->pooled) {
+        MutexLock(g_lockCmdPool);
+        cmd->next = g_freeCmds;
+        g_freeCmds = cmd;
+        MutexUnlock(g_lockCmdPool);
+    } else {
+        MEM_MALLOC.free(cmd);
     }
-    MEM_MALLOC.free(cmd);
 }
 
-int HciSendCmd(HciCmd *cmd)
+static int HciSubmitCmd(HciCmd *cmd)
 {
     int result = BT_NO_ERROR;
 
     MutexLock(g_lockNumberOfHciCmd);
 
-    if (g_numberOfHciCmd > 0) {
-        result = HciCmdPushToTxQueue(cmd);
+    // Commands already waiting keep their order.
+    if (g_numberOfHciCmd > 0 && g_cmdCache.first == NULL) {
+        MutexLock(g_lockProcessingCmds);
+        result = HciCmdSendToController(cmd);
+        MutexUnlock(g_lockProcessingCmds);
         if (result == BT_NO_ERROR) {
             g_numberOfHciCmd--;
-
-            MutexLock(g_lockProcessingCmds);
-            AlarmSet(cmd->alarm, CMD_TIMEOUT, HciCmdOnCmdTimeout, cmd);
-            ListAddLast(g_processingCmds, cmd);
-            MutexUnlock(g_lockProcessingCmds);
         }
     } else {
-        QueueEnqueue(g_cmdCache, cmd);
+        HciCmdQueueAddLast(&g_cmdCache, cmd);
     }
 
     MutexUnlock(g_lockNumberOfHciCmd);
@@ -262,76 +437,48 @@ int HciSendCmd(HciCmd *cmd)
     return result;
 }
 
-void HciCmdOnCommandStatus(uint16_t opCode, uint8_t status)
+int HciSendCmd(HciCmd *cmd)
 {
-    HciCmd *cmd = NULL;
-
-    MutexLock(g_lockProcessingCmds);
-
-    ListNode *node = ListGetFirstNode(g_processingCmds);
-    while (node != NULL) {
-        cmd = ListGetNodeData(node);
-        if (cmd != NULL) {
-            if (opCode == cmd->opCode) {
-                break;
-            }
-            cmd = NULL;
-        }
-
-        node = ListGetNextNode(node);
+    if (cmd == NULL) {
+        return BT_NO_MEMORY;
     }
 
-    void *param = NULL;
-
-    if (cmd != NULL) {
-        AlarmCancel(cmd->alarm);
-
-        param = cmd->param;
-        cmd->param = NULL;
-
-        ListRemoveNode(g_processingCmds, cmd);
+    int result = HciSubmitCmd(cmd);
+    if (result != BT_NO_ERROR) {
+        HciFreeCmd(cmd);
     }
+    return result;
+}
 
+void HciCmdOnCommandStatus(uint16_t opCode, uint8_t status)
+{
+    MutexLock(g_lockProcessingCmds);
+    HciCmd *cmd = HciCmdRemoveProcessing(opCode);
     MutexUnlock(g_lockProcessingCmds);
 
-    if (cmd != NULL && opCode == HCI_DISCONNECT && status == HCI_SUCCESS) {
-        HciDisconnectParam *discParam = (HciDisconnectParam *)param;
-        HciAclOnDisconnectStatus(discParam->connectionHandle);
+    if (cmd == NULL) {
+        return;
     }
 
-    if (cmd != NULL && status != HCI_SUCCESS) {
-        HciOnCmdFailed(opCode, status, param);
+    if (opCode == HCI_DISCONNECT && status == HCI_SUCCESS && cmd->param != NULL) {
+        HciDisconnectParam *discParam = (HciDisconnectParam *)cmd->param;
+        HciAclOnDisconnectStatus(discParam->connectionHandle);
     }
 
-    if (param != NULL) {
-        MEM_MALLOC.free(param);
-        param = NULL;
+    if (status != HCI_SUCCESS) {
+        HciOnCmdFailed(opCode, status, cmd->param);
     }
+
+    HciFreeCmd(cmd);
 }
 
 void HciCmdOnCommandComplete(uint16_t opCode)
 {
-    HciCmd *cmd = NULL;
-
     MutexLock(g_lockProcessingCmds);
-
-    ListNode *node = ListGetFirstNode(g_processingCmds);
-    while (node != NULL) {
-        cmd = ListGetNodeData(node);
-        if (cmd != NULL) {
-            if (opCode == cmd->opCode) {
-                break;
-            }
-            cmd = NULL;
-        }
-
-        node = ListGetNextNode(node);
-    }
+    HciCmd *cmd = HciCmdRemoveProcessing(opCode);
+    MutexUnlock(g_lockProcessingCmds);
 
     if (cmd != NULL) {
-        AlarmCancel(cmd->alarm);
-        ListRemoveNode(g_processingCmds, cmd);
+        HciFreeCmd(cmd);
     }
-
-    MutexUnlock(g_lockProcessingCmds);
 }
@@ -16,20 +16,31 @@
 #ifndef HCI_CMD_H
 #define HCI_CMD_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "packet.h"
-#include "platform/include/alarm.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-typedef struct {
+// Parameter Total Length is one octet, so the parameters of any command fit in the inline buffer.
+#define HCI_CMD_INLINE_PARAM_SIZE 255
+
+typedef struct HciCmd {
     uint16_t opCode;
     void *param;
     Packet *packet;
-    Alarm *alarm;
+    // Send time + command timeout, in milliseconds of the monotonic clock.
+    uint64_t deadline;
+    // Link of the free list, the pending queue or the timeout queue.
+    struct HciCmd *prev;
+    struct HciCmd *next;
+    // Link of the in-flight opcode bucket.
+    struct HciCmd *bucketNext;
+    bool pooled;
+    uint8_t paramBuffer[HCI_CMD_INLINE_PARAM_SIZE];
 } HciCmd;
 
 void HciInitCmd();
@@ -19,6 +19,7 @@
 #include "btstack.h"
 #include "log.h"
 #include "packet.h"
+#include "perf_counter.h"
 #include "platform/include/allocator.h"
 #include "platform/include/event.h"
 #include "platform/include/module.h"
@@ -301,6 +302,8 @@ static void HciOnReceivedHciPacket(BtPacketType type, const BtPacket *btPacket)
         uint8_t transType = (type == PACKET_TYPE_EVENT) ? TRANSMISSON_TYPE_C2H_EVENT : TRANSMISSON_TYPE_C2H_DATA;
         g_transmissionCallback(transType, btPacket->data, btPacket->size);
     }
+    PerfCounterAdd(PERF_COUNTER_HCI_RX_PACKETS, 1);
+    PerfCounterAdd(PERF_COUNTER_HCI_RX_BYTES, btPacket->size);
 
     HciPacket *hciPacket = MEM_MALLOC.alloc(sizeof(HciPacket));
     if (hciPacket != NULL) {
@@ -356,6 +359,8 @@ static void HciSendPacketCallback(void *param)
         if (result != SUCCESS) {
             LOG_ERROR("Send packet to HAL failed: %{public}d", result);
         } else {
+            PerfCounterAdd(PERF_COUNTER_HCI_TX_PACKETS, 1);
+            PerfCounterAdd(PERF_COUNTER_HCI_TX_BYTES, btPacket.size);
             if (g_transmissionCapture && g_transmissionCallback != NULL) {
                 uint8_t type = (packet->type == H2C_CMD) ? TRANSMISSON_TYPE_H2C_CMD : TRANSMISSON_TYPE_H2C_DATA;
                 g_transmissionCallback(type, btPacket.data, btPacket.size);
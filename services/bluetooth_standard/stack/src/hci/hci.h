@@ -1467,6 +1467,18 @@ int HCI_DeregisterFailureCallback(const HciFailureCallbacks *callbacks);
 #define NON_FLUSHABLE_PACKET 0
 #define FLUSHABLE_PACKET 1
 int HCI_SendAclData(uint16_t handle, uint8_t flushable, Packet *packet);
+// Get the number of ACL data packets of a connection that are waiting for or held by the controller buffers.
+int HCI_GetAclTxQueueLength(uint16_t handle, uint16_t *queueLength);
+
+typedef struct {
+    uint64_t txPackets;       // Packets handed to HCI_SendAclData(), before fragmentation.
+    uint64_t txBytes;
+    uint64_t rxPackets;       // L2CAP PDUs received from the controller, counted on their start fragment.
+    uint64_t rxBytes;
+    uint64_t lastActivityUs;  // PerfClockUs() of the last packet sent or received, or of the connection.
+} HciAclTrafficStats;
+// Get the ACL data sent and received on a connection since it was established.
+int HCI_GetAclTrafficStats(uint16_t handle, HciAclTrafficStats *stats);
 
 #define TRANSMISSON_TYPE_H2C_CMD 1
 #define TRANSMISSON_TYPE_C2H_EVENT 2
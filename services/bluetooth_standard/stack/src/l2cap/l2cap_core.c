@@ -21,6 +21,7 @@
 
 #include "btm.h"
 #include "log.h"
+#include "perf_counter.h"
 
 #include "l2cap_cmn.h"
 #include "l2cap_crc.h"
@@ -614,6 +615,7 @@ static void L2capErfcTxOneFrame(L2capConnection *conn, L2capChannel *chan, uint8
             }
 
             L2capSendPacketNoFree(conn->aclHandle, chan->lcfg.flushTimeout, tx->pkt);
+            PerfCounterAdd(PERF_COUNTER_L2CAP_RETRANSMITS, 1);
             break;
         }
 
@@ -779,6 +781,9 @@ static void L2capErfcDoTx(L2capConnection *conn, L2capChannel *chan, uint16_t tx
             L2capAddCrc(tx->pkt);
         }
 
+        if (tx->retryCount > 0) {
+            PerfCounterAdd(PERF_COUNTER_L2CAP_RETRANSMITS, 1);
+        }
         tx->retryCount += 1;
         L2capSendPacketNoFree(conn->aclHandle, chan->lcfg.flushTimeout, tx->pkt);
 
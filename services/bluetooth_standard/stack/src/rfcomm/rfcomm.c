@@ -30,6 +30,8 @@ void RfcommInitialize()
         g_serverNum[cnt] = false;
     }
 
+    RfcommInitFcsTable();
+
     // Create list.
     RfcommCreateSessionList();
     RfcommCreateChannelList();
@@ -408,6 +410,24 @@ int RfcommGetPortState(uint16_t handle, RfcommPortState *state)
     return RFCOMM_SUCCESS;
 }
 
+/**
+ * @brief Return the credits freed by the upper layer reading data.
+ *
+ * @param context The pointer of the channel in the channel list.
+ */
+static void RfcommCreditReturnTsk(void *context)
+{
+    LOG_INFO("%{public}s", __func__);
+
+    RfcommChannelInfo *channel = context;
+    if (!RfcommIsChannelValid(channel)) {
+        LOG_ERROR("%{public}s:Channel is closed.", __func__);
+        return;
+    }
+
+    RfcommReturnCredits(channel, false);
+}
+
 /**
  * @brief This function is used to get the payload packet sent by the peer from RFCOMM.
  *        After the caller finishes using this interface, it creates a packet reference or
@@ -440,7 +460,12 @@ int RfcommRead(uint16_t handle, Packet **pkt)
     ListRemoveFirst(channel->recvQueue);
 
     // Local can receive more data, send flow control to peer.
-    RfcommSetFlcToPeer(channel, true);
+    if (channel->session->fcType == FC_TYPE_CREDIT) {
+        // Credits are returned in batches from the RFCOMM thread.
+        BTM_RunTaskInProcessingQueue(PROCESSING_QUEUE_ID_RFCOMM, RfcommCreditReturnTsk, channel);
+    } else {
+        RfcommSetFlcToPeer(channel, true);
+    }
 
     return RFCOMM_SUCCESS;
 }
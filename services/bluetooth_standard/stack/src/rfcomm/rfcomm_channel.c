@@ -151,6 +151,7 @@ static void RfcommInitChannelInfo(RfcommChannelInfo *channel)
     channel->sendQueue = ListCreate(NULL);
     channel->recvQueue = ListCreate(NULL);
     channel->timer = AlarmCreate(NULL, false);
+    channel->creditTimer = AlarmCreate(NULL, false);
     channel->localCreditMax = MAX_CREDIT_COUNT;
     channel->peerChannelFc = false;
     // Set remote port default value.
@@ -342,6 +343,10 @@ void RfcommRemoveChannel(RfcommChannelInfo *channel)
         AlarmDelete(channel->timer);
         channel->timer = NULL;
     }
+    if (channel->creditTimer != NULL) {
+        AlarmDelete(channel->creditTimer);
+        channel->creditTimer = NULL;
+    }
 
     // Free handle.
     RfcommFreeHandle(channel->handle);
@@ -411,6 +416,10 @@ void RfcommResetChannelInfo(RfcommChannelInfo *channel)
     RfcommReadLock();
 
     RfcommStopChannelTimer(channel);
+    if (channel->creditTimer != NULL) {
+        AlarmCancel(channel->creditTimer);
+    }
+    channel->creditTimerStarted = false;
     RfcommReleaseCachePkt(channel);
     channel->sendQueue = ListCreate(NULL);
     channel->recvQueue = ListCreate(NULL);
@@ -810,6 +819,49 @@ void RfcommRemoveChannelCallback(uint8_t scn)
     }
 }
 
+/**
+ * @brief Send further credits to peer.
+ *
+ * @param channel The pointer of the channel in the channel list.
+ * @param credits The number of credits that can be received locally.
+ */
+static void RfcommSendCredits(const RfcommChannelInfo *channel, uint8_t credits)
+{
+    LOG_INFO("%{public}s", __func__);
+
+    RfcommSendUihData(channel->session, channel->dlci, credits, NULL);
+}
+
+/**
+ * @brief Take queued packets from the head of the buffer queue, joined into one frame up to the peer's MTU.
+ *        RFCOMM carries a byte stream, so consecutive writes can share a UIH frame.
+ *
+ * @param channel The pointer of the channel in the channel list.
+ * @return The frame to send, the caller frees it.
+ */
+static Packet *RfcommCoalesceCachePkt(RfcommChannelInfo *channel)
+{
+    Packet *frame = ListGetNodeData(ListGetFirstNode(channel->sendQueue));
+    ListRemoveFirst(channel->sendQueue);
+    uint32_t size = PacketPayloadSize(frame);
+
+    ListNode *node = ListGetFirstNode(channel->sendQueue);
+    while (node != NULL) {
+        Packet *pkt = ListGetNodeData(node);
+        uint32_t pktSize = PacketPayloadSize(pkt);
+        if (size + pktSize > channel->peerMtu) {
+            break;
+        }
+        PacketAssemble(frame, pkt);
+        size += pktSize;
+        ListRemoveFirst(channel->sendQueue);
+        PacketFree(pkt);
+        node = ListGetFirstNode(channel->sendQueue);
+    }
+
+    return frame;
+}
+
 /**
  * @brief Send data in the buffer queue.
  *
@@ -835,61 +887,145 @@ void RfcommSendCachePkt(RfcommChannelInfo *channel)
     }
 
     if (session->fcType == FC_TYPE_CREDIT) {
-        while ((channel->peerCredit) && (node)) {
-            pkt = ListGetNodeData(node);
-            node = ListGetNextNode(node);
-            uint8_t newCredit = channel->localCreditMax - channel->localCredit;
-            newCredit = (newCredit < MAX_ONCE_NEWCREDIT) ? newCredit : MAX_ONCE_NEWCREDIT;
-            channel->localCredit += newCredit;
+        while ((channel->peerCredit) && (ListGetFirstNode(channel->sendQueue) != NULL)) {
+            pkt = RfcommCoalesceCachePkt(channel);
+            // Pending credits ride along with the data.
+            uint8_t newCredit = RfcommTakeGrantableCredits(channel);
             // Add transmite data bytes value.
             channel->transmittedBytes += PacketPayloadSize(pkt);
             // Send data to peer.
             RfcommSendUihData(session, channel->dlci, newCredit, pkt);
-            ListRemoveNode(channel->sendQueue, pkt);
             PacketFree(pkt);
             // Decrease credits.
             channel->peerCredit--;
         }
     } else if ((!channel->peerChannelFc) && (!session->peerSessionFc)) {
-        while (node != NULL) {
-            pkt = ListGetNodeData(node);
-            node = ListGetNextNode(node);
+        while (ListGetFirstNode(channel->sendQueue) != NULL) {
+            pkt = RfcommCoalesceCachePkt(channel);
             // Add transmite data bytes value.
             channel->transmittedBytes += PacketPayloadSize(pkt);
             // Send data to peer.
             RfcommSendUihData(session, channel->dlci, 0, pkt);
-            ListRemoveNode(channel->sendQueue, pkt);
             PacketFree(pkt);
         }
     }
 }
 
 /**
- * @brief Notify the upper layer whether RFCOMM can receive data.
+ * @brief Take the credits that can be granted to the peer now.
+ *        The credits the peer holds plus the frames not yet read by the upper layer never exceed the local buffer.
  *
  * @param channel The pointer of the channel in the channel list.
+ * @return The number of credits to send to the peer.
  */
-void RfcommSetFlcToUpper(RfcommChannelInfo *channel)
+uint8_t RfcommTakeGrantableCredits(RfcommChannelInfo *channel)
 {
     LOG_INFO("%{public}s", __func__);
 
-    if (channel->localFcToUpper) {
-        RfcommNotifyEvtToUpper(channel, RFCOMM_CHANNEL_EV_FC_ON, NULL);
-        channel->localFcToUpper = false;
+    if (channel->session->fcType != FC_TYPE_CREDIT) {
+        return 0;
+    }
+
+    RfcommReadLock();
+    uint32_t used = channel->localCredit + ListGetSize(channel->recvQueue);
+    RfcommReadUnlock();
+    if (used >= channel->localCreditMax) {
+        return 0;
+    }
+
+    uint8_t newCredits = channel->localCreditMax - used;
+    newCredits = (newCredits < MAX_ONCE_NEWCREDIT) ? newCredits : MAX_ONCE_NEWCREDIT;
+    channel->localCredit += newCredits;
+    if (channel->creditTimerStarted) {
+        AlarmCancel(channel->creditTimer);
+        channel->creditTimerStarted = false;
     }
+
+    return newCredits;
 }
 
 /**
- * @brief Send further credits to peer.
+ * @brief The credit timer's processing.
+ *
+ * @param parameter The pointer of the channel in the channel list.
+ */
+static void RfcommCreditTimeout(void *parameter)
+{
+    LOG_INFO("%{public}s", __func__);
+
+    RfcommChannelInfo *channel = parameter;
+    if (!RfcommIsChannelValid(channel)) {
+        LOG_ERROR("%{public}s:Channel is closed.", __func__);
+        return;
+    }
+
+    channel->creditTimerStarted = false;
+    RfcommReturnCredits(channel, true);
+}
+
+/**
+ * @brief The credit timer callback function registered to alarm.
+ *
+ * @param context The pointer of the channel in the channel list.
+ */
+static void RfcommCreditTimeoutCallback(void *context)
+{
+    LOG_INFO("%{public}s", __func__);
+
+    BTM_RunTaskInProcessingQueue(PROCESSING_QUEUE_ID_RFCOMM, RfcommCreditTimeout, context);
+}
+
+/**
+ * @brief Return freed credits to the peer in one frame.
+ *        Credits are sent once the batch threshold is reached, or when forced by the credit timer,
+ *        a few freed credits wait for the timer or for outgoing data to carry them.
  *
  * @param channel The pointer of the channel in the channel list.
- * @param credits The number of credits that can be received locally.
+ * @param force   Whether to send any freed credits now.
  */
-static void RfcommSendCredits(const RfcommChannelInfo *channel, uint8_t credits)
+void RfcommReturnCredits(RfcommChannelInfo *channel, bool force)
 {
     LOG_INFO("%{public}s", __func__);
 
-    RfcommSendUihData(channel->session, channel->dlci, credits, NULL);
+    if ((channel->channelState != ST_CHANNEL_CONNECTED) || (channel->session->fcType != FC_TYPE_CREDIT)) {
+        return;
+    }
+
+    RfcommReadLock();
+    uint32_t used = channel->localCredit + ListGetSize(channel->recvQueue);
+    RfcommReadUnlock();
+    if (used >= channel->localCreditMax) {
+        return;
+    }
+
+    // The peer may be out of credits, never hold all of them back.
+    if ((!force) && (channel->localCredit > 0) && (channel->localCreditMax - used < RFCOMM_CREDIT_RETURN_THRESHOLD)) {
+        if ((!channel->creditTimerStarted) && (channel->creditTimer != NULL)) {
+            AlarmSet(channel->creditTimer, RFCOMM_CREDIT_RETURN_DELAY_MS, RfcommCreditTimeoutCallback, channel);
+            channel->creditTimerStarted = true;
+        }
+        return;
+    }
+
+    uint8_t newCredits = RfcommTakeGrantableCredits(channel);
+    if (newCredits > 0) {
+        RfcommSendCredits(channel, newCredits);
+    }
+}
+
+/**
+ * @brief Notify the upper layer whether RFCOMM can receive data.
+ *
+ * @param channel The pointer of the channel in the channel list.
+ */
+void RfcommSetFlcToUpper(RfcommChannelInfo *channel)
+{
+    LOG_INFO("%{public}s", __func__);
+
+    if (channel->localFcToUpper) {
+        RfcommNotifyEvtToUpper(channel, RFCOMM_CHANNEL_EV_FC_ON, NULL);
+        channel->localFcToUpper = false;
+    }
 }
 
 /**
@@ -911,10 +1047,7 @@ void RfcommSetFlcToPeer(RfcommChannelInfo *channel, bool enable)
             return;
         }
         // Send new credit.
-        uint8_t newCredits = channel->localCreditMax - channel->localCredit;
-        newCredits = (newCredits >= MAX_ONCE_NEWCREDIT) ? (MAX_ONCE_NEWCREDIT - 1) : newCredits;
-        channel->localCredit += newCredits;
-        RfcommSendCredits(channel, newCredits + 1);
+        RfcommReturnCredits(channel, false);
     } else {
         RfcommReadLock();
         uint8_t count = ListGetSize(channel->recvQueue);
@@ -937,6 +937,10 @@ int RfcommRecvRevData(RfcommChannelInfo *channel, const void *data)
     }
 
     if (info.data.size > 0) {
+        // Each data frame uses one of the credits granted to the peer.
+        if ((channel->session->fcType == FC_TYPE_CREDIT) && (channel->localCredit > 0)) {
+            channel->localCredit--;
+        }
         RfcommReadLock();
         uint8_t count = (uint8_t)ListGetSize(channel->recvQueue);
         if (count < MAX_QUEUE_COUNT) {
@@ -980,14 +984,16 @@ int RfcommWriteData(RfcommChannelInfo *channel, const void *data)
         return RFCOMM_ERR_NOT_CONNECTED;
     }
     // Determine whether the peer can receive the data. If the peer cannot receive the data,
-    // save the data in the queue to be sent.
+    // save the data in the queue to be sent. Data already queued goes first, the new data may share its frames.
     if (((session->fcType == FC_TYPE_CREDIT) && (channel->peerCredit == 0)) ||
-        (channel->transferReady != TRANSFER_READY) || channel->peerChannelFc || (session->peerSessionFc)) {
+        (channel->transferReady != TRANSFER_READY) || channel->peerChannelFc || (session->peerSessionFc) ||
+        (ListGetFirstNode(channel->sendQueue) != NULL)) {
         // Get send list's count
         uint8_t count = (uint8_t)ListGetSize(channel->sendQueue);
         if (count < MAX_QUEUE_COUNT) {
             refpkt = PacketRefMalloc((Packet *)data);
             ListAddLast(channel->sendQueue, (void *)refpkt);
+            RfcommSendCachePkt(channel);
             return RFCOMM_SUCCESS;
         }
         channel->localFcToUpper = true;
@@ -996,8 +1002,7 @@ int RfcommWriteData(RfcommChannelInfo *channel, const void *data)
     if (session->fcType == FC_TYPE_CREDIT) {
         // The value of the credit octet (0 - 255) signifies a number of frames,
         // for which the sender now has buffer space available to receive on the DLC.
-        newCredits = channel->localCreditMax - channel->localCredit;
-        channel->localCredit += newCredits;
+        newCredits = RfcommTakeGrantableCredits(channel);
     }
 
     // Add transmite data bytes value.
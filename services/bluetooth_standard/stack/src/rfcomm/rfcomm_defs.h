@@ -48,6 +48,9 @@
 #define MAX_CREDIT_COUNT 10
 #define MAX_QUEUE_COUNT MAX_CREDIT_COUNT
 #define MAX_ONCE_NEWCREDIT 255
+// Credits freed by the upper layer reading are returned once this many are available, or after the delay.
+#define RFCOMM_CREDIT_RETURN_THRESHOLD (MAX_CREDIT_COUNT / 2)
+#define RFCOMM_CREDIT_RETURN_DELAY_MS 10
 
 #define FRAME_TYPE_SABM 0b00101111
 #define FRAME_TYPE_UA 0b01100011
@@ -391,6 +394,8 @@ typedef struct {
     uint32_t receivedBytes;
     uint32_t transmittedBytes;
     Alarm *timer;
+    Alarm *creditTimer;
+    bool creditTimerStarted;
     RFCOMM_EventCallback callBack;
     void *context;
 } RfcommChannelInfo;
@@ -579,6 +584,8 @@ void RfcommRemoveAllChannelOnSession(const RfcommSessionInfo *session);
 void RfcommRemoveInvalidChannelOnSession(const RfcommSessionInfo *session);
 void RfcommRemoveChannelCallback(uint8_t scn);
 void RfcommSendCachePkt(RfcommChannelInfo *channel);
+uint8_t RfcommTakeGrantableCredits(RfcommChannelInfo *channel);
+void RfcommReturnCredits(RfcommChannelInfo *channel, bool force);
 void RfcommSendAllCachePktOnSession(const RfcommSessionInfo *session);
 bool RfcommCheckSessionValid(const RfcommSessionInfo *session);
 void RfcommCloseInvalidSession(RfcommSessionInfo *session);
@@ -607,6 +614,7 @@ RfcommServerInfo *RfcommCreateServer(
 void RfcommRemoveServer(RfcommServerInfo *server);
 
 // Compose or parse Frame.
+void RfcommInitFcsTable();
 int RfcommSendSabm(const RfcommSessionInfo *session, uint8_t dlci);
 int RfcommSendDisc(const RfcommSessionInfo *session, uint8_t dlci);
 int RfcommSendUa(const RfcommSessionInfo *session, uint8_t dlci);
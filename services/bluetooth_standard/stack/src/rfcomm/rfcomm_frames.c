@@ -34,12 +34,18 @@ static const unsigned char G_CRCTABLE[256] = {  // Refer to B.3.5 Reversed CRC t
     0xB4, 0x25, 0x57, 0xC6, 0xB3, 0x22, 0x50, 0xC1, 0xBA, 0x2B, 0x59, 0xC8, 0xBD, 0x2C, 0x5E, 0xCF
 };
 
+// UIH frames only cover the address and control fields with the FCS, so it is fixed per DLCI, C/R bit and P/F bit.
+// Indexed by the address field without the EA bit, then by the P/F bit.
+#define RFCOMM_UIH_FCS_ADDRESS_COUNT 128
+static uint8_t g_uihFcsTable[RFCOMM_UIH_FCS_ADDRESS_COUNT][2];
+
 static bool RfcommIsSabmDiscValid(RfcommCheckFrameValidInfo info);
 static bool RfcommIsUaValid(RfcommCheckFrameValidInfo info);
 static bool RfcommIsDmValid(RfcommCheckFrameValidInfo info);
 static bool RfcommIsUihValid(RfcommCheckFrameValidInfo info);
 static bool RfcommCheckFcs(uint8_t len, uint8_t recvfcs, const uint8_t *p);
 static uint8_t RfcommCalculateFcs(uint8_t len, const uint8_t *p);
+static uint8_t RfcommCalculateUihFcs(const uint8_t *header);
 static void RfcommParseHeaderTail(Packet *pkt, RfcommFrameHeaderTailInfo *headTailInfo);
 static RfcommEventType RfcommParseSabm(
     RfcommCheckFrameValidInfo checkInfo, uint8_t addrDlci, RfcommParseFrameResult output);
@@ -84,6 +90,42 @@ uint8_t RfcommCalculateFcs(uint8_t len, const uint8_t *p)
     return fcs;
 }
 
+/**
+ * @brief The function is used to build the FCS table of UIH frames when RFCOMM initializes.
+ */
+void RfcommInitFcsTable()
+{
+    LOG_INFO("%{public}s", __func__);
+
+    uint8_t header[RFCOMM_IS_UIH_FSC_LEN] = {0};
+
+    for (uint8_t index = 0; index < RFCOMM_UIH_FCS_ADDRESS_COUNT; index++) {
+        header[RFCOMM_ADDRESS] = EA | (index << RFCOMM_SHIFT_CR);
+        header[RFCOMM_CONTROL] = FRAME_TYPE_UIH;
+        g_uihFcsTable[index][0] = RfcommCalculateFcs(RFCOMM_IS_UIH_FSC_LEN, header);
+        header[RFCOMM_CONTROL] = FRAME_TYPE_UIH | PF;
+        g_uihFcsTable[index][1] = RfcommCalculateFcs(RFCOMM_IS_UIH_FSC_LEN, header);
+    }
+}
+
+/**
+ * @brief The function is used to get the FCS of a UIH frame from the table.
+ *
+ * @param header The address and control fields of the frame.
+ * @return The FCS value.
+ */
+uint8_t RfcommCalculateUihFcs(const uint8_t *header)
+{
+    uint8_t address = header[RFCOMM_ADDRESS];
+    uint8_t control = header[RFCOMM_CONTROL];
+
+    if (((address & EA) == 0) || ((control & ~PF) != FRAME_TYPE_UIH)) {
+        return RfcommCalculateFcs(RFCOMM_IS_UIH_FSC_LEN, header);
+    }
+
+    return g_uihFcsTable[address >> RFCOMM_SHIFT_CR][(control & PF) ? 1 : 0];
+}
+
 /**
  * @brief The function is used to check FCS.
  *        The function is referred to B.3.4 The receiver code of GSM 07.10,v6.3.0.
@@ -264,7 +306,7 @@ int RfcommSendUihPn(const RfcommSessionInfo *session, uint8_t dlci, bool isCmd,
     // Information(K1~K3)
     header[RFCOMM_PN_CREDIT] = pnInfo->credits;
     // FCS(For UIH frames: on Address and Control field.)
-    uint8_t tail = RfcommCalculateFcs(RFCOMM_IS_UIH_FSC_LEN, header);
+    uint8_t tail = RfcommCalculateUihFcs(header);
 
     return RfcommSendData(session->l2capId, header, RFCOMM_PN_HEADER_LEN, tail, NULL);
 }
@@ -308,7 +350,7 @@ int RfcommSendUihMsc(const RfcommSessionInfo *session, uint8_t dlci, bool isCmd,
         header[RFCOMM_MSC_BREAK] = EA | (modemSts->breakSignal << 1);
     }
     // FCS(For UIH frames: on Address and Control field.)
-    uint8_t tail = RfcommCalculateFcs(RFCOMM_IS_UIH_FSC_LEN, header);
+    uint8_t tail = RfcommCalculateUihFcs(header);
 
     return RfcommSendData(session->l2capId, header, headerLength, tail, NULL);
 }
@@ -345,7 +387,7 @@ int RfcommSendUihRls(const RfcommSessionInfo *session, uint8_t dlci, bool isCmd,
     // Information(rls)
     header[RFCOMM_RLS_STATUS] = lineStatus;
     // FCS(For UIH frames: on Address and Control field.)
-    uint8_t tail = RfcommCalculateFcs(RFCOMM_IS_UIH_FSC_LEN, header);
+    uint8_t tail = RfcommCalculateUihFcs(header);
 
     return RfcommSendData(session->l2capId, header, RFCOMM_RLS_HEADER_LEN, tail, NULL);
 }
@@ -397,7 +439,7 @@ int RfcommSendUihRpn(const RfcommSessionInfo *session, uint8_t dlci, bool isCmd,
         header[RFCOMM_RPN_MASK2] = portConfig->parameter_mask2;
     }
     // FCS(For UIH frames: on Address and Control field.)
-    uint8_t tail = RfcommCalculateFcs(RFCOMM_IS_UIH_FSC_LEN, header);
+    uint8_t tail = RfcommCalculateUihFcs(header);
 
     return RfcommSendData(session->l2capId, header, headerLength, tail, NULL);
 }
@@ -428,7 +470,7 @@ int RfcommSendUihFcon(const RfcommSessionInfo *session, bool isCmd)
     // Information(Length)
     header[RFCOMM_INFO_LEN] = EA | (0 << 1);
     // FCS(For UIH frames: on Address and Control field.)
-    uint8_t tail = RfcommCalculateFcs(RFCOMM_IS_UIH_FSC_LEN, header);
+    uint8_t tail = RfcommCalculateUihFcs(header);
 
     return RfcommSendData(session->l2capId, header, RFCOMM_FCON_HEADER_LEN, tail, NULL);
 }
@@ -459,7 +501,7 @@ int RfcommSendUihFcoff(const RfcommSessionInfo *session, bool isCmd)
     // Information(Length)
     header[RFCOMM_INFO_LEN] = EA | (0 << 1);
     // FCS(For UIH frames: on Address and Control field.)
-    uint8_t tail = RfcommCalculateFcs(RFCOMM_IS_UIH_FSC_LEN, header);
+    uint8_t tail = RfcommCalculateUihFcs(header);
 
     return RfcommSendData(session->l2capId, header, RFCOMM_FCOFF_HEADER_LEN, tail, NULL);
 }
@@ -514,7 +556,7 @@ int RfcommSendUihTest(const RfcommSessionInfo *session, bool isCmd, Packet *pkt)
         len++;
     }
     // FCS(For UIH frames: on Address and Control field.)
-    uint8_t tail = RfcommCalculateFcs(RFCOMM_IS_UIH_FSC_LEN, header);
+    uint8_t tail = RfcommCalculateUihFcs(header);
 
     return RfcommSendData(session->l2capId, header, len, tail, pkt);
 }
@@ -550,7 +592,7 @@ int RfcommSendUihNsc(const RfcommSessionInfo *session, uint8_t ea, uint8_t cr, u
     // Information(Non supported command type)
     header[RFCOMM_NSC_TYPE] = ea | (cr << RFCOMM_SHIFT_CR) | (type << RFCOMM_SHIFT_TYPE);
     // FCS(For UIH frames: on Address and Control field.)
-    uint8_t tail = RfcommCalculateFcs(RFCOMM_IS_UIH_FSC_LEN, header);
+    uint8_t tail = RfcommCalculateUihFcs(header);
 
     return RfcommSendData(session->l2capId, header, RFCOMM_NSC_HEADER_LEN, tail, NULL);
 }
@@ -600,7 +642,7 @@ int RfcommSendUihData(const RfcommSessionInfo *session, uint8_t dlci, uint8_t ne
         len++;
     }
     // FCS(For UIH frames: on Address and Control field.)
-    uint8_t tail = RfcommCalculateFcs(RFCOMM_IS_UIH_FSC_LEN, header);
+    uint8_t tail = RfcommCalculateUihFcs(header);
 
     return RfcommSendData(session->l2capId, header, len, tail, pkt);
 }
@@ -686,7 +728,8 @@ bool RfcommIsUihValid(RfcommCheckFrameValidInfo info)
         return false;
     }
 
-    if (!IS_CMD(info.isInitiator, info.cr) || !RfcommCheckFcs(RFCOMM_IS_UIH_FSC_LEN, info.fcs, info.calcInfo)) {
+    // The FCS of a UIH frame only depends on the header, so compare it with the precomputed value.
+    if (!IS_CMD(info.isInitiator, info.cr) || (RfcommCalculateUihFcs(info.calcInfo) != info.fcs)) {
         LOG_ERROR("%{public}s Uih is invalid, isInitiator:%{public}d, cr:%hhu.", __func__, info.isInitiator, info.cr);
         return false;
     }
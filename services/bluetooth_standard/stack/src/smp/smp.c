@@ -49,10 +49,6 @@
 #include "smp_send.h"
 #include "smp_tool.h"
 
-static const uint8_t SALT[SMP_ENCRYPT_KEY_LEN] = {
-    0x6C, 0x88, 0x83, 0x91, 0xAA, 0xF5, 0xA5, 0x38, 0x60, 0x37, 0x0B, 0xDB, 0x5A, 0x60, 0x83, 0xBE
-};  // The key of an encryption algorithm.
-
 static SMP_PairMng g_smpPairMng = {0x00};
 static SMP_Callback_t g_smpCallBack = {0x00};
 static bool g_smpSecureConnOnlyMode = false;
@@ -121,11 +117,13 @@ static HciEventCallbacks g_smpHciEventCallbacks = {
 static void SMP_Initialize(int traceLevel)
 {
     LOG_INFO("%{public}s", __FUNCTION__);
+    SMP_AesInitialize();
 }
 
 static void SMP_Finalize(void)
 {
     LOG_INFO("%{public}s", __FUNCTION__);
+    SMP_AesFinalize();
 }
 
 static void SMP_Startup()
@@ -1089,8 +1087,6 @@ static int SMP_AuthReqReplyJudgeExceptionMaster(bool accept, uint8_t rejectReaso
 static int SMP_AuthReqReplyStepTransMaster(uint8_t pairMethod)
 {
     int ret = SMP_SUCCESS;
-    uint8_t cryptAesCmacZ[CRYPT_AESCMAC_Z_LEN] = {0x00};
-    HciLeEncryptParam encryptParam;
     if (g_smpPairMng.pairType == SMP_PAIR_TYPE_LEGACY) {
         ret = SMP_SendHciLeRandCmd(0x00);
     } else {
@@ -1098,11 +1094,7 @@ static int SMP_AuthReqReplyStepTransMaster(uint8_t pairMethod)
             LOG_DEBUG("SMP_SC_PAIR_PASSKEYENTRY_MASTER_STEP_6 started.");
             ret = SMP_SendHciLeRandCmd(SMP_SC_PAIR_PASSKEYENTRY_MASTER_STEP_6);
         } else if (pairMethod == SMP_PAIR_METHOD_NUMERIC_COMPARISON) {
-            SMP_MemoryReverseCopy(encryptParam.key, SALT, sizeof(encryptParam.key));
-            (void)memcpy_s(
-                encryptParam.plaintextData, sizeof(encryptParam.plaintextData), cryptAesCmacZ, CRYPT_AESCMAC_Z_LEN);
-            LOG_DEBUG("SMP_SC_PAIR_COMMON_MASTER_STEP_1 started.");
-            ret = SMP_SendLeEncryptCmd(&encryptParam, SMP_SC_PAIR_COMMON_MASTER_STEP_1, NULL, SMP_USING_HW_AES128_PAIR);
+            ret = SMP_ScPairCommonMasterStart();
         } else if (SMP_IsScOobPair(pairMethod)) {
             LOG_DEBUG("SMP_SC_PAIR_OOB_MASTER_STEP_8 started.");
             g_smpPairMng.step = SMP_SC_PAIR_OOB_MASTER_STEP_8;
@@ -1118,7 +1110,6 @@ static int SMP_AuthReqReplyStepTransMaster(uint8_t pairMethod)
     if (ret != SMP_SUCCESS) {
         SMP_GeneratePairResult(g_smpPairMng.handle, SMP_PAIR_STATUS_FAILED, SMP_PAIR_FAILED_UNSPECIFIED_REASION, NULL);
     }
-    (void)memset_s(encryptParam.key, SMP_ENCRYPT_KEY_LEN, 0x00, SMP_ENCRYPT_KEY_LEN);
     return ret;
 }
 
@@ -1192,15 +1183,9 @@ static int SMP_AuthReqReplyStepTransSlave(uint8_t pairMethod)
 static int SMP_AuthReqReplyNumericSlave()
 {
     int ret = SMP_SUCCESS;
-    HciLeEncryptParam encryptParam;
     LOG_DEBUG("%{public}s", __FUNCTION__);
     if (g_smpPairMng.slaveDHKeyCheckRecvFlag) {
-        uint8_t cryptAesCmacZ[CRYPT_AESCMAC_Z_LEN] = {0x00};
-        SMP_MemoryReverseCopy(encryptParam.key, SALT, sizeof(encryptParam.key));
-        (void)memcpy_s(
-            encryptParam.plaintextData, sizeof(encryptParam.plaintextData), cryptAesCmacZ, CRYPT_AESCMAC_Z_LEN);
-        LOG_DEBUG("SMP_SC_PAIR_COMMON_SLAVE_STEP_2 started.");
-        ret = SMP_SendLeEncryptCmd(&encryptParam, SMP_SC_PAIR_COMMON_SLAVE_STEP_2, NULL, SMP_USING_HW_AES128_PAIR);
+        ret = SMP_ScPairCommonSlaveStart();
         if (ret != SMP_SUCCESS) {
             SMP_GeneratePairResult(
                 g_smpPairMng.handle, SMP_PAIR_STATUS_FAILED, SMP_PAIR_FAILED_UNSPECIFIED_REASION, NULL);
@@ -1210,7 +1195,6 @@ static int SMP_AuthReqReplyNumericSlave()
         g_smpPairMng.step = SMP_SC_PAIR_COMMON_SLAVE_STEP_1;
         AlarmSet(g_smpPairMng.alarm, SMP_PAIR_WAIT_TIME, SMP_PairTimeout, NULL);
     }
-    (void)memset_s(encryptParam.key, SMP_ENCRYPT_KEY_LEN, 0x00, SMP_ENCRYPT_KEY_LEN);
     return ret;
 }
 
@@ -1600,6 +1584,7 @@ static void SMP_GenPairRetNormal(uint16_t handle, uint8_t status)
 
     AlarmDelete(g_smpPairMng.alarm);
     (void)memset_s(&g_smpPairMng, sizeof(g_smpPairMng), 0x00, sizeof(g_smpPairMng));
+    SMP_AesClearKeyCache();
     SMP_NotifyCbPairRet(handle, status, &pairResult);
 }
 
@@ -1615,6 +1600,7 @@ static void SMP_GenPairRetException(uint16_t handle, uint8_t status, uint8_t fai
     }
     AlarmDelete(g_smpPairMng.alarm);
     (void)memset_s(&g_smpPairMng, sizeof(g_smpPairMng), 0x00, sizeof(g_smpPairMng));
+    SMP_AesClearKeyCache();
     SMP_NotifyCbPairRet(handle, status, &pairResult);
 }
 
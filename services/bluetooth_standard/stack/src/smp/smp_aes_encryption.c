@@ -17,10 +17,30 @@
 #include <string.h>
 
 #include "log.h"
-#include "openssl/aes.h"
+#include "openssl/evp.h"
+#include "platform/include/mutex.h"
 
 #include "smp.h"
 
+#define SMP_AES_KEY_CACHE_SIZE 4
+#define SMP_AES_CMAC_CONST_RB 0x87
+
+// An expanded key schedule and the CMAC subkeys derived from it. EVP picks AES-NI or the ARMv8 crypto
+// extensions when the CPU has them, the AES_* functions always run the table based code.
+typedef struct {
+    bool inUse;
+    bool hasSubkeys;
+    uint32_t lastUsed;
+    uint8_t key[AES_BLOCK_SIZE];
+    uint8_t k1[AES_BLOCK_SIZE];
+    uint8_t k2[AES_BLOCK_SIZE];
+    EVP_CIPHER_CTX *ctx;
+} SMP_AesKeyCacheEntry;
+
+static SMP_AesKeyCacheEntry g_smpAesKeyCache[SMP_AES_KEY_CACHE_SIZE];
+static uint32_t g_smpAesKeyCacheClock = 0;
+static Mutex *g_smpAesKeyCacheLock = NULL;
+
 static void SMP_ReverseData(const uint8_t *intput, uint8_t *output, int size)
 {
     for (int i = 0x00; i < size; i++) {
@@ -28,6 +48,140 @@ static void SMP_ReverseData(const uint8_t *intput, uint8_t *output, int size)
     }
 }
 
+static void SMP_AesClearEntry(SMP_AesKeyCacheEntry *entry)
+{
+    if (entry->ctx != NULL) {
+        EVP_CIPHER_CTX_free(entry->ctx);
+    }
+    (void)memset_s(entry, sizeof(SMP_AesKeyCacheEntry), 0x00, sizeof(SMP_AesKeyCacheEntry));
+}
+
+static int SMP_AesSetKey(SMP_AesKeyCacheEntry *entry, const uint8_t key[AES_BLOCK_SIZE])
+{
+    uint8_t keyReverse[AES_BLOCK_SIZE];
+    SMP_ReverseData(key, keyReverse, sizeof(keyReverse));
+
+    entry->ctx = EVP_CIPHER_CTX_new();
+    int ret = -1;
+    if ((entry->ctx != NULL) && (EVP_EncryptInit_ex(entry->ctx, EVP_aes_128_ecb(), NULL, keyReverse, NULL) == 1)) {
+        (void)EVP_CIPHER_CTX_set_padding(entry->ctx, 0);
+        (void)memcpy_s(entry->key, AES_BLOCK_SIZE, key, AES_BLOCK_SIZE);
+        entry->inUse = true;
+        ret = 0;
+    }
+    (void)memset_s(keyReverse, sizeof(keyReverse), 0x00, sizeof(keyReverse));
+    if (ret != 0) {
+        SMP_AesClearEntry(entry);
+    }
+    return ret;
+}
+
+// Must be called with g_smpAesKeyCacheLock held, or on a private entry when the cache is not initialized.
+static SMP_AesKeyCacheEntry *SMP_AesGetKeyEntry(const uint8_t key[AES_BLOCK_SIZE])
+{
+    SMP_AesKeyCacheEntry *victim = &g_smpAesKeyCache[0];
+    for (int i = 0; i < SMP_AES_KEY_CACHE_SIZE; i++) {
+        SMP_AesKeyCacheEntry *entry = &g_smpAesKeyCache[i];
+        if (entry->inUse && (memcmp(entry->key, key, AES_BLOCK_SIZE) == 0)) {
+            entry->lastUsed = ++g_smpAesKeyCacheClock;
+            return entry;
+        }
+        if (!victim->inUse) {
+            continue;
+        }
+        if ((!entry->inUse) || (entry->lastUsed < victim->lastUsed)) {
+            victim = entry;
+        }
+    }
+
+    SMP_AesClearEntry(victim);
+    if (SMP_AesSetKey(victim, key) != 0) {
+        LOG_ERROR("%{public}s: set key failed.", __FUNCTION__);
+        return NULL;
+    }
+    victim->lastUsed = ++g_smpAesKeyCacheClock;
+    return victim;
+}
+
+// Input and output are in the AES byte order, most significant octet first.
+static int SMP_AesEncryptBlock(
+    const SMP_AesKeyCacheEntry *entry, const uint8_t in[AES_BLOCK_SIZE], uint8_t out[AES_BLOCK_SIZE])
+{
+    int outLen = 0;
+    if ((EVP_EncryptUpdate(entry->ctx, out, &outLen, in, AES_BLOCK_SIZE) != 1) || (outLen != AES_BLOCK_SIZE)) {
+        return -1;
+    }
+    return 0;
+}
+
+static void SMP_AesCmacSubkey(const uint8_t in[AES_BLOCK_SIZE], uint8_t out[AES_BLOCK_SIZE])
+{
+    uint8_t overflow = 0x00;
+    for (int i = AES_BLOCK_SIZE - 1; i >= 0; i--) {
+        out[i] = (uint8_t)(in[i] << 0x01) | overflow;
+        overflow = (in[i] & 0x80) ? 0x01 : 0x00;
+    }
+    if (in[0] & 0x80) {
+        out[AES_BLOCK_SIZE - 1] ^= SMP_AES_CMAC_CONST_RB;
+    }
+}
+
+static int SMP_AesCmacDeriveSubkeys(SMP_AesKeyCacheEntry *entry)
+{
+    if (entry->hasSubkeys) {
+        return 0;
+    }
+    uint8_t zero[AES_BLOCK_SIZE] = {0x00};
+    uint8_t l[AES_BLOCK_SIZE] = {0x00};
+    if (SMP_AesEncryptBlock(entry, zero, l) != 0) {
+        return -1;
+    }
+    SMP_AesCmacSubkey(l, entry->k1);
+    SMP_AesCmacSubkey(entry->k1, entry->k2);
+    (void)memset_s(l, sizeof(l), 0x00, sizeof(l));
+    entry->hasSubkeys = true;
+    return 0;
+}
+
+static int SMP_AesCmacInternal(
+    SMP_AesKeyCacheEntry *entry, const uint8_t *in, uint16_t inLen, uint8_t out[AES_BLOCK_SIZE])
+{
+    if (SMP_AesCmacDeriveSubkeys(entry) != 0) {
+        return -1;
+    }
+
+    uint16_t blocks = (inLen + AES_BLOCK_SIZE - 1) / AES_BLOCK_SIZE;
+    bool isComplete = (blocks != 0) && ((inLen % AES_BLOCK_SIZE) == 0);
+    if (blocks == 0) {
+        blocks = 1;
+    }
+
+    uint8_t x[AES_BLOCK_SIZE] = {0x00};
+    uint8_t y[AES_BLOCK_SIZE];
+    for (uint16_t n = 0; n < blocks - 1; n++) {
+        for (int i = 0; i < AES_BLOCK_SIZE; i++) {
+            y[i] = x[i] ^ in[n * AES_BLOCK_SIZE + i];
+        }
+        if (SMP_AesEncryptBlock(entry, y, x) != 0) {
+            return -1;
+        }
+    }
+
+    uint16_t offset = (blocks - 1) * AES_BLOCK_SIZE;
+    uint16_t lastLen = inLen - offset;
+    uint8_t last[AES_BLOCK_SIZE] = {0x00};
+    (void)memcpy_s(last, AES_BLOCK_SIZE, in + offset, lastLen);
+    const uint8_t *subkey = entry->k1;
+    if (!isComplete) {
+        last[lastLen] = 0x80;
+        subkey = entry->k2;
+    }
+    for (int i = 0; i < AES_BLOCK_SIZE; i++) {
+        y[i] = x[i] ^ last[i] ^ subkey[i];
+    }
+    return SMP_AesEncryptBlock(entry, y, out);
+}
+
 static int SMP_Aes128Internal(
     const uint8_t key[AES_BLOCK_SIZE], const uint8_t in[AES_BLOCK_SIZE], uint8_t out[AES_BLOCK_SIZE])
 {
@@ -36,20 +190,30 @@ static int SMP_Aes128Internal(
     }
 
     uint8_t inReverse[AES_BLOCK_SIZE];
-    uint8_t keyReverse[AES_BLOCK_SIZE];
     uint8_t outReverse[AES_BLOCK_SIZE];
-    AES_KEY aesKey;
-
-    SMP_ReverseData(key, keyReverse, sizeof(keyReverse));
     SMP_ReverseData(in, inReverse, sizeof(inReverse));
 
-    AES_set_encrypt_key(keyReverse, 0x80, &aesKey);
-    AES_encrypt(inReverse, outReverse, &aesKey);
+    int ret;
+    if (g_smpAesKeyCacheLock == NULL) {
+        SMP_AesKeyCacheEntry entry = {0};
+        ret = SMP_AesSetKey(&entry, key);
+        if (ret == 0) {
+            ret = SMP_AesEncryptBlock(&entry, inReverse, outReverse);
+        }
+        SMP_AesClearEntry(&entry);
+    } else {
+        MutexLock(g_smpAesKeyCacheLock);
+        SMP_AesKeyCacheEntry *entry = SMP_AesGetKeyEntry(key);
+        ret = (entry != NULL) ? SMP_AesEncryptBlock(entry, inReverse, outReverse) : -1;
+        MutexUnlock(g_smpAesKeyCacheLock);
+    }
 
-    SMP_ReverseData(outReverse, out, sizeof(outReverse));
-    (void)memset_s(keyReverse, sizeof(keyReverse), 0x00, sizeof(keyReverse));
+    if (ret == 0) {
+        SMP_ReverseData(outReverse, out, sizeof(outReverse));
+    }
+    (void)memset_s(outReverse, sizeof(outReverse), 0x00, sizeof(outReverse));
 
-    return 0;
+    return ret;
 }
 
 int SMP_Aes128(
@@ -76,4 +240,63 @@ int SMP_Aes128(
     }
 
     return SMP_Aes128Internal(&keyInput[0], &input[0], &out[0]);
-}
\ No newline at end of file
+}
+
+int SMP_AesCmac(const uint8_t key[AES_BLOCK_SIZE], const uint8_t *in, uint16_t inLen, uint8_t out[AES_BLOCK_SIZE])
+{
+    if ((key == NULL) || ((in == NULL) && (inLen != 0)) || (out == NULL)) {
+        return -1;
+    }
+
+    uint8_t tag[AES_BLOCK_SIZE];
+    int ret;
+    if (g_smpAesKeyCacheLock == NULL) {
+        SMP_AesKeyCacheEntry entry = {0};
+        ret = SMP_AesSetKey(&entry, key);
+        if (ret == 0) {
+            ret = SMP_AesCmacInternal(&entry, in, inLen, tag);
+        }
+        SMP_AesClearEntry(&entry);
+    } else {
+        MutexLock(g_smpAesKeyCacheLock);
+        SMP_AesKeyCacheEntry *entry = SMP_AesGetKeyEntry(key);
+        ret = (entry != NULL) ? SMP_AesCmacInternal(entry, in, inLen, tag) : -1;
+        MutexUnlock(g_smpAesKeyCacheLock);
+    }
+
+    if (ret == 0) {
+        SMP_ReverseData(tag, out, sizeof(tag));
+    }
+    (void)memset_s(tag, sizeof(tag), 0x00, sizeof(tag));
+
+    return ret;
+}
+
+void SMP_AesInitialize()
+{
+    if (g_smpAesKeyCacheLock == NULL) {
+        g_smpAesKeyCacheLock = MutexCreate();
+    }
+}
+
+void SMP_AesFinalize()
+{
+    SMP_AesClearKeyCache();
+    if (g_smpAesKeyCacheLock != NULL) {
+        MutexDelete(g_smpAesKeyCacheLock);
+        g_smpAesKeyCacheLock = NULL;
+    }
+}
+
+void SMP_AesClearKeyCache()
+{
+    if (g_smpAesKeyCacheLock == NULL) {
+        return;
+    }
+    MutexLock(g_smpAesKeyCacheLock);
+    for (int i = 0; i < SMP_AES_KEY_CACHE_SIZE; i++) {
+        SMP_AesClearEntry(&g_smpAesKeyCache[i]);
+    }
+    g_smpAesKeyCacheClock = 0;
+    MutexUnlock(g_smpAesKeyCacheLock);
+}
@@ -39,6 +39,33 @@ extern "C" {
 int SMP_Aes128(
     const uint8_t *key, const uint8_t keyLen, const uint8_t *in, const uint8_t inLen, uint8_t out[AES_BLOCK_SIZE]);
 
+/**
+ * @brief aes cmac, reusing the cached key schedule and subkeys of the key.
+ *
+ * @param key key data, must be 128bit, in the same byte order as the key of SMP_Aes128.
+ * @param in Message, most significant octet first.
+ * @param inLen Message's length in bytes.
+ * @param out Message authentication code, must be 128bit, in the same byte order as the output of SMP_Aes128.
+ * @return Returns <b>0</b> if the operation is success.
+ *         returns <b>-1</b> if the operation is failed.
+ */
+int SMP_AesCmac(const uint8_t key[AES_BLOCK_SIZE], const uint8_t *in, uint16_t inLen, uint8_t out[AES_BLOCK_SIZE]);
+
+/**
+ * @brief Create the lock of the key schedule cache. Without it every call expands its key again.
+ */
+void SMP_AesInitialize();
+
+/**
+ * @brief Clear the key schedule cache and delete its lock.
+ */
+void SMP_AesFinalize();
+
+/**
+ * @brief Clear the cached key schedules and subkeys, so no key material outlives a pairing.
+ */
+void SMP_AesClearKeyCache();
+
 #ifdef __cplusplus
 }
 #endif
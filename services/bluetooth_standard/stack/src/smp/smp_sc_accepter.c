@@ -963,25 +963,82 @@ void SMP_ScPairOobSlaveStep15(const SMP_StepParam *param)
     }
 }
 
+static bool SMP_ScPairCommonSlaveCheckDHKey(const uint8_t *dhkeyCheckTmp)
+{
+    if (memcmp(dhkeyCheckTmp, SMP_GetPairMng()->peer.DHKeyCheck, SMP_DHKEY_CHECK_LEN) != 0x00) {
+        SMP_GeneratePairResult(SMP_GetPairMng()->handle, SMP_PAIR_STATUS_FAILED, SMP_PAIR_FAILED_DHKEY_CHECK, NULL);
+        LOG_ERROR("DHKey check failed");
+        return false;
+    }
+    LOG_INFO("DHKey check success");
+    return true;
+}
+
+static void SMP_ScPairCommonSlaveSendDHKeyCheck()
+{
+    LOG_DEBUG("SMP_SC_PAIR_COMMON_SLAVE_STEP_17 started.");
+    SMP_GetPairMng()->step = SMP_SC_PAIR_COMMON_SLAVE_STEP_17;
+    AlarmSet(SMP_GetPairMng()->alarm, SMP_PAIR_WAIT_TIME, SMP_PairTimeout, NULL);
+    int ret =
+        SMP_SendPairingDHKeyCheck(SMP_GetPairMng()->handle, SMP_GetPairMng()->local.DHKeyCheck, SMP_SendDataCallback);
+    if (ret != SMP_SUCCESS) {
+        LOG_ERROR("Send Pairing DHKey Check failed.");
+        SMP_GeneratePairResult(SMP_GetPairMng()->handle,
+            SMP_PAIR_STATUS_FAILED,
+            SMP_PAIR_FAILED_UNSPECIFIED_REASION,
+            SMP_GetPairMng()->alarm);
+    }
+}
+
+int SMP_ScPairCommonSlaveStart()
+{
+    if (SMP_USING_HW_AES128_PAIR) {
+        uint8_t cryptAesCmacZ[CRYPT_AESCMAC_Z_LEN] = {0x00};
+        HciLeEncryptParam encryptParam;
+        SMP_MemoryReverseCopy(encryptParam.key, SALT, sizeof(encryptParam.key));
+        (void)memcpy_s(
+            encryptParam.plaintextData, sizeof(encryptParam.plaintextData), cryptAesCmacZ, CRYPT_AESCMAC_Z_LEN);
+        LOG_DEBUG("SMP_SC_PAIR_COMMON_SLAVE_STEP_2 started.");
+        int ret = SMP_SendLeEncryptCmd(&encryptParam, SMP_SC_PAIR_COMMON_SLAVE_STEP_2, NULL, SMP_USING_HW_AES128_PAIR);
+        (void)memset_s(encryptParam.key, SMP_ENCRYPT_KEY_LEN, 0x00, SMP_ENCRYPT_KEY_LEN);
+        return ret;
+    }
+
+    // The software AES path has no controller round trips to wait for, so f5 and both f6 run here in one go.
+    uint8_t dhkeyCheckTmp[SMP_DHKEY_CHECK_LEN] = {0x00};
+    LOG_DEBUG("%{public}s", __FUNCTION__);
+    int ret = SMP_CalculateScLtkAndMacKey(SMP_ROLE_SLAVE);
+    if (ret == SMP_SUCCESS) {
+        bool isCalculatePeer = true;
+        ret = SMP_CalculateScDHKeyCheck(isCalculatePeer, dhkeyCheckTmp);
+    }
+    if (ret != SMP_SUCCESS) {
+        return ret;
+    }
+    if (!SMP_ScPairCommonSlaveCheckDHKey(dhkeyCheckTmp)) {
+        return SMP_SUCCESS;
+    }
+    bool isCalculatePeer = false;
+    ret = SMP_CalculateScDHKeyCheck(isCalculatePeer, SMP_GetPairMng()->local.DHKeyCheck);
+    if (ret == SMP_SUCCESS) {
+        SMP_ScPairCommonSlaveSendDHKeyCheck();
+    }
+    return ret;
+}
+
 void SMP_ScPairCommonSlaveStep1(const SMP_StepParam *param)
 {
     if (SMP_ParamIsNULL(param) != SMP_SUCCESS) {
         return;
     }
-    uint8_t cryptAesCmacZ[CRYPT_AESCMAC_Z_LEN] = {0x00};
-    HciLeEncryptParam encryptParam;
     LOG_DEBUG("%{public}s", __FUNCTION__);
     AlarmCancel(SMP_GetPairMng()->alarm);
     (void)memcpy_s(SMP_GetPairMng()->peer.DHKeyCheck, SMP_DHKEY_CHECK_LEN, (uint8_t *)param->data, SMP_DHKEY_CHECK_LEN);
-    SMP_MemoryReverseCopy(encryptParam.key, SALT, sizeof(encryptParam.key));
-    (void)memcpy_s(encryptParam.plaintextData, sizeof(encryptParam.plaintextData), cryptAesCmacZ, CRYPT_AESCMAC_Z_LEN);
-    LOG_DEBUG("SMP_SC_PAIR_COMMON_SLAVE_STEP_2 started.");
-    int ret = SMP_SendLeEncryptCmd(&encryptParam, SMP_SC_PAIR_COMMON_SLAVE_STEP_2, NULL, SMP_USING_HW_AES128_PAIR);
+    int ret = SMP_ScPairCommonSlaveStart();
     if (ret != SMP_SUCCESS) {
         SMP_GeneratePairResult(
             SMP_GetPairMng()->handle, SMP_PAIR_STATUS_FAILED, SMP_PAIR_FAILED_UNSPECIFIED_REASION, NULL);
     }
-    (void)memset_s(encryptParam.key, SMP_ENCRYPT_KEY_LEN, 0x00, SMP_ENCRYPT_KEY_LEN);
 }
 
 void SMP_ScPairCommonSlaveStep2(const SMP_StepParam *param)
@@ -1271,11 +1328,7 @@ void SMP_ScPairCommonSlaveStep13(const SMP_StepParam *param)
         return;
     }
     (void)memcpy_s(dhkeyCheckTmp, SMP_DHKEY_CHECK_LEN, encData->encRetParam->encryptedData, SMP_DHKEY_CHECK_LEN);
-    if (memcmp(dhkeyCheckTmp, SMP_GetPairMng()->peer.DHKeyCheck, SMP_DHKEY_CHECK_LEN) != 0x00) {
-        SMP_GeneratePairResult(SMP_GetPairMng()->handle, SMP_PAIR_STATUS_FAILED, SMP_PAIR_FAILED_DHKEY_CHECK, NULL);
-        LOG_ERROR("DHKey check failed");
-    } else {
-        LOG_INFO("DHKey check success");
+    if (SMP_ScPairCommonSlaveCheckDHKey(dhkeyCheckTmp)) {
         SMP_MemoryReverseCopy(encryptParam.key, SMP_GetPairMng()->macKey, SMP_MACKEY_LEN);
         uint8_t cryptAesCmacZ[CRYPT_AESCMAC_Z_LEN] = {0x00};
         (void)memcpy_s(
@@ -1351,17 +1404,7 @@ void SMP_ScPairCommonSlaveStep16(const SMP_StepParam *param)
     }
     (void)memcpy_s(
         SMP_GetPairMng()->local.DHKeyCheck, SMP_DHKEY_CHECK_LEN, returnParam->encryptedData, SMP_DHKEY_CHECK_LEN);
-    LOG_DEBUG("SMP_SC_PAIR_COMMON_SLAVE_STEP_17 started.");
-    SMP_GetPairMng()->step = SMP_SC_PAIR_COMMON_SLAVE_STEP_17;
-    AlarmSet(SMP_GetPairMng()->alarm, SMP_PAIR_WAIT_TIME, SMP_PairTimeout, NULL);
-    ret = SMP_SendPairingDHKeyCheck(SMP_GetPairMng()->handle, SMP_GetPairMng()->local.DHKeyCheck, SMP_SendDataCallback);
-    if (ret != SMP_SUCCESS) {
-        LOG_ERROR("Send Pairing DHKey Check failed.");
-        SMP_GeneratePairResult(SMP_GetPairMng()->handle,
-            SMP_PAIR_STATUS_FAILED,
-            SMP_PAIR_FAILED_UNSPECIFIED_REASION,
-            SMP_GetPairMng()->alarm);
-    }
+    SMP_ScPairCommonSlaveSendDHKeyCheck();
 }
 
 void SMP_ScPairCommonSlaveStep19(const SMP_StepParam *param)
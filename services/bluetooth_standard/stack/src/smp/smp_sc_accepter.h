@@ -129,6 +129,7 @@ void SMP_ScPairOobSlaveStep12(const SMP_StepParam *param);
 void SMP_ScPairOobSlaveStep13(const SMP_StepParam *param);
 void SMP_ScPairOobSlaveStep14(const SMP_StepParam *param);
 void SMP_ScPairOobSlaveStep15(const SMP_StepParam *param);
+int SMP_ScPairCommonSlaveStart();
 void SMP_ScPairCommonSlaveStep1(const SMP_StepParam *param);
 void SMP_ScPairCommonSlaveStep2(const SMP_StepParam *param);
 void SMP_ScPairCommonSlaveStep3(const SMP_StepParam *param);
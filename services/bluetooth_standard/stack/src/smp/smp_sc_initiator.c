@@ -246,11 +246,7 @@ void SMP_ScPairJustworkOrNumericMasterStep10(const SMP_StepParam *param)
         LOG_INFO("Confirm Check Success.");
         uint8_t cryptAesCmacZ[CRYPT_AESCMAC_Z_LEN] = {0x00};
         if (SMP_GetPairMng()->local.pairMethod == SMP_PAIR_METHOD_JUST_WORK) {
-            SMP_MemoryReverseCopy(encryptParam.key, SALT, sizeof(encryptParam.key));
-            (void)memcpy_s(
-                encryptParam.plaintextData, sizeof(encryptParam.plaintextData), cryptAesCmacZ, CRYPT_AESCMAC_Z_LEN);
-            LOG_DEBUG("SMP_SC_PAIR_COMMON_MASTER_STEP_1 started.");
-            ret = SMP_SendLeEncryptCmd(&encryptParam, SMP_SC_PAIR_COMMON_MASTER_STEP_1, NULL, SMP_USING_HW_AES128_PAIR);
+            ret = SMP_ScPairCommonMasterStart();
         } else {
             SMP_MemoryReverseCopy(encryptParam.key, SMP_GetPairMng()->local.random, sizeof(encryptParam.key));
             (void)memcpy_s(
@@ -663,7 +659,6 @@ void SMP_ScPairPasskeyEntryMasterStep15(const SMP_StepParam *param)
     }
     SMP_EncData *encData = (SMP_EncData *)param->data;
     uint8_t confirmTemp[SMP_CONFIRM_DATA_LEN] = {0x00};
-    HciLeEncryptParam encryptParam;
     LOG_DEBUG("%{public}s", __FUNCTION__);
     int ret = SMP_EncryptCompleteJudgeException(encData->encRetParam->status, SMP_ROLE_MASTER);
     if (ret != SMP_SUCCESS) {
@@ -677,12 +672,7 @@ void SMP_ScPairPasskeyEntryMasterStep15(const SMP_StepParam *param)
         LOG_INFO("Confirm Check Success");
         SMP_GetPairMng()->scConfirmCheckCounter++;
         if (SMP_GetPairMng()->scConfirmCheckCounter == 0x14) {
-            SMP_MemoryReverseCopy(encryptParam.key, SALT, sizeof(encryptParam.key));
-            uint8_t cryptAesCmacZ[CRYPT_AESCMAC_Z_LEN] = {0x00};
-            (void)memcpy_s(
-                encryptParam.plaintextData, sizeof(encryptParam.plaintextData), cryptAesCmacZ, CRYPT_AESCMAC_Z_LEN);
-            LOG_DEBUG("SMP_SC_PAIR_COMMON_MASTER_STEP_1 started.");
-            ret = SMP_SendLeEncryptCmd(&encryptParam, SMP_SC_PAIR_COMMON_MASTER_STEP_1, NULL, SMP_USING_HW_AES128_PAIR);
+            ret = SMP_ScPairCommonMasterStart();
         } else {
             LOG_DEBUG("SMP_SC_PAIR_PASSKEYENTRY_MASTER_STEP_6 started.");
             ret = SMP_SendHciLeRandCmd(SMP_SC_PAIR_PASSKEYENTRY_MASTER_STEP_6);
@@ -692,7 +682,6 @@ void SMP_ScPairPasskeyEntryMasterStep15(const SMP_StepParam *param)
                 SMP_GetPairMng()->handle, SMP_PAIR_STATUS_FAILED, SMP_PAIR_FAILED_UNSPECIFIED_REASION, NULL);
         }
     }
-    (void)memset_s(encryptParam.key, SMP_ENCRYPT_KEY_LEN, 0x00, SMP_ENCRYPT_KEY_LEN);
 }
 
 void SMP_ScPairOobMasterStep1(const SMP_StepParam *param)
@@ -900,19 +889,83 @@ void SMP_ScPairOobMasterStep15(const SMP_StepParam *param)
     if (SMP_ParamIsNULL(param) != SMP_SUCCESS) {
         return;
     }
-    uint8_t cryptAesCmacZ[CRYPT_AESCMAC_Z_LEN] = {0x00};
-    HciLeEncryptParam encryptParam;
     LOG_DEBUG("%{public}s", __FUNCTION__);
     SMP_MemoryReverseCopy(SMP_GetPairMng()->peer.random, (uint8_t *)param->data, SMP_RANDOM_DATA_LEN);
-    SMP_MemoryReverseCopy(encryptParam.key, SALT, sizeof(encryptParam.key));
-    (void)memcpy_s(encryptParam.plaintextData, sizeof(encryptParam.plaintextData), cryptAesCmacZ, CRYPT_AESCMAC_Z_LEN);
-    LOG_DEBUG("SMP_SC_PAIR_COMMON_MASTER_STEP_1 started.");
-    int ret = SMP_SendLeEncryptCmd(&encryptParam, SMP_SC_PAIR_COMMON_MASTER_STEP_1, NULL, SMP_USING_HW_AES128_PAIR);
+    int ret = SMP_ScPairCommonMasterStart();
     if (ret != SMP_SUCCESS) {
         SMP_GeneratePairResult(
             SMP_GetPairMng()->handle, SMP_PAIR_STATUS_FAILED, SMP_PAIR_FAILED_UNSPECIFIED_REASION, NULL);
     }
-    (void)memset_s(encryptParam.key, SMP_ENCRYPT_KEY_LEN, 0x00, SMP_ENCRYPT_KEY_LEN);
+}
+
+static void SMP_ScPairCommonMasterSendDHKeyCheck()
+{
+    LOG_DEBUG("SMP_SC_PAIR_COMMON_MASTER_STEP_13 started.");
+    SMP_GetPairMng()->step = SMP_SC_PAIR_COMMON_MASTER_STEP_13;
+    AlarmSet(SMP_GetPairMng()->alarm, SMP_PAIR_WAIT_TIME, SMP_PairTimeout, NULL);
+    int ret =
+        SMP_SendPairingDHKeyCheck(SMP_GetPairMng()->handle, SMP_GetPairMng()->local.DHKeyCheck, SMP_SendDataCallback);
+    if (ret != SMP_SUCCESS) {
+        SMP_GeneratePairResult(SMP_GetPairMng()->handle,
+            SMP_PAIR_STATUS_FAILED,
+            SMP_PAIR_FAILED_UNSPECIFIED_REASION,
+            SMP_GetPairMng()->alarm);
+        LOG_ERROR("Send Pairing DHKey Check Failed");
+    }
+}
+
+static void SMP_ScPairCommonMasterCheckDHKey(const uint8_t *dhkeyCheckTemp)
+{
+    HciLeStartEncryptionParam startEncParam;
+    if (memcmp(dhkeyCheckTemp, SMP_GetPairMng()->peer.DHKeyCheck, SMP_DHKEY_CHECK_LEN) != 0x00) {
+        LOG_ERROR("DHKey  Check  Failed.");
+        SMP_GeneratePairResult(SMP_GetPairMng()->handle, SMP_PAIR_STATUS_FAILED, SMP_PAIR_FAILED_DHKEY_CHECK, NULL);
+    } else {
+        LOG_INFO("DHKey  Check  Success.");
+        startEncParam.connectionHandle = SMP_GetPairMng()->handle;
+        startEncParam.encryptDiversifier = 0x00;
+        (void)memset_s(startEncParam.randomNumber, SMP_MASTER_RAND_LEN, 0x00, SMP_MASTER_RAND_LEN);
+        (void)memcpy_s(startEncParam.longTermKey, SMP_LTK_LEN, SMP_GetPairMng()->local.LTK, SMP_LTK_LEN);
+        LOG_DEBUG("SMP_SC_PAIR_COMMON_MASTER_STEP_17 started.");
+        SMP_GetPairMng()->step = SMP_SC_PAIR_COMMON_MASTER_STEP_17;
+        AlarmSet(SMP_GetPairMng()->alarm, SMP_PAIR_WAIT_TIME, SMP_PairTimeout, NULL);
+        SMP_GetPairMng()->masterEncryptedFlag = SMP_MASTER_ENCRYPTED_FLAG_NO;
+        int ret = HCI_LeStartEncryption(&startEncParam);
+        if (ret != SMP_SUCCESS) {
+            LOG_ERROR("HCI_LeStartEncryption failed.");
+            SMP_GeneratePairResult(SMP_GetPairMng()->handle,
+                SMP_PAIR_STATUS_FAILED,
+                SMP_PAIR_FAILED_UNSPECIFIED_REASION,
+                SMP_GetPairMng()->alarm);
+        }
+    }
+}
+
+int SMP_ScPairCommonMasterStart()
+{
+    if (SMP_USING_HW_AES128_PAIR) {
+        uint8_t cryptAesCmacZ[CRYPT_AESCMAC_Z_LEN] = {0x00};
+        HciLeEncryptParam encryptParam;
+        SMP_MemoryReverseCopy(encryptParam.key, SALT, sizeof(encryptParam.key));
+        (void)memcpy_s(
+            encryptParam.plaintextData, sizeof(encryptParam.plaintextData), cryptAesCmacZ, CRYPT_AESCMAC_Z_LEN);
+        LOG_DEBUG("SMP_SC_PAIR_COMMON_MASTER_STEP_1 started.");
+        int ret = SMP_SendLeEncryptCmd(&encryptParam, SMP_SC_PAIR_COMMON_MASTER_STEP_1, NULL, SMP_USING_HW_AES128_PAIR);
+        (void)memset_s(encryptParam.key, SMP_ENCRYPT_KEY_LEN, 0x00, SMP_ENCRYPT_KEY_LEN);
+        return ret;
+    }
+
+    // The software AES path has no controller round trips to wait for, so f5 and the local f6 run here in one go.
+    LOG_DEBUG("%{public}s", __FUNCTION__);
+    int ret = SMP_CalculateScLtkAndMacKey(SMP_ROLE_MASTER);
+    if (ret == SMP_SUCCESS) {
+        bool isCalculatePeer = false;
+        ret = SMP_CalculateScDHKeyCheck(isCalculatePeer, SMP_GetPairMng()->local.DHKeyCheck);
+    }
+    if (ret == SMP_SUCCESS) {
+        SMP_ScPairCommonMasterSendDHKeyCheck();
+    }
+    return ret;
 }
 
 void SMP_ScPairCommonMasterStep1(const SMP_StepParam *param)
@@ -1200,17 +1253,7 @@ void SMP_ScPairCommonMasterStep12(const SMP_StepParam *param)
         SMP_DHKEY_CHECK_LEN,
         encData->encRetParam->encryptedData,
         SMP_DHKEY_CHECK_LEN);
-    LOG_DEBUG("SMP_SC_PAIR_COMMON_MASTER_STEP_13 started.");
-    SMP_GetPairMng()->step = SMP_SC_PAIR_COMMON_MASTER_STEP_13;
-    AlarmSet(SMP_GetPairMng()->alarm, SMP_PAIR_WAIT_TIME, SMP_PairTimeout, NULL);
-    ret = SMP_SendPairingDHKeyCheck(SMP_GetPairMng()->handle, SMP_GetPairMng()->local.DHKeyCheck, SMP_SendDataCallback);
-    if (ret != SMP_SUCCESS) {
-        SMP_GeneratePairResult(SMP_GetPairMng()->handle,
-            SMP_PAIR_STATUS_FAILED,
-            SMP_PAIR_FAILED_UNSPECIFIED_REASION,
-            SMP_GetPairMng()->alarm);
-        LOG_ERROR("Send Pairing DHKey Check Failed");
-    }
+    SMP_ScPairCommonMasterSendDHKeyCheck();
 }
 
 void SMP_ScPairCommonMasterStep13(const SMP_StepParam *param)
@@ -1224,6 +1267,17 @@ void SMP_ScPairCommonMasterStep13(const SMP_StepParam *param)
     LOG_DEBUG("%{public}s", __FUNCTION__);
     AlarmCancel(SMP_GetPairMng()->alarm);
     (void)memcpy_s(SMP_GetPairMng()->peer.DHKeyCheck, SMP_DHKEY_CHECK_LEN, (uint8_t *)param->data, SMP_DHKEY_CHECK_LEN);
+    if (!SMP_USING_HW_AES128_PAIR) {
+        uint8_t dhkeyCheckTemp[SMP_DHKEY_CHECK_LEN] = {0x00};
+        bool isCalculatePeer = true;
+        if (SMP_CalculateScDHKeyCheck(isCalculatePeer, dhkeyCheckTemp) != SMP_SUCCESS) {
+            SMP_GeneratePairResult(
+                SMP_GetPairMng()->handle, SMP_PAIR_STATUS_FAILED, SMP_PAIR_FAILED_UNSPECIFIED_REASION, NULL);
+            return;
+        }
+        SMP_ScPairCommonMasterCheckDHKey(dhkeyCheckTemp);
+        return;
+    }
     SMP_MemoryReverseCopy(encryptParam.key, SMP_GetPairMng()->macKey, SMP_MACKEY_LEN);
     (void)memcpy_s(encryptParam.plaintextData, sizeof(encryptParam.plaintextData), cryptAesCmacZ, CRYPT_AESCMAC_Z_LEN);
     LOG_DEBUG("SMP_SC_PAIR_COMMON_MASTER_STEP_14 started.");
@@ -1289,7 +1343,6 @@ void SMP_ScPairCommonMasterStep16(const SMP_StepParam *param)
         return;
     }
     SMP_EncData *encData = (SMP_EncData *)param->data;
-    HciLeStartEncryptionParam startEncParam;
     uint8_t dhkeyCheckTemp[SMP_DHKEY_CHECK_LEN] = {0x00};
     LOG_DEBUG("%{public}s", __FUNCTION__);
     int ret = SMP_EncryptCompleteJudgeException(encData->encRetParam->status, SMP_ROLE_MASTER);
@@ -1297,28 +1350,7 @@ void SMP_ScPairCommonMasterStep16(const SMP_StepParam *param)
         return;
     }
     (void)memcpy_s(dhkeyCheckTemp, SMP_DHKEY_CHECK_LEN, encData->encRetParam->encryptedData, SMP_DHKEY_CHECK_LEN);
-    if (memcmp(dhkeyCheckTemp, SMP_GetPairMng()->peer.DHKeyCheck, SMP_DHKEY_CHECK_LEN) != 0x00) {
-        LOG_ERROR("DHKey  Check  Failed.");
-        SMP_GeneratePairResult(SMP_GetPairMng()->handle, SMP_PAIR_STATUS_FAILED, SMP_PAIR_FAILED_DHKEY_CHECK, NULL);
-    } else {
-        LOG_INFO("DHKey  Check  Success.");
-        startEncParam.connectionHandle = SMP_GetPairMng()->handle;
-        startEncParam.encryptDiversifier = 0x00;
-        (void)memset_s(startEncParam.randomNumber, SMP_MASTER_RAND_LEN, 0x00, SMP_MASTER_RAND_LEN);
-        (void)memcpy_s(startEncParam.longTermKey, SMP_LTK_LEN, SMP_GetPairMng()->local.LTK, SMP_LTK_LEN);
-        LOG_DEBUG("SMP_SC_PAIR_COMMON_MASTER_STEP_17 started.");
-        SMP_GetPairMng()->step = SMP_SC_PAIR_COMMON_MASTER_STEP_17;
-        AlarmSet(SMP_GetPairMng()->alarm, SMP_PAIR_WAIT_TIME, SMP_PairTimeout, NULL);
-        SMP_GetPairMng()->masterEncryptedFlag = SMP_MASTER_ENCRYPTED_FLAG_NO;
-        ret = HCI_LeStartEncryption(&startEncParam);
-        if (ret != SMP_SUCCESS) {
-            LOG_ERROR("HCI_LeStartEncryption failed.");
-            SMP_GeneratePairResult(SMP_GetPairMng()->handle,
-                SMP_PAIR_STATUS_FAILED,
-                SMP_PAIR_FAILED_UNSPECIFIED_REASION,
-                SMP_GetPairMng()->alarm);
-        }
-    }
+    SMP_ScPairCommonMasterCheckDHKey(dhkeyCheckTemp);
 }
 
 void SMP_ScPairCommonMasterStep19(const SMP_StepParam *param)
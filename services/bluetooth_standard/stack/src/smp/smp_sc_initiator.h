@@ -126,6 +126,7 @@ void SMP_ScPairOobMasterStep12(const SMP_StepParam *param);
 void SMP_ScPairOobMasterStep13(const SMP_StepParam *param);
 void SMP_ScPairOobMasterStep14(const SMP_StepParam *param);
 void SMP_ScPairOobMasterStep15(const SMP_StepParam *param);
+int SMP_ScPairCommonMasterStart();
 void SMP_ScPairCommonMasterStep1(const SMP_StepParam *param);
 void SMP_ScPairCommonMasterStep2(const SMP_StepParam *param);
 void SMP_ScPairCommonMasterStep3(const SMP_StepParam *param);
@@ -20,6 +20,7 @@
 #include "log.h"
 #include "platform/include/allocator.h"
 #include "smp.h"
+#include "smp_aes_encryption.h"
 #include "smp_common.h"
 #include "smp_def.h"
 #include "smp_send.h"
@@ -28,6 +29,10 @@ static const uint8_t CONST_RB[CRYPT_AESCMAC_CONST_RB_LEN] = {
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x87
 };
 
+static const uint8_t SALT[SMP_ENCRYPT_KEY_LEN] = {
+    0x6C, 0x88, 0x83, 0x91, 0xAA, 0xF5, 0xA5, 0x38, 0x60, 0x37, 0x0B, 0xDB, 0x5A, 0x60, 0x83, 0xBE
+};  // The key of an encryption algorithm.
+
 static const uint8_t MASTER_LEGACY_IO_TABLE[IO_COUNTS][IO_COUNTS] = {
     {SMP_PAIR_METHOD_JUST_WORK,
         SMP_PAIR_METHOD_JUST_WORK,
@@ -474,6 +479,57 @@ void SMP_CryptographicF6(SMP_CryptF6Param *param)
     SMP_WriteToRow(param->output, CRYPT_F6_OUT_LEN, offset, param->A2, CRYPT_F6_A2_LEN);
 }
 
+int SMP_CalculateScLtkAndMacKey(uint8_t role)
+{
+    uint8_t key[SMP_ENCRYPT_KEY_LEN] = {0x00};
+    uint8_t t[SMP_ENCRYPT_KEY_LEN] = {0x00};
+    uint8_t tempMacKey[SMP_MACKEY_LEN] = {0x00};
+    uint8_t tempLTK[SMP_LTK_LEN] = {0x00};
+    SMP_CryptF5Param cryptF5Param;
+
+    SMP_MemoryReverseCopy(key, SALT, sizeof(key));
+    int ret = SMP_AesCmac(key, SMP_GetPairMng()->DHKey, SMP_DHKEY_LEN, t);
+    if (ret == SMP_SUCCESS) {
+        SMP_ConstituteF5Param(role, &cryptF5Param);
+        SMP_CryptographicF5(&cryptF5Param);
+        ret = SMP_AesCmac(t, cryptF5Param.output, CRYPT_F5_OUT_LEN, tempMacKey);
+    }
+    if (ret == SMP_SUCCESS) {
+        cryptF5Param.output[0x00] = 0x01;
+        ret = SMP_AesCmac(t, cryptF5Param.output, CRYPT_F5_OUT_LEN, tempLTK);
+    }
+    if (ret == SMP_SUCCESS) {
+        SMP_MemoryReverseCopy(SMP_GetPairMng()->macKey, tempMacKey, SMP_MACKEY_LEN);
+        SMP_LongTermKeyCopy(SMP_GetPairMng()->local.LTK, tempLTK, SMP_GetPairMng()->encKeySize);
+        SMP_LongTermKeyCopy(SMP_GetPairMng()->peer.LTK, tempLTK, SMP_GetPairMng()->encKeySize);
+    } else {
+        LOG_ERROR("%{public}s failed.", __FUNCTION__);
+    }
+
+    (void)memset_s(key, sizeof(key), 0x00, sizeof(key));
+    (void)memset_s(t, sizeof(t), 0x00, sizeof(t));
+    (void)memset_s(tempMacKey, sizeof(tempMacKey), 0x00, sizeof(tempMacKey));
+    (void)memset_s(tempLTK, sizeof(tempLTK), 0x00, sizeof(tempLTK));
+    return ret;
+}
+
+int SMP_CalculateScDHKeyCheck(bool isCalculatePeer, uint8_t dhkeyCheck[SMP_DHKEY_CHECK_LEN])
+{
+    uint8_t key[SMP_MACKEY_LEN] = {0x00};
+    SMP_CryptF6Param cryptF6Param;
+
+    SMP_ConstituteF6Param(isCalculatePeer, &cryptF6Param);
+    SMP_CryptographicF6(&cryptF6Param);
+    SMP_MemoryReverseCopy(key, SMP_GetPairMng()->macKey, SMP_MACKEY_LEN);
+    int ret = SMP_AesCmac(key, cryptF6Param.output, CRYPT_F6_OUT_LEN, dhkeyCheck);
+    if (ret != SMP_SUCCESS) {
+        LOG_ERROR("%{public}s failed.", __FUNCTION__);
+    }
+
+    (void)memset_s(key, sizeof(key), 0x00, sizeof(key));
+    return ret;
+}
+
 void SMP_CryptographicG2(SMP_CryptG2Param *param)
 {
     uint8_t offset = 0x00;
@@ -704,6 +760,7 @@ void SMP_ClearPairState(SMP_PairMng *mng)
         AlarmDelete(mng->alarm);
     }
     (void)memset_s(mng, sizeof(SMP_PairMng), 0x00, sizeof(SMP_PairMng));
+    SMP_AesClearKeyCache();
 }
 
 void SMP_CalculatePairType(SMP_PairMng *mng)
@@ -157,6 +157,8 @@ void SMP_ConstituteF5Param(uint8_t role, SMP_CryptF5Param *cryptF5Param);
 void SMP_CryptographicF5(SMP_CryptF5Param *param);
 void SMP_ConstituteF6Param(bool isCalculatePeer, SMP_CryptF6Param *cryptF6Param);
 void SMP_CryptographicF6(SMP_CryptF6Param *param);
+int SMP_CalculateScLtkAndMacKey(uint8_t role);
+int SMP_CalculateScDHKeyCheck(bool isCalculatePeer, uint8_t dhkeyCheck[SMP_DHKEY_CHECK_LEN]);
 void SMP_CryptographicG2(SMP_CryptG2Param *param);
 void SMP_CryptographicAesCmacStep1(SMP_CryptAesCmacStep1Param *param);
 void SMP_CryptographicAesCmacStep2(SMP_CryptAesCmacStep2Param *param);